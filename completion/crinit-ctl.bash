@@ -55,6 +55,7 @@ _crinit-ctl() {
         status
         notify
         list
+        graph
         reboot
         poweroff"
 
@@ -151,6 +151,20 @@ int crinitCGroupConfigure(crinitCgroup_t *cgroup);
  */
 int crinitCGroupAssignPID(crinitCgroup_t *cgroup, pid_t pid);
 
+/**
+ * @brief Open the directory of an existing cgroup.
+ *
+ * Opens (but does not create) the cgroup directory named by @p cgroup->name below
+ * its parent, if any. The returned descriptor has O_CLOEXEC set and can be used
+ * with clone3() and CLONE_INTO_CGROUP. @p cgroup itself is not modified.
+ *
+ * @param[in] cgroup    Pointer to a crinitCgroup_t that holds a valid, non-empty name.
+ *                      Must not be NULL.
+ *
+ * @return On success the open directory file descriptor which the caller needs to close, otherwise -1
+ */
+int crinitCGroupOpenDir(const crinitCgroup_t *cgroup);
+
 /**
  * @brief Create all global cgroups (includes root cgroup if configured)
  * @return On sucess 0, otherwise -1
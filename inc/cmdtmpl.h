@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file cmdtmpl.h
+ * @brief Header related to command templates, i.e. command arguments containing variables which are expanded each time
+ *        the command is run.
+ *
+ * Variable references of the form `${NAME}` are located once when the configuration is loaded, see
+ * crinitCmdTmplCompile(). Expanding them only formats the current values and copies the literal parts of the arguments
+ * into a single buffer, see crinitCmdTmplExpand(). Currently used for STOP_COMMANDs.
+ */
+#ifndef __CMDTMPL_H__
+#define __CMDTMPL_H__
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/**
+ * Enumeration of the variables which can be used in a command template.
+ */
+typedef enum crinitCmdVar {
+    CRINIT_CMD_VAR_NONE = -1,    ///< No variable, marks the literal rest of an argument.
+    CRINIT_CMD_VAR_TASK_PID,     ///< `${TASK_PID}` or `${MAINPID}`, the PID of the task's current process or -1.
+    CRINIT_CMD_VAR_TASK_NAME,    ///< `${TASK_NAME}`, the name of the task.
+    CRINIT_CMD_VAR_EXIT_STATUS,  ///< `${EXIT_STATUS}`, see crinitCmdVarVals_t::exitStatus.
+    CRINIT_CMD_VARS_COUNT        ///< Number of variables, must be last.
+} crinitCmdVar_t;
+
+/**
+ * Type to store the values of the variables at the time a command template is expanded.
+ */
+typedef struct crinitCmdVarVals {
+    const char *taskName;  ///< The name of the task.
+    pid_t pid;             ///< The PID of the task's current process or -1.
+    int exitStatus;        ///< Exit status of the last process of the task which has ended, 128 plus the signal number
+                           ///< if it was killed, or -1 if none has ended yet.
+} crinitCmdVarVals_t;
+
+/**
+ * A part of an argument in a command template.
+ */
+typedef struct crinitCmdTmplSeg {
+    int arg;             ///< Index of the argument the segment belongs to.
+    size_t litOff;       ///< Offset of the literal text in front of the variable from the start of the argument.
+    size_t litLen;       ///< Length of the literal text in front of the variable.
+    crinitCmdVar_t var;  ///< The variable, #CRINIT_CMD_VAR_NONE for the last segment of an argument.
+} crinitCmdTmplSeg_t;
+
+/**
+ * Precompiled variable references of a command.
+ *
+ * Only arguments containing at least one variable have segments, all other arguments are copied as they are. A
+ * template is a single allocation and can be freed using free().
+ */
+typedef struct crinitCmdTmpl {
+    size_t segsSize;            ///< Number of elements in segs.
+    crinitCmdTmplSeg_t segs[];  ///< The segments of all arguments containing variables, ordered by argument.
+} crinitCmdTmpl_t;
+
+/**
+ * Locate the variable references in the arguments of a command.
+ *
+ * References to unknown variables are left as they are. So is an argument which cannot be tokenized.
+ *
+ * @param tmpl  Return pointer for the template, set to NULL if no argument contains a known variable. Must be freed
+ *              using free().
+ * @param argc  Number of arguments.
+ * @param argv  The arguments.
+ *
+ * @return  0 on success, -1 on error
+ */
+int crinitCmdTmplCompile(crinitCmdTmpl_t **tmpl, int argc, char *const argv[]);
+
+/**
+ * Expand the variables in the arguments of a command.
+ *
+ * The result has the same format as the output of crinitConfConvToStrArr(), i.e. a NULL-terminated array of \a argc
+ * strings with a single backing buffer, and must be freed using crinitFreeArgvArray().
+ *
+ * @param out   Return pointer for the expanded arguments.
+ * @param tmpl  The template created by crinitCmdTmplCompile() from \a argv.
+ * @param argc  Number of arguments.
+ * @param argv  The arguments.
+ * @param vals  The values of the variables.
+ *
+ * @return  0 on success, -1 on error
+ */
+int crinitCmdTmplExpand(char ***out, const crinitCmdTmpl_t *tmpl, int argc, char *const argv[],
+                        const crinitCmdVarVals_t *vals);
+
+/**
+ * Duplicate a command template.
+ *
+ * @param out   Return pointer for the copy, NULL if \a tmpl is NULL. Must be freed using free().
+ * @param tmpl  The template to duplicate, may be NULL.
+ *
+ * @return  0 on success, -1 on error
+ */
+int crinitCmdTmplDup(crinitCmdTmpl_t **out, const crinitCmdTmpl_t *tmpl);
+
+#endif /* __CMDTMPL_H__ */
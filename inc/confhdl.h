@@ -44,6 +44,8 @@ int crinitCfgDepHandler(void *tgt, const char *val, crinitConfigType_t type);
 int crinitCfgTrigHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `TRIGGER_REARM` config directives. See crinitConfigHandler_t. **/
 int crinitCfgTrigRearmHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `READY_FD` config directives. See crinitConfigHandler_t. **/
+int crinitCfgReadyFdHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `IO_REDIRECT` config directives. See crinitConfigHandler_t. **/
 int crinitCfgIoRedirHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `NAME` config directives. See crinitConfigHandler_t. **/
@@ -54,6 +56,26 @@ int crinitCfgPrvHandler(void *tgt, const char *val, crinitConfigType_t type);
 int crinitCfgRespHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `RESPAWN_RETRIES` config directives. See crinitConfigHandler_t. **/
 int crinitCfgRespRetHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `RESPAWN_DELAY_MS` config directives. See crinitConfigHandler_t. **/
+int crinitCfgRespDelayHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `RESPAWN_DELAY_MAX_MS` config directives. See crinitConfigHandler_t. **/
+int crinitCfgRespDelayMaxHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `RESPAWN_BURST` config directives. See crinitConfigHandler_t. **/
+int crinitCfgRespBurstHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `RESPAWN_BURST_INTERVAL_MS` config directives. See crinitConfigHandler_t. **/
+int crinitCfgRespBurstIntervalHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `RESPAWN_COOLDOWN_MS` config directives. See crinitConfigHandler_t. **/
+int crinitCfgRespCooldownHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `NICE` config directives. See crinitConfigHandler_t. **/
+int crinitCfgNiceHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `SCHED_POLICY` config directives. See crinitConfigHandler_t. **/
+int crinitCfgSchedPolicyHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `CPU_AFFINITY` config directives. See crinitConfigHandler_t. **/
+int crinitCfgCpuAffinityHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `IO_PRIORITY` config directives. See crinitConfigHandler_t. **/
+int crinitCfgIoPriorityHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `OOM_SCORE_ADJ` config directives. See crinitConfigHandler_t. **/
+int crinitCfgOomScoreAdjHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `INCLUDE` config directives. See crinitConfigHandler_t. **/
 int crinitTaskIncludeHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `USER` config directives. See crinitConfigHandler_t **/
@@ -77,6 +99,10 @@ int crinitCfgInclSuffixHandler(void *tgt, const char *val, crinitConfigType_t ty
 int crinitCfgInclDirHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `SHUTDOWN_GRACE_PERIOD_US` config directives. See crinitConfigHandler_t. **/
 int crinitCfgShdGpHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `DISPATCH_WORKERS` config directives. See crinitConfigHandler_t. **/
+int crinitCfgDispWorkersHandler(void *tgt, const char *val, crinitConfigType_t type);
+/** Handler for `DISPATCH_QUEUE_DEPTH` config directives. See crinitConfigHandler_t. **/
+int crinitCfgDispQueueDepthHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `TASK_SUFFIX` config directives. See crinitConfigHandler_t. **/
 int crinitCfgTaskSuffixHandler(void *tgt, const char *val, crinitConfigType_t type);
 /** Handler for `TASKDIR` config directives. See crinitConfigHandler_t. **/
@@ -25,6 +25,10 @@
 /**  Config file key for DEFAULTCAPS global option. **/
 #define CRINIT_CONFIG_KEYSTR_DEFAULTCAPS "DEFAULTCAPS"
 #endif
+/**  Config file key for DISPATCH_QUEUE_DEPTH global option. **/
+#define CRINIT_CONFIG_KEYSTR_DISPATCH_QUEUE_DEPTH "DISPATCH_QUEUE_DEPTH"
+/**  Config file key for DISPATCH_WORKERS global option. **/
+#define CRINIT_CONFIG_KEYSTR_DISPATCH_WORKERS "DISPATCH_WORKERS"
 /**  Config file key for INCLUDEDIR global option. **/
 #define CRINIT_CONFIG_KEYSTR_INCLDIR "INCLUDEDIR"
 /**  Config file key for SHUTDOWN_GRACE_PERIOD_US global option **/
@@ -73,14 +77,36 @@
 #define CRINIT_CONFIG_KEYSTR_INCLUDE "INCLUDE"
 /**  Config key for IO redirections. **/
 #define CRINIT_CONFIG_KEYSTR_IOREDIR "IO_REDIRECT"
+/**  Config key to set the CPUs the task's commands may run on. **/
+#define CRINIT_CONFIG_KEYSTR_CPU_AFFINITY "CPU_AFFINITY"
+/**  Config key to set the I/O scheduling class and priority of the task's commands. **/
+#define CRINIT_CONFIG_KEYSTR_IO_PRIORITY "IO_PRIORITY"
+/**  Config key to set the nice value of the task's commands. **/
+#define CRINIT_CONFIG_KEYSTR_NICE "NICE"
+/**  Config key to adjust the OOM killer score of the task's commands. **/
+#define CRINIT_CONFIG_KEYSTR_OOM_SCORE_ADJ "OOM_SCORE_ADJ"
+/**  Config key to set the scheduling policy and priority of the task's commands. **/
+#define CRINIT_CONFIG_KEYSTR_SCHED_POLICY "SCHED_POLICY"
 /**  Config key for the task name. **/
 #define CRINIT_CONFIG_KEYSTR_NAME "NAME"
 /**  Config key for provided features. **/
 #define CRINIT_CONFIG_KEYSTR_PROVIDES "PROVIDES"
+/**  Config key to pass a readiness notification pipe to the task's commands. **/
+#define CRINIT_CONFIG_KEYSTR_READY_FD "READY_FD"
 /**  Config key to set a task to be respawning. **/
 #define CRINIT_CONFIG_KEYSTR_RESPAWN "RESPAWN"
 /**  Config key to set how often a task is allowed to respawn on failure. **/
 #define CRINIT_CONFIG_KEYSTR_RESPAWN_RETRIES "RESPAWN_RETRIES"
+/**  Config key to set how many times a task may be started within RESPAWN_BURST_INTERVAL_MS. **/
+#define CRINIT_CONFIG_KEYSTR_RESPAWN_BURST "RESPAWN_BURST"
+/**  Config key to set the interval RESPAWN_BURST applies to. **/
+#define CRINIT_CONFIG_KEYSTR_RESPAWN_BURST_INTERVAL "RESPAWN_BURST_INTERVAL_MS"
+/**  Config key to set how long a task waits before respawning after exceeding RESPAWN_BURST. **/
+#define CRINIT_CONFIG_KEYSTR_RESPAWN_COOLDOWN "RESPAWN_COOLDOWN_MS"
+/**  Config key to set the initial delay before a task is respawned. **/
+#define CRINIT_CONFIG_KEYSTR_RESPAWN_DELAY "RESPAWN_DELAY_MS"
+/**  Config key to set the maximum delay before a task is respawned. **/
+#define CRINIT_CONFIG_KEYSTR_RESPAWN_DELAY_MAX "RESPAWN_DELAY_MAX_MS"
 /**  Config key to add a stop command to the task. **/
 #define CRINIT_CONFIG_KEYSTR_STOP_COMMAND "STOP_COMMAND"
 /**  Config key to set a specific user to run task's commands. **/
@@ -128,6 +154,10 @@
 #endif
 /**  Default value for SHUTDOWN_GRACE_PERIOD_US global option **/
 #define CRINIT_CONFIG_DEFAULT_SHDGRACEP 100000uLL
+/**  Default value for DISPATCH_QUEUE_DEPTH global option **/
+#define CRINIT_CONFIG_DEFAULT_DISPATCH_QUEUE_DEPTH 128uLL
+/**  Default value for DISPATCH_WORKERS global option **/
+#define CRINIT_CONFIG_DEFAULT_DISPATCH_WORKERS 8uLL
 /**  Default value for USE_SYSLOG global option. **/
 #define CRINIT_CONFIG_DEFAULT_USE_SYSLOG false
 /**  Default value for USE_ELOS global option. **/
@@ -151,11 +181,14 @@
 /** Enumeration of all configuration keys. Goes together with crinitTaskCfgMap and crinitSeriesCfgMap. **/
 typedef enum crinitConfigs {
     CRINIT_CONFIG_COMMAND = 0,
+    CRINIT_CONFIG_CPU_AFFINITY,
     CRINIT_CONFIG_DEBUG,
 #ifdef ENABLE_CAPABILITIES
     CRINIT_CONFIG_DEFAULTCAPS,
 #endif
     CRINIT_CONFIG_DEPENDS,
+    CRINIT_CONFIG_DISPATCH_QUEUE_DEPTH,
+    CRINIT_CONFIG_DISPATCH_WORKERS,
     CRINIT_CONFIG_ELOS_EVENT_POLL_INTERVAL,
     CRINIT_CONFIG_ELOS_PORT,
     CRINIT_CONFIG_ELOS_SERVER,
@@ -165,11 +198,21 @@ typedef enum crinitConfigs {
     CRINIT_CONFIG_INCLUDE,
     CRINIT_CONFIG_INCLUDE_SUFFIX,
     CRINIT_CONFIG_INCLUDEDIR,
+    CRINIT_CONFIG_IO_PRIORITY,
     CRINIT_CONFIG_IOREDIR,
     CRINIT_CONFIG_NAME,
+    CRINIT_CONFIG_NICE,
+    CRINIT_CONFIG_OOM_SCORE_ADJ,
     CRINIT_CONFIG_PROVIDES,
+    CRINIT_CONFIG_READY_FD,
     CRINIT_CONFIG_RESPAWN,
+    CRINIT_CONFIG_RESPAWN_BURST,
+    CRINIT_CONFIG_RESPAWN_BURST_INTERVAL,
+    CRINIT_CONFIG_RESPAWN_COOLDOWN,
+    CRINIT_CONFIG_RESPAWN_DELAY,
+    CRINIT_CONFIG_RESPAWN_DELAY_MAX,
     CRINIT_CONFIG_RESPAWN_RETRIES,
+    CRINIT_CONFIG_SCHED_POLICY,
     CRINIT_CONFIG_SHDGRACEP,
     CRINIT_CONFIG_SIGKEYDIR,
     CRINIT_CONFIG_SIGNATURES,
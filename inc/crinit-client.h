@@ -84,15 +84,56 @@ void crinitClientSetSocketPath(const char *sockFile);
  */
 int crinitClientSetVerbose(bool v);
 
+/**
+ * Opaque type of a persistent connection to Crinit, see crinitClientConnOpen().
+ */
+typedef struct crinitClientConn crinitClientConn_t;
+/**
+ * Opens a persistent connection to Crinit.
+ *
+ * Without a connection, every request connects to Crinit on its own. A connection avoids the cost of connecting and of
+ * the initial handshake for all but the first request, which is useful for clients issuing many requests, e.g. to poll
+ * the status of tasks. To use it, bind it to the calling thread using crinitClientConnBind().
+ *
+ * The connection uses the socket path set by crinitClientSetSocketPath() at the time of the call. If Crinit closes the
+ * connection, it is transparently reopened by the next request.
+ *
+ * @param conn  Return pointer for the connection. Must be closed using crinitClientConnClose().
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitClientConnOpen(crinitClientConn_t **conn);
+/**
+ * Closes a persistent connection to Crinit.
+ *
+ * If the connection is bound to the calling thread, it is unbound. It must not be bound to any other thread.
+ *
+ * @param conn  The connection to close, may be NULL.
+ */
+void crinitClientConnClose(crinitClientConn_t *conn);
+/**
+ * Binds a persistent connection to the calling thread.
+ *
+ * All requests of the crinit-client library issued by the calling thread, including sd_notify(), then use \a conn
+ * instead of connecting to Crinit each time. A connection must only be bound to a single thread at a time.
+ *
+ * @param conn  The connection to bind, or NULL to go back to a new connection per request.
+ */
+void crinitClientConnBind(crinitClientConn_t *conn);
+
 /**
  * Notifies Crinit of task state changes.
  *
- * Partially implements the SD_NOTIFY interface of systemd. Specifically, the commands READY and MAINPID are supported.
- * Others are currently unimplemented and will be ignored. The \a unset_environment argument is also unimplemented, i.e.
- * the environment will not be unset. If \a unset_environment is not 0, a warning will be printed.
+ * Partially implements the SD_NOTIFY interface of systemd. Specifically, the commands READY, STOPPING, MAINPID and
+ * STATUS are supported. Others are currently unimplemented and will be ignored. The \a unset_environment argument is
+ * also unimplemented, i.e. the environment will not be unset. If \a unset_environment is not 0, a warning will be
+ * printed.
  *
- * READY=1 lets Crinit know the task is currently running. MAINPID=[pid] tells Crinit its PID. Delimiting character is a
- * newline.
+ * READY=1 lets Crinit know the task is currently running. STOPPING=1 lets Crinit know the task has finished its work.
+ * MAINPID=[pid] tells Crinit its PID. STATUS=[text] is logged by Crinit. Delimiting character is a newline.
+ *
+ * If the task uses the READY_FD option, the state string is written to the pipe given by the environment variable
+ * #CRINIT_ENV_READY_FD. Otherwise, or if that fails, it is sent over Crinit's socket.
  *
  * Example: `"READY=1\nMAINPID=42"` will update the task's state to #CRINIT_TASK_STATE_RUNNING and its PID to 42.
  *
@@ -240,7 +281,23 @@ int crinitClientTaskGetStatus(crinitTaskState_t *s, pid_t *pid, struct timespec
                               struct timespec *et, gid_t *gid, uid_t *uid, char **username, char **groupname,
                               const char *taskName);
 /**
- * Request Crinit to report the list of task names from its TaskDB.
+ * Request Crinit to report the resource usage of a task from its TaskDB.
+ *
+ * The CPU times and context switches are the sums over all processes of the task which have been reaped so far,
+ * including previous runs of respawned tasks. The maximum resident set size is the largest of these processes.
+ *
+ * @param usage     Return pointer for the task's resource usage.
+ * @param taskName  The name of the task.
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitClientTaskGetUsage(crinitTaskUsage_t *usage, const char *taskName);
+/**
+ * Request Crinit to report the list of tasks in its TaskDB along with their status.
+ *
+ * Uses crinitClientGetTaskStatusList() without a filter. If Crinit does not support it, falls back to querying the
+ * list of task names and then the status of each task in a separate request. In that case,
+ * crinitTaskListEntry_t::failCount is always 0.
  *
  * The returned object should be freed with crinitClientFreeTaskList().
  *
@@ -250,11 +307,47 @@ int crinitClientTaskGetStatus(crinitTaskState_t *s, pid_t *pid, struct timespec
  */
 int crinitClientGetTaskList(crinitTaskList_t **tl);
 /**
- * Free the list of tasks obtained from crinitClientGetTaskList().
+ * Request Crinit to report the status of all tasks in its TaskDB matching a filter in a single request.
+ *
+ * Crinit takes the status of all selected tasks as one consistent snapshot. Tasks are selected if they have at least
+ * one of the state bits in crinitTaskListFilter_t::stateMask set (CRINIT_TASKLIST_FILTER_LOADED selects tasks which
+ * never ran) and their name starts with crinitTaskListFilter_t::prefix. If crinitTaskListFilter_t::names is given, the
+ * list contains the named tasks in the given order, names of tasks not loaded by Crinit are skipped.
+ *
+ * The returned object should be freed with crinitClientFreeTaskList().
+ *
+ * @param tl      Return pointer for the list of tasks.
+ * @param filter  The tasks to report, may be NULL to report all tasks.
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitClientGetTaskStatusList(crinitTaskList_t **tl, const crinitTaskListFilter_t *filter);
+/**
+ * Free the list of tasks obtained from crinitClientGetTaskList() or crinitClientGetTaskStatusList().
  *
  * @param tl    The list of tasks.
  */
 void crinitClientFreeTaskList(crinitTaskList_t *tl);
+/**
+ * Request Crinit to report the analysis of the dependency graph formed by the tasks in its TaskDB.
+ *
+ * For each task, the result contains its topological level, the length of its critical path in microseconds, the
+ * resulting spawn priority and flags indicating dependency cycles, tasks blocked by a cycle, and dependencies no loaded
+ * task can fulfill (see CRINIT_DEPGRAPH_CYCLE, CRINIT_DEPGRAPH_BLOCKED, and CRINIT_DEPGRAPH_DANGLING).
+ *
+ * The returned object should be freed with crinitClientFreeDepGraph().
+ *
+ * @param graph  Return pointer for the dependency graph analysis.
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitClientGetDepGraph(crinitDepGraph_t **graph);
+/**
+ * Free the dependency graph analysis obtained from crinitClientGetDepGraph().
+ *
+ * @param graph  The dependency graph analysis.
+ */
+void crinitClientFreeDepGraph(crinitDepGraph_t *graph);
 /**
  * Request Crinit to initiate an immediate shutdown or reboot.
  *
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file dispqueue.h
+ * @brief Header defining the bounded FIFO queue between the Process Dispatcher and its worker threads.
+ */
+#ifndef __DISPQUEUE_H__
+#define __DISPQUEUE_H__
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Bounded FIFO queue of jobs waiting for a dispatch worker thread.
+ */
+typedef struct crinitDispatchQueue {
+    void **jobs;              ///< Ring buffer of queued jobs.
+    size_t size;              ///< Capacity of the ring buffer.
+    size_t head;              ///< Position of the oldest queued job in the ring buffer.
+    size_t items;             ///< Number of queued jobs.
+    pthread_mutex_t lock;     ///< Mutex protecting the queue.
+    pthread_cond_t jobAvail;  ///< Condition variable signalled if a job has been queued.
+} crinitDispatchQueue_t;
+
+/**
+ * Initialize a dispatch queue.
+ *
+ * Modifies errno.
+ *
+ * @param q     The queue to initialize.
+ * @param size  The maximum number of queued jobs, must be at least 1.
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitDispatchQueueInit(crinitDispatchQueue_t *q, size_t size);
+
+/**
+ * Free the resources of a dispatch queue.
+ *
+ * Jobs still in the queue are not freed. No thread may wait in crinitDispatchQueuePop() anymore.
+ *
+ * @param q  The queue to destroy.
+ */
+void crinitDispatchQueueDestroy(crinitDispatchQueue_t *q);
+
+/**
+ * Append a job to a dispatch queue.
+ *
+ * Never waits for free space, so it can be called while holding locks the worker threads need to make progress.
+ *
+ * Modifies errno.
+ *
+ * @param q    The queue.
+ * @param job  The job to append.
+ *
+ * @return 0 on success, -1 on error. errno is set to EAGAIN if the queue is full.
+ */
+int crinitDispatchQueuePush(crinitDispatchQueue_t *q, void *job);
+
+/**
+ * Take the oldest job from a dispatch queue, waiting until there is one.
+ *
+ * @param q        The queue.
+ * @param wasFull  Return pointer, set to true if the queue was full before the job was taken, so that a caller of
+ *                 crinitDispatchQueuePush() may have been rejected since and should be told there is space again.
+ *                 May be NULL.
+ *
+ * @return  The job.
+ */
+void *crinitDispatchQueuePop(crinitDispatchQueue_t *q, bool *wasFull);
+
+#endif /* __DISPQUEUE_H__ */
@@ -36,6 +36,8 @@ typedef struct crinitGlobOptStore {
     char **tasks;                              ///< Value for the TASKS global option.
     char *launcherCmd;                         ///< Value for the LAUNCHER_CMD global option.
     unsigned long long shdGraceP;              ///< Value for the SHUTDOWN_GRACE_PERIOD_US global option.
+    unsigned long long dispWorkers;            ///< Value for the DISPATCH_WORKERS global option.
+    unsigned long long dispQueueDepth;         ///< Value for the DISPATCH_QUEUE_DEPTH global option.
     crinitEnvSet_t globEnv;                    ///< Storage for global task environment variables.
     crinitEnvSet_t globFilters;                ///< Storage for global task filter variables.
 #ifdef ENABLE_CAPABILITIES
@@ -63,6 +65,8 @@ typedef struct crinitGlobOptStore {
 #define CRINIT_GLOBOPT_TASKS tasks                                     ///< TASKS global option
 #define CRINIT_GLOBOPT_LAUNCHER_CMD launcherCmd                        ///< LAUNCHER_CMD global option
 #define CRINIT_GLOBOPT_SHDGRACEP shdGraceP                             ///< SHUTDOWN_GRACE_PERIOD_US global option
+#define CRINIT_GLOBOPT_DISPATCH_WORKERS dispWorkers                    ///< DISPATCH_WORKERS global option
+#define CRINIT_GLOBOPT_DISPATCH_QUEUE_DEPTH dispQueueDepth             ///< DISPATCH_QUEUE_DEPTH global option
 #define CRINIT_GLOBOPT_ENV globEnv                                     ///< Reference to the global task environment
 #define CRINIT_GLOBOPT_FILTERS globFilters                             ///< Reference to the global task filters
 #define CRINIT_GLOBOPT_SIGNATURES signatures  ///< Reference to global setting of signature checking.
@@ -275,4 +279,15 @@ int crinitGlobOptGetUnsignedLL(size_t memberOffset, unsigned long long *val);
  */
 int crinitGlobOptGetEnvSet(size_t memberOffset, crinitEnvSet_t *val);
 
+/**
+ * Get the number of changes made to the global option storage so far.
+ *
+ * Allows other modules to detect if data they have derived from global options is out of date. Counts every call to
+ * one of the crinitGlobOptSet*() functions and crinitGlobOptDestroy(), but not changes made through
+ * crinitGlobOptBorrow(). Thread-safe and lock-free.
+ *
+ * @return  The number of changes.
+ */
+unsigned long long crinitGlobOptGetGeneration(void);
+
 #endif /* __GLOBOPT_H__ */
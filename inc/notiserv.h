@@ -11,8 +11,9 @@
 /**
  * Starts the Notification and Service interface socket server.
  *
- * Will create the AF_UNIX socket for clients to connect to and spawn a number of worker threads to service incoming
- * connections (see notiserv.c and thrpool.h).
+ * Will create the AF_UNIX socket for clients to connect to and spawn a small, fixed number of threads to service
+ * incoming connections using a shared epoll instance, so that many clients can be handled concurrently. Commands which
+ * read configuration files are executed by separate worker threads (see notiserv.c and thrpool.h).
  *
  * @param ctx       Pointer to the crinitTaskDB_t which the Server should use for incoming requests.
  * @param sockfile  Path where to create the AF_UNIX socket file.
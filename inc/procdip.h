@@ -6,21 +6,17 @@
 #ifndef __PROCDIP_H__
 #define __PROCDIP_H__
 
-#include <limits.h>
-
 #include "taskdb.h"
 
-/**
- * Stack size for process dispatch threads.
- */
-#define CRINIT_PROC_DISPATCH_THREAD_STACK_SIZE (PTHREAD_STACK_MIN + 112 * 1024)
-
 /**
  * Process dispatcher function to spawn a task that is ready.
  *
- * Will create a new thread to handle process spawning of task \a t and status updates of \a ctx. The function will
- * return successfully if the thread has been created without error. The thread is created in a detached state so no
- * further management action is necessary.
+ * Queues task \a t for one of the dispatch worker threads which handles process spawning of the task and status updates
+ * of \a ctx. The worker threads are started on the first call and their number is set by the `DISPATCH_WORKERS` global
+ * option. The function never blocks, so it can be called while holding crinitTaskDB_t::lock. If the dispatch queue
+ * already holds `DISPATCH_QUEUE_DEPTH` tasks, the function fails with errno set to EAGAIN and the caller should retry
+ * later. A worker thread is done with a task as soon as its first command is running, the task's processes are then
+ * watched by the Process Supervisor (see procsup.h), which also starts the remaining commands.
  *
  * Modifies errno.
  *
@@ -35,8 +31,8 @@ int crinitProcDispatchSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crin
 /**
  * Turn waiting for child processes on or off.
  *
- * If \a inh is set to true, the process dispatch threads will block before waiting for a child process until
- * waiting is reactivated, leaving terminated child processes as zombies for the time being.
+ * If \a inh is set to true, the Process Supervisor and the dispatch worker threads will block before reaping a child
+ * process until waiting is reactivated, leaving terminated child processes as zombies for the time being.
  *
  * Modifies errno.
  *
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file procspawn.h
+ * @brief Header related to spawning processes with changed credentials without the help of crinit-launch.
+ *
+ * Processes are created using clone3() and, if a target cgroup is given, placed into it atomically with
+ * `CLONE_INTO_CGROUP`. The child then sets up IO redirections, scheduling parameters, groups, user and capabilities in
+ * the same way as crinit-launch does before it executes the target command. This saves the additional execve() of
+ * crinit-launch and the dynamic loading that comes with it. The child only uses raw system calls between clone3() and
+ * execve(), as the parent is multi-threaded.
+ */
+#ifndef __PROCSPAWN_H__
+#define __PROCSPAWN_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "ioredir.h"
+#include "schedparam.h"
+
+/**
+ * Type to store the credentials, the cgroup, and the scheduling parameters a process shall be spawned with.
+ */
+typedef struct crinitProcSpawnCreds {
+    uid_t user;                        ///< The user ID to run the process with.
+    gid_t group;                       ///< The group ID to run the process with.
+    const gid_t *supGroups;            ///< Array of supplementary group IDs, may be NULL if supGroupsSize is 0.
+    size_t supGroupsSize;              ///< Number of elements in supGroups.
+    bool setCaps;                      ///< If true, the process will keep the capabilities in caps over the change of
+                                       ///< user.
+    uint64_t caps;                     ///< Bitmask of capabilities to set as inheritable and ambient capabilities.
+    int cgroupFd;                      ///< Open directory file descriptor of the target cgroup, -1 to stay in
+                                       ///< crinit's cgroup.
+    const crinitSchedParams_t *sched;  ///< Scheduling parameters to apply before the change of user, may be NULL.
+} crinitProcSpawnCreds_t;
+
+/**
+ * Spawn a new process with the given credentials, IO redirections, and cgroup.
+ *
+ * The child process does the same as crinit-launch would do with the equivalent parameters, see
+ * crinitCreateLauncherParameters(). If the running kernel does not support clone3() or `CLONE_INTO_CGROUP` (the latter
+ * only matters if crinitProcSpawnCreds_t::cgroupFd is set), the function fails with errno set to ENOSYS and remembers
+ * this for subsequent calls. The same happens, without remembering, if crinitProcSpawnCreds_t::cgroupFd does not refer
+ * to a cgroup v2 directory. The caller should fall back to crinit-launch in these cases.
+ *
+ * The function returns after the child has either executed \a path or failed to do so, in which case the child has
+ * been reaped and errno is set to the cause of the failure.
+ *
+ * FIFOs used in IO redirections must already exist, the dispatcher creates them when it prepares a task.
+ *
+ * Modifies errno.
+ *
+ * @param pid         Return pointer for the PID of the new process.
+ * @param path        Absolute path to the executable.
+ * @param argv        Argument vector for the new process, NULL-terminated.
+ * @param envp        Environment for the new process, NULL-terminated, or NULL for an empty environment.
+ * @param redirs      Array of IO redirections to apply in the child, may be NULL if \a redirsSize is 0.
+ * @param redirsSize  Number of elements in \a redirs.
+ * @param creds       The credentials and the cgroup of the new process.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitProcSpawn(pid_t *pid, const char *path, char *const argv[], char *const envp[], const crinitIoRedir_t *redirs,
+                    size_t redirsSize, const crinitProcSpawnCreds_t *creds);
+
+#endif /* __PROCSPAWN_H__ */
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file procsup.h
+ * @brief Header related to the Process Supervisor.
+ *
+ * The Process Supervisor is a single thread watching all child processes started by Crinit using process file
+ * descriptors (pidfds) and epoll. Once a watched process terminates, a callback registered along with it is run on the
+ * supervisor thread. This way, no thread needs to block for the lifetime of a child process and the number of threads
+ * does not grow with the number of running tasks.
+ *
+ * The same thread can also watch other file descriptors for incoming data, e.g. the readiness pipes of tasks using
+ * `READY_FD`, see crinitProcSupWatchFd().
+ */
+#ifndef __PROCSUP_H__
+#define __PROCSUP_H__
+
+#include <limits.h>
+#include <signal.h>
+#include <sys/types.h>
+
+/**
+ * Stack size of the supervisor thread.
+ */
+#define CRINIT_PROC_SUPERVISOR_THREAD_STACK_SIZE (PTHREAD_STACK_MIN + 112 * 1024)
+/**
+ * Maximum number of process terminations handled per call to epoll_wait().
+ */
+#define CRINIT_PROC_SUPERVISOR_MAX_EVENTS 16
+
+/**
+ * Callback to run once a watched process has terminated.
+ *
+ * Runs on the supervisor thread, so it should not block for long. The process is left as a zombie and must be reaped
+ * by the callback (or later). The callback may call crinitProcSupWatch() to watch further processes.
+ *
+ * @param pid     The PID of the terminated process.
+ * @param status  The status of the terminated process as reported by waitid(), NULL if it could not be retrieved.
+ * @param arg     The argument given to crinitProcSupWatch().
+ */
+typedef void (*crinitProcSupCallback_t)(pid_t pid, const siginfo_t *status, void *arg);
+
+/**
+ * Callback to run whenever a watched file descriptor is readable.
+ *
+ * Runs on the supervisor thread, so it should not block for long. The descriptor is watched level-triggered, so the
+ * callback should read all available data, ideally from a non-blocking descriptor. The callback must not call
+ * crinitProcSupWatchFd() or crinitProcSupUnwatchFd().
+ *
+ * @param fd   The readable file descriptor.
+ * @param arg  The argument given to crinitProcSupWatchFd().
+ */
+typedef void (*crinitProcSupFdCallback_t)(int fd, void *arg);
+
+/**
+ * Watch a child process and run a callback once it has terminated.
+ *
+ * Starts the supervisor thread on first use. \a pid must be a child of the calling process which has not been reaped
+ * yet. If the process has already terminated, the callback runs as soon as possible.
+ *
+ * If the kernel does not support pidfds, the function fails with errno set to ENOSYS without printing an error. In
+ * that case, the caller needs to wait for the process itself.
+ *
+ * Modifies errno.
+ *
+ * @param pid  The PID of the process to watch.
+ * @param cb   The callback to run once the process has terminated.
+ * @param arg  Argument to pass to \a cb.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitProcSupWatch(pid_t pid, crinitProcSupCallback_t cb, void *arg);
+
+/**
+ * Watch a file descriptor and run a callback whenever it is readable.
+ *
+ * Starts the supervisor thread on first use. The descriptor is watched until crinitProcSupUnwatchFd() is called for
+ * it and must stay open until then.
+ *
+ * If the kernel does not support pidfds, the supervisor thread does not run and the function fails with errno set to
+ * ENOSYS without printing an error.
+ *
+ * Modifies errno.
+ *
+ * @param fd   The file descriptor to watch.
+ * @param cb   The callback to run if \a fd is readable.
+ * @param arg  Argument to pass to \a cb.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitProcSupWatchFd(int fd, crinitProcSupFdCallback_t cb, void *arg);
+
+/**
+ * Stop watching a file descriptor.
+ *
+ * Once the function has returned, the callback given to crinitProcSupWatchFd() is not running and will not run again,
+ * so its argument may be freed and \a fd may be closed. Can be called from any thread, including from a
+ * crinitProcSupCallback_t.
+ *
+ * @param fd  The file descriptor given to crinitProcSupWatchFd().
+ *
+ * @return 0 on success, -1 if \a fd is not watched
+ */
+int crinitProcSupUnwatchFd(int fd);
+
+#endif /* __PROCSUP_H__ */
@@ -6,6 +6,9 @@
 #ifndef __RTIMCMD_H__
 #define __RTIMCMD_H__
 
+#include <stdint.h>
+#include <time.h>
+
 #include "rtimopmap.h"
 #include "taskdb.h"
 
@@ -17,13 +20,56 @@
 #define CRINIT_RTIMCMD_RES_OK "RES_OK"    ///< Value of first argument in a positive (successful) response message.
 #define CRINIT_RTIMCMD_RES_ERR "RES_ERR"  ///< Value of first argument in a negative (unsuccessful) response message.
 
+#define CRINIT_RTIMCMD_FILTER_STATE "state="    ///< Start of a STATUSLIST argument selecting tasks by state mask.
+#define CRINIT_RTIMCMD_FILTER_PREFIX "prefix="  ///< Start of a STATUSLIST argument selecting tasks by name prefix.
+#define CRINIT_RTIMCMD_FILTER_NAME "name="      ///< Start of a STATUSLIST argument selecting a task by name.
+
+/**
+ * Types of the arguments of a command or response message.
+ *
+ * Arguments of commands are always strings. Responses may contain numerical arguments which keep their type if the
+ * message is transferred using the binary encoding, see crinitRtimCmdToMsgBin(). Using the text encoding, all
+ * arguments are received as strings, so numerical arguments should be read using crinitRtimArgGetInt(),
+ * crinitRtimArgGetUInt(), or crinitRtimArgGetTime() which accept both.
+ */
+typedef enum crinitRtimArgType {
+    CRINIT_RTIMARG_TYPE_STR = 1,  ///< A null-terminated string, see crinitRtimArg_t::str.
+    CRINIT_RTIMARG_TYPE_INT,      ///< A signed integer, see crinitRtimArg_t::num.
+    CRINIT_RTIMARG_TYPE_UINT,     ///< An unsigned integer, see crinitRtimArg_t::unum.
+    CRINIT_RTIMARG_TYPE_TIME,     ///< A point in time, see crinitRtimArg_t::time.
+} crinitRtimArgType_t;
+
+/**
+ * A typed argument of a command or response message.
+ */
+typedef struct crinitRtimArg {
+    crinitRtimArgType_t type;  ///< The type of the argument, selects the valid member of the union.
+    union {
+        const char *str;       ///< Value of a #CRINIT_RTIMARG_TYPE_STR argument.
+        int64_t num;           ///< Value of a #CRINIT_RTIMARG_TYPE_INT argument.
+        uint64_t unum;         ///< Value of a #CRINIT_RTIMARG_TYPE_UINT argument.
+        struct timespec time;  ///< Value of a #CRINIT_RTIMARG_TYPE_TIME argument.
+    };
+} crinitRtimArg_t;
+
+/** Initializer for a #CRINIT_RTIMARG_TYPE_STR argument. **/
+#define CRINIT_RTIMARG_STR(s) {.type = CRINIT_RTIMARG_TYPE_STR, .str = (s)}
+/** Initializer for a #CRINIT_RTIMARG_TYPE_INT argument. **/
+#define CRINIT_RTIMARG_INT(n) {.type = CRINIT_RTIMARG_TYPE_INT, .num = (int64_t)(n)}
+/** Initializer for a #CRINIT_RTIMARG_TYPE_UINT argument. **/
+#define CRINIT_RTIMARG_UINT(n) {.type = CRINIT_RTIMARG_TYPE_UINT, .unum = (uint64_t)(n)}
+/** Initializer for a #CRINIT_RTIMARG_TYPE_TIME argument. **/
+#define CRINIT_RTIMARG_TIME(ts) {.type = CRINIT_RTIMARG_TYPE_TIME, .time = (ts)}
+
 /**
  * Structure holding a command or response message with its crinitRtimOp_t opcode and arguments array.
+ *
+ * The argument array and the strings it points to are a single allocation.
  */
 typedef struct crinitRtimCmd {
-    crinitRtimOp_t op;  ///< The command or response opcode (see rtimopmap.h).
-    size_t argc;        ///< The number of arguments.
-    char **args;        ///< String array of arguments.
+    crinitRtimOp_t op;      ///< The command or response opcode (see rtimopmap.h).
+    size_t argc;            ///< The number of arguments.
+    crinitRtimArg_t *args;  ///< Array of arguments.
 } crinitRtimCmd_t;
 
 /**
@@ -41,7 +87,34 @@ typedef struct crinitRtimCmd {
  */
 int crinitBuildRtimCmd(crinitRtimCmd_t *c, crinitRtimOp_t op, size_t argc, ...);
 /**
- * Free memory in an crinitRtimCmd_t allocated by crinitBuildRtimCmd() or crinitParseRtimCmd().
+ * Create an crinitRtimCmd_t from an opcode and an array of typed arguments.
+ *
+ * The values of string arguments are copied. Memory should be freed using crinitDestroyRtimCmd() when no longer
+ * needed.
+ *
+ * @param c     The crinitRtimCmd_t to build.
+ * @param op    The opcode of the command or response.
+ * @param argc  The number of arguments to the command/response.
+ * @param args  Array of \a argc arguments.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitBuildRtimCmdArgs(crinitRtimCmd_t *c, crinitRtimOp_t op, size_t argc, const crinitRtimArg_t args[]);
+/**
+ * Create an crinitRtimCmd_t from an opcode and an array of strings.
+ *
+ * The strings are copied. Memory should be freed using crinitDestroyRtimCmd() when no longer needed.
+ *
+ * @param c     The crinitRtimCmd_t to build.
+ * @param op    The opcode of the command or response.
+ * @param argc  The number of arguments to the command/response.
+ * @param args  Array of \a argc strings.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitBuildRtimCmdArray(crinitRtimCmd_t *c, crinitRtimOp_t op, int argc, const char *args[]);
+/**
+ * Free memory in an crinitRtimCmd_t allocated by one of the crinitBuildRtimCmd() or crinitParseRtimCmd() functions.
  *
  * Will free the memory for the argument array in the structure.
  *
@@ -56,7 +129,7 @@ int crinitDestroyRtimCmd(crinitRtimCmd_t *c);
  *
  * The string must be of the form `<OPCODE_STRING>\nARG1\n...\nARGn`. The mapping of an opcode to a string
  * representation is done in rtimopmap.h. crinitRtimCmdToMsgStr() can be used to obtain such a string from an
- * crinitRtimCmd_t.
+ * crinitRtimCmd_t. All arguments will be of type #CRINIT_RTIMARG_TYPE_STR.
  *
  * Will allocate memory for the argument array inside the output command which should be freed using
  * crinitDestroyRtimCmd().
@@ -70,8 +143,9 @@ int crinitParseRtimCmd(crinitRtimCmd_t *out, const char *cmdStr);
 /**
  * Generates a string representation of an crinitRtimCmd_t.
  *
- * The generated string will be in a format parse-able by crinitParseRtimCmd(). Memory for the string will be allocated
- * using malloc() and should be freed using free() once no longer used.
+ * The generated string will be in a format parse-able by crinitParseRtimCmd(). Numerical arguments are formatted as
+ * decimal numbers, points in time as `<sec>.<nsec>`. Memory for the string will be allocated using malloc() and should
+ * be freed using free() once no longer used.
  *
  * @param out     Pointer to the output string.
  * @param outLen  Size of the output string including the terminating zero.
@@ -80,6 +154,75 @@ int crinitParseRtimCmd(crinitRtimCmd_t *out, const char *cmdStr);
  * @return 0 on success, -1 otherwise
  */
 int crinitRtimCmdToMsgStr(char **out, size_t *outLen, const crinitRtimCmd_t *cmd);
+/**
+ * Parses a binary message into an crinitRtimCmd_t.
+ *
+ * The message must have been generated by crinitRtimCmdToMsgBin(). Will allocate memory for the argument array inside
+ * the output command which should be freed using crinitDestroyRtimCmd().
+ *
+ * @param out     The crinitRtimCmd_t to create.
+ * @param msg     The message to parse.
+ * @param msgLen  Size of the message in bytes.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitParseRtimCmdBin(crinitRtimCmd_t *out, const void *msg, size_t msgLen);
+/**
+ * Generates a binary representation of an crinitRtimCmd_t.
+ *
+ * Unlike the text encoding, arguments keep their type and may contain any character. The encoding consists of, in host
+ * byte order:
+ *  - the opcode as uint32_t,
+ *  - the number of arguments as uint32_t,
+ *  - for each argument, its type as uint8_t, the size of its value as uint32_t, and the value. A string is stored
+ *    without its terminating zero, an integer as int64_t or uint64_t, and a point in time as two int64_t holding the
+ *    seconds and nanoseconds.
+ *
+ * Memory for the message will be allocated using malloc() and should be freed using free() once no longer used.
+ *
+ * @param out     Pointer to the output message.
+ * @param outLen  Size of the output message in bytes.
+ * @param cmd     The crinitRtimCmd_t to generate the message from.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitRtimCmdToMsgBin(void **out, size_t *outLen, const crinitRtimCmd_t *cmd);
+/**
+ * Get the value of a string argument.
+ *
+ * @param a    The argument.
+ * @param out  Return pointer for the string, points into \a a.
+ *
+ * @return 0 on success, -1 if \a a is not a string
+ */
+int crinitRtimArgGetStr(const crinitRtimArg_t *a, const char **out);
+/**
+ * Get the value of a signed integer argument, also if it has been transferred as a string or unsigned integer.
+ *
+ * @param a    The argument.
+ * @param out  Return pointer for the value.
+ *
+ * @return 0 on success, -1 if \a a does not hold a signed integer
+ */
+int crinitRtimArgGetInt(const crinitRtimArg_t *a, int64_t *out);
+/**
+ * Get the value of an unsigned integer argument, also if it has been transferred as a string or signed integer.
+ *
+ * @param a    The argument.
+ * @param out  Return pointer for the value.
+ *
+ * @return 0 on success, -1 if \a a does not hold an unsigned integer
+ */
+int crinitRtimArgGetUInt(const crinitRtimArg_t *a, uint64_t *out);
+/**
+ * Get the value of a point in time argument, also if it has been transferred as a string of the form `<sec>.<nsec>`.
+ *
+ * @param a    The argument.
+ * @param out  Return pointer for the value.
+ *
+ * @return 0 on success, -1 if \a a does not hold a point in time
+ */
+int crinitRtimArgGetTime(const crinitRtimArg_t *a, struct timespec *out);
 /**
  * Executes an crinitRtimCmd_t if it contains a valid command.
  *
@@ -13,7 +13,7 @@
  */
 #define crinitGenOpMap(f)                                                                                   \
     f(ADDTASK) f(ADDSERIES) f(ENABLE) f(DISABLE) f(STOP) f(KILL) f(RESTART) f(NOTIFY) f(STATUS) f(TASKLIST) \
-        f(SHUTDOWN) f(GETVER)
+        f(SHUTDOWN) f(GETVER) f(DEPGRAPH) f(USAGE) f(STATUSLIST)
 /**
  * Macro to generate the opcode enum for crinitGenOpMap().
  *
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file schedparam.h
+ * @brief Header related to per-task scheduling parameters like nice value, CPU affinity, and I/O priority.
+ *
+ * The parameters are parsed from the task configuration and applied in the new process before the target command is
+ * executed, either directly after clone3() (see procspawn.h) or by crinit-launch. The launcher receives the parameters
+ * as long options using the same value syntax as the task configuration.
+ */
+#ifndef __SCHEDPARAM_H__
+#define __SCHEDPARAM_H__
+
+#include <limits.h>
+#include <stddef.h>
+
+/** Number of CPUs which can be part of a crinitSchedParams_t::affinity, equal to CPU_SETSIZE of glibc. **/
+#define CRINIT_SCHED_MAX_CPUS 1024
+/** Number of CPUs per element of crinitSchedParams_t::affinity. **/
+#define CRINIT_SCHED_CPUS_PER_WORD (CHAR_BIT * sizeof(unsigned long))
+/** Number of elements of crinitSchedParams_t::affinity. **/
+#define CRINIT_SCHED_AFFINITY_WORDS (CRINIT_SCHED_MAX_CPUS / CRINIT_SCHED_CPUS_PER_WORD)
+
+/** Launcher option name for the nice value. **/
+#define CRINIT_SCHED_LAUNCHOPT_NICE "nice"
+/** Launcher option name for the scheduling policy and priority. **/
+#define CRINIT_SCHED_LAUNCHOPT_POLICY "sched-policy"
+/** Launcher option name for the CPU affinity. **/
+#define CRINIT_SCHED_LAUNCHOPT_AFFINITY "cpu-affinity"
+/** Launcher option name for the I/O priority. **/
+#define CRINIT_SCHED_LAUNCHOPT_IOPRIO "io-priority"
+/** Launcher option name for the OOM score adjustment. **/
+#define CRINIT_SCHED_LAUNCHOPT_OOM_SCORE_ADJ "oom-score-adj"
+
+/**
+ * Enumeration of the available scheduling parameters, in the order they are applied.
+ */
+typedef enum crinitSchedParam {
+    CRINIT_SCHED_PARAM_AFFINITY,       ///< CPU affinity, see sched_setaffinity().
+    CRINIT_SCHED_PARAM_POLICY,         ///< Scheduling policy and static priority, see sched_setscheduler().
+    CRINIT_SCHED_PARAM_NICE,           ///< Nice value, see setpriority().
+    CRINIT_SCHED_PARAM_IOPRIO,         ///< I/O scheduling class and priority, see ioprio_set().
+    CRINIT_SCHED_PARAM_OOM_SCORE_ADJ,  ///< Adjustment of the OOM killer score, see /proc/pid/oom_score_adj.
+    CRINIT_SCHED_PARAMS_COUNT          ///< Number of parameters, must be last.
+} crinitSchedParam_t;
+
+/** Returns the crinitSchedParams_t::flags bit of a crinitSchedParam_t. **/
+#define crinitSchedParamFlag(param) (1u << (param))
+
+/**
+ * Type to store the scheduling parameters of a task.
+ */
+typedef struct crinitSchedParams {
+    unsigned int flags;                                   ///< Bitmask of the parameters which are set, see
+                                                          ///< crinitSchedParamFlag().
+    int nice;                                             ///< The nice value, -20 to 19.
+    int policy;                                           ///< The scheduling policy, e.g. SCHED_FIFO.
+    int priority;                                         ///< The static priority for SCHED_FIFO and SCHED_RR.
+    unsigned long affinity[CRINIT_SCHED_AFFINITY_WORDS];  ///< Bitmask of the CPUs the task may run on.
+    int ioprio;                                           ///< The I/O priority as expected by ioprio_set().
+    int oomScoreAdj;                                      ///< The OOM score adjustment, -1000 to 1000.
+} crinitSchedParams_t;
+
+/**
+ * Parse a scheduling parameter from a string and set it in a crinitSchedParams_t.
+ *
+ * The expected formats are:
+ * - #CRINIT_SCHED_PARAM_NICE: A number from -20 to 19.
+ * - #CRINIT_SCHED_PARAM_POLICY: One of `other`, `batch`, `idle`, `fifo:<priority>`, or `rr:<priority>`, the priority
+ *   must be within the range the kernel reports for the policy (usually 1 to 99).
+ * - #CRINIT_SCHED_PARAM_AFFINITY: A comma-separated list of CPU numbers or ranges, e.g. `0-3,6`.
+ * - #CRINIT_SCHED_PARAM_IOPRIO: One of `realtime[:<level>]`, `best-effort[:<level>]`, or `idle`, the level is 0
+ *   (highest) to 7 (lowest) and defaults to 4.
+ * - #CRINIT_SCHED_PARAM_OOM_SCORE_ADJ: A number from -1000 to 1000.
+ *
+ * @param sp     The crinitSchedParams_t to modify.
+ * @param param  The parameter to set.
+ * @param val    The string to parse.
+ *
+ * @return  0 on success, -1 on error
+ */
+int crinitSchedParamsParse(crinitSchedParams_t *sp, crinitSchedParam_t param, const char *val);
+
+/**
+ * Write a scheduling parameter as a crinit-launch long option (`--<name>=<value>`).
+ *
+ * Behaves like snprintf(), i.e. the output is truncated if \a buf is too small and the function may be called with a
+ * \a bufSize of 0 to get the needed length.
+ *
+ * @param buf      The output buffer, may be NULL if \a bufSize is 0.
+ * @param bufSize  The size of \a buf.
+ * @param sp       The crinitSchedParams_t to read.
+ * @param param    The parameter to write.
+ *
+ * @return  The length of the option excluding the terminating null byte, 0 if \a param is not set in \a sp, or -1 on
+ *          error
+ */
+int crinitSchedParamsLauncherOpt(char *buf, size_t bufSize, const crinitSchedParams_t *sp, crinitSchedParam_t param);
+
+/**
+ * Apply the scheduling parameters to the calling process.
+ *
+ * The function is async-signal-safe and does not log, so it may be called in the child process of a multi-threaded
+ * parent. It should be called before privileges are dropped as raising priorities and lowering the OOM score
+ * adjustment need CAP_SYS_NICE and CAP_SYS_RESOURCE, respectively.
+ *
+ * Modifies errno.
+ *
+ * @param sp      The parameters to apply. Only the parameters set in crinitSchedParams_t::flags are changed.
+ * @param failed  Return pointer for the parameter which could not be applied in case of an error, may be NULL.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+int crinitSchedParamsApply(const crinitSchedParams_t *sp, crinitSchedParam_t *failed);
+
+/**
+ * Get the name of a scheduling parameter as used for the crinit-launch long option.
+ *
+ * @param param  The parameter.
+ *
+ * @return  The name of the parameter
+ */
+const char *crinitSchedParamName(crinitSchedParam_t param);
+
+#endif /* __SCHEDPARAM_H__ */
@@ -6,13 +6,35 @@
 #ifndef __SOCKCOM_H__
 #define __SOCKCOM_H__
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "crinit-client.h"
 #include "rtimcmd.h"
 
+/**
+ * A persistent connection to Crinit.
+ *
+ * Crinit answers the requests on a connection in the order they were sent. Each request is assigned a consecutive ID
+ * by crinitConnSend() and each response the ID of the request it answers by crinitConnRecv(), so that requests can be
+ * pipelined and stale responses of failed transfers can be skipped.
+ */
+struct crinitClientConn {
+    int sockFd;          ///< The connected socket, -1 if not connected.
+    char *sockFile;      ///< Path to the AF_UNIX socket file, used to reconnect.
+    uint64_t nextReqId;  ///< ID of the next request to send.
+    uint64_t nextResId;  ///< ID of the request answered by the next response to receive.
+    size_t sockReqs;     ///< Number of requests sent over the current socket.
+    size_t sockResps;    ///< Number of responses received over the current socket.
+    bool perRequest;     ///< Set if Crinit closes the connection after each response, i.e. it is an older version.
+    int version;         ///< The protocol version used on the current socket, see sockmsg.h.
+};
+
 /**
  * Perform a request/response transfer with Crinit
  *
- * Will connect to Crinit and send a request/command, then receive the result/response.
- * The server side equivalent is crinitConnThread() in notiserv.c.
+ * Will connect to Crinit and send a request/command, then receive the result/response. Uses a temporary connection,
+ * see crinitConnXfer(). The server side equivalent is crinitServThread() in notiserv.c.
  *
  * The following image shows the high level communication sequence. For the lower level, refer to
  * the internal functions crinitSend() and crinitRecv().
@@ -27,4 +49,64 @@
  */
 int crinitXfer(const char *sockFile, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
 
+/**
+ * Open a persistent connection to Crinit.
+ *
+ * Uses version 2 of the protocol unless Crinit has turned out to only support version 1, see sockmsg.h. Using version
+ * 1, connects and waits for the ready-to-receive message, which Crinit only sends once per connection.
+ *
+ * @param conn      The connection to initialize. Must be closed using crinitConnClose(), also on error.
+ * @param sockFile  Path to the AF_UNIX socket file to connect to, will be copied.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitConnOpen(crinitClientConn_t *conn, const char *sockFile);
+/**
+ * Close a persistent connection to Crinit and free its resources.
+ *
+ * @param conn  The connection to close.
+ */
+void crinitConnClose(crinitClientConn_t *conn);
+/**
+ * Perform a request/response transfer over a persistent connection.
+ *
+ * Responses to earlier requests which have not been received are skipped. If Crinit has closed a connection which has
+ * already been used before answering the request, the function reconnects and repeats the request once. An older
+ * Crinit closes the connection after each response without reading further requests, in that case the function
+ * reconnects for every request from then on. If Crinit closes the connection before the first response using version
+ * 2 of the protocol, the function checks with a GETVER request if Crinit supports version 2. Only if that is rejected
+ * as well, the request is repeated using version 1 for this and all later connections. Otherwise the function fails
+ * without repeating the request, as Crinit may already have executed it.
+ *
+ * @param conn  The connection to use.
+ * @param res   Return pointer for response/result.
+ * @param cmd   The command/request to send.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitConnXfer(crinitClientConn_t *conn, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
+/**
+ * Send a request over a persistent connection without waiting for the response.
+ *
+ * The number of outstanding requests should be kept small, as Crinit does not read further requests while it cannot
+ * send a response. Pipelining requests needs a Crinit version which keeps connections open.
+ *
+ * @param conn   The connection to use.
+ * @param cmd    The command/request to send.
+ * @param reqId  Return pointer for the ID of the request, may be NULL.
+ *
+ * @return 0 on success, -1 otherwise with errno set
+ */
+int crinitConnSend(crinitClientConn_t *conn, const crinitRtimCmd_t *cmd, uint64_t *reqId);
+/**
+ * Receive the next response over a persistent connection.
+ *
+ * @param conn   The connection to use.
+ * @param res    Return pointer for response/result.
+ * @param reqId  Return pointer for the ID of the request the response answers, may be NULL.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitConnRecv(crinitClientConn_t *conn, crinitRtimCmd_t *res, uint64_t *reqId);
+
 #endif /* __SOCKCOM_H__ */
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file sockmsg.h
+ * @brief Header defining the message format of version 2 of the socket protocol between Crinit and its clients.
+ *
+ * In version 1, Crinit sends a ready-to-receive message after accepting a connection and each string is transferred as
+ * two packets, a binary size_t with its length followed by the string itself, see crinitSendStr() and crinitRecvStr()
+ * in notiserv.c.
+ *
+ * In version 2, each request and each response is a single `SOCK_SEQPACKET` message consisting of a
+ * crinitSockMsgHdr_t followed by the crinitRtimCmd_t in the binary encoding of crinitRtimCmdToMsgBin(), so that
+ * arguments keep their type and may contain any character. A client sends its first request right
+ * after connecting, without waiting for the ready-to-receive message. Crinit takes the credentials of the client once
+ * per connection using `SO_PEERCRED` instead of from `SCM_CREDENTIALS` attached to each packet.
+ *
+ * An older Crinit only supporting version 1 interprets the start of the header as the length of a string it cannot
+ * allocate and closes the connection without executing the request. A client falls back to version 1 if a GETVER
+ * request using version 2 is rejected the same way, see crinitConnXfer().
+ */
+#ifndef __SOCKMSG_H__
+#define __SOCKMSG_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Value of crinitSockMsgHdr_t::marker, never a valid string length in version 1. **/
+#define CRINIT_SOCKMSG_MARKER SIZE_MAX
+/** The protocol version using crinitSockMsgHdr_t. **/
+#define CRINIT_SOCKMSG_VERSION 2
+
+/**
+ * Header of a version 2 message.
+ */
+typedef struct crinitSockMsgHdr {
+    size_t marker;     ///< Always #CRINIT_SOCKMSG_MARKER, distinguishes the message from a version 1 length packet.
+    uint32_t version;  ///< The protocol version of the message, currently always #CRINIT_SOCKMSG_VERSION.
+    uint32_t flags;    ///< Reserved for future use, must be 0.
+} crinitSockMsgHdr_t;
+
+#endif /* __SOCKMSG_H__ */
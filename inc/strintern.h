@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file strintern.h
+ * @brief Header related to the global string intern table.
+ *
+ * Strings which are shared between many tasks, like dependency names and events or provided feature names, are stored
+ * only once in the intern table. Two interned strings are lexicographically equal if and only if they are the same
+ * pointer, so comparing them does not need strcmp(). Every entry carries a reference count and is freed once the last
+ * reference has been released.
+ *
+ * All functions use an internal mutex for synchronization and are thread-safe.
+ */
+#ifndef __STRINTERN_H__
+#define __STRINTERN_H__
+
+#include <stddef.h>
+
+/**
+ * Get the interned representation of a string and take a reference to it.
+ *
+ * If no string lexicographically equal to \a str is in the intern table yet, a copy of \a str is added. The returned
+ * pointer must not be written to and must be released using crinitStrInternRelease() if no longer needed.
+ *
+ * Modifies errno.
+ *
+ * @param str  The string to intern.
+ *
+ * @return  The interned string on success, NULL on error.
+ */
+const char *crinitStrIntern(const char *str);
+
+/**
+ * Take an additional reference to an already interned string.
+ *
+ * Does not need to look up or hash the string and is therefore cheaper than calling crinitStrIntern() again. The
+ * reference must be released using crinitStrInternRelease() if no longer needed.
+ *
+ * @param str  A string returned by crinitStrIntern() or crinitStrInternRef(), may be NULL.
+ *
+ * @return  \a str
+ */
+const char *crinitStrInternRef(const char *str);
+
+/**
+ * Look up the interned representation of a string without taking a reference.
+ *
+ * Meant to translate strings from outside into their interned form before comparing them to interned strings. The
+ * returned pointer stays valid only as long as someone else holds a reference to it, so it should only be compared
+ * against interned strings the caller knows to be referenced.
+ *
+ * @param str  The string to look up.
+ *
+ * @return  The interned string if \a str is in the intern table, NULL otherwise.
+ */
+const char *crinitStrInternFind(const char *str);
+
+/**
+ * Release a reference to an interned string.
+ *
+ * If this was the last reference, the string is removed from the intern table and freed.
+ *
+ * @param str  A string returned by crinitStrIntern() or crinitStrInternRef(), may be NULL.
+ */
+void crinitStrInternRelease(const char *str);
+
+/**
+ * Get the number of distinct strings currently held in the intern table.
+ *
+ * @return  The number of strings in the intern table.
+ */
+size_t crinitStrInternCount(void);
+
+#endif /* __STRINTERN_H__ */
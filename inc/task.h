@@ -6,14 +6,18 @@
 #ifndef __TASK_H__
 #define __TASK_H__
 
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <sys/types.h>
 #include <time.h>
 
+#include "cmdtmpl.h"
 #include "confparse.h"
 #include "crinit-sdefs.h"
 #include "envset.h"
 #include "ioredir.h"
+#include "schedparam.h"
 
 #ifdef ENABLE_CGROUP
 #include "cgroup.h"
@@ -29,6 +33,17 @@ typedef unsigned long crinitTaskOpts_t;
 #define CRINIT_TASK_OPT_TRIGGER_REARM (1 << 1)
 /** Default value for TRIGGER_REARM option. **/
 #define CRINIT_TASK_OPT_TRIGGER_REARM_DEFAULT false
+/** READY_FD task option bitmask. **/
+#define CRINIT_TASK_OPT_READY_FD (1 << 2)
+/** Default value for READY_FD option. **/
+#define CRINIT_TASK_OPT_READY_FD_DEFAULT false
+
+/** Default value for RESPAWN_DELAY_MAX_MS option. **/
+#define CRINIT_TASK_RESPAWN_DELAY_MAX_DEFAULT 60000u
+/** Default value for RESPAWN_BURST_INTERVAL_MS option. **/
+#define CRINIT_TASK_RESPAWN_BURST_INTERVAL_DEFAULT 10000u
+/** Default value for RESPAWN_COOLDOWN_MS option. **/
+#define CRINIT_TASK_RESPAWN_COOLDOWN_DEFAULT 60000u
 
 /** Dependency event that fires when a task reaches the RUNNING state. **/
 #define CRINIT_TASK_EVENT_RUNNING "spawn"
@@ -60,23 +75,26 @@ typedef enum crinitTaskTimestampType {
  * Type to store a single command within a task.
  */
 typedef struct crinitTaskCmd {
-    int argc;     ///< Number of arguments within argv.
-    char **argv;  ///< String array containing the program arguments, argv[0] contains absolute path to executable.
+    int argc;               ///< Number of arguments within argv.
+    char **argv;            ///< String array containing the program arguments, argv[0] contains absolute path to
+                            ///< executable.
+    crinitCmdTmpl_t *tmpl;  ///< Variables to expand in argv when the command is run, NULL if there are none. Only
+                            ///< used for STOP_COMMANDs.
 } crinitTaskCmd_t;
 
 /**
  * Type to store a single dependency within a task.
  */
 typedef struct crinitTaskDep {
-    char *name;   ///< Dependency name.
-    char *event;  ///< Dependency event.
+    const char *name;   ///< Dependency name, interned using crinitStrIntern() if part of a crinitTask_t.
+    const char *event;  ///< Dependency event, interned using crinitStrIntern() if part of a crinitTask_t.
 } crinitTaskDep_t;
 
 /**
  * Type to store a single provided feature within a task.
  */
 typedef struct crinitTaskPrv {
-    char *name;                  ///< Name of the provided feature.
+    const char *name;            ///< Name of the provided feature, interned using crinitStrIntern().
     crinitTaskState_t stateReq;  ///< The task state required to be reached to provide the feature.
 } crinitTaskPrv_t;
 
@@ -101,6 +119,8 @@ typedef struct crinitTask {
     crinitTaskOpts_t opts;       ///< Task options.
     crinitTaskState_t state;     ///< Task state.
     pid_t pid;                   ///< PID of currently running process subordinate to the task, if any.
+    int exitStatus;              ///< Exit status of the last process of the task which has ended, 128 plus the signal
+                                 ///< number if it was killed, or -1 if none has ended yet.
     crinitIoRedir_t *redirs;     ///< IO redirection descriptions.
     size_t redirsSize;           ///< Number of IO redirections.
     int maxRetries;              ///< If crinitTask_t::opts includes #CRINIT_TASK_OPT_RESPAWN, this variable specifies a
@@ -108,15 +128,26 @@ typedef struct crinitTask {
     int failCount;               ///< Counts consecutive respawns after failure (see crinitTaskOpts_t::maxRetries).
                                  ///< Resets on a successful completion (i.e. all COMMANDs in the task have returned 0).
     bool inhibitRespawn;         ///< If task was stopped via user interaction, do not respawn it.
+    unsigned int respawnDelay;   ///< Delay in milliseconds before the task is respawned, doubled with each consecutive
+                                 ///< failure (see failCount) up to backoffLimit.
+    unsigned int backoffLimit;   ///< Upper limit of the respawn delay in milliseconds.
+    unsigned int respawnBurst;   ///< Maximum number of starts within burstInterval before the task needs to cool down
+                                 ///< for burstCooldown milliseconds, 0 for unlimited.
+    unsigned int burstInterval;  ///< Length of the interval in milliseconds respawnBurst applies to.
+    unsigned int burstCooldown;  ///< Time in milliseconds a task has to wait after too many starts.
+    unsigned int burstCount;     ///< Number of starts since burstStart.
+    struct timespec burstStart;  ///< The time the current burst interval began.
     struct timespec createTime;  ///< The time the task was created (i.e. has been loaded and parsed).
     struct timespec startTime;   ///< The time the task last became 'running'.
     struct timespec endTime;     ///< The time the task last became 'done' or 'failed.
+    crinitTaskUsage_t usage;     ///< Resource usage accumulated over all processes of the task.
     uid_t user;                  ///< The user id to run the task's commands with.
     gid_t group;                 ///< The group id to run the task's commands with.
     gid_t *supGroups;            ///< Dynamic array of supplementary group IDs.
     size_t supGroupsSize;        ///< Number of supplementary group IDs in supGroups.
     char *username;              ///< The username to run the task's commands with.
     char *groupname;             ///< The groupname to run the task's commands with.
+    crinitSchedParams_t sched;   ///< Scheduling parameters, CPU affinity, I/O priority, and OOM score adjustment.
 #ifdef ENABLE_CAPABILITIES
     uint64_t capabilitiesSet;    ///< Bitmask to hold the capabilities that shall be added to a task.
     uint64_t capabilitiesClear;  ///< Bitmask to hold the capabilities that shall be cleared from a task.
@@ -142,6 +173,55 @@ typedef struct crinitTask {
  */
 #define crinitTaskForEachTrig(task, trg) for ((trg) = (task)->trig; (trg) != (task)->trig + (task)->trigSize; (trg)++)
 
+/**
+ * Common header of a reference-counted spawn plan.
+ *
+ * A spawn plan holds everything the Process Dispatcher derives from a configuration snapshot to spawn the task's
+ * commands. The dispatcher embeds this header as the first member of its own plan type, so that a snapshot can release
+ * its plan without depending on the dispatcher.
+ */
+typedef struct crinitSpawnPlanHdr {
+    atomic_size_t refs;                                ///< Number of references held to the plan.
+    void (*destroy)(struct crinitSpawnPlanHdr *plan);  ///< Frees the plan once its last reference is released.
+} crinitSpawnPlanHdr_t;
+
+/**
+ * Type to store an immutable, reference-counted snapshot of a task's configuration.
+ *
+ * Meant to be shared between the TaskDB and the dispatch threads working on the task, so that starting a task does not
+ * need to copy its configuration. Once created, the contained task must not be modified. Runtime state like
+ * crinitTask_t::state, crinitTask_t::pid or the remaining dependencies is part of the snapshot as well but is not kept
+ * up to date and must be queried from the TaskDB instead.
+ */
+typedef struct crinitTaskCfg {
+    atomic_size_t refs;               ///< Number of references held to the snapshot.
+    crinitSpawnPlanHdr_t *spawnPlan;  ///< Spawn plan cached by the Process Dispatcher, NULL if not built yet. Only
+                                      ///< accessed by the Process Dispatcher under its own lock, the snapshot holds
+                                      ///< one reference.
+    crinitTask_t task;                ///< The snapshot of the task.
+} crinitTaskCfg_t;
+
+/**
+ * Get the crinitTaskCfg_t holding a task which is part of a snapshot.
+ *
+ * @param t  Pointer to the crinitTaskCfg_t::task member of a snapshot.
+ */
+#define crinitTaskCfgOf(t) ((crinitTaskCfg_t *)((uintptr_t)(t) - offsetof(crinitTaskCfg_t, task)))
+
+/**
+ * Type to store the state changes a task has reported through sd_notify(), see crinitTaskNotifyParse().
+ */
+typedef struct crinitTaskNotify {
+    pid_t mainPid;       ///< New main PID of the task from `MAINPID=`, -1 if not reported.
+    bool ready;          ///< true if `READY=1` has been reported.
+    bool stopping;       ///< true if `STOPPING=1` has been reported.
+    const char *status;  ///< Free-form status text from `STATUS=`, not null-terminated, NULL if not reported.
+    size_t statusLen;    ///< Length of crinitTaskNotify_t::status.
+} crinitTaskNotify_t;
+
+/** Initializer for a crinitTaskNotify_t without any reported state changes. **/
+#define CRINIT_TASK_NOTIFY_INIT {-1, false, false, NULL, 0}
+
 /**
  * Given an crinitConfKvList_t created from a task config, build an equivalent crinitTask.
  *
@@ -194,6 +274,60 @@ int crinitTaskDup(crinitTask_t **out, const crinitTask_t *orig);
  */
 int crinitTaskCopy(crinitTask_t *out, const crinitTask_t *orig);
 
+/**
+ *  Moves the contents from one task to another without copying any of the dynamically allocated members.
+ *
+ *  Afterwards, \a out owns all memory previously owned by \a orig and \a orig is empty. It is safe to call
+ *  crinitDestroyTask() or crinitFreeTask() on the emptied \a orig.
+ *
+ *  @param out   Pointer to the task to move \a orig into, must not hold any allocated memory.
+ *  @param orig  The original task to move, will be emptied.
+ */
+void crinitTaskMove(crinitTask_t *out, crinitTask_t *orig);
+
+/**
+ * Create an immutable snapshot of the configuration of a task.
+ *
+ * The snapshot holds a deep copy of \a orig prepared for spawning, i.e. its environment additionally contains the
+ * task name in #CRINIT_ENV_NOTIFY_NAME. It is returned with a single reference which must be released using
+ * crinitTaskCfgRelease().
+ *
+ * @param orig  The task to take the snapshot of.
+ *
+ * @return  The new snapshot on success, NULL on error.
+ */
+crinitTaskCfg_t *crinitTaskCfgCreate(const crinitTask_t *orig);
+
+/**
+ * Take an additional reference to a task configuration snapshot.
+ *
+ * Thread-safe without further locking.
+ *
+ * @param cfg  The snapshot to reference.
+ *
+ * @return  \a cfg
+ */
+crinitTaskCfg_t *crinitTaskCfgRef(crinitTaskCfg_t *cfg);
+
+/**
+ * Release a reference to a task configuration snapshot.
+ *
+ * The snapshot is freed once its last reference is released. Thread-safe without further locking.
+ *
+ * @param cfg  The snapshot to release, may be NULL.
+ */
+void crinitTaskCfgRelease(crinitTaskCfg_t *cfg);
+
+/**
+ * Release a reference to a spawn plan.
+ *
+ * The plan is freed using crinitSpawnPlanHdr_t::destroy once its last reference is released. Thread-safe without
+ * further locking.
+ *
+ * @param plan  The plan to release, may be NULL.
+ */
+void crinitSpawnPlanRelease(crinitSpawnPlanHdr_t *plan);
+
 /**
  * Merges the options set in a given include file into the target crinitTask_t.
  *
@@ -210,4 +344,17 @@ int crinitTaskCopy(crinitTask_t *out, const crinitTask_t *orig);
  */
 int crinitTaskMergeInclude(crinitTask_t *tgt, const char *src, char *importList);
 
+/**
+ * Parse a state string as sent by sd_notify() into a crinitTaskNotify_t.
+ *
+ * \a state consists of newline-separated assignments like `READY=1` or `MAINPID=4711`. Unknown assignments are
+ * ignored. \a n is not reset, so the function can be called repeatedly to collect the assignments of several strings.
+ * crinitTaskNotify_t::status will point into \a state.
+ *
+ * @param n      The crinitTaskNotify_t to update, initialized using #CRINIT_TASK_NOTIFY_INIT.
+ * @param state  The state string, does not need to be null-terminated.
+ * @param len    Length of \a state.
+ */
+void crinitTaskNotifyParse(crinitTaskNotify_t *n, const char *state, size_t len);
+
 #endif /* __TASK_H__ */
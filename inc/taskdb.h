@@ -8,12 +8,23 @@
 
 #include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <sys/resource.h>
 
 #include "task.h"
 
 #define CRINIT_MONITOR_DEP_NAME "@crinitmon"  ///< Special dependency name to depend on monitor events (not yet impl.).
 #define CRINIT_PROVIDE_DEP_NAME "@provided"   ///< Special dependency name to depend on provided system features.
 #define CRINIT_TASKDB_INITIAL_SIZE 256        ///< Default initial size of taskSet and inclSet within an crinitTaskDB_t.
+#define CRINIT_TASKDB_CHUNK_SIZE 64           ///< Number of tasks per chunk of crinitTaskDB_t::taskSet, a power of two.
+
+/**
+ * Type to store a stable handle to a task within a crinitTaskDB_t.
+ *
+ * A handle is the position of the task in crinitTaskDB_t::taskSet. As tasks are never removed from or moved within a
+ * TaskDB, a handle stays valid for the lifetime of the TaskDB, even if the task is overwritten.
+ */
+typedef size_t crinitTaskHandle_t;
 
 /**
  * Type to describe wheter the spawn thread launches start or stop commands
@@ -23,42 +34,187 @@ typedef enum crinitDispatchThreadMode {
     CRINIT_DISPATCH_THREAD_MODE_STOP
 } crinitDispatchThreadMode_t;
 
+#define CRINIT_TASKDB_SCHED_TRIGGERED (1 << 0)        ///< Scheduling flag, crinitTask_t::triggered is set.
+#define CRINIT_TASKDB_SCHED_RESPAWN (1 << 1)          ///< Scheduling flag, task has #CRINIT_TASK_OPT_RESPAWN set.
+#define CRINIT_TASKDB_SCHED_INHIBIT_RESPAWN (1 << 2)  ///< Scheduling flag, crinitTask_t::inhibitRespawn is set.
+#define CRINIT_TASKDB_SCHED_DEPS_PENDING (1 << 3)     ///< Scheduling flag, crinitTask_t::depsSize is not 0.
+#define CRINIT_TASKDB_SCHED_QUEUED (1 << 4)           ///< Scheduling flag, task is in crinitTaskDB_t::readyQueue.
+
+/**
+ * Type to store the scheduling state of a task, an entry of crinitTaskDB_t::taskSched.
+ *
+ * Holds compact copies of the few crinitTask_t members needed to decide if a task is ready to be started, so that
+ * the scheduler does not need to touch the (much larger) crinitTask_t itself. Entries are kept up to date by the TaskDB
+ * whenever it changes one of the corresponding task members.
+ */
+typedef struct crinitTaskDBSched {
+    uint32_t state;      ///< Copy of crinitTask_t::state.
+    int32_t failCount;   ///< Copy of crinitTask_t::failCount.
+    int32_t maxRetries;  ///< Copy of crinitTask_t::maxRetries.
+    uint32_t flags;      ///< Bitmask of CRINIT_TASKDB_SCHED_* flags.
+    uint32_t prio;       ///< Spawn priority, tasks with higher priority leave crinitTaskDB_t::readyQueue first. Set by
+                         ///< crinitTaskDBSetSpawnPrio(), 0 for new tasks.
+} crinitTaskDBSched_t;
+
+/**
+ * Type to store the tasks waiting for a specific dependency event, an entry of the reverse dependency index of an
+ * crinitTaskDB_t.
+ */
+typedef struct crinitTaskDBWaitList {
+    const char *name;    ///< Dependency name, interned using crinitStrIntern().
+    const char *event;   ///< Dependency event, interned using crinitStrIntern().
+    size_t *waiters;     ///< Dynamic array of positions in crinitTaskDB_t::taskSet of tasks which have name:event in
+                         ///< their crinitTask_t::deps or crinitTask_t::trig.
+    size_t waitersSize;  ///< Number of elements in waiters.
+    size_t waitersCap;   ///< Current maximum size of the waiters array.
+} crinitTaskDBWaitList_t;
+
 /**
  * Type to store a task database.
  */
 typedef struct crinitTaskDB {
-    crinitTask_t *taskSet;  ///< Dynamic array of tasks, corresponds to task configs specified in the series config.
-    size_t taskSetSize;     ///< Current maximum size of the task array.
-    size_t taskSetItems;    ///< Number of elements in the task array.
+    crinitTask_t **taskSet;          ///< Dynamic array of chunks of #CRINIT_TASKDB_CHUNK_SIZE tasks each, corresponds
+                                     ///< to task configs specified in the series config. Growing only adds chunks, so
+                                     ///< tasks never move. Use crinitTaskDBTaskAt() to access a task by position.
+    crinitTaskDBSched_t *taskSched;  ///< Array parallel to taskSet holding the scheduling state of each task.
+    crinitTaskCfg_t **taskCfg;       ///< Array parallel to taskSet holding the configuration snapshot of each task
+                                     ///< handed to spawnFunc, NULL until needed or after the configuration changed.
+    size_t taskSetSize;              ///< Current maximum number of tasks in taskSet (and taskSched), always a multiple
+                                     ///< of #CRINIT_TASKDB_CHUNK_SIZE.
+    size_t taskSetItems;             ///< Number of tasks in taskSet (and taskSched).
+
+    size_t *taskIdx;     ///< Open-addressing hash index from task name to position in taskSet (stored as position + 1,
+                         ///< 0 marks an empty bucket).
+    size_t taskIdxSize;  ///< Number of buckets in taskIdx, a power of two of at least twice taskSetSize.
 
-    /** Pointer specifying a function for spawning ready tasks, used by crinitTaskDBSpawnReady() **/
+    crinitTaskDBWaitList_t *waitSet;  ///< Dynamic array forming the reverse dependency index, one entry per
+                                      ///< name:event combination any task depends on or is triggered by.
+    size_t waitSetSize;               ///< Current maximum size of the waitSet array.
+    size_t waitSetItems;              ///< Number of elements in the waitSet array.
+    size_t *waitIdx;     ///< Open-addressing hash index from name:event to position in waitSet, same scheme as taskIdx.
+    size_t waitIdxSize;  ///< Number of buckets in waitIdx, a power of two of at least twice waitSetSize.
+
+    size_t *readyQueue;      ///< Ring buffer of positions in taskSet of tasks which became ready to be spawned,
+                             ///< ordered by descending crinitTaskDBSched_t::prio and by arrival within the same
+                             ///< priority. Drained by crinitTaskDBSpawnReady().
+    size_t readyQueueSize;   ///< Capacity of readyQueue, kept equal to taskSetSize.
+    size_t readyQueueHead;   ///< Position of the first element in readyQueue.
+    size_t readyQueueItems;  ///< Number of elements in readyQueue.
+    size_t borrowed;         ///< Position + 1 of the task handed out by crinitTaskDBBorrowTask() until
+                             ///< crinitTaskDBRemit(), 0 if no task is borrowed.
+
+    /**
+     * Pointer specifying a function for spawning ready tasks, used by crinitTaskDBSpawnReady(). Called with
+     * crinitTaskDB_t::lock held. The task given to it is the crinitTaskCfg_t::task member of a configuration snapshot
+     * (see crinitTaskCfgOf()) which is only guaranteed to stay valid during the call, so the function needs to take its
+     * own reference using crinitTaskCfgRef() if it keeps the task around.
+     **/
     int (*spawnFunc)(struct crinitTaskDB *ctx, const crinitTask_t *, crinitDispatchThreadMode_t mode);
 
     bool
         spawnInhibit;  ///< Specifies if process spawning is currently inhibited, respected by crinitTaskDBSpawnReady().
 
-    pthread_mutex_t lock;    ///< Mutex to lock the TaskDB, shall be used for any operations on the data structure if
-                             ///< multiple threads are involved.
-    pthread_cond_t changed;  ///< Condition variable to be signalled if taskSet or spawnInhibit is changed.
+    pthread_mutex_t lock;        ///< Mutex to lock the TaskDB, shall be used for any operations on the data structure
+                                 ///< if multiple threads are involved.
+    pthread_cond_t changed;      ///< Condition variable to be signalled if taskSet or spawnInhibit is changed.
+    unsigned long changeGen;     ///< Incremented each time crinitTaskDB_t::changed is signalled, lets a thread detect
+                                 ///< changes it was not waiting for yet.
+    unsigned long spawnFailGen;  ///< Value of changeGen when crinitTaskDBSpawnReady() last failed to spawn a task.
+    pthread_cond_t ready;        ///< Condition variable to be signalled if a task has been added to readyQueue or if
+                                 ///< spawnInhibit has been reset while readyQueue is non-empty.
+    pthread_rwlock_t queryLock;  ///< Reader/writer lock guarding the layout of taskSet and the task members reported by
+                                 ///< status queries. Writers must already hold crinitTaskDB_t::lock, readers must not.
 } crinitTaskDB_t;
 
+/**
+ * Type to store a snapshot of the externally visible status of a task, see crinitTaskDBGetTaskStatus() and
+ * crinitTaskDBExportTaskStatus().
+ */
+typedef struct crinitTaskDBStatus {
+    char *name;                  ///< Name of the task, only set by crinitTaskDBExportTaskStatus().
+    crinitTaskState_t state;     ///< Task state, see crinitTask_t::state.
+    pid_t pid;                   ///< PID of the currently running process of the task or -1, see crinitTask_t::pid.
+    struct timespec createTime;  ///< See crinitTask_t::createTime.
+    struct timespec startTime;   ///< See crinitTask_t::startTime.
+    struct timespec endTime;     ///< See crinitTask_t::endTime.
+    crinitTaskUsage_t usage;     ///< See crinitTask_t::usage.
+    uid_t user;                  ///< See crinitTask_t::user.
+    gid_t group;                 ///< See crinitTask_t::group.
+    char *username;              ///< Dynamically allocated copy of crinitTask_t::username or NULL if unset.
+    char *groupname;             ///< Dynamically allocated copy of crinitTask_t::groupname or NULL if unset.
+    int failCount;               ///< See crinitTask_t::failCount.
+} crinitTaskDBStatus_t;
+
+/**
+ * Check if a task is considered ready to be started (startable), given its scheduling state.
+ *
+ * See crinitTaskDBSpawnReady() for further explanation. Does not check if the task is already in
+ * crinitTaskDB_t::readyQueue.
+ *
+ * @param s  The crinitTaskDB_t::taskSched entry of the task.
+ *
+ * @return true if the task is ready, false otherwise
+ */
+static inline bool crinitTaskDBSchedIsReady(const crinitTaskDBSched_t *s) {
+    if (s->flags & CRINIT_TASKDB_SCHED_DEPS_PENDING) {
+        return false;
+    }
+    if (!(s->flags & CRINIT_TASKDB_SCHED_TRIGGERED)) {
+        return false;
+    }
+    if (s->state & (CRINIT_TASK_STATE_RUNNING | CRINIT_TASK_STATE_STARTING)) {
+        return false;
+    }
+    bool respawn = s->flags & CRINIT_TASKDB_SCHED_RESPAWN;
+    if (respawn && (s->flags & CRINIT_TASKDB_SCHED_INHIBIT_RESPAWN)) {
+        return false;
+    }
+    if (s->state & (CRINIT_TASK_STATE_BACKOFF | CRINIT_TASK_STATE_COOLDOWN)) {
+        return false;
+    }
+    if (s->state & (CRINIT_TASK_STATE_FAILED | CRINIT_TASK_STATE_DONE)) {
+        if (!respawn) {
+            return false;
+        }
+        if (s->maxRetries != -1 && s->failCount > s->maxRetries) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Get a pointer to the task at a given position in a task database.
+ *
+ * Does not check bounds or lock the TaskDB. The returned pointer stays valid for the lifetime of the TaskDB but the
+ * task itself must only be accessed with crinitTaskDB_t::lock held.
+ *
+ * @param taskDb  Pointer to the task database.
+ * @param pos     The position of the task in crinitTaskDB_t::taskSet, equal to its crinitTaskHandle_t.
+ */
+#define crinitTaskDBTaskAt(taskDb, pos) \
+    (&(taskDb)->taskSet[(pos) / CRINIT_TASKDB_CHUNK_SIZE][(pos) % CRINIT_TASKDB_CHUNK_SIZE])
+
 /**
  * Iterate over all tasks in a task database
  *
  * @param taskDb  Pointer to a task database to traverse.
  * @param task    Pointer to a single task entry.
  */
-#define crinitTaskDbForEach(taskDb, task) \
-    for ((task) = (taskDb)->taskSet; (task) != (taskDb)->taskSet + (taskDb)->taskSetItems; (task)++)
+#define crinitTaskDbForEach(taskDb, task)                                                                            \
+    for (size_t crinitTaskDbIter = 0;                                                                                \
+         crinitTaskDbIter < (taskDb)->taskSetItems && ((task) = crinitTaskDBTaskAt(taskDb, crinitTaskDbIter), true); \
+         crinitTaskDbIter++)
 
 /**
  * Insert a task into a task database.
  *
  * Will store a copy of \a t in the crinitTaskDB_t::taskSet of \a ctx. crinitTaskDB_t::taskSetItems will be incremented
- * and if crinitTaskDB_t::taskSetSize is not sufficient, the set will be grown. If \a overwrite is true, a task with the
- * same name in the set will be overwritten. If it is false, an existing task with the same name will cause an error. If
- * the task has been successfully inserted, the function will signal crinitTaskDB_t::changed. The function uses
- * crinitTaskDB_t::lock for synchronization and is thread-safe.
+ * and if crinitTaskDB_t::taskSetSize is not sufficient, the set (and crinitTaskDB_t::taskIdx along with it) will be
+ * grown. Growing the set does not move tasks which are already stored, so pointers and handles to them stay valid.
+ * If \a overwrite is true, a task with the same name in the set will be overwritten. If it is false, an existing task
+ * with the same name will cause an error. If the task has been successfully inserted, the function will signal
+ * crinitTaskDB_t::changed. The function uses crinitTaskDB_t::lock for synchronization and is thread-safe.
  *
  * Modifies errno.
  *
@@ -75,12 +231,38 @@ int crinitTaskDBInsert(crinitTaskDB_t *ctx, const crinitTask_t *t, bool overwrit
  * For explanation see crinitTaskDBInsert() with parameter \a overwrite set to true.
  */
 #define crinitTaskDBUpdate(ctx, t) crinitTaskDBInsert(ctx, t, true)
+/**
+ * Insert multiple tasks into a task database at once.
+ *
+ * Behaves like calling crinitTaskDBInsert() for each element of \a tasks in order but locks the TaskDB only once, grows
+ * crinitTaskDB_t::taskSet at most once and signals crinitTaskDB_t::changed only once at the end. Instead of copying,
+ * the contents of each successfully inserted task are moved into the TaskDB using crinitTaskMove(), leaving the
+ * element of \a tasks empty. The caller still needs to free the elements of \a tasks (e.g. using crinitFreeTask()),
+ * regardless of success.
+ *
+ * If \a overwrite is true and a name occurs more than once in \a tasks, the last of these tasks wins and the task is
+ * added only once.
+ *
+ * If a task cannot be inserted, the tasks before it remain in the TaskDB, the failed task and the ones after it are
+ * left untouched. The function uses crinitTaskDB_t::lock for synchronization and is thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx        The crinitTaskDB_t context, into which the tasks should be inserted.
+ * @param tasks      Array of pointers to the tasks to be inserted.
+ * @param numTasks   Number of elements in \a tasks.
+ * @param overwrite  Overwrite colliding tasks with the same name (true) or return an error (false).
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitTaskDBInsertBatch(crinitTaskDB_t *ctx, crinitTask_t **tasks, size_t numTasks, bool overwrite);
 
 /**
  * Fulfill a dependency for all tasks inside a task database.
  *
  * Will search \a ctx for tasks containing a dependency equal to \a dep (i.e. specifying the same name and event,
- * according to strcmp()) and, if found, remove the dependency from crinitTask_t::deps. Will signal
+ * according to strcmp()) and, if found, remove the dependency from crinitTask_t::deps. If \a target is NULL, only the
+ * tasks listed for \a dep in the reverse dependency index (crinitTaskDB_t::waitSet) are visited. Will signal
  * crinitTaskDB_t::changed on successful completion. The function uses crinitTaskDB_t::lock for synchronization and is
  * thread-safe.
  *
@@ -195,6 +377,10 @@ int crinitTaskRearmTrigger(crinitTaskDB_t *ctx, const char *taskName);
  * crinitTask_t::failCount will be reset to 0. The function uses crinitTaskDB_t::lock for synchronization and is
  * thread-safe.
  *
+ * If a respawning task ends and needs to wait before it is started again (see crinitTask_t::respawnDelay and
+ * crinitTask_t::respawnBurst), #CRINIT_TASK_STATE_BACKOFF or #CRINIT_TASK_STATE_COOLDOWN is added to its state and a
+ * respawn timer is armed in the TimerDB which calls crinitTaskDBEndRespawnDelay() once the delay has passed.
+ *
  * Modifies errno.
  *
  * @param ctx       The crinitTaskDB_t context in which the task is held.
@@ -209,7 +395,7 @@ int crinitTaskDBSetTaskState(crinitTaskDB_t *ctx, crinitTaskState_t s, const cha
  *
  * Will search \a ctx for an crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and write its
  * crinitTask_t::state to \a s. If such a task does not exist in \a ctx, an error is returned. The function uses
- * crinitTaskDB_t::lock for synchronization and is thread-safe.
+ * crinitTaskDB_t::queryLock for synchronization and is thread-safe.
  *
  * Modifies errno.
  *
@@ -242,8 +428,8 @@ int crinitTaskDBSetTaskPID(crinitTaskDB_t *ctx, pid_t pid, const char *taskName)
  *
  * Will search \a ctx for an crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and write its
  * PID to \a pid. If such a task does not exit in \a ctx, an error is returned. If the task does not currently have a
- * running process, \a pid will be -1 but the function will indicate success. The function uses crinitTaskDB_t::lock for
- * synchronization and is thread-safe.
+ * running process, \a pid will be -1 but the function will indicate success. The function uses
+ * crinitTaskDB_t::queryLock for synchronization and is thread-safe.
  *
  * Modifies errno.
  *
@@ -255,13 +441,83 @@ int crinitTaskDBSetTaskPID(crinitTaskDB_t *ctx, pid_t pid, const char *taskName)
  */
 int crinitTaskDBGetTaskPID(crinitTaskDB_t *ctx, pid_t *pid, const char *taskName);
 
+/**
+ * Set the exit status of the last process of a task which has ended in a task database.
+ *
+ * Will search \a ctx for an crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and set its
+ * crinitTask_t::exitStatus to \a exitStatus. If such a task does not exist in \a ctx, an error is returned. The
+ * function uses crinitTaskDB_t::lock for synchronization and is thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx         The crinitTaskDB_t context in which the task is held.
+ * @param exitStatus  The exit status, 128 plus the signal number if the process was killed.
+ * @param taskName    The task's name.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+int crinitTaskDBSetTaskExitStatus(crinitTaskDB_t *ctx, int exitStatus, const char *taskName);
+
+/**
+ * Get the exit status of the last process of a task which has ended in a task database.
+ *
+ * Will search \a ctx for an crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and write its
+ * crinitTask_t::exitStatus to \a exitStatus. If such a task does not exist in \a ctx, an error is returned. If no
+ * process of the task has ended yet, \a exitStatus will be -1 but the function will indicate success. The function uses
+ * crinitTaskDB_t::queryLock for synchronization and is thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx         The crinitTaskDB_t context in which the task is held.
+ * @param exitStatus  Pointer to store the returned exit status.
+ * @param taskName    The task's name.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+int crinitTaskDBGetTaskExitStatus(crinitTaskDB_t *ctx, int *exitStatus, const char *taskName);
+
+/**
+ * Apply the state changes a task has reported through sd_notify() to a task database.
+ *
+ * A reported main PID is set as the task's PID. `READY=1` sets the task to running and notified and fulfills the
+ * respective `-notified` dependency and features, `STOPPING=1` does the same for the done state. A reported status
+ * text is logged. Used for both the `NOTIFY` runtime command and tasks using `READY_FD`. The function is thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx       The crinitTaskDB_t context in which the task is held.
+ * @param taskName  The task's name.
+ * @param n         The reported state changes, see crinitTaskNotifyParse().
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+int crinitTaskDBNotify(crinitTaskDB_t *ctx, const char *taskName, const crinitTaskNotify_t *n);
+
+/**
+ * Add the resource usage of a reaped process to the totals of a task in a task database.
+ *
+ * Will search \a ctx for an crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and add the
+ * CPU times and context switches in \a ru to crinitTask_t::usage. The maximum resident set size is kept if it is
+ * larger than the one in \a ru. If such a task does not exist in \a ctx, an error is returned. The function uses
+ * crinitTaskDB_t::lock for synchronization and is thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx       The crinitTaskDB_t context in which the task is held.
+ * @param ru        The resource usage of the process as reported by wait4().
+ * @param taskName  The task's name.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+int crinitTaskDBAddTaskUsage(crinitTaskDB_t *ctx, const struct rusage *ru, const char *taskName);
+
 /**
  * Get the crinitTaskState_t and the PID of a task in a task database
  *
  * Will search \a ctx for an crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and write its
  * crinitTask_t::state to \a s and its PID to \a pid. If such a task does not exist in \a ctx, an error is returned. If
  * the task does not currently have a running process, \a pid will be -1 but the function will indicate success. The
- * function uses crinitTaskDB_t::lock for synchronization and is thread-safe.
+ * function uses crinitTaskDB_t::queryLock for synchronization and is thread-safe.
  *
  * Modifies errno.
  *
@@ -274,6 +530,44 @@ int crinitTaskDBGetTaskPID(crinitTaskDB_t *ctx, pid_t *pid, const char *taskName
  */
 int crinitTaskDBGetTaskStateAndPID(crinitTaskDB_t *ctx, crinitTaskState_t *s, pid_t *pid, const char *taskName);
 
+/**
+ * Get a snapshot of the externally visible status of a task in a task database.
+ *
+ * Will search \a ctx for an crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and copy its
+ * status into \a status. If such a task does not exist in \a ctx, an error is returned. The function only takes
+ * crinitTaskDB_t::queryLock for reading and does not need crinitTaskDB_t::lock, so concurrent queries neither block
+ * each other nor the spawning of tasks for longer than it takes to copy the status.
+ *
+ * On success, crinitTaskDBStatus_t::username and crinitTaskDBStatus_t::groupname of \a status are dynamically allocated
+ * (or NULL) and need to be freed by the caller.
+ *
+ * Modifies errno.
+ *
+ * @param ctx       The crinitTaskDB_t context in which the task is held.
+ * @param status    Pointer to store the returned status.
+ * @param taskName  The task's name.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+int crinitTaskDBGetTaskStatus(crinitTaskDB_t *ctx, crinitTaskDBStatus_t *status, const char *taskName);
+
+/**
+ * End the respawn delay of a task.
+ *
+ * Removes #CRINIT_TASK_STATE_BACKOFF and #CRINIT_TASK_STATE_COOLDOWN from the crinitTask_t::state of the task named
+ * \a taskName so that it can be respawned. Called by the TimerDB once the delay set by crinitTaskDBSetTaskState() has
+ * passed. Does nothing if the task is not waiting to be respawned (anymore). The function uses crinitTaskDB_t::lock for
+ * synchronization and is thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx       The crinitTaskDB_t context in which the task is held.
+ * @param taskName  The task's name.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+int crinitTaskDBEndRespawnDelay(crinitTaskDB_t *ctx, const char *taskName);
+
 /**
  * Sets the respawnInhibit flag.
  *
@@ -297,8 +591,10 @@ int crinitTaskDBSetTaskRespawnInhibit(crinitTaskDB_t *ctx, bool inhibit, const c
  *
  * If the function returns an error (`NULL`), no database lock is acquired.
  *
- * As the lock is held on the whole task database, operations in the critical section between crinitTaskDBBorrowTask
- * and crinitTaskDBRemit() must be kept short to avoid performance issues.
+ * As the lock is held on the whole task database (crinitTaskDB_t::lock as well as crinitTaskDB_t::queryLock for
+ * writing), operations in the critical section between crinitTaskDBBorrowTask and crinitTaskDBRemit() must be kept
+ * short to avoid performance issues. For read-only access to the status of a task, use crinitTaskDBGetTaskStatus()
+ * instead. Changes made to the task are picked up by the scheduler in crinitTaskDBRemit().
  *
  * Modifies errno.
  *
@@ -308,6 +604,37 @@ int crinitTaskDBSetTaskRespawnInhibit(crinitTaskDB_t *ctx, bool inhibit, const c
  * @return  A pointer to the task with \a taskName within the task database context on success, NULL on any error.
  */
 crinitTask_t *crinitTaskDBBorrowTask(crinitTaskDB_t *ctx, const char *taskName);
+/**
+ * Provide direct thread-safe access to a task within a task database by its handle.
+ *
+ * Works like crinitTaskDBBorrowTask() but does not need to look up the task by name. The borrowed task must be released
+ * using crinitTaskDBRemit().
+ *
+ * Modifies errno.
+ *
+ * @param ctx     The TaskDB containing the task to borrow.
+ * @param handle  The handle of the task to borrow as returned by crinitTaskDBGetTaskHandle().
+ *
+ * @return  A pointer to the task within the task database context on success, NULL on any error.
+ */
+crinitTask_t *crinitTaskDBBorrowTaskByHandle(crinitTaskDB_t *ctx, crinitTaskHandle_t handle);
+/**
+ * Get the stable handle of a task in a task database.
+ *
+ * Will search \a ctx for a crinitTask_t with crinitTask_t::name lexicographically equal to \a taskName and return its
+ * handle. The handle can be cached and used to access the task without further name lookups, see
+ * crinitTaskDBBorrowTaskByHandle(). The function uses crinitTaskDB_t::queryLock for synchronization and is
+ * thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx       The TaskDB containing the task.
+ * @param handle    Return pointer for the handle.
+ * @param taskName  The name of the task.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+int crinitTaskDBGetTaskHandle(crinitTaskDB_t *ctx, crinitTaskHandle_t *handle, const char *taskName);
 /**
  * Release the lock on the task database acquired via crinitTaskDBBorrowTask(). The borrowed task reference may not be
  * used anymore.
@@ -320,6 +647,68 @@ crinitTask_t *crinitTaskDBBorrowTask(crinitTaskDB_t *ctx, const char *taskName);
  */
 int crinitTaskDBRemit(crinitTaskDB_t *ctx);
 
+/**
+ * Find the handle of a task by name.
+ *
+ * Doesn't lock the TaskDB! Must be called with crinitTaskDB_t::lock held.
+ *
+ * @param ctx       The TaskDB to search.
+ * @param handle    Return pointer for the handle.
+ * @param taskName  The name of the task.
+ *
+ * @return  0 on success, -1 if the task is not in the TaskDB.
+ */
+int crinitTaskDBFindTaskHandle(const crinitTaskDB_t *ctx, crinitTaskHandle_t *handle, const char *taskName);
+
+/**
+ * Set the spawn priorities of the tasks in a TaskDB.
+ *
+ * Sets crinitTaskDBSched_t::prio of the first \a numTasks tasks to the corresponding element of \a prio and reorders
+ * crinitTaskDB_t::readyQueue accordingly. If several tasks are ready at once, crinitTaskDBSpawnReady() starts those
+ * with higher priority first. Elements of \a prio beyond the tasks in the TaskDB are ignored.
+ *
+ * Doesn't lock the TaskDB! Must be called with crinitTaskDB_t::lock held, which should also have been held while
+ * \a prio was computed from the tasks, so that it matches the tasks it is applied to.
+ *
+ * @param ctx       The TaskDB to modify.
+ * @param prio      Array of priorities, indexed by crinitTaskHandle_t.
+ * @param numTasks  Number of elements in \a prio.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+int crinitTaskDBSetSpawnPrio(crinitTaskDB_t *ctx, const uint32_t *prio, size_t numTasks);
+
+/**
+ * Get a reference to the configuration snapshot of a task.
+ *
+ * The snapshot is created on first use and kept in crinitTaskDB_t::taskCfg until the configuration of the task is
+ * replaced by crinitTaskDBInsert() or possibly modified through crinitTaskDBBorrowTask(), so repeatedly starting the
+ * same task does not copy its configuration. The reference must be released using crinitTaskCfgRelease().
+ *
+ * Doesn't lock the TaskDB! Must be called with crinitTaskDB_t::lock held.
+ *
+ * @param ctx     The TaskDB containing the task.
+ * @param handle  The handle of the task.
+ *
+ * @return  The snapshot on success, NULL on error.
+ */
+crinitTaskCfg_t *crinitTaskDBPinTaskCfg(crinitTaskDB_t *ctx, crinitTaskHandle_t handle);
+/**
+ * Get a reference to the configuration snapshot of a task by name.
+ *
+ * Works like crinitTaskDBPinTaskCfg() but looks up the task by name and uses crinitTaskDB_t::lock for synchronization.
+ * The reference must be released using crinitTaskCfgRelease().
+ *
+ * Modifies errno.
+ *
+ * @param ctx       The TaskDB containing the task.
+ * @param cfg       Return pointer for the snapshot.
+ * @param taskName  The name of the task.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+int crinitTaskDBGetTaskCfg(crinitTaskDB_t *ctx, crinitTaskCfg_t **cfg, const char *taskName);
+
 /**
  * Run crinitTaskDB_t::spawnFunc for each startable task in a task database.
  *
@@ -329,6 +718,17 @@ int crinitTaskDBRemit(crinitTaskDB_t *ctx);
  * crinitTask_t::failCount is less than crinitTask_t::maxRetries. The function uses crinitTaskDB_t::lock for
  * synchronization and is thread-safe.
  *
+ * Tasks are not searched for but taken from crinitTaskDB_t::readyQueue. The TaskDB functions changing anything
+ * relevant to the above conditions put a task into the queue as soon as it becomes startable. If a queued task is no
+ * longer startable once it is taken from the queue, it is skipped. Tasks with a higher spawn priority (see
+ * crinitTaskDBSetSpawnPrio()) are started first. If crinitTaskDB_t::spawnFunc fails, the task stays queued and the
+ * function returns with the errno set by crinitTaskDB_t::spawnFunc, e.g. EAGAIN if the Process Dispatcher is busy.
+ *
+ * Tasks without COMMANDs (meta-tasks) are not handed to crinitTaskDB_t::spawnFunc in
+ * #CRINIT_DISPATCH_THREAD_MODE_START but completed right away under the same lock, unless they respawn, rearm their
+ * triggers, or have a cgroup. Tasks which become startable through this are handled by the same call. Logging, feature
+ * hooks, and other work which must not run with crinitTaskDB_t::lock held is done after the lock has been released.
+ *
  * If crinitTaskDB::spawnInhibit is true, no tasks are considered startable and this function will return successfully
  * without starting anything.
  *
@@ -340,6 +740,36 @@ int crinitTaskDBRemit(crinitTaskDB_t *ctx);
  * @return 0 on success, -1 otherwise
  */
 int crinitTaskDBSpawnReady(crinitTaskDB_t *ctx, crinitDispatchThreadMode_t mode);
+
+/**
+ * Wait until crinitTaskDBSpawnReady() may succeed again after it has failed.
+ *
+ * Returns as soon as crinitTaskDB_t::changed has been signalled after the last failure of crinitTaskDBSpawnReady(),
+ * including a change which happened before the function was called, e.g. a dispatch worker thread taking a task from
+ * the full dispatch queue (see crinitTaskDBDispatchSpaceFreed()). Must only be called after crinitTaskDBSpawnReady()
+ * has returned an error.
+ *
+ * Modifies errno.
+ *
+ * @param ctx  The TaskDB context.
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitTaskDBWaitSpawnRetry(crinitTaskDB_t *ctx);
+
+/**
+ * Notify the TaskDB that crinitTaskDB_t::spawnFunc can accept tasks again after it has failed with EAGAIN.
+ *
+ * Wakes up crinitTaskDBWaitSpawnRetry().
+ *
+ * Modifies errno.
+ *
+ * @param ctx  The TaskDB context.
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitTaskDBDispatchSpaceFreed(crinitTaskDB_t *ctx);
+
 /**
  * Inhibit or un-inhibit spawning of processes by setting crinitTaskDB_t::spawnInhibit.
  *
@@ -354,6 +784,20 @@ int crinitTaskDBSpawnReady(crinitTaskDB_t *ctx, crinitDispatchThreadMode_t mode)
  * @return 0 on success, -1 otherwise
  */
 int crinitTaskDBSetSpawnInhibit(crinitTaskDB_t *ctx, bool inh);
+/**
+ * Wait until there are tasks to be spawned by crinitTaskDBSpawnReady().
+ *
+ * Blocks on crinitTaskDB_t::ready until crinitTaskDB_t::readyQueue is non-empty and crinitTaskDB_t::spawnInhibit is
+ * false. Returns immediately if that is already the case. The function uses crinitTaskDB_t::lock for synchronization
+ * and is thread-safe.
+ *
+ * Modifies errno.
+ *
+ * @param ctx  The TaskDB context to wait on.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+int crinitTaskDBWaitReady(crinitTaskDB_t *ctx);
 
 /**
  *  Initialize the internals of an crinitTaskDB_t with a specified initial size for crinitTaskDB_t::taskSet.
@@ -397,7 +841,8 @@ int crinitTaskDBDestroy(crinitTaskDB_t *ctx);
  * Export the list of task names currently in the task database.
  *
  * The function allocates an array of strings as \a tasks and returns the number of array elements in \a numTasks.
- * Each entry in the \a tasks array will be allocated separately and needs to be freed by the caller.
+ * Each entry in the \a tasks array will be allocated separately and needs to be freed by the caller. The function uses
+ * crinitTaskDB_t::queryLock for synchronization and is thread-safe.
  *
  * Modifies errno.
  *
@@ -409,4 +854,27 @@ int crinitTaskDBDestroy(crinitTaskDB_t *ctx);
  */
 int crinitTaskDBExportTaskNamesToArray(crinitTaskDB_t *ctx, char **tasks[], size_t *numTasks);
 
+/**
+ * Export a snapshot of the status of all tasks in the task database matching a filter.
+ *
+ * The status of all selected tasks is copied while holding crinitTaskDB_t::queryLock for reading once, so the result is
+ * consistent across tasks. The returned array is a single allocation also holding crinitTaskDBStatus_t::name,
+ * crinitTaskDBStatus_t::username, and crinitTaskDBStatus_t::groupname of each element and must be freed using free().
+ *
+ * If crinitTaskListFilter_t::numNames of \a filter is not 0, the result contains the named tasks in the given order.
+ * Names of tasks not in the task database are skipped. Otherwise, the result contains all tasks in the order they
+ * were added.
+ *
+ * Modifies errno.
+ *
+ * @param ctx       The TaskDB context from which to get the status of the tasks.
+ * @param tasks     Return pointer for the array of task status, NULL if no task matches.
+ * @param numTasks  Return pointer for the number of array elements.
+ * @param filter    The tasks to select, may be NULL to select all tasks.
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitTaskDBExportTaskStatus(crinitTaskDB_t *ctx, crinitTaskDBStatus_t **tasks, size_t *numTasks,
+                                 const crinitTaskListFilter_t *filter);
+
 #endif /* __TASKDB_H__ */
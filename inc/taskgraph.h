@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file taskgraph.h
+ * @brief Header related to the analysis of the dependency graph formed by the tasks in a TaskDB.
+ *
+ * Every dependency of a task on another task (`<task_name>:<event>`) or on a feature provided by other tasks
+ * (`@provided:<feature>`) is an edge of the graph. Other special dependencies, like `@ctl:enable`, are fulfilled from
+ * outside of the TaskDB and are not part of the graph. As fulfilled dependencies are removed from crinitTask_t::deps,
+ * the analysis always reflects the dependencies which are still pending at the time it is run.
+ */
+#ifndef __TASKGRAPH_H__
+#define __TASKGRAPH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "taskdb.h"
+
+#define CRINIT_TASKGRAPH_DEFAULT_WEIGHT 1  ///< Weight in microseconds of a task without a known run duration.
+
+/**
+ * Type to store the analysis results for a single task.
+ */
+typedef struct crinitTaskGraphNode {
+    char *name;           ///< Name of the task, dynamically allocated.
+    uint64_t duration;    ///< Duration of the last successful run of the task in microseconds, 0 if unknown.
+    uint64_t critPath;    ///< Length of the critical path from the start of the task to the end of the last task
+                          ///< (transitively) depending on it in microseconds. Tasks without a known duration count
+                          ///< with #CRINIT_TASKGRAPH_DEFAULT_WEIGHT. 0 if the task is in or blocked by a cycle.
+    uint32_t level;       ///< Topological level, 0 if the task does not depend on other tasks or is in or blocked by a
+                          ///< cycle.
+    uint32_t prio;        ///< Spawn priority derived from critPath, see crinitTaskDBSetSpawnPrio().
+    unsigned long flags;  ///< Bitmask of CRINIT_DEPGRAPH_* flags.
+} crinitTaskGraphNode_t;
+
+/**
+ * Type to store the analysis results for a whole TaskDB.
+ */
+typedef struct crinitTaskGraph {
+    crinitTaskGraphNode_t *nodes;  ///< Array of analysis results, indexed by crinitTaskHandle_t.
+    size_t numNodes;               ///< Number of elements in nodes.
+    size_t numCycleTasks;          ///< Number of tasks with #CRINIT_DEPGRAPH_CYCLE set.
+    size_t numBlockedTasks;        ///< Number of tasks with #CRINIT_DEPGRAPH_BLOCKED set.
+    size_t numDanglingDeps;        ///< Number of dependencies which no task in the TaskDB can fulfill.
+} crinitTaskGraph_t;
+
+/**
+ * Analyze the dependency graph of a TaskDB and update the spawn priorities of its tasks.
+ *
+ * Detects dependency cycles and dependencies which cannot be fulfilled by any task in the TaskDB, sorts the tasks
+ * topologically and computes the length of their critical paths, using the duration of the last successful run of each
+ * task as its weight if known. The spawn priority of each task is set according to the length of its critical path, so
+ * that crinitTaskDBSpawnReady() starts the tasks which delay the rest of the graph most first.
+ *
+ * Holds crinitTaskDB_t::lock from taking the graph from the TaskDB until the priorities are set, so they always match
+ * the tasks they are computed from. The analysis is linear in the number of tasks and dependencies.
+ * The results must be freed using crinitTaskGraphDestroy().
+ *
+ * @param graph  Return pointer for the analysis results.
+ * @param ctx    The TaskDB to analyze.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+int crinitTaskGraphAnalyze(crinitTaskGraph_t *graph, crinitTaskDB_t *ctx);
+
+/**
+ * Free the memory held by the results of crinitTaskGraphAnalyze().
+ *
+ * @param graph  The analysis results to free.
+ */
+void crinitTaskGraphDestroy(crinitTaskGraph_t *graph);
+
+/**
+ * Analyze the dependency graph of a TaskDB, update the spawn priorities of its tasks and report problems.
+ *
+ * Meant to be called whenever tasks have been added to the TaskDB. Calls crinitTaskGraphAnalyze() and prints an error
+ * message for every task which will never be started due to a dependency cycle and a message for every task which has
+ * dependencies no task can currently fulfill.
+ *
+ * @param ctx  The TaskDB to analyze.
+ *
+ * @return  0 on success, -1 if the analysis failed.
+ */
+int crinitTaskGraphUpdate(crinitTaskDB_t *ctx);
+
+#endif /* __TASKGRAPH_H__ */
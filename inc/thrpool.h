@@ -2,7 +2,7 @@
 /**
  * @file thrpool.h
  * @brief Header defining a generic worker thread pool. Used by the notification/service interface to handle socket
- * communication.
+ * communication and by the Process Dispatcher.
  */
 #ifndef __THRPOOL_H__
 #define __THRPOOL_H__
@@ -29,6 +29,7 @@ typedef struct crinitTimer {
     char *name;
     size_t refs;
     struct itimerspec next;
+    bool respawn;  ///< If true, this is a one-shot timer ending the respawn delay of the task called name.
 } crinitTimer_t;
 
 /**
@@ -48,12 +48,24 @@ int crinitTimerDBSpawn(void);
  *
  * @param timerStr  the configuration string/name for the timer
  */
-void crinitTimerDBAddTimer(char *timerStr);
+void crinitTimerDBAddTimer(const char *timerStr);
 /**
  * Removes a timer from crinits timerDB.
  *
  * @param timerStr  the configuration string/name for the timer
  */
-void crinitTimerDBRemoveTimer(char *timerStr);
+void crinitTimerDBRemoveTimer(const char *timerStr);
+/**
+ * Arms a one-shot timer ending the respawn delay of a task.
+ *
+ * Once \a delayMs milliseconds have passed, the timer thread calls crinitTaskDBEndRespawnDelay() for the task and
+ * removes the timer. If a respawn timer for the task is already armed, it is re-armed with the new delay.
+ *
+ * @param taskName  the name of the task waiting to be respawned
+ * @param delayMs   the delay in milliseconds
+ *
+ * @return 0 on success, -1 on error
+ */
+int crinitTimerDBAddRespawnTimer(const char *taskName, unsigned int delayMs);
 
 #endif /* __TIMER_DB_H__ */
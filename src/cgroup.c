@@ -368,6 +368,18 @@ int crinitCGroupAssignPID(crinitCgroup_t *cgroup, pid_t pid) {
     return result;
 }
 
+int crinitCGroupOpenDir(const crinitCgroup_t *cgroup) {
+    crinitNullCheck(-1, cgroup);
+
+    // The cgroup may be shared with other threads, so use a private handle.
+    crinitCgroup_t handle = *cgroup;
+    if (crinitCgroupOpen(&handle, false) == -1) {
+        crinitErrPrint("Could not open cgroup '%s'.", (cgroup->name != NULL) ? cgroup->name : "(null)");
+        return -1;
+    }
+    return handle.groupFd;
+}
+
 /** Read buffer size to read controllers.
  *
  *  Should be sufficent for most cases to read all available controllers in one go.
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file cmdtmpl.c
+ * @brief Implementation of command templates.
+ */
+#include "cmdtmpl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "lexers.h"
+#include "logio.h"
+
+/** Size of a buffer large enough for the decimal representation of an int including the terminating null byte. **/
+#define CRINIT_CMDTMPL_INT_BUF_SIZE 12
+
+/**
+ * Type to map a variable name to a crinitCmdVar_t.
+ */
+typedef struct crinitCmdVarName {
+    const char *name;    ///< The name as used in `${NAME}`.
+    crinitCmdVar_t var;  ///< The corresponding variable.
+} crinitCmdVarName_t;
+
+/** Names of the supported variables. **/
+static const crinitCmdVarName_t crinitCmdVarNames[] = {
+    {"TASK_PID", CRINIT_CMD_VAR_TASK_PID},
+    {"MAINPID", CRINIT_CMD_VAR_TASK_PID},
+    {"TASK_NAME", CRINIT_CMD_VAR_TASK_NAME},
+    {"EXIT_STATUS", CRINIT_CMD_VAR_EXIT_STATUS},
+};
+
+/**
+ * Look up a variable by name.
+ *
+ * @param name  Start of the name, not null-terminated.
+ * @param len   Length of the name.
+ *
+ * @return  The variable or #CRINIT_CMD_VAR_NONE if \a name is unknown.
+ */
+static crinitCmdVar_t crinitCmdVarFind(const char *name, size_t len);
+/**
+ * Locate the variable references in the arguments of a command.
+ *
+ * Called twice by crinitCmdTmplCompile(), first without output to count the segments.
+ *
+ * @param segs  Output array for the segments, may be NULL.
+ * @param argc  Number of arguments.
+ * @param argv  The arguments.
+ *
+ * @return  The number of segments.
+ */
+static size_t crinitCmdTmplScan(crinitCmdTmplSeg_t *segs, int argc, char *const argv[]);
+
+int crinitCmdTmplCompile(crinitCmdTmpl_t **tmpl, int argc, char *const argv[]) {
+    crinitNullCheck(-1, tmpl, argv);
+
+    *tmpl = NULL;
+    size_t segsSize = crinitCmdTmplScan(NULL, argc, argv);
+    if (segsSize == 0) {
+        return 0;
+    }
+
+    *tmpl = malloc(sizeof(**tmpl) + segsSize * sizeof((*tmpl)->segs[0]));
+    if (*tmpl == NULL) {
+        crinitErrnoPrint("Could not allocate memory for command template with %zu segments.", segsSize);
+        return -1;
+    }
+    (*tmpl)->segsSize = crinitCmdTmplScan((*tmpl)->segs, argc, argv);
+    return 0;
+}
+
+int crinitCmdTmplExpand(char ***out, const crinitCmdTmpl_t *tmpl, int argc, char *const argv[],
+                        const crinitCmdVarVals_t *vals) {
+    crinitNullCheck(-1, out, tmpl, argv, vals);
+
+    char pidStr[CRINIT_CMDTMPL_INT_BUF_SIZE], exitStatusStr[CRINIT_CMDTMPL_INT_BUF_SIZE];
+    snprintf(pidStr, sizeof(pidStr), "%d", (int)vals->pid);
+    snprintf(exitStatusStr, sizeof(exitStatusStr), "%d", vals->exitStatus);
+    const char *valStr[CRINIT_CMD_VARS_COUNT] = {
+        [CRINIT_CMD_VAR_TASK_PID] = pidStr,
+        [CRINIT_CMD_VAR_TASK_NAME] = (vals->taskName != NULL) ? vals->taskName : "",
+        [CRINIT_CMD_VAR_EXIT_STATUS] = exitStatusStr,
+    };
+    size_t valLen[CRINIT_CMD_VARS_COUNT];
+    for (size_t i = 0; i < CRINIT_CMD_VARS_COUNT; i++) {
+        valLen[i] = strlen(valStr[i]);
+    }
+
+    // Sum up the size of the expanded arguments so that they fit into a single allocation.
+    size_t bufLen = 0, k = 0;
+    for (int j = 0; j < argc; j++) {
+        if (k < tmpl->segsSize && tmpl->segs[k].arg == j) {
+            for (; k < tmpl->segsSize && tmpl->segs[k].arg == j; k++) {
+                bufLen += tmpl->segs[k].litLen;
+                if (tmpl->segs[k].var != CRINIT_CMD_VAR_NONE) {
+                    bufLen += valLen[tmpl->segs[k].var];
+                }
+            }
+        } else {
+            bufLen += strlen(argv[j]);
+        }
+        bufLen++;
+    }
+
+    char **outArgv = calloc(argc + 1, sizeof(*outArgv));
+    char *buf = malloc(bufLen);
+    if (outArgv == NULL || buf == NULL) {
+        crinitErrnoPrint("Could not allocate memory for expanded command with %d arguments.", argc);
+        free(outArgv);
+        free(buf);
+        return -1;
+    }
+
+    char *p = buf;
+    k = 0;
+    for (int j = 0; j < argc; j++) {
+        outArgv[j] = p;
+        if (k < tmpl->segsSize && tmpl->segs[k].arg == j) {
+            for (; k < tmpl->segsSize && tmpl->segs[k].arg == j; k++) {
+                const crinitCmdTmplSeg_t *seg = &tmpl->segs[k];
+                memcpy(p, argv[j] + seg->litOff, seg->litLen);
+                p += seg->litLen;
+                if (seg->var != CRINIT_CMD_VAR_NONE) {
+                    memcpy(p, valStr[seg->var], valLen[seg->var]);
+                    p += valLen[seg->var];
+                }
+            }
+            *p++ = '\0';
+        } else {
+            size_t len = strlen(argv[j]) + 1;
+            memcpy(p, argv[j], len);
+            p += len;
+        }
+    }
+
+    *out = outArgv;
+    return 0;
+}
+
+int crinitCmdTmplDup(crinitCmdTmpl_t **out, const crinitCmdTmpl_t *tmpl) {
+    crinitNullCheck(-1, out);
+
+    *out = NULL;
+    if (tmpl == NULL) {
+        return 0;
+    }
+    size_t size = sizeof(*tmpl) + tmpl->segsSize * sizeof(tmpl->segs[0]);
+    *out = malloc(size);
+    if (*out == NULL) {
+        crinitErrnoPrint("Could not allocate memory for copy of command template.");
+        return -1;
+    }
+    memcpy(*out, tmpl, size);
+    return 0;
+}
+
+static crinitCmdVar_t crinitCmdVarFind(const char *name, size_t len) {
+    for (size_t i = 0; i < sizeof(crinitCmdVarNames) / sizeof(crinitCmdVarNames[0]); i++) {
+        if (strncmp(crinitCmdVarNames[i].name, name, len) == 0 && crinitCmdVarNames[i].name[len] == '\0') {
+            return crinitCmdVarNames[i].var;
+        }
+    }
+    return CRINIT_CMD_VAR_NONE;
+}
+
+static size_t crinitCmdTmplScan(crinitCmdTmplSeg_t *segs, int argc, char *const argv[]) {
+    size_t n = 0;
+    for (int j = 0; j < argc; j++) {
+        const size_t argStart = n;
+        const char *s = argv[j], *lit = argv[j], *mbegin = NULL, *mend = NULL;
+        crinitTokenType_t tt;
+        do {
+            tt = crinitEnvVarInnerLex(&s, &mbegin, &mend);
+            if (tt != CRINIT_TK_VAR) {
+                continue;  // Everything else, including escape sequences, is copied as it is.
+            }
+            crinitCmdVar_t var = crinitCmdVarFind(mbegin, (size_t)(mend - mbegin));
+            if (var == CRINIT_CMD_VAR_NONE) {
+                continue;
+            }
+            // The match only contains the name, the reference starts with "${" directly in front of it.
+            const char *ref = mbegin - 2;
+            if (segs != NULL) {
+                segs[n] = (crinitCmdTmplSeg_t){j, (size_t)(lit - argv[j]), (size_t)(ref - lit), var};
+            }
+            n++;
+            lit = s;
+        } while (tt != CRINIT_TK_END && tt != CRINIT_TK_ERR);
+
+        if (tt == CRINIT_TK_ERR) {
+            crinitDbgInfoPrint("Will not expand variables in argument '%s' as it could not be parsed.", argv[j]);
+            n = argStart;
+        } else if (n > argStart) {
+            if (segs != NULL) {
+                segs[n] = (crinitCmdTmplSeg_t){j, (size_t)(lit - argv[j]), strlen(lit), CRINIT_CMD_VAR_NONE};
+            }
+            n++;
+        }
+    }
+    return n;
+}
@@ -31,6 +31,7 @@
 #include "globopt.h"
 #include "lexers.h"
 #include "logio.h"
+#include "strintern.h"
 #include "timerdb.h"
 
 /**
@@ -234,6 +235,10 @@ int crinitCfgStopCmdHandler(void *tgt, const char *val, crinitConfigType_t type)
         crinitErrPrint("Could not extract argv/argc from '%s' index %zu.", CRINIT_CONFIG_KEYSTR_STOP_COMMAND, newIdx);
         return -1;
     }
+    if (crinitCmdTmplCompile(&t->stopCmds[newIdx].tmpl, t->stopCmds[newIdx].argc, t->stopCmds[newIdx].argv) == -1) {
+        crinitErrPrint("Could not parse variables in '%s' index %zu.", CRINIT_CONFIG_KEYSTR_STOP_COMMAND, newIdx);
+        return -1;
+    }
     return 0;
 }
 
@@ -263,37 +268,38 @@ static int crinitDepListHandler(crinitTaskDep_t **list, size_t *listSize, const
     *listSize = newSz;
 
     for (size_t i = oldSz; i < *listSize; i++) {
-        (*list)[i].name = strdup(tempDeps[i - oldSz]);
-        if ((*list)[i].name == NULL) {
-            crinitErrnoPrint("Could not duplicate string for dependency '%s'.", tempDeps[i - oldSz]);
-            *listSize = i;
-            crinitFreeArgvArray(tempDeps);
-            return -1;
-        }
-
         char *strtokState = NULL;
-        (*list)[i].name = strtok_r((*list)[i].name, ":", &strtokState);
-        (*list)[i].event = strtok_r(NULL, " ", &strtokState);
+        const char *depName = strtok_r(tempDeps[i - oldSz], ":", &strtokState);
+        const char *depEvent = strtok_r(NULL, " ", &strtokState);
 
-        if ((*list)[i].name == NULL || (*list)[i].event == NULL) {
+        if (depName == NULL || depEvent == NULL) {
             crinitErrPrint("Could not parse dependency '%s'.", tempDeps[i - oldSz]);
             *listSize = i;
-            free((*list)[i].name);
             crinitFreeArgvArray(tempDeps);
             return -1;
         }
-        if (strcmp((*list)[i].name, "@timer") == 0) {
-            crinitTimerDBAddTimer((*list)[i].event);
-        }
 #ifndef ENABLE_ELOS
-        if (strcmp((*list)[i].name, "@elos") == 0) {
+        if (strcmp(depName, "@elos") == 0) {
             crinitErrPrint("To depend on an ELOS filter ELOS support must be enabled at compile time.");
             *listSize = i;
-            free((*list)[i].name);
             crinitFreeArgvArray(tempDeps);
             return -1;
         }
 #endif
+
+        (*list)[i].name = crinitStrIntern(depName);
+        (*list)[i].event = crinitStrIntern(depEvent);
+        if ((*list)[i].name == NULL || (*list)[i].event == NULL) {
+            crinitErrPrint("Could not intern strings for dependency '%s:%s'.", depName, depEvent);
+            crinitStrInternRelease((*list)[i].name);
+            crinitStrInternRelease((*list)[i].event);
+            *listSize = i;
+            crinitFreeArgvArray(tempDeps);
+            return -1;
+        }
+        if (strcmp(depName, "@timer") == 0) {
+            crinitTimerDBAddTimer(depEvent);
+        }
     }
 
     crinitFreeArgvArray(tempDeps);
@@ -328,6 +334,18 @@ int crinitCfgTrigRearmHandler(void *tgt, const char *val, crinitConfigType_t typ
     return 0;
 }
 
+int crinitCfgReadyFdHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitInfoPrint("Parsing value of boolean option '%s'.", CRINIT_CONFIG_KEYSTR_READY_FD);
+    crinitTask_t *t = tgt;
+    if (crinitCfgHandlerSetTaskOptFromStr(&t->opts, CRINIT_TASK_OPT_READY_FD, val) == -1) {
+        crinitErrPrint("Could not parse value of boolean option '%s'.", CRINIT_CONFIG_KEYSTR_READY_FD);
+        return -1;
+    }
+    return 0;
+}
+
 int crinitCfgPrvHandler(void *tgt, const char *val, crinitConfigType_t type) {
     crinitNullCheck(-1, tgt, val);
     crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
@@ -358,17 +376,13 @@ int crinitCfgPrvHandler(void *tgt, const char *val, crinitConfigType_t type) {
 
     for (size_t i = oldSz; i < t->prvSize; i++) {
         crinitTaskPrv_t *ptr = &t->prv[i];
+        char *prvName = tempPrvs[i - oldSz];
         ptr->stateReq = 0;
-        ptr->name = strdup(tempPrvs[i - oldSz]);
-        if (ptr->name == NULL) {
-            crinitErrnoPrint("Could not duplicate string for %s.", CRINIT_CONFIG_KEYSTR_PROVIDES);
-            crinitFreeArgvArray(tempPrvs);
-            return -1;
-        }
 
-        char *delimPtr = strchr(ptr->name, ':');
+        char *delimPtr = strchr(prvName, ':');
         if (delimPtr == NULL) {
-            crinitErrnoPrint("Could not parse '%s' in %s.", ptr->name, CRINIT_CONFIG_KEYSTR_PROVIDES);
+            crinitErrnoPrint("Could not parse '%s' in %s.", prvName, CRINIT_CONFIG_KEYSTR_PROVIDES);
+            t->prvSize = i;
             crinitFreeArgvArray(tempPrvs);
             return -1;
         }
@@ -380,7 +394,8 @@ int crinitCfgPrvHandler(void *tgt, const char *val, crinitConfigType_t type) {
         } else if (strncmp(delimPtr, CRINIT_TASK_EVENT_FAILED, strlen(CRINIT_TASK_EVENT_FAILED)) == 0) {
             ptr->stateReq = CRINIT_TASK_STATE_FAILED;
         } else {
-            crinitErrnoPrint("Could not parse '%s' in %s.", ptr->name, CRINIT_CONFIG_KEYSTR_PROVIDES);
+            crinitErrnoPrint("Could not parse '%s' in %s.", prvName, CRINIT_CONFIG_KEYSTR_PROVIDES);
+            t->prvSize = i;
             crinitFreeArgvArray(tempPrvs);
             return -1;
         }
@@ -389,6 +404,14 @@ int crinitCfgPrvHandler(void *tgt, const char *val, crinitConfigType_t type) {
         if (delimPtr != NULL && strcmp(delimPtr, CRINIT_TASK_EVENT_NOTIFY_SUFFIX) == 0) {
             ptr->stateReq |= CRINIT_TASK_STATE_NOTIFIED;
         }
+
+        ptr->name = crinitStrIntern(prvName);
+        if (ptr->name == NULL) {
+            crinitErrPrint("Could not intern string for %s.", CRINIT_CONFIG_KEYSTR_PROVIDES);
+            t->prvSize = i;
+            crinitFreeArgvArray(tempPrvs);
+            return -1;
+        }
     }
 
     crinitFreeArgvArray(tempPrvs);
@@ -524,6 +547,118 @@ int crinitCfgRespRetHandler(void *tgt, const char *val, crinitConfigType_t type)
     return 0;
 }
 
+int crinitCfgRespDelayHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitConfConvToInteger(&t->respawnDelay, val, 10) == -1) {
+        crinitErrPrint("Could not parse value of unsigned numeric option '%s'.", CRINIT_CONFIG_KEYSTR_RESPAWN_DELAY);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgRespDelayMaxHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitConfConvToInteger(&t->backoffLimit, val, 10) == -1) {
+        crinitErrPrint("Could not parse value of unsigned numeric option '%s'.",
+                       CRINIT_CONFIG_KEYSTR_RESPAWN_DELAY_MAX);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgRespBurstHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitConfConvToInteger(&t->respawnBurst, val, 10) == -1) {
+        crinitErrPrint("Could not parse value of unsigned numeric option '%s'.", CRINIT_CONFIG_KEYSTR_RESPAWN_BURST);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgRespBurstIntervalHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitConfConvToInteger(&t->burstInterval, val, 10) == -1) {
+        crinitErrPrint("Could not parse value of unsigned numeric option '%s'.",
+                       CRINIT_CONFIG_KEYSTR_RESPAWN_BURST_INTERVAL);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgRespCooldownHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitConfConvToInteger(&t->burstCooldown, val, 10) == -1) {
+        crinitErrPrint("Could not parse value of unsigned numeric option '%s'.", CRINIT_CONFIG_KEYSTR_RESPAWN_COOLDOWN);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgNiceHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitSchedParamsParse(&t->sched, CRINIT_SCHED_PARAM_NICE, val) == -1) {
+        crinitErrPrint("Could not parse value of option '%s'.", CRINIT_CONFIG_KEYSTR_NICE);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgSchedPolicyHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitSchedParamsParse(&t->sched, CRINIT_SCHED_PARAM_POLICY, val) == -1) {
+        crinitErrPrint("Could not parse value of option '%s'.", CRINIT_CONFIG_KEYSTR_SCHED_POLICY);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgCpuAffinityHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitSchedParamsParse(&t->sched, CRINIT_SCHED_PARAM_AFFINITY, val) == -1) {
+        crinitErrPrint("Could not parse value of option '%s'.", CRINIT_CONFIG_KEYSTR_CPU_AFFINITY);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgIoPriorityHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitSchedParamsParse(&t->sched, CRINIT_SCHED_PARAM_IOPRIO, val) == -1) {
+        crinitErrPrint("Could not parse value of option '%s'.", CRINIT_CONFIG_KEYSTR_IO_PRIORITY);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgOomScoreAdjHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    crinitNullCheck(-1, tgt, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
+    crinitTask_t *t = tgt;
+    if (crinitSchedParamsParse(&t->sched, CRINIT_SCHED_PARAM_OOM_SCORE_ADJ, val) == -1) {
+        crinitErrPrint("Could not parse value of option '%s'.", CRINIT_CONFIG_KEYSTR_OOM_SCORE_ADJ);
+        return -1;
+    }
+    return 0;
+}
+
 int crinitTaskIncludeHandler(void *tgt, const char *val, crinitConfigType_t type) {
     crinitNullCheck(-1, tgt, val);
     crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_TASK);
@@ -1075,6 +1210,40 @@ int crinitCfgShdGpHandler(void *tgt, const char *val, crinitConfigType_t type) {
     return 0;
 }
 
+int crinitCfgDispWorkersHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    CRINIT_PARAM_UNUSED(tgt);
+    crinitNullCheck(-1, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_SERIES);
+
+    unsigned long long workers;
+    if (crinitConfConvToInteger(&workers, val, 10) == -1 || workers == 0) {
+        crinitErrPrint("The value for '%s' must be a positive integer.", CRINIT_CONFIG_KEYSTR_DISPATCH_WORKERS);
+        return -1;
+    }
+    if (crinitGlobOptSet(CRINIT_GLOBOPT_DISPATCH_WORKERS, workers) == -1) {
+        crinitErrPrint("Could not set global option '%s'.", CRINIT_CONFIG_KEYSTR_DISPATCH_WORKERS);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitCfgDispQueueDepthHandler(void *tgt, const char *val, crinitConfigType_t type) {
+    CRINIT_PARAM_UNUSED(tgt);
+    crinitNullCheck(-1, val);
+    crinitCfgHandlerTypeCheck(CRINIT_CONFIG_TYPE_SERIES);
+
+    unsigned long long depth;
+    if (crinitConfConvToInteger(&depth, val, 10) == -1 || depth == 0) {
+        crinitErrPrint("The value for '%s' must be a positive integer.", CRINIT_CONFIG_KEYSTR_DISPATCH_QUEUE_DEPTH);
+        return -1;
+    }
+    if (crinitGlobOptSet(CRINIT_GLOBOPT_DISPATCH_QUEUE_DEPTH, depth) == -1) {
+        crinitErrPrint("Could not set global option '%s'.", CRINIT_CONFIG_KEYSTR_DISPATCH_QUEUE_DEPTH);
+        return -1;
+    }
+    return 0;
+}
+
 int crinitCfgTaskSuffixHandler(void *tgt, const char *val, crinitConfigType_t type) {
     CRINIT_PARAM_UNUSED(tgt);
     crinitNullCheck(-1, val);
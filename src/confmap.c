@@ -20,16 +20,29 @@ const crinitConfigMapping_t crinitTaskCfgMap[] = {
     {CRINIT_CONFIG_CGROUP_PARAMS, CRINIT_CONFIG_KEYSTR_CGROUP_PARAMS, true, false, crinitCfgCgroupParamsHandler},
 #endif
     {CRINIT_CONFIG_COMMAND, CRINIT_CONFIG_KEYSTR_COMMAND, true, false, crinitCfgCmdHandler},
+    {CRINIT_CONFIG_CPU_AFFINITY, CRINIT_CONFIG_KEYSTR_CPU_AFFINITY, false, false, crinitCfgCpuAffinityHandler},
     {CRINIT_CONFIG_DEPENDS, CRINIT_CONFIG_KEYSTR_DEPENDS, true, true, crinitCfgDepHandler},
     {CRINIT_CONFIG_ENV_SET, CRINIT_CONFIG_KEYSTR_ENV_SET, true, true, crinitCfgEnvHandler},
     {CRINIT_CONFIG_FILTER_DEFINE, CRINIT_CONFIG_KEYSTR_FILTER_DEFINE, true, true, crinitCfgFilterHandler},
     {CRINIT_CONFIG_GROUP, CRINIT_CONFIG_KEYSTR_GROUP, true, false, crinitCfgGroupHandler},
     {CRINIT_CONFIG_INCLUDE, CRINIT_CONFIG_KEYSTR_INCLUDE, true, false, crinitTaskIncludeHandler},
+    {CRINIT_CONFIG_IO_PRIORITY, CRINIT_CONFIG_KEYSTR_IO_PRIORITY, false, false, crinitCfgIoPriorityHandler},
     {CRINIT_CONFIG_IOREDIR, CRINIT_CONFIG_KEYSTR_IOREDIR, true, true, crinitCfgIoRedirHandler},
     {CRINIT_CONFIG_NAME, CRINIT_CONFIG_KEYSTR_NAME, false, false, crinitCfgNameHandler},
+    {CRINIT_CONFIG_NICE, CRINIT_CONFIG_KEYSTR_NICE, false, false, crinitCfgNiceHandler},
+    {CRINIT_CONFIG_OOM_SCORE_ADJ, CRINIT_CONFIG_KEYSTR_OOM_SCORE_ADJ, false, false, crinitCfgOomScoreAdjHandler},
     {CRINIT_CONFIG_PROVIDES, CRINIT_CONFIG_KEYSTR_PROVIDES, true, false, crinitCfgPrvHandler},
+    {CRINIT_CONFIG_READY_FD, CRINIT_CONFIG_KEYSTR_READY_FD, false, false, crinitCfgReadyFdHandler},
     {CRINIT_CONFIG_RESPAWN, CRINIT_CONFIG_KEYSTR_RESPAWN, false, false, crinitCfgRespHandler},
+    {CRINIT_CONFIG_RESPAWN_BURST, CRINIT_CONFIG_KEYSTR_RESPAWN_BURST, false, false, crinitCfgRespBurstHandler},
+    {CRINIT_CONFIG_RESPAWN_BURST_INTERVAL, CRINIT_CONFIG_KEYSTR_RESPAWN_BURST_INTERVAL, false, false,
+     crinitCfgRespBurstIntervalHandler},
+    {CRINIT_CONFIG_RESPAWN_COOLDOWN, CRINIT_CONFIG_KEYSTR_RESPAWN_COOLDOWN, false, false, crinitCfgRespCooldownHandler},
+    {CRINIT_CONFIG_RESPAWN_DELAY_MAX, CRINIT_CONFIG_KEYSTR_RESPAWN_DELAY_MAX, false, false,
+     crinitCfgRespDelayMaxHandler},
+    {CRINIT_CONFIG_RESPAWN_DELAY, CRINIT_CONFIG_KEYSTR_RESPAWN_DELAY, false, false, crinitCfgRespDelayHandler},
     {CRINIT_CONFIG_RESPAWN_RETRIES, CRINIT_CONFIG_KEYSTR_RESPAWN_RETRIES, false, false, crinitCfgRespRetHandler},
+    {CRINIT_CONFIG_SCHED_POLICY, CRINIT_CONFIG_KEYSTR_SCHED_POLICY, false, false, crinitCfgSchedPolicyHandler},
     {CRINIT_CONFIG_STOP_COMMAND, CRINIT_CONFIG_KEYSTR_STOP_COMMAND, true, false, crinitCfgStopCmdHandler},
     {CRINIT_CONFIG_TRIGGER, CRINIT_CONFIG_KEYSTR_TRIGGER, true, true, crinitCfgTrigHandler},
     {CRINIT_CONFIG_TRIGGER_REARM, CRINIT_CONFIG_KEYSTR_TRIGGER_REARM, false, false, crinitCfgTrigRearmHandler},
@@ -51,6 +64,10 @@ const crinitConfigMapping_t crinitSeriesCfgMap[] = {
 #ifdef ENABLE_CAPABILITIES
     {CRINIT_CONFIG_DEFAULTCAPS, CRINIT_CONFIG_KEYSTR_DEFAULTCAPS, true, false, crinitCfgDefaultCapsHandler},
 #endif
+    {CRINIT_CONFIG_DISPATCH_QUEUE_DEPTH, CRINIT_CONFIG_KEYSTR_DISPATCH_QUEUE_DEPTH, false, false,
+     crinitCfgDispQueueDepthHandler},
+    {CRINIT_CONFIG_DISPATCH_WORKERS, CRINIT_CONFIG_KEYSTR_DISPATCH_WORKERS, false, false,
+     crinitCfgDispWorkersHandler},
     {CRINIT_CONFIG_ELOS_EVENT_POLL_INTERVAL, CRINIT_CONFIG_KEYSTR_ELOS_EVENT_POLL_INTERVAL, false, false,
      crinitCfgElosEventPollIntervalHandler},
     {CRINIT_CONFIG_ELOS_PORT, CRINIT_CONFIG_KEYSTR_ELOS_PORT, false, false, crinitCfgElosPortHandler},
@@ -3,10 +3,14 @@
  * @file crinit-client.c
  * @brief Implementation of the crinit-client shared library.
  */
+#define _GNU_SOURCE  ///< Needed for O_DIRECT.
 #include "crinit-client.h"
 
+#include <fcntl.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "common.h"
@@ -32,11 +36,17 @@
 
 /** String to be used if no task name for sd_notify() is currently set. **/
 #define CRINIT_ENV_NOTIFY_NAME_UNDEF "@undefined"
+/** Size of a buffer large enough for the decimal representation of an unsigned long including the null byte. **/
+#define CRINIT_CLIENT_ULONG_BUF_SIZE 21
 
 /** Holds the task name for sd_notify() **/
 static const char *crinitNotifyName = CRINIT_ENV_NOTIFY_NAME_UNDEF;
 /** Holds the path to the Crinit AF_UNIX socket file **/
 static const char *crinitSockFile = CRINIT_SOCKFILE;
+/** Holds the readiness pipe for sd_notify() if the task uses READY_FD, -1 otherwise **/
+static int crinitReadyFd = -1;
+/** Holds the persistent connection bound to the current thread, see crinitClientConnBind() **/
+static _Thread_local crinitClientConn_t *crinitBoundConn = NULL;
 
 /**
  * Check if a response from Crinit is valid and/or an error.
@@ -47,6 +57,45 @@ static const char *crinitSockFile = CRINIT_SOCKFILE;
  * @return 0 if \a res is valid and indicates success, -1 if not
  */
 static inline int crinitResponseCheck(const crinitRtimCmd_t *res, crinitRtimOp_t resCode);
+/**
+ * Get the readiness pipe passed by Crinit from the environment.
+ *
+ * As the environment variable specified by #CRINIT_ENV_READY_FD may have been inherited by a child process, the file
+ * descriptor is only used if it still refers to the write end of a pipe in packet mode.
+ *
+ * @return  The file descriptor of the readiness pipe or -1 if there is none.
+ */
+static int crinitReadyFdFromEnv(void);
+/**
+ * Perform a request/response transfer with Crinit.
+ *
+ * Uses the connection bound to the calling thread if there is one, otherwise a new connection.
+ *
+ * @param res  Return pointer for response/result.
+ * @param cmd  The command/request to send.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitClientXfer(crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
+/**
+ * Build a STATUSLIST command selecting the tasks given by a filter.
+ *
+ * @param cmd     Return pointer for the command.
+ * @param filter  The tasks to select, may be NULL to select all tasks.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitClientBuildStatusListCmd(crinitRtimCmd_t *cmd, const crinitTaskListFilter_t *filter);
+/**
+ * Get the list of tasks using TASKLIST for the names and one STATUS request per task.
+ *
+ * Fallback of crinitClientGetTaskList() for a Crinit not supporting STATUSLIST.
+ *
+ * @param tlptr  Return pointer for the list of tasks.
+ *
+ * @return 0 on success, -1 on error
+ */
+static int crinitClientGetTaskListPerTask(crinitTaskList_t **tlptr);
 
 /**
  * Library initialization function.
@@ -64,6 +113,7 @@ static CRINIT_LIB_CONSTRUCTOR void crinitLibInit(void) {
     } else {
         crinitNotifyName = CRINIT_ENV_NOTIFY_NAME_UNDEF;
     }
+    crinitReadyFd = crinitReadyFdFromEnv();
 }
 
 /**
@@ -100,6 +150,40 @@ CRINIT_LIB_EXPORTED void crinitClientSetSocketPath(const char *sockFile) {
     }
 }
 
+CRINIT_LIB_EXPORTED int crinitClientConnOpen(crinitClientConn_t **conn) {
+    if (conn == NULL) {
+        crinitErrPrint("Return pointer must not be NULL.");
+        return -1;
+    }
+    *conn = malloc(sizeof(**conn));
+    if (*conn == NULL) {
+        crinitErrnoPrint("Could not allocate memory for connection.");
+        return -1;
+    }
+    if (crinitConnOpen(*conn, crinitSockFile) == -1) {
+        crinitConnClose(*conn);
+        free(*conn);
+        *conn = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+CRINIT_LIB_EXPORTED void crinitClientConnClose(crinitClientConn_t *conn) {
+    if (conn == NULL) {
+        return;
+    }
+    if (crinitBoundConn == conn) {
+        crinitBoundConn = NULL;
+    }
+    crinitConnClose(conn);
+    free(conn);
+}
+
+CRINIT_LIB_EXPORTED void crinitClientConnBind(crinitClientConn_t *conn) {
+    crinitBoundConn = conn;
+}
+
 CRINIT_LIB_EXPORTED const crinitVersion_t *crinitClientLibGetVersion(void) {
     return &crinitVersion;
 }
@@ -116,12 +200,25 @@ CRINIT_LIB_EXPORTED int sd_notify(int unset_environment, const char *state) {  /
         crinitErrPrint("SD_NOTIFY: unset_environment is unimplemented.");
     }
 
+    // A single write() to the readiness pipe is atomic up to PIPE_BUF bytes, anything else falls back to the socket.
+    size_t stateLen = strlen(state);
+    if (crinitReadyFd != -1 && stateLen <= PIPE_BUF) {
+        ssize_t n;
+        do {
+            n = write(crinitReadyFd, state, stateLen);
+        } while (n == -1 && errno == EINTR);
+        if (n == (ssize_t)stateLen) {
+            return 0;
+        }
+        crinitDbgInfoPrint("Could not write to readiness pipe, will use the notification socket instead.");
+    }
+
     crinitRtimCmd_t cmd, res;
     if (crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_NOTIFY, 2, crinitNotifyName, state) == -1) {
         crinitErrPrint("Could not build RtimCmd to send to Crinit.");
         return -1;
     }
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -182,7 +279,7 @@ CRINIT_LIB_EXPORTED int crinitClientTaskAdd(const char *configFilePath, bool ove
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -208,7 +305,7 @@ CRINIT_LIB_EXPORTED int crinitClientSeriesAdd(const char *seriesFilePath, bool o
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -232,7 +329,7 @@ CRINIT_LIB_EXPORTED int crinitClientTaskEnable(const char *taskName) {
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -255,7 +352,7 @@ CRINIT_LIB_EXPORTED int crinitClientTaskDisable(const char *taskName) {
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -279,7 +376,7 @@ CRINIT_LIB_EXPORTED int crinitClientTaskStop(const char *taskName) {
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -303,7 +400,7 @@ CRINIT_LIB_EXPORTED int crinitClientTaskKill(const char *taskName) {
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -327,7 +424,7 @@ CRINIT_LIB_EXPORTED int crinitClientTaskRestart(const char *taskName) {
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -350,7 +447,7 @@ CRINIT_LIB_EXPORTED int crinitClientTaskGetStatus(crinitTaskState_t *s, pid_t *p
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -365,97 +462,52 @@ CRINIT_LIB_EXPORTED int crinitClientTaskGetStatus(crinitTaskState_t *s, pid_t *p
     }
 
     if (crinitResponseCheck(&res, CRINIT_RTIMCMD_R_STATUS) == 0 && res.argc == 10) {
-        char *endPtr;
+        uint64_t state, user, group;
+        int64_t taskPid;
+        struct timespec times[3];
+        const char *resUsername, *resGroupname;
+        if (crinitRtimArgGetUInt(&res.args[1], &state) == -1 || crinitRtimArgGetInt(&res.args[2], &taskPid) == -1 ||
+            crinitRtimArgGetTime(&res.args[3], &times[0]) == -1 ||
+            crinitRtimArgGetTime(&res.args[4], &times[1]) == -1 ||
+            crinitRtimArgGetTime(&res.args[5], &times[2]) == -1 || crinitRtimArgGetUInt(&res.args[6], &user) == -1 ||
+            crinitRtimArgGetUInt(&res.args[7], &group) == -1 ||
+            crinitRtimArgGetStr(&res.args[8], &resUsername) == -1 ||
+            crinitRtimArgGetStr(&res.args[9], &resGroupname) == -1) {
+            crinitErrPrint("Could not parse task status from response of Crinit.");
+            goto responseFail;
+        }
         if (s != NULL) {
-            *s = strtoul(res.args[1], &endPtr, 10);
-            if (endPtr == res.args[1] || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[1]);
-                goto responseFail;
-            }
+            *s = (crinitTaskState_t)state;
         }
         if (pid != NULL) {
-            *pid = strtol(res.args[2], &endPtr, 10);
-            if (endPtr == res.args[2] || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[2]);
-                goto responseFail;
-            }
+            *pid = (pid_t)taskPid;
         }
         if (ct != NULL) {
-            ct->tv_sec = strtoll(res.args[3], &endPtr, 10);
-            if (endPtr == res.args[3] || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[3]);
-                goto responseFail;
-            }
-            char *decPlPtr = strchr(res.args[3], '.') + 1;
-            if (decPlPtr == NULL) {
-                crinitErrPrint("Could not parse numerical value from '%s'. Missing decimal point.", res.args[3]);
-                goto responseFail;
-            }
-            ct->tv_nsec = strtol(decPlPtr, &endPtr, 10);
-            if (endPtr == decPlPtr || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[3]);
-                goto responseFail;
-            }
+            *ct = times[0];
         }
         if (st != NULL) {
-            st->tv_sec = strtoll(res.args[4], &endPtr, 10);
-            if (endPtr == res.args[4] || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[4]);
-                goto responseFail;
-            }
-            char *decPlPtr = strchr(res.args[4], '.') + 1;
-            if (decPlPtr == NULL) {
-                crinitErrPrint("Could not parse numerical value from '%s'. Missing decimal point.", res.args[4]);
-                goto responseFail;
-            }
-            st->tv_nsec = strtol(decPlPtr, &endPtr, 10);
-            if (endPtr == decPlPtr || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[4]);
-                goto responseFail;
-            }
+            *st = times[1];
         }
         if (et != NULL) {
-            et->tv_sec = strtoll(res.args[5], &endPtr, 10);
-            if (endPtr == res.args[5] || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[5]);
-                goto responseFail;
-            }
-            char *decPlPtr = strchr(res.args[5], '.') + 1;
-            if (decPlPtr == NULL) {
-                crinitErrPrint("Could not parse numerical value from '%s'. Missing decimal point.", res.args[5]);
-                goto responseFail;
-            }
-            et->tv_nsec = strtol(decPlPtr, &endPtr, 10);
-            if (endPtr == decPlPtr || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[5]);
-                goto responseFail;
-            }
+            *et = times[2];
         }
         if (uid != NULL) {
-            *uid = strtoul(res.args[6], &endPtr, 10);
-            if (endPtr == res.args[6] || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[6]);
-                goto responseFail;
-            }
+            *uid = (uid_t)user;
         }
         if (gid != NULL) {
-            *gid = strtoul(res.args[7], &endPtr, 10);
-            if (endPtr == res.args[7] || errno == ERANGE) {
-                crinitErrPrint("Could not parse numerical value from '%s'.", res.args[7]);
-                goto responseFail;
-            }
+            *gid = (gid_t)group;
         }
         if (username != NULL) {
-            *username = strdup(res.args[8]);
+            *username = strdup(resUsername);
             if (*username == NULL) {
-                crinitErrPrint("Could not copy task's username '%s'.", res.args[8]);
+                crinitErrPrint("Could not copy task's username '%s'.", resUsername);
                 goto responseFail;
             }
         }
         if (groupname != NULL) {
-            *groupname = strdup(res.args[9]);
+            *groupname = strdup(resGroupname);
             if (*groupname == NULL) {
-                crinitErrPrint("Could not copy task's groupname '%s'.", res.args[9]);
+                crinitErrPrint("Could not copy task's groupname '%s'.", resGroupname);
                 goto responseFail;
             }
         }
@@ -475,19 +527,157 @@ responseFail:
     return -1;
 }
 
+CRINIT_LIB_EXPORTED int crinitClientTaskGetUsage(crinitTaskUsage_t *usage, const char *taskName) {
+    crinitNullCheck(-1, usage, taskName);
+
+    crinitRtimCmd_t cmd, res;
+    if (crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_USAGE, 1, taskName) == -1) {
+        crinitErrPrint("Could not build RtimCmd to send to Crinit.");
+        return -1;
+    }
+
+    if (crinitClientXfer(&res, &cmd) == -1) {
+        crinitDestroyRtimCmd(&cmd);
+        crinitErrPrint("Could not complete data transfer from/to Crinit.");
+        return -1;
+    }
+    crinitDestroyRtimCmd(&cmd);
+
+    if (crinitResponseCheck(&res, CRINIT_RTIMCMD_R_USAGE) == -1) {
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+    if (res.argc != 1 + CRINIT_TASKUSAGE_FIELDS) {
+        crinitErrPrint("Got unexpected response length from Crinit.");
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+
+    // The fields are sent in the order of their declaration in crinitTaskUsage_t.
+    unsigned long long *fields[CRINIT_TASKUSAGE_FIELDS] = {&usage->userTime, &usage->sysTime,    &usage->maxRss,
+                                                           &usage->volCtxSw, &usage->involCtxSw, &usage->numProcs,
+                                                           &usage->lastRuntime};
+    for (size_t i = 0; i < CRINIT_TASKUSAGE_FIELDS; i++) {
+        uint64_t val;
+        if (crinitRtimArgGetUInt(&res.args[1 + i], &val) == -1) {
+            crinitErrPrint("Could not parse field %zu of task resource usage.", i);
+            crinitDestroyRtimCmd(&res);
+            return -1;
+        }
+        *fields[i] = val;
+    }
+
+    crinitDestroyRtimCmd(&res);
+    return 0;
+}
+
 CRINIT_LIB_EXPORTED int crinitClientGetTaskList(crinitTaskList_t **tlptr) {
     if (tlptr == NULL) {
         crinitErrPrint("Pointer arguments must not be NULL");
         return -1;
     }
 
+    if (crinitClientGetTaskStatusList(tlptr, NULL) == 0) {
+        return 0;
+    }
+    crinitDbgInfoPrint("Could not get task list in a single request, will query the status of each task.");
+    return crinitClientGetTaskListPerTask(tlptr);
+}
+
+CRINIT_LIB_EXPORTED int crinitClientGetTaskStatusList(crinitTaskList_t **tlptr, const crinitTaskListFilter_t *filter) {
+    if (tlptr == NULL) {
+        crinitErrPrint("Pointer arguments must not be NULL");
+        return -1;
+    }
+
+    crinitRtimCmd_t cmd, res;
+    if (crinitClientBuildStatusListCmd(&cmd, filter) == -1) {
+        crinitErrPrint("Could not build RtimCmd to send to Crinit.");
+        return -1;
+    }
+
+    if (crinitClientXfer(&res, &cmd) == -1) {
+        crinitDestroyRtimCmd(&cmd);
+        crinitErrPrint("Could not complete data transfer from/to Crinit.");
+        return -1;
+    }
+    crinitDestroyRtimCmd(&cmd);
+
+    if (crinitResponseCheck(&res, CRINIT_RTIMCMD_R_STATUSLIST) == -1) {
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+    if ((res.argc - 1) % CRINIT_TASKSTATUS_FIELDS != 0) {
+        crinitErrPrint("Got unexpected response length from Crinit.");
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+
+    *tlptr = malloc(sizeof(crinitTaskList_t));
+    if (*tlptr == NULL) {
+        crinitErrPrint("Could not allocate memory for task list.");
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+    crinitTaskList_t *tl = *tlptr;
+    tl->numTasks = 0;
+    tl->tasks = malloc((res.argc - 1) / CRINIT_TASKSTATUS_FIELDS * sizeof(*(tl->tasks)));
+    if (tl->tasks == NULL && res.argc > 1) {
+        crinitErrPrint("Could not allocate memory for task list entries.");
+        goto fail;
+    }
+
+    for (size_t i = 1; i < res.argc; i += CRINIT_TASKSTATUS_FIELDS) {
+        const crinitRtimArg_t *a = &res.args[i];
+        const char *name, *resUsername, *resGroupname;
+        uint64_t state, user, group;
+        int64_t taskPid, failCount;
+        struct timespec times[3];
+        if (crinitRtimArgGetStr(&a[0], &name) == -1 || crinitRtimArgGetUInt(&a[1], &state) == -1 ||
+            crinitRtimArgGetInt(&a[2], &taskPid) == -1 || crinitRtimArgGetTime(&a[3], &times[0]) == -1 ||
+            crinitRtimArgGetTime(&a[4], &times[1]) == -1 || crinitRtimArgGetTime(&a[5], &times[2]) == -1 ||
+            crinitRtimArgGetUInt(&a[6], &user) == -1 || crinitRtimArgGetUInt(&a[7], &group) == -1 ||
+            crinitRtimArgGetStr(&a[8], &resUsername) == -1 || crinitRtimArgGetStr(&a[9], &resGroupname) == -1 ||
+            crinitRtimArgGetInt(&a[10], &failCount) == -1) {
+            crinitErrPrint("Could not parse task status from response of Crinit.");
+            goto fail;
+        }
+        crinitTaskListEntry_t *e = &tl->tasks[tl->numTasks++];
+        e->name = strdup(name);
+        e->pid = (pid_t)taskPid;
+        e->state = (crinitTaskState_t)state;
+        e->createTime = times[0];
+        e->startTime = times[1];
+        e->endTime = times[2];
+        e->uid = (uid_t)user;
+        e->gid = (gid_t)group;
+        e->username = strdup(resUsername);
+        e->groupname = strdup(resGroupname);
+        e->failCount = (int)failCount;
+        if (e->name == NULL || e->username == NULL || e->groupname == NULL) {
+            crinitErrPrint("Could not allocate memory for task list entry.");
+            goto fail;
+        }
+    }
+
+    crinitDestroyRtimCmd(&res);
+    return 0;
+
+fail:
+    crinitClientFreeTaskList(tl);
+    *tlptr = NULL;
+    crinitDestroyRtimCmd(&res);
+    return -1;
+}
+
+static int crinitClientGetTaskListPerTask(crinitTaskList_t **tlptr) {
     crinitRtimCmd_t cmd, res;
     if (crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_TASKLIST, 0) == -1) {
         crinitErrPrint("Could not build RtimCmd to send to Crinit.");
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -519,7 +709,12 @@ CRINIT_LIB_EXPORTED int crinitClientGetTaskList(crinitTaskList_t **tlptr) {
     }
 
     for (size_t i = 0; i < res.argc - 1; i++) {
-        const char *name = res.args[i + 1];
+        const char *name = NULL;
+        if (crinitRtimArgGetStr(&res.args[i + 1], &name) == -1) {
+            crinitErrPrint("Got unexpected task name from Crinit.");
+            ret = -1;
+            goto fail_status;
+        }
         pid_t pid = -1;
         struct timespec ct = {0}, st = {0}, et = {0};
         gid_t gid = 0;
@@ -547,6 +742,7 @@ CRINIT_LIB_EXPORTED int crinitClientGetTaskList(crinitTaskList_t **tlptr) {
         tl->tasks[i].gid = gid;
         tl->tasks[i].username = username;
         tl->tasks[i].groupname = groupname;
+        tl->tasks[i].failCount = 0;
         tl->numTasks++;
         username = NULL;
         groupname = NULL;
@@ -576,6 +772,96 @@ CRINIT_LIB_EXPORTED void crinitClientFreeTaskList(crinitTaskList_t *tl) {
     free(tl);
 }
 
+CRINIT_LIB_EXPORTED int crinitClientGetDepGraph(crinitDepGraph_t **graph) {
+    if (graph == NULL) {
+        crinitErrPrint("Pointer arguments must not be NULL");
+        return -1;
+    }
+
+    crinitRtimCmd_t cmd, res;
+    if (crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_DEPGRAPH, 0) == -1) {
+        crinitErrPrint("Could not build RtimCmd to send to Crinit.");
+        return -1;
+    }
+
+    if (crinitClientXfer(&res, &cmd) == -1) {
+        crinitDestroyRtimCmd(&cmd);
+        crinitErrPrint("Could not complete data transfer from/to Crinit.");
+        return -1;
+    }
+    crinitDestroyRtimCmd(&cmd);
+
+    if (crinitResponseCheck(&res, CRINIT_RTIMCMD_R_DEPGRAPH) == -1) {
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+    if ((res.argc - 1) % CRINIT_DEPGRAPH_FIELDS != 0) {
+        crinitErrPrint("Got unexpected response length from Crinit.");
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+
+    *graph = malloc(sizeof(crinitDepGraph_t));
+    if (*graph == NULL) {
+        crinitErrPrint("Could not allocate memory for dependency graph.");
+        crinitDestroyRtimCmd(&res);
+        return -1;
+    }
+    crinitDepGraph_t *g = *graph;
+    g->numTasks = 0;
+    g->tasks = malloc((res.argc - 1) / CRINIT_DEPGRAPH_FIELDS * sizeof(*(g->tasks)));
+    if (g->tasks == NULL && res.argc > 1) {
+        crinitErrPrint("Could not allocate memory for dependency graph entries.");
+        goto fail;
+    }
+
+    for (size_t i = 1; i < res.argc; i += CRINIT_DEPGRAPH_FIELDS) {
+        crinitDepGraphEntry_t *e = &g->tasks[g->numTasks];
+        const char *name = NULL;
+        uint64_t fields[CRINIT_DEPGRAPH_FIELDS - 1];
+        if (crinitRtimArgGetStr(&res.args[i], &name) == -1) {
+            crinitErrPrint("Got unexpected task name in dependency graph from Crinit.");
+            goto fail;
+        }
+        for (size_t j = 0; j < CRINIT_DEPGRAPH_FIELDS - 1; j++) {
+            if (crinitRtimArgGetUInt(&res.args[i + 1 + j], &fields[j]) == -1) {
+                crinitErrPrint("Could not convert dependency graph field %zu of task \'%s\' to integer.", j, name);
+                goto fail;
+            }
+        }
+        e->level = fields[0];
+        e->critPath = fields[1];
+        e->prio = fields[2];
+        e->flags = fields[3];
+        e->name = strdup(name);
+        if (e->name == NULL) {
+            crinitErrPrint("Could not allocate memory for dependency graph entry name.");
+            goto fail;
+        }
+        g->numTasks++;
+    }
+
+    crinitDestroyRtimCmd(&res);
+    return 0;
+
+fail:
+    crinitClientFreeDepGraph(g);
+    *graph = NULL;
+    crinitDestroyRtimCmd(&res);
+    return -1;
+}
+
+CRINIT_LIB_EXPORTED void crinitClientFreeDepGraph(crinitDepGraph_t *graph) {
+    if (graph == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < graph->numTasks; i++) {
+        free(graph->tasks[i].name);
+    }
+    free(graph->tasks);
+    free(graph);
+}
+
 CRINIT_LIB_EXPORTED int crinitClientShutdown(crinitShutdownCmd_t sCmd) {
     crinitRtimCmd_t cmd, res;
     char sCmdStr[2] = {0};
@@ -585,7 +871,7 @@ CRINIT_LIB_EXPORTED int crinitClientShutdown(crinitShutdownCmd_t sCmd) {
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -609,7 +895,7 @@ CRINIT_LIB_EXPORTED int crinitClientGetVersion(crinitVersion_t *v) {
         return -1;
     }
 
-    if (crinitXfer(crinitSockFile, &res, &cmd) == -1) {
+    if (crinitClientXfer(&res, &cmd) == -1) {
         crinitDestroyRtimCmd(&cmd);
         crinitErrPrint("Could not complete data transfer from/to Crinit.");
         return -1;
@@ -624,34 +910,27 @@ CRINIT_LIB_EXPORTED int crinitClientGetVersion(crinitVersion_t *v) {
             return -1;
         }
 
-        char *endPtr = NULL;
-
-        v->major = (uint8_t)strtoul(res.args[1], &endPtr, 10);
-        if (endPtr == res.args[1]) {
-            crinitErrPrint("Could not convert major version number to integer.");
-            crinitDestroyRtimCmd(&res);
-            return -1;
-        }
-
-        v->minor = (uint8_t)strtoul(res.args[2], &endPtr, 10);
-        if (endPtr == res.args[2]) {
-            crinitErrPrint("Could not convert minor version number to integer.");
-            crinitDestroyRtimCmd(&res);
-            return -1;
-        }
-
-        v->micro = (uint8_t)strtoul(res.args[3], &endPtr, 10);
-        if (endPtr == res.args[3]) {
-            crinitErrPrint("Could not convert micro version number to integer.");
+        uint64_t major, minor, micro;
+        if (crinitRtimArgGetUInt(&res.args[1], &major) == -1 || crinitRtimArgGetUInt(&res.args[2], &minor) == -1 ||
+            crinitRtimArgGetUInt(&res.args[3], &micro) == -1) {
+            crinitErrPrint("Could not convert version number to integer.");
             crinitDestroyRtimCmd(&res);
             return -1;
         }
+        v->major = (uint8_t)major;
+        v->minor = (uint8_t)minor;
+        v->micro = (uint8_t)micro;
 
+        const char *git = NULL;
         if (res.argc < 5) {
             // We do not have a git hash in the version string.
             v->git[0] = '\0';
+        } else if (crinitRtimArgGetStr(&res.args[4], &git) == -1) {
+            crinitErrPrint("Got unexpected git hash from Crinit.");
+            crinitDestroyRtimCmd(&res);
+            return -1;
         } else {
-            strncpy(v->git, res.args[4], sizeof(v->git) - 1);
+            strncpy(v->git, git, sizeof(v->git) - 1);
             v->git[sizeof(v->git) - 1] = '\0';
         }
     }
@@ -660,6 +939,35 @@ CRINIT_LIB_EXPORTED int crinitClientGetVersion(crinitVersion_t *v) {
     return ret;
 }
 
+static int crinitClientXfer(crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
+    if (crinitBoundConn != NULL) {
+        return crinitConnXfer(crinitBoundConn, res, cmd);
+    }
+    return crinitXfer(crinitSockFile, res, cmd);
+}
+
+static int crinitReadyFdFromEnv(void) {
+    const char *envReadyFd = getenv(CRINIT_ENV_READY_FD);
+    if (envReadyFd == NULL) {
+        return -1;
+    }
+    char *end = NULL;
+    long fd = strtol(envReadyFd, &end, 10);
+    if (end == envReadyFd || *end != '\0' || fd < 0 || fd > INT_MAX) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat((int)fd, &st) == -1 || !S_ISFIFO(st.st_mode)) {
+        return -1;
+    }
+    int flags = fcntl((int)fd, F_GETFL);
+    if (flags == -1 || (flags & O_ACCMODE) != O_WRONLY || !(flags & O_DIRECT)) {
+        return -1;
+    }
+    return (int)fd;
+}
+
 static inline int crinitResponseCheck(const crinitRtimCmd_t *res, crinitRtimOp_t resCode) {
     if (res == NULL) {
         crinitErrPrint("Pointer arguments must not be NULL.");
@@ -675,14 +983,66 @@ static inline int crinitResponseCheck(const crinitRtimCmd_t *res, crinitRtimOp_t
         return -1;
     }
 
-    if (strcmp(res->args[0], CRINIT_RTIMCMD_RES_OK) == 0) {
+    if (res->args[0].type != CRINIT_RTIMARG_TYPE_STR) {
+        crinitErrPrint("Got unexpected response code type from Crinit: %d", (int)res->args[0].type);
+        return -1;
+    }
+    if (strcmp(res->args[0].str, CRINIT_RTIMCMD_RES_OK) == 0) {
         return 0;
     }
 
     crinitErrPrint("Crinit responded with an error message.");
-    if (res->argc >= 2) {
-        crinitErrPrint("Message from Crinit: \'%s\'", res->args[1]);
+    if (res->argc >= 2 && res->args[1].type == CRINIT_RTIMARG_TYPE_STR) {
+        crinitErrPrint("Message from Crinit: \'%s\'", res->args[1].str);
     }
 
     return -1;
 }
+
+static int crinitClientBuildStatusListCmd(crinitRtimCmd_t *cmd, const crinitTaskListFilter_t *filter) {
+    if (filter == NULL) {
+        return crinitBuildRtimCmd(cmd, CRINIT_RTIMCMD_C_STATUSLIST, 0);
+    }
+
+    // All filter arguments are formatted into a single buffer, crinitBuildRtimCmdArray() copies them.
+    size_t bufLen = sizeof(CRINIT_RTIMCMD_FILTER_STATE) + CRINIT_CLIENT_ULONG_BUF_SIZE;
+    if (filter->prefix != NULL) {
+        bufLen += sizeof(CRINIT_RTIMCMD_FILTER_PREFIX) + strlen(filter->prefix);
+    }
+    for (size_t i = 0; i < filter->numNames; i++) {
+        if (filter->names[i] == NULL) {
+            crinitErrPrint("Task names in filter must not be NULL.");
+            return -1;
+        }
+        bufLen += sizeof(CRINIT_RTIMCMD_FILTER_NAME) + strlen(filter->names[i]);
+    }
+
+    const char **args = malloc((filter->numNames + 2) * sizeof(*args));
+    char *buf = malloc(bufLen);
+    if (args == NULL || buf == NULL) {
+        crinitErrnoPrint("Could not allocate memory for STATUSLIST filter with %zu task names.", filter->numNames);
+        free(args);
+        free(buf);
+        return -1;
+    }
+
+    char *p = buf;
+    int argc = 0;
+    if (filter->stateMask != 0) {
+        args[argc++] = p;
+        p += snprintf(p, bufLen, "%s%lu", CRINIT_RTIMCMD_FILTER_STATE, filter->stateMask) + 1;
+    }
+    if (filter->prefix != NULL) {
+        args[argc++] = p;
+        p = stpcpy(stpcpy(p, CRINIT_RTIMCMD_FILTER_PREFIX), filter->prefix) + 1;
+    }
+    for (size_t i = 0; i < filter->numNames; i++) {
+        args[argc++] = p;
+        p = stpcpy(stpcpy(p, CRINIT_RTIMCMD_FILTER_NAME), filter->names[i]) + 1;
+    }
+
+    int ret = crinitBuildRtimCmdArray(cmd, CRINIT_RTIMCMD_C_STATUSLIST, argc, args);
+    free(args);
+    free(buf);
+    return ret;
+}
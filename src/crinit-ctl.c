@@ -35,12 +35,23 @@
  *            - Queries status bits, PID, and timestamps of <TASK_NAME>. The CTime, STime, and ETime fields
  *              represent the times the task was Created (loaded/parsed), last Started (became running), and
  *              last Ended (failed or is done). If the event has not occurred yet, the timestamp's value will
- *              be 'n/a'.
+ *              be 'n/a'. The Usage line sums up the processes of the task reaped so far: CPU time in user
+ *              and system mode, the largest maximum resident set size, voluntary/involuntary context switches,
+ *              the number of processes, and the Runtime of the last run.
  *     notify <TASK_NAME> <"SD_NOTIFY_STRING">
- *            - Will send an sd_notify-style status report to Crinit. Only MAINPID and READY are
- *              implemented. See the sd_notify documentation for their meaning.
- *       list
+ *            - Will send an sd_notify-style status report to Crinit. Only MAINPID, READY, STOPPING and
+ *              STATUS are implemented. See the sd_notify documentation for their meaning.
+ *       list [-s/--state <STATE>[,<STATE>...]] [-p/--prefix <PREFIX>] [TASK_NAME...]
  *            - Print the list of loaded tasks and their status.
+ *              '-s/--state' - Only list tasks in one of the given states (loaded, starting, running, done,
+ *                   failed, notified, backoff, cooldown).
+ *              '-p/--prefix' - Only list tasks whose name starts with <PREFIX>.
+ *              If TASK_NAMEs are given, only these tasks are listed.
+ *      graph
+ *            - Print the analysis of the dependency graph of all loaded tasks. LEVEL is the topological
+ *              level, CRITPATH the length of the critical path in microseconds and PRIO the resulting spawn
+ *              priority. FLAGS marks tasks in a dependency cycle, tasks blocked by a cycle, and tasks with
+ *              dependencies no loaded task can fulfill.
  *     reboot
  *            - Will request Crinit to perform a graceful system reboot. crinit-ctl can be symlinked to
  *              reboot as a shortcut which will invoke this command automatically.
@@ -88,6 +99,15 @@ static void crinitPrintVersion(void);
  * @return a string representing the given task status code.
  */
 static const char *crinitTaskStateToStr(crinitTaskState_t s);
+/**
+ * Convert a comma-separated list of task state names to a filter mask for crinitTaskListFilter_t::stateMask.
+ *
+ * @param mask  Return pointer for the mask.
+ * @param str   The list of state names.
+ *
+ * @return 0 on success, -1 if \a str contains an unknown state name
+ */
+static int crinitStrToTaskStateMask(crinitTaskState_t *mask, const char *str);
 
 int main(int argc, char *argv[]) {
     int getoptArgc = argc;
@@ -122,16 +142,20 @@ int main(int argc, char *argv[]) {
                                          {"ignore-deps", no_argument, 0, 'i'},
                                          {"override-deps", required_argument, 0, 'd'},
                                          {"overwrite", no_argument, 0, 'f'},
+                                         {"prefix", required_argument, 0, 'p'},
+                                         {"state", required_argument, 0, 's'},
                                          {"verbose", no_argument, 0, 'v'},
                                          {0, 0, 0, 0}};
     bool overwrite = false;
     bool ignoreDeps = false;
     const char *overDeps = NULL;
+    crinitTaskListFilter_t filter = {0};
+    bool useFilter = false;
 
     bool verbose = false;
 
     while (true) {
-        opt = getopt_long(getoptArgc, getoptArgv, "hd:fiv", longOptions, NULL);
+        opt = getopt_long(getoptArgc, getoptArgv, "hd:fip:s:v", longOptions, NULL);
         if (opt == -1) {
             break;
         }
@@ -145,6 +169,17 @@ int main(int argc, char *argv[]) {
             case 'f':
                 overwrite = true;
                 break;
+            case 'p':
+                filter.prefix = optarg;
+                useFilter = true;
+                break;
+            case 's':
+                if (crinitStrToTaskStateMask(&filter.stateMask, optarg) == -1) {
+                    crinitErrPrint("Unknown task state in \'%s\'.", optarg);
+                    return EXIT_FAILURE;
+                }
+                useFilter = true;
+                break;
             case 'v':
                 verbose = true;
                 break;
@@ -277,6 +312,16 @@ int main(int argc, char *argv[]) {
                         ctStr, stStr, etStr, username, uid, groupname, gid);
         free(username);
         free(groupname);
+
+        crinitTaskUsage_t u;
+        if (crinitClientTaskGetUsage(&u, getoptArgv[optind]) == -1) {
+            crinitErrPrint("Querying resource usage of task \'%s\' failed.", getoptArgv[optind]);
+            return EXIT_FAILURE;
+        }
+        crinitInfoPrint("Usage: UTime: %llu.%.6llus STime: %llu.%.6llus MaxRSS: %llukB CSW: %llu/%llu Procs: %llu "
+                        "Runtime: %llu.%.6llus",
+                        u.userTime / 1000000, u.userTime % 1000000, u.sysTime / 1000000, u.sysTime % 1000000, u.maxRss,
+                        u.volCtxSw, u.involCtxSw, u.numProcs, u.lastRuntime / 1000000, u.lastRuntime % 1000000);
         return EXIT_SUCCESS;
     }
     if (strcmp(getoptArgv[0], "notify") == 0) {
@@ -295,13 +340,14 @@ int main(int argc, char *argv[]) {
     if (strcmp(getoptArgv[0], "list") == 0) {
         const char *tableHeaderGroup = "GROUP";
         const char *tableHeaderUser = "USER";
-        if (getoptArgv[optind] != NULL) {
-            crinitPrintUsage(argv[0]);
-            return EXIT_FAILURE;
+        if (optind < getoptArgc) {
+            filter.names = (const char *const *)&getoptArgv[optind];
+            filter.numNames = getoptArgc - optind;
+            useFilter = true;
         }
         crinitTaskList_t *tl;
-        if (crinitClientGetTaskList(&tl) == -1) {
-            crinitErrPrint("Querying list of task \'%s\' failed.", getoptArgv[optind]);
+        if ((useFilter) ? crinitClientGetTaskStatusList(&tl, &filter) == -1 : crinitClientGetTaskList(&tl) == -1) {
+            crinitErrPrint("Querying list of tasks failed.");
             return EXIT_FAILURE;
         }
         int maxNameLen = 0;
@@ -339,6 +385,34 @@ int main(int argc, char *argv[]) {
         crinitClientFreeTaskList(tl);
         return EXIT_SUCCESS;
     }
+    if (strcmp(getoptArgv[0], "graph") == 0) {
+        if (getoptArgv[optind] != NULL) {
+            crinitPrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        crinitDepGraph_t *g;
+        if (crinitClientGetDepGraph(&g) == -1) {
+            crinitErrPrint("Querying dependency graph failed.");
+            return EXIT_FAILURE;
+        }
+        int maxNameLen = strlen("NAME");
+        for (size_t i = 0; i < g->numTasks; i++) {
+            int len = strlen(g->tasks[i].name);
+            if (len > maxNameLen) {
+                maxNameLen = len;
+            }
+        }
+        crinitInfoPrint("%-*s  %5s  %5s  %12s  %s", maxNameLen, "NAME", "LEVEL", "PRIO", "CRITPATH", "FLAGS");
+        for (size_t i = 0; i < g->numTasks; i++) {
+            const crinitDepGraphEntry_t *e = &g->tasks[i];
+            crinitInfoPrint("%-*s  %5lu  %5lu  %12llu  %s%s%s", maxNameLen, e->name, e->level, e->prio, e->critPath,
+                            (e->flags & CRINIT_DEPGRAPH_CYCLE) ? "cycle " : "",
+                            (e->flags & CRINIT_DEPGRAPH_BLOCKED) ? "blocked " : "",
+                            (e->flags & CRINIT_DEPGRAPH_DANGLING) ? "dangling" : "");
+        }
+        crinitClientFreeDepGraph(g);
+        return EXIT_SUCCESS;
+    }
     if (strcmp(basename(getoptArgv[0]), "poweroff") == 0) {
         if (crinitClientShutdown(CRINIT_SHD_POWEROFF) == -1) {
             crinitErrPrint("System poweroff request failed.");
@@ -407,13 +481,19 @@ static void crinitPrintUsage(char *prgmPath) {
         "             - Queries status bits, PID, and timestamps of <TASK_NAME>. The CTime, STime, and ETime fields\n"
         "               represent the times the task was Created (loaded/parsed), last Started (became running), and\n"
         "               last Ended (failed or is done). If the event has not occurred yet, the timestamp's value will\n"
-        "               be 'n/a'.\n"
+        "               be 'n/a'. The Usage line sums up the processes of the task reaped so far: CPU time in\n"
+        "               user and system mode, the largest maximum resident set size, voluntary/involuntary context\n"
+        "               switches, the number of processes, and the Runtime of the last run.\n"
         "               See \"list\" for a detailed description of different statuses.\n"
         "      notify <TASK_NAME> <\"SD_NOTIFY_STRING\">\n"
-        "             - Will send an sd_notify-style status report to Crinit. Only MAINPID and READY are\n"
-        "               implemented. See the sd_notify documentation for their meaning.\n"
-        "        list\n"
+        "             - Will send an sd_notify-style status report to Crinit. Only MAINPID, READY, STOPPING and\n"
+        "               STATUS are implemented. See the sd_notify documentation for their meaning.\n"
+        "        list [-s/--state <STATE>[,<STATE>...]] [-p/--prefix <PREFIX>] [TASK_NAME...]\n"
         "             - Print the list of loaded tasks and their status.\n"
+        "               \'-s/--state\' - Only list tasks in one of the given states (loaded, starting, running, done,\n"
+        "                    failed, notified, backoff, cooldown).\n"
+        "               \'-p/--prefix\' - Only list tasks whose name starts with <PREFIX>.\n"
+        "               If TASK_NAMEs are given, only these tasks are listed.\n"
         "               Following states can be reported:\n"
         "               - loaded: the task was loaded but never ran\n"
         "               - starting: the task currently spawns a new process\n"
@@ -422,7 +502,15 @@ static void crinitPrintUsage(char *prgmPath) {
         "               - failed: the task has finished with an error code\n"
         "               The states \"running\", \"done\" and \"failed\" can appear with the\n"
         "               postfix \"(notified)\", too. That means that the information was transmitted\n"
-        "               to crinit\n via the sd_notify API.\n"
+        "               to crinit\n via the sd_notify API.\n",
+        prgmPath);
+    fprintf(
+        stderr,
+        "       graph\n"
+        "             - Print the analysis of the dependency graph of all loaded tasks. LEVEL is the topological\n"
+        "               level, CRITPATH the length of the critical path in microseconds and PRIO the resulting spawn\n"
+        "               priority. FLAGS marks tasks in a dependency cycle, tasks blocked by a cycle, and tasks with\n"
+        "               dependencies no loaded task can fulfill.\n"
         "      reboot\n"
         "             - Will request Crinit to perform a graceful system reboot. crinit-ctl can be symlinked to\n"
         "               reboot as a shortcut which will invoke this command automatically.\n"
@@ -433,8 +521,7 @@ static void crinitPrintUsage(char *prgmPath) {
         "        --verbose/-v - Be verbose.\n"
         "        --help/-h    - Print this help.\n"
         "        --version/-V - Print version information about crinit-ctl, the crinit-client library,\n"
-        "                       and -- if connection is successful -- the crinit daemon.\n",
-        prgmPath);
+        "                       and -- if connection is successful -- the crinit daemon.\n");
 }
 
 static void crinitPrintVersion(void) {
@@ -453,7 +540,9 @@ static void crinitPrintVersion(void) {
 
 static const char *crinitTaskStateToStr(crinitTaskState_t s) {
     bool notified = s & CRINIT_TASK_STATE_NOTIFIED;
-    s &= ~CRINIT_TASK_STATE_NOTIFIED;
+    bool backoff = s & CRINIT_TASK_STATE_BACKOFF;
+    bool cooldown = s & CRINIT_TASK_STATE_COOLDOWN;
+    s &= ~(CRINIT_TASK_STATE_NOTIFIED | CRINIT_TASK_STATE_BACKOFF | CRINIT_TASK_STATE_COOLDOWN);
 
     switch (s) {
         case CRINIT_TASK_STATE_LOADED:
@@ -463,10 +552,50 @@ static const char *crinitTaskStateToStr(crinitTaskState_t s) {
         case CRINIT_TASK_STATE_RUNNING:
             return (notified) ? "running (notified)" : "running";
         case CRINIT_TASK_STATE_DONE:
+            if (backoff) {
+                return (notified) ? "done (notified, respawn backoff)" : "done (respawn backoff)";
+            }
+            if (cooldown) {
+                return (notified) ? "done (notified, respawn cooldown)" : "done (respawn cooldown)";
+            }
             return (notified) ? "done (notified)" : "done";
         case CRINIT_TASK_STATE_FAILED:
+            if (backoff) {
+                return (notified) ? "failed (notified, respawn backoff)" : "failed (respawn backoff)";
+            }
+            if (cooldown) {
+                return (notified) ? "failed (notified, respawn cooldown)" : "failed (respawn cooldown)";
+            }
             return (notified) ? "failed (notified)" : "failed";
         default:
             return "(invalid)";
     }
 }
+
+static int crinitStrToTaskStateMask(crinitTaskState_t *mask, const char *str) {
+    static const struct {
+        const char *name;
+        crinitTaskState_t bit;
+    } states[] = {
+        {"loaded", CRINIT_TASKLIST_FILTER_LOADED},    {"starting", CRINIT_TASK_STATE_STARTING},
+        {"running", CRINIT_TASK_STATE_RUNNING},       {"done", CRINIT_TASK_STATE_DONE},
+        {"failed", CRINIT_TASK_STATE_FAILED},         {"notified", CRINIT_TASK_STATE_NOTIFIED},
+        {"backoff", CRINIT_TASK_STATE_BACKOFF},       {"cooldown", CRINIT_TASK_STATE_COOLDOWN},
+    };
+
+    *mask = 0;
+    while (*str != '\0') {
+        size_t len = strcspn(str, ",");
+        size_t i = 0;
+        while (i < sizeof(states) / sizeof(states[0]) &&
+               (strncmp(states[i].name, str, len) != 0 || states[i].name[len] != '\0')) {
+            i++;
+        }
+        if (i == sizeof(states) / sizeof(states[0])) {
+            return -1;
+        }
+        *mask |= states[i].bit;
+        str += (str[len] == ',') ? len + 1 : len;
+    }
+    return (*mask != 0) ? 0 : -1;
+}
@@ -6,13 +6,21 @@
  * Program usage info:
  *
  * ~~~
- * USAGE: crinit-launch --cmd=/path/to/targetcmd [--user=UID --groups=GID[,SGID1,SGID2]] -- [TARGET_COMMAND_ARGUMENTS]
+ * USAGE: crinit-launch --cmd=/path/to/targetcmd [--user=UID --groups=GID[,SGID1,SGID2]] [SCHEDULING_OPTIONS] --
+ *        [TARGET_COMMAND_ARGUMENTS]
  * where ACTION must be exactly one of (including specific options/parameters):
  *    cmd Path to the program to launch.
  *   user UID of the user to be used to start the specified command. If not given, the user of the crinit process is
  * used. groups Comma separated list of GIDs that shall be used to start the specified command. The first one will be
  * used as the primary group, all others as suplimentary groups. If not given the group of the crinit process is used.
  *
+ * Scheduling Options (same values as the respective task configuration options):
+ *       --nice=<NICE>                  - Nice value, see NICE.
+ *       --sched-policy=<POLICY[:PRIO]> - Scheduling policy and priority, see SCHED_POLICY.
+ *       --cpu-affinity=<CPULIST>       - CPUs to run on, see CPU_AFFINITY.
+ *       --io-priority=<CLASS[:LEVEL]>  - I/O scheduling class and level, see IO_PRIORITY.
+ *       --oom-score-adj=<ADJ>          - OOM score adjustment, see OOM_SCORE_ADJ.
+ *
  * After the delimiter -- the arguments of the specifed command can be given, if there are any.
  * General Options:
  *       --help/-h    - Print this help.
@@ -33,6 +41,10 @@
 #endif
 #include "crinit-version.h"
 #include "logio.h"
+#include "schedparam.h"
+
+/** Value returned by getopt_long() for the first scheduling option, the others follow in crinitSchedParam_t order. **/
+#define CRINIT_LAUNCH_OPT_SCHED 0x100
 
 static void crinitPrintVersion(void) {
     fprintf(stderr, "Crinit version %s\n", crinitGetVersionString());
@@ -46,9 +58,9 @@ static void crinitPrintUsage(void) {
         "--cgroup=<cgroup> "
 #endif
 #ifdef ENABLE_CAPABILITIES
-        "--caps=bitmask -- "
+        "--caps=bitmask "
 #endif
-        "[TARGET_COMMAND_ARGUMENTS]\n"
+        "[SCHEDULING_OPTIONS] -- [TARGET_COMMAND_ARGUMENTS]\n"
         "  where ACTION must be exactly one of (including specific options/parameters):\n"
         "    cmd Path to the program to launch.\n"
         "    user UID of the user to be used to start the specified command. If not given, the user of the crinit "
@@ -67,6 +79,13 @@ static void crinitPrintUsage(void) {
         "       Bit positions correspond to capability values that are defined by the kernel in <linux/capability.h>.\n"
         "       E.g. setting capability CAP_SETGID which has a value 6) would require a bitmap with value 0x40.\n"
 #endif
+        "\n"
+        " Scheduling Options (same values as the respective task configuration options):\n"
+        "      --nice=<NICE>                  - Nice value, see NICE.\n"
+        "      --sched-policy=<POLICY[:PRIO]> - Scheduling policy and priority, see SCHED_POLICY.\n"
+        "      --cpu-affinity=<CPULIST>       - CPUs to run on, see CPU_AFFINITY.\n"
+        "      --io-priority=<CLASS[:LEVEL]>  - I/O scheduling class and level, see IO_PRIORITY.\n"
+        "      --oom-score-adj=<ADJ>          - OOM score adjustment, see OOM_SCORE_ADJ.\n"
         "\n"
         " After the delimiter -- the arguments of the specifed command can be given, if there are any.\n"
         " General Options:\n"
@@ -135,6 +154,16 @@ int main(int argc, char *argv[]) {
 #ifdef ENABLE_CGROUP
                                          {"cgroup", optional_argument, 0, 'r'},
 #endif
+                                         {CRINIT_SCHED_LAUNCHOPT_AFFINITY, required_argument, 0,
+                                          CRINIT_LAUNCH_OPT_SCHED + CRINIT_SCHED_PARAM_AFFINITY},
+                                         {CRINIT_SCHED_LAUNCHOPT_POLICY, required_argument, 0,
+                                          CRINIT_LAUNCH_OPT_SCHED + CRINIT_SCHED_PARAM_POLICY},
+                                         {CRINIT_SCHED_LAUNCHOPT_NICE, required_argument, 0,
+                                          CRINIT_LAUNCH_OPT_SCHED + CRINIT_SCHED_PARAM_NICE},
+                                         {CRINIT_SCHED_LAUNCHOPT_IOPRIO, required_argument, 0,
+                                          CRINIT_LAUNCH_OPT_SCHED + CRINIT_SCHED_PARAM_IOPRIO},
+                                         {CRINIT_SCHED_LAUNCHOPT_OOM_SCORE_ADJ, required_argument, 0,
+                                          CRINIT_LAUNCH_OPT_SCHED + CRINIT_SCHED_PARAM_OOM_SCORE_ADJ},
                                          {0, 0, 0, 0}};
 
 #ifdef ENABLE_CAPABILITIES
@@ -143,6 +172,7 @@ int main(int argc, char *argv[]) {
 #ifdef ENABLE_CGROUP
     char *targetCgroup = NULL;
 #endif
+    crinitSchedParams_t sched = {0};
     gid_t *groups = NULL;
     size_t groupSize = 0;
     uid_t user = -1;
@@ -224,7 +254,17 @@ int main(int argc, char *argv[]) {
                 return EXIT_SUCCESS;
             case 'h':
             case '?':
+                crinitPrintUsage();
+                goto failureExit;
             default:
+                if (opt >= CRINIT_LAUNCH_OPT_SCHED && opt < CRINIT_LAUNCH_OPT_SCHED + CRINIT_SCHED_PARAMS_COUNT) {
+                    if (crinitSchedParamsParse(&sched, opt - CRINIT_LAUNCH_OPT_SCHED, optarg) == -1) {
+                        crinitErrPrint("Malformed input for %s parameter: %s.\n",
+                                       crinitSchedParamName(opt - CRINIT_LAUNCH_OPT_SCHED), optarg);
+                        goto failureExit;
+                    }
+                    break;
+                }
                 crinitPrintUsage();
                 goto failureExit;
         }
@@ -287,6 +327,12 @@ int main(int argc, char *argv[]) {
     }
 #endif
 
+    crinitSchedParam_t failedParam;
+    if (crinitSchedParamsApply(&sched, &failedParam) == -1) {
+        crinitErrnoPrint("Failed to set %s.\n", crinitSchedParamName(failedParam));
+        goto failureExit;
+    }
+
     if (groupSize) {
         if (setgroups(0, NULL) != 0) {  // Drop all current supplementary groups
             crinitErrPrint("Failed to drop all initial supplementary groups.\n");
@@ -20,6 +20,7 @@
 #include "optfeat.h"
 #include "procdip.h"
 #include "rtimopmap.h"
+#include "taskgraph.h"
 #include "timerdb.h"
 
 #ifdef SIGNATURE_SUPPORT
@@ -214,6 +215,14 @@ int main(int argc, char *argv[]) {
     crinitTaskDBInit(&tdb, crinitProcDispatchSpawnFunc);
     crinitTimerDBInit(&tdb);
 
+    // Collect all tasks first so they can be moved into the TaskDB in one go.
+    crinitTask_t **tasks = calloc(taskSeries.size, sizeof(*tasks));
+    if (tasks == NULL && taskSeries.size > 0) {
+        crinitErrnoPrint("Could not allocate memory for %zu tasks.", taskSeries.size);
+        crinitDestroyFileSeries(&taskSeries);
+        goto failFreeTaskDB;
+    }
+    size_t numTasks = 0;
     for (size_t n = 0; n < taskSeries.size; n++) {
         char *confFn = taskSeries.fnames[n];
         bool confFnAllocated = false;
@@ -224,7 +233,7 @@ int main(int argc, char *argv[]) {
             if (confFn == NULL) {
                 crinitErrnoPrint("Could not allocate string with full path for \'%s\'.", taskSeries.fnames[n]);
                 crinitDestroyFileSeries(&taskSeries);
-                goto failFreeTaskDB;
+                goto failFreeTasks;
             }
             memcpy(confFn, taskSeries.baseDir, prefixLen);
             confFn[prefixLen] = '/';
@@ -238,7 +247,7 @@ int main(int argc, char *argv[]) {
                 free(confFn);
             }
             crinitDestroyFileSeries(&taskSeries);
-            goto failFreeTaskDB;
+            goto failFreeTasks;
         }
         crinitInfoPrint("File \'%s\' loaded.", confFn);
         if (confFnAllocated) {
@@ -251,23 +260,28 @@ int main(int argc, char *argv[]) {
             crinitErrPrint("Could not extract task from ConfKvList.");
             crinitFreeConfList(c);
             crinitDestroyFileSeries(&taskSeries);
-            goto failFreeTaskDB;
+            goto failFreeTasks;
         }
         crinitFreeConfList(c);
 
         crinitDbgInfoPrint("Task extracted without error.");
         crinitTaskPrint(t);
-
-        if (crinitTaskDBInsert(&tdb, t, false) == -1) {
-            crinitErrPrint("Could not insert Task '%s' into TaskDB.", t->name);
-            crinitDestroyFileSeries(&taskSeries);
-            crinitFreeTask(t);
-            goto failFreeTaskDB;
-        }
-        crinitFreeTask(t);
+        tasks[numTasks++] = t;
     }
     crinitDestroyFileSeries(&taskSeries);
+
+    if (crinitTaskDBInsertBatch(&tdb, tasks, numTasks, false) == -1) {
+        crinitErrPrint("Could not insert Tasks into TaskDB.");
+        goto failFreeTasks;
+    }
+    for (size_t n = 0; n < numTasks; n++) {
+        crinitFreeTask(tasks[n]);
+    }
+    free(tasks);
     crinitDbgInfoPrint("Done parsing.");
+    if (crinitTaskGraphUpdate(&tdb) == -1) {
+        crinitErrPrint("Could not analyze task dependencies. Tasks will be started in the order they were loaded.");
+    }
     if (crinitTimerDBSpawn()) {
         crinitErrPrint("Could not start timer pool.");
         goto failFreeTaskDB;
@@ -283,11 +297,16 @@ int main(int argc, char *argv[]) {
     }
 
     while (true) {
-        crinitTaskDBSpawnReady(&tdb, CRINIT_DISPATCH_THREAD_MODE_START);
-        pthread_mutex_lock(&tdb.lock);
+        if (crinitTaskDBSpawnReady(&tdb, CRINIT_DISPATCH_THREAD_MODE_START) == -1) {
+            // The failed task is still queued, so retry only after something else has changed, e.g. a dispatch worker
+            // has taken a task from the full dispatch queue.
+            if (crinitTaskDBWaitSpawnRetry(&tdb) == -1) {
+                crinitErrPrint("Could not wait for the TaskDB to change.");
+            }
+            continue;
+        }
         crinitDbgInfoPrint("Waiting for Task to be ready.");
-        pthread_cond_wait(&tdb.changed, &tdb.lock);
-        pthread_mutex_unlock(&tdb.lock);
+        crinitTaskDBWaitReady(&tdb);
     }
     crinitTaskDBDestroy(&tdb);
     crinitGlobOptDestroy();
@@ -298,6 +317,11 @@ int main(int argc, char *argv[]) {
 #endif
     return EXIT_SUCCESS;
 
+failFreeTasks:
+    for (size_t n = 0; n < numTasks; n++) {
+        crinitFreeTask(tasks[n]);
+    }
+    free(tasks);
 failFreeTaskDB:
     crinitTaskDBDestroy(&tdb);
 failFreeSigs:
@@ -376,4 +400,5 @@ static void crinitTaskPrint(const crinitTask_t *t) {
     crinitDbgInfoPrint("    CRINIT_TASK_OPT_RESPAWN = %s", (t->opts & CRINIT_TASK_OPT_RESPAWN) ? "true" : "false");
     crinitDbgInfoPrint("    CRINIT_TASK_OPT_TRIGGER_REARM = %s",
                        (t->opts & CRINIT_TASK_OPT_TRIGGER_REARM) ? "true" : "false");
+    crinitDbgInfoPrint("    CRINIT_TASK_OPT_READY_FD = %s", (t->opts & CRINIT_TASK_OPT_READY_FD) ? "true" : "false");
 }
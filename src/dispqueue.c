@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file dispqueue.c
+ * @brief Implementation of the bounded FIFO queue between the Process Dispatcher and its worker threads.
+ */
+#include "dispqueue.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "logio.h"
+
+int crinitDispatchQueueInit(crinitDispatchQueue_t *q, size_t size) {
+    crinitNullCheck(-1, q);
+
+    if (size < 1) {
+        crinitErrPrint("Dispatch queue must be able to hold at least one job.");
+        errno = EINVAL;
+        return -1;
+    }
+    q->jobs = calloc(size, sizeof(*q->jobs));
+    if (q->jobs == NULL) {
+        crinitErrnoPrint("Could not allocate dispatch queue of depth %zu.", size);
+        return -1;
+    }
+    if ((errno = pthread_mutex_init(&q->lock, NULL)) != 0) {
+        crinitErrnoPrint("Could not initialize dispatch queue mutex.");
+        free(q->jobs);
+        return -1;
+    }
+    if ((errno = pthread_cond_init(&q->jobAvail, NULL)) != 0) {
+        crinitErrnoPrint("Could not initialize dispatch queue condition variable.");
+        pthread_mutex_destroy(&q->lock);
+        free(q->jobs);
+        return -1;
+    }
+    q->size = size;
+    q->head = 0;
+    q->items = 0;
+    return 0;
+}
+
+void crinitDispatchQueueDestroy(crinitDispatchQueue_t *q) {
+    if (q == NULL) {
+        return;
+    }
+    pthread_cond_destroy(&q->jobAvail);
+    pthread_mutex_destroy(&q->lock);
+    free(q->jobs);
+    q->jobs = NULL;
+    q->size = 0;
+    q->items = 0;
+}
+
+int crinitDispatchQueuePush(crinitDispatchQueue_t *q, void *job) {
+    crinitNullCheck(-1, q);
+
+    if ((errno = pthread_mutex_lock(&q->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock on dispatch queue.");
+        return -1;
+    }
+    if (q->items == q->size) {
+        pthread_mutex_unlock(&q->lock);
+        errno = EAGAIN;
+        return -1;
+    }
+    q->jobs[(q->head + q->items) % q->size] = job;
+    q->items++;
+    pthread_cond_signal(&q->jobAvail);
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+void *crinitDispatchQueuePop(crinitDispatchQueue_t *q, bool *wasFull) {
+    pthread_mutex_lock(&q->lock);
+    while (q->items == 0) {
+        pthread_cond_wait(&q->jobAvail, &q->lock);
+    }
+    if (wasFull != NULL) {
+        *wasFull = q->items == q->size;
+    }
+    void *job = q->jobs[q->head];
+    q->head = (q->head + 1) % q->size;
+    q->items--;
+    pthread_mutex_unlock(&q->lock);
+    return job;
+}
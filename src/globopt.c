@@ -6,6 +6,7 @@
 #include "globopt.h"
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 
 #include "common.h"
@@ -36,6 +37,8 @@
 static crinitGlobOptStore_t crinitGlobOpts;
 /** Mutex to synchronize access to globOptArr **/
 static pthread_mutex_t crinitOptLock = PTHREAD_MUTEX_INITIALIZER;
+/** Number of changes to the global option storage, see crinitGlobOptGetGeneration(). **/
+static atomic_ullong crinitGlobOptGen = 0;
 
 int crinitGlobOptInitDefault(void) {
     crinitGlobOptCommonLock();
@@ -46,6 +49,8 @@ int crinitGlobOptInitDefault(void) {
     crinitGlobOpts.elosEventPollInterval = CRINIT_CONFIG_DEFAULT_ELOS_EVENT_POLLING_TIME;
     crinitGlobOpts.elosPort = CRINIT_CONFIG_DEFAULT_ELOS_PORT;
     crinitGlobOpts.shdGraceP = CRINIT_CONFIG_DEFAULT_SHDGRACEP;
+    crinitGlobOpts.dispWorkers = CRINIT_CONFIG_DEFAULT_DISPATCH_WORKERS;
+    crinitGlobOpts.dispQueueDepth = CRINIT_CONFIG_DEFAULT_DISPATCH_QUEUE_DEPTH;
     crinitGlobOpts.taskDirFollowSl = CRINIT_CONFIG_DEFAULT_TASKDIR_SYMLINKS;
     crinitGlobOpts.signatures = CRINIT_CONFIG_DEFAULT_SIGNATURES;
 #ifdef ENABLE_CAPABILITIES
@@ -138,6 +143,7 @@ int crinitGlobOptSetString(size_t memberOffset, const char *val) {
         return -1;
     }
 
+    atomic_fetch_add(&crinitGlobOptGen, 1);
     crinitGlobOptCommonUnlock();
     return 0;
 }
@@ -170,6 +176,7 @@ int crinitGlobOptSetBoolean(size_t memberOffset, bool val) {
 
     crinitGlobOptCommonLock();
     *tgt = val;
+    atomic_fetch_add(&crinitGlobOptGen, 1);
     crinitGlobOptCommonUnlock();
 
     return 0;
@@ -192,6 +199,7 @@ int crinitGlobOptSetInteger(size_t memberOffset, int val) {
 
     crinitGlobOptCommonLock();
     *tgt = val;
+    atomic_fetch_add(&crinitGlobOptGen, 1);
     crinitGlobOptCommonUnlock();
 
     return 0;
@@ -214,6 +222,7 @@ int crinitGlobOptSetUnsignedLL(size_t memberOffset, unsigned long long val) {
 
     crinitGlobOptCommonLock();
     *tgt = val;
+    atomic_fetch_add(&crinitGlobOptGen, 1);
     crinitGlobOptCommonUnlock();
 
     return 0;
@@ -248,6 +257,7 @@ int crinitGlobOptSetEnvSet(size_t memberOffset, const crinitEnvSet_t *val) {
         return -1;
     }
 
+    atomic_fetch_add(&crinitGlobOptGen, 1);
     crinitGlobOptCommonUnlock();
     return 0;
 }
@@ -320,5 +330,10 @@ void crinitGlobOptDestroy(void) {
 #endif
     crinitEnvSetDestroy(&crinitGlobOpts.globEnv);
     crinitEnvSetDestroy(&crinitGlobOpts.globFilters);
+    atomic_fetch_add(&crinitGlobOptGen, 1);
     pthread_mutex_unlock(&crinitOptLock);
 }
+
+unsigned long long crinitGlobOptGetGeneration(void) {
+    return atomic_load(&crinitGlobOptGen);
+}
@@ -9,8 +9,10 @@
 #include <libgen.h>
 #include <linux/capability.h>
 #include <signal.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/syscall.h>
@@ -20,8 +22,10 @@
 #ifdef ENABLE_ELOS
 #include "eloslog.h"
 #endif
+#include "common.h"
 #include "logio.h"
 #include "rtimcmd.h"
+#include "sockmsg.h"
 #include "thrpool.h"
 
 #ifndef SYS_gettid
@@ -34,36 +38,169 @@
 /** Maximum number of unserviced connections until the server starts refusing **/
 #define MAX_CONN_BACKLOG 100
 
-/** Helper structure defining the arguments to connThread() **/
-typedef struct crinitConnThrArgs {
-    int sockFd;                 ///< The socket to accept connections from.
-    crinitThreadPool_t *tpRef;  ///< Pointer to the crinitThreadPool_t context, needed for
-                                ///< crinitThreadPoolThreadAvailCallback() and crinitThreadPoolThreadBusyCallback().
-} crinitConnThrArgs_t;
+/** Number of threads running the event loop of the server, see crinitServThread(). **/
+#define CRINIT_NOTISERV_EVENT_THREADS 2
+/** Number of threads executing commands which may block, see crinitRtimOpIsBlocking(). **/
+#define CRINIT_NOTISERV_CMD_WORKERS 2
+/** Maximum number of events fetched by a single call to epoll_wait(). **/
+#define CRINIT_NOTISERV_MAX_EVENTS 32
+/** Maximum number of requests answered on a connection before other connections get their turn. **/
+#define CRINIT_NOTISERV_MAX_REQS_PER_EVENT 16
 
-static crinitThreadPool_t crinitWorkers;  ///< The worker thread pool to run connThread() in.
-static crinitTaskDB_t *crinitTdbRef;      ///< Pointer to the crinitTaskDB_t to operate on.
+/** States of a client connection. **/
+typedef enum crinitConnState {
+    CRINIT_CONN_STATE_SEND_RTR,   ///< Sending the ready-to-receive message.
+    CRINIT_CONN_STATE_RECV_LEN,   ///< Waiting for the length packet or, using version 2, the message of the request.
+    CRINIT_CONN_STATE_RECV_DATA,  ///< Waiting for the string packet of the request, only used by version 1.
+    CRINIT_CONN_STATE_EXEC,       ///< Queued for or being executed by a command worker.
+    CRINIT_CONN_STATE_SEND_RES,   ///< Sending the response, afterwards the next request is received.
+} crinitConnState_t;
 
 /**
- * The worker thread function for handling a connection to a client.
+ * A client connection and the state of its request.
  *
- * Will accept connections in a loop, send RTR, handle incoming requests, and send responses. Automatically gets
- * informed of client PID, UID, and GID through `SO_PASSCRED`/`SCM_CREDENTIALS`, so that permission handling is
- * possible.
+ * A connection is registered with `EPOLLONESHOT`, so that it is only ever handled by a single thread at a time. Only
+ * that thread may access it until it re-arms the connection or hands it to a command worker.
  *
- * Uses crinitThreadPoolThreadAvailCallback() and crinitThreadPoolThreadBusyCallback() to signal its status to the
- * thread pool.
+ * The ready-to-receive message is only sent once. Afterwards, a client may send any number of requests over the same
+ * connection. They are answered one after the other, in the order they were received, until the client closes the
+ * connection.
+ *
+ * The protocol version is detected from the first request, see sockmsg.h. A client using version 2 does not wait for
+ * the ready-to-receive message, so it is not sent if the request has already arrived when the connection is accepted.
+ */
+typedef struct crinitConn {
+    int sockFd;               ///< The connected socket.
+    bool registered;          ///< If the socket has been added to the epoll instance.
+    crinitConnState_t state;  ///< The current state of the connection.
+    int version;              ///< The protocol version used by the client, 0 until the first request has arrived.
+    size_t dataLen;           ///< Length of the request in crinitConn_t::data.
+    char *data;               ///< Receive buffer for the request, NULL if not allocated.
+    struct ucred creds;       ///< Credentials of the client, passed with the length packet or taken on connection.
+    crinitRtimCmd_t cmd;      ///< The request, valid in #CRINIT_CONN_STATE_EXEC.
+    const char *out;          ///< The string or, using version 2, the binary message currently being sent.
+    char *outBuf;             ///< Backing buffer of crinitConn_t::out if it has been allocated, NULL otherwise.
+    size_t outLen;            ///< Length of crinitConn_t::out including the terminating zero of a string.
+    bool outLenSent;          ///< If the length packet of crinitConn_t::out has been sent.
+    struct crinitConn *next;  ///< Next connection in #crinitCmdQueue.
+} crinitConn_t;
+
+/** Queue of connections whose command is executed by a command worker, see crinitCmdWorker(). **/
+typedef struct crinitCmdQueue {
+    crinitConn_t *head;        ///< Oldest queued connection.
+    crinitConn_t *tail;        ///< Newest queued connection.
+    pthread_mutex_t lock;      ///< Mutex protecting the queue.
+    pthread_cond_t connAvail;  ///< Condition variable signalled if a connection has been queued.
+} crinitCmdQueue_t;
+
+/** Helper structure defining the arguments to crinitServThread() **/
+typedef struct crinitServThrArgs {
+    int epfd;  ///< The epoll instance to wait on.
+} crinitServThrArgs_t;
+
+/** Helper structure defining the arguments to crinitCmdWorker() **/
+typedef struct crinitCmdWorkerArgs {
+    crinitCmdQueue_t *queue;  ///< The queue to take connections from.
+} crinitCmdWorkerArgs_t;
+
+static crinitThreadPool_t crinitServThreads;  ///< The thread pool to run crinitServThread() in.
+static crinitThreadPool_t crinitCmdWorkers;   ///< The thread pool to run crinitCmdWorker() in.
+static crinitTaskDB_t *crinitTdbRef;          ///< Pointer to the crinitTaskDB_t to operate on.
+static int crinitServEpfd = -1;               ///< The epoll instance watching the server and all connections.
+static int crinitServSockFd = -1;             ///< The listening server socket.
+/** Set if accepting connections has been paused because the process has run out of file descriptors. **/
+static atomic_bool crinitServAcceptPaused = false;
+/** The queue of connections for the command workers. **/
+static crinitCmdQueue_t crinitCmdQueue = {NULL, NULL, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER};
+
+/**
+ * The event loop thread function of the server.
+ *
+ * All threads share the same epoll instance. Accepts new connections from the listening socket and advances client
+ * connections as far as possible without blocking using crinitConnProcess(). Commands which may block are handed to
+ * the command workers, so that a slow request does not hold up other clients.
  *
  * The client-side equivalent connection-handling function is crinitXfer() in crinit-client.c. The following image
  * illustrates the high level client/server protocol.
  *
  * \image html notiserv_sock_comm_seq.svg
  *
- * @param args  Arguments to the function, see crinitConnThrArgs_t.
+ * @param args  Arguments to the function, see crinitServThrArgs_t.
+ *
+ * @return  Does not return unless its thread is canceled in which case the return value is undefined.
+ */
+static void *crinitServThread(void *args);
+/**
+ * The thread function of a command worker.
+ *
+ * Takes connections from the queue, executes their command and continues with crinitConnProcess().
+ *
+ * @param args  Arguments to the function, see crinitCmdWorkerArgs_t.
  *
  * @return  Does not return unless its thread is canceled in which case the return value is undefined.
  */
-static void *crinitConnThread(void *args);
+static void *crinitCmdWorker(void *args);
+/**
+ * Accept all pending connections on the listening socket and re-arm it.
+ *
+ * If the process has run out of file descriptors, the listening socket is not re-armed until a connection has been
+ * closed, see #crinitServAcceptPaused.
+ *
+ * @param threadId  Thread ID of the caller for log messages.
+ */
+static void crinitServAccept(pid_t threadId);
+/**
+ * Advance a connection and re-arm it in the epoll instance, or close it once it is finished or has failed.
+ *
+ * @param c  The connection, owned by the calling thread.
+ */
+static void crinitConnProcess(crinitConn_t *c);
+/**
+ * Run the state machine of a connection until it would block.
+ *
+ * Automatically gets informed of client PID, UID, and GID through `SO_PASSCRED`/`SCM_CREDENTIALS` or, using version 2
+ * of the protocol, `SO_PEERCRED`, so that permission handling is possible.
+ *
+ * @param c  The connection, owned by the calling thread.
+ *
+ * @return  The epoll events to wait for, 0 if the connection has been handed to a command worker, or -1 if it is
+ *          finished or has failed and should be closed
+ */
+static int crinitConnHandle(crinitConn_t *c);
+/**
+ * Check permission for, and execute the received request or queue it for a command worker.
+ *
+ * @param c  The connection, crinitConn_t::data must hold the request.
+ *
+ * @return  0 on success, 1 if the connection has been handed to a command worker and must not be accessed anymore, -1
+ *          on error
+ */
+static int crinitConnDispatch(crinitConn_t *c);
+/**
+ * Set the response of a connection and move it to #CRINIT_CONN_STATE_SEND_RES.
+ *
+ * @param c    The connection.
+ * @param res  The response, will be destroyed.
+ *
+ * @return  0 on success, -1 on error
+ */
+static int crinitConnSetResponse(crinitConn_t *c, crinitRtimCmd_t *res);
+/**
+ * Close a connection and free its memory.
+ *
+ * Resumes accepting connections if it has been paused.
+ *
+ * @param c  The connection to close.
+ */
+static void crinitConnClose(crinitConn_t *c);
+/**
+ * Checks if executing a command may block for a longer time, e.g. because it reads files.
+ *
+ * @param op  The opcode of the command.
+ *
+ * @return  true if the command should be handed to a command worker, false if it can run in the event loop
+ */
+static inline bool crinitRtimOpIsBlocking(crinitRtimOp_t op);
 /**
  * Create AF_UNIX socket file, bind() and listen().
  *
@@ -98,44 +235,83 @@ static inline bool crinitCmsgHdrCheck(const struct cmsghdr *cmh);
  */
 static inline bool crinitUcredCheckEqual(const struct ucred *a, const struct ucred *b);
 /**
- * Sends a string to a connected client.
+ * Continues sending crinitConn_t::out to a connected client.
  *
  * The low level protocol is to first send a size_t informing the client of the length of the following string
  * (including the terminating zero) and then the string itself. The complementary client-side function is
- * crinitSend().
+ * crinitSend(). Using version 2, the binary encoded response is sent as a single message behind a crinitSockMsgHdr_t.
  *
  * The following image illustrates the low level send/receive protocol:
  * \image html sock_comm_str.svg
  *
- * @param sockFd  The socket file descriptor connected to the client.
- * @param str     The string to send.
+ * @param c  The connection.
  *
- * @return 0 on success, -1 otherwise
+ * @return 0 if the string has been sent completely, 1 if the socket is not writable, -1 on error
  */
-static inline int crinitSendStr(int sockFd, const char *str);
+static inline int crinitSendStr(crinitConn_t *c);
 /**
- * Receives a string from a connected client.
+ * Continues receiving a string from a connected client into crinitConn_t::data.
  *
  * The low level protocol is to first wait for a size_t informing the server of the length of the following string
  * (including the terminating zero) and then the string itself. The complementary client-side function is
  * crinitRecv().
  *
- * This function will also extract the message metadata received via `SO_PASSCRED` and return the credentials of the
- * sender via \a passedCreds.
- *
- * This function will allocate memory for the received string using malloc(). The string should be free()'d when no
- * longer needed.
+ * This function will also extract the message metadata received via `SO_PASSCRED` and store the credentials of the
+ * sender in crinitConn_t::creds.
  *
  * The following image illustrates the low level send/receive protocol:
  * \image html sock_comm_str.svg
  *
- * @param sockFd       The socket file descriptor connected to the client.
- * @param str          Return pointer for the received string.
- * @param passedCreds  Return pointer for SCM_CREDENTIALS metadata.
+ * @param c  The connection.
+ *
+ * @return 0 if the string has been received completely, 1 if there is no data to receive, 2 if the client has closed
+ *         the connection, -1 on error
+ */
+static inline int crinitRecvStr(crinitConn_t *c);
+/**
+ * Continues receiving a version 2 message from a connected client into crinitConn_t::data.
+ *
+ * The size of the message is peeked first, so that the receive buffer can be allocated accordingly. The binary
+ * encoded request following the crinitSockMsgHdr_t is moved to the start of the buffer, see crinitParseRtimCmdBin().
+ * The complementary client-side function is crinitSend().
+ *
+ * @param c  The connection.
  *
- * @return 0 on success, -1 otherwise
+ * @return 0 if the message has been received completely, 1 if there is no data to receive, 2 if the client has closed
+ *         the connection, -1 on error
  */
-static inline int crinitRecvStr(int sockFd, char **str, struct ucred *passedCreds);
+static inline int crinitRecvMsg(crinitConn_t *c);
+/**
+ * Detect the protocol version of a connection from the size of the first message sent by the client.
+ *
+ * A version 1 length packet has the size of a size_t, while a version 2 message is always larger. For version 2, the
+ * credentials of the client are taken once using `SO_PEERCRED` and `SO_PASSCRED` is disabled.
+ *
+ * @param c  The connection, crinitConn_t::version will be set.
+ *
+ * @return 0 if the version has been detected, 1 if there is no data to receive, 2 if the client has closed the
+ *         connection, -1 on error
+ */
+static inline int crinitConnDetectVersion(crinitConn_t *c);
+/**
+ * Takes the credentials of the client of a connection using `SO_PEERCRED`.
+ *
+ * @param c  The connection, crinitConn_t::creds will be set.
+ *
+ * @return 0 on success, -1 on error
+ */
+static inline int crinitConnPeerCreds(crinitConn_t *c);
+/**
+ * Receives a single packet including `SCM_CREDENTIALS` ancillary data.
+ *
+ * @param sockFd  The socket file descriptor connected to the client.
+ * @param buf     The buffer to receive to.
+ * @param len     The expected length of the packet.
+ * @param creds   Return pointer for the credentials.
+ *
+ * @return 0 on success, 1 if there is no data to receive, 2 if the client has closed the connection, -1 on error
+ */
+static inline int crinitRecvPacket(int sockFd, void *buf, size_t len, struct ucred *creds);
 /**
  * Checks if given process credentials imply permission to execute remote command.
  *
@@ -196,8 +372,28 @@ int crinitStartInterfaceServer(crinitTaskDB_t *ctx, const char *sockFile) {
         return -1;
     }
     umask(0022);
-    crinitConnThrArgs_t a = {sockFd, &crinitWorkers};
-    if (crinitThreadPoolInit(&crinitWorkers, 0, crinitConnThread, &a, sizeof(crinitConnThrArgs_t)) == -1) {
+    crinitServSockFd = sockFd;
+
+    crinitServEpfd = epoll_create1(EPOLL_CLOEXEC);
+    if (crinitServEpfd == -1) {
+        crinitErrnoPrint("Could not create epoll instance for the server.");
+        return -1;
+    }
+    struct epoll_event ev = {.events = EPOLLIN | EPOLLONESHOT, .data.ptr = NULL};
+    if (epoll_ctl(crinitServEpfd, EPOLL_CTL_ADD, sockFd, &ev) == -1) {
+        crinitErrnoPrint("Could not add server socket to epoll instance.");
+        return -1;
+    }
+
+    // Neither pool uses the busy/available callbacks, so their size stays fixed regardless of the number of clients.
+    crinitCmdWorkerArgs_t wa = {&crinitCmdQueue};
+    if (crinitThreadPoolInit(&crinitCmdWorkers, CRINIT_NOTISERV_CMD_WORKERS, crinitCmdWorker, &wa, sizeof(wa)) == -1) {
+        crinitErrPrint("Could not fill server command worker thread pool.");
+        return -1;
+    }
+    crinitServThrArgs_t a = {crinitServEpfd};
+    if (crinitThreadPoolInit(&crinitServThreads, CRINIT_NOTISERV_EVENT_THREADS, crinitServThread, &a, sizeof(a)) ==
+        -1) {
         crinitErrPrint("Could not fill server thread pool.");
         return -1;
     }
@@ -250,101 +446,308 @@ static inline bool crinitCmsgHdrCheck(const struct cmsghdr *cmh) {
     return true;
 }
 
-static void *crinitConnThread(void *args) {
+static void *crinitServThread(void *args) {
+    crinitServThrArgs_t *a = args;
     pid_t threadId = crinitGettid();
-    if (args == NULL) {
-        crinitErrPrint("(TID %d) Argument to connection worker thread must not be NULL.", threadId);
-        return NULL;
-    }
-    crinitConnThrArgs_t *a = (crinitConnThrArgs_t *)args;
-    int servSockFd = a->sockFd;
-    int connSockFd;
-    crinitDbgInfoPrint("(TID %d) Connection worker thread ready.", threadId);
-    while (true) {
-        connSockFd = -1;
-        connSockFd = accept(servSockFd, NULL, NULL);
-        crinitThreadPoolThreadBusyCallback(a->tpRef);
+    struct epoll_event events[CRINIT_NOTISERV_MAX_EVENTS];
 
-        if (connSockFd == -1) {
-            crinitErrnoPrint("(TID %d) Could not accept connection.", threadId);
+    crinitDbgInfoPrint("(TID %d) Server thread ready.", threadId);
+    while (true) {
+        int n = epoll_wait(a->epfd, events, CRINIT_NOTISERV_MAX_EVENTS, -1);
+        if (n == -1) {
+            if (errno != EINTR) {
+                crinitErrnoPrint("(TID %d) Could not wait for events on server epoll instance.", threadId);
+            }
             continue;
         }
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.ptr == NULL) {
+                crinitServAccept(threadId);
+            } else {
+                crinitConnProcess(events[i].data.ptr);
+            }
+        }
+    }
+    return NULL;
+}
 
-        int optVal = 1;
-        if (setsockopt(connSockFd, SOL_SOCKET, SO_PASSCRED, &optVal, sizeof(int)) == -1) {
-            crinitErrnoPrint("(TID %d) Could not set SO_PASSCRED option for connection socket.", threadId);
-            close(connSockFd);
-            continue;
+static void *crinitCmdWorker(void *args) {
+    crinitCmdWorkerArgs_t *wa = args;
+    crinitCmdQueue_t *q = wa->queue;
+    pid_t threadId = crinitGettid();
+
+    crinitDbgInfoPrint("(TID %d) Server command worker ready.", threadId);
+    while (true) {
+        pthread_mutex_lock(&q->lock);
+        while (q->head == NULL) {
+            pthread_cond_wait(&q->connAvail, &q->lock);
         }
-        if (crinitSendStr(connSockFd, "RTR") == -1) {
-            crinitErrPrint("(TID %d) Could not send RTR-message to client.", threadId);
-            close(connSockFd);
+        crinitConn_t *c = q->head;
+        q->head = c->next;
+        if (q->head == NULL) {
+            q->tail = NULL;
+        }
+        pthread_mutex_unlock(&q->lock);
+        c->next = NULL;
+
+        crinitRtimCmd_t res;
+        if (crinitExecRtimCmd(crinitTdbRef, &res, &c->cmd) == -1) {
+            crinitErrPrint("(TID %d) Could not execute command from client.", threadId);
+            crinitDestroyRtimCmd(&c->cmd);
+            crinitConnClose(c);
             continue;
         }
-        struct ucred msgCreds = {0};
-        char *clientMsg = NULL;
-        if (crinitRecvStr(connSockFd, &clientMsg, &msgCreds) == -1) {
-            crinitErrPrint("(TID %d) Could not receive string message from client.", threadId);
-            close(connSockFd);
+        crinitDestroyRtimCmd(&c->cmd);
+        if (crinitConnSetResponse(c, &res) == -1) {
+            crinitConnClose(c);
             continue;
         }
+        crinitConnProcess(c);
+    }
+    return NULL;
+}
 
-        crinitDbgInfoPrint("(TID %d) Received string \'%s\' from client.", threadId, clientMsg);
-        crinitDbgInfoPrint("(TID %d) Received following credentials from peer process: PID=%d, UID=%d, GID=%d",
-                           threadId, msgCreds.pid, msgCreds.uid, msgCreds.gid);
+static void crinitServAccept(pid_t threadId) {
+    bool paused = false;
+    while (true) {
+        int connSockFd = accept4(crinitServSockFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (connSockFd == -1) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno == EMFILE || errno == ENFILE) {
+                if (paused) {
+                    return;
+                }
+                crinitErrnoPrint("(TID %d) Could not accept connection, will resume once a connection is closed.",
+                                 threadId);
+                // A connection closed before the flag was set would not resume accepting, so try once more.
+                atomic_store(&crinitServAcceptPaused, true);
+                paused = true;
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                crinitErrnoPrint("(TID %d) Could not accept connection.", threadId);
+            }
+            break;
+        }
+        if (paused) {
+            atomic_store(&crinitServAcceptPaused, false);
+            paused = false;
+        }
 
-        crinitRtimCmd_t cmd, res;
-        if (crinitParseRtimCmd(&cmd, clientMsg) == -1) {
-            crinitErrPrint("(TID %d) Could not parse command from client.", threadId);
-            free(clientMsg);
+        crinitConn_t *c = calloc(1, sizeof(*c));
+        if (c == NULL) {
+            crinitErrnoPrint("(TID %d) Could not allocate memory for connection.", threadId);
             close(connSockFd);
             continue;
         }
-        free(clientMsg);
-        if (!crinitCheckPerm(cmd.op, &msgCreds)) {
-            crinitErrPrint("(TID %d) Client does not have permission to issue command.", threadId);
-#ifdef ENABLE_ELOS
-            if (crinitElosLog(ELOS_SEVERITY_WARN, ELOS_MSG_CODE_IPC_NOT_AUTHORIZED,
-                              ELOS_CLASSIFICATION_SECURITY | ELOS_CLASSIFICATION_IPC, "%d", msgCreds.pid) == -1) {
-                crinitErrPrint("Could not enqueue elos permission event. Will continue but logging may be impaired.");
-            }
-#endif
-            if (crinitBuildRtimCmd(&res, cmd.op + 1, 2, CRINIT_RTIMCMD_RES_ERR, "Permission denied.") == -1) {
-                crinitErrPrint("Could not generate response to client.");
-                crinitDestroyRtimCmd(&cmd);
-                close(connSockFd);
+        c->sockFd = connSockFd;
+
+        // A client using version 2 sends its request right away, while a version 1 client waits for RTR.
+        ssize_t msgLen = recv(connSockFd, NULL, 0, MSG_PEEK | MSG_TRUNC);
+        if (msgLen > (ssize_t)sizeof(size_t)) {
+            if (crinitConnPeerCreds(c) == -1) {
+                crinitConnClose(c);
                 continue;
             }
+            c->version = CRINIT_SOCKMSG_VERSION;
+            c->state = CRINIT_CONN_STATE_RECV_LEN;
         } else {
-            if (crinitExecRtimCmd(crinitTdbRef, &res, &cmd) == -1) {
-                crinitErrPrint("(TID %d) Could not execute command from client.", threadId);
-                crinitDestroyRtimCmd(&cmd);
-                close(connSockFd);
+            int optVal = 1;
+            if (setsockopt(connSockFd, SOL_SOCKET, SO_PASSCRED, &optVal, sizeof(int)) == -1) {
+                crinitErrnoPrint("(TID %d) Could not set SO_PASSCRED option for connection socket.", threadId);
+                crinitConnClose(c);
                 continue;
             }
+            c->state = CRINIT_CONN_STATE_SEND_RTR;
+            c->out = "RTR";
+            c->outLen = sizeof("RTR");
+        }
+        crinitConnProcess(c);
+    }
+
+    struct epoll_event ev = {.events = EPOLLIN | EPOLLONESHOT, .data.ptr = NULL};
+    if (epoll_ctl(crinitServEpfd, EPOLL_CTL_MOD, crinitServSockFd, &ev) == -1) {
+        crinitErrnoPrint("(TID %d) Could not re-arm server socket.", threadId);
+    }
+}
+
+static void crinitConnProcess(crinitConn_t *c) {
+    int events = crinitConnHandle(c);
+    if (events == 0) {
+        return;
+    }
+    if (events > 0) {
+        // Once armed, another thread may take over the connection at any time, so it must not be touched afterwards.
+        int op = c->registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        c->registered = true;
+        struct epoll_event ev = {.events = (uint32_t)events | EPOLLONESHOT, .data.ptr = c};
+        if (epoll_ctl(crinitServEpfd, op, c->sockFd, &ev) == 0) {
+            return;
+        }
+        crinitErrnoPrint("Could not add connection to server epoll instance.");
+    }
+    crinitConnClose(c);
+}
+
+static int crinitConnHandle(crinitConn_t *c) {
+    pid_t threadId = crinitGettid();
+    size_t served = 0;
+    int ret;
+    while (true) {
+        switch (c->state) {
+            case CRINIT_CONN_STATE_SEND_RTR:
+            case CRINIT_CONN_STATE_SEND_RES:
+                ret = crinitSendStr(c);
+                if (ret != 0) {
+                    if (ret == -1) {
+                        crinitErrPrint("(TID %d) Could not send message to client.", threadId);
+                    }
+                    return (ret == 1) ? EPOLLOUT : -1;
+                }
+                free(c->outBuf);
+                c->outBuf = NULL;
+                c->outLenSent = false;
+                if (c->state == CRINIT_CONN_STATE_SEND_RES && ++served >= CRINIT_NOTISERV_MAX_REQS_PER_EVENT) {
+                    c->state = CRINIT_CONN_STATE_RECV_LEN;
+                    return EPOLLIN;
+                }
+                c->state = CRINIT_CONN_STATE_RECV_LEN;
+                break;
+            case CRINIT_CONN_STATE_RECV_LEN:
+            case CRINIT_CONN_STATE_RECV_DATA:
+                ret = (c->version == 0) ? crinitConnDetectVersion(c) : 0;
+                if (ret == 0) {
+                    ret = (c->version == CRINIT_SOCKMSG_VERSION) ? crinitRecvMsg(c) : crinitRecvStr(c);
+                }
+                if (ret == 2 && c->state == CRINIT_CONN_STATE_RECV_LEN) {
+                    crinitDbgInfoPrint("(TID %d) Connection closed by client.", threadId);
+                    return -1;
+                }
+                if (ret != 0) {
+                    if (ret != 1) {
+                        crinitErrPrint("(TID %d) Could not receive string message from client.", threadId);
+                    }
+                    return (ret == 1) ? EPOLLIN : -1;
+                }
+                ret = crinitConnDispatch(c);
+                if (ret != 0) {
+                    return (ret == 1) ? 0 : -1;
+                }
+                break;
+            case CRINIT_CONN_STATE_EXEC:
+            default:
+                crinitErrPrint("(TID %d) Connection is in unexpected state %d.", threadId, c->state);
+                return -1;
+        }
+    }
+}
+
+static int crinitConnDispatch(crinitConn_t *c) {
+    pid_t threadId = crinitGettid();
+    if (c->version != CRINIT_SOCKMSG_VERSION) {
+        crinitDbgInfoPrint("(TID %d) Received string \'%s\' from client.", threadId, c->data);
+    }
+    crinitDbgInfoPrint("(TID %d) Received following credentials from peer process: PID=%d, UID=%d, GID=%d", threadId,
+                       c->creds.pid, c->creds.uid, c->creds.gid);
+
+    crinitRtimCmd_t cmd, res;
+    int ret = (c->version == CRINIT_SOCKMSG_VERSION) ? crinitParseRtimCmdBin(&cmd, c->data, c->dataLen)
+                                                     : crinitParseRtimCmd(&cmd, c->data);
+    free(c->data);
+    c->data = NULL;
+    if (ret == -1) {
+        crinitErrPrint("(TID %d) Could not parse command from client.", threadId);
+        return -1;
+    }
+
+    if (!crinitCheckPerm(cmd.op, &c->creds)) {
+        crinitErrPrint("(TID %d) Client does not have permission to issue command.", threadId);
+#ifdef ENABLE_ELOS
+        if (crinitElosLog(ELOS_SEVERITY_WARN, ELOS_MSG_CODE_IPC_NOT_AUTHORIZED,
+                          ELOS_CLASSIFICATION_SECURITY | ELOS_CLASSIFICATION_IPC, "%d", c->creds.pid) == -1) {
+            crinitErrPrint("Could not enqueue elos permission event. Will continue but logging may be impaired.");
+        }
+#endif
+        if (crinitBuildRtimCmd(&res, cmd.op + 1, 2, CRINIT_RTIMCMD_RES_ERR, "Permission denied.") == -1) {
+            crinitErrPrint("Could not generate response to client.");
+            crinitDestroyRtimCmd(&cmd);
+            return -1;
+        }
+    } else if (crinitRtimOpIsBlocking(cmd.op)) {
+        c->cmd = cmd;
+        c->state = CRINIT_CONN_STATE_EXEC;
+        pthread_mutex_lock(&crinitCmdQueue.lock);
+        if (crinitCmdQueue.tail != NULL) {
+            crinitCmdQueue.tail->next = c;
+        } else {
+            crinitCmdQueue.head = c;
         }
+        crinitCmdQueue.tail = c;
+        pthread_cond_signal(&crinitCmdQueue.connAvail);
+        pthread_mutex_unlock(&crinitCmdQueue.lock);
+        return 1;
+    } else if (crinitExecRtimCmd(crinitTdbRef, &res, &cmd) == -1) {
+        crinitErrPrint("(TID %d) Could not execute command from client.", threadId);
         crinitDestroyRtimCmd(&cmd);
+        return -1;
+    }
+    crinitDestroyRtimCmd(&cmd);
+    return crinitConnSetResponse(c, &res);
+}
+
+static int crinitConnSetResponse(crinitConn_t *c, crinitRtimCmd_t *res) {
+    pid_t threadId = crinitGettid();
+    if (c->version == CRINIT_SOCKMSG_VERSION) {
+        void *resMsg;
+        size_t resLen;
+        if (crinitRtimCmdToMsgBin(&resMsg, &resLen, res) == -1) {
+            crinitDestroyRtimCmd(res);
+            crinitErrPrint("(TID %d) Could not transform command result to response message.", threadId);
+            return -1;
+        }
+        crinitDestroyRtimCmd(res);
+        crinitDbgInfoPrint("(TID %d) Will send response message of %zu Bytes to client.", threadId, resLen);
+        c->outBuf = resMsg;
+        c->outLen = resLen;
+    } else {
         char *resStr;
         size_t resLen;
-        if (crinitRtimCmdToMsgStr(&resStr, &resLen, &res) == -1) {
-            crinitDestroyRtimCmd(&res);
+        if (crinitRtimCmdToMsgStr(&resStr, &resLen, res) == -1) {
+            crinitDestroyRtimCmd(res);
             crinitErrPrint("(TID %d) Could not transform command result to response string.", threadId);
-            continue;
+            return -1;
         }
-        crinitDestroyRtimCmd(&res);
+        crinitDestroyRtimCmd(res);
         crinitDbgInfoPrint("(TID %d) Will send response message \'%s\' to client.", threadId, resStr);
-        if (crinitSendStr(connSockFd, resStr) == -1) {
-            crinitErrPrint("(TID %d) Could not send response message to client.", threadId);
-            free(resStr);
-            close(connSockFd);
-            continue;
-        }
+        c->outBuf = resStr;
+        c->outLen = strlen(resStr) + 1;
+    }
 
-        free(resStr);
-        close(connSockFd);
-        crinitThreadPoolThreadAvailCallback(a->tpRef);
+    c->out = c->outBuf;
+    c->outLenSent = false;
+    c->state = CRINIT_CONN_STATE_SEND_RES;
+    return 0;
+}
+
+static void crinitConnClose(crinitConn_t *c) {
+    close(c->sockFd);
+    free(c->data);
+    free(c->outBuf);
+    free(c);
+
+    if (atomic_exchange(&crinitServAcceptPaused, false)) {
+        struct epoll_event ev = {.events = EPOLLIN | EPOLLONESHOT, .data.ptr = NULL};
+        if (epoll_ctl(crinitServEpfd, EPOLL_CTL_MOD, crinitServSockFd, &ev) == -1) {
+            crinitErrnoPrint("Could not re-arm server socket.");
+        }
     }
-    return NULL;
+}
+
+static inline bool crinitRtimOpIsBlocking(crinitRtimOp_t op) {
+    // Both read and parse configuration files.
+    return op == CRINIT_RTIMCMD_C_ADDTASK || op == CRINIT_RTIMCMD_C_ADDSERIES;
 }
 
 static int crinitCreateSockFile(int *sockFd, const char *path) {
@@ -355,7 +758,7 @@ static int crinitCreateSockFile(int *sockFd, const char *path) {
     *sockFd = -1;
     struct sockaddr_un servAddr;
 
-    if ((*sockFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)) == -1) {
+    if ((*sockFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) == -1) {
         crinitErrnoPrint("Could not create server socket.");
         return -1;
     }
@@ -376,117 +779,212 @@ static int crinitCreateSockFile(int *sockFd, const char *path) {
     return 0;
 }
 
-static inline int crinitSendStr(int sockFd, const char *str) {
+static inline int crinitSendStr(crinitConn_t *c) {
     pid_t threadId = crinitGettid();
-    if (str == NULL) {
-        crinitErrPrint("(TID %d) String to send must not be NULL.", threadId);
+
+    if (c->version == CRINIT_SOCKMSG_VERSION) {
+        crinitSockMsgHdr_t hdr = {CRINIT_SOCKMSG_MARKER, CRINIT_SOCKMSG_VERSION, 0};
+        struct iovec iov[2] = {{.iov_base = &hdr, .iov_len = sizeof(hdr)},
+                               {.iov_base = (void *)c->out, .iov_len = c->outLen}};
+        struct msghdr mHdr = {.msg_iov = iov, .msg_iovlen = 2};
+        if (sendmsg(c->sockFd, &mHdr, MSG_NOSIGNAL) == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return 1;
+            }
+            crinitErrnoPrint("(TID %d) Could not send response message to client.", threadId);
+            return -1;
+        }
+        return 0;
+    }
+
+    if (!c->outLenSent) {
+        if (send(c->sockFd, &c->outLen, sizeof(size_t), MSG_NOSIGNAL) == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return 1;
+            }
+            crinitErrnoPrint("(TID %d) Could not send length packet (\'%zu\') of string \'%s\' to client. %d",
+                             threadId, c->outLen, c->out, c->sockFd);
+            return -1;
+        }
+        c->outLenSent = true;
+    }
+
+    if (send(c->sockFd, c->out, c->outLen, MSG_NOSIGNAL) == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 1;
+        }
+        crinitErrnoPrint("(TID %d) Could not send string \'%s\' to client.", threadId, c->out);
         return -1;
     }
 
-    size_t dataLen = strlen(str) + 1;
-    if (send(sockFd, &dataLen, sizeof(size_t), MSG_NOSIGNAL) == -1) {
-        crinitErrnoPrint("(TID %d) Could not send length packet (\'%zu\') of string \'%s\' to client. %d", threadId,
-                         dataLen, str, sockFd);
+    return 0;
+}
+
+static inline int crinitRecvStr(crinitConn_t *c) {
+    pid_t threadId = crinitGettid();
+    int ret;
+
+    if (c->state == CRINIT_CONN_STATE_RECV_LEN) {
+        ret = crinitRecvPacket(c->sockFd, &c->dataLen, sizeof(size_t), &c->creds);
+        if (ret != 0) {
+            return ret;
+        }
+        crinitDbgInfoPrint("(TID %d) Received message of %zu Bytes. Content:\n\'%zu\'", threadId, sizeof(size_t),
+                           c->dataLen);
+        if (c->dataLen == 0) {
+            crinitErrPrint("(TID %d) Client announced a string of length 0.", threadId);
+            return -1;
+        }
+        c->data = malloc(c->dataLen);
+        if (c->data == NULL) {
+            crinitErrnoPrint("(TID %d) Could not allocate receive buffer of size %zu Bytes.", threadId, c->dataLen);
+            return -1;
+        }
+        c->state = CRINIT_CONN_STATE_RECV_DATA;
+    }
+
+    struct ucred dataCreds;
+    ret = crinitRecvPacket(c->sockFd, c->data, c->dataLen, &dataCreds);
+    if (ret != 0) {
+        return ret;
+    }
+    // force terminating zero
+    c->data[c->dataLen - 1] = '\0';
+    crinitDbgInfoPrint("(TID %d) Received message of %zu Bytes. Content:\n\'%s\'", threadId, c->dataLen, c->data);
+
+    if (!crinitUcredCheckEqual(&c->creds, &dataCreds)) {
+        crinitErrPrint(
+            "(TID %d) Ancillary credential data of the length and data parts of the string message do not match.",
+            threadId);
         return -1;
     }
+    return 0;
+}
 
-    if (send(sockFd, str, dataLen, MSG_NOSIGNAL) == -1) {
-        crinitErrnoPrint("(TID %d) Could not send string \'%s\' to client.", threadId, str);
+static inline int crinitRecvMsg(crinitConn_t *c) {
+    pid_t threadId = crinitGettid();
+
+    ssize_t msgLen = recv(c->sockFd, NULL, 0, MSG_PEEK | MSG_TRUNC);
+    if (msgLen == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 1;
+        }
+        crinitErrnoPrint("(TID %d) Could not receive message via socket.", threadId);
+        return -1;
+    }
+    if (msgLen == 0) {
+        return 2;
+    }
+    if ((size_t)msgLen <= sizeof(crinitSockMsgHdr_t)) {
+        crinitErrPrint("(TID %d) Received message of unexpected length from client: %ld Bytes", threadId, msgLen);
         return -1;
     }
 
+    c->data = malloc(msgLen);
+    if (c->data == NULL) {
+        crinitErrnoPrint("(TID %d) Could not allocate receive buffer of size %ld Bytes.", threadId, msgLen);
+        return -1;
+    }
+    // The message is queued completely, so this does not block.
+    if (recv(c->sockFd, c->data, msgLen, 0) != msgLen) {
+        crinitErrnoPrint("(TID %d) Could not receive message of size %ld Bytes via socket.", threadId, msgLen);
+        return -1;
+    }
+    crinitSockMsgHdr_t hdr;
+    memcpy(&hdr, c->data, sizeof(hdr));
+    if (hdr.marker != CRINIT_SOCKMSG_MARKER || hdr.version != CRINIT_SOCKMSG_VERSION) {
+        crinitErrPrint("(TID %d) Received message with unexpected header from client.", threadId);
+        return -1;
+    }
+    c->dataLen = (size_t)msgLen - sizeof(hdr);
+    memmove(c->data, c->data + sizeof(hdr), c->dataLen);
+    crinitDbgInfoPrint("(TID %d) Received message of %ld Bytes.", threadId, msgLen);
     return 0;
 }
 
-static inline int crinitRecvStr(int sockFd, char **str, struct ucred *passedCreds) {
+static inline int crinitConnDetectVersion(crinitConn_t *c) {
     pid_t threadId = crinitGettid();
-    if (str == NULL || passedCreds == NULL) {
-        crinitErrPrint("(TID %d) Pointer arguments must not be NULL.", threadId);
+
+    ssize_t msgLen = recv(c->sockFd, NULL, 0, MSG_PEEK | MSG_TRUNC);
+    if (msgLen == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 1;
+        }
+        crinitErrnoPrint("(TID %d) Could not receive message via socket.", threadId);
+        return -1;
+    }
+    if (msgLen == 0) {
+        return 2;
+    }
+    if ((size_t)msgLen == sizeof(size_t)) {
+        c->version = 1;
+        return 0;
+    }
+
+    if (crinitConnPeerCreds(c) == -1) {
+        return -1;
+    }
+    // The credentials are not needed anymore for each message.
+    int optVal = 0;
+    if (setsockopt(c->sockFd, SOL_SOCKET, SO_PASSCRED, &optVal, sizeof(int)) == -1) {
+        crinitErrnoPrint("(TID %d) Could not unset SO_PASSCRED option for connection socket.", threadId);
+        return -1;
+    }
+    c->version = CRINIT_SOCKMSG_VERSION;
+    return 0;
+}
+
+static inline int crinitConnPeerCreds(crinitConn_t *c) {
+    socklen_t len = sizeof(c->creds);
+    if (getsockopt(c->sockFd, SOL_SOCKET, SO_PEERCRED, &c->creds, &len) == -1) {
+        crinitErrnoPrint("(TID %d) Could not get credentials of client.", crinitGettid());
         return -1;
     }
+    return 0;
+}
+
+static inline int crinitRecvPacket(int sockFd, void *buf, size_t len, struct ucred *creds) {
+    pid_t threadId = crinitGettid();
 
     union {
         char alignedBuf[CMSG_SPACE(sizeof(struct ucred))];
         struct cmsghdr alignment;
     } ancillaryData;
-    struct ucred scmCreds[2] = {0};
 
-    struct iovec iov;
+    struct iovec iov = {.iov_base = buf, .iov_len = len};
     struct msghdr mHdr;
     memset(&mHdr, 0, sizeof(struct msghdr));
     mHdr.msg_name = NULL;
     mHdr.msg_namelen = 0;
     mHdr.msg_iov = &iov;
     mHdr.msg_iovlen = 1;
-
-    size_t dataLen = 0;
-    iov.iov_base = &dataLen;
-    iov.iov_len = sizeof(size_t);
-
     mHdr.msg_control = ancillaryData.alignedBuf;
     mHdr.msg_controllen = sizeof(ancillaryData.alignedBuf);
-    ssize_t bytesRead = -1;
-    bytesRead = recvmsg(sockFd, &mHdr, 0);
+
+    ssize_t bytesRead = recvmsg(sockFd, &mHdr, 0);
     if (bytesRead == -1) {
-        crinitErrnoPrint("(TID %d) Could not receive string length message via socket.", threadId);
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 1;
+        }
+        crinitErrnoPrint("(TID %d) Could not receive message of size %zu Bytes via socket.", threadId, len);
         return -1;
     }
-    if (bytesRead != sizeof(size_t)) {
-        crinitErrPrint("Received data of unexpected length from client: %ld Bytes", bytesRead);
+    if (bytesRead == 0) {
+        return 2;
+    }
+    if ((size_t)bytesRead != len) {
+        crinitErrPrint("Received data of unexpected length from client: %ld Bytes vs. expected %zu Bytes", bytesRead,
+                       len);
         return -1;
     }
-    crinitDbgInfoPrint("(TID %d) Received message of %ld Bytes. Content:\n\'%zu\'", threadId, bytesRead, dataLen);
 
     struct cmsghdr *cmHdr = CMSG_FIRSTHDR(&mHdr);
     if (!crinitCmsgHdrCheck(cmHdr)) {
         crinitErrPrint("(TID %d) Control message header of received ancillary data is invalid.", threadId);
         return -1;
     }
-    memcpy(&scmCreds[0], CMSG_DATA(cmHdr), sizeof(struct ucred));
-
-    *str = malloc(dataLen);
-    if (*str == NULL) {
-        crinitErrnoPrint("(TID %d) Could not allocate receive buffer of size %zu Bytes.", threadId, dataLen);
-        return -1;
-    }
-    iov.iov_base = *str;
-    iov.iov_len = dataLen;
-
-    bytesRead = recvmsg(sockFd, &mHdr, 0);
-    if (bytesRead < 0) {
-        crinitErrnoPrint("(TID %d) Could not receive string data message of size %zu Bytes via socket.", threadId,
-                         dataLen);
-        goto fail;
-    }
-    if ((size_t)bytesRead != dataLen) {
-        crinitErrPrint("Received data of unexpected length from client: %ld Bytes vs. announced %zu Bytes ", bytesRead,
-                       dataLen);
-        goto fail;
-    }
-    // force terminating zero
-    (*str)[dataLen - 1] = '\0';
-    crinitDbgInfoPrint("(TID %d) Received message of %ld Bytes. Content:\n\'%s\'", threadId, bytesRead, *str);
-
-    cmHdr = CMSG_FIRSTHDR(&mHdr);
-    if (!crinitCmsgHdrCheck(cmHdr)) {
-        crinitErrPrint("(TID %d) Control message header of received ancillary data is invalid.", threadId);
-        goto fail;
-    }
-    memcpy(&scmCreds[1], CMSG_DATA(cmHdr), sizeof(struct ucred));
-
-    if (!crinitUcredCheckEqual(&scmCreds[0], &scmCreds[1])) {
-        crinitErrPrint(
-            "(TID %d) Ancillary credential data of the length and data parts of the string message do not match.",
-            threadId);
-        goto fail;
-    }
-
-    memcpy(passedCreds, scmCreds, sizeof(struct ucred));
+    memcpy(creds, CMSG_DATA(cmHdr), sizeof(struct ucred));
     return 0;
-fail:
-    free(*str);
-    *str = NULL;
-    return -1;
 }
 
 static inline bool crinitUcredCheckEqual(const struct ucred *a, const struct ucred *b) {
@@ -518,6 +1016,9 @@ static inline bool crinitCheckPerm(crinitRtimOp_t op, const struct ucred *passed
         case CRINIT_RTIMCMD_C_STATUS:
         case CRINIT_RTIMCMD_C_TASKLIST:
         case CRINIT_RTIMCMD_C_GETVER:
+        case CRINIT_RTIMCMD_C_DEPGRAPH:
+        case CRINIT_RTIMCMD_C_USAGE:
+        case CRINIT_RTIMCMD_C_STATUSLIST:
             return true;
         case CRINIT_RTIMCMD_C_SHUTDOWN:
             if (crinitProcCapget(capdata, passedCreds->pid) == -1) {
@@ -536,6 +1037,9 @@ static inline bool crinitCheckPerm(crinitRtimOp_t op, const struct ucred *passed
         case CRINIT_RTIMCMD_R_STATUS:
         case CRINIT_RTIMCMD_R_TASKLIST:
         case CRINIT_RTIMCMD_R_GETVER:
+        case CRINIT_RTIMCMD_R_DEPGRAPH:
+        case CRINIT_RTIMCMD_R_USAGE:
+        case CRINIT_RTIMCMD_R_STATUSLIST:
         case CRINIT_RTIMCMD_R_SHUTDOWN:
         default:
             crinitErrPrint("Unknown or unsupported opcode.");
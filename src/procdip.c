@@ -3,15 +3,22 @@
  * @file procdip.c
  * @brief Implementation of the Process Dispatcher.
  */
+#define _GNU_SOURCE  ///< Needed for pipe2() and O_DIRECT.
 #include "procdip.h"
 
+#include <fcntl.h>
+#include <limits.h>
 #include <spawn.h>
+#include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "timerdb.h"
@@ -20,10 +27,14 @@
 #include "capabilities.h"
 #endif
 #include "confhdl.h"
+#include "dispqueue.h"
 #include "envset.h"
 #include "globopt.h"
-#include "lexers.h"
 #include "logio.h"
+#include "procspawn.h"
+#include "procsup.h"
+#include "schedparam.h"
+#include "thrpool.h"
 
 #ifndef SYS_gettid
 #error "SYS_gettid unavailable on this system"
@@ -32,28 +43,149 @@
 /** Macro wrapper for the gettid syscall in case glibc is not new enough to contain one itself **/
 #define crinitGettid() ((pid_t)syscall(SYS_gettid))
 
-/** Struct wrapper for arguments to dispatchThreadFunc **/
+/**
+ * Precompiled arguments to spawn a single command of a task, see crinitSpawnPlan_t.
+ */
+typedef struct crinitSpawnPlanCmd {
+    char *path;        ///< The executable to spawn using posix_spawn(), either the command itself or crinit-launch.
+    char **argv;       ///< The argument vector to spawn path with.
+    char *argvBuffer;  ///< Buffer backing the launcher arguments in argv, NULL if crinit-launch is not used.
+    bool direct;       ///< If true, try to spawn the command using crinitProcSpawn() before falling back to path/argv.
+} crinitSpawnPlanCmd_t;
+
+/**
+ * Everything needed to spawn the commands of a task which stays the same from one run of the task to the next.
+ *
+ * The plan for the COMMANDs of a task is built on the first dispatch of a configuration snapshot and kept in
+ * crinitTaskCfg_t::spawnPlan, so that later runs of the same configuration do not need to allocate, query global
+ * options, format launcher arguments, or check FIFOs. It is rebuilt if global options have changed in the meantime.
+ */
+typedef struct crinitSpawnPlan {
+    crinitSpawnPlanHdr_t hdr;            ///< Common header, must be the first member.
+    unsigned long long globOptGen;       ///< Generation of the global options the plan was built from.
+    bool useFileact;                     ///< If true, fileact holds the IO redirections of the task.
+    posix_spawn_file_actions_t fileact;  ///< File actions implementing the IO redirections for posix_spawn().
+    crinitProcSpawnCreds_t creds;        ///< Credentials and cgroup of the task for crinitProcSpawn().
+    char *launcherCmd;                   ///< Path to crinit-launch, NULL if the task does not need it.
+    size_t cmdsSize;                     ///< Number of elements in cmds.
+    crinitSpawnPlanCmd_t cmds[];         ///< Arguments to spawn each command with.
+} crinitSpawnPlan_t;
+
+/**
+ * Struct wrapper for a task handed to the dispatch worker threads, see crinitDispatchTask().
+ *
+ * Also holds the progress through the commands of the task, as the commands after the first one are started from the
+ * Process Supervisor once their predecessor has returned.
+ */
 typedef struct crinitDispThrArgs {
     crinitTaskDB_t *ctx;              ///< The TaskDB context to update on task state changes.
-    const crinitTask_t *t;            ///< The task to run.
+    crinitTaskCfg_t *cfg;             ///< Reference to the configuration snapshot of the task to run.
     crinitDispatchThreadMode_t mode;  ///< Select between start and stop commands
+    crinitTask_t *t;                  ///< The task to run, points into crinitDispThrArgs_t::cfg.
+    crinitTaskCmd_t *cmds;            ///< The commands to run, either COMMANDs or STOP_COMMANDs of the task.
+    crinitTaskCmd_t *cmdsPrivate;     ///< Expanded copies of the STOP_COMMANDs if any of them contains variables, NULL
+                                      ///< otherwise. Elements without variables share argv with the task.
+    crinitSpawnPlan_t *plan;          ///< Reference to the spawn plan for cmds.
+    size_t cmdsSize;                  ///< Number of elements in cmds.
+    size_t cmdIdx;                    ///< Index of the command currently running.
+    pid_t pid;                        ///< PID of the currently running command, -1 if there is none.
+    struct timespec readyTime;        ///< Time the task was handed to the Process Dispatcher (CLOCK_MONOTONIC).
+    int readyFd[2];                   ///< Readiness pipe of a task using READY_FD, both -1 if there is none.
+    posix_spawn_file_actions_t readyFileact;  ///< IO redirections of the task plus the readiness pipe, valid if
+                                              ///< there is a readiness pipe.
+    crinitIoRedir_t *readyRedirs;     ///< The same as readyFileact for crinitProcSpawn(), the readiness pipe comes
+                                      ///< first and is followed by a shallow copy of the task's IO redirections.
 } crinitDispThrArgs_t;
 
+/** Helper structure defining the arguments to crinitDispatchWorkerFunc() **/
+typedef struct crinitDispWorkerArgs {
+    crinitDispatchQueue_t *queue;  ///< The queue to take tasks from.
+} crinitDispWorkerArgs_t;
+
+/** The queue of tasks to be dispatched, its depth is set by the DISPATCH_QUEUE_DEPTH global option. **/
+static crinitDispatchQueue_t crinitDispQueue;
+/** The worker thread pool to run crinitDispatchWorkerFunc() in. **/
+static crinitThreadPool_t crinitDispWorkers;
+/** Makes sure the queue and the worker threads are set up exactly once, see crinitDispatchInit(). **/
+static pthread_once_t crinitDispInitOnce = PTHREAD_ONCE_INIT;
+/** errno value if crinitDispatchInit() has failed, 0 otherwise. **/
+static int crinitDispInitErr = 0;
+
 /** Mutex to guard #crinitWaitInhibit **/
 static pthread_mutex_t crinitWaitInhibitLock = PTHREAD_MUTEX_INITIALIZER;
 /** Condition variable to signal threads waiting for #crinitWaitInhibit to become `false`. **/
 static pthread_cond_t crinitWaitInhibitCond = PTHREAD_COND_INITIALIZER;
 /** If true, all terminated child processes will be kept around as zombies (see crinitBlockOnWaitInhibit()). **/
 static bool crinitWaitInhibit = false;
+/** Protects crinitTaskCfg_t::spawnPlan of all configuration snapshots, see crinitSpawnPlanGet(). **/
+static pthread_mutex_t crinitSpawnPlanLock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
- * Function to be started as a pthread from crinitProcDispatchThread().
+ * Allocate the dispatch queue and start the dispatch worker threads.
  *
- * Takes care of process spawning/waiting and crinitTaskDB_t status updates.
+ * Called once through pthread_once() on the first use of the Process Dispatcher, so that the DISPATCH_WORKERS and
+ * DISPATCH_QUEUE_DEPTH global options have already been read from the series file. Sets #crinitDispInitErr on error.
+ */
+static void crinitDispatchInit(void);
+/**
+ * The worker thread function of the Process Dispatcher.
+ *
+ * Takes tasks from the dispatch queue in a loop and runs crinitDispatchTask() on them.
+ *
+ * @param args  Arguments to the function, see crinitDispWorkerArgs_t.
+ *
+ * @return  Does not return.
+ */
+static void *crinitDispatchWorkerFunc(void *args);
+/**
+ * Prepare a task and start its first command.
  *
- * @param args  See crinitDispThrArgs_t.
+ * Returns as soon as the command is running, waiting for it and starting the following commands is left to the
+ * Process Supervisor (see procsup.h).
+ *
+ * @param a  The dispatch state of the task, ownership is taken.
+ */
+static void crinitDispatchTask(crinitDispThrArgs_t *a);
+/**
+ * Start the current command of a task and hand it over to the Process Supervisor.
+ *
+ * If there are no more commands left, the task is done. If the kernel does not support pidfds, the calling thread
+ * waits for the command itself. Takes ownership of \a a.
+ *
+ * @param a  The dispatch state of the task, crinitDispThrArgs_t::cmdIdx selects the command to start.
  */
-static void *crinitDispatchThreadFunc(void *args);
+static void crinitDispatchRunCommand(crinitDispThrArgs_t *a);
+/**
+ * Spawn the current command of a task and update the TaskDB accordingly.
+ *
+ * Sets crinitDispThrArgs_t::pid. If it is the first command of the task, the task is set to running and its `spawn`
+ * dependency and features are fulfilled.
+ *
+ * @param a         The dispatch state of the task, crinitDispThrArgs_t::cmdIdx selects the command to spawn.
+ * @param threadId  The TID of the calling thread, used for log messages.
+ *
+ * @return 0 on success, -1 on error
+ */
+static int crinitDispatchSpawnCommand(crinitDispThrArgs_t *a, pid_t threadId);
+/**
+ * Process Supervisor callback for a terminated command, see crinitProcSupCallback_t.
+ *
+ * Reaps a successful command and starts the next one or finishes the task if the command was not successful.
+ */
+static void crinitDispatchCommandExited(pid_t pid, const siginfo_t *status, void *args);
+/**
+ * Set the final state of a task, fulfill the respective dependencies and features, and free the dispatch state.
+ *
+ * @param a        The dispatch state of the task, will be freed.
+ * @param success  true if all commands have returned successfully, false otherwise.
+ */
+static void crinitDispatchFinish(crinitDispThrArgs_t *a, bool success);
+/**
+ * Rearm or remove the triggers of a task and free its dispatch state.
+ *
+ * @param a  The dispatch state of the task, will be freed.
+ */
+static void crinitDispatchRelease(crinitDispThrArgs_t *a);
 /**
  * Block calling thread until #crinitWaitInhibit becomes false.
  *
@@ -68,10 +200,94 @@ static int crinitBlockOnWaitInhibit(void);
  * Will call blockOnWaitInhibit() internally.
  *
  * @param pid  The PID of the process to wait for.
+ * @param ru   Return pointer for the resource usage of the process.
  *
- * @return 0 on success, -1 on error
+ * @return 1 if the process has been reaped and \a ru is filled, 0 if the process has already been reaped or never
+ *         existed, -1 on error
+ */
+static int crinitReapPid(pid_t pid, struct rusage *ru);
+/**
+ * Reap the zombie of the current command of a dispatched task and add its resource usage to the task's totals.
+ *
+ * @param a  The dispatch state of the task, crinitDispThrArgs_t::pid must refer to the terminated process.
  */
-static int crinitReapPid(pid_t pid);
+static void crinitDispatchReap(crinitDispThrArgs_t *a);
+/**
+ * Set up the STOP_COMMANDs of a task as the commands to run and expand the variables in them.
+ *
+ * Sets crinitDispThrArgs_t::cmds and crinitDispThrArgs_t::cmdsSize. If none of the STOP_COMMANDs contains variables,
+ * the commands of the task are used as they are. Otherwise crinitDispThrArgs_t::cmdsPrivate is allocated and holds
+ * expanded copies of the commands containing variables.
+ *
+ * @param a     The dispatch state of the task to stop.
+ * @param vals  The current values of the variables.
+ *
+ * @return  0 on success, -1 on error
+ */
+static int crinitDispatchExpandStopCmds(crinitDispThrArgs_t *a, const crinitCmdVarVals_t *vals);
+/**
+ * Create the readiness pipe of a task using READY_FD and hand its read end to the Process Supervisor.
+ *
+ * The write end is passed to every command of the task as #CRINIT_READY_FD_NO, see crinitDispThrArgs_t::readyFileact
+ * and crinitDispThrArgs_t::readyRedirs. The pipe is in packet mode, so that each write() of the task is read as a
+ * single sd_notify() state string.
+ *
+ * If the Process Supervisor is not available, the function succeeds without creating a pipe. The task will then fall
+ * back to the notification socket.
+ *
+ * @param a  The dispatch state of the task, crinitDispThrArgs_t::plan must be set.
+ *
+ * @return  0 on success, -1 on error
+ */
+static int crinitDispatchReadyFdOpen(crinitDispThrArgs_t *a);
+/**
+ * Stop watching the readiness pipe of a task, apply notifications still in the pipe, and close it.
+ *
+ * Does nothing if the task has no readiness pipe.
+ *
+ * @param a  The dispatch state of the task.
+ */
+static void crinitDispatchReadyFdClose(crinitDispThrArgs_t *a);
+/**
+ * Process Supervisor callback for a readable readiness pipe, see crinitProcSupFdCallback_t.
+ *
+ * Reads all pending state strings and applies them to the task using crinitTaskDBNotify(). A `MAINPID` which
+ * crinitDispatchMainPidPermitted() rejects is ignored, the rest of the state string is applied.
+ */
+static void crinitDispatchReadyFdReadable(int fd, void *args);
+/**
+ * Check if a task may report a process as its main PID through its readiness pipe.
+ *
+ * Anything which can write to the pipe could otherwise make crinit signal an arbitrary process on STOP or KILL. The
+ * same as for the NOTIFY runtime command, a task running with crinit's effective user ID may report any PID. Other
+ * tasks may only report their own process, a descendant of it, or a process in their cgroup. Not static so that it
+ * can be unit tested.
+ *
+ * @param mainPid   The reported main PID.
+ * @param taskPid   The PID of the task's running command, -1 if there is none.
+ * @param taskUser  The user ID the task runs as.
+ * @param cgroupFd  Open directory file descriptor of the task's cgroup, -1 if the task has none.
+ *
+ * @return  true if the main PID is accepted, false otherwise
+ */
+bool crinitDispatchMainPidPermitted(pid_t mainPid, pid_t taskPid, uid_t taskUser, int cgroupFd);
+/**
+ * Get the parent of a process from `/proc/<pid>/stat`.
+ *
+ * @param pid  The process.
+ *
+ * @return  The PID of the parent, or -1 on error, e.g. if the process does not exist anymore.
+ */
+static pid_t crinitProcGetParent(pid_t pid);
+/**
+ * Check if a process is listed in the `cgroup.procs` file of a cgroup.
+ *
+ * @param pid       The process.
+ * @param cgroupFd  Open directory file descriptor of the cgroup.
+ *
+ * @return  true if the process is a member of the cgroup, false otherwise or on error
+ */
+static bool crinitCgroupHasPid(pid_t pid, int cgroupFd);
 
 /**
  * Adds an action to a posix_spawn_file_actions_t instance as defined by an crinitIoRedir_t instance.
@@ -103,47 +319,100 @@ static int crinitPosixSpawnAddIOFileAction(posix_spawn_file_actions_t *fileact,
  * @return  0 on success, -1 otherwise.
  */
 static int crinitEnsureFifo(const char *path, mode_t mode);
+#ifdef ENABLE_CAPABILITIES
+/**
+ * Calculate the capabilities a task shall run with.
+ *
+ * Starts from the global `DEFAULTCAPS` and applies `CAPABILITY_CLEAR` and `CAPABILITY_SET` of the task.
+ *
+ * @param t     The task.
+ * @param caps  Return pointer for the resulting capability bitmask.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+static int crinitCalcTaskCapabilities(const crinitTask_t *t, uint64_t *caps);
+#endif
+/**
+ * Build a spawn plan for the commands of a task.
+ *
+ * Checks the FIFOs used in IO redirections, prepares the file actions, and, if the task needs to run with different
+ * credentials or in a cgroup, calculates its capabilities, opens its cgroup, and creates the crinit-launch arguments
+ * for each command. The cgroup must already exist.
+ *
+ * @param t            The task, must outlive the plan.
+ * @param cmds         The commands of the task to plan for, must outlive the plan.
+ * @param cmdsSize     Number of elements in \a cmds.
+ * @param useIoRedirs  Whether the IO redirections of the task shall be applied to the commands.
+ *
+ * @return  The new plan with a single reference on success, NULL otherwise.
+ */
+static crinitSpawnPlan_t *crinitSpawnPlanCreate(crinitTask_t *t, crinitTaskCmd_t *cmds, size_t cmdsSize,
+                                                bool useIoRedirs);
+/**
+ * Free a spawn plan, used as crinitSpawnPlanHdr_t::destroy.
+ *
+ * @param hdr  The header of the plan to free.
+ */
+static void crinitSpawnPlanDestroy(crinitSpawnPlanHdr_t *hdr);
+/**
+ * Get a reference to the spawn plan for the COMMANDs of a configuration snapshot.
+ *
+ * Returns the plan cached in the snapshot or builds and caches a new one if there is none yet or if the global options
+ * have changed since it was built. Not static so that the caching can be unit tested.
+ *
+ * @param cfg  The configuration snapshot.
+ *
+ * @return  The plan on success, NULL otherwise. The reference must be released using crinitSpawnPlanRelease().
+ */
+crinitSpawnPlan_t *crinitSpawnPlanGet(crinitTaskCfg_t *cfg);
 
 int crinitProcDispatchSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
-    pthread_t dispatchThread;
-    pthread_attr_t dispatchThreadAttr;
+    if ((errno = pthread_once(&crinitDispInitOnce, crinitDispatchInit)) != 0) {
+        crinitErrnoPrint("Could not initialize Process Dispatcher.");
+        return -1;
+    }
+    if (crinitDispInitErr != 0) {
+        errno = crinitDispInitErr;
+        crinitErrnoPrint("Process Dispatcher is unavailable. Can not dispatch task \'%s\'.", t->name);
+        return -1;
+    }
+
     crinitDispThrArgs_t *threadArgs = malloc(sizeof(crinitDispThrArgs_t));
     if (threadArgs == NULL) {
-        crinitErrnoPrint("Could not allocate memory for thread arguments. Meant to create thread for task \'%s\'.",
-                         t->name);
+        crinitErrnoPrint("Could not allocate memory for dispatch state of task \'%s\'.", t->name);
         return -1;
     }
     threadArgs->ctx = ctx;
-    threadArgs->t = t;
+    // The snapshot is shared with the TaskDB, so queueing the task does not need to copy anything.
+    threadArgs->cfg = crinitTaskCfgRef(crinitTaskCfgOf(t));
     threadArgs->mode = mode;
-
-    if ((errno = pthread_attr_init(&dispatchThreadAttr)) != 0) {
-        crinitErrnoPrint("Could not initialize pthread attributes. Meant to create thread for task \'%s\'.", t->name);
-        goto fail;
-    }
-
-    if ((errno = pthread_attr_setdetachstate(&dispatchThreadAttr, PTHREAD_CREATE_DETACHED)) != 0) {
-        crinitErrnoPrint("Could not set PTHREAD_CREATE_DETACHED attribute. Meant to create thread for task \'%s\'.",
-                         t->name);
-        goto fail;
-    }
-
-    if ((errno = pthread_attr_setstacksize(&dispatchThreadAttr, CRINIT_PROC_DISPATCH_THREAD_STACK_SIZE)) != 0) {
-        crinitErrnoPrint("Could not set pthread stack size to %d. Meant to create thread for task \'%s\'.",
-                         CRINIT_PROC_DISPATCH_THREAD_STACK_SIZE, t->name);
-        goto fail;
-    }
-
-    crinitDbgInfoPrint("Creating new thread for Task \'%s\'.", t->name);
-    if ((errno = pthread_create(&dispatchThread, &dispatchThreadAttr, crinitDispatchThreadFunc, threadArgs)) != 0) {
-        crinitErrnoPrint("Could not create pthread for task \'%s\'.", t->name);
+    threadArgs->t = &threadArgs->cfg->task;
+    threadArgs->cmds = NULL;
+    threadArgs->cmdsPrivate = NULL;
+    threadArgs->plan = NULL;
+    threadArgs->readyFd[0] = -1;
+    threadArgs->readyFd[1] = -1;
+    threadArgs->readyRedirs = NULL;
+    threadArgs->cmdsSize = 0;
+    threadArgs->cmdIdx = 0;
+    threadArgs->pid = -1;
+    clock_gettime(CLOCK_MONOTONIC, &threadArgs->readyTime);
+
+    // The caller may hold the TaskDB lock the workers need to make progress, so never wait for free space here. The
+    // worker taking the next task from the full queue tells the TaskDB, see crinitDispatchWorkerFunc().
+    if (crinitDispatchQueuePush(&crinitDispQueue, threadArgs) == -1) {
+        if (errno == EAGAIN) {
+            crinitDbgInfoPrint("Dispatch queue is full, task \'%s\' needs to wait.", t->name);
+        } else {
+            crinitErrnoPrint("Could not queue task \'%s\' for dispatch.", t->name);
+        }
         goto fail;
     }
 
-    pthread_attr_destroy(&dispatchThreadAttr);
+    crinitDbgInfoPrint("Queued Task \'%s\' for dispatch.", t->name);
     return 0;
 fail:
-    pthread_attr_destroy(&dispatchThreadAttr);
+    crinitTaskCfgRelease(threadArgs->cfg);
     free(threadArgs);
     return -1;
 }
@@ -160,29 +429,6 @@ int crinitSpawnSingleCommand(const char *cmd, char *const argv[], char *const en
     return 0;
 }
 
-int crinitPrepareIoRedirectionsForSpawn(size_t cmdIdx, crinitIoRedir_t *redirs, size_t redirsSize, pid_t threadId,
-                                        const char *name, posix_spawn_file_actions_t *fileact) {
-    for (size_t j = 0; j < redirsSize; j++) {
-        // NOTE: We currently have a umask of 0022 which precludes us from creating files with 0666 permissions.
-        //       We may want to make that configurable in the future.
-
-        if (redirs[j].fifo && crinitEnsureFifo(redirs[j].path, redirs[j].mode) == -1) {
-            crinitErrPrint(
-                "(TID: %d) Unexpected result while ensuring '%s' is a FIFO special file for command %zu of Task "
-                "'%s'",
-                threadId, redirs[j].path, cmdIdx, name);
-            return -1;
-        }
-
-        if (crinitPosixSpawnAddIOFileAction(fileact, &(redirs[j])) == -1) {
-            crinitErrPrint("(TID: %d) Could not add IO file action to posix_spawn for command %zu of Task '%s'",
-                           threadId, cmdIdx, name);
-            return -1;
-        }
-    }
-    return 0;
-}
-
 static int crinitCalculateVariableGroupParamLength(size_t supGroupsSize, gid_t *supGroups) {
     if (supGroupsSize == 0) {
         return 0;
@@ -250,27 +496,30 @@ int crinitCreateLauncherParameters(crinitTaskCmd_t *taskCmd, crinitTask_t *tCopy
     const size_t userParamLength = snprintf(NULL, 0, userParamFormatStr, tCopy->user) + 1;
     const size_t groupParamFixedPartLength = snprintf(NULL, 0, groupParamFormatStr, tCopy->group) + 1;
 #ifdef ENABLE_CAPABILITIES
-    char *defaultCaps = NULL;
-    if (crinitGlobOptGet(CRINIT_GLOBOPT_DEFAULTCAPS, &defaultCaps) == -1) {
-        defaultCaps = strdup(CRINIT_CONFIG_DEFAULT_DEFAULTCAPS);
-        crinitErrPrint("Could not retrieve global default capabilities. Will use %s", defaultCaps);
-    }
-
-    uint64_t defaultCapsMask = 0;
-    if (crinitCapConvertToBitmask(&defaultCapsMask, defaultCaps) != 0) {
-        free(defaultCaps);
+    uint64_t capEff = 0;
+    if (crinitCalcTaskCapabilities(tCopy, &capEff) == -1) {
         return -1;
     }
-    free(defaultCaps);
-    crinitDbgInfoPrint("Default capabilities: %#lx", defaultCapsMask);
-
-    uint64_t capEff = defaultCapsMask & ~tCopy->capabilitiesClear;
-    capEff |= tCopy->capabilitiesSet;
-    crinitInfoPrint("(Task %s) Calculated effective capabilities: %#lx", tCopy->name, capEff);
 
     const size_t capParamLength = snprintf(NULL, 0, capParamFormatStr, capEff) + 1;
 #endif
 
+    int schedParamLength[CRINIT_SCHED_PARAMS_COUNT];
+    size_t schedParamsTotalLength = 0;
+    size_t schedParamCount = 0;
+    for (crinitSchedParam_t param = 0; param < CRINIT_SCHED_PARAMS_COUNT; param++) {
+        schedParamLength[param] = crinitSchedParamsLauncherOpt(NULL, 0, &tCopy->sched, param);
+        if (schedParamLength[param] == -1) {
+            crinitErrPrint("Failed to create launcher parameter for scheduling parameter '%s'.",
+                           crinitSchedParamName(param));
+            return -1;
+        }
+        if (schedParamLength[param] > 0) {
+            schedParamsTotalLength += schedParamLength[param] + 1;
+            schedParamCount++;
+        }
+    }
+
 #ifdef ENABLE_CGROUP
     size_t cgroupParamLength = 0;
     char *cgroupParam = NULL;
@@ -298,10 +547,6 @@ int crinitCreateLauncherParameters(crinitTaskCmd_t *taskCmd, crinitTask_t *tCopy
         crinitErrPrint("Failed to calculate the size of the supplementary groups parmaeter string.\n");
         return -1;
     }
-    size_t targetParamTotalLength = 0;
-    for (int i = 1; i < taskCmd->argc; i++) {
-        targetParamTotalLength += strlen(taskCmd->argv[i]) + 1;
-    }
     const size_t totalLength = cmdParamLength + userParamLength + groupParamFixedPartLength + groupParamVarPartLength
 #ifdef ENABLE_CAPABILITIES
                                + capParamLength
@@ -309,7 +554,7 @@ int crinitCreateLauncherParameters(crinitTaskCmd_t *taskCmd, crinitTask_t *tCopy
 #ifdef ENABLE_CGROUP
                                + cgroupParamLength
 #endif
-                               + doubleDashLength + targetParamTotalLength;
+                               + schedParamsTotalLength + doubleDashLength;
 
     char *argBuf = NULL;
     char **av = NULL;
@@ -327,6 +572,7 @@ int crinitCreateLauncherParameters(crinitTaskCmd_t *taskCmd, crinitTask_t *tCopy
 #ifdef ENABLE_CGROUP
     launcherParamCount++;
 #endif
+    launcherParamCount += schedParamCount;
     av = calloc(launcherParamCount + taskCmd->argc, sizeof(*av));
     if (av == NULL) {
         crinitErrnoPrint("Failed to allocate memory for temporary argv to use with command launcher.\n");
@@ -377,13 +623,18 @@ int crinitCreateLauncherParameters(crinitTaskCmd_t *taskCmd, crinitTask_t *tCopy
     }
 #endif
 
+    for (crinitSchedParam_t param = 0; param < CRINIT_SCHED_PARAMS_COUNT; param++) {
+        if (schedParamLength[param] > 0) {
+            av[argBufIdx++] = argBufCurr;
+            crinitSchedParamsLauncherOpt(argBufCurr, schedParamLength[param] + 1, &tCopy->sched, param);
+            argBufCurr += schedParamLength[param] + 1;
+        }
+    }
+
     av[argBufIdx++] = argBufCurr;
     memcpy(argBufCurr, delimiterEndOfOptionsStr, doubleDashLength);
     argBufCurr += doubleDashLength;
 
-    memcpy(argBufCurr, taskCmd->argv, targetParamTotalLength);
-    argBufCurr += targetParamTotalLength;
-
     for (int argvIdx = argBufIdx, count = 1; count < taskCmd->argc; count++, argvIdx++) {
         av[argvIdx] = taskCmd->argv[count];
     }
@@ -393,450 +644,531 @@ int crinitCreateLauncherParameters(crinitTaskCmd_t *taskCmd, crinitTask_t *tCopy
     return 0;
 }
 
-int crinitHandleCommands(crinitTaskDB_t *ctx, pid_t threadId, char *name, crinitTaskCmd_t *cmds, size_t cmdsSize,
-                         crinitTask_t *tCopy, pid_t *pid, bool deactivateFileactions) {
-    char *cmd = NULL;
-    char **argv = NULL;
-    char *argvBuffer = NULL;
-    bool useLauncher = false;
-
-    char *crinitLauncherCommand = NULL;
-    if (crinitGlobOptGet(CRINIT_GLOBOPT_LAUNCHER_CMD, &crinitLauncherCommand) != 0) {
-        crinitErrPrint("Could not retrieve value for global setting LAUNCHER_CMD.");
-        return -1;
+static int crinitDispatchSpawnCommand(crinitDispThrArgs_t *a, pid_t threadId) {
+    crinitTask_t *t = a->t;
+    const char *name = t->name;
+    size_t i = a->cmdIdx;
+    crinitSpawnPlan_t *plan = a->plan;
+    const crinitSpawnPlanCmd_t *pc = &plan->cmds[i];
+
+    if (i == 0) {
+        // Time spent in the dispatch queue and preparing the task.
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        crinitDbgInfoPrint("(TID: %d) Task \'%s\' is spawned %lld us after it was ready.", threadId, name,
+                           (long long)(now.tv_sec - a->readyTime.tv_sec) * 1000000LL +
+                               (now.tv_nsec - a->readyTime.tv_nsec) / 1000);
     }
 
-    if (tCopy->user != 0 || tCopy->group != 0
-#ifdef ENABLE_CGROUP
-        || tCopy->cgroup != NULL
-#endif
-    ) {
-        cmd = crinitLauncherCommand;
-        useLauncher = true;
+    const crinitIoRedir_t *redirs = plan->useFileact ? t->redirs : NULL;
+    size_t redirsSize = plan->useFileact ? t->redirsSize : 0;
+    posix_spawn_file_actions_t *fileact = plan->useFileact ? &plan->fileact : NULL;
+    if (a->readyFd[1] != -1) {
+        redirs = a->readyRedirs;
+        redirsSize = t->redirsSize + 1;
+        fileact = &a->readyFileact;
     }
 
-#ifdef ENABLE_CGROUP
-    if (tCopy->cgroup) {
-        if (crinitCGroupConfigure(tCopy->cgroup) != 0) {
-            crinitErrPrint("Failed to configure task cgroup '%s'.", tCopy->cgroup->name);
+    // Only use crinit-launch if the kernel does not allow the direct spawn.
+    bool spawned = false;
+    if (pc->direct) {
+        if (crinitProcSpawn(&a->pid, a->cmds[i].argv[0], a->cmds[i].argv, t->taskEnv.envp, redirs, redirsSize,
+                            &plan->creds) == 0) {
+            spawned = true;
+        } else if (errno != ENOSYS) {
+            crinitErrPrint("(TID: %d) Could not spawn new process for command %zu of Task \'%s\'", threadId, i, name);
+            a->pid = -1;
             return -1;
         }
     }
-#endif
 
-    for (size_t i = 0; i < cmdsSize; i++) {
-        posix_spawn_file_actions_t fileact;
-        errno = posix_spawn_file_actions_init(&fileact);
-        if (errno != 0) {
-            crinitErrnoPrint("(TID: %d) Could not initialize posix_spawn file actions for command %zu of Task '%s'",
-                             threadId, i, name);
-            posix_spawn_file_actions_destroy(&fileact);
-            free(crinitLauncherCommand);
-            return -1;
-        }
+    if (!spawned &&
+        crinitSpawnSingleCommand(pc->path, pc->argv, t->taskEnv.envp, fileact, name, i, threadId, &a->pid) == -1) {
+        a->pid = -1;
+        return -1;
+    }
 
-        if (crinitPrepareIoRedirectionsForSpawn(i, tCopy->redirs, tCopy->redirsSize, threadId, tCopy->name, &fileact) ==
-            -1) {
-            posix_spawn_file_actions_destroy(&fileact);
-            free(crinitLauncherCommand);
-            return -1;
-        }
+    crinitInfoPrint("(TID: %d) Started new process %d for command %zu of Task \'%s\' (\'%s\').", threadId, a->pid, i,
+                    name, a->cmds[i].argv[0]);
 
-        if (!useLauncher) {
-            cmd = cmds[i].argv[0];
-            argv = cmds[i].argv;
-        } else {
-            if (crinitCreateLauncherParameters(&(cmds[i]), tCopy, cmd, &argv, &argvBuffer) != 0) {
-                crinitErrPrint("Failed to create launcher parameters.\n");
-                posix_spawn_file_actions_destroy(&fileact);
-                free(crinitLauncherCommand);
-                free(argvBuffer);
-                free(argv);
-                return -1;
-            }
-        }
+    if (crinitTaskDBSetTaskPID(a->ctx, a->pid, name) == -1) {
+        crinitErrPrint("(TID: %d) Could not set PID of Task \'%s\' to %d.", threadId, name, a->pid);
+        return -1;
+    }
 
-        if (crinitSpawnSingleCommand(cmd, argv, tCopy->taskEnv.envp, deactivateFileactions == true ? NULL : &fileact,
-                                     name, i, threadId, pid) == -1) {
-            posix_spawn_file_actions_destroy(&fileact);
-            if (useLauncher) {
-                free(argvBuffer);
-                free(argv);
-                argvBuffer = NULL;
-                argv = NULL;
-            }
-            free(crinitLauncherCommand);
+    if (i == 0) {
+        if (crinitTaskDBSetTaskState(a->ctx, CRINIT_TASK_STATE_RUNNING, name) == -1) {
+            crinitErrPrint("(TID: %d) Could not set state of Task \'%s\' to running.", threadId, name);
             return -1;
         }
-        if (!useLauncher) {
-            cmd = NULL;
-        } else {
-            free(argvBuffer);
-            free(argv);
-            argvBuffer = NULL;
-            argv = NULL;
+        crinitTaskDep_t spawnDep = {name, CRINIT_TASK_EVENT_RUNNING};
+        if (crinitTaskDBFulfillDep(a->ctx, &spawnDep, NULL) == -1) {
+            crinitErrPrint("(TID: %d) Could not fulfill dependency %s:%s.", threadId, spawnDep.name, spawnDep.event);
+            return -1;
         }
-        posix_spawn_file_actions_destroy(&fileact);
-
-        crinitInfoPrint("(TID: %d) Started new process %d for command %zu of Task \'%s\' (\'%s\').", threadId, *pid, i,
-                        name, cmds[i].argv[0]);
+        crinitDbgInfoPrint("(TID: %d) Dependency \'%s:%s\' fulfilled.", threadId, spawnDep.name, spawnDep.event);
 
-        if (crinitTaskDBSetTaskPID(ctx, *pid, name) == -1) {
-            crinitErrPrint("(TID: %d) Could not set PID of Task \'%s\' to %d.", threadId, name, *pid);
-            free(crinitLauncherCommand);
-            return -1;
+        if (crinitTaskDBProvideFeature(a->ctx, t, CRINIT_TASK_STATE_RUNNING) == -1) {
+            crinitErrPrint("(TID: %d) Could not fulfill provided features of spawned task \'%s\'.", threadId, name);
         }
+        crinitDbgInfoPrint("(TID: %d) Features of spawned task \'%s\' fulfilled.", threadId, name);
+    }
+    return 0;
+}
 
-        if (i == 0) {
-            if (crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_RUNNING, name) == -1) {
-                crinitErrPrint("(TID: %d) Could not set state of Task \'%s\' to running.", threadId, name);
-                return -1;
-            }
-            crinitTaskDep_t spawnDep = {name, CRINIT_TASK_EVENT_RUNNING};
-            if (crinitTaskDBFulfillDep(ctx, &spawnDep, NULL) == -1) {
-                crinitErrPrint("(TID: %d) Could not fulfill dependency %s:%s.", threadId, spawnDep.name,
-                               spawnDep.event);
-                free(crinitLauncherCommand);
-                return -1;
-            }
-            crinitDbgInfoPrint("(TID: %d) Dependency \'%s:%s\' fulfilled.", threadId, spawnDep.name, spawnDep.event);
+#ifdef ENABLE_CAPABILITIES
+static int crinitCalcTaskCapabilities(const crinitTask_t *t, uint64_t *caps) {
+    char *defaultCaps = NULL;
+    if (crinitGlobOptGet(CRINIT_GLOBOPT_DEFAULTCAPS, &defaultCaps) == -1) {
+        defaultCaps = strdup(CRINIT_CONFIG_DEFAULT_DEFAULTCAPS);
+        crinitErrPrint("Could not retrieve global default capabilities. Will use %s", defaultCaps);
+    }
 
-            if (crinitTaskDBProvideFeature(ctx, tCopy, CRINIT_TASK_STATE_RUNNING) == -1) {
-                crinitErrPrint("(TID: %d) Could not fulfill provided features of spawned task \'%s\'.", threadId, name);
-            }
-            crinitDbgInfoPrint("(TID: %d) Features of spawned task \'%s\' fulfilled.", threadId, name);
-        }
+    uint64_t defaultCapsMask = 0;
+    if (crinitCapConvertToBitmask(&defaultCapsMask, defaultCaps) != 0) {
+        free(defaultCaps);
+        return -1;
+    }
+    free(defaultCaps);
+    crinitDbgInfoPrint("Default capabilities: %#lx", defaultCapsMask);
 
-        int wret;
-        siginfo_t status;
-        // Check if process has exited, but leave zombie.
-        do {
-            wret = waitid(P_PID, *pid, &status, WEXITED | WNOWAIT);
-        } while (wret != 0 && errno == EINTR);
+    *caps = defaultCapsMask & ~t->capabilitiesClear;
+    *caps |= t->capabilitiesSet;
+    crinitInfoPrint("(Task %s) Calculated effective capabilities: %#lx", t->name, *caps);
+    return 0;
+}
+#endif
 
-        if (wret != 0 || status.si_code != CLD_EXITED || status.si_status != 0) {
-            // There was some error, either Crinit-internal or the task returned an error code or the task was killed.
-            if (errno) {
-                crinitErrnoPrint("(TID: %d) Failed to wait for Task \'%s\' (PID %d).", threadId, name, *pid);
-                return -1;
-            } else if (status.si_code == CLD_EXITED) {
-                crinitInfoPrint("(TID: %d) Task \'%s\' (PID %d) returned error code %d.", threadId, name, *pid,
-                                status.si_status);
-            } else {
-                crinitInfoPrint("(TID: %d) Task \'%s\' (PID %d) failed.", threadId, name, *pid);
+static crinitSpawnPlan_t *crinitSpawnPlanCreate(crinitTask_t *t, crinitTaskCmd_t *cmds, size_t cmdsSize,
+                                                bool useIoRedirs) {
+    // Read the generation first so that a concurrent change of the global options invalidates the plan.
+    unsigned long long globOptGen = crinitGlobOptGetGeneration();
+    crinitSpawnPlan_t *plan = calloc(1, sizeof(*plan) + cmdsSize * sizeof(*plan->cmds));
+    if (plan == NULL) {
+        crinitErrnoPrint("Could not allocate memory for spawn plan of Task \'%s\'.", t->name);
+        return NULL;
+    }
+    atomic_init(&plan->hdr.refs, 1);
+    plan->hdr.destroy = crinitSpawnPlanDestroy;
+    plan->globOptGen = globOptGen;
+    plan->creds.cgroupFd = -1;
+    plan->cmdsSize = cmdsSize;
+
+    if (useIoRedirs) {
+        if (posix_spawn_file_actions_init(&plan->fileact) != 0) {
+            crinitErrPrint("Could not initialize posix_spawn file actions for Task \'%s\'.", t->name);
+            free(plan);
+            return NULL;
+        }
+        plan->useFileact = true;
+        for (size_t j = 0; j < t->redirsSize; j++) {
+            // NOTE: We currently have a umask of 0022 which precludes us from creating files with 0666 permissions.
+            //       We may want to make that configurable in the future.
+            if (t->redirs[j].fifo && crinitEnsureFifo(t->redirs[j].path, t->redirs[j].mode) == -1) {
+                crinitErrPrint("Unexpected result while ensuring '%s' is a FIFO special file for Task '%s'",
+                               t->redirs[j].path, t->name);
+                crinitSpawnPlanDestroy(&plan->hdr);
+                return NULL;
+            }
+            if (crinitPosixSpawnAddIOFileAction(&plan->fileact, &t->redirs[j]) == -1) {
+                crinitErrPrint("Could not add IO file action to posix_spawn for Task '%s'", t->name);
+                crinitSpawnPlanDestroy(&plan->hdr);
+                return NULL;
             }
-            free(crinitLauncherCommand);
-            return -1;
         }
+    }
 
-        // command of task has returned successfully
-        if (crinitTaskDBSetTaskPID(ctx, -1, name) == -1) {
-            crinitErrPrint("(TID: %d) Could not reset PID of Task \'%s\' to -1.", threadId, name);
-        }
-        // Reap zombie of successful command.
-        if (crinitReapPid(*pid) == -1) {
-            crinitErrnoPrint("(TID: %d) Could not reap zombie for task \'%s\'.", threadId, name);
+    // There is no posix_spawn() attribute for most of the scheduling parameters, so they need the same path as
+    // changed credentials.
+    bool useCreds = t->user != 0 || t->group != 0 || t->sched.flags != 0;
+#ifdef ENABLE_CGROUP
+    useCreds = useCreds || t->cgroup != NULL;
+#endif
+    if (!useCreds) {
+        for (size_t i = 0; i < cmdsSize; i++) {
+            plan->cmds[i].path = cmds[i].argv[0];
+            plan->cmds[i].argv = cmds[i].argv;
         }
+        return plan;
     }
 
-    free(crinitLauncherCommand);
-    return 0;
-}
+    if (crinitGlobOptGet(CRINIT_GLOBOPT_LAUNCHER_CMD, &plan->launcherCmd) == -1) {
+        crinitErrPrint("Could not retrieve path to crinit-launch for Task \'%s\'.", t->name);
+        crinitSpawnPlanDestroy(&plan->hdr);
+        return NULL;
+    }
 
-int crinitExpandPIDVariablesInSingleCommand(char *input, const pid_t pid, char **result) {
-    crinitTokenType_t tt;
-    char *substKey = NULL;
-    char *substVal = NULL;
-    const char *src = input;
-    const char *s = input;
-    const char *mbegin = NULL;
-    const char *mend = NULL;
-
-    const int substValLen = snprintf(NULL, 0, "%d", pid);
-    substVal = (char *)calloc(substValLen + 1, sizeof(char));
-    if (!substVal) {
-        crinitErrnoPrint("Couldn't write PID into temporary string.\n");
-        return -1;
+    plan->creds.user = t->user;
+    plan->creds.group = t->group;
+    plan->creds.supGroups = t->supGroups;
+    plan->creds.supGroupsSize = t->supGroupsSize;
+    plan->creds.sched = (t->sched.flags != 0) ? &t->sched : NULL;
+#ifdef ENABLE_CAPABILITIES
+    plan->creds.setCaps = true;
+    if (crinitCalcTaskCapabilities(t, &plan->creds.caps) == -1) {
+        crinitErrPrint("Could not calculate capabilities of Task \'%s\'.", t->name);
+        crinitSpawnPlanDestroy(&plan->hdr);
+        return NULL;
     }
-    snprintf(substVal, substValLen + 1, "%d", pid);
-    if (*result != NULL) {
-        crinitErrnoPrint("Expecting result pointer to be NULL.\n");
-        free(substVal);
-        return -1;
+#endif
+#ifdef ENABLE_CGROUP
+    if (t->cgroup != NULL) {
+        plan->creds.cgroupFd = crinitCGroupOpenDir(t->cgroup);
+        if (plan->creds.cgroupFd == -1) {
+            crinitErrPrint("Could not open cgroup of Task \'%s\'.", t->name);
+            crinitSpawnPlanDestroy(&plan->hdr);
+            return NULL;
+        }
     }
+#endif
 
-    do {
-        tt = crinitEnvVarInnerLex(&s, &mbegin, &mend);
-        switch (tt) {
-            case CRINIT_TK_ERR:
-                crinitErrPrint("Error while parsing string at '%.*s'\n", (int)(mend - mbegin), mbegin);
-                break;
-            case CRINIT_TK_VAR:
-                substKey = strndup(mbegin, (size_t)(mend - mbegin));
-                if (substKey == NULL) {
-                    crinitErrnoPrint("Could not duplicate key of environment variable to expand.");
-                    tt = CRINIT_TK_ERR;
-                    break;
-                }
-                if (strcmp(substKey, "TASK_PID") == 0) {
-                    free(substKey);
-                    char *tmp = NULL;
-                    tmp = calloc((int)(mend - src) + substValLen + 1, sizeof(char));
-                    if (!tmp) {
-                        crinitErrPrint("Error allocating memory for result string.\n");
-                        tt = CRINIT_TK_ERR;
-                        break;
-                    }
-                    sprintf(tmp, "%.*s%s", (int)(mbegin - 2 - src), src,
-                            substVal);  // Substitute 2 to get rid of '${' directly before the variable name.
-                    if (*result) {
-                        char *tmp2 = NULL;
-                        tmp2 = calloc(strlen(*result) + strlen(tmp) + 1, sizeof(char));
-                        if (!tmp2) {
-                            crinitErrPrint("Error allocating memory for result string.\n");
-                            tt = CRINIT_TK_ERR;
-                            free(tmp);
-                            break;
-                        }
-                        strcat(tmp2, *result);
-                        strcat(tmp2, tmp);
-                        free(*result);
-                        free(tmp);
-                        *result = tmp2;
-                    } else {
-                        free(*result);
-                        *result = tmp;
-                    }
-                    src = mend + 1;
-                } else {
-                    free(substKey);
-                }
-                break;
-            case CRINIT_TK_END:
-            case CRINIT_TK_CPY:
-                // Intentionally do nothing.
-                break;
-            case CRINIT_TK_ESC:
-            case CRINIT_TK_ESCX:
-            case CRINIT_TK_WSPC:
-            case CRINIT_TK_ENVKEY:
-            case CRINIT_TK_ENVVAL:
-            case CRINIT_TK_UQSTR:
-            case CRINIT_TK_DQSTR:
-            default:
-                crinitErrPrint("Parser error at '%.*s'\n", (int)(mend - mbegin), mbegin);
-                tt = CRINIT_TK_ERR;
-                break;
-        }
-    } while (tt != CRINIT_TK_END && tt != CRINIT_TK_ERR);
-
-    free(substVal);
-
-    if (tt == CRINIT_TK_END && *result) {
-        char *tmp = NULL;
-        tmp = (char *)calloc(strlen(*result) + strlen(src) + 1, sizeof(char));
-        if (!tmp) {
-            crinitErrPrint("Error allocating memory for result string.\n");
-            tt = CRINIT_TK_ERR;
-            free(*result);
-            return -1;
+    for (size_t i = 0; i < cmdsSize; i++) {
+        crinitSpawnPlanCmd_t *pc = &plan->cmds[i];
+        if (crinitCreateLauncherParameters(&cmds[i], t, plan->launcherCmd, &pc->argv, &pc->argvBuffer) == -1) {
+            crinitErrPrint("Could not create crinit-launch parameters for command %zu of Task \'%s\'.", i, t->name);
+            crinitSpawnPlanDestroy(&plan->hdr);
+            return NULL;
         }
-        strcat(tmp, *result);
-        strcat(tmp, src);
-        free(*result);
-        *result = tmp;
-        return 1;
-    } else if (tt == CRINIT_TK_ERR) {
-        free(*result);
-        return -1;
+        pc->path = plan->launcherCmd;
+        // The launcher searches PATH for commands without a slash, so keep using it for these.
+        pc->direct = strchr(cmds[i].argv[0], '/') != NULL;
     }
+    return plan;
+}
 
-    return 0;
+static void crinitSpawnPlanDestroy(crinitSpawnPlanHdr_t *hdr) {
+    crinitSpawnPlan_t *plan = (crinitSpawnPlan_t *)hdr;
+    if (plan->launcherCmd != NULL) {
+        for (size_t i = 0; i < plan->cmdsSize; i++) {
+            free(plan->cmds[i].argvBuffer);
+            free(plan->cmds[i].argv);
+        }
+        free(plan->launcherCmd);
+    }
+    if (plan->useFileact) {
+        posix_spawn_file_actions_destroy(&plan->fileact);
+    }
+    if (plan->creds.cgroupFd != -1) {
+        close(plan->creds.cgroupFd);
+    }
+    free(plan);
 }
 
-/**
- * @brief Expands variable ${TASK_PID} in a command with the task's PID.
- *
- * Please note that this makes only sense for a STOP_COMMAND.
- * Currently this is the only variable that can be expanded here.
- *
- * @param commands Pointer to task command structure
- * @param cmdsSize Number of elements in commands
- * @param pid PID of task
- */
-void crinitExpandPIDVariablesInCommands(crinitTaskCmd_t *commands, size_t cmdsSize, const pid_t pid) {
-    for (size_t i = 0; i < cmdsSize; i++) {
-        if (commands[i].argc > 0) {
-            char *origArgvBackbufEnd = strchr(commands[i].argv[commands[i].argc - 1], '\0');
-            size_t argvBackbufLen = origArgvBackbufEnd - commands[i].argv[0] + 1;
-            argvBackbufLen *= 2;
-            size_t bytesUsed = 0;
-
-            char *argvBackbuf = malloc(argvBackbufLen);
-            if (argvBackbuf == NULL) {
-                crinitErrnoPrint("Could not allocate memory for argv STOP_COMMAND variable expansion.\n");
-                return;
-            }
+crinitSpawnPlan_t *crinitSpawnPlanGet(crinitTaskCfg_t *cfg) {
+    crinitSpawnPlan_t *plan = NULL;
+    crinitSpawnPlan_t *stale = NULL;
 
-            char *oldArgvBuf = commands[i].argv[0];
-            size_t *offsets = calloc(commands[i].argc, sizeof(size_t));
-            for (int j = 0; j < commands[i].argc; j++) {
-                char *result = NULL;
-                if (crinitExpandPIDVariablesInSingleCommand(commands[i].argv[j], pid, &result) == -1) {
-                    crinitErrnoPrint("Could not allocate memory for argv STOP_COMMAND variable expansion.\n");
-                    free(argvBackbuf);
-                    free(offsets);
-                    return;
-                } else {
-                    char *tmpResult = commands[i].argv[j];
-                    if (result) {
-                        tmpResult = result;
-                    }
-                    const size_t resultLen = strlen(tmpResult) + 1;
-                    if (bytesUsed + resultLen > argvBackbufLen) {
-                        char *tmp = realloc(argvBackbuf, bytesUsed + resultLen);
-                        if (tmp == NULL) {
-                            free(result);
-                            free(argvBackbuf);
-                            free(offsets);
-                            return;
-                        }
-                        argvBackbuf = tmp;
-                        argvBackbufLen = bytesUsed + resultLen;
-                    }
-                    memcpy(argvBackbuf + bytesUsed, tmpResult, resultLen);
-                    offsets[j] = bytesUsed;
-                    bytesUsed += resultLen;
-                    free(result);
-                }
-            }
+    pthread_mutex_lock(&crinitSpawnPlanLock);
+    plan = (crinitSpawnPlan_t *)cfg->spawnPlan;
+    if (plan != NULL && plan->globOptGen == crinitGlobOptGetGeneration()) {
+        atomic_fetch_add_explicit(&plan->hdr.refs, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&crinitSpawnPlanLock);
+        return plan;
+    }
+    pthread_mutex_unlock(&crinitSpawnPlanLock);
 
-            if (argvBackbufLen > bytesUsed) {
-                argvBackbuf = realloc(argvBackbuf, bytesUsed);
-            }
-            free(oldArgvBuf);
-            for (int j = 0; j < commands[i].argc; j++) {
-                commands[i].argv[j] = argvBackbuf + offsets[j];
-            }
-            free(offsets);
-        }
+    // Building the plan may touch the file system, so do it without holding the lock.
+    plan = crinitSpawnPlanCreate(&cfg->task, cfg->task.cmds, cfg->task.cmdsSize, true);
+    if (plan == NULL) {
+        return NULL;
     }
-}
 
-static void *crinitDispatchThreadFunc(void *args) {
-    crinitDispThrArgs_t *a = (crinitDispThrArgs_t *)args;
-    crinitTaskDB_t *ctx = a->ctx;
-    const crinitTask_t *t = a->t;
-    crinitTask_t *tCopy = NULL;
-    pid_t threadId = crinitGettid();
-    pid_t pid = -1;
+    pthread_mutex_lock(&crinitSpawnPlanLock);
+    crinitSpawnPlan_t *cached = (crinitSpawnPlan_t *)cfg->spawnPlan;
+    if (cached != NULL && cached->globOptGen >= plan->globOptGen) {
+        // Another thread has been faster.
+        stale = plan;
+        plan = cached;
+    } else {
+        stale = cached;
+        cfg->spawnPlan = &plan->hdr;
+    }
+    atomic_fetch_add_explicit(&plan->hdr.refs, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&crinitSpawnPlanLock);
+
+    if (stale != NULL) {
+        crinitSpawnPlanRelease(&stale->hdr);
+    }
+    return plan;
+}
 
-    crinitDbgInfoPrint("(TID: %d) New thread started.", threadId);
+static void crinitDispatchInit(void) {
+    unsigned long long workers = CRINIT_CONFIG_DEFAULT_DISPATCH_WORKERS;
+    if (crinitGlobOptGet(CRINIT_GLOBOPT_DISPATCH_WORKERS, &workers) == -1) {
+        crinitErrPrint("Could not retrieve value for global setting %s. Will use %llu.",
+                       CRINIT_CONFIG_KEYSTR_DISPATCH_WORKERS, workers);
+    }
+    unsigned long long depth = CRINIT_CONFIG_DEFAULT_DISPATCH_QUEUE_DEPTH;
+    if (crinitGlobOptGet(CRINIT_GLOBOPT_DISPATCH_QUEUE_DEPTH, &depth) == -1) {
+        crinitErrPrint("Could not retrieve value for global setting %s. Will use %llu.",
+                       CRINIT_CONFIG_KEYSTR_DISPATCH_QUEUE_DEPTH, depth);
+    }
 
-    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
-        crinitErrnoPrint("(TID: %d) Could not queue up for mutex lock.", threadId);
-        goto threadExit;
+    if (crinitDispatchQueueInit(&crinitDispQueue, depth) == -1) {
+        crinitDispInitErr = (errno != 0) ? errno : EINVAL;
+        crinitErrPrint("Could not set up dispatch queue of depth %llu.", depth);
+        return;
     }
 
-    if (crinitTaskDup(&tCopy, t) == -1) {
-        crinitErrPrint("(TID: %d) Could not get duplicate of Task to spawn.", threadId);
-        pthread_mutex_unlock(&ctx->lock);
-        goto threadExit;
+    crinitDispWorkerArgs_t wa = {&crinitDispQueue};
+    if (crinitThreadPoolInit(&crinitDispWorkers, workers, crinitDispatchWorkerFunc, &wa, sizeof(wa)) == -1) {
+        crinitDispInitErr = (errno != 0) ? errno : EAGAIN;
+        crinitErrPrint("Could not start dispatch worker threads.");
+        return;
     }
+    crinitDbgInfoPrint("Process Dispatcher started with %llu worker threads and a queue depth of %llu.", workers,
+                       depth);
+}
+
+static void *crinitDispatchWorkerFunc(void *args) {
+    crinitDispWorkerArgs_t *wa = args;
+    crinitDispatchQueue_t *q = wa->queue;
+    pid_t threadId = crinitGettid();
 
-    pthread_mutex_unlock(&ctx->lock);
+    crinitDbgInfoPrint("(TID: %d) Dispatch worker thread ready.", threadId);
+    while (true) {
+        bool wasFull = false;
+        crinitDispThrArgs_t *a = crinitDispatchQueuePop(q, &wasFull);
+        // crinitProcDispatchSpawnFunc() may have rejected a task in the meantime, which then waits in the ready queue
+        // of the TaskDB for the next change.
+        if (wasFull && crinitTaskDBDispatchSpaceFreed(a->ctx) == -1) {
+            crinitErrPrint("(TID: %d) Could not notify TaskDB about free space in the dispatch queue.", threadId);
+        }
 
-    if (crinitEnvSetSet(&tCopy->taskEnv, CRINIT_ENV_NOTIFY_NAME, tCopy->name) == -1) {
-        crinitErrPrint("Could not set notification environment variable for task \'%s\'", tCopy->name);
-        goto threadExitFail;
+        crinitDispatchTask(a);
     }
+    return NULL;
+}
 
-    crinitDbgInfoPrint("(TID: %d) Will spawn Task \'%s\'.", threadId, tCopy->name);
+static void crinitDispatchTask(crinitDispThrArgs_t *a) {
+    pid_t threadId = crinitGettid();
 
-    crinitTaskCmd_t *cmds = NULL;
-    size_t cmdsSize = 0;
     switch (a->mode) {
         case CRINIT_DISPATCH_THREAD_MODE_START:
-            cmds = tCopy->cmds;
-            cmdsSize = tCopy->cmdsSize;
+            a->cmds = a->t->cmds;
+            a->cmdsSize = a->t->cmdsSize;
             break;
-        case CRINIT_DISPATCH_THREAD_MODE_STOP:
-            cmds = tCopy->stopCmds;
-            cmdsSize = tCopy->stopCmdsSize;
-            crinitExpandPIDVariablesInCommands(cmds, cmdsSize, tCopy->pid);
+        case CRINIT_DISPATCH_THREAD_MODE_STOP: {
+            // The PID and exit status in the snapshot are out of date, the current ones are in the TaskDB.
+            crinitCmdVarVals_t vals = {a->t->name, -1, -1};
+            if (crinitTaskDBGetTaskPID(a->ctx, &vals.pid, a->t->name) == -1 ||
+                crinitTaskDBGetTaskExitStatus(a->ctx, &vals.exitStatus, a->t->name) == -1) {
+                crinitErrPrint("(TID: %d) Could not get PID and exit status of Task to stop.", threadId);
+                crinitDispatchRelease(a);
+                return;
+            }
+            if (crinitDispatchExpandStopCmds(a, &vals) == -1) {
+                crinitErrPrint("(TID: %d) Could not expand variables in STOP_COMMANDs of Task \'%s\'.", threadId,
+                               a->t->name);
+                crinitDispatchRelease(a);
+                return;
+            }
             break;
+        }
         default:
             crinitErrPrint("Invalid mode for dispatch thread work mode received");
-            goto threadExitFail;
+            crinitDispatchFinish(a, false);
+            return;
     }
 
-    // Do not execute IO redirections for STOP_COMMANDS for now.
-    if (crinitHandleCommands(ctx, threadId, tCopy->name, cmds, cmdsSize, tCopy, &pid,
-                             a->mode == CRINIT_DISPATCH_THREAD_MODE_STOP ? true : false) != 0) {
-        goto threadExitFail;
+    crinitDbgInfoPrint("(TID: %d) Will spawn Task \'%s\'.", threadId, a->t->name);
+
+#ifdef ENABLE_CGROUP
+    if (a->t->cgroup) {
+        // The task may be shared with other dispatch threads, so use a private handle to the cgroup.
+        crinitCgroup_t cgroup = *a->t->cgroup;
+        if (crinitCGroupConfigure(&cgroup) != 0) {
+            crinitErrPrint("Failed to configure task cgroup '%s'.", a->t->cgroup->name);
+            crinitDispatchFinish(a, false);
+            return;
+        }
     }
+#endif
 
-    // chain of commands is done successfully
-    crinitInfoPrint("(TID: %d) Task \'%s\' done.", threadId, tCopy->name);
-    if (crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_DONE, tCopy->name) == -1) {
-        crinitErrPrint("(TID: %d) Could not set state of Task \'%s\' to done.", threadId, tCopy->name);
+    if (a->mode == CRINIT_DISPATCH_THREAD_MODE_START) {
+        a->plan = crinitSpawnPlanGet(a->cfg);
+    } else {
+        // Do not execute IO redirections for STOP_COMMANDS for now. The commands have just been expanded, so their plan
+        // cannot be reused.
+        a->plan = crinitSpawnPlanCreate(a->t, a->cmds, a->cmdsSize, false);
+    }
+    if (a->plan == NULL) {
+        crinitErrPrint("(TID: %d) Could not prepare spawning of Task \'%s\'.", threadId, a->t->name);
+        crinitDispatchFinish(a, false);
+        return;
     }
-    crinitTaskDep_t doneDep = {tCopy->name, CRINIT_TASK_EVENT_DONE};
-    if (crinitTaskDBFulfillDep(ctx, &doneDep, NULL) == -1) {
-        crinitErrPrint("(TID: %d) Could not fulfill dependency %s:%s.", threadId, doneDep.name, doneDep.event);
+    if (a->mode == CRINIT_DISPATCH_THREAD_MODE_START && (a->t->opts & CRINIT_TASK_OPT_READY_FD) &&
+        crinitDispatchReadyFdOpen(a) == -1) {
+        crinitErrPrint("(TID: %d) Could not create readiness pipe for Task \'%s\'.", threadId, a->t->name);
+        crinitDispatchFinish(a, false);
+        return;
     }
-    crinitDbgInfoPrint("(TID: %d) Dependency \'%s:%s\' fulfilled.", threadId, doneDep.name, doneDep.event);
 
-    if (crinitTaskDBProvideFeature(ctx, tCopy, CRINIT_TASK_STATE_DONE) == -1) {
-        crinitErrPrint("(TID: %d) Could not fulfill provided features of finished task \'%s\'.", threadId, tCopy->name);
+    crinitDispatchRunCommand(a);
+}
+
+static void crinitDispatchRunCommand(crinitDispThrArgs_t *a) {
+    pid_t threadId = crinitGettid();
+
+    if (a->cmdIdx >= a->cmdsSize) {
+        crinitDispatchFinish(a, true);
+        return;
+    }
+    if (crinitDispatchSpawnCommand(a, threadId) == -1) {
+        crinitDispatchFinish(a, false);
+        return;
     }
-    crinitDbgInfoPrint("(TID: %d) Features of finished task \'%s\' fulfilled.", threadId, tCopy->name);
 
-    goto threadExit;
+    if (crinitProcSupWatch(a->pid, crinitDispatchCommandExited, a) == 0) {
+        return;
+    }
+    if (errno != ENOSYS) {
+        crinitErrPrint("(TID: %d) Could not hand over process %d of Task \'%s\' to Process Supervisor.", threadId,
+                       a->pid, a->t->name);
+        crinitDispatchFinish(a, false);
+        return;
+    }
 
-threadExitFail:
-    if (crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_FAILED, tCopy->name) == -1) {
-        crinitErrPrint("(TID: %d) Could not set state of Task \'%s\' to failed.", threadId, tCopy->name);
+    // No pidfd support, so wait for the process here but leave the zombie. The worker thread is blocked until then, so
+    // let the thread pool grow if this happens to too many of them.
+    int wret;
+    siginfo_t status = {0};
+    crinitThreadPoolThreadBusyCallback(&crinitDispWorkers);
+    do {
+        wret = waitid(P_PID, a->pid, &status, WEXITED | WNOWAIT);
+    } while (wret != 0 && errno == EINTR);
+    int waitErr = errno;
+    crinitThreadPoolThreadAvailCallback(&crinitDispWorkers);
+    if (wret != 0) {
+        errno = waitErr;
+        crinitErrnoPrint("(TID: %d) Failed to wait for Task \'%s\' (PID %d).", threadId, a->t->name, a->pid);
     }
-    if (crinitTaskDBSetTaskPID(ctx, -1, tCopy->name) == -1) {
-        crinitErrPrint("(TID: %d) Could not reset PID of failed Task \'%s\' to -1.", threadId, tCopy->name);
+    crinitDispatchCommandExited(a->pid, (wret == 0) ? &status : NULL, a);
+}
+
+static void crinitDispatchCommandExited(pid_t pid, const siginfo_t *status, void *args) {
+    crinitDispThrArgs_t *a = args;
+    pid_t threadId = crinitGettid();
+    const char *name = a->t->name;
+
+    // Only processes of the task itself count, not those of its STOP_COMMANDs.
+    if (status != NULL && a->mode == CRINIT_DISPATCH_THREAD_MODE_START) {
+        int exitStatus = (status->si_code == CLD_EXITED) ? status->si_status : 128 + status->si_status;
+        if (crinitTaskDBSetTaskExitStatus(a->ctx, exitStatus, name) == -1) {
+            crinitErrPrint("(TID: %d) Could not store exit status of Task \'%s\' (PID %d).", threadId, name, pid);
+        }
     }
-    // Reap zombie of failed command (if it was actually spawned).
-    if (pid > 0 && crinitReapPid(pid) == -1) {
-        crinitErrPrint("(TID: %d) Could not reap zombie for task \'%s\'.", threadId, tCopy->name);
+
+    if (status == NULL || status->si_code != CLD_EXITED || status->si_status != 0) {
+        // There was some error, either Crinit-internal or the task returned an error code or the task was killed.
+        if (status == NULL) {
+            crinitErrPrint("(TID: %d) Could not get exit status of Task \'%s\' (PID %d).", threadId, name, pid);
+        } else if (status->si_code == CLD_EXITED) {
+            crinitInfoPrint("(TID: %d) Task \'%s\' (PID %d) returned error code %d.", threadId, name, pid,
+                            status->si_status);
+        } else {
+            crinitInfoPrint("(TID: %d) Task \'%s\' (PID %d) failed.", threadId, name, pid);
+        }
+        crinitDispatchFinish(a, false);
+        return;
     }
 
-    crinitTaskDep_t failDep = {tCopy->name, CRINIT_TASK_EVENT_FAILED};
-    if (crinitTaskDBFulfillDep(ctx, &failDep, NULL) == -1) {
-        crinitErrPrint("(TID: %d) Could not fulfill dependency %s:%s.", threadId, failDep.name, failDep.event);
-    } else {
-        crinitDbgInfoPrint("(TID: %d) Dependency \'%s:%s\' fulfilled.", threadId, failDep.name, failDep.event);
+    // command of task has returned successfully
+    if (crinitTaskDBSetTaskPID(a->ctx, -1, name) == -1) {
+        crinitErrPrint("(TID: %d) Could not reset PID of Task \'%s\' to -1.", threadId, name);
     }
+    // Reap zombie of successful command.
+    crinitDispatchReap(a);
+    a->pid = -1;
+    a->cmdIdx++;
+    crinitDispatchRunCommand(a);
+}
 
-    if (crinitTaskDBProvideFeature(ctx, tCopy, CRINIT_TASK_STATE_FAILED) == -1) {
-        crinitErrPrint("(TID: %d) Could not fulfill provided features of failed task \'%s\'.", threadId, tCopy->name);
+static void crinitDispatchFinish(crinitDispThrArgs_t *a, bool success) {
+    crinitTaskDB_t *ctx = a->ctx;
+    crinitTask_t *t = a->t;
+    pid_t threadId = crinitGettid();
+
+    // Notifications sent right before the last command has ended must not override the final state.
+    crinitDispatchReadyFdClose(a);
+
+    if (success) {
+        // chain of commands is done successfully
+        crinitInfoPrint("(TID: %d) Task \'%s\' done.", threadId, t->name);
+        if (crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_DONE, t->name) == -1) {
+            crinitErrPrint("(TID: %d) Could not set state of Task \'%s\' to done.", threadId, t->name);
+        }
+        crinitTaskDep_t doneDep = {t->name, CRINIT_TASK_EVENT_DONE};
+        if (crinitTaskDBFulfillDep(ctx, &doneDep, NULL) == -1) {
+            crinitErrPrint("(TID: %d) Could not fulfill dependency %s:%s.", threadId, doneDep.name, doneDep.event);
+        }
+        crinitDbgInfoPrint("(TID: %d) Dependency \'%s:%s\' fulfilled.", threadId, doneDep.name, doneDep.event);
+
+        if (crinitTaskDBProvideFeature(ctx, t, CRINIT_TASK_STATE_DONE) == -1) {
+            crinitErrPrint("(TID: %d) Could not fulfill provided features of finished task \'%s\'.", threadId,
+                           t->name);
+        }
+        crinitDbgInfoPrint("(TID: %d) Features of finished task \'%s\' fulfilled.", threadId, t->name);
     } else {
-        crinitDbgInfoPrint("(TID: %d) Features of failed task \'%s\' fulfilled.", threadId, tCopy->name);
+        // Reap zombie of failed command (if it was actually spawned) before the failure becomes visible, so that its
+        // resource usage is already accounted for.
+        if (a->pid > 0) {
+            crinitDispatchReap(a);
+        }
+        if (crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_FAILED, t->name) == -1) {
+            crinitErrPrint("(TID: %d) Could not set state of Task \'%s\' to failed.", threadId, t->name);
+        }
+        if (crinitTaskDBSetTaskPID(ctx, -1, t->name) == -1) {
+            crinitErrPrint("(TID: %d) Could not reset PID of failed Task \'%s\' to -1.", threadId, t->name);
+        }
+
+        crinitTaskDep_t failDep = {t->name, CRINIT_TASK_EVENT_FAILED};
+        if (crinitTaskDBFulfillDep(ctx, &failDep, NULL) == -1) {
+            crinitErrPrint("(TID: %d) Could not fulfill dependency %s:%s.", threadId, failDep.name, failDep.event);
+        } else {
+            crinitDbgInfoPrint("(TID: %d) Dependency \'%s:%s\' fulfilled.", threadId, failDep.name, failDep.event);
+        }
+
+        if (crinitTaskDBProvideFeature(ctx, t, CRINIT_TASK_STATE_FAILED) == -1) {
+            crinitErrPrint("(TID: %d) Could not fulfill provided features of failed task \'%s\'.", threadId, t->name);
+        } else {
+            crinitDbgInfoPrint("(TID: %d) Features of failed task \'%s\' fulfilled.", threadId, t->name);
+        }
     }
 
-threadExit:
-    crinitDbgInfoPrint("(TID: %d) exiting thread for \'%s\'.", threadId, tCopy->name);
-    if (tCopy->opts & CRINIT_TASK_OPT_TRIGGER_REARM) {
+    crinitDispatchRelease(a);
+}
+
+static void crinitDispatchRelease(crinitDispThrArgs_t *a) {
+    crinitTask_t *t = a->t;
+    crinitDbgInfoPrint("(TID: %d) Done dispatching \'%s\'.", crinitGettid(), t->name);
+    if (t->opts & CRINIT_TASK_OPT_TRIGGER_REARM) {
         // NOTE:  all trigger sources that need reenabling/rearming (elos filter(?), timer(?), ..)
         // should be reenable/rearmed here
-        if (crinitTaskRearmTrigger(ctx, tCopy->name) == -1) {
-            crinitErrPrint("(TID: %d) failed to rearm taks \'%s\'.", threadId, tCopy->name);
+        if (crinitTaskRearmTrigger(a->ctx, t->name) == -1) {
+            crinitErrPrint("(TID: %d) failed to rearm taks \'%s\'.", crinitGettid(), t->name);
         }
     } else {
-        for (size_t i = 0; i < tCopy->trigSize; i++) {
-            if (0 == strcmp(tCopy->trig[i].name, "@timer")) {
-                crinitTimerDBRemoveTimer(tCopy->trig[i].event);
+        for (size_t i = 0; i < t->trigSize; i++) {
+            if (0 == strcmp(t->trig[i].name, "@timer")) {
+                crinitTimerDBRemoveTimer(t->trig[i].event);
             }
         }
     }
-    crinitFreeTask(tCopy);
-    free(args);
-    return NULL;
+    crinitDispatchReadyFdClose(a);
+    if (a->plan != NULL) {
+        crinitSpawnPlanRelease(&a->plan->hdr);
+    }
+    if (a->cmdsPrivate != NULL) {
+        for (size_t i = 0; i < a->cmdsSize; i++) {
+            if (a->t->stopCmds[i].tmpl != NULL) {
+                crinitFreeArgvArray(a->cmdsPrivate[i].argv);
+            }
+        }
+        free(a->cmdsPrivate);
+    }
+    crinitTaskCfgRelease(a->cfg);
+    free(a);
 }
 
 int crinitSetInhibitWait(bool inh) {
@@ -881,22 +1213,241 @@ static int crinitBlockOnWaitInhibit(void) {
     return 0;
 }
 
-static int crinitReapPid(pid_t pid) {
+static int crinitReapPid(pid_t pid, struct rusage *ru) {
     if (crinitBlockOnWaitInhibit() == -1) {
         crinitErrPrint("Could not block on wait inhibition condition.");
         return -1;
     }
+    pid_t wret;
     do {
-        waitpid(pid, NULL, 0);
-    } while (errno == EINTR);
-    if (errno == ECHILD) {
+        wret = wait4(pid, NULL, 0, ru);
+    } while (wret == -1 && errno == EINTR);
+    if (wret == -1 && errno == ECHILD) {
         return 0;  // If the PID does not exist it has either already been reaped or never existed. In either case,
                    // we're fine.
-    } else if (errno != 0) {
+    } else if (wret == -1) {
         crinitErrnoPrint("Could not reap zombie for PID \'%d\'.", pid);
         return -1;
     }
+    return 1;
+}
+
+static int crinitDispatchExpandStopCmds(crinitDispThrArgs_t *a, const crinitCmdVarVals_t *vals) {
+    const crinitTask_t *t = a->t;
+    a->cmds = t->stopCmds;
+    a->cmdsSize = t->stopCmdsSize;
+
+    bool hasVars = false;
+    for (size_t i = 0; i < t->stopCmdsSize && !hasVars; i++) {
+        hasVars = t->stopCmds[i].tmpl != NULL;
+    }
+    if (!hasVars) {
+        return 0;
+    }
+
+    a->cmdsPrivate = calloc(t->stopCmdsSize, sizeof(*a->cmdsPrivate));
+    if (a->cmdsPrivate == NULL) {
+        crinitErrnoPrint("Could not allocate memory for %zu STOP_COMMANDs of Task \'%s\'.", t->stopCmdsSize, t->name);
+        return -1;
+    }
+    for (size_t i = 0; i < t->stopCmdsSize; i++) {
+        const crinitTaskCmd_t *orig = &t->stopCmds[i];
+        crinitTaskCmd_t *cmd = &a->cmdsPrivate[i];
+        cmd->argc = orig->argc;
+        if (orig->tmpl == NULL) {
+            cmd->argv = orig->argv;
+        } else if (crinitCmdTmplExpand(&cmd->argv, orig->tmpl, orig->argc, orig->argv, vals) == -1) {
+            // Only free what has been expanded so far.
+            a->cmdsSize = i;
+            return -1;
+        }
+    }
+    a->cmds = a->cmdsPrivate;
+    return 0;
+}
+
+static int crinitDispatchReadyFdOpen(crinitDispThrArgs_t *a) {
+    const crinitTask_t *t = a->t;
+
+    // Packet mode keeps the boundaries between the state strings written by the task.
+    if (pipe2(a->readyFd, O_CLOEXEC | O_DIRECT) == -1) {
+        crinitErrnoPrint("Could not create readiness pipe for Task \'%s\'.", t->name);
+        return -1;
+    }
+    // Only the read end is non-blocking, the write end shares its flags with the task.
+    int flags = fcntl(a->readyFd[0], F_GETFL);
+    if (flags == -1 || fcntl(a->readyFd[0], F_SETFL, flags | O_NONBLOCK) == -1) {
+        crinitErrnoPrint("Could not set readiness pipe of Task \'%s\' to non-blocking mode.", t->name);
+        goto fail;
+    }
+
+    a->readyRedirs = calloc(t->redirsSize + 1, sizeof(*a->readyRedirs));
+    if (a->readyRedirs == NULL) {
+        crinitErrnoPrint("Could not allocate memory for IO redirections of Task \'%s\'.", t->name);
+        goto fail;
+    }
+    a->readyRedirs[0].newFd = CRINIT_READY_FD_NO;
+    a->readyRedirs[0].oldFd = a->readyFd[1];
+    if (t->redirsSize > 0) {
+        memcpy(&a->readyRedirs[1], t->redirs, t->redirsSize * sizeof(*t->redirs));
+    }
+
+    if ((errno = posix_spawn_file_actions_init(&a->readyFileact)) != 0) {
+        crinitErrnoPrint("Could not initialize posix_spawn file actions for Task \'%s\'.", t->name);
+        goto fail;
+    }
+    if ((errno = posix_spawn_file_actions_adddup2(&a->readyFileact, a->readyFd[1], CRINIT_READY_FD_NO)) != 0) {
+        crinitErrnoPrint("Could not add readiness pipe to posix_spawn file actions for Task \'%s\'.", t->name);
+        goto failFileact;
+    }
+    for (size_t j = 0; j < t->redirsSize; j++) {
+        if (crinitPosixSpawnAddIOFileAction(&a->readyFileact, &t->redirs[j]) == -1) {
+            crinitErrPrint("Could not add IO file action to posix_spawn for Task \'%s\'.", t->name);
+            goto failFileact;
+        }
+    }
+
+    if (crinitProcSupWatchFd(a->readyFd[0], crinitDispatchReadyFdReadable, a) == -1) {
+        if (errno == ENOSYS) {
+            crinitInfoPrint("Task \'%s\' will use the notification socket as READY_FD needs pidfd support.",
+                            t->name);
+            posix_spawn_file_actions_destroy(&a->readyFileact);
+            free(a->readyRedirs);
+            a->readyRedirs = NULL;
+            close(a->readyFd[0]);
+            close(a->readyFd[1]);
+            a->readyFd[0] = a->readyFd[1] = -1;
+            return 0;
+        }
+        crinitErrPrint("Could not hand over readiness pipe of Task \'%s\' to Process Supervisor.", t->name);
+        goto failFileact;
+    }
     return 0;
+
+failFileact:
+    posix_spawn_file_actions_destroy(&a->readyFileact);
+fail:
+    free(a->readyRedirs);
+    a->readyRedirs = NULL;
+    close(a->readyFd[0]);
+    close(a->readyFd[1]);
+    a->readyFd[0] = a->readyFd[1] = -1;
+    return -1;
+}
+
+static void crinitDispatchReadyFdClose(crinitDispThrArgs_t *a) {
+    if (a->readyFd[0] == -1) {
+        return;
+    }
+    crinitProcSupUnwatchFd(a->readyFd[0]);
+    crinitDispatchReadyFdReadable(a->readyFd[0], a);
+
+    posix_spawn_file_actions_destroy(&a->readyFileact);
+    free(a->readyRedirs);
+    a->readyRedirs = NULL;
+    close(a->readyFd[0]);
+    close(a->readyFd[1]);
+    a->readyFd[0] = a->readyFd[1] = -1;
+}
+
+static void crinitDispatchReadyFdReadable(int fd, void *args) {
+    crinitDispThrArgs_t *a = args;
+    char buf[PIPE_BUF];
+    ssize_t len;
+
+    while (true) {
+        len = read(fd, buf, sizeof(buf));
+        if (len == -1 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        crinitTaskNotify_t n = CRINIT_TASK_NOTIFY_INIT;
+        crinitTaskNotifyParse(&n, buf, (size_t)len);
+        if (n.mainPid > 0 &&
+            !crinitDispatchMainPidPermitted(n.mainPid, a->pid, a->t->user, a->plan->creds.cgroupFd)) {
+            crinitErrPrint("Ignoring main PID %d reported by Task '%s' as it is not part of the task.", n.mainPid,
+                           a->t->name);
+            n.mainPid = -1;
+        }
+        if (crinitTaskDBNotify(a->ctx, a->t->name, &n) == -1) {
+            crinitErrPrint("Could not apply notification from readiness pipe of Task \'%s\'.", a->t->name);
+        }
+    }
+    if (len == -1 && errno != EAGAIN) {
+        crinitErrnoPrint("Could not read from readiness pipe of Task \'%s\'.", a->t->name);
+    }
+}
+
+bool crinitDispatchMainPidPermitted(pid_t mainPid, pid_t taskPid, uid_t taskUser, int cgroupFd) {
+    if (taskUser == geteuid() || mainPid == taskPid) {
+        return true;
+    }
+    if (cgroupFd != -1 && crinitCgroupHasPid(mainPid, cgroupFd)) {
+        return true;
+    }
+    if (taskPid <= 0) {
+        return false;
+    }
+    // Processes reparented to crinit or a subreaper on the way do not count, they are found through the cgroup if any.
+    for (pid_t p = crinitProcGetParent(mainPid); p > 1; p = crinitProcGetParent(p)) {
+        if (p == taskPid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static pid_t crinitProcGetParent(pid_t pid) {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE *f = fopen(path, "re");
+    if (f == NULL) {
+        return -1;
+    }
+    char buf[512];
+    size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[len] = '\0';
+
+    // The command name in parentheses may contain anything, so the fields are counted from the last ')'.
+    const char *s = strrchr(buf, ')');
+    int ppid = -1;
+    if (s == NULL || sscanf(s, ") %*c %d", &ppid) != 1) {
+        return -1;
+    }
+    return (pid_t)ppid;
+}
+
+static bool crinitCgroupHasPid(pid_t pid, int cgroupFd) {
+    int fd = openat(cgroupFd, "cgroup.procs", O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+    FILE *f = fdopen(fd, "r");
+    if (f == NULL) {
+        close(fd);
+        return false;
+    }
+    bool found = false;
+    int member;
+    while (!found && fscanf(f, "%d", &member) == 1) {
+        found = member == pid;
+    }
+    fclose(f);
+    return found;
+}
+
+static void crinitDispatchReap(crinitDispThrArgs_t *a) {
+    struct rusage ru;
+    int ret = crinitReapPid(a->pid, &ru);
+    if (ret == -1) {
+        crinitErrPrint("(TID: %d) Could not reap zombie for task \'%s\'.", crinitGettid(), a->t->name);
+    } else if (ret == 1 && crinitTaskDBAddTaskUsage(a->ctx, &ru, a->t->name) == -1) {
+        crinitErrPrint("(TID: %d) Could not account resource usage of process %d to Task \'%s\'.", crinitGettid(),
+                       a->pid, a->t->name);
+    }
 }
 
 static int crinitPosixSpawnAddIOFileAction(posix_spawn_file_actions_t *fileact, const crinitIoRedir_t *ior) {
@@ -0,0 +1,310 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file procspawn.c
+ * @brief Implementation of spawning processes with changed credentials without the help of crinit-launch.
+ */
+#define _GNU_SOURCE  ///< Needed for pipe2().
+#include "procspawn.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/capability.h>
+#include <linux/securebits.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "logio.h"
+
+#ifndef SYS_clone3
+/** Syscall number of clone3(), the same on all architectures except alpha. Missing from older kernel headers. **/
+#define SYS_clone3 435
+#endif
+
+#ifndef CLONE_INTO_CGROUP
+/** Flag for clone3() to create the child in the cgroup given by crinitCloneArgs_t::cgroup, since Linux 5.7. **/
+#define CLONE_INTO_CGROUP 0x200000000ULL
+#endif
+
+// The 16-bit ID variants of these syscalls would truncate IDs on architectures which have both.
+#ifdef SYS_setresuid32
+#define CRINIT_SYS_SETRESUID SYS_setresuid32  ///< Syscall number of setresuid() with 32-bit IDs.
+#define CRINIT_SYS_SETRESGID SYS_setresgid32  ///< Syscall number of setresgid() with 32-bit IDs.
+#define CRINIT_SYS_SETGROUPS SYS_setgroups32  ///< Syscall number of setgroups() with 32-bit IDs.
+#else
+#define CRINIT_SYS_SETRESUID SYS_setresuid  ///< Syscall number of setresuid().
+#define CRINIT_SYS_SETRESGID SYS_setresgid  ///< Syscall number of setresgid().
+#define CRINIT_SYS_SETGROUPS SYS_setgroups  ///< Syscall number of setgroups().
+#endif
+
+/**
+ * Arguments to the clone3() syscall, equivalent to `struct clone_args` (version 2) which is missing from older kernel
+ * headers.
+ */
+typedef struct crinitCloneArgs {
+    uint64_t flags;       ///< Flags for the new process, CLONE_*.
+    uint64_t pidfd;       ///< Return pointer for a pidfd if CLONE_PIDFD is set.
+    uint64_t childTid;    ///< Return pointer for the TID in the child's memory if CLONE_CHILD_SETTID is set.
+    uint64_t parentTid;   ///< Return pointer for the TID in the parent's memory if CLONE_PARENT_SETTID is set.
+    uint64_t exitSignal;  ///< Signal to send to the parent once the child terminates.
+    uint64_t stack;       ///< Lowest address of the child's stack, 0 to use a copy of the parent's stack.
+    uint64_t stackSize;   ///< Size of the child's stack.
+    uint64_t tls;         ///< Thread-local storage of the child if CLONE_SETTLS is set.
+    uint64_t setTid;      ///< Array of PIDs to use for the child in each PID namespace, 0 to let the kernel choose.
+    uint64_t setTidSize;  ///< Number of elements in setTid.
+    uint64_t cgroup;      ///< Directory file descriptor of the child's cgroup if CLONE_INTO_CGROUP is set.
+} crinitCloneArgs_t;
+
+/**
+ * The steps of the child setup, used to report where the child has failed.
+ */
+typedef enum crinitProcSpawnStep {
+    CRINIT_PROCSPAWN_STEP_IOREDIR,   ///< Applying IO redirections.
+    CRINIT_PROCSPAWN_STEP_SCHED,     ///< Applying scheduling parameters.
+    CRINIT_PROCSPAWN_STEP_KEEPCAPS,  ///< Retaining permitted capabilities over the change of user.
+    CRINIT_PROCSPAWN_STEP_GROUPS,    ///< Setting supplementary groups.
+    CRINIT_PROCSPAWN_STEP_GID,       ///< Setting the group ID.
+    CRINIT_PROCSPAWN_STEP_UID,       ///< Setting the user ID.
+    CRINIT_PROCSPAWN_STEP_INHCAPS,   ///< Setting inheritable capabilities.
+    CRINIT_PROCSPAWN_STEP_AMBCAPS,   ///< Raising ambient capabilities.
+    CRINIT_PROCSPAWN_STEP_EXEC,      ///< Executing the target command.
+} crinitProcSpawnStep_t;
+
+/** Descriptions of the steps in crinitProcSpawnStep_t for error messages. **/
+static const char *const crinitProcSpawnStepStr[] = {
+    [CRINIT_PROCSPAWN_STEP_IOREDIR] = "apply IO redirections",
+    [CRINIT_PROCSPAWN_STEP_SCHED] = "apply scheduling parameters",
+    [CRINIT_PROCSPAWN_STEP_KEEPCAPS] = "retain permitted capabilities",
+    [CRINIT_PROCSPAWN_STEP_GROUPS] = "set supplementary groups",
+    [CRINIT_PROCSPAWN_STEP_GID] = "set group ID",
+    [CRINIT_PROCSPAWN_STEP_UID] = "set user ID",
+    [CRINIT_PROCSPAWN_STEP_INHCAPS] = "set inheritable capabilities",
+    [CRINIT_PROCSPAWN_STEP_AMBCAPS] = "raise ambient capabilities",
+    [CRINIT_PROCSPAWN_STEP_EXEC] = "execute command",
+};
+
+/**
+ * Error report sent from the child to the parent through a pipe if the child setup has failed.
+ */
+typedef struct crinitProcSpawnErr {
+    crinitProcSpawnStep_t step;  ///< The step which has failed.
+    int err;                     ///< The errno value of the failure.
+} crinitProcSpawnErr_t;
+
+/** Set if the kernel does not support clone3(). **/
+static atomic_bool crinitProcSpawnNoClone3 = false;
+/** Set if the kernel supports clone3() but not CLONE_INTO_CGROUP. **/
+static atomic_bool crinitProcSpawnNoCgroup = false;
+
+/**
+ * Set up the child process and execute the target command.
+ *
+ * Runs in the child created by crinitProcSpawn() which is a copy of a multi-threaded process. Locks held by other
+ * threads at the time of clone3() may never be released, so the function must only use async-signal-safe functions and
+ * does not log anything. Failures are reported to the parent through \a errFd instead.
+ *
+ * Parameters are the same as for crinitProcSpawn(), plus:
+ *
+ * @param errFd  Write end of the pipe to report failures through, with FD_CLOEXEC set.
+ *
+ * Does not return.
+ */
+static void crinitProcSpawnChild(int errFd, const char *path, char *const argv[], char *const envp[],
+                                 const crinitIoRedir_t *redirs, size_t redirsSize,
+                                 const crinitProcSpawnCreds_t *creds);
+
+int crinitProcSpawn(pid_t *pid, const char *path, char *const argv[], char *const envp[], const crinitIoRedir_t *redirs,
+                    size_t redirsSize, const crinitProcSpawnCreds_t *creds) {
+    crinitNullCheck(-1, pid, path, argv, creds);
+    if (redirsSize > 0 && redirs == NULL) {
+        crinitErrPrint("Input parameters must not be NULL.");
+        return -1;
+    }
+
+    bool intoCgroup = creds->cgroupFd != -1;
+    if (atomic_load(&crinitProcSpawnNoClone3) || (intoCgroup && atomic_load(&crinitProcSpawnNoCgroup))) {
+        errno = ENOSYS;
+        return -1;
+    }
+
+    int errPipe[2];
+    if (pipe2(errPipe, O_CLOEXEC) == -1) {
+        crinitErrnoPrint("Could not create pipe to receive errors from the new process for '%s'.", path);
+        return -1;
+    }
+
+    char *const emptyEnv[] = {NULL};
+    if (envp == NULL) {
+        envp = emptyEnv;
+    }
+
+    crinitCloneArgs_t cloneArgs = {0};
+    cloneArgs.exitSignal = SIGCHLD;
+    if (intoCgroup) {
+        cloneArgs.flags |= CLONE_INTO_CGROUP;
+        cloneArgs.cgroup = (uint64_t)creds->cgroupFd;
+    }
+
+    pid_t child = (pid_t)syscall(SYS_clone3, &cloneArgs, sizeof(cloneArgs));
+    if (child == 0) {
+        close(errPipe[0]);
+        crinitProcSpawnChild(errPipe[1], path, argv, envp, redirs, redirsSize, creds);
+    }
+    int cloneErr = errno;
+    close(errPipe[1]);
+
+    if (child == -1) {
+        close(errPipe[0]);
+        if (cloneErr == ENOSYS) {
+            atomic_store(&crinitProcSpawnNoClone3, true);
+            crinitInfoPrint("The kernel does not support clone3(), will use the launcher to spawn processes.");
+        } else if (intoCgroup && (cloneErr == EINVAL || cloneErr == E2BIG)) {
+            // Kernels before 5.7 reject the unknown flag or the larger argument struct.
+            atomic_store(&crinitProcSpawnNoCgroup, true);
+            crinitInfoPrint("The kernel does not support CLONE_INTO_CGROUP, will use the launcher to spawn processes.");
+        } else if (intoCgroup && cloneErr == EBADF) {
+            // Not a cgroup v2 directory, the launcher may still be able to move the process there.
+            crinitDbgInfoPrint("Can not spawn '%s' into a cgroup which is not part of the cgroup v2 hierarchy.", path);
+        } else {
+            errno = cloneErr;
+            crinitErrnoPrint("Could not create new process for '%s'.", path);
+            errno = cloneErr;
+            return -1;
+        }
+        errno = ENOSYS;
+        return -1;
+    }
+
+    // The pipe is closed without data on a successful execve().
+    crinitProcSpawnErr_t childErr;
+    ssize_t bytesRead;
+    do {
+        bytesRead = read(errPipe[0], &childErr, sizeof(childErr));
+    } while (bytesRead == -1 && errno == EINTR);
+    close(errPipe[0]);
+
+    if (bytesRead == sizeof(childErr)) {
+        while (waitpid(child, NULL, 0) == -1 && errno == EINTR) {
+        }
+        errno = childErr.err;
+        crinitErrnoPrint("New process for '%s' could not %s.", path, crinitProcSpawnStepStr[childErr.step]);
+        errno = childErr.err;
+        return -1;
+    }
+    if (bytesRead == -1) {
+        // The process exists in any case, a failure to execute would show in its exit status.
+        crinitErrnoPrint("Could not receive setup result of new process %d for '%s'.", child, path);
+    }
+
+    *pid = child;
+    return 0;
+}
+
+static void crinitProcSpawnChild(int errFd, const char *path, char *const argv[], char *const envp[],
+                                 const crinitIoRedir_t *redirs, size_t redirsSize,
+                                 const crinitProcSpawnCreds_t *creds) {
+    crinitProcSpawnErr_t e = {CRINIT_PROCSPAWN_STEP_IOREDIR, 0};
+
+    // Move the pipe out of the way of the standard streams and all other redirected descriptors, otherwise an IO
+    // redirection could overwrite it.
+    int minFd = STDERR_FILENO + 1;
+    for (size_t i = 0; i < redirsSize; i++) {
+        if (redirs[i].newFd >= minFd) {
+            minFd = redirs[i].newFd + 1;
+        }
+    }
+    if (errFd < minFd) {
+        errFd = fcntl(errFd, F_DUPFD_CLOEXEC, minFd);
+        if (errFd == -1) {
+            _exit(127);
+        }
+    }
+
+    for (size_t i = 0; i < redirsSize; i++) {
+        const crinitIoRedir_t *ior = &redirs[i];
+        if (ior->path != NULL) {
+            int fd = open(ior->path, ior->oflags, ior->mode);
+            if (fd == -1) {
+                goto fail;
+            }
+            if (fd != ior->newFd) {
+                if (dup2(fd, ior->newFd) == -1) {
+                    goto fail;
+                }
+                close(fd);
+            }
+        } else if (ior->oldFd == ior->newFd) {
+            // dup2() would do nothing, but the descriptor still needs to survive execve() as with posix_spawn().
+            int flags = fcntl(ior->newFd, F_GETFD);
+            if (flags == -1 || fcntl(ior->newFd, F_SETFD, flags & ~FD_CLOEXEC) == -1) {
+                goto fail;
+            }
+        } else if (dup2(ior->oldFd, ior->newFd) == -1) {
+            goto fail;
+        }
+    }
+
+    // Raising priorities needs privileges, so this happens before the change of user.
+    e.step = CRINIT_PROCSPAWN_STEP_SCHED;
+    if (creds->sched != NULL && crinitSchedParamsApply(creds->sched, NULL) == -1) {
+        goto fail;
+    }
+
+    // The rest mirrors crinit-launch. The libc wrappers for set*id() would try to synchronize the IDs of all threads
+    // of the parent, so the raw syscalls are used.
+    if (creds->setCaps) {
+        e.step = CRINIT_PROCSPAWN_STEP_KEEPCAPS;
+        int secBits = prctl(PR_GET_SECUREBITS);
+        if (secBits == -1 || prctl(PR_SET_SECUREBITS, secBits | SECBIT_KEEP_CAPS) == -1) {
+            goto fail;
+        }
+    }
+
+    e.step = CRINIT_PROCSPAWN_STEP_GROUPS;
+    if (syscall(CRINIT_SYS_SETGROUPS, creds->supGroupsSize, creds->supGroups) == -1) {
+        goto fail;
+    }
+    e.step = CRINIT_PROCSPAWN_STEP_GID;
+    if (syscall(CRINIT_SYS_SETRESGID, creds->group, creds->group, creds->group) == -1) {
+        goto fail;
+    }
+    e.step = CRINIT_PROCSPAWN_STEP_UID;
+    if (syscall(CRINIT_SYS_SETRESUID, creds->user, creds->user, creds->user) == -1) {
+        goto fail;
+    }
+
+    if (creds->setCaps) {
+        e.step = CRINIT_PROCSPAWN_STEP_INHCAPS;
+        struct __user_cap_header_struct capHdr = {.version = _LINUX_CAPABILITY_VERSION_3, .pid = 0};
+        struct __user_cap_data_struct capData[_LINUX_CAPABILITY_U32S_3];
+        if (syscall(SYS_capget, &capHdr, capData) == -1) {
+            goto fail;
+        }
+        capData[0].inheritable = (uint32_t)creds->caps;
+        capData[1].inheritable = (uint32_t)(creds->caps >> 32);
+        if (syscall(SYS_capset, &capHdr, capData) == -1) {
+            goto fail;
+        }
+
+        e.step = CRINIT_PROCSPAWN_STEP_AMBCAPS;
+        for (unsigned long capIdx = 0; capIdx < 64; capIdx++) {
+            if ((creds->caps & (1uLL << capIdx)) && prctl(PR_CAP_AMBIENT, PR_CAP_AMBIENT_RAISE, capIdx, 0, 0) == -1) {
+                goto fail;
+            }
+        }
+    }
+
+    e.step = CRINIT_PROCSPAWN_STEP_EXEC;
+    execve(path, argv, envp);
+
+fail:
+    e.err = errno;
+    if (write(errFd, &e, sizeof(e)) != sizeof(e)) {
+        // Nothing left to do, the parent will see the exit status.
+    }
+    _exit(127);
+}
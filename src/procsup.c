@@ -0,0 +1,292 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file procsup.c
+ * @brief Implementation of the Process Supervisor.
+ */
+#include "procsup.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "logio.h"
+
+#ifndef SYS_pidfd_open
+/** Syscall number of pidfd_open(), the same on all architectures except alpha. Missing from older kernel headers. **/
+#define SYS_pidfd_open 434
+#endif
+
+/** Macro wrapper for the pidfd_open syscall in case glibc is not new enough to contain one itself **/
+#define crinitPidfdOpen(pid) ((int)syscall(SYS_pidfd_open, (pid), 0))
+
+/**
+ * Type to store a watched process or file descriptor along with its callback.
+ */
+typedef struct crinitProcSupEntry {
+    pid_t pid;                        ///< PID of the watched process, -1 if the entry watches a file descriptor.
+    int pidfd;                        ///< Process file descriptor referring to the watched process, or the watched
+                                      ///< file descriptor.
+    crinitProcSupCallback_t cb;       ///< Callback to run once the process has terminated.
+    crinitProcSupFdCallback_t fdCb;   ///< Callback to run if the watched file descriptor is readable.
+    void *arg;                        ///< Argument to the callback.
+    bool removed;                     ///< Set by crinitProcSupUnwatchFd(), the entry is freed by the supervisor.
+    struct crinitProcSupEntry *next;  ///< Next entry in #crinitProcSupFdList.
+} crinitProcSupEntry_t;
+
+/** Guards the one-time initialization of the supervisor by crinitProcSupInit(). **/
+static pthread_once_t crinitProcSupOnce = PTHREAD_ONCE_INIT;
+/** The epoll instance watching the pidfds of all supervised processes. **/
+static int crinitProcSupEpfd = -1;
+/** 0 if the supervisor has been started successfully, otherwise the errno value of the failed initialization. **/
+static int crinitProcSupInitErr = 0;
+/** Protects #crinitProcSupFdList and is held while a crinitProcSupFdCallback_t runs. **/
+static pthread_mutex_t crinitProcSupFdLock = PTHREAD_MUTEX_INITIALIZER;
+/** List of all watched file descriptors, including removed ones not yet freed by the supervisor thread. **/
+static crinitProcSupEntry_t *crinitProcSupFdList = NULL;
+
+/**
+ * Create the epoll instance and start the supervisor thread.
+ *
+ * Meant to be called through pthread_once() and sets #crinitProcSupInitErr on failure.
+ */
+static void crinitProcSupInit(void);
+/**
+ * The supervisor thread function, waits for watched processes to terminate and runs their callbacks.
+ *
+ * @param args  UNUSED
+ */
+static void *crinitProcSupThreadFunc(void *args);
+/**
+ * Run pthread_once() on crinitProcSupInit() and report its result.
+ *
+ * @return 0 if the supervisor is running, -1 otherwise with errno set
+ */
+static int crinitProcSupStart(void);
+/**
+ * Free the entries of file descriptors removed by crinitProcSupUnwatchFd().
+ *
+ * Only called by the supervisor thread in between two calls to epoll_wait(), so that no removed entry is still
+ * referenced by a pending event.
+ */
+static void crinitProcSupFdSweep(void);
+
+int crinitProcSupWatch(pid_t pid, crinitProcSupCallback_t cb, void *arg) {
+    if (cb == NULL) {
+        crinitErrPrint("Callback must not be NULL.");
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (crinitProcSupStart() == -1) {
+        return -1;
+    }
+
+    crinitProcSupEntry_t *e = calloc(1, sizeof(*e));
+    if (e == NULL) {
+        crinitErrnoPrint("Could not allocate memory to watch process %d.", pid);
+        return -1;
+    }
+    e->pid = pid;
+    e->cb = cb;
+    e->arg = arg;
+    e->pidfd = crinitPidfdOpen(pid);
+    if (e->pidfd == -1) {
+        crinitErrnoPrint("Could not open pidfd for process %d.", pid);
+        free(e);
+        return -1;
+    }
+
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = e};
+    if (epoll_ctl(crinitProcSupEpfd, EPOLL_CTL_ADD, e->pidfd, &ev) == -1) {
+        crinitErrnoPrint("Could not add pidfd of process %d to epoll instance.", pid);
+        close(e->pidfd);
+        free(e);
+        return -1;
+    }
+    return 0;
+}
+
+int crinitProcSupWatchFd(int fd, crinitProcSupFdCallback_t cb, void *arg) {
+    if (cb == NULL || fd < 0) {
+        crinitErrPrint("Callback must not be NULL and file descriptor must be valid.");
+        errno = EINVAL;
+        return -1;
+    }
+    if (crinitProcSupStart() == -1) {
+        return -1;
+    }
+
+    crinitProcSupEntry_t *e = calloc(1, sizeof(*e));
+    if (e == NULL) {
+        crinitErrnoPrint("Could not allocate memory to watch file descriptor %d.", fd);
+        return -1;
+    }
+    e->pid = -1;
+    e->pidfd = fd;
+    e->fdCb = cb;
+    e->arg = arg;
+
+    pthread_mutex_lock(&crinitProcSupFdLock);
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = e};
+    if (epoll_ctl(crinitProcSupEpfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+        int err = errno;
+        pthread_mutex_unlock(&crinitProcSupFdLock);
+        errno = err;
+        crinitErrnoPrint("Could not add file descriptor %d to epoll instance.", fd);
+        free(e);
+        errno = err;
+        return -1;
+    }
+    e->next = crinitProcSupFdList;
+    crinitProcSupFdList = e;
+    pthread_mutex_unlock(&crinitProcSupFdLock);
+    return 0;
+}
+
+int crinitProcSupUnwatchFd(int fd) {
+    pthread_mutex_lock(&crinitProcSupFdLock);
+    for (crinitProcSupEntry_t *e = crinitProcSupFdList; e != NULL; e = e->next) {
+        if (e->pidfd == fd && !e->removed) {
+            epoll_ctl(crinitProcSupEpfd, EPOLL_CTL_DEL, fd, NULL);
+            e->removed = true;
+            pthread_mutex_unlock(&crinitProcSupFdLock);
+            return 0;
+        }
+    }
+    pthread_mutex_unlock(&crinitProcSupFdLock);
+    crinitErrPrint("File descriptor %d is not watched by the Process Supervisor.", fd);
+    errno = ENOENT;
+    return -1;
+}
+
+static int crinitProcSupStart(void) {
+    if ((errno = pthread_once(&crinitProcSupOnce, crinitProcSupInit)) != 0) {
+        crinitErrnoPrint("Could not initialize Process Supervisor.");
+        return -1;
+    }
+    if (crinitProcSupInitErr != 0) {
+        errno = crinitProcSupInitErr;
+        return -1;
+    }
+    return 0;
+}
+
+static void crinitProcSupInit(void) {
+    // Probe for pidfd support using our own PID, so that callers can fall back before any child is involved.
+    int probe = crinitPidfdOpen(getpid());
+    if (probe == -1) {
+        crinitProcSupInitErr = errno;
+        if (errno == ENOSYS) {
+            crinitInfoPrint("Kernel does not support pidfds, child processes will be waited for by dispatch threads.");
+        } else {
+            crinitErrnoPrint("Could not open pidfd to probe for pidfd support.");
+        }
+        return;
+    }
+    close(probe);
+
+    crinitProcSupEpfd = epoll_create1(EPOLL_CLOEXEC);
+    if (crinitProcSupEpfd == -1) {
+        crinitProcSupInitErr = errno;
+        crinitErrnoPrint("Could not create epoll instance for Process Supervisor.");
+        return;
+    }
+
+    pthread_t supThread;
+    pthread_attr_t supThreadAttr;
+    if ((errno = pthread_attr_init(&supThreadAttr)) != 0) {
+        crinitErrnoPrint("Could not initialize pthread attributes for Process Supervisor.");
+        goto fail;
+    }
+    if ((errno = pthread_attr_setdetachstate(&supThreadAttr, PTHREAD_CREATE_DETACHED)) != 0) {
+        crinitErrnoPrint("Could not set PTHREAD_CREATE_DETACHED attribute for Process Supervisor.");
+        goto failAttr;
+    }
+    if ((errno = pthread_attr_setstacksize(&supThreadAttr, CRINIT_PROC_SUPERVISOR_THREAD_STACK_SIZE)) != 0) {
+        crinitErrnoPrint("Could not set pthread stack size to %zu for Process Supervisor.",
+                         (size_t)CRINIT_PROC_SUPERVISOR_THREAD_STACK_SIZE);
+        goto failAttr;
+    }
+    if ((errno = pthread_create(&supThread, &supThreadAttr, crinitProcSupThreadFunc, NULL)) != 0) {
+        crinitErrnoPrint("Could not create Process Supervisor thread.");
+        goto failAttr;
+    }
+    pthread_attr_destroy(&supThreadAttr);
+    crinitDbgInfoPrint("Process Supervisor started.");
+    return;
+
+failAttr:
+    pthread_attr_destroy(&supThreadAttr);
+fail:
+    crinitProcSupInitErr = errno;
+    close(crinitProcSupEpfd);
+    crinitProcSupEpfd = -1;
+}
+
+static void *crinitProcSupThreadFunc(void *args) {
+    CRINIT_PARAM_UNUSED(args);
+    struct epoll_event events[CRINIT_PROC_SUPERVISOR_MAX_EVENTS];
+
+    while (true) {
+        int n = epoll_wait(crinitProcSupEpfd, events, CRINIT_PROC_SUPERVISOR_MAX_EVENTS, -1);
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            crinitErrnoPrint("Process Supervisor could not wait for child processes. Exiting.");
+            return NULL;
+        }
+
+        for (int i = 0; i < n; i++) {
+            crinitProcSupEntry_t *e = events[i].data.ptr;
+            if (e->pid == -1) {
+                // Unwatching the descriptor waits for the lock, so the callback's argument is valid until then.
+                pthread_mutex_lock(&crinitProcSupFdLock);
+                if (!e->removed) {
+                    e->fdCb(e->pidfd, e->arg);
+                }
+                pthread_mutex_unlock(&crinitProcSupFdLock);
+                continue;
+            }
+
+            // A pidfd becomes readable once the process has terminated, so this does not block.
+            epoll_ctl(crinitProcSupEpfd, EPOLL_CTL_DEL, e->pidfd, NULL);
+            close(e->pidfd);
+
+            siginfo_t status = {0};
+            int wret;
+            do {
+                wret = waitid(P_PID, e->pid, &status, WEXITED | WNOWAIT);
+            } while (wret == -1 && errno == EINTR);
+            if (wret == -1) {
+                crinitErrnoPrint("Could not get exit status of process %d.", e->pid);
+            }
+
+            e->cb(e->pid, (wret == 0) ? &status : NULL, e->arg);
+            free(e);
+        }
+        crinitProcSupFdSweep();
+    }
+    return NULL;
+}
+
+static void crinitProcSupFdSweep(void) {
+    pthread_mutex_lock(&crinitProcSupFdLock);
+    crinitProcSupEntry_t **pp = &crinitProcSupFdList;
+    while (*pp != NULL) {
+        crinitProcSupEntry_t *e = *pp;
+        if (e->removed) {
+            *pp = e->next;
+            free(e);
+        } else {
+            pp = &e->next;
+        }
+    }
+    pthread_mutex_unlock(&crinitProcSupFdLock);
+}
@@ -5,7 +5,9 @@
  */
 #include "rtimcmd.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <limits.h>
 #include <pthread.h>
 #include <signal.h>
@@ -24,6 +26,14 @@
 #include "globopt.h"
 #include "logio.h"
 #include "procdip.h"
+#include "taskgraph.h"
+
+/** Size of a buffer large enough for the text of a numerical argument including the terminating null byte. **/
+#define CRINIT_RTIMARG_NUM_BUF_SIZE 48
+/** Size of the opcode and the number of arguments at the start of the binary encoding of a command. **/
+#define CRINIT_RTIMCMD_BIN_HDR_SIZE (2 * sizeof(uint32_t))
+/** Size of the type and the size of the value in front of each argument in the binary encoding of a command. **/
+#define CRINIT_RTIMARG_BIN_HDR_SIZE (sizeof(uint8_t) + sizeof(uint32_t))
 
 /**
  * Argument structure for shdnThread().
@@ -161,6 +171,42 @@ static int crinitExecRtimCmdStatus(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, co
  * @return 0 on success, -1 on error
  */
 static int crinitExecRtimCmdTaskList(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
+/**
+ * Internal implementation of the "depgraph" command on an crinitTaskDB_t.
+ *
+ * For documentation on the command itself, see crinitClientGetDepGraph().
+ *
+ * @param ctx  The crinitTaskDB_t to operate on.
+ * @param res  Return pointer for response/result.
+ * @param cmd  The crinitRtimCmd_t to execute, used to pass the argument list.
+ *
+ * @return 0 on success, -1 on error
+ */
+static int crinitExecRtimCmdDepGraph(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
+/**
+ * Internal implementation of the "usage" command on an crinitTaskDB_t.
+ *
+ * For documentation on the command itself, see crinitClientTaskGetUsage().
+ *
+ * @param ctx  The crinitTaskDB_t to operate on.
+ * @param res  Return pointer for response/result.
+ * @param cmd  The crinitRtimCmd_t to execute, used to pass the argument list.
+ *
+ * @return 0 on success, -1 on error
+ */
+static int crinitExecRtimCmdUsage(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
+/**
+ * Internal implementation of the "statuslist" command on an crinitTaskDB_t.
+ *
+ * For documentation on the command itself, see crinitClientGetTaskStatusList().
+ *
+ * @param ctx  The crinitTaskDB_t to operate on.
+ * @param res  Return pointer for response/result.
+ * @param cmd  The crinitRtimCmd_t to execute, used to pass the argument list.
+ *
+ * @return 0 on success, -1 on error
+ */
+static int crinitExecRtimCmdStatusList(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
 
 /**
  * Internal implementation of the version query from the client library to crinit.
@@ -235,6 +281,51 @@ static inline int crinitGenUnMountList(crinitUnMountList_t **um, bool *rootfsIsR
  * @param um  The crinitUnMountList_t to free.
  */
 static inline void crinitFreeUnMountList(crinitUnMountList_t *um);
+/**
+ * Allocate the argument array of an crinitRtimCmd_t together with the storage for its strings.
+ *
+ * Sets crinitRtimCmd_t::args and crinitRtimCmd_t::argc.
+ *
+ * @param c        The crinitRtimCmd_t to allocate the arguments of.
+ * @param argc     The number of arguments.
+ * @param strSize  The total size of the strings including their terminating zeroes.
+ *
+ * @return  Pointer to the string storage behind the argument array, NULL on error
+ */
+static char *crinitRtimCmdAlloc(crinitRtimCmd_t *c, size_t argc, size_t strSize);
+/**
+ * Format a numerical argument as text.
+ *
+ * @param buf  Buffer of at least #CRINIT_RTIMARG_NUM_BUF_SIZE Bytes.
+ * @param a    The argument to format.
+ *
+ * @return  The length of the text, 0 if \a a is a string which is not copied, -1 if its type is invalid
+ */
+static int crinitRtimArgFormat(char *buf, const crinitRtimArg_t *a);
+/**
+ * Get the size of the value of an argument in the binary encoding, see crinitRtimCmdToMsgBin().
+ *
+ * @param size  Return pointer for the size.
+ * @param a     The argument.
+ *
+ * @return  0 on success, -1 if the type of \a a is invalid or its value too large
+ */
+static int crinitRtimArgBinSize(size_t *size, const crinitRtimArg_t *a);
+/**
+ * Read and validate an argument of a message in the binary encoding, see crinitRtimCmdToMsgBin().
+ *
+ * The value of a string argument is not copied, crinitRtimArg_t::str points into the message and is not
+ * null-terminated. The nanoseconds of a time argument must be in [0, 1000000000). Not static so that it can be unit
+ * tested.
+ *
+ * @param a       Return pointer for the argument.
+ * @param strLen  Return pointer for the length of a string argument.
+ * @param runner  Position of the argument in the message, set behind it on success.
+ * @param end     End of the message.
+ *
+ * @return  0 on success, -1 if the argument is invalid
+ */
+int crinitRtimArgBinRead(crinitRtimArg_t *a, size_t *strLen, const uint8_t **runner, const uint8_t *end);
 
 int crinitParseRtimCmd(crinitRtimCmd_t *out, const char *cmdStr) {
     if (out == NULL || cmdStr == NULL) {
@@ -268,40 +359,30 @@ int crinitParseRtimCmd(crinitRtimCmd_t *out, const char *cmdStr) {
             runner++;
         }
     }
-    out->args = malloc((argCount + 1) * sizeof(char *));
-    if (out->args == NULL) {
-        crinitErrnoPrint("Could not allocate memory for runtime commmand argument array with %zu arguments.", argCount);
+
+    size_t argStrLen = (argCount > 0) ? (size_t)(argEnd - argStart) : 0;
+    char *strBuf = crinitRtimCmdAlloc(out, argCount, argStrLen);
+    if (strBuf == NULL) {
+        crinitErrPrint("Could not allocate memory for runtime commmand argument array with %zu arguments.", argCount);
         return -1;
     }
     if (argCount == 0) {
-        out->args[0] = NULL;
-        out->argc = 0;
         return 0;
     }
 
-    size_t argStrLen = argEnd - argStart;
-    out->args[0] = malloc(argStrLen);
-    if (out->args[0] == NULL) {
-        crinitErrnoPrint("Could not allocate memory for backing string of argument array");
-        free(out->args);
-        out->args = NULL;
-        out->argc = 0;
-        return -1;
-    }
-    memcpy(out->args[0], argStart + 1, argStrLen - 1);
-    out->args[0][argStrLen - 1] = '\0';
+    memcpy(strBuf, argStart + 1, argStrLen - 1);
+    strBuf[argStrLen - 1] = '\0';
     char *strtokState = NULL;
     char *token = NULL;
-    char *start = out->args[0];
+    char *start = strBuf;
     size_t i = 0;
     char tokenList[2] = {CRINIT_RTIMCMD_ARGDELIM, '\0'};
     while ((token = strtok_r(start, tokenList, &strtokState)) != NULL && i < argCount) {
         start = NULL;
-        out->args[i] = token;
+        out->args[i].type = CRINIT_RTIMARG_TYPE_STR;
+        out->args[i].str = token;
         i++;
     }
-    out->args[argCount] = NULL;
-    out->argc = argCount;
     return 0;
 }
 
@@ -316,9 +397,19 @@ int crinitRtimCmdToMsgStr(char **out, size_t *outLen, const crinitRtimCmd_t *cmd
         crinitErrPrint("Could not get a string representation of the command's opcode.");
         return -1;
     }
+    char numBuf[CRINIT_RTIMARG_NUM_BUF_SIZE];
     *outLen = strlen(opStr) + 1;
     for (size_t i = 0; i < cmd->argc; i++) {
-        *outLen += strlen(cmd->args[i]) + 1;
+        if (cmd->args[i].type == CRINIT_RTIMARG_TYPE_STR) {
+            *outLen += strlen(cmd->args[i].str) + 1;
+            continue;
+        }
+        int numLen = crinitRtimArgFormat(numBuf, &cmd->args[i]);
+        if (numLen == -1) {
+            crinitErrPrint("Argument %zu of runtime command has invalid type %d.", i, (int)cmd->args[i].type);
+            return -1;
+        }
+        *outLen += (size_t)numLen + 1;
     }
 
     *out = malloc(*outLen);
@@ -332,16 +423,261 @@ int crinitRtimCmdToMsgStr(char **out, size_t *outLen, const crinitRtimCmd_t *cmd
     for (size_t i = 0; i < cmd->argc; i++) {
         *runner = CRINIT_RTIMCMD_ARGDELIM;
         runner++;
-        runner = stpcpy(runner, cmd->args[i]);
+        if (cmd->args[i].type == CRINIT_RTIMARG_TYPE_STR) {
+            runner = stpcpy(runner, cmd->args[i].str);
+        } else {
+            runner += crinitRtimArgFormat(runner, &cmd->args[i]);
+        }
+    }
+    return 0;
+}
+
+int crinitParseRtimCmdBin(crinitRtimCmd_t *out, const void *msg, size_t msgLen) {
+    if (out == NULL || msg == NULL) {
+        crinitErrPrint("Pointer parameters must not be NULL.");
+        return -1;
+    }
+    if (msgLen < CRINIT_RTIMCMD_BIN_HDR_SIZE) {
+        crinitErrPrint("Runtime command message of %zu Bytes is too short.", msgLen);
+        return -1;
+    }
+
+    const uint8_t *start = msg, *end = start + msgLen;
+    uint32_t op, argc;
+    memcpy(&op, start, sizeof(op));
+    memcpy(&argc, start + sizeof(op), sizeof(argc));
+    start += CRINIT_RTIMCMD_BIN_HDR_SIZE;
+    const char *opStr = NULL;
+    if (op > INT_MAX || crinitOpStrGetByRtimOp(&opStr, (crinitRtimOp_t)op) == -1) {
+        crinitErrPrint("Could not parse runtime command. Unknown or invalid opcode %" PRIu32 ".", op);
+        return -1;
+    }
+
+    // First pass to validate the message and to sum up the size of the strings so that they fit into one allocation.
+    crinitRtimArg_t arg;
+    size_t strLen = 0, strSize = 0;
+    const uint8_t *runner = start;
+    for (uint32_t i = 0; i < argc; i++) {
+        if (crinitRtimArgBinRead(&arg, &strLen, &runner, end) == -1) {
+            crinitErrPrint("Could not parse argument %" PRIu32 " of runtime command message.", i);
+            return -1;
+        }
+        if (arg.type == CRINIT_RTIMARG_TYPE_STR) {
+            strSize += strLen + 1;
+        }
+    }
+    if (runner != end) {
+        crinitErrPrint("Runtime command message has %zu unexpected trailing Bytes.", (size_t)(end - runner));
+        return -1;
+    }
+
+    char *strBuf = crinitRtimCmdAlloc(out, argc, strSize);
+    if (strBuf == NULL) {
+        crinitErrPrint("Could not allocate memory for runtime commmand argument array with %" PRIu32 " arguments.",
+                       argc);
+        return -1;
+    }
+    out->op = (crinitRtimOp_t)op;
+    runner = start;
+    for (uint32_t i = 0; i < argc; i++) {
+        crinitRtimArgBinRead(&out->args[i], &strLen, &runner, end);
+        if (out->args[i].type == CRINIT_RTIMARG_TYPE_STR) {
+            memcpy(strBuf, out->args[i].str, strLen);
+            strBuf[strLen] = '\0';
+            out->args[i].str = strBuf;
+            strBuf += strLen + 1;
+        }
+    }
+    return 0;
+}
+
+int crinitRtimCmdToMsgBin(void **out, size_t *outLen, const crinitRtimCmd_t *cmd) {
+    if (out == NULL || outLen == NULL || cmd == NULL) {
+        crinitErrPrint("Pointer parameters must not be NULL.");
+        return -1;
+    }
+    if (cmd->argc > UINT32_MAX) {
+        crinitErrPrint("Runtime command has too many arguments (%zu).", cmd->argc);
+        return -1;
+    }
+
+    size_t valSize;
+    *outLen = CRINIT_RTIMCMD_BIN_HDR_SIZE;
+    for (size_t i = 0; i < cmd->argc; i++) {
+        if (crinitRtimArgBinSize(&valSize, &cmd->args[i]) == -1) {
+            crinitErrPrint("Could not encode argument %zu of runtime command.", i);
+            return -1;
+        }
+        *outLen += CRINIT_RTIMARG_BIN_HDR_SIZE + valSize;
+    }
+
+    // One spare Byte for the terminating zero which stpcpy() writes behind the last string.
+    uint8_t *runner = malloc(*outLen + 1);
+    if (runner == NULL) {
+        crinitErrnoPrint("Could not allocate memory (%zu Bytes) for binary representation of runtime command.",
+                         *outLen);
+        *outLen = 0;
+        return -1;
+    }
+    *out = runner;
+
+    const uint32_t hdr[2] = {(uint32_t)cmd->op, (uint32_t)cmd->argc};
+    memcpy(runner, hdr, sizeof(hdr));
+    runner += sizeof(hdr);
+    for (size_t i = 0; i < cmd->argc; i++) {
+        const crinitRtimArg_t *a = &cmd->args[i];
+        uint8_t *argHdr = runner;
+        runner += CRINIT_RTIMARG_BIN_HDR_SIZE;
+        switch (a->type) {
+            case CRINIT_RTIMARG_TYPE_STR:
+                // Copy first to get the length in the same pass, the terminating zero is overwritten by the next
+                // argument.
+                valSize = (size_t)((uint8_t *)stpcpy((char *)runner, a->str) - runner);
+                break;
+            case CRINIT_RTIMARG_TYPE_INT:
+                valSize = sizeof(a->num);
+                memcpy(runner, &a->num, valSize);
+                break;
+            case CRINIT_RTIMARG_TYPE_UINT:
+                valSize = sizeof(a->unum);
+                memcpy(runner, &a->unum, valSize);
+                break;
+            case CRINIT_RTIMARG_TYPE_TIME: {
+                const int64_t time[2] = {a->time.tv_sec, a->time.tv_nsec};
+                valSize = sizeof(time);
+                memcpy(runner, time, valSize);
+                break;
+            }
+        }
+        const uint32_t size = (uint32_t)valSize;
+        *argHdr = (uint8_t)a->type;
+        memcpy(argHdr + sizeof(uint8_t), &size, sizeof(size));
+        runner += valSize;
     }
     return 0;
 }
 
+int crinitRtimArgGetStr(const crinitRtimArg_t *a, const char **out) {
+    if (a == NULL || out == NULL) {
+        crinitErrPrint("Pointer parameters must not be NULL.");
+        return -1;
+    }
+    if (a->type != CRINIT_RTIMARG_TYPE_STR) {
+        crinitErrPrint("Expected a string argument but got type %d.", (int)a->type);
+        return -1;
+    }
+    *out = a->str;
+    return 0;
+}
+
+int crinitRtimArgGetInt(const crinitRtimArg_t *a, int64_t *out) {
+    if (a == NULL || out == NULL) {
+        crinitErrPrint("Pointer parameters must not be NULL.");
+        return -1;
+    }
+    char *endPtr = NULL;
+    switch (a->type) {
+        case CRINIT_RTIMARG_TYPE_INT:
+            *out = a->num;
+            return 0;
+        case CRINIT_RTIMARG_TYPE_UINT:
+            if (a->unum > INT64_MAX) {
+                break;
+            }
+            *out = (int64_t)a->unum;
+            return 0;
+        case CRINIT_RTIMARG_TYPE_STR:
+            errno = 0;
+            long long num = strtoll(a->str, &endPtr, 10);
+            if (endPtr == a->str || *endPtr != '\0' || errno == ERANGE) {
+                crinitErrPrint("Could not parse numerical value from '%s'.", a->str);
+                return -1;
+            }
+            *out = num;
+            return 0;
+        case CRINIT_RTIMARG_TYPE_TIME:
+            break;
+    }
+    crinitErrPrint("Argument of type %d does not hold a signed integer.", (int)a->type);
+    return -1;
+}
+
+int crinitRtimArgGetUInt(const crinitRtimArg_t *a, uint64_t *out) {
+    if (a == NULL || out == NULL) {
+        crinitErrPrint("Pointer parameters must not be NULL.");
+        return -1;
+    }
+    char *endPtr = NULL;
+    switch (a->type) {
+        case CRINIT_RTIMARG_TYPE_UINT:
+            *out = a->unum;
+            return 0;
+        case CRINIT_RTIMARG_TYPE_INT:
+            if (a->num < 0) {
+                break;
+            }
+            *out = (uint64_t)a->num;
+            return 0;
+        case CRINIT_RTIMARG_TYPE_STR:
+            errno = 0;
+            unsigned long long unum = strtoull(a->str, &endPtr, 10);
+            if (endPtr == a->str || *endPtr != '\0' || errno == ERANGE || strchr(a->str, '-') != NULL) {
+                crinitErrPrint("Could not parse numerical value from '%s'.", a->str);
+                return -1;
+            }
+            *out = unum;
+            return 0;
+        case CRINIT_RTIMARG_TYPE_TIME:
+            break;
+    }
+    crinitErrPrint("Argument of type %d does not hold an unsigned integer.", (int)a->type);
+    return -1;
+}
+
+int crinitRtimArgGetTime(const crinitRtimArg_t *a, struct timespec *out) {
+    if (a == NULL || out == NULL) {
+        crinitErrPrint("Pointer parameters must not be NULL.");
+        return -1;
+    }
+    char *endPtr = NULL;
+    switch (a->type) {
+        case CRINIT_RTIMARG_TYPE_TIME:
+            *out = a->time;
+            return 0;
+        case CRINIT_RTIMARG_TYPE_STR:
+            errno = 0;
+            out->tv_sec = strtoll(a->str, &endPtr, 10);
+            if (endPtr == a->str || *endPtr != '.' || errno == ERANGE) {
+                crinitErrPrint("Could not parse point in time from '%s'.", a->str);
+                return -1;
+            }
+            const char *decPlPtr = endPtr + 1;
+            out->tv_nsec = strtol(decPlPtr, &endPtr, 10);
+            if (endPtr == decPlPtr || *endPtr != '\0' || out->tv_nsec < 0 || out->tv_nsec >= 1000000000L) {
+                crinitErrPrint("Could not parse point in time from '%s'.", a->str);
+                return -1;
+            }
+            return 0;
+        case CRINIT_RTIMARG_TYPE_INT:
+        case CRINIT_RTIMARG_TYPE_UINT:
+            break;
+    }
+    crinitErrPrint("Argument of type %d does not hold a point in time.", (int)a->type);
+    return -1;
+}
+
 int crinitExecRtimCmd(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     if (res == NULL || cmd == NULL) {
         crinitErrPrint("Pointer parameters must not be NULL.");
         return -1;
     }
+    // The implementations of the commands below expect string arguments only.
+    for (size_t i = 0; i < cmd->argc; i++) {
+        if (cmd->args[i].type != CRINIT_RTIMARG_TYPE_STR) {
+            crinitErrPrint("Argument %zu of runtime command is not a string.", i);
+            return -1;
+        }
+    }
     switch (cmd->op) {
         case CRINIT_RTIMCMD_C_ADDTASK:
             if (crinitExecRtimCmdAddTask(ctx, res, cmd) == -1) {
@@ -415,6 +751,24 @@ int crinitExecRtimCmd(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRti
                 return -1;
             }
             return 0;
+        case CRINIT_RTIMCMD_C_DEPGRAPH:
+            if (crinitExecRtimCmdDepGraph(ctx, res, cmd) == -1) {
+                crinitErrPrint("Could not execute runtime command \'DEPGRAPH\'.");
+                return -1;
+            }
+            return 0;
+        case CRINIT_RTIMCMD_C_USAGE:
+            if (crinitExecRtimCmdUsage(ctx, res, cmd) == -1) {
+                crinitErrPrint("Could not execute runtime command \'USAGE\'.");
+                return -1;
+            }
+            return 0;
+        case CRINIT_RTIMCMD_C_STATUSLIST:
+            if (crinitExecRtimCmdStatusList(ctx, res, cmd) == -1) {
+                crinitErrPrint("Could not execute runtime command \'STATUSLIST\'.");
+                return -1;
+            }
+            return 0;
 
         case CRINIT_RTIMCMD_R_ADDTASK:
         case CRINIT_RTIMCMD_R_ADDSERIES:
@@ -428,6 +782,9 @@ int crinitExecRtimCmd(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRti
         case CRINIT_RTIMCMD_R_TASKLIST:
         case CRINIT_RTIMCMD_R_SHUTDOWN:
         case CRINIT_RTIMCMD_R_GETVER:
+        case CRINIT_RTIMCMD_R_DEPGRAPH:
+        case CRINIT_RTIMCMD_R_USAGE:
+        case CRINIT_RTIMCMD_R_STATUSLIST:
         default:
             crinitErrPrint("Could not execute opcode %d. This is an unknown opcode or a response code.", cmd->op);
             return -1;
@@ -441,13 +798,6 @@ int crinitBuildRtimCmd(crinitRtimCmd_t *c, crinitRtimOp_t op, size_t argc, ...)
         return -1;
     }
 
-    c->args = malloc((argc + 1) * sizeof(char *));
-    if (c->args == NULL) {
-        crinitErrPrint("Could not allocate memory for RtimCmd argument array.");
-        return -1;
-    }
-    c->args[argc] = NULL;
-
     va_list vargs;
     va_start(vargs, argc);
     va_list vargsCopy;
@@ -459,28 +809,23 @@ int crinitBuildRtimCmd(crinitRtimCmd_t *c, crinitRtimOp_t op, size_t argc, ...)
     }
     va_end(vargs);
 
-    c->args[0] = malloc(sumStrSize);
-    if (c->args[0] == NULL) {
-        crinitErrPrint("Could not allocate memory for RtimCmd argument array backing string.");
-        free(c->args);
-        c->args = NULL;
+    char *runner = crinitRtimCmdAlloc(c, argc, sumStrSize);
+    if (runner == NULL) {
+        crinitErrPrint("Could not allocate memory for RtimCmd argument array.");
         va_end(vargsCopy);
         return -1;
     }
 
-    char *runner = c->args[0];
     for (size_t i = 0; i < argc; i++) {
         const char *str = va_arg(vargsCopy, const char *);
         size_t copyLen = strlen(str) + 1;
         memcpy(runner, str, copyLen);
-        c->args[i] = runner;
+        c->args[i] = (crinitRtimArg_t)CRINIT_RTIMARG_STR(runner);
         runner += copyLen;
     }
     va_end(vargsCopy);
 
     c->op = op;
-    c->argc = argc;
-
     return 0;
 }
 
@@ -490,39 +835,60 @@ int crinitBuildRtimCmdArray(crinitRtimCmd_t *c, crinitRtimOp_t op, int argc, con
         return -1;
     }
 
-    c->args = malloc((argc + 1) * sizeof(char *));
-    if (c->args == NULL) {
-        crinitErrPrint("Could not allocate memory for RtimCmd argument array.");
-        return -1;
-    }
-    c->args[argc] = NULL;
-
     size_t sumStrSize = 0;
     for (int i = 0; i < argc; i++) {
         const char *str = args[i];
         sumStrSize += strlen(str) + 1;
     }
 
-    c->args[0] = malloc(sumStrSize);
-    if (c->args[0] == NULL) {
-        crinitErrPrint("Could not allocate memory for RtimCmd argument array backing string.");
-        free(c->args);
-        c->args = NULL;
+    char *runner = crinitRtimCmdAlloc(c, argc, sumStrSize);
+    if (runner == NULL) {
+        crinitErrPrint("Could not allocate memory for RtimCmd argument array.");
         return -1;
     }
 
-    char *runner = c->args[0];
     for (int i = 0; i < argc; i++) {
         const char *str = args[i];
         size_t copyLen = strlen(str) + 1;
         memcpy(runner, str, copyLen);
-        c->args[i] = runner;
+        c->args[i] = (crinitRtimArg_t)CRINIT_RTIMARG_STR(runner);
         runner += copyLen;
     }
 
     c->op = op;
-    c->argc = argc;
+    return 0;
+}
+
+int crinitBuildRtimCmdArgs(crinitRtimCmd_t *c, crinitRtimOp_t op, size_t argc, const crinitRtimArg_t args[]) {
+    if (c == NULL || args == NULL) {
+        crinitErrPrint("Pointer parameters must not be NULL.");
+        return -1;
+    }
+
+    size_t sumStrSize = 0;
+    for (size_t i = 0; i < argc; i++) {
+        if (args[i].type == CRINIT_RTIMARG_TYPE_STR) {
+            sumStrSize += strlen(args[i].str) + 1;
+        }
+    }
 
+    char *runner = crinitRtimCmdAlloc(c, argc, sumStrSize);
+    if (runner == NULL) {
+        crinitErrPrint("Could not allocate memory for RtimCmd argument array.");
+        return -1;
+    }
+
+    for (size_t i = 0; i < argc; i++) {
+        c->args[i] = args[i];
+        if (args[i].type == CRINIT_RTIMARG_TYPE_STR) {
+            size_t copyLen = strlen(args[i].str) + 1;
+            memcpy(runner, args[i].str, copyLen);
+            c->args[i].str = runner;
+            runner += copyLen;
+        }
+    }
+
+    c->op = op;
     return 0;
 }
 
@@ -531,11 +897,123 @@ int crinitDestroyRtimCmd(crinitRtimCmd_t *c) {
         crinitErrPrint("RtimCmd pointer must not be NULL.");
         return -1;
     }
-    free(c->args[0]);
     free(c->args);
     return 0;
 }
 
+static char *crinitRtimCmdAlloc(crinitRtimCmd_t *c, size_t argc, size_t strSize) {
+    size_t argsSize = argc * sizeof(*c->args);
+    // Never request zero Bytes so that a command without arguments is not mistaken for an allocation error.
+    c->args = malloc(argsSize + strSize + 1);
+    if (c->args == NULL) {
+        c->argc = 0;
+        return NULL;
+    }
+    c->argc = argc;
+    return (char *)c->args + argsSize;
+}
+
+static int crinitRtimArgFormat(char *buf, const crinitRtimArg_t *a) {
+    switch (a->type) {
+        case CRINIT_RTIMARG_TYPE_STR:
+            return 0;
+        case CRINIT_RTIMARG_TYPE_INT:
+            return snprintf(buf, CRINIT_RTIMARG_NUM_BUF_SIZE, "%" PRId64, a->num);
+        case CRINIT_RTIMARG_TYPE_UINT:
+            return snprintf(buf, CRINIT_RTIMARG_NUM_BUF_SIZE, "%" PRIu64, a->unum);
+        case CRINIT_RTIMARG_TYPE_TIME:
+            return snprintf(buf, CRINIT_RTIMARG_NUM_BUF_SIZE, "%lld.%.9ld", (long long)a->time.tv_sec,
+                            a->time.tv_nsec);
+    }
+    return -1;
+}
+
+static int crinitRtimArgBinSize(size_t *size, const crinitRtimArg_t *a) {
+    switch (a->type) {
+        case CRINIT_RTIMARG_TYPE_STR:
+            *size = strlen(a->str);
+            if (*size > UINT32_MAX) {
+                crinitErrPrint("String argument of %zu Bytes is too long.", *size);
+                return -1;
+            }
+            return 0;
+        case CRINIT_RTIMARG_TYPE_INT:
+            *size = sizeof(a->num);
+            return 0;
+        case CRINIT_RTIMARG_TYPE_UINT:
+            *size = sizeof(a->unum);
+            return 0;
+        case CRINIT_RTIMARG_TYPE_TIME:
+            *size = 2 * sizeof(int64_t);
+            return 0;
+    }
+    crinitErrPrint("Argument has invalid type %d.", (int)a->type);
+    return -1;
+}
+
+int crinitRtimArgBinRead(crinitRtimArg_t *a, size_t *strLen, const uint8_t **runner, const uint8_t *end) {
+    const uint8_t *p = *runner;
+    if ((size_t)(end - p) < CRINIT_RTIMARG_BIN_HDR_SIZE) {
+        crinitErrPrint("Message ends inside an argument header.");
+        return -1;
+    }
+    uint32_t size;
+    memcpy(&size, p + sizeof(uint8_t), sizeof(size));
+    a->type = (crinitRtimArgType_t)*p;
+    p += CRINIT_RTIMARG_BIN_HDR_SIZE;
+    if ((size_t)(end - p) < size) {
+        crinitErrPrint("Message ends inside an argument value of %" PRIu32 " Bytes.", size);
+        return -1;
+    }
+
+    int64_t time[2];
+    size_t expSize = 0;
+    switch (a->type) {
+        case CRINIT_RTIMARG_TYPE_STR:
+            if (memchr(p, '\0', size) != NULL) {
+                crinitErrPrint("String argument contains a null byte.");
+                return -1;
+            }
+            a->str = (const char *)p;
+            *strLen = size;
+            expSize = size;
+            break;
+        case CRINIT_RTIMARG_TYPE_INT:
+            expSize = sizeof(a->num);
+            if (size == expSize) {
+                memcpy(&a->num, p, size);
+            }
+            break;
+        case CRINIT_RTIMARG_TYPE_UINT:
+            expSize = sizeof(a->unum);
+            if (size == expSize) {
+                memcpy(&a->unum, p, size);
+            }
+            break;
+        case CRINIT_RTIMARG_TYPE_TIME:
+            expSize = sizeof(time);
+            if (size == expSize) {
+                memcpy(time, p, size);
+                if (time[1] < 0 || time[1] >= 1000000000L) {
+                    crinitErrPrint("Time argument has nanoseconds out of range: %" PRId64, time[1]);
+                    return -1;
+                }
+                a->time.tv_sec = (time_t)time[0];
+                a->time.tv_nsec = (long)time[1];
+            }
+            break;
+        default:
+            crinitErrPrint("Argument has unknown type %d.", (int)a->type);
+            return -1;
+    }
+    if (size != expSize) {
+        crinitErrPrint("Argument of type %d has unexpected size of %" PRIu32 " Bytes.", (int)a->type, size);
+        return -1;
+    }
+    *runner = p + size;
+    return 0;
+}
+
 static int crinitExecRtimCmdAddTask(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     if (ctx == NULL || res == NULL || cmd == NULL) {
         crinitErrPrint("Pointer parameters must not be NULL.");
@@ -543,7 +1021,7 @@ static int crinitExecRtimCmdAddTask(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
 
     crinitDbgInfoPrint("Will execute runtime command \'ADDTASK\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
 
     if (cmd->argc != 3) {
@@ -552,15 +1030,15 @@ static int crinitExecRtimCmdAddTask(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
     }
 
     crinitConfKvList_t *c;
-    if (crinitParseConf(&c, cmd->args[0]) == -1) {
+    if (crinitParseConf(&c, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDTASK, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not parse given config.");
     }
-    crinitDbgInfoPrint("File \'%s\' loaded.", cmd->args[0]);
+    crinitDbgInfoPrint("File \'%s\' loaded.", cmd->args[0].str);
 
-    if (strcmp(cmd->args[2], "@unchanged") != 0) {
+    if (strcmp(cmd->args[2].str, "@unchanged") != 0) {
         crinitConfKvList_t *runner = c;
-        if (strcmp(cmd->args[2], "@empty") == 0) {
+        if (strcmp(cmd->args[2].str, "@empty") == 0) {
             while (runner != NULL) {
                 if (strcmp(runner->key, CRINIT_CONFIG_KEYSTR_DEPENDS) == 0 && runner->val != NULL) {
                     runner->val[0] = '\0';
@@ -573,7 +1051,7 @@ static int crinitExecRtimCmdAddTask(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
                 if (strcmp(runner->key, CRINIT_CONFIG_KEYSTR_DEPENDS) == 0 && runner->val != NULL) {
                     if (firstEncounter) {
                         free(runner->val);
-                        runner->val = strdup(cmd->args[2]);
+                        runner->val = strdup(cmd->args[2].str);
                         if (runner->val == NULL) {
                             crinitFreeConfList(c);
                             return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDTASK, 2, CRINIT_RTIMCMD_RES_ERR,
@@ -607,7 +1085,7 @@ static int crinitExecRtimCmdAddTask(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
                     return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDTASK, 2, CRINIT_RTIMCMD_RES_ERR,
                                               "Could not set dependencies to given string.");
                 }
-                runner->val = strdup(cmd->args[2]);
+                runner->val = strdup(cmd->args[2].str);
                 if (runner->val == NULL) {
                     crinitFreeConfList(c);
                     return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDTASK, 2, CRINIT_RTIMCMD_RES_ERR,
@@ -627,7 +1105,7 @@ static int crinitExecRtimCmdAddTask(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
 
     crinitDbgInfoPrint("Task extracted without error.");
     bool overwrite = false;
-    if (strcmp(cmd->args[1], "true") == 0) {
+    if (strcmp(cmd->args[1].str, "true") == 0) {
         overwrite = true;
     }
 
@@ -637,6 +1115,10 @@ static int crinitExecRtimCmdAddTask(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
                                   "Could not insert new task into TaskDB.");
     }
     crinitFreeTask(t);
+    // The task is in the TaskDB already, so only report problems with the analysis.
+    if (crinitTaskGraphUpdate(ctx) == -1) {
+        crinitErrPrint("Could not analyze task dependencies after adding a task.");
+    }
     return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDTASK, 1, CRINIT_RTIMCMD_RES_OK);
 }
 
@@ -647,7 +1129,7 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
 
     crinitDbgInfoPrint("Will execute runtime command \'ADDSERIES\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
 
     if (cmd->argc != 2) {
@@ -655,7 +1137,7 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
                                   "Wrong number of arguments.");
     }
 
-    if (!crinitIsAbsPath(cmd->args[0])) {
+    if (!crinitIsAbsPath(cmd->args[0].str)) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Path to series file must be absolute.");
     }
@@ -679,7 +1161,7 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
                                   "Could not release exclusive access to global option storage.");
     }
 
-    if (crinitLoadSeriesConf(cmd->args[0]) == -1) {
+    if (crinitLoadSeriesConf(cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not load series file.");
     }
@@ -691,10 +1173,20 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
     }
 
     bool overwriteTasks = false;
-    if (strcmp(cmd->args[1], "true") == 0) {
+    if (strcmp(cmd->args[1].str, "true") == 0) {
         overwriteTasks = true;
     }
 
+    // Collect all tasks first so they can be moved into the TaskDB in one go.
+    crinitTask_t **tasks = calloc(taskSeries.size, sizeof(*tasks));
+    if (tasks == NULL && taskSeries.size > 0) {
+        crinitDestroyFileSeries(&taskSeries);
+        crinitTaskDBSetSpawnInhibit(ctx, false);
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR,
+                                  "Memory allocation error.");
+    }
+    size_t numTasks = 0;
+    const char *errMsg = NULL;
     for (size_t n = 0; n < taskSeries.size; n++) {
         char *confFn = taskSeries.fnames[n];
         bool confFnAllocated = false;
@@ -703,10 +1195,8 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
             size_t suffixLen = strlen(taskSeries.fnames[n]);
             confFn = malloc(prefixLen + suffixLen + 2);
             if (confFn == NULL) {
-                crinitDestroyFileSeries(&taskSeries);
-                crinitTaskDBSetSpawnInhibit(ctx, false);
-                return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR,
-                                          "Memory allocation error.");
+                errMsg = "Memory allocation error.";
+                break;
             }
             memcpy(confFn, taskSeries.baseDir, prefixLen);
             confFn[prefixLen] = '/';
@@ -720,10 +1210,8 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
             if (confFnAllocated) {
                 free(confFn);
             }
-            crinitDestroyFileSeries(&taskSeries);
-            crinitTaskDBSetSpawnInhibit(ctx, false);
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not parse config file.");
+            errMsg = "Could not parse config file.";
+            break;
         }
         crinitInfoPrint("File \'%s\' loaded.", confFn);
         if (confFnAllocated) {
@@ -733,24 +1221,31 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
         crinitTask_t *t = NULL;
         if (crinitTaskCreateFromConfKvList(&t, c) == -1) {
             crinitFreeConfList(c);
-            crinitDestroyFileSeries(&taskSeries);
-            crinitTaskDBSetSpawnInhibit(ctx, false);
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not create task from config file.");
+            errMsg = "Could not create task from config file.";
+            break;
         }
 
         crinitFreeConfList(c);
-        if (crinitTaskDBInsert(ctx, t, overwriteTasks) == -1) {
-            crinitFreeTask(t);
-            crinitDestroyFileSeries(&taskSeries);
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDTASK, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not insert new task into TaskDB.");
-        }
+        tasks[numTasks++] = t;
+    }
+    crinitDestroyFileSeries(&taskSeries);
 
-        crinitFreeTask(t);
+    if (errMsg == NULL && crinitTaskDBInsertBatch(ctx, tasks, numTasks, overwriteTasks) == -1) {
+        errMsg = "Could not insert new tasks into TaskDB.";
+    }
+    for (size_t n = 0; n < numTasks; n++) {
+        crinitFreeTask(tasks[n]);
+    }
+    free(tasks);
+    // Update the spawn priorities before spawning is re-enabled, even if only some of the tasks were added.
+    if (crinitTaskGraphUpdate(ctx) == -1) {
+        crinitErrPrint("Could not analyze task dependencies after adding a series.");
+    }
+    if (errMsg != NULL) {
+        crinitTaskDBSetSpawnInhibit(ctx, false);
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR, errMsg);
     }
 
-    crinitDestroyFileSeries(&taskSeries);
     if (crinitTaskDBSetSpawnInhibit(ctx, false) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ADDSERIES, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not re-enable spawning of processes.");
@@ -761,61 +1256,41 @@ static int crinitExecRtimCmdAddSeries(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
 static int crinitExecRtimCmdEnable(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'ENABLE\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
     if (cmd->argc != 1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ENABLE, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Wrong number of arguments.");
     }
-    const char depStr[] = "@ctl\0enable";
-    crinitTaskDep_t tempDep = {NULL, NULL};
-    tempDep.name = malloc(sizeof(depStr));
-    if (tempDep.name == NULL) {
-        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ENABLE, 2, CRINIT_RTIMCMD_RES_ERR, "Memory allocation error.");
-    }
-    memcpy(tempDep.name, depStr, sizeof(depStr));
-    tempDep.event = tempDep.name + strlen(tempDep.name) + 1;
-
-    if (crinitTaskDBRemoveDepFromTask(ctx, &tempDep, cmd->args[0]) == -1) {
-        free(tempDep.name);
+    const crinitTaskDep_t tempDep = {"@ctl", "enable"};
+    if (crinitTaskDBRemoveDepFromTask(ctx, &tempDep, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ENABLE, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not remove \'enable\' dependency from task.");
     }
-    free(tempDep.name);
     return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_ENABLE, 1, CRINIT_RTIMCMD_RES_OK);
 }
 
 static int crinitExecRtimCmdDisable(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'DISABLE\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
     if (cmd->argc != 1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_DISABLE, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Wrong number of arguments.");
     }
-    const char newDepStr[] = "@ctl\0enable";
-    crinitTaskDep_t tempDep = {NULL, NULL};
-    tempDep.name = malloc(sizeof(newDepStr));
-    if (tempDep.name == NULL) {
-        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_DISABLE, 2, CRINIT_RTIMCMD_RES_ERR, "Memory allocation error.");
-    }
-    memcpy(tempDep.name, newDepStr, sizeof(newDepStr));
-    tempDep.event = tempDep.name + strlen(tempDep.name) + 1;
-
-    if (crinitTaskDBAddDepToTask(ctx, &tempDep, cmd->args[0]) == -1) {
-        free(tempDep.name);
+    const crinitTaskDep_t tempDep = {"@ctl", "enable"};
+    if (crinitTaskDBAddDepToTask(ctx, &tempDep, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_DISABLE, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not add dependency to task.");
     }
-    free(tempDep.name);
     return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_DISABLE, 1, CRINIT_RTIMCMD_RES_OK);
 }
 
 static int crinitExecRtimCmdStop(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'STOP\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
     if (cmd->argc != 1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STOP, 2, CRINIT_RTIMCMD_RES_ERR, "Wrong number of arguments.");
@@ -827,29 +1302,36 @@ static int crinitExecRtimCmdStop(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, cons
                                   "Could not inhibit waiting for processes.");
     }
 
-    if (crinitTaskDBSetTaskRespawnInhibit(ctx, true, cmd->args[0]) != 0) {
+    if (crinitTaskDBSetTaskRespawnInhibit(ctx, true, cmd->args[0].str) != 0) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STOP, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not access task to set respawnInhibit.");
     }
 
-    crinitTask_t *pTask;
-    if (crinitTaskDBGetTaskByName(ctx, &pTask, cmd->args[0]) != 0) {
+    crinitTaskCfg_t *cfg = NULL;
+    if (crinitTaskDBGetTaskCfg(ctx, &cfg, cmd->args[0].str) != 0) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STOP, 2, CRINIT_RTIMCMD_RES_ERR, "Could not access task.");
     }
-    if (pTask->stopCmdsSize > 0) {
+    if (cfg->task.stopCmdsSize > 0) {
         if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+            crinitTaskCfgRelease(cfg);
             return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STOP, 2, CRINIT_RTIMCMD_RES_ERR,
                                       "Could not prepare to spawn STOP_COMMAND(s).");
         }
-        if (ctx->spawnFunc(ctx, pTask, CRINIT_DISPATCH_THREAD_MODE_STOP) == -1) {
-            crinitErrPrint("Could not spawn new thread for execution STOP_COMMAND of task \'%s\'.", pTask->name);
+        if (ctx->spawnFunc(ctx, &cfg->task, CRINIT_DISPATCH_THREAD_MODE_STOP) == -1) {
+            crinitErrPrint("Could not spawn new thread for execution STOP_COMMAND of task \'%s\'.", cfg->task.name);
             pthread_mutex_unlock(&ctx->lock);
+            crinitTaskCfgRelease(cfg);
             return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STOP, 2, CRINIT_RTIMCMD_RES_ERR,
                                       "Could not spawn STOP_COMMAND(s).");
         }
         pthread_mutex_unlock(&ctx->lock);
+        crinitTaskCfgRelease(cfg);
     } else {
-        pid_t taskPid = pTask->pid;
+        crinitTaskCfgRelease(cfg);
+        pid_t taskPid = 0;
+        if (crinitTaskDBGetTaskPID(ctx, &taskPid, cmd->args[0].str) == -1) {
+            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STOP, 2, CRINIT_RTIMCMD_RES_ERR, "Could not access task.");
+        }
         if (taskPid <= 0) {
             return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STOP, 2, CRINIT_RTIMCMD_RES_ERR,
                                       "No PID registered for task.");
@@ -869,7 +1351,7 @@ static int crinitExecRtimCmdStop(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, cons
 static int crinitExecRtimCmdKill(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'KILL\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
     if (cmd->argc != 1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_KILL, 2, CRINIT_RTIMCMD_RES_ERR, "Wrong number of arguments.");
@@ -880,7 +1362,7 @@ static int crinitExecRtimCmdKill(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, cons
                                   "Could not inhibit waiting for processes.");
     }
     pid_t taskPid = 0;
-    if (crinitTaskDBGetTaskPID(ctx, &taskPid, cmd->args[0]) == -1) {
+    if (crinitTaskDBGetTaskPID(ctx, &taskPid, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_KILL, 2, CRINIT_RTIMCMD_RES_ERR, "Could not access task.");
     }
     if (taskPid <= 0) {
@@ -900,7 +1382,7 @@ static int crinitExecRtimCmdKill(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, cons
 static int crinitExecRtimCmdRestart(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'RESTART\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
     if (cmd->argc != 1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_RESTART, 2, CRINIT_RTIMCMD_RES_ERR,
@@ -908,7 +1390,7 @@ static int crinitExecRtimCmdRestart(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
     }
 
     crinitTaskState_t s = 0;
-    if (crinitTaskDBGetTaskState(ctx, &s, cmd->args[0]) == -1) {
+    if (crinitTaskDBGetTaskState(ctx, &s, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_RESTART, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not get task state from TaskDB.");
     }
@@ -918,11 +1400,11 @@ static int crinitExecRtimCmdRestart(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
                                   "Task is not either DONE or FAILED.");
     }
 
-    if (crinitTaskDBSetTaskRespawnInhibit(ctx, false, cmd->args[0]) == -1) {
+    if (crinitTaskDBSetTaskRespawnInhibit(ctx, false, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_RESTART, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Failed to reset the task respawn inhibit flag.");
     }
-    if (crinitTaskDBSetTaskState(ctx, 0, cmd->args[0]) == -1) {
+    if (crinitTaskDBSetTaskState(ctx, 0, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_RESTART, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Could not reset task state.");
     }
@@ -932,7 +1414,7 @@ static int crinitExecRtimCmdRestart(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, c
 static int crinitExecRtimCmdNotify(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'NOTIFY\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
 
     // Notify library will need to send task name. So process dispatch will need to set it in an environment for
@@ -942,76 +1424,14 @@ static int crinitExecRtimCmdNotify(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, co
                                   "Wrong number of arguments.");
     }
 
-    pid_t pid = -1;
-    int ready = -1;
-    int stopping = -1;
-
+    crinitTaskNotify_t n = CRINIT_TASK_NOTIFY_INIT;
     for (size_t i = 1; i < cmd->argc; i++) {
-        size_t argLen = strlen(cmd->args[i]);
-        const char *delim = strchr(cmd->args[i], '=');
-        if (delim != NULL) {
-            size_t cmpLen = delim - cmd->args[i];
-            delim++;
-            if (cmpLen < argLen) {
-                if (strncmp(cmd->args[i], "MAINPID", cmpLen) == 0) {
-                    pid = strtol(delim, NULL, 10);
-                }
-                if (strncmp(cmd->args[i], "READY", cmpLen) == 0) {
-                    ready = strtol(delim, NULL, 10);
-                }
-                if (strncmp(cmd->args[i], "STOPPING", cmpLen) == 0) {
-                    stopping = strtol(delim, NULL, 10);
-                }
-            }
-        }
-    }
-
-    if (pid > 0) {
-        if (crinitTaskDBSetTaskPID(ctx, pid, cmd->args[0]) == -1) {
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not set main PID of task.");
-        }
-    }
-
-    if (ready > 0) {
-        const crinitTaskState_t s = CRINIT_TASK_STATE_RUNNING | CRINIT_TASK_STATE_NOTIFIED;
-        char depEvent[] = CRINIT_TASK_EVENT_RUNNING CRINIT_TASK_EVENT_NOTIFY_SUFFIX;
-        if (crinitTaskDBSetTaskState(ctx, s, cmd->args[0]) == -1) {
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not set task state to RUNNING.");
-        }
-
-        crinitTaskDep_t dep = {cmd->args[0], depEvent};
-        if (crinitTaskDBFulfillDep(ctx, &dep, NULL) == -1) {
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not fulfill dependency \'%s:%s\'.", cmd->args[0], depEvent);
-        }
-
-        if (crinitTaskDBProvideFeatureByTaskName(ctx, cmd->args[0], s) == -1) {
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not set features of spawned task \'%s\' as provided.", cmd->args[0]);
-        }
+        crinitTaskNotifyParse(&n, cmd->args[i].str, strlen(cmd->args[i].str));
     }
 
-    if (stopping > 0) {
-        const crinitTaskState_t s = CRINIT_TASK_STATE_DONE | CRINIT_TASK_STATE_NOTIFIED;
-        char depEvent[] = CRINIT_TASK_EVENT_DONE CRINIT_TASK_EVENT_NOTIFY_SUFFIX;
-
-        if (crinitTaskDBSetTaskState(ctx, s, cmd->args[0]) == -1) {
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not set task state to DONE.");
-        }
-
-        const crinitTaskDep_t dep = {cmd->args[0], depEvent};
-        if (crinitTaskDBFulfillDep(ctx, &dep, NULL) == -1) {
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not fulfill dependency \'%s:%s\'.", cmd->args[0], depEvent);
-        }
-
-        if (crinitTaskDBProvideFeatureByTaskName(ctx, cmd->args[0], s) == -1) {
-            return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
-                                      "Could not set features of spawned task \'%s\' as provided.", cmd->args[0]);
-        }
+    if (crinitTaskDBNotify(ctx, cmd->args[0].str, &n) == -1) {
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 2, CRINIT_RTIMCMD_RES_ERR,
+                                  "Could not apply notification to task.");
     }
 
     return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_NOTIFY, 1, CRINIT_RTIMCMD_RES_OK);
@@ -1020,104 +1440,39 @@ static int crinitExecRtimCmdNotify(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, co
 static int crinitExecRtimCmdStatus(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'STATUS\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
     if (cmd->argc != 1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUS, 2, CRINIT_RTIMCMD_RES_ERR,
                                   "Wrong number of arguments.");
     }
-    crinitTaskState_t s;
-    pid_t pid;
-    struct timespec creation, start, end;
-    gid_t group;
-    uid_t user;
-    char *username = NULL;
-    char *groupname = NULL;
-
-    crinitTask_t *pTask = crinitTaskDBBorrowTask(ctx, cmd->args[0]);
-    if (pTask == NULL) {
+    crinitTaskDBStatus_t st;
+    if (crinitTaskDBGetTaskStatus(ctx, &st, cmd->args[0].str) == -1) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUS, 2, CRINIT_RTIMCMD_RES_ERR,
-                                  "Could not get access to requested task in TaskDB.");
-    }
-
-    s = pTask->state;
-    pid = pTask->pid;
-    creation = pTask->createTime;
-    start = pTask->startTime;
-    end = pTask->endTime;
-    group = pTask->group;
-    user = pTask->user;
-    if (pTask->username) {
-        username = strdup(pTask->username);
-    } else {
-        username = strdup("root");
-    }
-    if (pTask->groupname) {
-        groupname = strdup(pTask->groupname);
-    } else {
-        groupname = strdup("root");
-    }
-
-    if (crinitTaskDBRemit(ctx) == -1) {
-        crinitErrPrint(
-            "Could not release mutex on TaskDB. This should not happen. Will try to continue but Crinit may lock up.");
-    }
-
-    const char *resFmt = "%lu\n%d\n%lld.%.9ld\n%lld.%.9ld\n%lld.%.9ld\n%d\n%d\n%s\n%s";
-    size_t resStrLen = 1 + snprintf(NULL, 0, resFmt, s, pid, creation.tv_sec, creation.tv_nsec, start.tv_sec,
-                                    start.tv_nsec, end.tv_sec, end.tv_nsec, user, group, username, groupname);
-    char *resStr = malloc(resStrLen);
-    if (resStr == NULL) {
-        free(username);
-        free(groupname);
-        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUS, 2, CRINIT_RTIMCMD_RES_ERR, "Memory allocation error.");
-    }
-    snprintf(resStr, resStrLen, resFmt, s, pid, creation.tv_sec, creation.tv_nsec, start.tv_sec, start.tv_nsec,
-             end.tv_sec, end.tv_nsec, user, group, username, groupname);
-
-    free(username);
-    free(groupname);
-    username = NULL;
-    groupname = NULL;
-
-    char *pidStr = strchr(resStr, '\n');
-    *pidStr = '\0';
-    pidStr++;
-    char *ctStr = strchr(pidStr, '\n');
-    *ctStr = '\0';
-    ctStr++;
-    char *stStr = strchr(ctStr, '\n');
-    *stStr = '\0';
-    stStr++;
-    char *etStr = strchr(stStr, '\n');
-    *etStr = '\0';
-    etStr++;
-    char *userStr = strchr(etStr, '\n');
-    *userStr = '\0';
-    userStr++;
-    char *groupStr = strchr(userStr, '\n');
-    *groupStr = '\0';
-    groupStr++;
-    char *usernameStr = strchr(groupStr, '\n');
-    *usernameStr = '\0';
-    usernameStr++;
-    char *groupnameStr = strchr(usernameStr, '\n');
-    *groupnameStr = '\0';
-    groupnameStr++;
-
-    if (crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUS, 10, CRINIT_RTIMCMD_RES_OK, resStr, pidStr, ctStr, stStr, etStr,
-                           userStr, groupStr, usernameStr, groupnameStr) == -1) {
-        free(resStr);
-        return -1;
-    }
-    free(resStr);
-    return 0;
+                                  "Could not get status of requested task from TaskDB.");
+    }
+    const crinitRtimArg_t args[] = {
+        CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK),
+        CRINIT_RTIMARG_UINT(st.state),
+        CRINIT_RTIMARG_INT(st.pid),
+        CRINIT_RTIMARG_TIME(st.createTime),
+        CRINIT_RTIMARG_TIME(st.startTime),
+        CRINIT_RTIMARG_TIME(st.endTime),
+        CRINIT_RTIMARG_UINT(st.user),
+        CRINIT_RTIMARG_UINT(st.group),
+        CRINIT_RTIMARG_STR((st.username != NULL) ? st.username : "root"),
+        CRINIT_RTIMARG_STR((st.groupname != NULL) ? st.groupname : "root"),
+    };
+    int ret = crinitBuildRtimCmdArgs(res, CRINIT_RTIMCMD_R_STATUS, sizeof(args) / sizeof(args[0]), args);
+    free(st.username);
+    free(st.groupname);
+    return ret;
 }
 
 static int crinitExecRtimCmdTaskList(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     crinitDbgInfoPrint("Will execute runtime command \'TASKLIST\' with following arguments:");
     for (size_t i = 0; i < cmd->argc; i++) {
-        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i]);
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
     }
     if (cmd->argc != 0) {
         return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_TASKLIST, 2, CRINIT_RTIMCMD_RES_ERR,
@@ -1155,6 +1510,153 @@ out:
     return ret;
 }
 
+static int crinitExecRtimCmdDepGraph(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
+    crinitDbgInfoPrint("Will execute runtime command \'DEPGRAPH\' with following arguments:");
+    for (size_t i = 0; i < cmd->argc; i++) {
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
+    }
+    if (cmd->argc != 0) {
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_DEPGRAPH, 2, CRINIT_RTIMCMD_RES_ERR,
+                                  "Wrong number of arguments.");
+    }
+
+    crinitTaskGraph_t graph;
+    if (crinitTaskGraphAnalyze(&graph, ctx) == -1) {
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_DEPGRAPH, 2, CRINIT_RTIMCMD_RES_ERR,
+                                  "Could not analyze dependency graph.");
+    }
+
+    // Each task is described by its name followed by the numeric fields level, critical path, priority and flags.
+    size_t argc = 1 + CRINIT_DEPGRAPH_FIELDS * graph.numNodes;
+    crinitRtimArg_t *args = malloc(argc * sizeof(*args));
+    if (args == NULL) {
+        crinitTaskGraphDestroy(&graph);
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_DEPGRAPH, 2, CRINIT_RTIMCMD_RES_ERR,
+                                  "Memory allocation error.");
+    }
+
+    args[0] = (crinitRtimArg_t)CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK);
+    for (size_t i = 0; i < graph.numNodes; i++) {
+        const crinitTaskGraphNode_t *v = &graph.nodes[i];
+        crinitRtimArg_t *taskArgs = &args[1 + i * CRINIT_DEPGRAPH_FIELDS];
+        taskArgs[0] = (crinitRtimArg_t)CRINIT_RTIMARG_STR(v->name);
+        taskArgs[1] = (crinitRtimArg_t)CRINIT_RTIMARG_UINT(v->level);
+        taskArgs[2] = (crinitRtimArg_t)CRINIT_RTIMARG_UINT(v->critPath);
+        taskArgs[3] = (crinitRtimArg_t)CRINIT_RTIMARG_UINT(v->prio);
+        taskArgs[4] = (crinitRtimArg_t)CRINIT_RTIMARG_UINT(v->flags);
+    }
+
+    int ret = crinitBuildRtimCmdArgs(res, CRINIT_RTIMCMD_R_DEPGRAPH, argc, args);
+    free(args);
+    crinitTaskGraphDestroy(&graph);
+    return ret;
+}
+
+static int crinitExecRtimCmdUsage(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
+    crinitDbgInfoPrint("Will execute runtime command \'USAGE\' with following arguments:");
+    for (size_t i = 0; i < cmd->argc; i++) {
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
+    }
+    if (cmd->argc != 1) {
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_USAGE, 2, CRINIT_RTIMCMD_RES_ERR, "Wrong number of arguments.");
+    }
+    crinitTaskDBStatus_t st;
+    if (crinitTaskDBGetTaskStatus(ctx, &st, cmd->args[0].str) == -1) {
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_USAGE, 2, CRINIT_RTIMCMD_RES_ERR,
+                                  "Could not get resource usage of requested task from TaskDB.");
+    }
+    free(st.username);
+    free(st.groupname);
+
+    const crinitTaskUsage_t *u = &st.usage;
+    // Send the fields in the order of their declaration in crinitTaskUsage_t.
+    const unsigned long long fields[CRINIT_TASKUSAGE_FIELDS] = {u->userTime,   u->sysTime,  u->maxRss,     u->volCtxSw,
+                                                                u->involCtxSw, u->numProcs, u->lastRuntime};
+    crinitRtimArg_t args[1 + CRINIT_TASKUSAGE_FIELDS] = {CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK)};
+    for (size_t i = 0; i < CRINIT_TASKUSAGE_FIELDS; i++) {
+        args[1 + i] = (crinitRtimArg_t)CRINIT_RTIMARG_UINT(fields[i]);
+    }
+    return crinitBuildRtimCmdArgs(res, CRINIT_RTIMCMD_R_USAGE, 1 + CRINIT_TASKUSAGE_FIELDS, args);
+}
+
+static int crinitExecRtimCmdStatusList(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
+    crinitDbgInfoPrint("Will execute runtime command \'STATUSLIST\' with following arguments:");
+    for (size_t i = 0; i < cmd->argc; i++) {
+        crinitDbgInfoPrint("    args[%zu] = %s", i, cmd->args[i].str);
+    }
+
+    int ret = 0;
+    crinitTaskListFilter_t filter = {0};
+    const char **names = malloc((cmd->argc + 1) * sizeof(*names));
+    crinitTaskDBStatus_t *tasks = NULL;
+    size_t numTasks = 0;
+    crinitRtimArg_t *args = NULL;
+    if (names == NULL) {
+        return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUSLIST, 2, CRINIT_RTIMCMD_RES_ERR,
+                                  "Memory allocation error.");
+    }
+
+    for (size_t i = 0; i < cmd->argc; i++) {
+        const char *arg = cmd->args[i].str;
+        if (strncmp(arg, CRINIT_RTIMCMD_FILTER_STATE, strlen(CRINIT_RTIMCMD_FILTER_STATE)) == 0) {
+            const char *val = arg + strlen(CRINIT_RTIMCMD_FILTER_STATE);
+            char *end = NULL;
+            errno = 0;
+            filter.stateMask = strtoul(val, &end, 0);
+            if (errno == 0 && end != val && *end == '\0') {
+                continue;
+            }
+        } else if (strncmp(arg, CRINIT_RTIMCMD_FILTER_PREFIX, strlen(CRINIT_RTIMCMD_FILTER_PREFIX)) == 0) {
+            filter.prefix = arg + strlen(CRINIT_RTIMCMD_FILTER_PREFIX);
+            continue;
+        } else if (strncmp(arg, CRINIT_RTIMCMD_FILTER_NAME, strlen(CRINIT_RTIMCMD_FILTER_NAME)) == 0) {
+            names[filter.numNames++] = arg + strlen(CRINIT_RTIMCMD_FILTER_NAME);
+            continue;
+        }
+        ret = crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUSLIST, 2, CRINIT_RTIMCMD_RES_ERR, "Invalid filter.");
+        goto out;
+    }
+    filter.names = names;
+
+    if (crinitTaskDBExportTaskStatus(ctx, &tasks, &numTasks, &filter) == -1) {
+        ret = crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUSLIST, 2, CRINIT_RTIMCMD_RES_ERR,
+                                 "Could not get status of tasks from TaskDB.");
+        goto out;
+    }
+
+    args = malloc((1 + numTasks * CRINIT_TASKSTATUS_FIELDS) * sizeof(*args));
+    if (args == NULL) {
+        ret = crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_STATUSLIST, 2, CRINIT_RTIMCMD_RES_ERR,
+                                 "Memory allocation error.");
+        goto out;
+    }
+    args[0] = (crinitRtimArg_t)CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK);
+    for (size_t i = 0; i < numTasks; i++) {
+        const crinitTaskDBStatus_t *st = &tasks[i];
+        const crinitRtimArg_t fields[CRINIT_TASKSTATUS_FIELDS] = {
+            CRINIT_RTIMARG_STR(st->name),
+            CRINIT_RTIMARG_UINT(st->state),
+            CRINIT_RTIMARG_INT(st->pid),
+            CRINIT_RTIMARG_TIME(st->createTime),
+            CRINIT_RTIMARG_TIME(st->startTime),
+            CRINIT_RTIMARG_TIME(st->endTime),
+            CRINIT_RTIMARG_UINT(st->user),
+            CRINIT_RTIMARG_UINT(st->group),
+            CRINIT_RTIMARG_STR((st->username != NULL) ? st->username : "root"),
+            CRINIT_RTIMARG_STR((st->groupname != NULL) ? st->groupname : "root"),
+            CRINIT_RTIMARG_INT(st->failCount),
+        };
+        memcpy(&args[1 + i * CRINIT_TASKSTATUS_FIELDS], fields, sizeof(fields));
+    }
+    ret = crinitBuildRtimCmdArgs(res, CRINIT_RTIMCMD_R_STATUSLIST, 1 + numTasks * CRINIT_TASKSTATUS_FIELDS, args);
+
+out:
+    free(args);
+    free(tasks);
+    free(names);
+    return ret;
+}
+
 static int crinitExecRtimCmdGetVer(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
     if (ctx == NULL || res == NULL || cmd == NULL) {
         crinitErrPrint("Pointer parameters must not be NULL");
@@ -1167,13 +1669,12 @@ static int crinitExecRtimCmdGetVer(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, co
                                   "Wrong number of arguments.");
     }
 
-    char major[8] = {'\0'}, minor[8] = {'\0'}, micro[8] = {'\0'};
-    snprintf(major, sizeof(major) - 1, "%u", crinitVersion.major);
-    snprintf(minor, sizeof(minor) - 1, "%u", crinitVersion.minor);
-    snprintf(micro, sizeof(micro) - 1, "%u", crinitVersion.micro);
-
-    return crinitBuildRtimCmd(res, CRINIT_RTIMCMD_R_GETVER, 5, CRINIT_RTIMCMD_RES_OK, major, minor, micro,
-                              crinitVersion.git);
+    const crinitRtimArg_t args[] = {
+        CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK), CRINIT_RTIMARG_UINT(crinitVersion.major),
+        CRINIT_RTIMARG_UINT(crinitVersion.minor),  CRINIT_RTIMARG_UINT(crinitVersion.micro),
+        CRINIT_RTIMARG_STR(crinitVersion.git),
+    };
+    return crinitBuildRtimCmdArgs(res, CRINIT_RTIMCMD_R_GETVER, sizeof(args) / sizeof(args[0]), args);
 }
 
 static int crinitExecRtimCmdShutdown(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
@@ -1195,7 +1696,7 @@ static int crinitExecRtimCmdShutdown(crinitTaskDB_t *ctx, crinitRtimCmd_t *res,
     }
 
     thrArgs->ctx = ctx;
-    crinitShutdownCmd_t sCmd = (crinitShutdownCmd_t)strtol(cmd->args[0], NULL, 10);
+    crinitShutdownCmd_t sCmd = (crinitShutdownCmd_t)strtol(cmd->args[0].str, NULL, 10);
     switch (sCmd) {
         case CRINIT_SHD_POWEROFF:
             thrArgs->shutdownCmd = RB_POWER_OFF;
@@ -1234,15 +1735,17 @@ static void *crinitShdnThread(void *args) {
 
     bool haveStopCommands = false;
     if ((errno = pthread_mutex_lock(&ctx->lock)) == 0) {
-        crinitTask_t *pTask;
-        crinitTaskDbForEach(ctx, pTask) {
-            if (pTask->stopCmdsSize > 0) {
-                haveStopCommands = true;
-                if (ctx->spawnFunc(ctx, pTask, CRINIT_DISPATCH_THREAD_MODE_STOP) == -1) {
-                    crinitErrPrint("Could not spawn new thread for execution STOP_COMMAND of task \'%s\'.",
-                                   pTask->name);
-                }
+        for (crinitTaskHandle_t h = 0; h < ctx->taskSetItems; h++) {
+            if (crinitTaskDBTaskAt(ctx, h)->stopCmdsSize == 0) {
+                continue;
+            }
+            haveStopCommands = true;
+            crinitTaskCfg_t *cfg = crinitTaskDBPinTaskCfg(ctx, h);
+            if (cfg == NULL || ctx->spawnFunc(ctx, &cfg->task, CRINIT_DISPATCH_THREAD_MODE_STOP) == -1) {
+                crinitErrPrint("Could not spawn new thread for execution STOP_COMMAND of task \'%s\'.",
+                               crinitTaskDBTaskAt(ctx, h)->name);
             }
+            crinitTaskCfgRelease(cfg);
         }
         pthread_mutex_unlock(&ctx->lock);
     }
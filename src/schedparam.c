@@ -0,0 +1,418 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file schedparam.c
+ * @brief Implementation of per-task scheduling parameters.
+ */
+#define _GNU_SOURCE  ///< Needed for SCHED_BATCH and SCHED_IDLE.
+#include "schedparam.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "logio.h"
+
+/** Shift of the I/O scheduling class in an I/O priority value, see linux/ioprio.h. **/
+#define CRINIT_IOPRIO_CLASS_SHIFT 13
+/** Mask of the level in an I/O priority value. **/
+#define CRINIT_IOPRIO_LEVEL_MASK ((1 << CRINIT_IOPRIO_CLASS_SHIFT) - 1)
+/** Highest level (i.e. lowest priority) of the realtime and best-effort I/O scheduling classes. **/
+#define CRINIT_IOPRIO_LEVEL_MAX 7
+/** Level used for the realtime and best-effort I/O scheduling classes if none is given. **/
+#define CRINIT_IOPRIO_LEVEL_DEFAULT 4
+/** `which` argument of ioprio_set() to address a single process. **/
+#define CRINIT_IOPRIO_WHO_PROCESS 1
+
+/** Path to the OOM score adjustment of the calling process. **/
+#define CRINIT_OOM_SCORE_ADJ_PATH "/proc/self/oom_score_adj"
+/** Lowest valid OOM score adjustment. **/
+#define CRINIT_OOM_SCORE_ADJ_MIN (-1000)
+/** Highest valid OOM score adjustment. **/
+#define CRINIT_OOM_SCORE_ADJ_MAX 1000
+
+/** Tests if a CPU is part of crinitSchedParams_t::affinity. **/
+#define crinitSchedCpuIsSet(cpu, mask) \
+    (((mask)[(cpu) / CRINIT_SCHED_CPUS_PER_WORD] >> ((cpu) % CRINIT_SCHED_CPUS_PER_WORD)) & 1uL)
+
+/** Lowest valid nice value. **/
+#define CRINIT_NICE_MIN (-20)
+/** Highest valid nice value. **/
+#define CRINIT_NICE_MAX 19
+
+/**
+ * Type to map a name from the configuration to a numeric value.
+ */
+typedef struct crinitSchedName {
+    const char *name;  ///< The name as used in the configuration.
+    int value;         ///< The corresponding value.
+    bool hasLevel;     ///< If true, the name is followed by a colon and a priority or level.
+} crinitSchedName_t;
+
+/** Names of the supported scheduling policies. **/
+static const crinitSchedName_t crinitSchedPolicyNames[] = {
+    {"other", SCHED_OTHER, false}, {"batch", SCHED_BATCH, false}, {"idle", SCHED_IDLE, false},
+    {"fifo", SCHED_FIFO, true},    {"rr", SCHED_RR, true},
+};
+
+/** Names of the supported I/O scheduling classes. **/
+static const crinitSchedName_t crinitIoPrioClassNames[] = {
+    {"realtime", 1, true},
+    {"best-effort", 2, true},
+    {"idle", 3, false},
+};
+
+/** Launcher option names of the parameters in crinitSchedParam_t. **/
+static const char *const crinitSchedParamNames[] = {
+    [CRINIT_SCHED_PARAM_AFFINITY] = CRINIT_SCHED_LAUNCHOPT_AFFINITY,
+    [CRINIT_SCHED_PARAM_POLICY] = CRINIT_SCHED_LAUNCHOPT_POLICY,
+    [CRINIT_SCHED_PARAM_NICE] = CRINIT_SCHED_LAUNCHOPT_NICE,
+    [CRINIT_SCHED_PARAM_IOPRIO] = CRINIT_SCHED_LAUNCHOPT_IOPRIO,
+    [CRINIT_SCHED_PARAM_OOM_SCORE_ADJ] = CRINIT_SCHED_LAUNCHOPT_OOM_SCORE_ADJ,
+};
+
+/**
+ * Parse a decimal integer within a given range.
+ *
+ * @param out  Return pointer for the parsed value.
+ * @param val  The string to parse, may be followed by other characters if \a end is not NULL.
+ * @param end  Return pointer for the first character after the number, if NULL the whole string must be a number.
+ * @param min  The lowest accepted value.
+ * @param max  The highest accepted value.
+ *
+ * @return  0 on success, -1 on error
+ */
+static int crinitSchedParseInt(int *out, const char *val, const char **end, long min, long max);
+/**
+ * Parse a name from a crinitSchedName_t table, optionally followed by a colon and a number.
+ *
+ * @param value      Return pointer for the value corresponding to the name.
+ * @param level      Return pointer for the number after the name, set to \a levelDef if there is none.
+ * @param val        The string to parse.
+ * @param names      The table of valid names.
+ * @param namesSize  The number of elements in \a names.
+ * @param levelDef   The number to return if the name is not followed by one.
+ *
+ * @return  0 on success, -1 on error
+ */
+static int crinitSchedParseName(int *value, int *level, const char *val, const crinitSchedName_t *names,
+                                size_t namesSize, int levelDef);
+/**
+ * Parse a list of CPUs like `0-3,6` into a CPU bitmask.
+ *
+ * @param mask  The CPU bitmask to fill, see crinitSchedParams_t::affinity.
+ * @param val   The string to parse.
+ *
+ * @return  0 on success, -1 on error
+ */
+static int crinitSchedParseCpuList(unsigned long *mask, const char *val);
+/**
+ * Find the name of a value in a crinitSchedName_t table.
+ *
+ * @return  The entry with the given value or NULL if there is none.
+ */
+static const crinitSchedName_t *crinitSchedFindValue(int value, const crinitSchedName_t *names, size_t namesSize);
+/**
+ * Write a CPU bitmask as a list of CPUs and ranges in the format accepted by crinitSchedParseCpuList().
+ *
+ * Behaves like snprintf().
+ */
+static int crinitSchedPrintCpuList(char *buf, size_t bufSize, const unsigned long *mask);
+/**
+ * Write the OOM score adjustment of the calling process in an async-signal-safe way.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int crinitSchedSetOomScoreAdj(int adj);
+
+int crinitSchedParamsParse(crinitSchedParams_t *sp, crinitSchedParam_t param, const char *val) {
+    crinitNullCheck(-1, sp, val);
+
+    switch (param) {
+        case CRINIT_SCHED_PARAM_NICE:
+            if (crinitSchedParseInt(&sp->nice, val, NULL, CRINIT_NICE_MIN, CRINIT_NICE_MAX) == -1) {
+                crinitErrPrint("Nice value must be a number from %d to %d, got '%s'.", CRINIT_NICE_MIN, CRINIT_NICE_MAX,
+                               val);
+                return -1;
+            }
+            break;
+        case CRINIT_SCHED_PARAM_POLICY: {
+            int policy, priority;
+            if (crinitSchedParseName(&policy, &priority, val, crinitSchedPolicyNames,
+                                     crinitNumElements(crinitSchedPolicyNames), -1) == -1) {
+                crinitErrPrint("Unknown scheduling policy '%s'.", val);
+                return -1;
+            }
+            if (priority == -1) {
+                priority = 0;
+            }
+            int prioMin = sched_get_priority_min(policy);
+            int prioMax = sched_get_priority_max(policy);
+            if (prioMin == -1 || prioMax == -1) {
+                crinitErrnoPrint("Could not get the priority range of scheduling policy '%s'.", val);
+                return -1;
+            }
+            if (priority < prioMin || priority > prioMax) {
+                crinitErrPrint("The priority of scheduling policy '%s' must be from %d to %d.", val, prioMin, prioMax);
+                return -1;
+            }
+            sp->policy = policy;
+            sp->priority = priority;
+        } break;
+        case CRINIT_SCHED_PARAM_AFFINITY:
+            if (crinitSchedParseCpuList(sp->affinity, val) == -1) {
+                crinitErrPrint("Could not parse CPU list '%s'.", val);
+                return -1;
+            }
+            break;
+        case CRINIT_SCHED_PARAM_IOPRIO: {
+            int class, level;
+            if (crinitSchedParseName(&class, &level, val, crinitIoPrioClassNames,
+                                     crinitNumElements(crinitIoPrioClassNames), CRINIT_IOPRIO_LEVEL_DEFAULT) == -1 ||
+                level > CRINIT_IOPRIO_LEVEL_MAX) {
+                crinitErrPrint("Could not parse I/O priority '%s'.", val);
+                return -1;
+            }
+            sp->ioprio = (class << CRINIT_IOPRIO_CLASS_SHIFT) | level;
+        } break;
+        case CRINIT_SCHED_PARAM_OOM_SCORE_ADJ:
+            if (crinitSchedParseInt(&sp->oomScoreAdj, val, NULL, CRINIT_OOM_SCORE_ADJ_MIN, CRINIT_OOM_SCORE_ADJ_MAX) ==
+                -1) {
+                crinitErrPrint("OOM score adjustment must be a number from %d to %d, got '%s'.",
+                               CRINIT_OOM_SCORE_ADJ_MIN, CRINIT_OOM_SCORE_ADJ_MAX, val);
+                return -1;
+            }
+            break;
+        case CRINIT_SCHED_PARAMS_COUNT:
+        default:
+            crinitErrPrint("Unknown scheduling parameter %d.", param);
+            return -1;
+    }
+    sp->flags |= crinitSchedParamFlag(param);
+    return 0;
+}
+
+int crinitSchedParamsLauncherOpt(char *buf, size_t bufSize, const crinitSchedParams_t *sp, crinitSchedParam_t param) {
+    crinitNullCheck(-1, sp);
+    if (param >= CRINIT_SCHED_PARAMS_COUNT) {
+        crinitErrPrint("Unknown scheduling parameter %d.", param);
+        return -1;
+    }
+    if (!(sp->flags & crinitSchedParamFlag(param))) {
+        return 0;
+    }
+
+    const char *name = crinitSchedParamNames[param];
+    const crinitSchedName_t *n = NULL;
+    switch (param) {
+        case CRINIT_SCHED_PARAM_NICE:
+            return snprintf(buf, bufSize, "--%s=%d", name, sp->nice);
+        case CRINIT_SCHED_PARAM_POLICY:
+            n = crinitSchedFindValue(sp->policy, crinitSchedPolicyNames, crinitNumElements(crinitSchedPolicyNames));
+            if (n == NULL) {
+                crinitErrPrint("Unknown scheduling policy %d.", sp->policy);
+                return -1;
+            }
+            if (n->hasLevel) {
+                return snprintf(buf, bufSize, "--%s=%s:%d", name, n->name, sp->priority);
+            }
+            return snprintf(buf, bufSize, "--%s=%s", name, n->name);
+        case CRINIT_SCHED_PARAM_AFFINITY: {
+            int prefix = snprintf(buf, bufSize, "--%s=", name);
+            size_t off = ((size_t)prefix < bufSize) ? (size_t)prefix : bufSize;
+            int list = crinitSchedPrintCpuList((buf == NULL) ? NULL : buf + off, bufSize - off, sp->affinity);
+            return (list == -1) ? -1 : prefix + list;
+        }
+        case CRINIT_SCHED_PARAM_IOPRIO:
+            n = crinitSchedFindValue(sp->ioprio >> CRINIT_IOPRIO_CLASS_SHIFT, crinitIoPrioClassNames,
+                                     crinitNumElements(crinitIoPrioClassNames));
+            if (n == NULL) {
+                crinitErrPrint("Unknown I/O scheduling class %d.", sp->ioprio >> CRINIT_IOPRIO_CLASS_SHIFT);
+                return -1;
+            }
+            if (n->hasLevel) {
+                return snprintf(buf, bufSize, "--%s=%s:%d", name, n->name, sp->ioprio & CRINIT_IOPRIO_LEVEL_MASK);
+            }
+            return snprintf(buf, bufSize, "--%s=%s", name, n->name);
+        case CRINIT_SCHED_PARAM_OOM_SCORE_ADJ:
+            return snprintf(buf, bufSize, "--%s=%d", name, sp->oomScoreAdj);
+        case CRINIT_SCHED_PARAMS_COUNT:
+        default:
+            return -1;
+    }
+}
+
+int crinitSchedParamsApply(const crinitSchedParams_t *sp, crinitSchedParam_t *failed) {
+    for (crinitSchedParam_t param = 0; param < CRINIT_SCHED_PARAMS_COUNT; param++) {
+        if (!(sp->flags & crinitSchedParamFlag(param))) {
+            continue;
+        }
+        int ret = 0;
+        switch (param) {
+            case CRINIT_SCHED_PARAM_AFFINITY:
+                ret = (int)syscall(SYS_sched_setaffinity, 0, sizeof(sp->affinity), sp->affinity);
+                break;
+            case CRINIT_SCHED_PARAM_POLICY: {
+                struct sched_param schedParam = {.sched_priority = sp->priority};
+                ret = sched_setscheduler(0, sp->policy, &schedParam);
+            } break;
+            case CRINIT_SCHED_PARAM_NICE:
+                ret = setpriority(PRIO_PROCESS, 0, sp->nice);
+                break;
+            case CRINIT_SCHED_PARAM_IOPRIO:
+                ret = (int)syscall(SYS_ioprio_set, CRINIT_IOPRIO_WHO_PROCESS, 0, sp->ioprio);
+                break;
+            case CRINIT_SCHED_PARAM_OOM_SCORE_ADJ:
+                ret = crinitSchedSetOomScoreAdj(sp->oomScoreAdj);
+                break;
+            case CRINIT_SCHED_PARAMS_COUNT:
+            default:
+                errno = EINVAL;
+                ret = -1;
+                break;
+        }
+        if (ret == -1) {
+            if (failed != NULL) {
+                *failed = param;
+            }
+            return -1;
+        }
+    }
+    return 0;
+}
+
+const char *crinitSchedParamName(crinitSchedParam_t param) {
+    if (param >= CRINIT_SCHED_PARAMS_COUNT) {
+        return "unknown";
+    }
+    return crinitSchedParamNames[param];
+}
+
+static int crinitSchedParseInt(int *out, const char *val, const char **end, long min, long max) {
+    char *endPtr = NULL;
+    errno = 0;
+    long num = strtol(val, &endPtr, 10);
+    if (endPtr == val || errno != 0 || num < min || num > max || (end == NULL && *endPtr != '\0')) {
+        return -1;
+    }
+    if (end != NULL) {
+        *end = endPtr;
+    }
+    *out = (int)num;
+    return 0;
+}
+
+static int crinitSchedParseName(int *value, int *level, const char *val, const crinitSchedName_t *names,
+                                size_t namesSize, int levelDef) {
+    const char *colon = strchr(val, ':');
+    size_t nameLen = (colon == NULL) ? strlen(val) : (size_t)(colon - val);
+    for (size_t i = 0; i < namesSize; i++) {
+        if (strlen(names[i].name) != nameLen || strncasecmp(val, names[i].name, nameLen) != 0) {
+            continue;
+        }
+        *value = names[i].value;
+        *level = levelDef;
+        if (colon == NULL) {
+            return 0;
+        }
+        if (!names[i].hasLevel) {
+            return -1;
+        }
+        return crinitSchedParseInt(level, colon + 1, NULL, 0, INT_MAX);
+    }
+    return -1;
+}
+
+static int crinitSchedParseCpuList(unsigned long *mask, const char *val) {
+    unsigned long newMask[CRINIT_SCHED_AFFINITY_WORDS] = {0};
+    const char *p = val;
+    do {
+        int first, last;
+        if (crinitSchedParseInt(&first, p, &p, 0, CRINIT_SCHED_MAX_CPUS - 1) == -1) {
+            return -1;
+        }
+        last = first;
+        if (*p == '-' && crinitSchedParseInt(&last, p + 1, &p, first, CRINIT_SCHED_MAX_CPUS - 1) == -1) {
+            return -1;
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            newMask[cpu / CRINIT_SCHED_CPUS_PER_WORD] |= 1uL << (cpu % CRINIT_SCHED_CPUS_PER_WORD);
+        }
+        if (*p != ',' && *p != '\0') {
+            return -1;
+        }
+    } while (*p++ == ',');
+
+    memcpy(mask, newMask, sizeof(newMask));
+    return 0;
+}
+
+static const crinitSchedName_t *crinitSchedFindValue(int value, const crinitSchedName_t *names, size_t namesSize) {
+    for (size_t i = 0; i < namesSize; i++) {
+        if (names[i].value == value) {
+            return &names[i];
+        }
+    }
+    return NULL;
+}
+
+static int crinitSchedPrintCpuList(char *buf, size_t bufSize, const unsigned long *mask) {
+    size_t len = 0;
+    for (int cpu = 0; cpu < CRINIT_SCHED_MAX_CPUS; cpu++) {
+        if (!crinitSchedCpuIsSet(cpu, mask)) {
+            continue;
+        }
+        int last = cpu;
+        while (last + 1 < CRINIT_SCHED_MAX_CPUS && crinitSchedCpuIsSet(last + 1, mask)) {
+            last++;
+        }
+        size_t off = (len < bufSize) ? len : bufSize;
+        // Only measuring if buf is NULL, pointer arithmetic on NULL is undefined.
+        char *dst = (buf == NULL) ? NULL : buf + off;
+        int written = (last == cpu) ? snprintf(dst, bufSize - off, "%s%d", len ? "," : "", cpu)
+                                    : snprintf(dst, bufSize - off, "%s%d-%d", len ? "," : "", cpu, last);
+        if (written < 0) {
+            return -1;
+        }
+        len += (size_t)written;
+        cpu = last;
+    }
+    return (int)len;
+}
+
+static int crinitSchedSetOomScoreAdj(int adj) {
+    // snprintf() is not async-signal-safe, so convert the number manually.
+    char str[sizeof("-1000")];
+    char *p = str + sizeof(str);
+    unsigned int absAdj = (adj < 0) ? (unsigned int)-adj : (unsigned int)adj;
+    do {
+        *--p = (char)('0' + absAdj % 10);
+        absAdj /= 10;
+    } while (absAdj > 0);
+    if (adj < 0) {
+        *--p = '-';
+    }
+    size_t len = (size_t)(str + sizeof(str) - p);
+
+    int fd = open(CRINIT_OOM_SCORE_ADJ_PATH, O_WRONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return -1;
+    }
+    ssize_t written = write(fd, p, len);
+    int err = errno;
+    close(fd);
+    if (written != (ssize_t)len) {
+        errno = (written == -1) ? err : EIO;
+        return -1;
+    }
+    return 0;
+}
@@ -5,55 +5,82 @@
  */
 #include "sockcom.h"
 
+#include <errno.h>
+#include <stdatomic.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
 #include "logio.h"
+#include "sockmsg.h"
+
+/** Set once Crinit has turned out to only support version 1 of the protocol, see sockmsg.h. **/
+static atomic_bool crinitSockV1Only = false;
 
 /**
- * Connect to Crinit and wait for a ready-to-receive message.
+ * Connect to Crinit.
+ *
+ * Using version 1 of the protocol, waits for the ready-to-receive message.
  *
  * @param sockFd    Return pointer for the connected socket.
  * @param sockFile  Path to the AF_UNIX socket file to connect to.
+ * @param version   The protocol version to use, see sockmsg.h.
  *
  * @return 0 on success, -1 otherwise
  */
-static int crinitConnect(int *sockFd, const char *sockFile);
+static int crinitConnect(int *sockFd, const char *sockFile, int version);
 /**
  * Send a command/request to Crinit.
  *
- * Uses crinitRtimCmdToMsgStr() to generate a string and sends it using the same protocol as sendStr()/recvStr() in
- * notiserv.c. First, a binary size_t with the string size is sent, then the string itself in a second message/packet.
+ * Using version 1, uses crinitRtimCmdToMsgStr() to generate a string and sends it using the same protocol as
+ * sendStr()/recvStr() in notiserv.c. First a binary size_t with the string size is sent, then the string itself in a
+ * second message/packet. Using version 2, the output of crinitRtimCmdToMsgBin() is sent in a single message behind a
+ * crinitSockMsgHdr_t.
  *
- * The following diagram illustrates the low-level protocol:
+ * The following diagram illustrates the low-level protocol of version 1:
  * \image html sock_comm_str.svg
  *
- * @param sockFd  The connected socket over which to send.
- * @param cmd     The command/request to send.
+ * @param sockFd   The connected socket over which to send.
+ * @param cmd      The command/request to send.
+ * @param version  The protocol version to use, see sockmsg.h.
  *
- * @return 0 on success, -1 otherwise
+ * @return 0 on success, -1 otherwise with errno set
  */
-static int crinitSend(int sockFd, const crinitRtimCmd_t *cmd);
+static int crinitSend(int sockFd, const crinitRtimCmd_t *cmd, int version);
 /**
  * Receive a response from Crinit.
  *
- * Receives a string using the same protocol as sendStr()/recvStr() in notiserv.c and then uses crinitParseRtimCmd() to
- * generate an equivalent crinitRtimCmd_t.
+ * Using version 1, receives a string using the same protocol as sendStr()/recvStr() in notiserv.c and then uses
+ * crinitParseRtimCmd() to generate an equivalent crinitRtimCmd_t. First a binary size_t with the string size is
+ * received, memory allocation made accordingly, and then the string itself in a second message/packet is received.
+ * Using version 2, receives a message using crinitRecvMsg() and parses it using crinitParseRtimCmdBin().
  *
- * First, a binary size_t with the string size is received, memory allocation made accordingly, and then the string
- * itself in a second message/packet is received.
- *
- * The following diagram illustrates the low-level protocol:
+ * The following diagram illustrates the low-level protocol of version 1:
  * \image html sock_comm_str.svg
  *
+ * @param sockFd   The connected socket from which to receive.
+ * @param res      Return pointer for the response/result.
+ * @param version  The protocol version to use, see sockmsg.h.
+ *
+ * @return 0 on success, -1 otherwise with errno set to ECONNRESET if Crinit has closed the connection
+ */
+static int crinitRecv(int sockFd, crinitRtimCmd_t *res, int version);
+/**
+ * Receive a version 2 message from Crinit.
+ *
+ * The size of the message is peeked first, so that the receive buffer can be allocated accordingly. A ready-to-receive
+ * message, which Crinit sends if it has accepted the connection before the first request arrived, is skipped.
+ *
  * @param sockFd  The connected socket from which to receive.
- * @param res     Return pointer for the response/result.
+ * @param msg     Return pointer for the binary encoded response contained in the message. Must be freed using free().
+ * @param len     Return pointer for the size of the response.
  *
- * @return 0 on success, -1 otherwise
+ * @return 0 on success, -1 otherwise with errno set to ECONNRESET if Crinit has closed the connection
  */
-static int crinitRecv(int sockFd, crinitRtimCmd_t *res);
+static int crinitRecvMsg(int sockFd, char **msg, size_t *len);
 /**
  * Wait for a ready-to-receive message from Crinit.
  *
@@ -62,31 +89,243 @@ static int crinitRecv(int sockFd, crinitRtimCmd_t *res);
  * @return 0 on success, -1 otherwise
  */
 static int crinitWaitForRtr(int sockFd);
+/**
+ * Replace the socket of a persistent connection with a new one.
+ *
+ * Responses to requests sent over the old socket are considered lost.
+ *
+ * @param conn  The connection.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitConnReconnect(crinitClientConn_t *conn);
+/**
+ * Check if Crinit supports a protocol version.
+ *
+ * Sends a GETVER request, which has no side effects, over a new connection using the given version.
+ *
+ * @param sockFile  Path to the AF_UNIX socket file to connect to.
+ * @param version   The protocol version to check, see sockmsg.h.
+ *
+ * @return 1 if Crinit has answered, 0 if it has closed the connection without an answer, -1 on other errors
+ */
+static int crinitProbeVersion(const char *sockFile, int version);
 
 int crinitXfer(const char *sockFile, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
-    if (res == NULL || cmd == NULL) {
+    if (sockFile == NULL || res == NULL || cmd == NULL) {
         crinitErrPrint("Pointer arguments must not be NULL");
         return -1;
     }
-    int sockFd = -1;
-    if (crinitConnect(&sockFd, sockFile) == -1) {
+    crinitClientConn_t conn;
+    int ret = -1;
+    if (crinitConnOpen(&conn, sockFile) == 0) {
+        crinitDbgInfoPrint("Connected to Crinit using %s.", sockFile);
+        ret = crinitConnXfer(&conn, res, cmd);
+    }
+    crinitConnClose(&conn);
+    return ret;
+}
+
+int crinitConnOpen(crinitClientConn_t *conn, const char *sockFile) {
+    if (conn == NULL || sockFile == NULL) {
+        crinitErrPrint("Pointer arguments must not be NULL");
+        return -1;
+    }
+    conn->sockFd = -1;
+    conn->nextReqId = 0;
+    conn->nextResId = 0;
+    conn->sockReqs = 0;
+    conn->sockResps = 0;
+    conn->perRequest = false;
+    conn->version = atomic_load(&crinitSockV1Only) ? 1 : CRINIT_SOCKMSG_VERSION;
+    conn->sockFile = strdup(sockFile);
+    if (conn->sockFile == NULL) {
+        crinitErrnoPrint("Could not duplicate socket file path.");
+        return -1;
+    }
+    if (crinitConnect(&conn->sockFd, sockFile, conn->version) == -1) {
         crinitErrPrint("Could not connect to Crinit using socket at \'%s\'.", sockFile);
         return -1;
     }
-    crinitDbgInfoPrint("Connected to Crinit using %s.", sockFile);
-    if (crinitSend(sockFd, cmd) == -1) {
-        crinitErrPrint("Could not send RtimCmd to Crinit.");
+    crinitDbgInfoPrint("Opened persistent connection to Crinit using %s.", sockFile);
+    return 0;
+}
+
+void crinitConnClose(crinitClientConn_t *conn) {
+    if (conn == NULL) {
+        return;
+    }
+    if (conn->sockFd != -1) {
+        close(conn->sockFd);
+        conn->sockFd = -1;
+    }
+    free(conn->sockFile);
+    conn->sockFile = NULL;
+}
+
+int crinitConnXfer(crinitClientConn_t *conn, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
+    if (conn == NULL || res == NULL || cmd == NULL) {
+        crinitErrPrint("Pointer arguments must not be NULL");
         return -1;
     }
-    if (crinitRecv(sockFd, res) == -1) {
-        crinitErrPrint("Could not receive response from Crinit.");
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (conn->sockFd == -1 || (conn->perRequest && conn->sockReqs > 0)) {
+            if (crinitConnReconnect(conn) == -1) {
+                return -1;
+            }
+        }
+        // Only a connection which has already been used may have been closed by Crinit in the meantime.
+        bool reused = conn->sockReqs > 0;
+
+        uint64_t reqId;
+        if (crinitConnSend(conn, cmd, &reqId) == -1) {
+            if (reused && (errno == EPIPE || errno == ECONNRESET)) {
+                crinitDbgInfoPrint("Connection has been closed by Crinit, will reconnect.");
+                conn->perRequest = true;
+                close(conn->sockFd);
+                conn->sockFd = -1;
+                continue;
+            }
+            crinitErrPrint("Could not send RtimCmd to Crinit.");
+            return -1;
+        }
+
+        uint64_t resId;
+        do {
+            int version = conn->version;
+            bool answered = conn->sockResps > 0;
+            if (crinitConnRecv(conn, res, &resId) == -1) {
+                if (errno == ECONNRESET && version != 1 && !answered) {
+                    // An older Crinit rejects the first message of version 2 and closes the connection, but so may a
+                    // current one after it has executed the request. Only fall back if a request without side effects
+                    // is rejected as well. An older Crinit never executes a version 2 request, so repeating it is safe.
+                    int probe = crinitProbeVersion(conn->sockFile, version);
+                    if (probe == 0) {
+                        crinitDbgInfoPrint("Crinit does not support protocol version %d, will fall back to version 1.",
+                                           version);
+                        atomic_store(&crinitSockV1Only, true);
+                        conn->version = 1;
+                        break;
+                    }
+                    if (probe == 1) {
+                        crinitErrPrint("Crinit has closed the connection without a response.");
+                    } else {
+                        crinitErrPrint("Could not check which protocol versions Crinit supports.");
+                    }
+                    errno = ECONNRESET;
+                    return -1;
+                }
+                if (reused && errno == ECONNRESET) {
+                    // An older Crinit closes the connection after the first response without reading the request.
+                    crinitDbgInfoPrint("Connection has been closed by Crinit, will reconnect.");
+                    conn->perRequest = true;
+                    break;
+                }
+                crinitErrPrint("Could not receive response from Crinit.");
+                return -1;
+            }
+            if (resId != reqId) {
+                crinitDbgInfoPrint("Skipping stale response to request %llu.", (unsigned long long)resId);
+                crinitDestroyRtimCmd(res);
+            }
+        } while (resId != reqId);
+        if (conn->sockFd != -1) {
+            return 0;
+        }
+    }
+    crinitErrPrint("Could not complete data transfer with Crinit after reconnecting.");
+    return -1;
+}
+
+int crinitConnSend(crinitClientConn_t *conn, const crinitRtimCmd_t *cmd, uint64_t *reqId) {
+    if (conn == NULL || cmd == NULL) {
+        crinitErrPrint("Pointer arguments must not be NULL");
+        errno = EINVAL;
         return -1;
     }
-    close(sockFd);
+    if (conn->sockFd == -1) {
+        errno = ENOTCONN;
+        return -1;
+    }
+    if (crinitSend(conn->sockFd, cmd, conn->version) == -1) {
+        return -1;
+    }
+    if (reqId != NULL) {
+        *reqId = conn->nextReqId;
+    }
+    conn->nextReqId++;
+    conn->sockReqs++;
     return 0;
 }
 
-static int crinitConnect(int *sockFd, const char *sockFile) {
+int crinitConnRecv(crinitClientConn_t *conn, crinitRtimCmd_t *res, uint64_t *reqId) {
+    if (conn == NULL || res == NULL) {
+        crinitErrPrint("Pointer arguments must not be NULL");
+        return -1;
+    }
+    if (conn->sockFd == -1 || conn->nextResId == conn->nextReqId) {
+        crinitErrPrint("There is no outstanding request on the connection.");
+        return -1;
+    }
+    if (crinitRecv(conn->sockFd, res, conn->version) == -1) {
+        // The connection is out of sync, so start over on the next request.
+        int err = errno;
+        close(conn->sockFd);
+        conn->sockFd = -1;
+        errno = err;
+        return -1;
+    }
+    if (reqId != NULL) {
+        *reqId = conn->nextResId;
+    }
+    conn->nextResId++;
+    conn->sockResps++;
+    return 0;
+}
+
+static int crinitConnReconnect(crinitClientConn_t *conn) {
+    if (conn->sockFd != -1) {
+        close(conn->sockFd);
+        conn->sockFd = -1;
+    }
+    conn->nextResId = conn->nextReqId;
+    conn->sockReqs = 0;
+    conn->sockResps = 0;
+    if (crinitConnect(&conn->sockFd, conn->sockFile, conn->version) == -1) {
+        crinitErrPrint("Could not reconnect to Crinit using socket at \'%s\'.", conn->sockFile);
+        return -1;
+    }
+    return 0;
+}
+
+static int crinitProbeVersion(const char *sockFile, int version) {
+    int sockFd = -1;
+    if (crinitConnect(&sockFd, sockFile, version) == -1) {
+        return -1;
+    }
+
+    crinitRtimCmd_t cmd, res;
+    if (crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_GETVER, 0) == -1) {
+        crinitErrPrint("Could not build version request.");
+        close(sockFd);
+        return -1;
+    }
+    int ret = -1;
+    if (crinitSend(sockFd, &cmd, version) == 0) {
+        if (crinitRecv(sockFd, &res, version) == 0) {
+            crinitDestroyRtimCmd(&res);
+            ret = 1;
+        } else if (errno == ECONNRESET) {
+            ret = 0;
+        }
+    }
+    crinitDestroyRtimCmd(&cmd);
+    close(sockFd);
+    return ret;
+}
+
+static int crinitConnect(int *sockFd, const char *sockFile, int version) {
     crinitDbgInfoPrint("Sending message to server at \'%s\'.", sockFile);
 
     *sockFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
@@ -110,6 +349,10 @@ static int crinitConnect(int *sockFd, const char *sockFile) {
         return -1;
     }
     crinitDbgInfoPrint("Connected to Crinit.");
+    if (version != 1) {
+        // The request can be sent right away.
+        return 0;
+    }
     crinitDbgInfoPrint("Waiting for RTR.");
     if (crinitWaitForRtr(*sockFd) == -1) {
         crinitErrPrint("Could not wait for RTR.");
@@ -120,12 +363,40 @@ static int crinitConnect(int *sockFd, const char *sockFile) {
     return 0;
 }
 
-static int crinitSend(int sockFd, const crinitRtimCmd_t *cmd) {
+static int crinitSend(int sockFd, const crinitRtimCmd_t *cmd, int version) {
     if (cmd == NULL) {
         crinitErrPrint("Pointer arguments must not be NULL");
         return -1;
     }
 
+    int err;
+    if (version != 1) {
+        void *sendMsg = NULL;
+        size_t sendLen = 0;
+        if (crinitRtimCmdToMsgBin(&sendMsg, &sendLen, cmd) == -1) {
+            crinitErrPrint("Could not transform RtimCmd into sendable message.");
+            return -1;
+        }
+        crinitSockMsgHdr_t hdr = {CRINIT_SOCKMSG_MARKER, CRINIT_SOCKMSG_VERSION, 0};
+        struct iovec iov[2] = {{.iov_base = &hdr, .iov_len = sizeof(hdr)}, {.iov_base = sendMsg, .iov_len = sendLen}};
+        struct msghdr mHdr = {.msg_iov = iov, .msg_iovlen = 2};
+        if (sendmsg(sockFd, &mHdr, MSG_NOSIGNAL) == -1) {
+            err = errno;
+            // The message has not been sent, so it is safe to repeat the request, see crinitConnXfer().
+            if (err == EPIPE) {
+                crinitDbgInfoPrint("Could not send message as the connection has been closed.");
+            } else {
+                crinitErrnoPrint("Could not send message of %zu Bytes to Crinit.", sendLen);
+            }
+            free(sendMsg);
+            errno = err;
+            return -1;
+        }
+        crinitDbgInfoPrint("Sent message of %zu Bytes.", sendLen);
+        free(sendMsg);
+        return 0;
+    }
+
     char *sendStr = NULL;
     size_t sendLen = 0;
     if (crinitRtimCmdToMsgStr(&sendStr, &sendLen, cmd) == -1) {
@@ -134,14 +405,24 @@ static int crinitSend(int sockFd, const crinitRtimCmd_t *cmd) {
     }
 
     if (send(sockFd, &sendLen, sizeof(size_t), MSG_NOSIGNAL) == -1) {
-        crinitErrnoPrint("Could not send length packet (\'%zu\') of string \'%s\' to client.", sendLen, sendStr);
+        err = errno;
+        // A closed connection is expected if Crinit does not keep it open, see crinitConnXfer().
+        if (err == EPIPE) {
+            crinitDbgInfoPrint("Could not send length packet as the connection has been closed.");
+        } else {
+            crinitErrnoPrint("Could not send length packet (\'%zu\') of string \'%s\' to client.", sendLen, sendStr);
+        }
         free(sendStr);
+        errno = err;
         return -1;
     }
 
     if (send(sockFd, sendStr, sendLen, MSG_NOSIGNAL) == -1) {
+        err = errno;
         crinitErrnoPrint("Could not send string \'%s\' to client.", sendStr);
         free(sendStr);
+        // The length packet has been sent, so the request must not be repeated.
+        errno = (err == EPIPE || err == ECONNRESET) ? EIO : err;
         return -1;
     }
     crinitDbgInfoPrint("Sent message of %zu Bytes. Content:\n\'%s\'", sendLen, sendStr);
@@ -149,26 +430,53 @@ static int crinitSend(int sockFd, const crinitRtimCmd_t *cmd) {
     return 0;
 }
 
-static int crinitRecv(int sockFd, crinitRtimCmd_t *res) {
+static int crinitRecv(int sockFd, crinitRtimCmd_t *res, int version) {
     if (res == NULL) {
         crinitErrPrint("Return pointer must not be NULL.");
         return -1;
     }
 
+    char *recvStr = NULL;
     size_t recvLen = 0;
+    if (version != 1) {
+        if (crinitRecvMsg(sockFd, &recvStr, &recvLen) == -1) {
+            return -1;
+        }
+        crinitDbgInfoPrint("Received message of %zu Bytes.", recvLen);
+        int ret = crinitParseRtimCmdBin(res, recvStr, recvLen);
+        free(recvStr);
+        if (ret == -1) {
+            crinitErrPrint("Could not parse response message.");
+            errno = EPROTO;
+        }
+        return ret;
+    }
+
     ssize_t bytesRead = -1;
     bytesRead = recv(sockFd, &recvLen, sizeof(size_t), 0);
+    if (bytesRead < 0 && errno == ECONNRESET) {
+        // Crinit has closed the connection without reading the request, see crinitConnXfer().
+        crinitDbgInfoPrint("Connection has been reset by Crinit.");
+        errno = ECONNRESET;
+        return -1;
+    }
     if (bytesRead < 0) {
         crinitErrnoPrint("Could not receive string length message via socket.");
         return -1;
     }
+    if (bytesRead == 0) {
+        crinitDbgInfoPrint("Connection has been closed by Crinit.");
+        errno = ECONNRESET;
+        return -1;
+    }
     if (bytesRead != sizeof(size_t)) {
         crinitErrPrint("Received data of unexpected length from Crinit: '%ld' Bytes", bytesRead);
+        errno = EPROTO;
         return -1;
     }
     crinitDbgInfoPrint("Received message of %ld Bytes. Content:\n\'%zu\'", bytesRead, recvLen);
 
-    char *recvStr = malloc(recvLen);
+    recvStr = malloc(recvLen);
     if (recvStr == NULL) {
         crinitErrnoPrint("Could not allocate receive buffer of size %zu Bytes.", recvLen);
         return -1;
@@ -197,6 +505,65 @@ static int crinitRecv(int sockFd, crinitRtimCmd_t *res) {
     return 0;
 }
 
+static int crinitRecvMsg(int sockFd, char **msg, size_t *len) {
+    while (true) {
+        ssize_t msgLen = recv(sockFd, NULL, 0, MSG_PEEK | MSG_TRUNC);
+        if (msgLen < 0 && errno == ECONNRESET) {
+            // Crinit has closed the connection without reading the request, see crinitConnXfer().
+            crinitDbgInfoPrint("Connection has been reset by Crinit.");
+            errno = ECONNRESET;
+            return -1;
+        }
+        if (msgLen < 0) {
+            crinitErrnoPrint("Could not receive message via socket.");
+            return -1;
+        }
+        if (msgLen == 0) {
+            crinitDbgInfoPrint("Connection has been closed by Crinit.");
+            errno = ECONNRESET;
+            return -1;
+        }
+        if ((size_t)msgLen == sizeof(size_t)) {
+            // Crinit has accepted the connection before the request arrived and does not know the version yet.
+            if (crinitWaitForRtr(sockFd) == -1) {
+                errno = EPROTO;
+                return -1;
+            }
+            continue;
+        }
+        if ((size_t)msgLen <= sizeof(crinitSockMsgHdr_t)) {
+            crinitErrPrint("Received message of unexpected length from Crinit: '%ld' Bytes", msgLen);
+            errno = EPROTO;
+            return -1;
+        }
+
+        char *buf = malloc(msgLen);
+        if (buf == NULL) {
+            crinitErrnoPrint("Could not allocate receive buffer of size %ld Bytes.", msgLen);
+            return -1;
+        }
+        ssize_t bytesRead = recv(sockFd, buf, msgLen, 0);
+        if (bytesRead != msgLen) {
+            crinitErrPrint("Could not receive message of %ld Bytes from Crinit.", msgLen);
+            free(buf);
+            errno = EPROTO;
+            return -1;
+        }
+        crinitSockMsgHdr_t hdr;
+        memcpy(&hdr, buf, sizeof(hdr));
+        if (hdr.marker != CRINIT_SOCKMSG_MARKER || hdr.version != CRINIT_SOCKMSG_VERSION) {
+            crinitErrPrint("Received message with unexpected header from Crinit.");
+            free(buf);
+            errno = EPROTO;
+            return -1;
+        }
+        *len = (size_t)bytesRead - sizeof(hdr);
+        memmove(buf, buf + sizeof(hdr), *len);
+        *msg = buf;
+        return 0;
+    }
+}
+
 static int crinitWaitForRtr(int sockFd) {
     char rtrBuf[sizeof("RTR")] = {'\0'};
     size_t recvLen = 0;
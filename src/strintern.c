@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file strintern.c
+ * @brief Implementation of the global string intern table.
+ */
+#include "strintern.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "logio.h"
+
+#define CRINIT_STRINTERN_INITIAL_SIZE 64                  ///< Initial number of buckets in the intern table.
+#define CRINIT_STRINTERN_HASH_INIT 0xcbf29ce484222325ULL  ///< Initial value for string hashes (FNV-1a).
+#define CRINIT_STRINTERN_HASH_PRIME 0x100000001b3ULL      ///< Multiplier for string hashes (FNV-1a).
+
+/**
+ * Type to store a single interned string along with its metadata.
+ */
+typedef struct crinitStrInternEntry {
+    size_t refs;    ///< Number of references held to the string.
+    uint64_t hash;  ///< Hash of the string, kept to avoid rehashing when the table grows or entries are moved.
+    char str[];     ///< The string itself.
+} crinitStrInternEntry_t;
+
+/**
+ * Get the crinitStrInternEntry_t holding an interned string.
+ */
+#define crinitStrInternEntryOf(s) ((crinitStrInternEntry_t *)((uintptr_t)(s) - offsetof(crinitStrInternEntry_t, str)))
+
+/**
+ * Type to store the intern table, an open-addressing hash set with linear probing.
+ */
+typedef struct crinitStrInternTable {
+    crinitStrInternEntry_t **buckets;  ///< Array of entries, NULL marks an empty bucket.
+    size_t size;                       ///< Number of buckets, always a power of two.
+    size_t items;                      ///< Number of entries in the table.
+} crinitStrInternTable_t;
+
+/** The global intern table. **/
+static crinitStrInternTable_t crinitStrInternTbl = {NULL, 0, 0};
+/** Mutex to synchronize access to crinitStrInternTbl. **/
+static pthread_mutex_t crinitStrInternLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Calculate the FNV-1a hash of a string.
+ *
+ * @param str  The string to hash.
+ *
+ * @return  The hash value.
+ */
+static uint64_t crinitStrInternHash(const char *str);
+/**
+ * Find the bucket holding a string or the empty bucket where it would need to be inserted.
+ *
+ * Must be called with crinitStrInternLock held and a non-empty table.
+ *
+ * @param str   The string to search for.
+ * @param hash  The hash of \a str as returned by crinitStrInternHash().
+ *
+ * @return  The position of the bucket in crinitStrInternTbl.
+ */
+static size_t crinitStrInternFindBucket(const char *str, uint64_t hash);
+/**
+ * Double the number of buckets of the intern table (or allocate the initial buckets) and re-insert all entries.
+ *
+ * Must be called with crinitStrInternLock held.
+ *
+ * @return  0 on success, -1 otherwise
+ */
+static int crinitStrInternGrow(void);
+
+const char *crinitStrIntern(const char *str) {
+    crinitNullCheck(NULL, str);
+
+    uint64_t hash = crinitStrInternHash(str);
+    if ((errno = pthread_mutex_lock(&crinitStrInternLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return NULL;
+    }
+
+    if (crinitStrInternTbl.items * 2 >= crinitStrInternTbl.size && crinitStrInternGrow() == -1) {
+        crinitErrPrint("Could not grow string intern table.");
+        pthread_mutex_unlock(&crinitStrInternLock);
+        return NULL;
+    }
+
+    size_t pos = crinitStrInternFindBucket(str, hash);
+    crinitStrInternEntry_t *e = crinitStrInternTbl.buckets[pos];
+    if (e == NULL) {
+        size_t len = strlen(str) + 1;
+        e = malloc(sizeof(*e) + len);
+        if (e == NULL) {
+            crinitErrnoPrint("Could not allocate memory for interned string '%s'.", str);
+            pthread_mutex_unlock(&crinitStrInternLock);
+            return NULL;
+        }
+        e->refs = 0;
+        e->hash = hash;
+        memcpy(e->str, str, len);
+        crinitStrInternTbl.buckets[pos] = e;
+        crinitStrInternTbl.items++;
+    }
+    e->refs++;
+
+    pthread_mutex_unlock(&crinitStrInternLock);
+    return e->str;
+}
+
+const char *crinitStrInternRef(const char *str) {
+    if (str == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&crinitStrInternLock);
+    crinitStrInternEntryOf(str)->refs++;
+    pthread_mutex_unlock(&crinitStrInternLock);
+    return str;
+}
+
+const char *crinitStrInternFind(const char *str) {
+    crinitNullCheck(NULL, str);
+
+    const char *ret = NULL;
+    uint64_t hash = crinitStrInternHash(str);
+    pthread_mutex_lock(&crinitStrInternLock);
+    if (crinitStrInternTbl.items > 0) {
+        crinitStrInternEntry_t *e = crinitStrInternTbl.buckets[crinitStrInternFindBucket(str, hash)];
+        if (e != NULL) {
+            ret = e->str;
+        }
+    }
+    pthread_mutex_unlock(&crinitStrInternLock);
+    return ret;
+}
+
+void crinitStrInternRelease(const char *str) {
+    if (str == NULL) {
+        return;
+    }
+
+    crinitStrInternEntry_t *e = crinitStrInternEntryOf(str);
+    pthread_mutex_lock(&crinitStrInternLock);
+    if (--e->refs > 0) {
+        pthread_mutex_unlock(&crinitStrInternLock);
+        return;
+    }
+
+    // Remove the entry and shift back following entries of the same probe sequence so that no lookup misses them.
+    size_t mask = crinitStrInternTbl.size - 1;
+    size_t hole = e->hash & mask;
+    while (crinitStrInternTbl.buckets[hole] != e) {
+        hole = (hole + 1) & mask;
+    }
+    crinitStrInternTbl.buckets[hole] = NULL;
+    crinitStrInternTbl.items--;
+    for (size_t pos = (hole + 1) & mask; crinitStrInternTbl.buckets[pos] != NULL; pos = (pos + 1) & mask) {
+        size_t home = crinitStrInternTbl.buckets[pos]->hash & mask;
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+            crinitStrInternTbl.buckets[hole] = crinitStrInternTbl.buckets[pos];
+            crinitStrInternTbl.buckets[pos] = NULL;
+            hole = pos;
+        }
+    }
+    pthread_mutex_unlock(&crinitStrInternLock);
+    free(e);
+}
+
+size_t crinitStrInternCount(void) {
+    pthread_mutex_lock(&crinitStrInternLock);
+    size_t ret = crinitStrInternTbl.items;
+    pthread_mutex_unlock(&crinitStrInternLock);
+    return ret;
+}
+
+static uint64_t crinitStrInternHash(const char *str) {
+    uint64_t h = CRINIT_STRINTERN_HASH_INIT;
+    while (*str != '\0') {
+        h = (h ^ (unsigned char)*str++) * CRINIT_STRINTERN_HASH_PRIME;
+    }
+    return h;
+}
+
+static size_t crinitStrInternFindBucket(const char *str, uint64_t hash) {
+    size_t mask = crinitStrInternTbl.size - 1;
+    size_t pos = hash & mask;
+    crinitStrInternEntry_t *e;
+    while ((e = crinitStrInternTbl.buckets[pos]) != NULL) {
+        if (e->hash == hash && strcmp(e->str, str) == 0) {
+            break;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+static int crinitStrInternGrow(void) {
+    size_t newSize = (crinitStrInternTbl.size == 0) ? CRINIT_STRINTERN_INITIAL_SIZE : crinitStrInternTbl.size * 2;
+    crinitStrInternEntry_t **newBuckets = calloc(newSize, sizeof(*newBuckets));
+    if (newBuckets == NULL) {
+        crinitErrnoPrint("Could not allocate memory for %zu buckets of the string intern table.", newSize);
+        return -1;
+    }
+
+    for (size_t i = 0; i < crinitStrInternTbl.size; i++) {
+        crinitStrInternEntry_t *e = crinitStrInternTbl.buckets[i];
+        if (e != NULL) {
+            size_t pos = e->hash & (newSize - 1);
+            while (newBuckets[pos] != NULL) {
+                pos = (pos + 1) & (newSize - 1);
+            }
+            newBuckets[pos] = e;
+        }
+    }
+    free(crinitStrInternTbl.buckets);
+    crinitStrInternTbl.buckets = newBuckets;
+    crinitStrInternTbl.size = newSize;
+    return 0;
+}
@@ -5,12 +5,18 @@
  */
 #include "task.h"
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "common.h"
 #include "confmap.h"
 #include "globopt.h"
 #include "logio.h"
+#include "strintern.h"
+
+/** Size of a buffer large enough for the numeric values in sd_notify() state strings, including the null byte. **/
+#define CRINIT_TASK_NOTIFY_NUM_BUF_SIZE 24
 
 /**
  * Helper function to go through an crinitConfKvList_t and apply all contained settings to a target task.
@@ -50,8 +56,12 @@ int crinitTaskCreateFromConfKvList(crinitTask_t **out, const crinitConfKvList_t
     }
     crinitTask_t *pTask = *out;
     pTask->pid = -1;
+    pTask->exitStatus = -1;
     pTask->maxRetries = -1;
     pTask->inhibitRespawn = false;
+    pTask->backoffLimit = CRINIT_TASK_RESPAWN_DELAY_MAX_DEFAULT;
+    pTask->burstInterval = CRINIT_TASK_RESPAWN_BURST_INTERVAL_DEFAULT;
+    pTask->burstCooldown = CRINIT_TASK_RESPAWN_COOLDOWN_DEFAULT;
 
     if (crinitGlobOptGet(CRINIT_GLOBOPT_ENV, &pTask->taskEnv) == -1) {
         crinitErrPrint("Could not retrieve global environment set during Task creation.");
@@ -90,6 +100,7 @@ int crinitTaskCreateFromConfKvList(crinitTask_t **out, const crinitConfKvList_t
     }
     memset(&pTask->startTime, 0, sizeof(pTask->startTime));
     memset(&pTask->endTime, 0, sizeof(pTask->startTime));
+    memset(&pTask->usage, 0, sizeof(pTask->usage));
 
     return 0;
 
@@ -152,17 +163,8 @@ int crinitTaskCopy(crinitTask_t *out, const crinitTask_t *orig) {
         }
 
         for (size_t i = 0; i < out->depsSize; i++) {
-            size_t depNameLen = strlen(orig->deps[i].name) + 1;
-            size_t depEventLen = strlen(orig->deps[i].event) + 1;
-            out->deps[i].name = malloc(depNameLen + depEventLen);
-            if (out->deps[i].name == NULL) {
-                crinitErrnoPrint(
-                    "Could not allocate memory for backing string in deps[%zu] during copy of Task \'%s\'.", i,
-                    orig->name);
-                goto fail;
-            }
-            memcpy(out->deps[i].name, orig->deps[i].name, depNameLen + depEventLen);
-            out->deps[i].event = out->deps[i].name + depNameLen;
+            out->deps[i].name = crinitStrInternRef(orig->deps[i].name);
+            out->deps[i].event = crinitStrInternRef(orig->deps[i].event);
         }
     } else {
         out->deps = NULL;
@@ -176,17 +178,8 @@ int crinitTaskCopy(crinitTask_t *out, const crinitTask_t *orig) {
         }
 
         for (size_t i = 0; i < out->trigSize; i++) {
-            size_t depNameLen = strlen(orig->trig[i].name) + 1;
-            size_t depEventLen = strlen(orig->trig[i].event) + 1;
-            out->trig[i].name = malloc(depNameLen + depEventLen);
-            if (out->trig[i].name == NULL) {
-                crinitErrnoPrint(
-                    "Could not allocate memory for backing string in trig[%zu] during copy of Task \'%s\'.", i,
-                    orig->name);
-                goto fail;
-            }
-            memcpy(out->trig[i].name, orig->trig[i].name, depNameLen + depEventLen);
-            out->trig[i].event = out->trig[i].name + depNameLen;
+            out->trig[i].name = crinitStrInternRef(orig->trig[i].name);
+            out->trig[i].event = crinitStrInternRef(orig->trig[i].event);
         }
     } else {
         out->trig = NULL;
@@ -200,13 +193,8 @@ int crinitTaskCopy(crinitTask_t *out, const crinitTask_t *orig) {
         }
 
         for (size_t i = 0; i < out->prvSize; i++) {
-            out->prv[i].name = strdup(orig->prv[i].name);
+            out->prv[i].name = crinitStrInternRef(orig->prv[i].name);
             out->prv[i].stateReq = orig->prv[i].stateReq;
-            if (out->prv[i].name == NULL) {
-                crinitErrnoPrint("Could not allocate memory for TaskPrv at index %zu during copy of Task '%s'.", i,
-                                 out->name);
-                goto fail;
-            }
         }
     } else {
         out->prv = NULL;
@@ -232,6 +220,13 @@ int crinitTaskCopy(crinitTask_t *out, const crinitTask_t *orig) {
     out->pid = orig->pid;
     out->maxRetries = orig->maxRetries;
     out->failCount = orig->failCount;
+    out->respawnDelay = orig->respawnDelay;
+    out->backoffLimit = orig->backoffLimit;
+    out->respawnBurst = orig->respawnBurst;
+    out->burstInterval = orig->burstInterval;
+    out->burstCooldown = orig->burstCooldown;
+    out->burstCount = orig->burstCount;
+    out->burstStart = orig->burstStart;
 
     out->user = orig->user;
     out->group = orig->group;
@@ -303,6 +298,66 @@ int crinitTaskDup(crinitTask_t **out, const crinitTask_t *orig) {
     return 0;
 }
 
+void crinitTaskMove(crinitTask_t *out, crinitTask_t *orig) {
+    memcpy(out, orig, sizeof(*out));
+    memset(orig, 0, sizeof(*orig));
+}
+
+crinitTaskCfg_t *crinitTaskCfgCreate(const crinitTask_t *orig) {
+    crinitNullCheck(NULL, orig);
+
+    crinitTaskCfg_t *cfg = malloc(sizeof(*cfg));
+    if (cfg == NULL) {
+        crinitErrnoPrint("Could not allocate memory for configuration snapshot of Task \'%s\'.", orig->name);
+        return NULL;
+    }
+
+    // crinitTaskCopy() cleans up after itself on error.
+    if (crinitTaskCopy(&cfg->task, orig) != 0) {
+        crinitErrPrint("Failed to copy task \'%s\'.", orig->name);
+        free(cfg);
+        return NULL;
+    }
+    char readyFdStr[CRINIT_TASK_NOTIFY_NUM_BUF_SIZE];
+    snprintf(readyFdStr, sizeof(readyFdStr), "%d", CRINIT_READY_FD_NO);
+    if (crinitEnvSetSet(&cfg->task.taskEnv, CRINIT_ENV_NOTIFY_NAME, cfg->task.name) == -1 ||
+        ((cfg->task.opts & CRINIT_TASK_OPT_READY_FD) &&
+         crinitEnvSetSet(&cfg->task.taskEnv, CRINIT_ENV_READY_FD, readyFdStr) == -1)) {
+        crinitErrPrint("Could not set notification environment variable for task \'%s\'", orig->name);
+        crinitDestroyTask(&cfg->task);
+        free(cfg);
+        return NULL;
+    }
+    atomic_init(&cfg->refs, 1);
+    cfg->spawnPlan = NULL;
+    return cfg;
+}
+
+crinitTaskCfg_t *crinitTaskCfgRef(crinitTaskCfg_t *cfg) {
+    atomic_fetch_add_explicit(&cfg->refs, 1, memory_order_relaxed);
+    return cfg;
+}
+
+void crinitTaskCfgRelease(crinitTaskCfg_t *cfg) {
+    if (cfg == NULL) {
+        return;
+    }
+    if (atomic_fetch_sub_explicit(&cfg->refs, 1, memory_order_acq_rel) == 1) {
+        crinitSpawnPlanRelease(cfg->spawnPlan);
+        crinitDestroyTask(&cfg->task);
+        free(cfg);
+    }
+}
+
+void crinitSpawnPlanRelease(crinitSpawnPlanHdr_t *plan) {
+    if (plan == NULL) {
+        return;
+    }
+    if (atomic_fetch_sub_explicit(&plan->refs, 1, memory_order_acq_rel) == 1) {
+        plan->destroy(plan);
+    }
+}
+
 void crinitFreeTask(crinitTask_t *t) {
     if (t == NULL) {
         return;
@@ -317,30 +372,34 @@ void crinitDestroyTask(crinitTask_t *t) {
     if (t->cmds != NULL) {
         for (size_t i = 0; i < t->cmdsSize; i++) {
             crinitFreeArgvArray(t->cmds[i].argv);
+            free(t->cmds[i].tmpl);
         }
     }
     free(t->cmds);
     if (t->stopCmds != NULL) {
         for (size_t i = 0; i < t->stopCmdsSize; i++) {
             crinitFreeArgvArray(t->stopCmds[i].argv);
+            free(t->stopCmds[i].tmpl);
         }
     }
     free(t->stopCmds);
     if (t->deps != NULL) {
         for (size_t i = 0; i < t->depsSize; i++) {
-            free(t->deps[i].name);
+            crinitStrInternRelease(t->deps[i].name);
+            crinitStrInternRelease(t->deps[i].event);
         }
     }
     free(t->deps);
     if (t->trig != NULL) {
         for (size_t i = 0; i < t->trigSize; i++) {
-            free(t->trig[i].name);
+            crinitStrInternRelease(t->trig[i].name);
+            crinitStrInternRelease(t->trig[i].event);
         }
     }
     free(t->trig);
     if (t->prv != NULL) {
         for (size_t i = 0; i < t->prvSize; i++) {
-            free(t->prv[i].name);
+            crinitStrInternRelease(t->prv[i].name);
         }
     }
     free(t->prv);
@@ -471,6 +530,45 @@ static inline int crinitTaskSetFromConfKvList(crinitTask_t *tgt, const crinitCon
     return 0;
 }
 
+void crinitTaskNotifyParse(crinitTaskNotify_t *n, const char *state, size_t len) {
+    if (n == NULL || state == NULL) {
+        crinitErrPrint("Input parameters must not be NULL.");
+        return;
+    }
+
+    const char *end = state + len;
+    while (state < end) {
+        const char *lineEnd = memchr(state, '\n', (size_t)(end - state));
+        if (lineEnd == NULL) {
+            lineEnd = end;
+        }
+        const char *delim = memchr(state, '=', (size_t)(lineEnd - state));
+        if (delim != NULL) {
+            size_t keyLen = (size_t)(delim - state);
+            const char *val = delim + 1;
+            size_t valLen = (size_t)(lineEnd - val);
+            // The numeric values are short, copy them so that strtol() does not run past the end of the line.
+            char num[CRINIT_TASK_NOTIFY_NUM_BUF_SIZE] = {'\0'};
+            memcpy(num, val, (valLen < sizeof(num)) ? valLen : sizeof(num) - 1);
+
+            if (keyLen == strlen("MAINPID") && strncmp(state, "MAINPID", keyLen) == 0) {
+                long pid = strtol(num, NULL, 10);
+                if (pid > 0) {
+                    n->mainPid = (pid_t)pid;
+                }
+            } else if (keyLen == strlen("READY") && strncmp(state, "READY", keyLen) == 0) {
+                n->ready = strtol(num, NULL, 10) > 0;
+            } else if (keyLen == strlen("STOPPING") && strncmp(state, "STOPPING", keyLen) == 0) {
+                n->stopping = strtol(num, NULL, 10) > 0;
+            } else if (keyLen == strlen("STATUS") && strncmp(state, "STATUS", keyLen) == 0) {
+                n->status = val;
+                n->statusLen = valLen;
+            }
+        }
+        state = lineEnd + 1;
+    }
+}
+
 static int crinitCopyCommandBlock(char *name, size_t cmdsSize, crinitTaskCmd_t *origCmds, crinitTaskCmd_t **outCmds) {
     if (cmdsSize > 0) {
         size_t size = sizeof(**outCmds);
@@ -508,6 +606,11 @@ static int crinitCopyCommandBlock(char *name, size_t cmdsSize, crinitTaskCmd_t *
             for (int j = 0; j < (*outCmds)[i].argc; j++) {
                 (*outCmds)[i].argv[j] = argvBackbuf + (origCmds[i].argv[j] - origCmds[i].argv[0]);
             }
+
+            if (crinitCmdTmplDup(&(*outCmds)[i].tmpl, origCmds[i].tmpl) == -1) {
+                crinitErrPrint("Could not copy variables of cmds[%zu] of task \'%s\'.", i, name);
+                return -1;
+            }
         }
     }
 
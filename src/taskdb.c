@@ -6,6 +6,7 @@
 #include "taskdb.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -19,37 +20,393 @@
 #include "globopt.h"
 #include "logio.h"
 #include "optfeat.h"
+#include "strintern.h"
+
+#define CRINIT_TASKDB_HASH_INIT 0xcbf29ce484222325ULL  ///< Initial value for hashes in the TaskDB indices (FNV-1a).
+#define CRINIT_TASKDB_HASH_PRIME 0x100000001b3ULL      ///< Multiplier for hashes in the TaskDB indices (FNV-1a).
+
+/**
+ * List of the command-less tasks completed by crinitTaskDBSpawnReady() during one call.
+ *
+ * The parts of the completion which must not run with crinitTaskDB_t::lock held are done by
+ * crinitTaskDBFinishMetaTasks() once the lock is released.
+ */
+typedef struct crinitTaskDBMetaDone {
+    crinitTaskCfg_t **cfgs;  ///< References to the configuration snapshots of the completed tasks.
+    size_t items;            ///< Number of used elements in cfgs.
+    size_t size;             ///< Number of allocated elements in cfgs.
+} crinitTaskDBMetaDone_t;
 
 /**
  * Find index of a task in the crinitTaskDB_t::taskSet of an crinitTaskDB_t by name.
  *
  * @param task      Pointer pointer to return the task with.
+ * @param pos       Return pointer for the position of the task in crinitTaskDB_t::taskSet, may be NULL.
  * @param taskName  The crinitTask_t::name to search for.
  * @param in        The crinitTaskDB_t to search in.
  *
  * @return 0 on success, -1 otherwise
  */
-static int crinitFindTask(crinitTask_t **task, const char *taskName, const crinitTaskDB_t *in);
+static int crinitFindTask(crinitTask_t **task, size_t *pos, const char *taskName, const crinitTaskDB_t *in);
+/**
+ * Find the position of a task in crinitTaskDB_t::taskSet given a pointer to it.
+ *
+ * Needs to check the address ranges of the chunks in crinitTaskDB_t::taskSet one by one, so callers should keep track
+ * of positions where possible.
+ *
+ * @param pos    Return pointer for the position.
+ * @param pTask  The task to search for.
+ * @param in     The crinitTaskDB_t to search in.
+ *
+ * @return 0 on success, -1 if \a pTask is not stored in \a in.
+ */
+static int crinitFindTaskPos(size_t *pos, const crinitTask_t *pTask, const crinitTaskDB_t *in);
+/**
+ * Grow crinitTaskDB_t::taskSet, crinitTaskDB_t::taskSched and crinitTaskDB_t::taskCfg to a new capacity.
+ *
+ * Adds new chunks to crinitTaskDB_t::taskSet, tasks already stored do not move. On error, crinitTaskDB_t::taskSetSize
+ * is left untouched.
+ *
+ * @param ctx      The TaskDB context to work on.
+ * @param newSize  The new capacity, will be rounded up to a multiple of #CRINIT_TASKDB_CHUNK_SIZE.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitTaskSetGrow(crinitTaskDB_t *ctx, size_t newSize);
+/**
+ * Get the slot in crinitTaskDB_t::taskSet to store a task with a given name in.
+ *
+ * If a task with the same name exists and \a overwrite is true, it is destroyed and its slot is returned. Otherwise
+ * the next free slot is returned, growing crinitTaskDB_t::taskSet (and the structures sized along with it) if needed.
+ * A new slot only becomes part of the TaskDB once the caller has filled it and added it using crinitTaskIdxAdd().
+ *
+ * Must be called with crinitTaskDB_t::lock held and crinitTaskDB_t::queryLock held for writing.
+ *
+ * @param ctx        The TaskDB context to work on.
+ * @param pos        Return pointer for the position of the slot.
+ * @param newEntry   Return pointer, set to true if the slot is a new one and false if it is reused.
+ * @param name       The name of the task to store.
+ * @param overwrite  Reuse the slot of a task with the same name (true) or return an error (false).
+ *
+ * @return  A pointer to the slot on success, NULL otherwise.
+ */
+static crinitTask_t *crinitTaskDBGetSlot(crinitTaskDB_t *ctx, size_t *pos, bool *newEntry, const char *name,
+                                         bool overwrite);
+/**
+ * Finish the insertion of a task which has been stored in crinitTaskDB_t::taskSet.
+ *
+ * Adds the task to the reverse dependency index, sends the elos creation event, runs the `TASK_ADDED` feature hooks
+ * and checks if the task is ready to be started. Does not signal crinitTaskDB_t::changed.
+ *
+ * Must be called with crinitTaskDB_t::lock held but without crinitTaskDB_t::queryLock.
+ *
+ * @param ctx  The TaskDB context holding the task.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitTaskDBTaskAdded(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * Drop the configuration snapshot of a task from crinitTaskDB_t::taskCfg after its configuration may have changed.
+ *
+ * References still held by dispatch threads stay valid. A new snapshot is created on next use. Doesn't lock the
+ * TaskDB!
+ *
+ * @param ctx  The TaskDB context holding the task.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ */
+static void crinitTaskDBDropTaskCfg(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * Continue a hash calculation for use in crinitTaskDB_t::taskIdx or crinitTaskDB_t::waitIdx over a given string.
+ *
+ * Uses 64-bit FNV-1a which is cheap and distributes short, similar strings (like task names) well enough. A new
+ * calculation is started with #CRINIT_TASKDB_HASH_INIT as \a h.
+ *
+ * @param h    The hash value so far.
+ * @param str  The string to hash.
+ *
+ * @return  The hash value of \a str, continued from \a h.
+ */
+static inline uint64_t crinitTaskDBHashStr(uint64_t h, const char *str);
+/**
+ * Allocate an empty bucket array for an open-addressing index of elements in a dynamic array.
+ *
+ * The number of buckets will be the smallest power of two which is at least twice \a capacity, so that the load factor
+ * stays at or below 0.5 and linear probing sequences stay short.
+ *
+ * @param buckets   Return pointer for the number of buckets.
+ * @param capacity  The maximum number of elements the index needs to hold.
+ *
+ * @return  The zero-initialized bucket array on success, NULL on error.
+ */
+static size_t *crinitTaskDBIdxAlloc(size_t *buckets, size_t capacity);
+/**
+ * Add the task at a given position in crinitTaskDB_t::taskSet to crinitTaskDB_t::taskIdx.
+ *
+ * The index must have at least one free bucket. Does not check for duplicates.
+ *
+ * @param ctx  The TaskDB context to work on.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ */
+static void crinitTaskIdxAdd(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * (Re-)build crinitTaskDB_t::taskIdx for the current crinitTaskDB_t::taskSetSize.
+ *
+ * Allocates a new bucket array suitable for crinitTaskDB_t::taskSetSize and re-adds all tasks. On error, the old index
+ * is left untouched.
+ *
+ * @param ctx  The TaskDB context to work on.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitTaskIdxRebuild(crinitTaskDB_t *ctx);
+/**
+ * Calculate the starting bucket for a dependency in crinitTaskDB_t::waitIdx.
+ *
+ * As interned strings are unique, the bucket is derived from the string addresses instead of their contents.
+ *
+ * @param ctx    The TaskDB context holding the index.
+ * @param name   The interned dependency name.
+ * @param event  The interned dependency event.
+ *
+ * @return  The bucket at which to start probing.
+ */
+static inline size_t crinitWaitIdxBucket(const crinitTaskDB_t *ctx, const char *name, const char *event);
+/**
+ * Add the entry at a given position in crinitTaskDB_t::waitSet to crinitTaskDB_t::waitIdx.
+ *
+ * The index must have at least one free bucket. Does not check for duplicates.
+ *
+ * @param ctx  The TaskDB context to work on.
+ * @param pos  The position of the entry in crinitTaskDB_t::waitSet.
+ */
+static void crinitWaitIdxAdd(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * Find the entry for a dependency in the reverse dependency index crinitTaskDB_t::waitSet.
+ *
+ * @param ctx  The TaskDB context to search in.
+ * @param dep  The dependency to search for, name and event must be interned.
+ *
+ * @return  A pointer to the entry in crinitTaskDB_t::waitSet if found, NULL otherwise.
+ */
+static crinitTaskDBWaitList_t *crinitWaitListFind(const crinitTaskDB_t *ctx, const crinitTaskDep_t *dep);
+/**
+ * Register a task as waiting for a dependency in the reverse dependency index.
+ *
+ * Creates the crinitTaskDB_t::waitSet entry for \a dep if it does not exist yet. Does nothing if the task is already
+ * registered for \a dep.
+ *
+ * @param ctx  The TaskDB context to work on.
+ * @param dep  The dependency/trigger the task waits for, name and event must be interned.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitWaitListAdd(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep, size_t pos);
 /**
- * Check if an crinitTask_t is considered ready to be started (startable).
+ * Unregister a task as waiting for a dependency in the reverse dependency index.
  *
- * See crinitTaskDBSpawnReady() for further explanation.
+ * Does nothing if the task is not registered for \a dep.
  *
- * @param t The task to be checked for readiness.
+ * @param ctx  The TaskDB context to work on.
+ * @param dep  The dependency/trigger the task no longer waits for, name and event must be interned.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ */
+static void crinitWaitListRemove(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep, size_t pos);
+/**
+ * Register all dependencies and triggers of a task in the reverse dependency index.
+ *
+ * @param ctx  The TaskDB context to work on.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitTaskDBIndexTaskDeps(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * Unregister all dependencies and triggers of a task from the reverse dependency index.
  *
- * @return true if \a t is ready, false otherwise
+ * @param ctx  The TaskDB context to work on.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
  */
-static bool crinitTaskIsReady(const crinitTask_t *t);
+static void crinitTaskDBUnindexTaskDeps(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * Resize crinitTaskDB_t::readyQueue to a new capacity.
+ *
+ * Queued elements keep their order. On error, the old queue is left untouched.
+ *
+ * @param ctx      The TaskDB context to work on.
+ * @param newSize  The new capacity, must not be less than crinitTaskDB_t::taskSetItems or
+ *                 crinitTaskDB_t::readyQueueSize.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitReadyQueueResize(crinitTaskDB_t *ctx, size_t newSize);
+/**
+ * Insert a task into crinitTaskDB_t::readyQueue, keeping the queue ordered by spawn priority.
+ *
+ * Doesn't lock the TaskDB! Only considers the first \a n elements of the queue, the caller needs to adjust
+ * crinitTaskDB_t::readyQueueItems.
+ *
+ * @param ctx  The TaskDB context holding the queue.
+ * @param n    Number of queued elements to sort \a pos into, the queue must have room for \a n + 1 elements.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ */
+static void crinitReadyQueueInsert(crinitTaskDB_t *ctx, size_t n, size_t pos);
+/**
+ * Update the crinitTaskDB_t::taskSched entry of a task and put the task into crinitTaskDB_t::readyQueue if it is ready
+ * to be started and not already queued.
+ *
+ * Must be called whenever one of the task members mirrored in crinitTaskDBSched_t has been changed. Signals
+ * crinitTaskDB_t::ready if the task was queued. Doesn't lock the TaskDB!
+ *
+ * @param ctx  The TaskDB context holding the task.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ */
+static void crinitReadyQueueCheckTask(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * Copy the scheduling relevant members of a task into its crinitTaskDB_t::taskSched entry.
+ *
+ * Leaves #CRINIT_TASKDB_SCHED_QUEUED untouched.
+ *
+ * @param s  The crinitTaskDB_t::taskSched entry to update.
+ * @param t  The task at the same position in crinitTaskDB_t::taskSet.
+ */
+static void crinitTaskDBSchedUpdate(crinitTaskDBSched_t *s, const crinitTask_t *t);
+/**
+ * Count a start of a task towards its current burst interval, see crinitTask_t::respawnBurst.
+ *
+ * Begins a new burst interval if the current one has passed.
+ *
+ * @param t    The task which has been started.
+ * @param now  The time the task has been started (CLOCK_MONOTONIC).
+ */
+static void crinitTaskCountStart(crinitTask_t *t, const struct timespec *now);
+/**
+ * Calculate how long a task which has just ended needs to wait before it is respawned.
+ *
+ * If the task has been started crinitTask_t::respawnBurst times within its burst interval, it needs to wait
+ * crinitTask_t::burstCooldown milliseconds and a new burst interval begins with its next start. Otherwise the delay is
+ * crinitTask_t::respawnDelay, doubled for each consecutive failure after the first and limited to
+ * crinitTask_t::backoffLimit.
+ *
+ * @param t       The task which has just ended. Must be respawned according to its configuration.
+ * @param now     The time the task has ended (CLOCK_MONOTONIC).
+ * @param reason  Return pointer for the state bit to add to crinitTask_t::state while the task waits, either
+ *                #CRINIT_TASK_STATE_BACKOFF or #CRINIT_TASK_STATE_COOLDOWN. Left untouched if there is no delay.
+ *
+ * @return  The delay in milliseconds, 0 if the task can be respawned immediately.
+ */
+static unsigned int crinitTaskRespawnDelay(crinitTask_t *t, const struct timespec *now, crinitTaskState_t *reason);
+/**
+ * Set crinitTaskUsage_t::lastRuntime of a task which has just ended from its start and end timestamps.
+ *
+ * @param t          The task which has just ended.
+ * @param prevState  The state of the task before it ended. If it was not running, the runtime is set to 0 unless the
+ *                   task had already ended before.
+ */
+static void crinitTaskUpdateRuntime(crinitTask_t *t, crinitTaskState_t prevState);
 /**
  * Remove dependency and check trigger for a task.
  * Doesn't lock the TaskDB!
  *
- * @param pTask  The task to remove the dependency/check the trigger for.
- * @param dep    The dependency/tirgger to remove/check.
+ * If the task neither depends on nor is triggered by \a dep afterwards, it is removed from the reverse dependency
+ * index.
  *
- * @return 0 on success and -1 if pTask or dep where not valid.
+ * @param ctx  The TaskDB context holding the task.
+ * @param pos  The position of the task to remove the dependency/check the trigger for in crinitTaskDB_t::taskSet.
+ * @param dep  The dependency/tirgger to remove/check, name and event must be interned.
+ *
+ * @return 0 on success and -1 if dep was not valid.
  */
-static int crinitTaskDBRemoveDepFromTaskStruct(crinitTask_t *pTask, const crinitTaskDep_t *dep);
+static int crinitTaskDBRemoveDepFromTaskStruct(crinitTaskDB_t *ctx, size_t pos, const crinitTaskDep_t *dep);
+/**
+ * Translate a dependency given by the caller of a TaskDB function into its interned form.
+ *
+ * Does not take references to the interned strings, so the result is only valid while crinitTaskDB_t::lock is held.
+ *
+ * @param out  Return pointer for the interned dependency.
+ * @param dep  The dependency to translate.
+ *
+ * @return  true if both name and event of \a dep are interned, false otherwise. In the latter case, no task can be
+ *          waiting for \a dep.
+ */
+static bool crinitTaskDBFindInternedDep(crinitTaskDep_t *out, const crinitTaskDep_t *dep);
+/**
+ * Fulfill a dependency for all tasks waiting for it.
+ * Doesn't lock the TaskDB!
+ *
+ * @param ctx  The TaskDB context.
+ * @param dep  The dependency to fulfill.
+ */
+static void crinitTaskDBFulfillDepUnlocked(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep);
+/**
+ * Check if crinitTaskDBSpawnReady() can complete a ready task itself instead of using crinitTaskDB_t::spawnFunc.
+ *
+ * This is the case for tasks without COMMANDs (meta-tasks) which are started and whose completion has no side effects
+ * outside of the TaskDB, i.e. which neither respawn, nor rearm their triggers, nor have a cgroup to configure.
+ *
+ * @param t     The configuration of the task.
+ * @param mode  The mode crinitTaskDBSpawnReady() has been called with.
+ *
+ * @return  true if the task can be completed inline, false otherwise
+ */
+static bool crinitTaskDBIsInlineMetaTask(const crinitTask_t *t, crinitDispatchThreadMode_t mode);
+/**
+ * Complete a ready meta-task in the same way as the Process Dispatcher would.
+ * Doesn't lock the TaskDB!
+ *
+ * Sets the state of the task to #CRINIT_TASK_STATE_DONE with equal start and end timestamps and fulfills its `wait`
+ * dependency and the features it provides when done. Tasks which become ready through this are queued and so handled by
+ * the same crinitTaskDBSpawnReady() call. The task must already have been taken from crinitTaskDB_t::readyQueue.
+ *
+ * @param ctx  The TaskDB context holding the task.
+ * @param pos  The position of the task in crinitTaskDB_t::taskSet.
+ */
+static void crinitTaskDBCompleteMetaTask(crinitTaskDB_t *ctx, size_t pos);
+/**
+ * Do the rest of the work for the meta-tasks completed by crinitTaskDBSpawnReady() once crinitTaskDB_t::lock is
+ * released.
+ *
+ * Logs the completion, runs the feature hooks, removes timers of the triggers, and releases the configuration
+ * references. Frees the list afterwards.
+ *
+ * @param ctx   The TaskDB context holding the tasks.
+ * @param done  The list of completed tasks.
+ */
+static void crinitTaskDBFinishMetaTasks(crinitTaskDB_t *ctx, crinitTaskDBMetaDone_t *done);
+/**
+ * Signal crinitTaskDB_t::changed and count the change in crinitTaskDB_t::changeGen.
+ *
+ * crinitTaskDB_t::lock must be held.
+ *
+ * @param ctx  The TaskDB context.
+ */
+static inline void crinitTaskDBSignalChange(crinitTaskDB_t *ctx);
+/**
+ * Check if the state and name of a task match a filter of crinitTaskDBExportTaskStatus().
+ *
+ * @param t       The task to check.
+ * @param filter  The filter, may be NULL.
+ *
+ * @return  true if \a t is selected by the state mask and name prefix of \a filter, false otherwise.
+ */
+static bool crinitTaskDBStatusMatch(const crinitTask_t *t, const crinitTaskListFilter_t *filter);
+/**
+ * Copy the status of the tasks selected by a filter.
+ *
+ * Called twice by crinitTaskDBExportTaskStatus(), first without output to count the tasks and to sum up the size of
+ * their strings. crinitTaskDB_t::queryLock must be held for reading.
+ *
+ * @param out      Output array for the status of the tasks, may be NULL.
+ * @param strBuf   Buffer for the strings referenced by \a out, unused if \a out is NULL.
+ * @param strSize  Return pointer for the size of the strings including their terminating null bytes.
+ * @param ctx      The TaskDB context holding the tasks.
+ * @param filter   The filter, may be NULL.
+ *
+ * @return  The number of selected tasks.
+ */
+static size_t crinitTaskDBScanStatus(crinitTaskDBStatus_t *out, char *strBuf, size_t *strSize,
+                                     const crinitTaskDB_t *ctx, const crinitTaskListFilter_t *filter);
 
 int crinitTaskDBInitWithSize(crinitTaskDB_t *ctx,
                              int (*spawnFunc)(crinitTaskDB_t *ctx, const crinitTask_t *,
@@ -63,12 +420,45 @@ int crinitTaskDBInitWithSize(crinitTaskDB_t *ctx,
     }
     ctx->taskSetSize = 0;
     ctx->taskSetItems = 0;
+    ctx->taskIdx = NULL;
+    ctx->taskIdxSize = 0;
+    ctx->waitSet = NULL;
+    ctx->waitSetSize = 0;
+    ctx->waitSetItems = 0;
+    ctx->waitIdx = NULL;
+    ctx->waitIdxSize = 0;
+    ctx->readyQueue = NULL;
+    ctx->readyQueueSize = 0;
+    ctx->readyQueueHead = 0;
+    ctx->readyQueueItems = 0;
+    ctx->borrowed = 0;
     ctx->spawnFunc = NULL;
     ctx->spawnInhibit = true;
-    ctx->taskSet = calloc(initialSize, sizeof(*ctx->taskSet));
-    if (ctx->taskSet == NULL) {
-        crinitErrnoPrint("Could not allocate memory for Task set of size %zu in TaskDB.", initialSize);
-        return -1;
+    ctx->taskSched = NULL;
+    ctx->taskCfg = NULL;
+    ctx->taskSet = NULL;
+    if (crinitTaskSetGrow(ctx, initialSize) == -1) {
+        crinitErrPrint("Could not allocate memory for Task set of size %zu in TaskDB.", initialSize);
+        goto fail;
+    }
+    if (crinitTaskIdxRebuild(ctx) == -1) {
+        crinitErrPrint("Could not initialize task index of TaskDB.");
+        goto fail;
+    }
+    ctx->waitSet = calloc(initialSize, sizeof(*ctx->waitSet));
+    if (ctx->waitSet == NULL) {
+        crinitErrnoPrint("Could not allocate memory for reverse dependency index of size %zu in TaskDB.", initialSize);
+        goto fail;
+    }
+    ctx->waitSetSize = initialSize;
+    ctx->waitIdx = crinitTaskDBIdxAlloc(&ctx->waitIdxSize, ctx->waitSetSize);
+    if (ctx->waitIdx == NULL) {
+        crinitErrPrint("Could not initialize reverse dependency index of TaskDB.");
+        goto fail;
+    }
+    if (crinitReadyQueueResize(ctx, ctx->taskSetSize) == -1) {
+        crinitErrPrint("Could not initialize ready queue of TaskDB.");
+        goto fail;
     }
 
     if ((errno = pthread_mutex_init(&ctx->lock, NULL)) != 0) {
@@ -80,14 +470,47 @@ int crinitTaskDBInitWithSize(crinitTaskDB_t *ctx,
         pthread_mutex_destroy(&ctx->lock);
         goto fail;
     }
+    if ((errno = pthread_cond_init(&ctx->ready, NULL)) != 0) {
+        crinitErrnoPrint("Could not initialize condition variable for TaskDB.");
+        pthread_cond_destroy(&ctx->changed);
+        pthread_mutex_destroy(&ctx->lock);
+        goto fail;
+    }
+    if ((errno = pthread_rwlock_init(&ctx->queryLock, NULL)) != 0) {
+        crinitErrnoPrint("Could not initialize reader/writer lock for TaskDB.");
+        pthread_cond_destroy(&ctx->ready);
+        pthread_cond_destroy(&ctx->changed);
+        pthread_mutex_destroy(&ctx->lock);
+        goto fail;
+    }
 
-    ctx->taskSetSize = initialSize;
     ctx->spawnFunc = spawnFunc;
     ctx->spawnInhibit = false;
+    ctx->changeGen = 0;
+    ctx->spawnFailGen = 0;
     return 0;
 fail:
+    free(ctx->readyQueue);
+    ctx->readyQueue = NULL;
+    free(ctx->waitIdx);
+    ctx->waitIdx = NULL;
+    ctx->waitIdxSize = 0;
+    free(ctx->waitSet);
+    ctx->waitSet = NULL;
+    ctx->waitSetSize = 0;
+    free(ctx->taskIdx);
+    ctx->taskIdx = NULL;
+    ctx->taskIdxSize = 0;
+    free(ctx->taskSched);
+    ctx->taskSched = NULL;
+    free(ctx->taskCfg);
+    ctx->taskCfg = NULL;
+    for (size_t i = 0; i < ctx->taskSetSize / CRINIT_TASKDB_CHUNK_SIZE; i++) {
+        free(ctx->taskSet[i]);
+    }
     free(ctx->taskSet);
     ctx->taskSet = NULL;
+    ctx->taskSetSize = 0;
     return -1;
 }
 
@@ -95,14 +518,56 @@ int crinitTaskDBDestroy(crinitTaskDB_t *ctx) {
     crinitNullCheck(-1, ctx);
 
     ctx->spawnFunc = NULL;
-    ctx->taskSetSize = 0;
     for (size_t i = 0; i < ctx->taskSetItems; i++) {
-        crinitDestroyTask(&ctx->taskSet[i]);
+        crinitTaskCfgRelease(ctx->taskCfg[i]);
+        crinitDestroyTask(crinitTaskDBTaskAt(ctx, i));
     }
     ctx->taskSetItems = 0;
 
+    free(ctx->taskIdx);
+    ctx->taskIdx = NULL;
+    ctx->taskIdxSize = 0;
+    for (size_t i = 0; i < ctx->taskSetSize / CRINIT_TASKDB_CHUNK_SIZE; i++) {
+        free(ctx->taskSet[i]);
+    }
     free(ctx->taskSet);
+    ctx->taskSet = NULL;
+    ctx->taskSetSize = 0;
+    free(ctx->taskSched);
+    ctx->taskSched = NULL;
+    free(ctx->taskCfg);
+    ctx->taskCfg = NULL;
+
+    for (size_t i = 0; i < ctx->waitSetItems; i++) {
+        crinitStrInternRelease(ctx->waitSet[i].name);
+        crinitStrInternRelease(ctx->waitSet[i].event);
+        free(ctx->waitSet[i].waiters);
+    }
+    free(ctx->waitSet);
+    ctx->waitSet = NULL;
+    ctx->waitSetSize = 0;
+    ctx->waitSetItems = 0;
+    free(ctx->waitIdx);
+    ctx->waitIdx = NULL;
+    ctx->waitIdxSize = 0;
+
+    free(ctx->readyQueue);
+    ctx->readyQueue = NULL;
+    ctx->readyQueueSize = 0;
+    ctx->readyQueueHead = 0;
+    ctx->readyQueueItems = 0;
+
     int err = 0;
+    if ((err = pthread_rwlock_destroy(&ctx->queryLock)) != 0) {
+        errno = err;
+        crinitErrnoPrint("Could not destroy reader/writer lock in TaskDB.");
+        return -1;
+    }
+    if ((err = pthread_cond_destroy(&ctx->ready)) != 0) {
+        errno = err;
+        crinitErrnoPrint("Could not destroy condition variable in TaskDB.");
+        return -1;
+    }
     if ((err = pthread_mutex_destroy(&ctx->lock)) != 0) {
         errno = err;
         crinitErrnoPrint("Could not destroy mutex in TaskDB.");
@@ -118,35 +583,183 @@ int crinitTaskDBInsert(crinitTaskDB_t *ctx, const crinitTask_t *t, bool overwrit
         crinitErrnoPrint("Could not queue up for mutex lock.");
         return -1;
     }
+    // Queries may run concurrently as long as we do not hold this, so take it only while the set is being modified.
+    if ((errno = pthread_rwlock_wrlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for write lock.");
+        pthread_mutex_unlock(&ctx->lock);
+        return -1;
+    }
 
-    crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, t->name, ctx) == 0) {
-        if (overwrite) {
+    size_t pos;
+    bool newEntry;
+    crinitTask_t *pTask = crinitTaskDBGetSlot(ctx, &pos, &newEntry, t->name, overwrite);
+    if (pTask == NULL) {
+        goto failQuery;
+    }
+
+    if (crinitTaskCopy(pTask, t) == -1) {
+        crinitErrPrint("Could not copy new Task.");
+        goto failQuery;
+    }
+
+    if (newEntry) {
+        ctx->taskSched[ctx->taskSetItems].flags = 0;
+        ctx->taskSched[ctx->taskSetItems].prio = 0;
+        crinitTaskIdxAdd(ctx, ctx->taskSetItems++);
+    }
+    pthread_rwlock_unlock(&ctx->queryLock);
+
+    if (crinitTaskDBTaskAdded(ctx, pos) == -1) {
+        goto fail;
+    }
+
+    crinitTaskDBSignalChange(ctx);
+    pthread_mutex_unlock(&ctx->lock);
+    return 0;
+failQuery:
+    pthread_rwlock_unlock(&ctx->queryLock);
+fail:
+    pthread_mutex_unlock(&ctx->lock);
+    return -1;
+}
+
+int crinitTaskDBInsertBatch(crinitTaskDB_t *ctx, crinitTask_t **tasks, size_t numTasks, bool overwrite) {
+    crinitNullCheck(-1, ctx, tasks);
+
+    if (numTasks == 0) {
+        return 0;
+    }
+
+    size_t *positions = malloc(numTasks * sizeof(*positions));
+    if (positions == NULL) {
+        crinitErrnoPrint("Could not allocate memory for positions of %zu tasks.", numTasks);
+        return -1;
+    }
+
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        free(positions);
+        return -1;
+    }
+    if ((errno = pthread_rwlock_wrlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for write lock.");
+        pthread_mutex_unlock(&ctx->lock);
+        free(positions);
+        return -1;
+    }
+
+    int ret = 0;
+    // Tasks at or after this position are new in this batch, tasks before it which the batch overwrites are marked in
+    // replaced.
+    const size_t firstNew = ctx->taskSetItems;
+    bool *replaced = NULL;
+    if (overwrite && firstNew > 0 && (replaced = calloc(firstNew, sizeof(*replaced))) == NULL) {
+        crinitErrnoPrint("Could not allocate memory to track overwritten tasks.");
+        ret = -1;
+        numTasks = 0;
+    }
+    // Make room for the whole batch up front, so crinitTaskDBGetSlot() has to rebuild the index at most once.
+    size_t needed = ctx->taskSetItems + numTasks;
+    if (needed > ctx->taskSetSize &&
+        crinitTaskSetGrow(ctx, (needed > ctx->taskSetSize * 2) ? needed : ctx->taskSetSize * 2) == -1) {
+        crinitErrPrint("Could not allocate additional memory for %zu more tasks.", numTasks);
+        ret = -1;
+        numTasks = 0;
+    }
+
+    size_t stored = 0;
+    for (size_t i = 0; i < numTasks; i++) {
+        crinitTask_t *t = tasks[i];
+        if (t == NULL || t->name == NULL) {
+            crinitErrPrint("Task number %zu of the batch is invalid.", i);
+            ret = -1;
+            break;
+        }
+        crinitTask_t *pTask;
+        size_t pos;
+        if (overwrite && crinitFindTask(&pTask, &pos, t->name, ctx) == 0 && (pos >= firstNew || replaced[pos])) {
+            // An earlier task of this batch has the same name. Its dependencies are not indexed yet and it must not be
+            // added twice, so just replace it like crinitTaskDBInsert() would.
             crinitDestroyTask(pTask);
+            crinitTaskMove(pTask, t);
+            continue;
+        }
+        bool newEntry;
+        pTask = crinitTaskDBGetSlot(ctx, &positions[stored], &newEntry, t->name, overwrite);
+        if (pTask == NULL) {
+            ret = -1;
+            break;
+        }
+        crinitTaskMove(pTask, t);
+        if (newEntry) {
+            ctx->taskSched[ctx->taskSetItems].flags = 0;
+            ctx->taskSched[ctx->taskSetItems].prio = 0;
+            crinitTaskIdxAdd(ctx, ctx->taskSetItems++);
         } else {
-            crinitErrPrint("Found task/include with name '%s' already in TaskDB but will not overwrite", t->name);
-            goto fail;
+            replaced[positions[stored]] = true;
         }
+        stored++;
     }
+    pthread_rwlock_unlock(&ctx->queryLock);
+    free(replaced);
 
-    if (pTask == NULL) {
-        if (ctx->taskSetItems == ctx->taskSetSize) {
-            // We need to grow the backing array
-            crinitTask_t *newSet = realloc(ctx->taskSet, ctx->taskSetSize * 2 * sizeof(crinitTask_t));
-            if (newSet == NULL) {
-                crinitErrnoPrint("Could not allocate additional memory for more task/include elements.");
-                goto fail;
-            }
-            ctx->taskSet = newSet;
-            ctx->taskSetSize *= 2;
+    // Everything stored so far is part of the TaskDB now, so finish all of it even if some of the hooks fail.
+    for (size_t i = 0; i < stored; i++) {
+        if (crinitTaskDBTaskAdded(ctx, positions[i]) == -1) {
+            ret = -1;
         }
+    }
 
-        pTask = &ctx->taskSet[ctx->taskSetItems++];
+    // Waiters on crinitTaskDB_t::ready and ::changed cannot run before we unlock, so they wake up only once.
+    if (stored > 0) {
+        crinitTaskDBSignalChange(ctx);
     }
+    pthread_mutex_unlock(&ctx->lock);
+    free(positions);
+    return ret;
+}
 
-    if (crinitTaskCopy(pTask, t) == -1) {
-        crinitErrPrint("Could not copy new Task.");
-        goto fail;
+static crinitTask_t *crinitTaskDBGetSlot(crinitTaskDB_t *ctx, size_t *pos, bool *newEntry, const char *name,
+                                         bool overwrite) {
+    crinitTask_t *pTask;
+    if (crinitFindTask(&pTask, pos, name, ctx) == 0) {
+        if (!overwrite) {
+            crinitErrPrint("Found task/include with name '%s' already in TaskDB but will not overwrite", name);
+            return NULL;
+        }
+        crinitTaskDBUnindexTaskDeps(ctx, *pos);
+        crinitTaskDBDropTaskCfg(ctx, *pos);
+        crinitDestroyTask(pTask);
+        *newEntry = false;
+        return pTask;
+    }
+
+    // We need to add chunks to the backing array, existing tasks stay where they are. The new chunks are kept even if
+    // one of the following steps fails, so the index and ready queue are checked separately and will catch up on the
+    // next insert.
+    if (ctx->taskSetItems == ctx->taskSetSize && crinitTaskSetGrow(ctx, ctx->taskSetSize * 2) == -1) {
+        crinitErrPrint("Could not allocate additional memory for more task/include elements.");
+        return NULL;
+    }
+    if (ctx->taskIdxSize < 2 * ctx->taskSetSize && crinitTaskIdxRebuild(ctx) == -1) {
+        crinitErrPrint("Could not grow task index of TaskDB.");
+        return NULL;
+    }
+    if (ctx->readyQueueSize < ctx->taskSetSize && crinitReadyQueueResize(ctx, ctx->taskSetSize) == -1) {
+        crinitErrPrint("Could not grow ready queue of TaskDB.");
+        return NULL;
+    }
+
+    *pos = ctx->taskSetItems;
+    *newEntry = true;
+    return crinitTaskDBTaskAt(ctx, *pos);
+}
+
+static int crinitTaskDBTaskAdded(crinitTaskDB_t *ctx, size_t pos) {
+    crinitTask_t *pTask = crinitTaskDBTaskAt(ctx, pos);
+    if (crinitTaskDBIndexTaskDeps(ctx, pos) == -1) {
+        crinitErrPrint("Could not add dependencies of task '%s' to reverse dependency index.", pTask->name);
+        return -1;
     }
 
 #ifdef ENABLE_ELOS
@@ -160,15 +773,11 @@ int crinitTaskDBInsert(crinitTaskDB_t *ctx, const crinitTask_t *t, bool overwrit
     crinitDbgInfoPrint("Run feature hooks for 'TASK_ADDED'.");
     if (crinitFeatureHook(NULL, CRINIT_HOOK_TASK_ADDED, pTask) == -1) {
         crinitErrPrint("Could not run activiation hook for feature \'TASK_ADDED\'.");
-        goto fail;
+        return -1;
     }
 
-    pthread_cond_broadcast(&ctx->changed);
-    pthread_mutex_unlock(&ctx->lock);
+    crinitReadyQueueCheckTask(ctx, pos);
     return 0;
-fail:
-    pthread_mutex_unlock(&ctx->lock);
-    return -1;
 }
 
 int crinitTaskDBSpawnReady(crinitTaskDB_t *ctx, crinitDispatchThreadMode_t mode) {
@@ -186,25 +795,198 @@ int crinitTaskDBSpawnReady(crinitTaskDB_t *ctx, crinitDispatchThreadMode_t mode)
 
     if (ctx->spawnFunc == NULL) {
         crinitErrPrint("Could not spawn ready tasks because spawn function pointer was set to NULL.");
+        ctx->spawnFailGen = ctx->changeGen;
         pthread_mutex_unlock(&ctx->lock);
         return -1;
     }
 
-    crinitTask_t *pTask;
-    crinitTaskDbForEach(ctx, pTask) {
-        if (crinitTaskIsReady(pTask)) {
+    int ret = 0, spawnErr = 0;
+    crinitTaskDBMetaDone_t metaDone = {NULL, 0, 0};
+    while (ctx->readyQueueItems > 0) {
+        size_t pos = ctx->readyQueue[ctx->readyQueueHead];
+        crinitTaskDBSched_t *pSched = &ctx->taskSched[pos];
+        if (crinitTaskDBSchedIsReady(pSched)) {
+            crinitTask_t *pTask = crinitTaskDBTaskAt(ctx, pos);
             crinitDbgInfoPrint("Task \'%s\' ready to spawn.", pTask->name);
-            pTask->state = CRINIT_TASK_STATE_STARTING;
+            // The task stays queued on error so that it is retried on the next call.
+            crinitTaskCfg_t *cfg = crinitTaskDBPinTaskCfg(ctx, pos);
+            if (cfg == NULL) {
+                crinitErrPrint("Could not get configuration of task \'%s\' to spawn.", pTask->name);
+                ret = -1;
+                spawnErr = errno;
+                break;
+            }
 
-            if (ctx->spawnFunc(ctx, pTask, mode) == -1) {
-                crinitErrPrint("Could not spawn new thread for execution of task \'%s\'.", pTask->name);
+            // Meta-tasks are completed right here instead of occupying a dispatch worker. If the list cannot grow,
+            // the task is dispatched as usual.
+            if (crinitTaskDBIsInlineMetaTask(&cfg->task, mode)) {
+                if (metaDone.items == metaDone.size) {
+                    size_t newSize = (metaDone.size == 0) ? 8 : metaDone.size * 2;
+                    crinitTaskCfg_t **newCfgs = realloc(metaDone.cfgs, newSize * sizeof(*newCfgs));
+                    if (newCfgs != NULL) {
+                        metaDone.cfgs = newCfgs;
+                        metaDone.size = newSize;
+                    }
+                }
+                if (metaDone.items < metaDone.size) {
+                    metaDone.cfgs[metaDone.items++] = cfg;
+                    // Dequeue first, completing the task may queue tasks with a higher priority in front of it.
+                    pSched->flags &= ~CRINIT_TASKDB_SCHED_QUEUED;
+                    ctx->readyQueueHead = (ctx->readyQueueHead + 1) % ctx->readyQueueSize;
+                    ctx->readyQueueItems--;
+                    crinitTaskDBCompleteMetaTask(ctx, pos);
+                    continue;
+                }
+            }
+            pthread_rwlock_wrlock(&ctx->queryLock);
+            pTask->state = CRINIT_TASK_STATE_STARTING;
+            pthread_rwlock_unlock(&ctx->queryLock);
+            pSched->state = CRINIT_TASK_STATE_STARTING;
+
+            int spawnRet = ctx->spawnFunc(ctx, &cfg->task, mode);
+            spawnErr = errno;
+            crinitTaskCfgRelease(cfg);
+            if (spawnRet == -1) {
+                if (spawnErr == EAGAIN) {
+                    crinitDbgInfoPrint("Dispatch of task \'%s\' deferred, dispatcher is busy.", pTask->name);
+                } else {
+                    crinitErrPrint("Could not dispatch task \'%s\' for execution.", pTask->name);
+                }
+                pthread_rwlock_wrlock(&ctx->queryLock);
                 pTask->state &= ~CRINIT_TASK_STATE_STARTING;
-                pthread_mutex_unlock(&ctx->lock);
-                return -1;
+                pthread_rwlock_unlock(&ctx->queryLock);
+                pSched->state = (uint32_t)pTask->state;
+                ret = -1;
+                break;
             }
         }
+        pSched->flags &= ~CRINIT_TASKDB_SCHED_QUEUED;
+        ctx->readyQueueHead = (ctx->readyQueueHead + 1) % ctx->readyQueueSize;
+        ctx->readyQueueItems--;
+    }
+
+    if (metaDone.items > 0) {
+        crinitTaskDBSignalChange(ctx);
+    }
+    if (ret == -1) {
+        // Only changes from here on may let the failed task through, see crinitTaskDBWaitSpawnRetry().
+        ctx->spawnFailGen = ctx->changeGen;
+    }
+    pthread_mutex_unlock(&ctx->lock);
+    crinitTaskDBFinishMetaTasks(ctx, &metaDone);
+    if (ret == -1) {
+        errno = spawnErr;
+    }
+    return ret;
+}
+
+int crinitTaskDBFindTaskHandle(const crinitTaskDB_t *ctx, crinitTaskHandle_t *handle, const char *taskName) {
+    crinitNullCheck(-1, ctx, handle, taskName);
+
+    crinitTask_t *pTask;
+    return crinitFindTask(&pTask, handle, taskName, ctx);
+}
+
+int crinitTaskDBSetSpawnPrio(crinitTaskDB_t *ctx, const uint32_t *prio, size_t numTasks) {
+    crinitNullCheck(-1, ctx, prio);
+
+    if (numTasks > ctx->taskSetItems) {
+        numTasks = ctx->taskSetItems;
     }
+    for (size_t i = 0; i < numTasks; i++) {
+        ctx->taskSched[i].prio = prio[i];
+    }
+    // Sort the queue again. This is an insertion sort, so tasks of the same priority stay in order.
+    for (size_t n = 1; n < ctx->readyQueueItems; n++) {
+        crinitReadyQueueInsert(ctx, n, ctx->readyQueue[(ctx->readyQueueHead + n) % ctx->readyQueueSize]);
+    }
+    return 0;
+}
+
+crinitTaskCfg_t *crinitTaskDBPinTaskCfg(crinitTaskDB_t *ctx, crinitTaskHandle_t handle) {
+    crinitNullCheck(NULL, ctx);
+
+    if (handle >= ctx->taskSetItems) {
+        crinitErrPrint("Could not find task with handle %zu in TaskDB.", handle);
+        return NULL;
+    }
+    if (ctx->taskCfg[handle] == NULL) {
+        ctx->taskCfg[handle] = crinitTaskCfgCreate(crinitTaskDBTaskAt(ctx, handle));
+        if (ctx->taskCfg[handle] == NULL) {
+            return NULL;
+        }
+    }
+    return crinitTaskCfgRef(ctx->taskCfg[handle]);
+}
+
+int crinitTaskDBGetTaskCfg(crinitTaskDB_t *ctx, crinitTaskCfg_t **cfg, const char *taskName) {
+    crinitNullCheck(-1, ctx, cfg, taskName);
+
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return -1;
+    }
+
+    crinitTask_t *pTask;
+    size_t pos;
+    if (crinitFindTask(&pTask, &pos, taskName, ctx) == -1) {
+        crinitErrPrint("Could not find task \'%s\' in TaskDB.", taskName);
+        pthread_mutex_unlock(&ctx->lock);
+        return -1;
+    }
+    *cfg = crinitTaskDBPinTaskCfg(ctx, pos);
+    pthread_mutex_unlock(&ctx->lock);
+    return (*cfg == NULL) ? -1 : 0;
+}
+
+int crinitTaskDBWaitReady(crinitTaskDB_t *ctx) {
+    crinitNullCheck(-1, ctx);
+
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return -1;
+    }
+
+    while (ctx->readyQueueItems == 0 || ctx->spawnInhibit) {
+        if ((errno = pthread_cond_wait(&ctx->ready, &ctx->lock)) != 0) {
+            crinitErrnoPrint("Could not wait for tasks to become ready.");
+            pthread_mutex_unlock(&ctx->lock);
+            return -1;
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->lock);
+    return 0;
+}
+
+int crinitTaskDBWaitSpawnRetry(crinitTaskDB_t *ctx) {
+    crinitNullCheck(-1, ctx);
+
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return -1;
+    }
+
+    while (ctx->changeGen == ctx->spawnFailGen) {
+        if ((errno = pthread_cond_wait(&ctx->changed, &ctx->lock)) != 0) {
+            crinitErrnoPrint("Could not wait for changes to the TaskDB.");
+            pthread_mutex_unlock(&ctx->lock);
+            return -1;
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->lock);
+    return 0;
+}
+
+int crinitTaskDBDispatchSpaceFreed(crinitTaskDB_t *ctx) {
+    crinitNullCheck(-1, ctx);
 
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return -1;
+    }
+    crinitTaskDBSignalChange(ctx);
     pthread_mutex_unlock(&ctx->lock);
     return 0;
 }
@@ -220,7 +1002,10 @@ int crinitTaskDBSetSpawnInhibit(crinitTaskDB_t *ctx, bool inh) {
     if (inh != ctx->spawnInhibit) {
         ctx->spawnInhibit = inh;
         if (!inh) {
-            pthread_cond_broadcast(&ctx->changed);
+            crinitTaskDBSignalChange(ctx);
+            if (ctx->readyQueueItems > 0) {
+                pthread_cond_broadcast(&ctx->ready);
+            }
         }
     }
     pthread_mutex_unlock(&ctx->lock);
@@ -236,7 +1021,7 @@ int crinitTaskDBGetTaskByName(crinitTaskDB_t *ctx, crinitTask_t **task, const ch
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
         if (crinitTaskDup(task, pTask) != 0) {
             goto failFindTaskByName;
         }
@@ -258,12 +1043,16 @@ int crinitTaskRearmTrigger(crinitTaskDB_t *ctx, const char *taskName) {
         return -1;
     }
     crinitTask_t *pTask;
-    int res = crinitFindTask(&pTask, taskName, ctx);
+    size_t pos;
+    int res = crinitFindTask(&pTask, &pos, taskName, ctx);
     if (res == 0) {
         pTask->triggered = pTask->trigSize == 0;
+        pthread_rwlock_wrlock(&ctx->queryLock);
         pTask->state = CRINIT_TASK_STATE_LOADED;
+        pthread_rwlock_unlock(&ctx->queryLock);
+        crinitReadyQueueCheckTask(ctx, pos);
     }
-    pthread_cond_broadcast(&ctx->changed);
+    crinitTaskDBSignalChange(ctx);
     pthread_mutex_unlock(&ctx->lock);
     return res;
 }
@@ -286,18 +1075,23 @@ int crinitTaskDBSetTaskState(crinitTaskDB_t *ctx, crinitTaskState_t s, const cha
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
+    size_t pos;
+    if (crinitFindTask(&pTask, &pos, taskName, ctx) == 0) {
+        unsigned int respawnDelay = 0;
 #ifdef ENABLE_ELOS
         crinitElosSeverityE_t elosSeverity = ELOS_SEVERITY_INFO;
         crinitElosEventMessageCodeE_t elosMsgCode = ELOS_MSG_CODE_INFO_LOG;
         uint64_t classification = ELOS_CLASSIFICATION_UNDEFINED;
 #endif
+        pthread_rwlock_wrlock(&ctx->queryLock);
+        crinitTaskState_t prevState = pTask->state;
         pTask->state = s;
         s &= ~CRINIT_TASK_STATE_NOTIFIED;  // Here we don't care if we got the state via notification or directly.
         switch (s) {
             case CRINIT_TASK_STATE_FAILED:
                 pTask->failCount++;
                 memcpy(&pTask->endTime, &timestamp, sizeof(pTask->endTime));
+                crinitTaskUpdateRuntime(pTask, prevState);
 #ifdef ENABLE_ELOS
                 elosSeverity = ELOS_SEVERITY_ERROR;
                 elosMsgCode = ELOS_MSG_CODE_EXIT_FAILURE;
@@ -307,6 +1101,7 @@ int crinitTaskDBSetTaskState(crinitTaskDB_t *ctx, crinitTaskState_t s, const cha
             case CRINIT_TASK_STATE_DONE:
                 pTask->failCount = 0;
                 memcpy(&pTask->endTime, &timestamp, sizeof(pTask->endTime));
+                crinitTaskUpdateRuntime(pTask, prevState);
 #ifdef ENABLE_ELOS
                 elosMsgCode = ELOS_MSG_CODE_PROCESS_EXITED;
                 classification = ELOS_CLASSIFICATION_PROCESS;
@@ -314,6 +1109,9 @@ int crinitTaskDBSetTaskState(crinitTaskDB_t *ctx, crinitTaskState_t s, const cha
                 break;
             case CRINIT_TASK_STATE_RUNNING:
                 memcpy(&pTask->startTime, &timestamp, sizeof(pTask->startTime));
+                if (!(prevState & CRINIT_TASK_STATE_RUNNING)) {
+                    crinitTaskCountStart(pTask, &timestamp);
+                }
 #ifdef ENABLE_ELOS
                 elosMsgCode = ELOS_MSG_CODE_PROCESS_CREATED;
                 classification = ELOS_CLASSIFICATION_PROCESS;
@@ -323,8 +1121,26 @@ int crinitTaskDBSetTaskState(crinitTaskDB_t *ctx, crinitTaskState_t s, const cha
                 // do nothing
                 break;
         }
-        pthread_cond_broadcast(&ctx->changed);
+        const crinitTaskState_t waiting = CRINIT_TASK_STATE_BACKOFF | CRINIT_TASK_STATE_COOLDOWN;
+        const bool ended = s & (CRINIT_TASK_STATE_FAILED | CRINIT_TASK_STATE_DONE);
+        if (ended && (prevState & waiting)) {
+            // The end of the task has been reported twice (e.g. via sd_notify() and on exit), keep the running delay.
+            pTask->state |= prevState & waiting;
+        } else if (ended && (pTask->opts & CRINIT_TASK_OPT_RESPAWN) && !pTask->inhibitRespawn &&
+                   (pTask->maxRetries == -1 || pTask->failCount <= pTask->maxRetries)) {
+            crinitTaskState_t reason = 0;
+            respawnDelay = crinitTaskRespawnDelay(pTask, &timestamp, &reason);
+            pTask->state |= reason;
+        }
+        pthread_rwlock_unlock(&ctx->queryLock);
+        crinitReadyQueueCheckTask(ctx, pos);
+        crinitTaskDBSignalChange(ctx);
         pthread_mutex_unlock(&ctx->lock);
+        // Arm the timer without holding the TaskDB lock, as the TimerDB calls into the TaskDB with its own lock held.
+        if (respawnDelay > 0 && crinitTimerDBAddRespawnTimer(taskName, respawnDelay) == -1) {
+            crinitErrPrint("Could not arm respawn timer for Task \'%s\'. Will respawn it immediately.", taskName);
+            crinitTaskDBEndRespawnDelay(ctx, taskName);
+        }
 #ifdef ENABLE_ELOS
         if (crinitElosLog(elosSeverity, elosMsgCode, classification, taskName) == -1) {
             crinitErrPrint("Could not send task event to elos. Will continue but logging may be impaired.");
@@ -342,18 +1158,18 @@ int crinitTaskDBGetTaskState(crinitTaskDB_t *ctx, crinitTaskState_t *s, const ch
     crinitNullCheck(-1, ctx, taskName, s);
 
     *s = 0;
-    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
-        crinitErrnoPrint("Could not queue up for mutex lock.");
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
         return -1;
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
         *s = pTask->state;
-        pthread_mutex_unlock(&ctx->lock);
+        pthread_rwlock_unlock(&ctx->queryLock);
         return 0;
     }
-    pthread_mutex_unlock(&ctx->lock);
+    pthread_rwlock_unlock(&ctx->queryLock);
     crinitErrPrint("Could not get TaskState of Task \'%s\' as it does not exist in TaskDB.", taskName);
     return -1;
 }
@@ -367,8 +1183,10 @@ int crinitTaskDBSetTaskPID(crinitTaskDB_t *ctx, pid_t pid, const char *taskName)
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
+        pthread_rwlock_wrlock(&ctx->queryLock);
         pTask->pid = pid;
+        pthread_rwlock_unlock(&ctx->queryLock);
         pthread_mutex_unlock(&ctx->lock);
         return 0;
     }
@@ -381,19 +1199,137 @@ int crinitTaskDBGetTaskPID(crinitTaskDB_t *ctx, pid_t *pid, const char *taskName
     crinitNullCheck(-1, ctx, taskName, pid);
 
     *pid = -1;
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
+        return -1;
+    }
+
+    crinitTask_t *pTask;
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
+        *pid = pTask->pid;
+        pthread_rwlock_unlock(&ctx->queryLock);
+        return 0;
+    }
+    pthread_rwlock_unlock(&ctx->queryLock);
+    crinitErrPrint("Could not get TaskState of Task \'%s\' as it does not exist in TaskDB.", taskName);
+    return -1;
+}
+
+int crinitTaskDBSetTaskExitStatus(crinitTaskDB_t *ctx, int exitStatus, const char *taskName) {
+    crinitNullCheck(-1, ctx, taskName);
+
     if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
         crinitErrnoPrint("Could not queue up for mutex lock.");
         return -1;
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
-        *pid = pTask->pid;
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
+        pthread_rwlock_wrlock(&ctx->queryLock);
+        pTask->exitStatus = exitStatus;
+        pthread_rwlock_unlock(&ctx->queryLock);
         pthread_mutex_unlock(&ctx->lock);
         return 0;
     }
     pthread_mutex_unlock(&ctx->lock);
-    crinitErrPrint("Could not get TaskState of Task \'%s\' as it does not exist in TaskDB.", taskName);
+    crinitErrPrint("Could not set exit status of Task \'%s\' as it does not exist in TaskDB.", taskName);
+    return -1;
+}
+
+int crinitTaskDBGetTaskExitStatus(crinitTaskDB_t *ctx, int *exitStatus, const char *taskName) {
+    crinitNullCheck(-1, ctx, taskName, exitStatus);
+
+    *exitStatus = -1;
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
+        return -1;
+    }
+
+    crinitTask_t *pTask;
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
+        *exitStatus = pTask->exitStatus;
+        pthread_rwlock_unlock(&ctx->queryLock);
+        return 0;
+    }
+    pthread_rwlock_unlock(&ctx->queryLock);
+    crinitErrPrint("Could not get exit status of Task \'%s\' as it does not exist in TaskDB.", taskName);
+    return -1;
+}
+
+int crinitTaskDBNotify(crinitTaskDB_t *ctx, const char *taskName, const crinitTaskNotify_t *n) {
+    crinitNullCheck(-1, ctx, taskName, n);
+
+    if (n->status != NULL) {
+        crinitInfoPrint("Task \'%s\' reports status \'%.*s\'.", taskName, (int)n->statusLen, n->status);
+    }
+
+    if (n->mainPid > 0 && crinitTaskDBSetTaskPID(ctx, n->mainPid, taskName) == -1) {
+        crinitErrPrint("Could not set main PID of Task \'%s\' to %d.", taskName, n->mainPid);
+        return -1;
+    }
+
+    if (n->ready) {
+        const crinitTaskState_t s = CRINIT_TASK_STATE_RUNNING | CRINIT_TASK_STATE_NOTIFIED;
+        const crinitTaskDep_t dep = {taskName, CRINIT_TASK_EVENT_RUNNING CRINIT_TASK_EVENT_NOTIFY_SUFFIX};
+        if (crinitTaskDBSetTaskState(ctx, s, taskName) == -1) {
+            crinitErrPrint("Could not set state of Task \'%s\' to running.", taskName);
+            return -1;
+        }
+        if (crinitTaskDBFulfillDep(ctx, &dep, NULL) == -1) {
+            crinitErrPrint("Could not fulfill dependency \'%s:%s\'.", dep.name, dep.event);
+            return -1;
+        }
+        if (crinitTaskDBProvideFeatureByTaskName(ctx, taskName, s) == -1) {
+            crinitErrPrint("Could not set features of Task \'%s\' as provided.", taskName);
+            return -1;
+        }
+    }
+
+    if (n->stopping) {
+        const crinitTaskState_t s = CRINIT_TASK_STATE_DONE | CRINIT_TASK_STATE_NOTIFIED;
+        const crinitTaskDep_t dep = {taskName, CRINIT_TASK_EVENT_DONE CRINIT_TASK_EVENT_NOTIFY_SUFFIX};
+        if (crinitTaskDBSetTaskState(ctx, s, taskName) == -1) {
+            crinitErrPrint("Could not set state of Task \'%s\' to done.", taskName);
+            return -1;
+        }
+        if (crinitTaskDBFulfillDep(ctx, &dep, NULL) == -1) {
+            crinitErrPrint("Could not fulfill dependency \'%s:%s\'.", dep.name, dep.event);
+            return -1;
+        }
+        if (crinitTaskDBProvideFeatureByTaskName(ctx, taskName, s) == -1) {
+            crinitErrPrint("Could not set features of Task \'%s\' as provided.", taskName);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int crinitTaskDBAddTaskUsage(crinitTaskDB_t *ctx, const struct rusage *ru, const char *taskName) {
+    crinitNullCheck(-1, ctx, ru, taskName);
+
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return -1;
+    }
+
+    crinitTask_t *pTask;
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
+        pthread_rwlock_wrlock(&ctx->queryLock);
+        crinitTaskUsage_t *u = &pTask->usage;
+        u->userTime += (unsigned long long)ru->ru_utime.tv_sec * 1000000 + ru->ru_utime.tv_usec;
+        u->sysTime += (unsigned long long)ru->ru_stime.tv_sec * 1000000 + ru->ru_stime.tv_usec;
+        if ((unsigned long long)ru->ru_maxrss > u->maxRss) {
+            u->maxRss = ru->ru_maxrss;
+        }
+        u->volCtxSw += ru->ru_nvcsw;
+        u->involCtxSw += ru->ru_nivcsw;
+        u->numProcs++;
+        pthread_rwlock_unlock(&ctx->queryLock);
+        pthread_mutex_unlock(&ctx->lock);
+        return 0;
+    }
+    pthread_mutex_unlock(&ctx->lock);
+    crinitErrPrint("Could not add resource usage to Task '%s' as it does not exist in TaskDB.", taskName);
     return -1;
 }
 
@@ -402,21 +1338,96 @@ int crinitTaskDBGetTaskStateAndPID(crinitTaskDB_t *ctx, crinitTaskState_t *s, pi
 
     *s = 0;
     *pid = 0;
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
+        return -1;
+    }
+
+    crinitTask_t *pTask;
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == 0) {
+        *s = pTask->state;
+        *pid = pTask->pid;
+        pthread_rwlock_unlock(&ctx->queryLock);
+        return 0;
+    }
+    pthread_rwlock_unlock(&ctx->queryLock);
+    crinitErrPrint("Could not get TaskState of Task \'%s\' as it does not exist in TaskDB.", taskName);
+    return -1;
+}
+
+int crinitTaskDBGetTaskStatus(crinitTaskDB_t *ctx, crinitTaskDBStatus_t *status, const char *taskName) {
+    crinitNullCheck(-1, ctx, status, taskName);
+
+    memset(status, 0, sizeof(*status));
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
+        return -1;
+    }
+
+    crinitTask_t *pTask;
+    if (crinitFindTask(&pTask, NULL, taskName, ctx) == -1) {
+        pthread_rwlock_unlock(&ctx->queryLock);
+        crinitErrPrint("Could not get status of Task \'%s\' as it does not exist in TaskDB.", taskName);
+        return -1;
+    }
+
+    status->state = pTask->state;
+    status->pid = pTask->pid;
+    status->createTime = pTask->createTime;
+    status->startTime = pTask->startTime;
+    status->endTime = pTask->endTime;
+    status->usage = pTask->usage;
+    status->user = pTask->user;
+    status->group = pTask->group;
+    status->failCount = pTask->failCount;
+    if (pTask->username != NULL) {
+        status->username = strdup(pTask->username);
+        if (status->username == NULL) {
+            goto fail;
+        }
+    }
+    if (pTask->groupname != NULL) {
+        status->groupname = strdup(pTask->groupname);
+        if (status->groupname == NULL) {
+            goto fail;
+        }
+    }
+    pthread_rwlock_unlock(&ctx->queryLock);
+    return 0;
+
+fail:
+    pthread_rwlock_unlock(&ctx->queryLock);
+    crinitErrnoPrint("Could not allocate memory for status of Task \'%s\'.", taskName);
+    free(status->username);
+    status->username = NULL;
+    return -1;
+}
+
+int crinitTaskDBEndRespawnDelay(crinitTaskDB_t *ctx, const char *taskName) {
+    crinitNullCheck(-1, ctx, taskName);
+
     if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
         crinitErrnoPrint("Could not queue up for mutex lock.");
         return -1;
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
-        *s = pTask->state;
-        *pid = pTask->pid;
+    size_t pos;
+    if (crinitFindTask(&pTask, &pos, taskName, ctx) == -1) {
         pthread_mutex_unlock(&ctx->lock);
-        return 0;
+        crinitErrPrint("Could not find task \'%s\' in TaskDB.", taskName);
+        return -1;
+    }
+    if (pTask->state & (CRINIT_TASK_STATE_BACKOFF | CRINIT_TASK_STATE_COOLDOWN)) {
+        crinitDbgInfoPrint("Respawn delay of Task \'%s\' has passed.", taskName);
+        pthread_rwlock_wrlock(&ctx->queryLock);
+        pTask->state &= ~(CRINIT_TASK_STATE_BACKOFF | CRINIT_TASK_STATE_COOLDOWN);
+        pthread_rwlock_unlock(&ctx->queryLock);
+        crinitReadyQueueCheckTask(ctx, pos);
+        crinitTaskDBSignalChange(ctx);
     }
     pthread_mutex_unlock(&ctx->lock);
-    crinitErrPrint("Could not get TaskState of Task \'%s\' as it does not exist in TaskDB.", taskName);
-    return -1;
+    return 0;
 }
 
 int crinitTaskDBSetTaskRespawnInhibit(crinitTaskDB_t *ctx, bool inhibit, const char *taskName) {
@@ -428,8 +1439,10 @@ int crinitTaskDBSetTaskRespawnInhibit(crinitTaskDB_t *ctx, bool inhibit, const c
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
+    size_t pos;
+    if (crinitFindTask(&pTask, &pos, taskName, ctx) == 0) {
         pTask->inhibitRespawn = inhibit;
+        crinitReadyQueueCheckTask(ctx, pos);
         pthread_mutex_unlock(&ctx->lock);
         return 0;
     }
@@ -447,19 +1460,71 @@ crinitTask_t *crinitTaskDBBorrowTask(crinitTaskDB_t *ctx, const char *taskName)
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == -1) {
+    size_t pos;
+    if (crinitFindTask(&pTask, &pos, taskName, ctx) == -1) {
         crinitErrPrint("Could not find task '%s' in TaskDB.", taskName);
         pthread_mutex_unlock(&ctx->lock);
         return NULL;
     }
+    // The borrower may modify anything in the task, so keep queries out until crinitTaskDBRemit().
+    pthread_rwlock_wrlock(&ctx->queryLock);
+    ctx->borrowed = pos + 1;
     return pTask;
 }
 
+crinitTask_t *crinitTaskDBBorrowTaskByHandle(crinitTaskDB_t *ctx, crinitTaskHandle_t handle) {
+    crinitNullCheck(NULL, ctx);
+
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return NULL;
+    }
+
+    if (handle >= ctx->taskSetItems) {
+        crinitErrPrint("Could not find task with handle %zu in TaskDB.", handle);
+        pthread_mutex_unlock(&ctx->lock);
+        return NULL;
+    }
+    pthread_rwlock_wrlock(&ctx->queryLock);
+    ctx->borrowed = handle + 1;
+    return crinitTaskDBTaskAt(ctx, handle);
+}
+
+int crinitTaskDBGetTaskHandle(crinitTaskDB_t *ctx, crinitTaskHandle_t *handle, const char *taskName) {
+    crinitNullCheck(-1, ctx, handle, taskName);
+
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
+        return -1;
+    }
+
+    crinitTask_t *pTask;
+    if (crinitFindTask(&pTask, handle, taskName, ctx) == -1) {
+        pthread_rwlock_unlock(&ctx->queryLock);
+        crinitErrPrint("Could not get handle of Task \'%s\' as it does not exist in TaskDB.", taskName);
+        return -1;
+    }
+    pthread_rwlock_unlock(&ctx->queryLock);
+    return 0;
+}
+
 int crinitTaskDBRemit(crinitTaskDB_t *ctx) {
     crinitNullCheck(-1, ctx);
 
+    // The borrower may have changed members mirrored in taskSched or the configuration.
+    if (ctx->borrowed != 0) {
+        crinitTaskDBDropTaskCfg(ctx, ctx->borrowed - 1);
+        crinitReadyQueueCheckTask(ctx, ctx->borrowed - 1);
+        ctx->borrowed = 0;
+    }
+
     // This *could* be called from a thread which does not actually own the mutex, so we need to check if
     // pthread_mutex_unlock() fails.
+    errno = pthread_rwlock_unlock(&ctx->queryLock);
+    if (errno != 0) {
+        crinitErrnoPrint("Could not unlock task database reader/writer lock.");
+        return -1;
+    }
     errno = pthread_mutex_unlock(&ctx->lock);
     if (errno != 0) {
         crinitErrnoPrint("Could not unlock task database mutex.");
@@ -477,67 +1542,86 @@ int crinitTaskDBAddDepToTask(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep, co
     }
 
     crinitTask_t *pTask;
+    size_t pos;
     crinitTaskDep_t *pDep;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
+    if (crinitFindTask(&pTask, &pos, taskName, ctx) == 0) {
+        crinitTaskDep_t newDep = {crinitStrIntern(dep->name), crinitStrIntern(dep->event)};
+        if (newDep.name == NULL || newDep.event == NULL) {
+            crinitErrPrint("Could not intern dependency \'%s:%s\' for task \'%s\'.", dep->name, dep->event, taskName);
+            goto failDep;
+        }
         // Return immediately if dependency is already present
         crinitTaskForEachDep(pTask, pDep) {
-            if (strcmp(pDep->name, dep->name) == 0 && strcmp(pDep->event, dep->event) == 0) {
+            if (pDep->name == newDep.name && pDep->event == newDep.event) {
+                crinitStrInternRelease(newDep.name);
+                crinitStrInternRelease(newDep.event);
                 pthread_mutex_unlock(&ctx->lock);
                 return 0;
             }
         }
-        pTask->depsSize++;
-        crinitTaskDep_t *pTempDeps = realloc(pTask->deps, pTask->depsSize * sizeof(crinitTaskDep_t));
+        crinitTaskDep_t *pTempDeps = realloc(pTask->deps, (pTask->depsSize + 1) * sizeof(crinitTaskDep_t));
         if (pTempDeps == NULL) {
             crinitErrnoPrint("Could not reallocate memory of dependency array for task \'%s\'.", taskName);
-            pTask->depsSize--;
-            pthread_mutex_unlock(&ctx->lock);
-            return -1;
+            goto failDep;
         }
         pTask->deps = pTempDeps;
-        size_t lastIdx = pTask->depsSize - 1;
-        size_t nameCopyLen = strlen(dep->name) + 1;
-        size_t eventCopyLen = strlen(dep->event) + 1;
-        pTask->deps[lastIdx].name = malloc(nameCopyLen + eventCopyLen);
-
-        if (pTask->deps[lastIdx].name == NULL) {
-            crinitErrnoPrint("Could not allocate memory for dependency backing string for task \'%s\'.", taskName);
-            pTask->depsSize--;
-            pthread_mutex_unlock(&ctx->lock);
-            return -1;
+        if (crinitWaitListAdd(ctx, &newDep, pos) == -1) {
+            crinitErrPrint("Could not add dependency to reverse dependency index for task \'%s\'.", taskName);
+            goto failDep;
         }
-        pTask->deps[lastIdx].event = pTask->deps[lastIdx].name + nameCopyLen;
-        memcpy(pTask->deps[lastIdx].name, dep->name, nameCopyLen);
-        memcpy(pTask->deps[lastIdx].event, dep->event, eventCopyLen);
+        pTask->deps[pTask->depsSize++] = newDep;
+        crinitReadyQueueCheckTask(ctx, pos);
         pthread_mutex_unlock(&ctx->lock);
         return 0;
+
+    failDep:
+        crinitStrInternRelease(newDep.name);
+        crinitStrInternRelease(newDep.event);
+        pthread_mutex_unlock(&ctx->lock);
+        return -1;
     }
     pthread_mutex_unlock(&ctx->lock);
     crinitErrPrint("Could not find task \'%s\' in TaskDB.", taskName);
     return -1;
 }
 
-static int crinitTaskDBRemoveDepFromTaskStruct(crinitTask_t *pTask, const crinitTaskDep_t *dep) {
-    crinitNullCheck(-1, pTask, dep);
-    for (size_t j = 0; j < pTask->depsSize; j++) {
-        if ((strcmp(pTask->deps[j].name, dep->name) == 0) && (strcmp(pTask->deps[j].event, dep->event) == 0)) {
+static int crinitTaskDBRemoveDepFromTaskStruct(crinitTaskDB_t *ctx, size_t pos, const crinitTaskDep_t *dep) {
+    crinitNullCheck(-1, ctx, dep);
+    crinitTask_t *pTask = crinitTaskDBTaskAt(ctx, pos);
+    bool removed = false, isTrigger = false;
+    size_t j = 0;
+    while (j < pTask->depsSize) {
+        if (pTask->deps[j].name == dep->name && pTask->deps[j].event == dep->event) {
             crinitDbgInfoPrint("Removing dependency \'%s:%s\' in \'%s\'.", dep->name, dep->event, pTask->name);
             if (0 == strcmp(dep->name, "@timer")) {
                 crinitTimerDBRemoveTimer(dep->event);
             }
-            free(pTask->deps[j].name);
+            crinitStrInternRelease(pTask->deps[j].name);
+            crinitStrInternRelease(pTask->deps[j].event);
             if (j < pTask->depsSize - 1) {
                 pTask->deps[j] = pTask->deps[pTask->depsSize - 1];
             }
             pTask->depsSize--;
+            removed = true;
+            // Do not advance j, the element swapped in from the back needs to be checked as well.
+            continue;
         }
+        j++;
     }
-    for (size_t j = 0; j < pTask->trigSize; j++) {
-        if ((strcmp(pTask->trig[j].name, dep->name) == 0) && (strcmp(pTask->trig[j].event, dep->event) == 0)) {
+    for (j = 0; j < pTask->trigSize; j++) {
+        if (pTask->trig[j].name == dep->name && pTask->trig[j].event == dep->event) {
             crinitDbgInfoPrint("Trigger \'%s:%s\' in \'%s\'.", dep->name, dep->event, pTask->name);
             pTask->triggered = true;
+            isTrigger = true;
         }
     }
+    // Triggers stay in place so they can be rearmed, so only drop the task from the index if dep was no trigger.
+    if (removed && !isTrigger) {
+        crinitWaitListRemove(ctx, dep, pos);
+    }
+    if (removed || isTrigger) {
+        crinitReadyQueueCheckTask(ctx, pos);
+    }
     return 0;
 }
 
@@ -550,9 +1634,13 @@ int crinitTaskDBRemoveDepFromTask(crinitTaskDB_t *ctx, const crinitTaskDep_t *de
     }
 
     crinitTask_t *pTask;
-    if (crinitFindTask(&pTask, taskName, ctx) == 0) {
-        crinitTaskDBRemoveDepFromTaskStruct(pTask, dep);
-        pthread_cond_broadcast(&ctx->changed);
+    size_t pos;
+    if (crinitFindTask(&pTask, &pos, taskName, ctx) == 0) {
+        crinitTaskDep_t internedDep;
+        if (crinitTaskDBFindInternedDep(&internedDep, dep)) {
+            crinitTaskDBRemoveDepFromTaskStruct(ctx, pos, &internedDep);
+        }
+        crinitTaskDBSignalChange(ctx);
         pthread_mutex_unlock(&ctx->lock);
         return 0;
     }
@@ -569,15 +1657,21 @@ int crinitTaskDBFulfillDep(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep, crin
         return -1;
     }
 
-    if (target != NULL) {
-        crinitTaskDBRemoveDepFromTaskStruct(target, dep);
-    } else {
-        crinitTask_t *pTask;
-        crinitTaskDbForEach(ctx, pTask) {
-            crinitTaskDBRemoveDepFromTaskStruct(pTask, dep);
-        }
+    crinitTaskDep_t internedDep;
+    size_t pos;
+    if (target != NULL && crinitFindTaskPos(&pos, target, ctx) == -1) {
+        crinitErrPrint("Could not fulfill dependency \'%s:%s\' for task \'%s\' as it is not part of the TaskDB.",
+                       dep->name, dep->event, target->name);
+        pthread_mutex_unlock(&ctx->lock);
+        return -1;
     }
-    pthread_cond_broadcast(&ctx->changed);
+
+    if (target == NULL) {
+        crinitTaskDBFulfillDepUnlocked(ctx, dep);
+    } else if (crinitTaskDBFindInternedDep(&internedDep, dep)) {
+        crinitTaskDBRemoveDepFromTaskStruct(ctx, pos, &internedDep);
+    }
+    crinitTaskDBSignalChange(ctx);
     pthread_mutex_unlock(&ctx->lock);
     return 0;
 }
@@ -587,8 +1681,7 @@ int crinitTaskDBProvideFeature(crinitTaskDB_t *ctx, const crinitTask_t *provider
 
     for (size_t i = 0; i < provider->prvSize; i++) {
         if (provider->prv[i].stateReq == newState) {
-            char depName[] = CRINIT_PROVIDE_DEP_NAME;
-            const crinitTaskDep_t dep = {depName, provider->prv[i].name};
+            const crinitTaskDep_t dep = {CRINIT_PROVIDE_DEP_NAME, provider->prv[i].name};
             if (crinitTaskDBFulfillDep(ctx, &dep, NULL) == -1) {
                 crinitErrPrint("Could not fulfill dependency \'%s:%s\'.", dep.name, dep.event);
                 return -1;
@@ -617,8 +1710,9 @@ int crinitTaskDBProvideFeatureByTaskName(crinitTaskDB_t *ctx, const char *taskNa
     }
 
     crinitTask_t *provider;
-    if (crinitFindTask(&provider, taskName, ctx) == -1) {
+    if (crinitFindTask(&provider, NULL, taskName, ctx) == -1) {
         crinitErrPrint("Could not find task \'%s\' in TaskDB.", taskName);
+        pthread_mutex_unlock(&ctx->lock);
         return -1;
     }
     pthread_mutex_unlock(&ctx->lock);
@@ -632,8 +1726,8 @@ int crinitTaskDBExportTaskNamesToArray(crinitTaskDB_t *ctx, char **tasks[], size
 
     crinitNullCheck(-1, ctx, tasks, numTasks);
 
-    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
-        crinitErrnoPrint("Could not queue up for mutex lock.");
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
         return -1;
     }
 
@@ -641,12 +1735,12 @@ int crinitTaskDBExportTaskNamesToArray(crinitTaskDB_t *ctx, char **tasks[], size
     *tasks = calloc(ctx->taskSetItems, sizeof(*tasks));
     if (*tasks == NULL) {
         crinitErrnoPrint("Could not allocate memory for task array.");
-        pthread_mutex_unlock(&ctx->lock);
+        pthread_rwlock_unlock(&ctx->queryLock);
         return -1;
     }
 
     for (i = 0; i < ctx->taskSetItems; i++) {
-        (*tasks)[i] = strdup(ctx->taskSet[i].name);
+        (*tasks)[i] = strdup(crinitTaskDBTaskAt(ctx, i)->name);
         if ((*tasks)[i] == NULL) {
             crinitErrnoPrint("Could not allocate memory for task name.");
             ret = -1;
@@ -658,23 +1752,58 @@ int crinitTaskDBExportTaskNamesToArray(crinitTaskDB_t *ctx, char **tasks[], size
         *numTasks = i;
     } else {
         for (size_t j = 0; j < i; j++) {
-            free((*tasks)[i]);
+            free((*tasks)[j]);
         }
         free(*tasks);
         *tasks = NULL;
     }
 
-    pthread_mutex_unlock(&ctx->lock);
+    pthread_rwlock_unlock(&ctx->queryLock);
     return ret;
 }
 
-static int crinitFindTask(crinitTask_t **task, const char *taskName, const crinitTaskDB_t *in) {
+int crinitTaskDBExportTaskStatus(crinitTaskDB_t *ctx, crinitTaskDBStatus_t **tasks, size_t *numTasks,
+                                 const crinitTaskListFilter_t *filter) {
+    crinitNullCheck(-1, ctx, tasks, numTasks);
+
+    *tasks = NULL;
+    *numTasks = 0;
+    if ((errno = pthread_rwlock_rdlock(&ctx->queryLock)) != 0) {
+        crinitErrnoPrint("Could not queue up for read lock.");
+        return -1;
+    }
+
+    size_t strSize;
+    size_t n = crinitTaskDBScanStatus(NULL, NULL, &strSize, ctx, filter);
+    if (n == 0) {
+        pthread_rwlock_unlock(&ctx->queryLock);
+        return 0;
+    }
+
+    *tasks = malloc(n * sizeof(**tasks) + strSize);
+    if (*tasks == NULL) {
+        crinitErrnoPrint("Could not allocate memory for status of %zu tasks.", n);
+        pthread_rwlock_unlock(&ctx->queryLock);
+        return -1;
+    }
+    *numTasks = crinitTaskDBScanStatus(*tasks, (char *)(*tasks + n), &strSize, ctx, filter);
+
+    pthread_rwlock_unlock(&ctx->queryLock);
+    return 0;
+}
+
+static int crinitFindTask(crinitTask_t **task, size_t *pos, const char *taskName, const crinitTaskDB_t *in) {
     crinitNullCheck(-1, taskName, in);
 
-    crinitTask_t *pTask;
-    crinitTaskDbForEach(in, pTask) {
+    size_t mask = in->taskIdxSize - 1;
+    size_t b = crinitTaskDBHashStr(CRINIT_TASKDB_HASH_INIT, taskName) & mask;
+    for (; in->taskIdx[b] != 0; b = (b + 1) & mask) {
+        crinitTask_t *pTask = crinitTaskDBTaskAt(in, in->taskIdx[b] - 1);
         if (strcmp(taskName, pTask->name) == 0) {
             *task = pTask;
+            if (pos != NULL) {
+                *pos = in->taskIdx[b] - 1;
+            }
             return 0;
         }
     }
@@ -684,28 +1813,518 @@ static int crinitFindTask(crinitTask_t **task, const char *taskName, const crini
     return -1;
 }
 
-static bool crinitTaskIsReady(const crinitTask_t *t) {
-    crinitNullCheck(false, t);
+static int crinitFindTaskPos(size_t *pos, const crinitTask_t *pTask, const crinitTaskDB_t *in) {
+    uintptr_t addr = (uintptr_t)pTask;
+    for (size_t c = 0; c * CRINIT_TASKDB_CHUNK_SIZE < in->taskSetItems; c++) {
+        uintptr_t chunk = (uintptr_t)in->taskSet[c];
+        if (addr >= chunk && addr < chunk + CRINIT_TASKDB_CHUNK_SIZE * sizeof(crinitTask_t)) {
+            size_t p = c * CRINIT_TASKDB_CHUNK_SIZE + (addr - chunk) / sizeof(crinitTask_t);
+            if (p >= in->taskSetItems) {
+                return -1;
+            }
+            *pos = p;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int crinitTaskSetGrow(crinitTaskDB_t *ctx, size_t newSize) {
+    size_t oldChunks = ctx->taskSetSize / CRINIT_TASKDB_CHUNK_SIZE;
+    size_t newChunks = (newSize + CRINIT_TASKDB_CHUNK_SIZE - 1) / CRINIT_TASKDB_CHUNK_SIZE;
+    if (newChunks <= oldChunks) {
+        return 0;
+    }
+
+    crinitTask_t **newSet = realloc(ctx->taskSet, newChunks * sizeof(*newSet));
+    if (newSet == NULL) {
+        crinitErrnoPrint("Could not allocate memory for %zu chunks of the Task set.", newChunks);
+        return -1;
+    }
+    ctx->taskSet = newSet;
+    crinitTaskDBSched_t *newSched = realloc(ctx->taskSched, newChunks * CRINIT_TASKDB_CHUNK_SIZE * sizeof(*newSched));
+    if (newSched == NULL) {
+        crinitErrnoPrint("Could not allocate memory for scheduling state of %zu tasks.",
+                         newChunks * CRINIT_TASKDB_CHUNK_SIZE);
+        return -1;
+    }
+    ctx->taskSched = newSched;
+    crinitTaskCfg_t **newCfg = realloc(ctx->taskCfg, newChunks * CRINIT_TASKDB_CHUNK_SIZE * sizeof(*newCfg));
+    if (newCfg == NULL) {
+        crinitErrnoPrint("Could not allocate memory for configuration snapshots of %zu tasks.",
+                         newChunks * CRINIT_TASKDB_CHUNK_SIZE);
+        return -1;
+    }
+    ctx->taskCfg = newCfg;
+    memset(&ctx->taskCfg[ctx->taskSetSize], 0,
+           (newChunks * CRINIT_TASKDB_CHUNK_SIZE - ctx->taskSetSize) * sizeof(*ctx->taskCfg));
+
+    for (size_t c = oldChunks; c < newChunks; c++) {
+        ctx->taskSet[c] = calloc(CRINIT_TASKDB_CHUNK_SIZE, sizeof(crinitTask_t));
+        if (ctx->taskSet[c] == NULL) {
+            crinitErrnoPrint("Could not allocate memory for a chunk of %d tasks.", CRINIT_TASKDB_CHUNK_SIZE);
+            while (c-- > oldChunks) {
+                free(ctx->taskSet[c]);
+            }
+            return -1;
+        }
+    }
+    ctx->taskSetSize = newChunks * CRINIT_TASKDB_CHUNK_SIZE;
+    return 0;
+}
+
+static inline uint64_t crinitTaskDBHashStr(uint64_t h, const char *str) {
+    while (*str != '\0') {
+        h ^= (unsigned char)*str++;
+        h *= CRINIT_TASKDB_HASH_PRIME;
+    }
+    return h;
+}
+
+static size_t *crinitTaskDBIdxAlloc(size_t *buckets, size_t capacity) {
+    size_t n = 1;
+    while (n < 2 * capacity) {
+        n <<= 1;
+    }
+
+    size_t *idx = calloc(n, sizeof(*idx));
+    if (idx == NULL) {
+        crinitErrnoPrint("Could not allocate memory for index with %zu buckets.", n);
+        return NULL;
+    }
+    *buckets = n;
+    return idx;
+}
+
+static void crinitTaskIdxAdd(crinitTaskDB_t *ctx, size_t pos) {
+    size_t mask = ctx->taskIdxSize - 1;
+    size_t b = crinitTaskDBHashStr(CRINIT_TASKDB_HASH_INIT, crinitTaskDBTaskAt(ctx, pos)->name) & mask;
+    while (ctx->taskIdx[b] != 0) {
+        b = (b + 1) & mask;
+    }
+    ctx->taskIdx[b] = pos + 1;
+}
+
+static int crinitTaskIdxRebuild(crinitTaskDB_t *ctx) {
+    size_t newSize;
+    size_t *newIdx = crinitTaskDBIdxAlloc(&newSize, ctx->taskSetSize);
+    if (newIdx == NULL) {
+        return -1;
+    }
+
+    free(ctx->taskIdx);
+    ctx->taskIdx = newIdx;
+    ctx->taskIdxSize = newSize;
+    for (size_t i = 0; i < ctx->taskSetItems; i++) {
+        crinitTaskIdxAdd(ctx, i);
+    }
+    return 0;
+}
+
+static inline size_t crinitWaitIdxBucket(const crinitTaskDB_t *ctx, const char *name, const char *event) {
+    uint64_t h = (CRINIT_TASKDB_HASH_INIT ^ (uintptr_t)name) * CRINIT_TASKDB_HASH_PRIME;
+    h = (h ^ (uintptr_t)event) * CRINIT_TASKDB_HASH_PRIME;
+    // The low bits of heap addresses are mostly alignment, mix in the upper half before masking.
+    return (size_t)(h ^ (h >> 32)) & (ctx->waitIdxSize - 1);
+}
+
+static crinitTaskDBWaitList_t *crinitWaitListFind(const crinitTaskDB_t *ctx, const crinitTaskDep_t *dep) {
+    size_t mask = ctx->waitIdxSize - 1;
+    for (size_t b = crinitWaitIdxBucket(ctx, dep->name, dep->event); ctx->waitIdx[b] != 0; b = (b + 1) & mask) {
+        crinitTaskDBWaitList_t *wl = &ctx->waitSet[ctx->waitIdx[b] - 1];
+        if (wl->name == dep->name && wl->event == dep->event) {
+            return wl;
+        }
+    }
+    return NULL;
+}
+
+static void crinitWaitIdxAdd(crinitTaskDB_t *ctx, size_t pos) {
+    size_t mask = ctx->waitIdxSize - 1;
+    size_t b = crinitWaitIdxBucket(ctx, ctx->waitSet[pos].name, ctx->waitSet[pos].event);
+    while (ctx->waitIdx[b] != 0) {
+        b = (b + 1) & mask;
+    }
+    ctx->waitIdx[b] = pos + 1;
+}
+
+static int crinitWaitListAdd(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep, size_t pos) {
+    crinitTaskDBWaitList_t *wl = crinitWaitListFind(ctx, dep);
+    if (wl == NULL) {
+        if (ctx->waitSetItems == ctx->waitSetSize) {
+            // We need to grow the backing array and its index.
+            size_t newSize = ctx->waitSetSize * 2, newIdxSize;
+            size_t *newIdx = crinitTaskDBIdxAlloc(&newIdxSize, newSize);
+            if (newIdx == NULL) {
+                return -1;
+            }
+            crinitTaskDBWaitList_t *newSet = realloc(ctx->waitSet, newSize * sizeof(*newSet));
+            if (newSet == NULL) {
+                crinitErrnoPrint("Could not allocate additional memory for reverse dependency index.");
+                free(newIdx);
+                return -1;
+            }
+            ctx->waitSet = newSet;
+            ctx->waitSetSize = newSize;
+            free(ctx->waitIdx);
+            ctx->waitIdx = newIdx;
+            ctx->waitIdxSize = newIdxSize;
+            for (size_t i = 0; i < ctx->waitSetItems; i++) {
+                crinitWaitIdxAdd(ctx, i);
+            }
+        }
+
+        wl = &ctx->waitSet[ctx->waitSetItems];
+        wl->name = crinitStrInternRef(dep->name);
+        wl->event = crinitStrInternRef(dep->event);
+        wl->waiters = NULL;
+        wl->waitersSize = 0;
+        wl->waitersCap = 0;
+        crinitWaitIdxAdd(ctx, ctx->waitSetItems++);
+    }
+
+    for (size_t i = 0; i < wl->waitersSize; i++) {
+        if (wl->waiters[i] == pos) {
+            return 0;
+        }
+    }
+
+    if (wl->waitersSize == wl->waitersCap) {
+        size_t newCap = (wl->waitersCap == 0) ? 4 : wl->waitersCap * 2;
+        size_t *newWaiters = realloc(wl->waiters, newCap * sizeof(*newWaiters));
+        if (newWaiters == NULL) {
+            crinitErrnoPrint("Could not allocate memory for waiting tasks of '%s:%s'.", dep->name, dep->event);
+            return -1;
+        }
+        wl->waiters = newWaiters;
+        wl->waitersCap = newCap;
+    }
+    wl->waiters[wl->waitersSize++] = pos;
+    return 0;
+}
+
+static void crinitWaitListRemove(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep, size_t pos) {
+    crinitTaskDBWaitList_t *wl = crinitWaitListFind(ctx, dep);
+    if (wl == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < wl->waitersSize; i++) {
+        if (wl->waiters[i] == pos) {
+            wl->waiters[i] = wl->waiters[--wl->waitersSize];
+            return;
+        }
+    }
+}
+
+static int crinitTaskDBIndexTaskDeps(crinitTaskDB_t *ctx, size_t pos) {
+    const crinitTask_t *pTask = crinitTaskDBTaskAt(ctx, pos);
+    const crinitTaskDep_t *pDep;
+    crinitTaskForEachDep(pTask, pDep) {
+        if (crinitWaitListAdd(ctx, pDep, pos) == -1) {
+            return -1;
+        }
+    }
+    crinitTaskForEachTrig(pTask, pDep) {
+        if (crinitWaitListAdd(ctx, pDep, pos) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void crinitTaskDBUnindexTaskDeps(crinitTaskDB_t *ctx, size_t pos) {
+    const crinitTask_t *pTask = crinitTaskDBTaskAt(ctx, pos);
+    const crinitTaskDep_t *pDep;
+    crinitTaskForEachDep(pTask, pDep) {
+        crinitWaitListRemove(ctx, pDep, pos);
+    }
+    crinitTaskForEachTrig(pTask, pDep) {
+        crinitWaitListRemove(ctx, pDep, pos);
+    }
+}
+
+static int crinitReadyQueueResize(crinitTaskDB_t *ctx, size_t newSize) {
+    size_t *newQueue = malloc(newSize * sizeof(*newQueue));
+    if (newQueue == NULL) {
+        crinitErrnoPrint("Could not allocate memory for ready queue of size %zu.", newSize);
+        return -1;
+    }
+
+    for (size_t i = 0; i < ctx->readyQueueItems; i++) {
+        newQueue[i] = ctx->readyQueue[(ctx->readyQueueHead + i) % ctx->readyQueueSize];
+    }
+
+    free(ctx->readyQueue);
+    ctx->readyQueue = newQueue;
+    ctx->readyQueueSize = newSize;
+    ctx->readyQueueHead = 0;
+    return 0;
+}
+
+static void crinitReadyQueueInsert(crinitTaskDB_t *ctx, size_t n, size_t pos) {
+    uint32_t prio = ctx->taskSched[pos].prio;
+    // Usually all queued tasks have the same or a higher priority, so this does not need to move anything.
+    for (; n > 0; n--) {
+        size_t prev = ctx->readyQueue[(ctx->readyQueueHead + n - 1) % ctx->readyQueueSize];
+        if (ctx->taskSched[prev].prio >= prio) {
+            break;
+        }
+        ctx->readyQueue[(ctx->readyQueueHead + n) % ctx->readyQueueSize] = prev;
+    }
+    ctx->readyQueue[(ctx->readyQueueHead + n) % ctx->readyQueueSize] = pos;
+}
+
+static void crinitTaskDBDropTaskCfg(crinitTaskDB_t *ctx, size_t pos) {
+    crinitTaskCfgRelease(ctx->taskCfg[pos]);
+    ctx->taskCfg[pos] = NULL;
+}
+
+static void crinitReadyQueueCheckTask(crinitTaskDB_t *ctx, size_t pos) {
+    crinitTaskDBSched_t *pSched = &ctx->taskSched[pos];
+    crinitTaskDBSchedUpdate(pSched, crinitTaskDBTaskAt(ctx, pos));
+    if ((pSched->flags & CRINIT_TASKDB_SCHED_QUEUED) || !crinitTaskDBSchedIsReady(pSched)) {
+        return;
+    }
+    crinitReadyQueueInsert(ctx, ctx->readyQueueItems, pos);
+    ctx->readyQueueItems++;
+    pSched->flags |= CRINIT_TASKDB_SCHED_QUEUED;
+    pthread_cond_broadcast(&ctx->ready);
+}
 
+static void crinitTaskDBSchedUpdate(crinitTaskDBSched_t *s, const crinitTask_t *t) {
+    uint32_t flags = s->flags & CRINIT_TASKDB_SCHED_QUEUED;
+    if (t->triggered) {
+        flags |= CRINIT_TASKDB_SCHED_TRIGGERED;
+    }
+    if (t->opts & CRINIT_TASK_OPT_RESPAWN) {
+        flags |= CRINIT_TASKDB_SCHED_RESPAWN;
+    }
+    if (t->inhibitRespawn) {
+        flags |= CRINIT_TASKDB_SCHED_INHIBIT_RESPAWN;
+    }
     if (t->depsSize != 0) {
+        flags |= CRINIT_TASKDB_SCHED_DEPS_PENDING;
+    }
+    s->state = (uint32_t)t->state;
+    s->failCount = t->failCount;
+    s->maxRetries = t->maxRetries;
+    s->flags = flags;
+}
+
+static bool crinitTaskDBFindInternedDep(crinitTaskDep_t *out, const crinitTaskDep_t *dep) {
+    out->name = crinitStrInternFind(dep->name);
+    out->event = crinitStrInternFind(dep->event);
+    return out->name != NULL && out->event != NULL;
+}
+
+static void crinitTaskCountStart(crinitTask_t *t, const struct timespec *now) {
+    if (t->respawnBurst == 0) {
+        return;
+    }
+    long long elapsedMs =
+        (long long)(now->tv_sec - t->burstStart.tv_sec) * 1000LL + (now->tv_nsec - t->burstStart.tv_nsec) / 1000000L;
+    if (t->burstCount == 0 || elapsedMs >= t->burstInterval) {
+        t->burstStart = *now;
+        t->burstCount = 0;
+    }
+    t->burstCount++;
+}
+
+static unsigned int crinitTaskRespawnDelay(crinitTask_t *t, const struct timespec *now, crinitTaskState_t *reason) {
+    if (t->respawnBurst > 0 && t->burstCount >= t->respawnBurst) {
+        long long elapsedMs = (long long)(now->tv_sec - t->burstStart.tv_sec) * 1000LL +
+                              (now->tv_nsec - t->burstStart.tv_nsec) / 1000000L;
+        if (elapsedMs < t->burstInterval) {
+            crinitInfoPrint("Task \'%s\' has been started %u times within %lld ms. Will cool down for %u ms.", t->name,
+                            t->burstCount, elapsedMs, t->burstCooldown);
+            t->burstCount = 0;
+            if (t->burstCooldown > 0) {
+                *reason = CRINIT_TASK_STATE_COOLDOWN;
+            }
+            return t->burstCooldown;
+        }
+    }
+
+    if (t->respawnDelay == 0) {
+        return 0;
+    }
+    unsigned long long delay = t->respawnDelay;
+    for (int i = 1; i < t->failCount && delay < t->backoffLimit; i++) {
+        delay *= 2;
+    }
+    if (delay > t->backoffLimit) {
+        delay = t->backoffLimit;
+    }
+    if (delay > 0) {
+        crinitInfoPrint("Task \'%s\' will be respawned in %llu ms.", t->name, delay);
+        *reason = CRINIT_TASK_STATE_BACKOFF;
+    }
+    return (unsigned int)delay;
+}
+
+static void crinitTaskUpdateRuntime(crinitTask_t *t, crinitTaskState_t prevState) {
+    if (prevState & (CRINIT_TASK_STATE_DONE | CRINIT_TASK_STATE_FAILED)) {
+        return;  // The end of the task has been reported twice (e.g. via sd_notify() and on exit).
+    }
+    if (!(prevState & CRINIT_TASK_STATE_RUNNING)) {
+        t->usage.lastRuntime = 0;  // The task ended without having been started, e.g. because of a spawn error.
+        return;
+    }
+    long long us = (long long)(t->endTime.tv_sec - t->startTime.tv_sec) * 1000000LL +
+                   (t->endTime.tv_nsec - t->startTime.tv_nsec) / 1000L;
+    t->usage.lastRuntime = (us > 0) ? (unsigned long long)us : 0;
+}
+
+static void crinitTaskDBFulfillDepUnlocked(crinitTaskDB_t *ctx, const crinitTaskDep_t *dep) {
+    crinitTaskDep_t internedDep;
+    if (!crinitTaskDBFindInternedDep(&internedDep, dep)) {
+        return;  // Nobody has ever depended on this, so there is nothing to remove.
+    }
+    const crinitTaskDBWaitList_t *wl = crinitWaitListFind(ctx, &internedDep);
+    if (wl != NULL) {
+        // Iterate backwards as crinitTaskDBRemoveDepFromTaskStruct() may swap-remove the current waiter.
+        for (size_t i = wl->waitersSize; i-- > 0;) {
+            crinitTaskDBRemoveDepFromTaskStruct(ctx, wl->waiters[i], &internedDep);
+        }
+    }
+}
+
+static bool crinitTaskDBIsInlineMetaTask(const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    if (mode != CRINIT_DISPATCH_THREAD_MODE_START || t->cmdsSize != 0) {
         return false;
     }
-    if (!t->triggered) {
+    if (t->opts & (CRINIT_TASK_OPT_RESPAWN | CRINIT_TASK_OPT_TRIGGER_REARM)) {
         return false;
     }
-    if (t->state & (CRINIT_TASK_STATE_RUNNING | CRINIT_TASK_STATE_STARTING)) {
+#ifdef ENABLE_CGROUP
+    if (t->cgroup != NULL) {
         return false;
     }
-    if ((t->opts & CRINIT_TASK_OPT_RESPAWN) && t->inhibitRespawn) {
+#endif
+    return true;
+}
+
+static void crinitTaskDBCompleteMetaTask(crinitTaskDB_t *ctx, size_t pos) {
+    crinitTask_t *pTask = crinitTaskDBTaskAt(ctx, pos);
+
+    struct timespec timestamp = {0};
+    if (clock_gettime(CLOCK_MONOTONIC, &timestamp) == -1) {
+        crinitErrnoPrint("Could not measure timestamp for task '%s'. Will set to 0 (undefined) and carry on.",
+                         pTask->name);
+    }
+    pthread_rwlock_wrlock(&ctx->queryLock);
+    pTask->state = CRINIT_TASK_STATE_DONE;
+    pTask->failCount = 0;
+    memcpy(&pTask->startTime, &timestamp, sizeof(pTask->startTime));
+    memcpy(&pTask->endTime, &timestamp, sizeof(pTask->endTime));
+    pTask->usage.lastRuntime = 0;
+    pthread_rwlock_unlock(&ctx->queryLock);
+    crinitReadyQueueCheckTask(ctx, pos);
+
+    const crinitTaskDep_t doneDep = {pTask->name, CRINIT_TASK_EVENT_DONE};
+    crinitTaskDBFulfillDepUnlocked(ctx, &doneDep);
+    for (size_t i = 0; i < pTask->prvSize; i++) {
+        if (pTask->prv[i].stateReq == CRINIT_TASK_STATE_DONE) {
+            const crinitTaskDep_t prvDep = {CRINIT_PROVIDE_DEP_NAME, pTask->prv[i].name};
+            crinitTaskDBFulfillDepUnlocked(ctx, &prvDep);
+            crinitDbgInfoPrint("Fulfilled feature dependency \'%s:%s\'.", prvDep.name, prvDep.event);
+        }
+    }
+}
+
+static void crinitTaskDBFinishMetaTasks(crinitTaskDB_t *ctx, crinitTaskDBMetaDone_t *done) {
+    for (size_t i = 0; i < done->items; i++) {
+        const crinitTask_t *t = &done->cfgs[i]->task;
+        crinitInfoPrint("Task \'%s\' done (no commands).", t->name);
+#ifdef ENABLE_ELOS
+        if (crinitElosLog(ELOS_SEVERITY_INFO, ELOS_MSG_CODE_PROCESS_EXITED, ELOS_CLASSIFICATION_PROCESS, t->name) ==
+            -1) {
+            crinitErrPrint("Could not send task event to elos. Will continue but logging may be impaired.");
+        }
+#endif
+        for (size_t j = 0; j < t->prvSize; j++) {
+            if (t->prv[j].stateReq == CRINIT_TASK_STATE_DONE) {
+                if (crinitFeatureHook(t->prv[j].name, CRINIT_HOOK_START, (void *)ctx) == -1) {
+                    crinitErrPrint("Could not run activation hook for feature \'%s\'.", t->prv[j].name);
+                }
+            } else if (crinitFeatureHook(t->prv[j].name, CRINIT_HOOK_STOP, (void *)ctx) == -1) {
+                crinitErrPrint("Could not run deactivation hook for feature \'%s\'.", t->prv[j].name);
+            }
+        }
+        for (size_t j = 0; j < t->trigSize; j++) {
+            if (strcmp(t->trig[j].name, "@timer") == 0) {
+                crinitTimerDBRemoveTimer(t->trig[j].event);
+            }
+        }
+        crinitTaskCfgRelease(done->cfgs[i]);
+    }
+    free(done->cfgs);
+    done->cfgs = NULL;
+    done->items = 0;
+    done->size = 0;
+}
+
+static bool crinitTaskDBStatusMatch(const crinitTask_t *t, const crinitTaskListFilter_t *filter) {
+    if (filter == NULL) {
+        return true;
+    }
+    if (filter->stateMask != 0 && (t->state & filter->stateMask) == 0 &&
+        !(t->state == CRINIT_TASK_STATE_LOADED && (filter->stateMask & CRINIT_TASKLIST_FILTER_LOADED))) {
         return false;
     }
-    if (t->state & (CRINIT_TASK_STATE_FAILED | CRINIT_TASK_STATE_DONE)) {
-        if (!(t->opts & CRINIT_TASK_OPT_RESPAWN)) {
-            return false;
+    return filter->prefix == NULL || strncmp(t->name, filter->prefix, strlen(filter->prefix)) == 0;
+}
+
+static size_t crinitTaskDBScanStatus(crinitTaskDBStatus_t *out, char *strBuf, size_t *strSize,
+                                     const crinitTaskDB_t *ctx, const crinitTaskListFilter_t *filter) {
+    bool byName = filter != NULL && filter->numNames > 0;
+    size_t count = byName ? filter->numNames : ctx->taskSetItems;
+    size_t n = 0;
+
+    *strSize = 0;
+    for (size_t i = 0; i < count; i++) {
+        crinitTask_t *t = NULL;
+        if (!byName) {
+            t = crinitTaskDBTaskAt(ctx, i);
+        } else if (filter->names[i] == NULL || crinitFindTask(&t, NULL, filter->names[i], ctx) == -1) {
+            continue;
+        }
+        if (!crinitTaskDBStatusMatch(t, filter)) {
+            continue;
+        }
+
+        const char *strs[] = {t->name, t->username, t->groupname};
+        if (out == NULL) {
+            for (size_t j = 0; j < sizeof(strs) / sizeof(strs[0]); j++) {
+                *strSize += (strs[j] != NULL) ? strlen(strs[j]) + 1 : 0;
+            }
+            n++;
+            continue;
         }
-        if (t->maxRetries != -1 && t->failCount > t->maxRetries) {
-            return false;
+
+        crinitTaskDBStatus_t *st = &out[n++];
+        st->state = t->state;
+        st->pid = t->pid;
+        st->createTime = t->createTime;
+        st->startTime = t->startTime;
+        st->endTime = t->endTime;
+        st->usage = t->usage;
+        st->user = t->user;
+        st->group = t->group;
+        st->failCount = t->failCount;
+        char **dsts[] = {&st->name, &st->username, &st->groupname};
+        for (size_t j = 0; j < sizeof(strs) / sizeof(strs[0]); j++) {
+            *dsts[j] = NULL;
+            if (strs[j] != NULL) {
+                *dsts[j] = strBuf;
+                strBuf = stpcpy(strBuf, strs[j]) + 1;
+            }
         }
     }
-    return true;
+    return n;
+}
+
+static inline void crinitTaskDBSignalChange(crinitTaskDB_t *ctx) {
+    ctx->changeGen++;
+    pthread_cond_broadcast(&ctx->changed);
 }
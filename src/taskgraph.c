@@ -0,0 +1,488 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file taskgraph.c
+ * @brief Implementation of the analysis of the dependency graph formed by the tasks in a TaskDB.
+ */
+#include "taskgraph.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "logio.h"
+#include "strintern.h"
+
+/**
+ * Type to store a provided feature along with the task providing it.
+ */
+typedef struct crinitTaskGraphProvider {
+    const char *feature;  ///< Name of the feature, interned using crinitStrIntern().
+    size_t pos;           ///< Position of the providing task in crinitTaskDB_t::taskSet.
+} crinitTaskGraphProvider_t;
+
+/**
+ * Type to store a task along with its critical path length, used to sort tasks by critical path.
+ */
+typedef struct crinitTaskGraphRank {
+    uint64_t critPath;  ///< See crinitTaskGraphNode_t::critPath.
+    size_t pos;         ///< Position of the task in crinitTaskDB_t::taskSet.
+} crinitTaskGraphRank_t;
+
+/**
+ * Type to store the edges of the dependency graph in compressed sparse row format.
+ *
+ * An edge leads from a task to a task depending on it. The successors of the task at position `i` are
+ * `succ[first[i]]` to `succ[first[i + 1] - 1]`.
+ */
+typedef struct crinitTaskGraphEdges {
+    size_t *first;    ///< Array of numNodes + 1 offsets into succ.
+    size_t *succ;     ///< Array of successor positions, grouped by predecessor.
+    size_t *from;     ///< Predecessor positions of all edges in the order they were found.
+    size_t *to;       ///< Successor positions of all edges in the order they were found.
+    size_t numEdges;  ///< Number of edges.
+    size_t capEdges;  ///< Current maximum number of edges in from and to.
+} crinitTaskGraphEdges_t;
+
+/**
+ * Take the nodes and edges of the dependency graph from a TaskDB.
+ *
+ * Must be called with crinitTaskDB_t::lock held. Fills in crinitTaskGraphNode_t::name, crinitTaskGraphNode_t::duration
+ * and #CRINIT_DEPGRAPH_DANGLING.
+ *
+ * @param graph  The analysis results, crinitTaskGraph_t::nodes must have room for all tasks in \a ctx.
+ * @param e      Return pointer for the edges, crinitTaskGraphEdges_t::from and crinitTaskGraphEdges_t::to are filled.
+ * @param ctx    The TaskDB to take the graph from.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+static int crinitTaskGraphCollect(crinitTaskGraph_t *graph, crinitTaskGraphEdges_t *e, const crinitTaskDB_t *ctx);
+/**
+ * Add an edge to the dependency graph.
+ *
+ * @param e     The edges to add to.
+ * @param from  Position of the task depended upon.
+ * @param to    Position of the depending task.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+static int crinitTaskGraphAddEdge(crinitTaskGraphEdges_t *e, size_t from, size_t to);
+/**
+ * Mark the tasks which are part of a dependency cycle.
+ *
+ * Runs Tarjan's algorithm for strongly connected components on the tasks which could not be sorted topologically. Sets
+ * #CRINIT_DEPGRAPH_CYCLE for tasks in a component with more than one task or with an edge to themselves and
+ * #CRINIT_DEPGRAPH_BLOCKED for the rest.
+ *
+ * @param graph   The analysis results.
+ * @param e       The edges of the graph.
+ * @param sorted  Array indicating which tasks have been sorted topologically.
+ *
+ * @return  0 on success, -1 otherwise.
+ */
+static int crinitTaskGraphMarkCycles(crinitTaskGraph_t *graph, const crinitTaskGraphEdges_t *e, const bool *sorted);
+/**
+ * Comparison function for qsort() to sort crinitTaskGraphProvider_t by feature.
+ */
+static int crinitTaskGraphProviderCmp(const void *a, const void *b);
+/**
+ * Comparison function for qsort() to sort crinitTaskGraphRank_t by critical path length.
+ */
+static int crinitTaskGraphRankCmp(const void *a, const void *b);
+
+int crinitTaskGraphAnalyze(crinitTaskGraph_t *graph, crinitTaskDB_t *ctx) {
+    crinitNullCheck(-1, graph, ctx);
+
+    int ret = -1;
+    crinitTaskGraphEdges_t e = {0};
+    size_t *indeg = NULL;
+    size_t *order = NULL;
+    bool *sorted = NULL;
+    uint32_t *prio = NULL;
+    crinitTaskGraphRank_t *ranks = NULL;
+    graph->nodes = NULL;
+    graph->numNodes = 0;
+    graph->numCycleTasks = 0;
+    graph->numBlockedTasks = 0;
+    graph->numDanglingDeps = 0;
+
+    if ((errno = pthread_mutex_lock(&ctx->lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return -1;
+    }
+    size_t n = ctx->taskSetItems;
+    graph->nodes = calloc(n + 1, sizeof(*graph->nodes));
+    if (graph->nodes == NULL) {
+        crinitErrnoPrint("Could not allocate memory for dependency graph of %zu tasks.", n);
+        pthread_mutex_unlock(&ctx->lock);
+        return -1;
+    }
+    graph->numNodes = n;
+    // Keep the lock until the priorities are applied, so they cannot end up on tasks which have been replaced since.
+    if (crinitTaskGraphCollect(graph, &e, ctx) == -1) {
+        goto out;
+    }
+
+    e.first = calloc(n + 1, sizeof(*e.first));
+    e.succ = malloc((e.numEdges + 1) * sizeof(*e.succ));
+    indeg = calloc(n + 1, sizeof(*indeg));
+    order = malloc((n + 1) * sizeof(*order));
+    sorted = calloc(n + 1, sizeof(*sorted));
+    prio = calloc(n + 1, sizeof(*prio));
+    ranks = malloc((n + 1) * sizeof(*ranks));
+    if (e.first == NULL || e.succ == NULL || indeg == NULL || order == NULL || sorted == NULL || prio == NULL ||
+        ranks == NULL) {
+        crinitErrnoPrint("Could not allocate memory to analyze dependency graph of %zu tasks.", n);
+        goto out;
+    }
+
+    // Group the edges by predecessor.
+    for (size_t i = 0; i < e.numEdges; i++) {
+        e.first[e.from[i] + 1]++;
+        indeg[e.to[i]]++;
+    }
+    for (size_t i = 0; i < n; i++) {
+        e.first[i + 1] += e.first[i];
+    }
+    for (size_t i = 0; i < e.numEdges; i++) {
+        e.succ[e.first[e.from[i]]++] = e.to[i];
+    }
+    for (size_t i = n; i > 0; i--) {
+        e.first[i] = e.first[i - 1];
+    }
+    e.first[0] = 0;
+
+    // Kahn's algorithm, order doubles as the queue of tasks whose predecessors have all been sorted.
+    size_t numSorted = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (indeg[i] == 0) {
+            order[numSorted++] = i;
+        }
+    }
+    for (size_t i = 0; i < numSorted; i++) {
+        size_t v = order[i];
+        sorted[v] = true;
+        for (size_t j = e.first[v]; j < e.first[v + 1]; j++) {
+            size_t s = e.succ[j];
+            if (graph->nodes[s].level < graph->nodes[v].level + 1) {
+                graph->nodes[s].level = graph->nodes[v].level + 1;
+            }
+            if (--indeg[s] == 0) {
+                order[numSorted++] = s;
+            }
+        }
+    }
+
+    if (numSorted < n) {
+        for (size_t i = 0; i < n; i++) {
+            if (!sorted[i]) {
+                graph->nodes[i].level = 0;
+            }
+        }
+        if (crinitTaskGraphMarkCycles(graph, &e, sorted) == -1) {
+            goto out;
+        }
+    }
+
+    // Critical paths in reverse topological order, successors which could not be sorted do not count.
+    for (size_t i = numSorted; i > 0; i--) {
+        crinitTaskGraphNode_t *v = &graph->nodes[order[i - 1]];
+        uint64_t longest = 0;
+        for (size_t j = e.first[order[i - 1]]; j < e.first[order[i - 1] + 1]; j++) {
+            if (graph->nodes[e.succ[j]].critPath > longest) {
+                longest = graph->nodes[e.succ[j]].critPath;
+            }
+        }
+        v->critPath = longest + ((v->duration > 0) ? v->duration : CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+        ranks[i - 1].critPath = v->critPath;
+        ranks[i - 1].pos = order[i - 1];
+    }
+
+    // Tasks with the same critical path length share a priority. Tasks in or blocked by a cycle keep 0.
+    qsort(ranks, numSorted, sizeof(*ranks), crinitTaskGraphRankCmp);
+    uint32_t p = 0;
+    for (size_t i = 0; i < numSorted; i++) {
+        if (i == 0 || ranks[i].critPath != ranks[i - 1].critPath) {
+            p++;
+        }
+        prio[ranks[i].pos] = p;
+        graph->nodes[ranks[i].pos].prio = p;
+    }
+
+    if (crinitTaskDBSetSpawnPrio(ctx, prio, n) == -1) {
+        crinitErrPrint("Could not set spawn priorities of tasks in TaskDB.");
+        goto out;
+    }
+    ret = 0;
+
+out:
+    pthread_mutex_unlock(&ctx->lock);
+    free(e.first);
+    free(e.succ);
+    free(e.from);
+    free(e.to);
+    free(indeg);
+    free(order);
+    free(sorted);
+    free(prio);
+    free(ranks);
+    if (ret == -1) {
+        crinitTaskGraphDestroy(graph);
+    }
+    return ret;
+}
+
+void crinitTaskGraphDestroy(crinitTaskGraph_t *graph) {
+    if (graph == NULL) {
+        return;
+    }
+    if (graph->nodes != NULL) {
+        for (size_t i = 0; i < graph->numNodes; i++) {
+            free(graph->nodes[i].name);
+        }
+    }
+    free(graph->nodes);
+    graph->nodes = NULL;
+    graph->numNodes = 0;
+}
+
+int crinitTaskGraphUpdate(crinitTaskDB_t *ctx) {
+    crinitNullCheck(-1, ctx);
+
+    crinitTaskGraph_t graph;
+    if (crinitTaskGraphAnalyze(&graph, ctx) == -1) {
+        crinitErrPrint("Could not analyze dependency graph of TaskDB.");
+        return -1;
+    }
+
+    for (size_t i = 0; i < graph.numNodes; i++) {
+        const crinitTaskGraphNode_t *v = &graph.nodes[i];
+        if (v->flags & CRINIT_DEPGRAPH_CYCLE) {
+            crinitErrPrint("Task \'%s\' is part of a dependency cycle and will not be started.", v->name);
+        } else if (v->flags & CRINIT_DEPGRAPH_BLOCKED) {
+            crinitErrPrint("Task \'%s\' depends on a dependency cycle and will not be started.", v->name);
+        }
+        if (v->flags & CRINIT_DEPGRAPH_DANGLING) {
+            crinitInfoPrint("Task \'%s\' has dependencies no loaded task can fulfill.", v->name);
+        }
+    }
+    crinitDbgInfoPrint(
+        "Analyzed dependency graph of %zu tasks: %zu in cycles, %zu blocked by cycles, %zu dangling dependencies.",
+        graph.numNodes, graph.numCycleTasks, graph.numBlockedTasks, graph.numDanglingDeps);
+
+    crinitTaskGraphDestroy(&graph);
+    return 0;
+}
+
+static int crinitTaskGraphCollect(crinitTaskGraph_t *graph, crinitTaskGraphEdges_t *e, const crinitTaskDB_t *ctx) {
+    size_t n = graph->numNodes;
+    crinitTaskGraphProvider_t *prv = NULL;
+    size_t numPrv = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        numPrv += crinitTaskDBTaskAt(ctx, i)->prvSize;
+    }
+    if (numPrv > 0) {
+        prv = malloc(numPrv * sizeof(*prv));
+        if (prv == NULL) {
+            crinitErrnoPrint("Could not allocate memory for %zu provided features.", numPrv);
+            return -1;
+        }
+        numPrv = 0;
+        for (size_t i = 0; i < n; i++) {
+            const crinitTask_t *t = crinitTaskDBTaskAt(ctx, i);
+            for (size_t j = 0; j < t->prvSize; j++) {
+                prv[numPrv].feature = t->prv[j].name;
+                prv[numPrv].pos = i;
+                numPrv++;
+            }
+        }
+        qsort(prv, numPrv, sizeof(*prv), crinitTaskGraphProviderCmp);
+    }
+
+    // Dependency names are interned, so the special ones can be recognized by address.
+    const char *provided = crinitStrInternFind(CRINIT_PROVIDE_DEP_NAME);
+    for (size_t i = 0; i < n; i++) {
+        const crinitTask_t *t = crinitTaskDBTaskAt(ctx, i);
+        crinitTaskGraphNode_t *v = &graph->nodes[i];
+
+        v->name = strdup(t->name);
+        if (v->name == NULL) {
+            crinitErrnoPrint("Could not allocate memory for name of task \'%s\'.", t->name);
+            goto fail;
+        }
+        if ((t->state & CRINIT_TASK_STATE_DONE) && t->startTime.tv_sec > 0) {
+            int64_t us = (int64_t)(t->endTime.tv_sec - t->startTime.tv_sec) * 1000000 +
+                         (t->endTime.tv_nsec - t->startTime.tv_nsec) / 1000;
+            v->duration = (us > 0) ? (uint64_t)us : 0;
+        }
+
+        for (size_t j = 0; j < t->depsSize; j++) {
+            const crinitTaskDep_t *dep = &t->deps[j];
+            size_t found = 0;
+            if (dep->name == provided) {
+                crinitTaskGraphProvider_t key = {dep->event, 0};
+                crinitTaskGraphProvider_t *p = NULL;
+                if (numPrv > 0) {
+                    p = bsearch(&key, prv, numPrv, sizeof(*prv), crinitTaskGraphProviderCmp);
+                }
+                if (p != NULL) {
+                    while (p > prv && (p - 1)->feature == dep->event) {
+                        p--;
+                    }
+                    for (; p < prv + numPrv && p->feature == dep->event; p++, found++) {
+                        if (crinitTaskGraphAddEdge(e, p->pos, i) == -1) {
+                            goto fail;
+                        }
+                    }
+                }
+            } else if (dep->name[0] == '@') {
+                // Fulfilled from outside of the TaskDB.
+                continue;
+            } else {
+                crinitTaskHandle_t h;
+                if (crinitTaskDBFindTaskHandle(ctx, &h, dep->name) == 0) {
+                    if (crinitTaskGraphAddEdge(e, h, i) == -1) {
+                        goto fail;
+                    }
+                    found++;
+                }
+            }
+            if (found == 0) {
+                v->flags |= CRINIT_DEPGRAPH_DANGLING;
+                graph->numDanglingDeps++;
+            }
+        }
+    }
+
+    free(prv);
+    return 0;
+
+fail:
+    free(prv);
+    return -1;
+}
+
+static int crinitTaskGraphAddEdge(crinitTaskGraphEdges_t *e, size_t from, size_t to) {
+    if (e->numEdges == e->capEdges) {
+        size_t newCap = (e->capEdges == 0) ? 64 : e->capEdges * 2;
+        size_t *newFrom = realloc(e->from, newCap * sizeof(*newFrom));
+        if (newFrom == NULL) {
+            crinitErrnoPrint("Could not allocate memory for %zu dependency graph edges.", newCap);
+            return -1;
+        }
+        e->from = newFrom;
+        size_t *newTo = realloc(e->to, newCap * sizeof(*newTo));
+        if (newTo == NULL) {
+            crinitErrnoPrint("Could not allocate memory for %zu dependency graph edges.", newCap);
+            return -1;
+        }
+        e->to = newTo;
+        e->capEdges = newCap;
+    }
+    e->from[e->numEdges] = from;
+    e->to[e->numEdges] = to;
+    e->numEdges++;
+    return 0;
+}
+
+static int crinitTaskGraphMarkCycles(crinitTaskGraph_t *graph, const crinitTaskGraphEdges_t *e, const bool *sorted) {
+    size_t n = graph->numNodes;
+    // Tarjan's algorithm without recursion. idx holds the DFS index + 1 (0 means unvisited), iter the next edge to
+    // follow for each task on the call stack.
+    size_t *idx = calloc(n, sizeof(*idx));
+    size_t *low = malloc(n * sizeof(*low));
+    size_t *iter = malloc(n * sizeof(*iter));
+    size_t *stack = malloc(n * sizeof(*stack));
+    size_t *calls = malloc(n * sizeof(*calls));
+    bool *onStack = calloc(n, sizeof(*onStack));
+    if (idx == NULL || low == NULL || iter == NULL || stack == NULL || calls == NULL || onStack == NULL) {
+        crinitErrnoPrint("Could not allocate memory to search for dependency cycles among %zu tasks.", n);
+        free(idx);
+        free(low);
+        free(iter);
+        free(stack);
+        free(calls);
+        free(onStack);
+        return -1;
+    }
+
+    size_t nextIdx = 1, stackSize = 0;
+    for (size_t root = 0; root < n; root++) {
+        if (sorted[root] || idx[root] != 0) {
+            continue;
+        }
+        size_t numCalls = 0;
+        calls[numCalls++] = root;
+        idx[root] = low[root] = nextIdx++;
+        iter[root] = e->first[root];
+        stack[stackSize++] = root;
+        onStack[root] = true;
+
+        while (numCalls > 0) {
+            size_t v = calls[numCalls - 1];
+            if (iter[v] < e->first[v + 1]) {
+                size_t s = e->succ[iter[v]++];
+                if (sorted[s]) {
+                    continue;
+                }
+                if (idx[s] == 0) {
+                    idx[s] = low[s] = nextIdx++;
+                    iter[s] = e->first[s];
+                    stack[stackSize++] = s;
+                    onStack[s] = true;
+                    calls[numCalls++] = s;
+                } else if (onStack[s] && idx[s] < low[v]) {
+                    low[v] = idx[s];
+                }
+                continue;
+            }
+
+            numCalls--;
+            if (numCalls > 0 && low[v] < low[calls[numCalls - 1]]) {
+                low[calls[numCalls - 1]] = low[v];
+            }
+            if (low[v] != idx[v]) {
+                continue;
+            }
+            // v is the root of a strongly connected component, which is a cycle if it has more than one task or the
+            // task depends on itself.
+            bool cycle = stack[stackSize - 1] != v;
+            for (size_t j = e->first[v]; !cycle && j < e->first[v + 1]; j++) {
+                cycle = e->succ[j] == v;
+            }
+            size_t w;
+            do {
+                w = stack[--stackSize];
+                onStack[w] = false;
+                graph->nodes[w].flags |= cycle ? CRINIT_DEPGRAPH_CYCLE : CRINIT_DEPGRAPH_BLOCKED;
+                if (cycle) {
+                    graph->numCycleTasks++;
+                } else {
+                    graph->numBlockedTasks++;
+                }
+            } while (w != v);
+        }
+    }
+
+    free(idx);
+    free(low);
+    free(iter);
+    free(stack);
+    free(calls);
+    free(onStack);
+    return 0;
+}
+
+static int crinitTaskGraphProviderCmp(const void *a, const void *b) {
+    uintptr_t fa = (uintptr_t)((const crinitTaskGraphProvider_t *)a)->feature;
+    uintptr_t fb = (uintptr_t)((const crinitTaskGraphProvider_t *)b)->feature;
+    return (fa > fb) - (fa < fb);
+}
+
+static int crinitTaskGraphRankCmp(const void *a, const void *b) {
+    uint64_t ca = ((const crinitTaskGraphRank_t *)a)->critPath;
+    uint64_t cb = ((const crinitTaskGraphRank_t *)b)->critPath;
+    return (ca > cb) - (ca < cb);
+}
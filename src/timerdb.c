@@ -41,6 +41,13 @@ static void crinitPrintTimerPool(crinitTimerDB_t *pool);
  * @return 0 on success, -1 on error
  */
 static int crinitTimerDBInsertTimer(crinitTimer_t timer);
+/**
+ * Remove a one-shot timer from the timerDB and close its timerfd.
+ * Doesn't lock the timerDB! Leaves freeing crinitTimer_t::name to the caller.
+ *
+ * @param idx  the position of the timer in the timerDB
+ */
+static void crinitTimerDBDropTimer(size_t idx);
 
 int crinitTimerDBInit(crinitTaskDB_t *taskDB) {
     crinitNullCheck(-1, taskDB);
@@ -107,7 +114,14 @@ static void *crinitTimerDBRunPool(void *args) {
         } else if (crinitTimerPool.pollList[0].revents != 0) {
             crinitErrnoPrint("Couldn't poll update events.");
         }
+        char *respawnTask = NULL;
         for (size_t i = 0; i < crinitTimerPool.size; i++) {
+            if (crinitTimerPool.pollList[i].revents == POLLIN && crinitTimerPool.timerList[i].respawn) {
+                // One-shot timer, the TaskDB is notified after the TimerDB has been unlocked.
+                respawnTask = crinitTimerPool.timerList[i].name;
+                crinitTimerDBDropTimer(i);
+                break;
+            }
             if (crinitTimerPool.pollList[i].revents == POLLIN) {
                 if (read(crinitTimerPool.pollList[i].fd, &u, sizeof(uint64_t)) != sizeof(uint64_t)) {
                     crinitErrnoPrint("Couldn't read timer.");
@@ -130,6 +144,10 @@ static void *crinitTimerDBRunPool(void *args) {
             }
         }
         pthread_mutex_unlock(&crinitTimerPool.lock);
+        if (respawnTask != NULL) {
+            crinitTaskDBEndRespawnDelay(crinitTimerPool.taskDB, respawnTask);
+            free(respawnTask);
+        }
     }
     return NULL;
 }
@@ -206,14 +224,14 @@ end:
     return res;
 }
 
-void crinitTimerDBRemoveTimer(char *timerStr) {
+void crinitTimerDBRemoveTimer(const char *timerStr) {
     if ((errno = pthread_mutex_lock(&crinitTimerPool.lock)) != 0) {
         crinitErrnoPrint("Could not queue up for mutex lock.");
         return;
     }
     uint64_t u = 1;
     for (size_t i = 1; i < crinitTimerPool.size; i++) {
-        if (0 == strcmp(crinitTimerPool.timerList[i].name, timerStr)) {
+        if (!crinitTimerPool.timerList[i].respawn && 0 == strcmp(crinitTimerPool.timerList[i].name, timerStr)) {
             if (write(crinitTimerPool.pollList[0].fd, &u, sizeof(uint64_t)) != sizeof(uint64_t)) {
                 crinitErrPrint("failed to notify timerpool");
             }
@@ -233,13 +251,13 @@ void crinitTimerDBRemoveTimer(char *timerStr) {
     pthread_mutex_unlock(&crinitTimerPool.lock);
 }
 
-void crinitTimerDBAddTimer(char *timerStr) {
+void crinitTimerDBAddTimer(const char *timerStr) {
     if ((errno = pthread_mutex_lock(&crinitTimerPool.lock)) != 0) {
         crinitErrnoPrint("Could not queue up for mutex lock.");
         return;
     }
     for (size_t i = 1; i < crinitTimerPool.size; i++) {
-        if (0 == strcmp(crinitTimerPool.timerList[i].name, timerStr)) {
+        if (!crinitTimerPool.timerList[i].respawn && 0 == strcmp(crinitTimerPool.timerList[i].name, timerStr)) {
             uint64_t u = 1;
             if (write(crinitTimerPool.pollList[0].fd, &u, sizeof(uint64_t)) != sizeof(uint64_t)) {
                 crinitErrPrint("failed to notify timerpool");
@@ -274,3 +292,76 @@ void crinitTimerDBAddTimer(char *timerStr) {
         crinitDbgInfoPrint("Successfully inserted Timer @timer:%s into TimerDB", timerStr);
     }
 }
+
+static void crinitTimerDBDropTimer(size_t idx) {
+    close(crinitTimerPool.pollList[idx].fd);
+    if (idx < crinitTimerPool.size - 1) {
+        crinitTimerPool.timerList[idx] = crinitTimerPool.timerList[crinitTimerPool.size - 1];
+        crinitTimerPool.pollList[idx] = crinitTimerPool.pollList[crinitTimerPool.size - 1];
+    }
+    crinitTimerPool.size -= 1;
+}
+
+int crinitTimerDBAddRespawnTimer(const char *taskName, unsigned int delayMs) {
+    crinitNullCheck(-1, taskName);
+    struct itimerspec next = {0};
+    next.it_value.tv_sec = delayMs / 1000;
+    next.it_value.tv_nsec = (long)(delayMs % 1000) * 1000000L;
+
+    if ((errno = pthread_mutex_lock(&crinitTimerPool.lock)) != 0) {
+        crinitErrnoPrint("Could not queue up for mutex lock.");
+        return -1;
+    }
+    int res = 0;
+    for (size_t i = 1; i < crinitTimerPool.size; i++) {
+        if (crinitTimerPool.timerList[i].respawn && 0 == strcmp(crinitTimerPool.timerList[i].name, taskName)) {
+            if (timerfd_settime(crinitTimerPool.pollList[i].fd, 0, &next, NULL) == -1) {
+                crinitErrnoPrint("Couldn't re-arm respawn timer of task '%s'.", taskName);
+                res = -1;
+            }
+            pthread_mutex_unlock(&crinitTimerPool.lock);
+            return res;
+        }
+    }
+    if (crinitTimerPool.size >= crinitTimerPool.cap) {
+        crinitErrPrint("TimerDB has no space left for additionall timer!!");
+        pthread_mutex_unlock(&crinitTimerPool.lock);
+        return -1;
+    }
+
+    crinitTimer_t timer = {0};
+    timer.name = strdup(taskName);
+    if (timer.name == NULL) {
+        crinitErrnoPrint("Could not allocate memory for respawn timer of task '%s'.", taskName);
+        pthread_mutex_unlock(&crinitTimerPool.lock);
+        return -1;
+    }
+    timer.refs = 1;
+    timer.next = next;
+    timer.respawn = true;
+
+    // Respawn delays are relative and must not be affected by changes of the system time.
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (fd == -1 || timerfd_settime(fd, 0, &timer.next, NULL) == -1) {
+        crinitErrnoPrint("Couldn't arm respawn timer of task '%s'.", taskName);
+        if (fd != -1) {
+            close(fd);
+        }
+        free(timer.name);
+        pthread_mutex_unlock(&crinitTimerPool.lock);
+        return -1;
+    }
+
+    crinitTimerPool.timerList[crinitTimerPool.size] = timer;
+    crinitTimerPool.pollList[crinitTimerPool.size].fd = fd;
+    crinitTimerPool.pollList[crinitTimerPool.size].events = POLLIN;
+    crinitTimerPool.size += 1;
+
+    uint64_t u = 1;
+    if (write(crinitTimerPool.pollList[0].fd, &u, sizeof(uint64_t)) != sizeof(uint64_t)) {
+        crinitErrPrint("failed to notify timerpool");
+    }
+    pthread_mutex_unlock(&crinitTimerPool.lock);
+    crinitDbgInfoPrint("Armed respawn timer of task '%s' for %u ms.", taskName, delayMs);
+    return 0;
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid-input.c
+ * @brief Unit test for crinitCfgCpuAffinityHandler(), handling of invalid input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-cpu-affinity-handler.h"
+
+void crinitCfgCpuAffinityHandlerTestInvalidInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "a", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "3-1", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "1,", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "1-", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "-1", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "1024", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "0", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(tgt.sched.flags, 0);
+    assert_int_equal(tgt.sched.affinity[0], 0);
+}
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCfgCpuAffinityHandler(), successful execution.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-cpu-affinity-handler.h"
+
+void crinitCfgCpuAffinityHandlerTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "0-2,5,64", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.flags, crinitSchedParamFlag(CRINIT_SCHED_PARAM_AFFINITY));
+    assert_int_equal(tgt.sched.affinity[0], 0x27);
+    assert_int_equal((tgt.sched.affinity[64 / CRINIT_SCHED_CPUS_PER_WORD] >> (64 % CRINIT_SCHED_CPUS_PER_WORD)) & 1, 1);
+
+    char opt[32];
+    assert_int_equal(crinitSchedParamsLauncherOpt(opt, sizeof(opt), &tgt.sched, CRINIT_SCHED_PARAM_AFFINITY),
+                     strlen("--cpu-affinity=0-2,5,64"));
+    assert_string_equal(opt, "--cpu-affinity=0-2,5,64");
+    // Only measures the length without a buffer.
+    assert_int_equal(crinitSchedParamsLauncherOpt(NULL, 0, &tgt.sched, CRINIT_SCHED_PARAM_AFFINITY),
+                     strlen("--cpu-affinity=0-2,5,64"));
+
+    // A later definition replaces the earlier one.
+    assert_int_equal(crinitCfgCpuAffinityHandler(&tgt, "3", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.affinity[0], 0x8);
+    assert_int_equal((tgt.sched.affinity[64 / CRINIT_SCHED_CPUS_PER_WORD] >> (64 % CRINIT_SCHED_CPUS_PER_WORD)) & 1, 0);
+}
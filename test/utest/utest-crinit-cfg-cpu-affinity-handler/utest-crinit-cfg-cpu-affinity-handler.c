@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-cpu-affinity-handler.c
+ * @brief Implementation of the crinitCfgCpuAffinityHandler() unit test group.
+ */
+
+#include "utest-crinit-cfg-cpu-affinity-handler.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCfgCpuAffinityHandler() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCfgCpuAffinityHandlerTestSuccess),
+        cmocka_unit_test(crinitCfgCpuAffinityHandlerTestInvalidInput),
+        cmocka_unit_test(crinitCfgCpuAffinityHandlerTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-cpu-affinity-handler.h
+ * @brief Header declaring the unit tests for crinitCfgCpuAffinityHandler().
+ */
+#ifndef __UTEST_CFG_CPU_AFFINITY_HANDLER_H__
+#define __UTEST_CFG_CPU_AFFINITY_HANDLER_H__
+
+/**
+ * Tests successful parsing of CPU lists.
+ */
+void crinitCfgCpuAffinityHandlerTestSuccess(void **state);
+/**
+ * Tests unsuccessful parsing of malformed CPU lists.
+ */
+void crinitCfgCpuAffinityHandlerTestInvalidInput(void **state);
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCfgCpuAffinityHandlerTestNullInput(void **state);
+
+#endif /* __UTEST_CFG_CPU_AFFINITY_HANDLER_H__ */
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid-input.c
+ * @brief Unit test for crinitCfgDispWorkersHandler(), handling of invalid input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "globopt.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-dispatch-workers-handler.h"
+
+void crinitCfgDispWorkersHandlerTestInvalidInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    unsigned long long workers = 0;
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitCfgDispWorkersHandler(NULL, "", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(crinitCfgDispWorkersHandler(NULL, "this_is_not_a_number", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(crinitCfgDispWorkersHandler(NULL, "0", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(crinitCfgDispWorkersHandler(NULL, "8", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitGlobOptGet(CRINIT_GLOBOPT_DISPATCH_WORKERS, &workers), 0);
+    assert_int_equal(workers, CRINIT_CONFIG_DEFAULT_DISPATCH_WORKERS);
+    crinitGlobOptDestroy();
+}
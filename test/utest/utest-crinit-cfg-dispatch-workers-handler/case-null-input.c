@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-null-input.c
+ * @brief Unit test for crinitCfgDispWorkersHandler(), handling of null pointer input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "globopt.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-dispatch-workers-handler.h"
+
+void crinitCfgDispWorkersHandlerTestNullInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitCfgDispWorkersHandler(NULL, NULL, CRINIT_CONFIG_TYPE_SERIES), -1);
+    crinitGlobOptDestroy();
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCfgDispWorkersHandler(), successful execution.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "globopt.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-dispatch-workers-handler.h"
+
+void crinitCfgDispWorkersHandlerTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    unsigned long long workers = 0;
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitCfgDispWorkersHandler(NULL, "32", CRINIT_CONFIG_TYPE_SERIES), 0);
+    assert_int_equal(crinitGlobOptGet(CRINIT_GLOBOPT_DISPATCH_WORKERS, &workers), 0);
+    assert_int_equal(workers, 32);
+    crinitGlobOptDestroy();
+}
+
+void crinitCfgDispWorkersDefaultValue(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    unsigned long long workers = 0;
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitGlobOptGet(CRINIT_GLOBOPT_DISPATCH_WORKERS, &workers), 0);
+    assert_int_equal(workers, CRINIT_CONFIG_DEFAULT_DISPATCH_WORKERS);
+    crinitGlobOptDestroy();
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-dispatch-workers-handler.c
+ * @brief Implementation of the crinitCfgDispWorkersHandler() unit test group.
+ */
+
+#include "utest-crinit-cfg-dispatch-workers-handler.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCfgDispWorkersHandler() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCfgDispWorkersHandlerTestSuccess),
+        cmocka_unit_test(crinitCfgDispWorkersDefaultValue),
+        cmocka_unit_test(crinitCfgDispWorkersHandlerTestInvalidInput),
+        cmocka_unit_test(crinitCfgDispWorkersHandlerTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-dispatch-workers-handler.h
+ * @brief Header declaring the unit tests for crinitCfgDispWorkersHandler().
+ */
+#ifndef __UTEST_CFG_DISPATCH_WORKERS_HANDLER_H__
+#define __UTEST_CFG_DISPATCH_WORKERS_HANDLER_H__
+
+/**
+ * Tests successful parsing of a positive number of worker threads.
+ */
+void crinitCfgDispWorkersHandlerTestSuccess(void **state);
+/**
+ * Tests default value.
+ */
+void crinitCfgDispWorkersDefaultValue(void **state);
+/**
+ * Tests unsuccessful parsing of invalid input values, including zero.
+ */
+void crinitCfgDispWorkersHandlerTestInvalidInput(void **state);
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCfgDispWorkersHandlerTestNullInput(void **state);
+#endif /* __UTEST_CFG_DISPATCH_WORKERS_HANDLER_H__ */
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid-input.c
+ * @brief Unit test for crinitCfgIoPriorityHandler(), handling of invalid input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-io-priority-handler.h"
+
+void crinitCfgIoPriorityHandlerTestInvalidInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "none", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "idle:1", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "realtime:", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "realtime:-1", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "realtime:8", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "best-effort:4a", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "idle", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(tgt.sched.flags, 0);
+    assert_int_equal(tgt.sched.ioprio, 0);
+}
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCfgIoPriorityHandler(), successful execution.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-io-priority-handler.h"
+
+void crinitCfgIoPriorityHandlerTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "realtime:0", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.flags, crinitSchedParamFlag(CRINIT_SCHED_PARAM_IOPRIO));
+    assert_int_equal(tgt.sched.ioprio, (1 << 13) | 0);
+
+    // The level defaults to 4, names are case-insensitive.
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "Best-Effort", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.ioprio, (2 << 13) | 4);
+
+    char opt[32];
+    assert_int_equal(crinitSchedParamsLauncherOpt(opt, sizeof(opt), &tgt.sched, CRINIT_SCHED_PARAM_IOPRIO),
+                     strlen("--io-priority=best-effort:4"));
+    assert_string_equal(opt, "--io-priority=best-effort:4");
+
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "best-effort:7", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.ioprio, (2 << 13) | 7);
+    // The idle class has no levels.
+    assert_int_equal(crinitCfgIoPriorityHandler(&tgt, "idle", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.ioprio >> 13, 3);
+    assert_int_equal(crinitSchedParamsLauncherOpt(opt, sizeof(opt), &tgt.sched, CRINIT_SCHED_PARAM_IOPRIO),
+                     strlen("--io-priority=idle"));
+    assert_string_equal(opt, "--io-priority=idle");
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-io-priority-handler.c
+ * @brief Implementation of the crinitCfgIoPriorityHandler() unit test group.
+ */
+
+#include "utest-crinit-cfg-io-priority-handler.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCfgIoPriorityHandler() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCfgIoPriorityHandlerTestSuccess),
+        cmocka_unit_test(crinitCfgIoPriorityHandlerTestInvalidInput),
+        cmocka_unit_test(crinitCfgIoPriorityHandlerTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
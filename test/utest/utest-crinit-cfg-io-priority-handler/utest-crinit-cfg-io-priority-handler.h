@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-io-priority-handler.h
+ * @brief Header declaring the unit tests for crinitCfgIoPriorityHandler().
+ */
+#ifndef __UTEST_CFG_IO_PRIORITY_HANDLER_H__
+#define __UTEST_CFG_IO_PRIORITY_HANDLER_H__
+
+/**
+ * Tests successful parsing of I/O priorities with and without level.
+ */
+void crinitCfgIoPriorityHandlerTestSuccess(void **state);
+/**
+ * Tests unsuccessful parsing of unknown classes and out-of-range levels.
+ */
+void crinitCfgIoPriorityHandlerTestInvalidInput(void **state);
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCfgIoPriorityHandlerTestNullInput(void **state);
+
+#endif /* __UTEST_CFG_IO_PRIORITY_HANDLER_H__ */
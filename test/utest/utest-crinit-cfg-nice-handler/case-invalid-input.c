@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid-input.c
+ * @brief Unit test for crinitCfgNiceHandler(), handling of invalid input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-nice-handler.h"
+
+void crinitCfgNiceHandlerTestInvalidInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "a", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "1a", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "-21", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "20", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "99999999999999999999", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "0", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(tgt.sched.flags, 0);
+    assert_int_equal(tgt.sched.nice, 0);
+}
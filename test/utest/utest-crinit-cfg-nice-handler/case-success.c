@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCfgNiceHandler(), successful execution.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-nice-handler.h"
+
+void crinitCfgNiceHandlerTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "-20", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.flags, crinitSchedParamFlag(CRINIT_SCHED_PARAM_NICE));
+    assert_int_equal(tgt.sched.nice, -20);
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "0", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.nice, 0);
+
+    // A later definition replaces the earlier one.
+    assert_int_equal(crinitCfgNiceHandler(&tgt, "19", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.nice, 19);
+
+    char opt[16];
+    assert_int_equal(crinitSchedParamsLauncherOpt(opt, sizeof(opt), &tgt.sched, CRINIT_SCHED_PARAM_NICE),
+                     strlen("--nice=19"));
+    assert_string_equal(opt, "--nice=19");
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-nice-handler.c
+ * @brief Implementation of the crinitCfgNiceHandler() unit test group.
+ */
+
+#include "utest-crinit-cfg-nice-handler.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCfgNiceHandler() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCfgNiceHandlerTestSuccess),
+        cmocka_unit_test(crinitCfgNiceHandlerTestInvalidInput),
+        cmocka_unit_test(crinitCfgNiceHandlerTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-nice-handler.h
+ * @brief Header declaring the unit tests for crinitCfgNiceHandler().
+ */
+#ifndef __UTEST_CFG_NICE_HANDLER_H__
+#define __UTEST_CFG_NICE_HANDLER_H__
+
+/**
+ * Tests successful parsing of nice values.
+ */
+void crinitCfgNiceHandlerTestSuccess(void **state);
+/**
+ * Tests unsuccessful parsing of malformed and out-of-range nice values.
+ */
+void crinitCfgNiceHandlerTestInvalidInput(void **state);
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCfgNiceHandlerTestNullInput(void **state);
+
+#endif /* __UTEST_CFG_NICE_HANDLER_H__ */
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid-input.c
+ * @brief Unit test for crinitCfgOomScoreAdjHandler(), handling of invalid input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-oom-score-adj-handler.h"
+
+void crinitCfgOomScoreAdjHandlerTestInvalidInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "a", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "10 ", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "-1001", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "1001", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "0", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(tgt.sched.flags, 0);
+    assert_int_equal(tgt.sched.oomScoreAdj, 0);
+}
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCfgOomScoreAdjHandler(), successful execution.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-oom-score-adj-handler.h"
+
+void crinitCfgOomScoreAdjHandlerTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "1000", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.flags, crinitSchedParamFlag(CRINIT_SCHED_PARAM_OOM_SCORE_ADJ));
+    assert_int_equal(tgt.sched.oomScoreAdj, 1000);
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "0", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.oomScoreAdj, 0);
+
+    // A later definition replaces the earlier one.
+    assert_int_equal(crinitCfgOomScoreAdjHandler(&tgt, "-1000", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.oomScoreAdj, -1000);
+
+    char opt[32];
+    assert_int_equal(crinitSchedParamsLauncherOpt(opt, sizeof(opt), &tgt.sched, CRINIT_SCHED_PARAM_OOM_SCORE_ADJ),
+                     strlen("--oom-score-adj=-1000"));
+    assert_string_equal(opt, "--oom-score-adj=-1000");
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-oom-score-adj-handler.c
+ * @brief Implementation of the crinitCfgOomScoreAdjHandler() unit test group.
+ */
+
+#include "utest-crinit-cfg-oom-score-adj-handler.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCfgOomScoreAdjHandler() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCfgOomScoreAdjHandlerTestSuccess),
+        cmocka_unit_test(crinitCfgOomScoreAdjHandlerTestInvalidInput),
+        cmocka_unit_test(crinitCfgOomScoreAdjHandlerTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-oom-score-adj-handler.h
+ * @brief Header declaring the unit tests for crinitCfgOomScoreAdjHandler().
+ */
+#ifndef __UTEST_CFG_OOM_SCORE_ADJ_HANDLER_H__
+#define __UTEST_CFG_OOM_SCORE_ADJ_HANDLER_H__
+
+/**
+ * Tests successful parsing of OOM score adjustments.
+ */
+void crinitCfgOomScoreAdjHandlerTestSuccess(void **state);
+/**
+ * Tests unsuccessful parsing of malformed and out-of-range OOM score adjustments.
+ */
+void crinitCfgOomScoreAdjHandlerTestInvalidInput(void **state);
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCfgOomScoreAdjHandlerTestNullInput(void **state);
+
+#endif /* __UTEST_CFG_OOM_SCORE_ADJ_HANDLER_H__ */
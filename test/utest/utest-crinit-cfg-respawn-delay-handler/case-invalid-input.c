@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid-input.c
+ * @brief Unit test for crinitCfgRespDelayHandler(), handling of invalid input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-respawn-delay-handler.h"
+
+void crinitCfgRespDelayHandlerTestInvalidInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgRespDelayHandler(&tgt, "this_is_not_a_number", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgRespDelayHandler(&tgt, "", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgRespDelayHandler(&tgt, "100", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(tgt.respawnDelay, 0);
+}
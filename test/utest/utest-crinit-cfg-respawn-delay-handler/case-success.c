@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCfgRespDelayHandler(), successful execution.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-respawn-delay-handler.h"
+
+void crinitCfgRespDelayHandlerTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgRespDelayHandler(&tgt, "250", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.respawnDelay, 250);
+    assert_int_equal(crinitCfgRespDelayHandler(&tgt, "0", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.respawnDelay, 0);
+}
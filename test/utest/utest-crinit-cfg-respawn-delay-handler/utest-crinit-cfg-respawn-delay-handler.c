@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-respawn-delay-handler.c
+ * @brief Implementation of the crinitCfgRespDelayHandler() unit test group.
+ */
+
+#include "utest-crinit-cfg-respawn-delay-handler.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCfgRespDelayHandler() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCfgRespDelayHandlerTestSuccess),
+        cmocka_unit_test(crinitCfgRespDelayHandlerTestInvalidInput),
+        cmocka_unit_test(crinitCfgRespDelayHandlerTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-respawn-delay-handler.h
+ * @brief Header declaring the unit tests for crinitCfgRespDelayHandler().
+ */
+#ifndef __UTEST_CFG_RESPAWN_DELAY_HANDLER_H__
+#define __UTEST_CFG_RESPAWN_DELAY_HANDLER_H__
+
+/**
+ * Tests successful parsing of a delay value.
+ */
+void crinitCfgRespDelayHandlerTestSuccess(void **state);
+/**
+ * Tests unsuccessful parsing of an invalid input value.
+ */
+void crinitCfgRespDelayHandlerTestInvalidInput(void **state);
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCfgRespDelayHandlerTestNullInput(void **state);
+
+#endif /* __UTEST_CFG_RESPAWN_DELAY_HANDLER_H__ */
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid-input.c
+ * @brief Unit test for crinitCfgSchedPolicyHandler(), handling of invalid input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-sched-policy-handler.h"
+
+void crinitCfgSchedPolicyHandlerTestInvalidInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "deadline", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "other:1", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "fifo", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "fifo:", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "fifo:a", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "fifo:-1", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "rr:100", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "other", CRINIT_CONFIG_TYPE_SERIES), -1);
+    assert_int_equal(tgt.sched.flags, 0);
+    assert_int_equal(tgt.sched.policy, 0);
+    assert_int_equal(tgt.sched.priority, 0);
+}
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-null-input.c
+ * @brief Unit test for crinitCfgSchedPolicyHandler(), handling of null pointer input.
+ */
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-sched-policy-handler.h"
+
+void crinitCfgSchedPolicyHandlerTestNullInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgSchedPolicyHandler(NULL, "other", CRINIT_CONFIG_TYPE_TASK), -1);
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, NULL, CRINIT_CONFIG_TYPE_TASK), -1);
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCfgSchedPolicyHandler(), successful execution.
+ */
+
+#define _GNU_SOURCE  ///< Needed for SCHED_BATCH.
+#include <sched.h>
+#include <string.h>
+
+#include "common.h"
+#include "confhdl.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-cfg-sched-policy-handler.h"
+
+void crinitCfgSchedPolicyHandlerTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt = {0};
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "batch", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.flags, crinitSchedParamFlag(CRINIT_SCHED_PARAM_POLICY));
+    assert_int_equal(tgt.sched.policy, SCHED_BATCH);
+    assert_int_equal(tgt.sched.priority, 0);
+
+    // A later definition replaces the earlier one, names are case-insensitive.
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "FIFO:10", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.policy, SCHED_FIFO);
+    assert_int_equal(tgt.sched.priority, 10);
+
+    char opt[32];
+    assert_int_equal(crinitSchedParamsLauncherOpt(opt, sizeof(opt), &tgt.sched, CRINIT_SCHED_PARAM_POLICY),
+                     strlen("--sched-policy=fifo:10"));
+    assert_string_equal(opt, "--sched-policy=fifo:10");
+
+    assert_int_equal(crinitCfgSchedPolicyHandler(&tgt, "rr:99", CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.sched.policy, SCHED_RR);
+    assert_int_equal(tgt.sched.priority, 99);
+}
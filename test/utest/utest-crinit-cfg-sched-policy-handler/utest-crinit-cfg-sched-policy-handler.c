@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-sched-policy-handler.c
+ * @brief Implementation of the crinitCfgSchedPolicyHandler() unit test group.
+ */
+
+#include "utest-crinit-cfg-sched-policy-handler.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCfgSchedPolicyHandler() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCfgSchedPolicyHandlerTestSuccess),
+        cmocka_unit_test(crinitCfgSchedPolicyHandlerTestInvalidInput),
+        cmocka_unit_test(crinitCfgSchedPolicyHandlerTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cfg-sched-policy-handler.h
+ * @brief Header declaring the unit tests for crinitCfgSchedPolicyHandler().
+ */
+#ifndef __UTEST_CFG_SCHED_POLICY_HANDLER_H__
+#define __UTEST_CFG_SCHED_POLICY_HANDLER_H__
+
+/**
+ * Tests successful parsing of scheduling policies with and without priority.
+ */
+void crinitCfgSchedPolicyHandlerTestSuccess(void **state);
+/**
+ * Tests unsuccessful parsing of unknown policies and out-of-range priorities.
+ */
+void crinitCfgSchedPolicyHandlerTestInvalidInput(void **state);
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCfgSchedPolicyHandlerTestNullInput(void **state);
+
+#endif /* __UTEST_CFG_SCHED_POLICY_HANDLER_H__ */
@@ -21,6 +21,7 @@ void crinitCfgStopCommandHandlerTestSingleStopCommandSuccess(void **state) {
     assert_int_equal(crinitCfgStopCmdHandler(&tgt, val, CRINIT_CONFIG_TYPE_TASK), 0);
     assert_int_equal(tgt.stopCmdsSize, 1);
     assert_string_equal(tgt.stopCmds[0].argv[0], "/bin/true");
+    assert_null(tgt.stopCmds[0].tmpl);
     crinitDestroyTask(&tgt);
 }
 
@@ -37,3 +38,20 @@ void crinitCfgStopCommandHandlerTestSingleStopCommandWithParameterSuccess(void *
     assert_string_equal(tgt.stopCmds[0].argv[1], "foo bar");
     crinitDestroyTask(&tgt);
 }
+
+void crinitCfgStopCommandHandlerTestStopCommandWithVariableSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTask_t tgt;
+    memset(&tgt, 0x00, sizeof(tgt));
+    const char *val = "/bin/kill ${TASK_PID}";
+    assert_int_equal(crinitCfgStopCmdHandler(&tgt, val, CRINIT_CONFIG_TYPE_TASK), 0);
+    assert_int_equal(tgt.stopCmdsSize, 1);
+    assert_int_equal(tgt.stopCmds[0].argc, 2);
+    assert_string_equal(tgt.stopCmds[0].argv[1], "${TASK_PID}");
+    assert_non_null(tgt.stopCmds[0].tmpl);
+    assert_int_equal(tgt.stopCmds[0].tmpl->segsSize, 2);
+    assert_int_equal(tgt.stopCmds[0].tmpl->segs[0].arg, 1);
+    assert_int_equal(tgt.stopCmds[0].tmpl->segs[0].var, CRINIT_CMD_VAR_TASK_PID);
+    crinitDestroyTask(&tgt);
+}
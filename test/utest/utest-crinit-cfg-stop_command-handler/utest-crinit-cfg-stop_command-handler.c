@@ -15,6 +15,7 @@ int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(crinitCfgStopCommandHandlerTestSingleStopCommandSuccess),
         cmocka_unit_test(crinitCfgStopCommandHandlerTestSingleStopCommandWithParameterSuccess),
+        cmocka_unit_test(crinitCfgStopCommandHandlerTestStopCommandWithVariableSuccess),
         cmocka_unit_test(crinitCfgStopCommandHandlerTestNullInput),
     };
 
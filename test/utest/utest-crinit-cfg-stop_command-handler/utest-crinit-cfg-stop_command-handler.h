@@ -14,6 +14,11 @@ void crinitCfgStopCommandHandlerTestSingleStopCommandSuccess(void **state);
  * Tests successful parsing of a stop command with parameter.
  */
 void crinitCfgStopCommandHandlerTestSingleStopCommandWithParameterSuccess(void **state);
+
+/**
+ * Tests successful parsing of a stop command with a variable which is compiled into a template.
+ */
+void crinitCfgStopCommandHandlerTestStopCommandWithVariableSuccess(void **state);
 /**
  * Tests detection of NULL pointer input.
  */
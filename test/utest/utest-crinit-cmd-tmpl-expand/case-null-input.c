@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-null-input.c
+ * @brief Unit test for crinitCmdTmplCompile(), crinitCmdTmplExpand() and crinitCmdTmplDup(), handling of null pointer
+ *        input.
+ */
+
+#include <stdlib.h>
+
+#include "cmdtmpl.h"
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-cmd-tmpl-expand.h"
+
+void crinitCmdTmplExpandTestNullInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char *argv[] = {"/bin/kill", "${TASK_PID}"};
+    const crinitCmdVarVals_t vals = {.taskName = "test_task", .pid = 4711, .exitStatus = -1};
+    crinitCmdTmpl_t *tmpl = NULL;
+    char **result = NULL;
+
+    assert_int_equal(crinitCmdTmplCompile(NULL, 2, argv), -1);
+    assert_int_equal(crinitCmdTmplCompile(&tmpl, 2, NULL), -1);
+
+    assert_int_equal(crinitCmdTmplCompile(&tmpl, 2, argv), 0);
+    assert_non_null(tmpl);
+    assert_int_equal(crinitCmdTmplExpand(NULL, tmpl, 2, argv, &vals), -1);
+    assert_int_equal(crinitCmdTmplExpand(&result, NULL, 2, argv, &vals), -1);
+    assert_int_equal(crinitCmdTmplExpand(&result, tmpl, 2, NULL, &vals), -1);
+    assert_int_equal(crinitCmdTmplExpand(&result, tmpl, 2, argv, NULL), -1);
+    assert_null(result);
+
+    assert_int_equal(crinitCmdTmplDup(NULL, tmpl), -1);
+    free(tmpl);
+}
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitCmdTmplCompile() and crinitCmdTmplExpand(), successful execution.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmdtmpl.h"
+#include "common.h"
+#include "confparse.h"
+#include "unit_test.h"
+#include "utest-crinit-cmd-tmpl-expand.h"
+
+#define CRINIT_ARGV_SIZE(argv) ((int)(sizeof(argv) / sizeof((argv)[0])))
+
+static const crinitCmdVarVals_t crinitTestVals = {.taskName = "test_task", .pid = 4711, .exitStatus = 143};
+
+static char **crinitCompileAndExpand(int argc, char *const argv[], size_t expectedSegs) {
+    crinitCmdTmpl_t *tmpl = NULL;
+    char **result = NULL;
+
+    assert_int_equal(crinitCmdTmplCompile(&tmpl, argc, argv), 0);
+    assert_non_null(tmpl);
+    assert_int_equal(tmpl->segsSize, expectedSegs);
+    assert_int_equal(crinitCmdTmplExpand(&result, tmpl, argc, argv, &crinitTestVals), 0);
+    assert_non_null(result);
+    assert_null(result[argc]);
+
+    free(tmpl);
+    return result;
+}
+
+void crinitCmdTmplExpandTestOneVariableReplaced(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char *argv[] = {"This is a test ${TASK_PID}."};
+    char **result = crinitCompileAndExpand(CRINIT_ARGV_SIZE(argv), argv, 2);
+
+    assert_string_equal(result[0], "This is a test 4711.");
+
+    crinitFreeArgvArray(result);
+}
+
+void crinitCmdTmplExpandTestTwoVariablesReplaced(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char *argv[] = {"This is a test ${TASK_PID} with two occurences ${TASK_PID}. Blubb."};
+    char **result = crinitCompileAndExpand(CRINIT_ARGV_SIZE(argv), argv, 3);
+
+    assert_string_equal(result[0], "This is a test 4711 with two occurences 4711. Blubb.");
+
+    crinitFreeArgvArray(result);
+}
+
+void crinitCmdTmplExpandTestOneVariableInThreeArgv(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char *argv[] = {"TestCommand_1", "TestCommand_2 ${TASK_PID}", "TestCommand_3"};
+    char **result = crinitCompileAndExpand(CRINIT_ARGV_SIZE(argv), argv, 2);
+
+    assert_string_equal(result[0], "TestCommand_1");
+    assert_string_equal(result[1], "TestCommand_2 4711");
+    assert_string_equal(result[2], "TestCommand_3");
+
+    crinitFreeArgvArray(result);
+}
+
+void crinitCmdTmplExpandTestAllVariablesReplaced(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char *argv[] = {"/bin/notify", "${TASK_NAME}", "pid=${MAINPID}", "${TASK_PID}${EXIT_STATUS}", "${EXIT_STATUS}"};
+    char **result = crinitCompileAndExpand(CRINIT_ARGV_SIZE(argv), argv, 9);
+
+    assert_string_equal(result[0], "/bin/notify");
+    assert_string_equal(result[1], "test_task");
+    assert_string_equal(result[2], "pid=4711");
+    assert_string_equal(result[3], "4711143");
+    assert_string_equal(result[4], "143");
+
+    crinitFreeArgvArray(result);
+}
+
+void crinitCmdTmplExpandTestNoKnownVariables(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitCmdTmpl_t *tmpl = (crinitCmdTmpl_t *)0x1;
+    char *argvNone[] = {"/bin/kill", "-TERM", "4711"};
+    assert_int_equal(crinitCmdTmplCompile(&tmpl, CRINIT_ARGV_SIZE(argvNone), argvNone), 0);
+    assert_null(tmpl);
+
+    // Unknown variables are left for the shell or the command to handle, but do not hide known ones.
+    tmpl = (crinitCmdTmpl_t *)0x1;
+    char *argvUnknown[] = {"/bin/echo", "${HOME}"};
+    assert_int_equal(crinitCmdTmplCompile(&tmpl, CRINIT_ARGV_SIZE(argvUnknown), argvUnknown), 0);
+    assert_null(tmpl);
+
+    char *argvMixed[] = {"${HOME}/${TASK_PID}"};
+    char **result = crinitCompileAndExpand(CRINIT_ARGV_SIZE(argvMixed), argvMixed, 2);
+    assert_string_equal(result[0], "${HOME}/4711");
+    crinitFreeArgvArray(result);
+}
+
+void crinitCmdTmplExpandTestDupSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char *argv[] = {"/bin/kill", "${TASK_PID}"};
+    crinitCmdTmpl_t *tmpl = NULL, *copy = NULL;
+    assert_int_equal(crinitCmdTmplCompile(&tmpl, CRINIT_ARGV_SIZE(argv), argv), 0);
+    assert_non_null(tmpl);
+
+    assert_int_equal(crinitCmdTmplDup(&copy, tmpl), 0);
+    assert_non_null(copy);
+    assert_ptr_not_equal(copy, tmpl);
+    assert_int_equal(copy->segsSize, tmpl->segsSize);
+    assert_memory_equal(copy->segs, tmpl->segs, tmpl->segsSize * sizeof(tmpl->segs[0]));
+    free(tmpl);
+
+    char **result = NULL;
+    assert_int_equal(crinitCmdTmplExpand(&result, copy, CRINIT_ARGV_SIZE(argv), argv, &crinitTestVals), 0);
+    assert_string_equal(result[0], "/bin/kill");
+    assert_string_equal(result[1], "4711");
+    crinitFreeArgvArray(result);
+    free(copy);
+
+    copy = (crinitCmdTmpl_t *)0x1;
+    assert_int_equal(crinitCmdTmplDup(&copy, NULL), 0);
+    assert_null(copy);
+}
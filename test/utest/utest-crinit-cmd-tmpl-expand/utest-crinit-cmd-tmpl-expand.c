@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cmd-tmpl-expand.c
+ * @brief Implementation of the crinitCmdTmplExpand() unit test group.
+ */
+
+#include "utest-crinit-cmd-tmpl-expand.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitCmdTmplExpand() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitCmdTmplExpandTestOneVariableReplaced),
+        cmocka_unit_test(crinitCmdTmplExpandTestTwoVariablesReplaced),
+        cmocka_unit_test(crinitCmdTmplExpandTestOneVariableInThreeArgv),
+        cmocka_unit_test(crinitCmdTmplExpandTestAllVariablesReplaced),
+        cmocka_unit_test(crinitCmdTmplExpandTestNoKnownVariables),
+        cmocka_unit_test(crinitCmdTmplExpandTestDupSuccess),
+        cmocka_unit_test(crinitCmdTmplExpandTestNullInput),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-cmd-tmpl-expand.h
+ * @brief Header declaring the unit tests for crinitCmdTmplCompile() and crinitCmdTmplExpand().
+ */
+#ifndef __UTEST_CMD_TMPL_EXPAND_H__
+#define __UTEST_CMD_TMPL_EXPAND_H__
+
+/**
+ * Tests successful replacing one variable in a command.
+ */
+void crinitCmdTmplExpandTestOneVariableReplaced(void **state);
+
+/**
+ * Tests successful replacing two variables in a command.
+ */
+void crinitCmdTmplExpandTestTwoVariablesReplaced(void **state);
+
+/**
+ * Tests successful replacement of a variable in one of three arguments.
+ */
+void crinitCmdTmplExpandTestOneVariableInThreeArgv(void **state);
+
+/**
+ * Tests successful replacement of all supported variables.
+ */
+void crinitCmdTmplExpandTestAllVariablesReplaced(void **state);
+
+/**
+ * Tests that unknown variables and commands without variables are left as they are.
+ */
+void crinitCmdTmplExpandTestNoKnownVariables(void **state);
+
+/**
+ * Tests successful duplication of a template.
+ */
+void crinitCmdTmplExpandTestDupSuccess(void **state);
+
+/**
+ * Tests detection of NULL pointer input.
+ */
+void crinitCmdTmplExpandTestNullInput(void **state);
+
+#endif /* __UTEST_CMD_TMPL_EXPAND_H__ */
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-fallback.c
+ * @brief Unit test for crinitConnXfer(), fallback to version 1 of the protocol.
+ */
+
+#include "common.h"
+#include "sockcom.h"
+#include "unit_test.h"
+#include "utest-crinit-conn-xfer.h"
+
+void crinitConnXferTestV1Fallback(void **state) {
+    crinitTestServer_t *srv = *state;
+    srv->mode = CRINIT_TEST_SERVER_V1;
+
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+
+    crinitRtimCmd_t cmd, res;
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_RESTART, 1, "task"), 0);
+    assert_int_equal(crinitConnXfer(&conn, &res, &cmd), 0);
+    assert_int_equal(res.op, CRINIT_RTIMCMD_R_RESTART);
+    assert_int_equal(res.argc, 2);
+    assert_string_equal(res.args[0].str, "RES_OK");
+    assert_string_equal(res.args[1].str, "task");
+    crinitDestroyRtimCmd(&res);
+
+    // Both the request and the version check have been rejected unread before the request was repeated.
+    assert_int_equal(atomic_load(&srv->v2Rejected), 2);
+    assert_int_equal(atomic_load(&srv->executed), 1);
+    assert_int_equal(atomic_load(&srv->probes), 0);
+    assert_int_equal(conn.version, 1);
+
+    // The connection is closed after each response, so the next request needs a new one.
+    assert_int_equal(crinitConnXfer(&conn, &res, &cmd), 0);
+    crinitDestroyRtimCmd(&res);
+    assert_int_equal(atomic_load(&srv->executed), 2);
+    assert_true(conn.perRequest);
+    crinitDestroyRtimCmd(&cmd);
+    crinitConnClose(&conn);
+
+    // Later connections use version 1 right away.
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+    assert_int_equal(conn.version, 1);
+    crinitConnClose(&conn);
+    assert_int_equal(atomic_load(&srv->v2Rejected), 2);
+}
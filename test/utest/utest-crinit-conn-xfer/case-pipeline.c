@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-pipeline.c
+ * @brief Unit test for crinitConnSend() and crinitConnRecv(), pipelined requests.
+ */
+
+#include <stdint.h>
+
+#include "common.h"
+#include "sockcom.h"
+#include "unit_test.h"
+#include "utest-crinit-conn-xfer.h"
+
+#define CRINIT_TEST_REQUESTS 3  ///< Number of requests sent before the first response is received.
+
+void crinitConnXferTestPipelineSuccess(void **state) {
+    crinitTestServer_t *srv = *state;
+    const char *names[CRINIT_TEST_REQUESTS] = {"a", "b", "c"};
+
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+
+    crinitRtimCmd_t cmd, res;
+    uint64_t reqIds[CRINIT_TEST_REQUESTS];
+    for (size_t i = 0; i < CRINIT_TEST_REQUESTS; i++) {
+        assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_STATUS, 1, names[i]), 0);
+        assert_int_equal(crinitConnSend(&conn, &cmd, &reqIds[i]), 0);
+        crinitDestroyRtimCmd(&cmd);
+        assert_int_equal(reqIds[i], i);
+    }
+
+    for (size_t i = 0; i < CRINIT_TEST_REQUESTS; i++) {
+        uint64_t resId = UINT64_MAX;
+        assert_int_equal(crinitConnRecv(&conn, &res, &resId), 0);
+        assert_int_equal(resId, reqIds[i]);
+        assert_int_equal(res.argc, 2);
+        assert_string_equal(res.args[1].str, names[i]);
+        crinitDestroyRtimCmd(&res);
+    }
+
+    // There is no outstanding request left.
+    assert_int_equal(crinitConnRecv(&conn, &res, NULL), -1);
+    assert_int_equal(atomic_load(&srv->executed), CRINIT_TEST_REQUESTS);
+    assert_int_equal(conn.sockReqs, CRINIT_TEST_REQUESTS);
+    crinitConnClose(&conn);
+}
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-reconnect.c
+ * @brief Unit test for crinitConnXfer(), reconnecting after Crinit has closed the connection.
+ */
+
+#include "common.h"
+#include "sockcom.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+#include "utest-crinit-conn-xfer.h"
+
+void crinitConnXferTestReconnectSuccess(void **state) {
+    crinitTestServer_t *srv = *state;
+    srv->closeAfter = 1;
+
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+
+    crinitRtimCmd_t cmd, res;
+    const char *names[] = {"a", "b", "c"};
+    for (size_t i = 0; i < ARRAY_SIZE(names); i++) {
+        assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_STATUS, 1, names[i]), 0);
+        assert_int_equal(crinitConnXfer(&conn, &res, &cmd), 0);
+        crinitDestroyRtimCmd(&cmd);
+        assert_int_equal(res.argc, 2);
+        assert_string_equal(res.args[1].str, names[i]);
+        crinitDestroyRtimCmd(&res);
+
+        // Each request has been executed once, the ones sent over a closed connection have been repeated.
+        assert_int_equal(atomic_load(&srv->executed), i + 1);
+        assert_int_equal(conn.sockReqs, 1);
+    }
+
+    // From the second request on, a new connection is opened for each request, without a version fallback.
+    assert_true(conn.perRequest);
+    assert_int_equal(conn.version, CRINIT_SOCKMSG_VERSION);
+    assert_int_equal(atomic_load(&srv->probes), 0);
+    crinitConnClose(&conn);
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-reset.c
+ * @brief Unit test for crinitConnXfer(), connection closed by a current Crinit without a response.
+ */
+
+#include <errno.h>
+
+#include "common.h"
+#include "sockcom.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+#include "utest-crinit-conn-xfer.h"
+
+void crinitConnXferTestResetFailure(void **state) {
+    crinitTestServer_t *srv = *state;
+    srv->mode = CRINIT_TEST_SERVER_V2_DROP;
+
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+
+    crinitRtimCmd_t cmd, res;
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_RESTART, 1, "task"), 0);
+    errno = 0;
+    assert_int_equal(crinitConnXfer(&conn, &res, &cmd), -1);
+    assert_int_equal(errno, ECONNRESET);
+    crinitDestroyRtimCmd(&cmd);
+
+    // Crinit has answered the version check, so the request must not have been repeated.
+    assert_int_equal(atomic_load(&srv->executed), 1);
+    assert_int_equal(atomic_load(&srv->probes), 1);
+    assert_int_equal(conn.version, CRINIT_SOCKMSG_VERSION);
+    crinitConnClose(&conn);
+
+    // Later connections keep using version 2.
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+    assert_int_equal(conn.version, CRINIT_SOCKMSG_VERSION);
+    crinitConnClose(&conn);
+}
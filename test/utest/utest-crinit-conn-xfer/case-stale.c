@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-stale.c
+ * @brief Unit test for crinitConnXfer(), skipping stale responses.
+ */
+
+#include "common.h"
+#include "sockcom.h"
+#include "unit_test.h"
+#include "utest-crinit-conn-xfer.h"
+
+void crinitConnXferTestStaleSuccess(void **state) {
+    crinitTestServer_t *srv = *state;
+
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+
+    // Two requests whose responses are never received, e.g. because the caller gave up on them.
+    crinitRtimCmd_t cmd, res;
+    for (int i = 0; i < 2; i++) {
+        assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_STATUS, 1, "stale"), 0);
+        assert_int_equal(crinitConnSend(&conn, &cmd, NULL), 0);
+        crinitDestroyRtimCmd(&cmd);
+    }
+
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_STATUS, 1, "current"), 0);
+    assert_int_equal(crinitConnXfer(&conn, &res, &cmd), 0);
+    crinitDestroyRtimCmd(&cmd);
+    assert_int_equal(res.argc, 2);
+    assert_string_equal(res.args[1].str, "current");
+    crinitDestroyRtimCmd(&res);
+
+    // All responses have been consumed over the same connection.
+    assert_int_equal(conn.nextResId, conn.nextReqId);
+    assert_int_equal(conn.sockReqs, 3);
+    assert_int_equal(conn.sockResps, 3);
+    assert_int_equal(atomic_load(&srv->executed), 3);
+    crinitConnClose(&conn);
+}
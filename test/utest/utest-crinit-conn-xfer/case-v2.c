@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-v2.c
+ * @brief Unit test for crinitConnXfer(), transfer with a current Crinit.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "sockcom.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+#include "utest-crinit-conn-xfer.h"
+
+void crinitConnXferTestV2Success(void **state) {
+    crinitTestServer_t *srv = *state;
+
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, srv->sockFile), 0);
+    assert_int_equal(conn.version, CRINIT_SOCKMSG_VERSION);
+
+    crinitRtimCmd_t cmd, res;
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_STATUS, 1, "task"), 0);
+    for (int i = 1; i <= 2; i++) {
+        assert_int_equal(crinitConnXfer(&conn, &res, &cmd), 0);
+        assert_int_equal(res.op, CRINIT_RTIMCMD_R_STATUS);
+        assert_int_equal(res.argc, 2);
+        assert_string_equal(res.args[0].str, "RES_OK");
+        assert_string_equal(res.args[1].str, "task");
+        crinitDestroyRtimCmd(&res);
+        assert_int_equal(atomic_load(&srv->executed), i);
+    }
+    crinitDestroyRtimCmd(&cmd);
+
+    // Both requests have been answered over the same connection without checking the version.
+    assert_int_equal(conn.version, CRINIT_SOCKMSG_VERSION);
+    assert_int_equal(conn.sockReqs, 2);
+    assert_false(conn.perRequest);
+    assert_int_equal(atomic_load(&srv->probes), 0);
+    crinitConnClose(&conn);
+}
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-conn-xfer.c
+ * @brief Implementation of the unit tests for crinitConnXfer() and the fake Crinit server they use.
+ */
+
+#include "utest-crinit-conn-xfer.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "rtimcmd.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+
+/**
+ * Build the answer of the fake server to a request.
+ *
+ * @param res  Return pointer for the response.
+ * @param cmd  The request.
+ *
+ * @return 0 on success, -1 otherwise
+ */
+static int crinitTestBuildResponse(crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
+/**
+ * Serve a connection of a client using version 2 of the protocol.
+ *
+ * @param srv     The fake server.
+ * @param connFd  The accepted connection, will be closed.
+ */
+static void crinitTestServeV2(crinitTestServer_t *srv, int connFd);
+/**
+ * Serve a connection as an older Crinit only supporting version 1 of the protocol.
+ *
+ * @param srv     The fake server.
+ * @param connFd  The accepted connection, will be closed.
+ */
+static void crinitTestServeV1(crinitTestServer_t *srv, int connFd);
+/**
+ * Thread function of the fake server.
+ *
+ * @param arg  The crinitTestServer_t to run.
+ *
+ * @return NULL
+ */
+static void *crinitTestServerThread(void *arg);
+
+static int crinitTestBuildResponse(crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
+    crinitRtimArg_t args[cmd->argc + 1];
+    args[0] = (crinitRtimArg_t)CRINIT_RTIMARG_STR("RES_OK");
+    memcpy(&args[1], cmd->args, cmd->argc * sizeof(*cmd->args));
+    return crinitBuildRtimCmdArgs(res, cmd->op + 1, cmd->argc + 1, args);
+}
+
+static void crinitTestServeV2(crinitTestServer_t *srv, int connFd) {
+    for (int resps = 0; srv->closeAfter == 0 || resps < srv->closeAfter; resps++) {
+        ssize_t msgLen = recv(connFd, NULL, 0, MSG_PEEK | MSG_TRUNC);
+        if (msgLen <= (ssize_t)sizeof(crinitSockMsgHdr_t)) {
+            break;
+        }
+        char *buf = malloc(msgLen);
+        if (buf == NULL || recv(connFd, buf, msgLen, 0) != msgLen) {
+            free(buf);
+            break;
+        }
+        crinitSockMsgHdr_t hdr;
+        memcpy(&hdr, buf, sizeof(hdr));
+        crinitRtimCmd_t cmd;
+        if (hdr.marker != CRINIT_SOCKMSG_MARKER ||
+            crinitParseRtimCmdBin(&cmd, buf + sizeof(hdr), (size_t)msgLen - sizeof(hdr)) == -1) {
+            free(buf);
+            break;
+        }
+        free(buf);
+
+        bool probe = cmd.op == CRINIT_RTIMCMD_C_GETVER;
+        atomic_fetch_add(probe ? &srv->probes : &srv->executed, 1);
+        if (srv->mode == CRINIT_TEST_SERVER_V2_DROP && !probe) {
+            crinitDestroyRtimCmd(&cmd);
+            break;
+        }
+
+        crinitRtimCmd_t res;
+        void *resMsg = NULL;
+        size_t resLen = 0;
+        int ret = crinitTestBuildResponse(&res, &cmd);
+        crinitDestroyRtimCmd(&cmd);
+        if (ret == -1) {
+            break;
+        }
+        ret = crinitRtimCmdToMsgBin(&resMsg, &resLen, &res);
+        crinitDestroyRtimCmd(&res);
+        if (ret == -1) {
+            break;
+        }
+        hdr = (crinitSockMsgHdr_t){CRINIT_SOCKMSG_MARKER, CRINIT_SOCKMSG_VERSION, 0};
+        struct iovec iov[2] = {{.iov_base = &hdr, .iov_len = sizeof(hdr)}, {.iov_base = resMsg, .iov_len = resLen}};
+        struct msghdr mHdr = {.msg_iov = iov, .msg_iovlen = 2};
+        ret = sendmsg(connFd, &mHdr, MSG_NOSIGNAL) == -1 ? -1 : 0;
+        free(resMsg);
+        if (ret == -1) {
+            break;
+        }
+    }
+    close(connFd);
+}
+
+static void crinitTestServeV1(crinitTestServer_t *srv, int connFd) {
+    size_t len = sizeof("RTR");
+    if (send(connFd, &len, sizeof(len), MSG_NOSIGNAL) == -1 || send(connFd, "RTR", len, MSG_NOSIGNAL) == -1) {
+        close(connFd);
+        return;
+    }
+
+    // Reads the start of a version 2 message as the length of the string, like an older Crinit.
+    if (recv(connFd, &len, sizeof(len), 0) != sizeof(len) || len == 0 || len == CRINIT_SOCKMSG_MARKER) {
+        if (len == CRINIT_SOCKMSG_MARKER) {
+            atomic_fetch_add(&srv->v2Rejected, 1);
+        }
+        close(connFd);
+        return;
+    }
+    char *str = malloc(len);
+    crinitRtimCmd_t cmd;
+    if (str == NULL || recv(connFd, str, len, 0) != (ssize_t)len) {
+        free(str);
+        close(connFd);
+        return;
+    }
+    str[len - 1] = '\0';
+    int ret = crinitParseRtimCmd(&cmd, str);
+    free(str);
+    if (ret == -1) {
+        close(connFd);
+        return;
+    }
+    atomic_fetch_add(cmd.op == CRINIT_RTIMCMD_C_GETVER ? &srv->probes : &srv->executed, 1);
+
+    crinitRtimCmd_t res;
+    ret = crinitTestBuildResponse(&res, &cmd);
+    crinitDestroyRtimCmd(&cmd);
+    if (ret == 0) {
+        ret = crinitRtimCmdToMsgStr(&str, &len, &res);
+        crinitDestroyRtimCmd(&res);
+    }
+    if (ret == 0) {
+        send(connFd, &len, sizeof(len), MSG_NOSIGNAL);
+        send(connFd, str, len, MSG_NOSIGNAL);
+        free(str);
+    }
+    // An older Crinit closes the connection after the first response.
+    close(connFd);
+}
+
+static void *crinitTestServerThread(void *arg) {
+    crinitTestServer_t *srv = arg;
+    while (true) {
+        int connFd = accept(srv->listenFd, NULL, NULL);
+        if (connFd == -1) {
+            break;
+        }
+        if (atomic_load(&srv->stop)) {
+            close(connFd);
+            break;
+        }
+        if (srv->mode == CRINIT_TEST_SERVER_V1) {
+            crinitTestServeV1(srv, connFd);
+        } else {
+            crinitTestServeV2(srv, connFd);
+        }
+    }
+    return NULL;
+}
+
+int crinitConnXferTestSetup(void **state) {
+    crinitTestServer_t *srv = calloc(1, sizeof(*srv));
+    assert_non_null(srv);
+    srv->mode = CRINIT_TEST_SERVER_V2;
+    memcpy(srv->sockDir, CRINIT_TEST_SOCK_DIR_TEMPLATE, sizeof(srv->sockDir));
+    assert_non_null(mkdtemp(srv->sockDir));
+    snprintf(srv->sockFile, sizeof(srv->sockFile), "%s%s", srv->sockDir, CRINIT_TEST_SOCK_NAME);
+
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    strncpy(addr.sun_path, srv->sockFile, sizeof(addr.sun_path) - 1);
+    srv->listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    assert_int_not_equal(srv->listenFd, -1);
+    assert_int_equal(bind(srv->listenFd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    assert_int_equal(listen(srv->listenFd, 8), 0);
+    assert_int_equal(pthread_create(&srv->thread, NULL, crinitTestServerThread, srv), 0);
+    *state = srv;
+    return 0;
+}
+
+int crinitConnXferTestTeardown(void **state) {
+    crinitTestServer_t *srv = *state;
+
+    // Wake up the server thread with a connection of its own.
+    atomic_store(&srv->stop, true);
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    strncpy(addr.sun_path, srv->sockFile, sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    assert_int_not_equal(fd, -1);
+    assert_int_equal(connect(fd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    pthread_join(srv->thread, NULL);
+    close(fd);
+
+    close(srv->listenFd);
+    unlink(srv->sockFile);
+    rmdir(srv->sockDir);
+    free(srv);
+    return 0;
+}
+
+/**
+ * Runs the unit test group for crinitConnXfer() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitConnXferTestV2Success, crinitConnXferTestSetup,
+                                        crinitConnXferTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitConnXferTestResetFailure, crinitConnXferTestSetup,
+                                        crinitConnXferTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitConnXferTestPipelineSuccess, crinitConnXferTestSetup,
+                                        crinitConnXferTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitConnXferTestStaleSuccess, crinitConnXferTestSetup,
+                                        crinitConnXferTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitConnXferTestReconnectSuccess, crinitConnXferTestSetup,
+                                        crinitConnXferTestTeardown),
+        // Falls back to version 1 for the rest of the process, so it has to be last.
+        cmocka_unit_test_setup_teardown(crinitConnXferTestV1Fallback, crinitConnXferTestSetup,
+                                        crinitConnXferTestTeardown),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
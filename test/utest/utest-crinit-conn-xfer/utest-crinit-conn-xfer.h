@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-conn-xfer.h
+ * @brief Header declaring the unit tests for crinitConnXfer() and the fake Crinit server they use.
+ */
+#ifndef __UTEST_CONN_XFER_H__
+#define __UTEST_CONN_XFER_H__
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/** Template for the directory holding the socket of the fake server. **/
+#define CRINIT_TEST_SOCK_DIR_TEMPLATE "/tmp/crinit-utest-sock-XXXXXX"
+/** Name of the socket of the fake server within its directory. **/
+#define CRINIT_TEST_SOCK_NAME "/crinit.sock"
+
+/**
+ * Behaviour of the fake server.
+ */
+typedef enum crinitTestServerMode {
+    CRINIT_TEST_SERVER_V2,       ///< A current Crinit, answers requests using version 2 of the protocol.
+    CRINIT_TEST_SERVER_V2_DROP,  ///< A current Crinit which closes the connection after executing a request, only
+                                 ///< GETVER requests are answered.
+    CRINIT_TEST_SERVER_V1,       ///< An older Crinit, only supports version 1 and answers one request per connection.
+} crinitTestServerMode_t;
+
+/**
+ * State of the fake server.
+ *
+ * Connections are served one after another by a single thread. Each request other than GETVER is answered with its
+ * response opcode, `RES_OK`, and the arguments of the request.
+ */
+typedef struct crinitTestServer {
+    crinitTestServerMode_t mode;  ///< Behaviour of the server, set before the first connection.
+    int closeAfter;               ///< If not 0, number of responses after which a connection is closed in version 2.
+    int listenFd;                 ///< The listening socket.
+    pthread_t thread;             ///< The thread serving the connections.
+    atomic_bool stop;             ///< Set to make the thread exit on the next connection.
+    atomic_int executed;          ///< Number of requests other than GETVER the server has read.
+    atomic_int probes;            ///< Number of GETVER requests the server has read.
+    atomic_int v2Rejected;        ///< Number of version 2 requests rejected by a server emulating version 1.
+    char sockDir[sizeof(CRINIT_TEST_SOCK_DIR_TEMPLATE)];                            ///< Directory of the socket.
+    char sockFile[sizeof(CRINIT_TEST_SOCK_DIR_TEMPLATE) + sizeof(CRINIT_TEST_SOCK_NAME)];  ///< Path of the socket.
+} crinitTestServer_t;
+
+/**
+ * Setup function, starts a fake server in #CRINIT_TEST_SERVER_V2 mode. The test may change the mode before connecting.
+ */
+int crinitConnXferTestSetup(void **state);
+/**
+ * Cleanup function, stops the fake server and removes its socket.
+ */
+int crinitConnXferTestTeardown(void **state);
+
+/**
+ * Tests that a transfer with a current Crinit uses version 2 of the protocol.
+ */
+void crinitConnXferTestV2Success(void **state);
+/**
+ * Tests that a connection closed by a current Crinit without a response neither repeats the request nor falls back
+ * to version 1.
+ */
+void crinitConnXferTestResetFailure(void **state);
+/**
+ * Tests that pipelined requests are answered in order and get the IDs of their requests.
+ */
+void crinitConnXferTestPipelineSuccess(void **state);
+/**
+ * Tests that responses to earlier requests which have not been received are skipped.
+ */
+void crinitConnXferTestStaleSuccess(void **state);
+/**
+ * Tests that the request is repeated over a new connection if Crinit has closed a connection which has already been
+ * used.
+ */
+void crinitConnXferTestReconnectSuccess(void **state);
+/**
+ * Tests that the request is repeated using version 1 if Crinit does not support version 2 and that later connections
+ * use version 1 right away. Must be the last test as the fallback applies to the whole process.
+ */
+void crinitConnXferTestV1Fallback(void **state);
+
+#endif /* __UTEST_CONN_XFER_H__ */
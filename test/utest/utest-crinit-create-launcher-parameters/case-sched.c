@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-sched.c
+ * @brief Unit test for crinitCreateLauncherParameters(), scheduling parameters.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-create-launcher-parameters.h"
+
+int crinitCreateLauncherParameters(crinitTaskCmd_t *taskCmd, crinitTask_t *tCopy, char *cmd, char ***argv,
+                                   char **argvBuffer);
+
+/**
+ * Create a task running as nobody with the given scheduling options, chained after NAME, COMMAND, USER and GROUP.
+ */
+static crinitTask_t *crinitCreateTaskWithSchedOpts(crinitConfKvList_t *schedOpts) {
+    crinitConfKvList_t group = {.next = schedOpts, .key = "GROUP", .val = "nogroup"};
+    crinitConfKvList_t user = {.next = &group, .key = "USER", .val = "nobody"};
+    crinitConfKvList_t cmd = {.next = &user, .key = "COMMAND", .val = "/bin/echo sched"};
+    crinitConfKvList_t name = {.next = &cmd, .key = "NAME", .val = "sched"};
+
+    crinitTask_t *tgt = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&tgt, &name), 0);
+    assert_non_null(tgt);
+    return tgt;
+}
+
+/**
+ * Check that the launcher options between the group and the end of options are exactly \a expected, in order.
+ * Capabilities are skipped as they depend on the build configuration.
+ */
+static void crinitAssertLauncherSchedOpts(char **argv, const char *const *expected, size_t expectedCount) {
+    assert_string_equal(argv[0], "crinit-launch");
+    assert_string_equal(argv[1], "--cmd=/bin/echo");
+    assert_string_equal(argv[2], "--user=65534");
+    assert_string_equal(argv[3], "--group=65534");
+
+    size_t i = 4, found = 0;
+    for (; argv[i] != NULL && strcmp(argv[i], "--") != 0; i++) {
+        if (strncmp(argv[i], "--caps=", strlen("--caps=")) == 0) {
+            continue;
+        }
+        assert_true(found < expectedCount);
+        assert_string_equal(argv[i], expected[found]);
+        found++;
+    }
+    assert_int_equal(found, expectedCount);
+    assert_non_null(argv[i]);
+    assert_string_equal(argv[i + 1], "sched");
+    assert_null(argv[i + 2]);
+}
+
+void crinitCreateLauncherParametersTestSchedSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char **argv = NULL;
+    char *argvBuffer = NULL;
+
+    crinitConfKvList_t oom = {.next = NULL, .key = "OOM_SCORE_ADJ", .val = "-500"};
+    crinitConfKvList_t ioprio = {.next = &oom, .key = "IO_PRIORITY", .val = "best-effort:2"};
+    crinitConfKvList_t affinity = {.next = &ioprio, .key = "CPU_AFFINITY", .val = "3,0-1"};
+    crinitConfKvList_t policy = {.next = &affinity, .key = "SCHED_POLICY", .val = "fifo:10"};
+    crinitConfKvList_t nice = {.next = &policy, .key = "NICE", .val = "5"};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    crinitTask_t *tgt = crinitCreateTaskWithSchedOpts(&nice);
+
+    assert_int_equal(crinitCreateLauncherParameters(tgt->cmds, tgt, "crinit-launch", &argv, &argvBuffer), 0);
+    assert_non_null(argv);
+    assert_non_null(argvBuffer);
+
+    // Always in the order of crinitSchedParam_t, independent of the order in the task file.
+    const char *const expected[] = {
+        "--cpu-affinity=0-1,3", "--sched-policy=fifo:10", "--nice=5", "--io-priority=best-effort:2",
+        "--oom-score-adj=-500",
+    };
+    crinitAssertLauncherSchedOpts(argv, expected, ARRAY_SIZE(expected));
+
+    free(argv);
+    free(argvBuffer);
+    crinitFreeTask(tgt);
+    crinitGlobOptDestroy();
+}
+
+void crinitCreateLauncherParametersTestSchedPartialSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char **argv = NULL;
+    char *argvBuffer = NULL;
+
+    // Options without a level are emitted without one, a nice value of 0 is still set.
+    crinitConfKvList_t ioprio = {.next = NULL, .key = "IO_PRIORITY", .val = "idle"};
+    crinitConfKvList_t policy = {.next = &ioprio, .key = "SCHED_POLICY", .val = "batch"};
+    crinitConfKvList_t nice = {.next = &policy, .key = "NICE", .val = "0"};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    crinitTask_t *tgt = crinitCreateTaskWithSchedOpts(&nice);
+
+    assert_int_equal(crinitCreateLauncherParameters(tgt->cmds, tgt, "crinit-launch", &argv, &argvBuffer), 0);
+
+    // CPU_AFFINITY and OOM_SCORE_ADJ are unset and must not be emitted.
+    const char *const expected[] = {"--sched-policy=batch", "--nice=0", "--io-priority=idle"};
+    crinitAssertLauncherSchedOpts(argv, expected, ARRAY_SIZE(expected));
+
+    free(argv);
+    free(argvBuffer);
+    crinitFreeTask(tgt);
+    crinitGlobOptDestroy();
+}
+
+void crinitCreateLauncherParametersTestSchedUnsetSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char **argv = NULL;
+    char *argvBuffer = NULL;
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    crinitTask_t *tgt = crinitCreateTaskWithSchedOpts(NULL);
+
+    assert_int_equal(crinitCreateLauncherParameters(tgt->cmds, tgt, "crinit-launch", &argv, &argvBuffer), 0);
+
+    // No scheduling options at all.
+    crinitAssertLauncherSchedOpts(argv, NULL, 0);
+
+    free(argv);
+    free(argvBuffer);
+    crinitFreeTask(tgt);
+    crinitGlobOptDestroy();
+}
@@ -16,6 +16,9 @@ int main(void) {
         cmocka_unit_test(crinitCfgLauncherCmdHandlerTestWithOneGroupSuccess),
         cmocka_unit_test(crinitCfgLauncherCmdHandlerTestWithTwoGroupsSuccess),
         cmocka_unit_test(crinitCfgLauncherCmdHandlerTestWithThreeGroupsSuccess),
+        cmocka_unit_test(crinitCreateLauncherParametersTestSchedSuccess),
+        cmocka_unit_test(crinitCreateLauncherParametersTestSchedPartialSuccess),
+        cmocka_unit_test(crinitCreateLauncherParametersTestSchedUnsetSuccess),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
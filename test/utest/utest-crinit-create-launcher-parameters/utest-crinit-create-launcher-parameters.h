@@ -18,4 +18,16 @@ void crinitCfgLauncherCmdHandlerTestWithTwoGroupsSuccess(void **state);
  * Tests successful parsing of a command with three groups (one main group, two supplementary groups).
  */
 void crinitCfgLauncherCmdHandlerTestWithThreeGroupsSuccess(void **state);
+/**
+ * Tests that all scheduling parameters are passed to crinit-launch in a fixed order.
+ */
+void crinitCreateLauncherParametersTestSchedSuccess(void **state);
+/**
+ * Tests that only the scheduling parameters which are set are passed to crinit-launch.
+ */
+void crinitCreateLauncherParametersTestSchedPartialSuccess(void **state);
+/**
+ * Tests that no scheduling parameters are passed to crinit-launch if none are set.
+ */
+void crinitCreateLauncherParametersTestSchedUnsetSuccess(void **state);
 #endif /* __UTEST_CREATE_LAUNCHER_PARAMETERS_H__ */
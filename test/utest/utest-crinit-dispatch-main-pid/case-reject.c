@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-reject.c
+ * @brief Unit test for crinitDispatchMainPidPermitted(), rejected main PIDs.
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-dispatch-main-pid.h"
+
+void crinitDispatchMainPidTestReject(void **state) {
+    int cgroupFd = *(int *)*state;
+    uid_t otherUser = geteuid() + 1;
+
+    // An unrelated process, here one of the task's ancestors and PID 1.
+    assert_false(crinitDispatchMainPidPermitted(getppid(), getpid(), otherUser, -1));
+    assert_false(crinitDispatchMainPidPermitted(1, getpid(), otherUser, -1));
+    // A process outside the task's cgroup.
+    assert_false(crinitDispatchMainPidPermitted(getppid(), getpid(), otherUser, cgroupFd));
+    // Anything once the task's process is gone and it has no cgroup.
+    assert_false(crinitDispatchMainPidPermitted(getpid(), -1, otherUser, -1));
+
+    // A process which does not exist (anymore).
+    pid_t child = fork();
+    assert_int_not_equal(child, -1);
+    if (child == 0) {
+        _exit(0);
+    }
+    assert_int_equal(waitpid(child, NULL, 0), child);
+    assert_false(crinitDispatchMainPidPermitted(child, getpid(), otherUser, -1));
+}
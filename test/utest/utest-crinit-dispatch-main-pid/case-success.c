@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitDispatchMainPidPermitted(), accepted main PIDs.
+ */
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-dispatch-main-pid.h"
+
+void crinitDispatchMainPidTestSuccess(void **state) {
+    int cgroupFd = *(int *)*state;
+    uid_t otherUser = geteuid() + 1;
+
+    // A task running as crinit's user may name any process, as it could use the NOTIFY command just as well.
+    assert_true(crinitDispatchMainPidPermitted(1, -1, geteuid(), -1));
+    assert_true(crinitDispatchMainPidPermitted(getppid(), getpid(), geteuid(), -1));
+
+    // The task's own process.
+    assert_true(crinitDispatchMainPidPermitted(getpid(), getpid(), otherUser, -1));
+
+    // A grandchild of the task's process, e.g. the daemon of a forking service before its parent exits.
+    int ready[2];
+    assert_int_equal(pipe(ready), 0);
+    pid_t child = fork();
+    assert_int_not_equal(child, -1);
+    if (child == 0) {
+        pid_t grandchild = fork();
+        if (grandchild == 0) {
+            close(ready[0]);
+            pause();
+            _exit(0);
+        }
+        if (write(ready[1], &grandchild, sizeof(grandchild)) != sizeof(grandchild)) {
+            _exit(1);
+        }
+        waitpid(grandchild, NULL, 0);
+        _exit(0);
+    }
+    close(ready[1]);
+    pid_t grandchild = -1;
+    assert_int_equal(read(ready[0], &grandchild, sizeof(grandchild)), sizeof(grandchild));
+    close(ready[0]);
+
+    assert_true(crinitDispatchMainPidPermitted(child, getpid(), otherUser, -1));
+    assert_true(crinitDispatchMainPidPermitted(grandchild, getpid(), otherUser, -1));
+    assert_true(crinitDispatchMainPidPermitted(grandchild, child, otherUser, -1));
+
+    kill(grandchild, SIGKILL);
+    assert_int_equal(waitpid(child, NULL, 0), child);
+
+    // A member of the task's cgroup, independent of how it was started.
+    assert_true(crinitDispatchMainPidPermitted(1, getpid(), otherUser, cgroupFd));
+    assert_true(crinitDispatchMainPidPermitted(1, -1, otherUser, cgroupFd));
+}
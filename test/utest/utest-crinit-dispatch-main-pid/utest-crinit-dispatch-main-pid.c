@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-dispatch-main-pid.c
+ * @brief Implementation of the unit tests for crinitDispatchMainPidPermitted().
+ */
+
+#include "utest-crinit-dispatch-main-pid.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "unit_test.h"
+
+/** Template for the directory standing in for a cgroup. **/
+#define CRINIT_CGROUP_DIR_TEMPLATE "/tmp/crinit-utest-cgroup-XXXXXX"
+/** Directory standing in for a cgroup. **/
+static char crinitCgroupDir[sizeof(CRINIT_CGROUP_DIR_TEMPLATE)];
+/** Path of cgroup.procs in crinitCgroupDir. **/
+static char crinitCgroupProcs[sizeof(crinitCgroupDir) + sizeof("/cgroup.procs")];
+
+int crinitDispatchMainPidTestSetup(void **state) {
+    memcpy(crinitCgroupDir, CRINIT_CGROUP_DIR_TEMPLATE, sizeof(crinitCgroupDir));
+    assert_non_null(mkdtemp(crinitCgroupDir));
+    snprintf(crinitCgroupProcs, sizeof(crinitCgroupProcs), "%s/cgroup.procs", crinitCgroupDir);
+    FILE *f = fopen(crinitCgroupProcs, "w");
+    assert_non_null(f);
+    fprintf(f, "1\n");
+    fclose(f);
+
+    int *cgroupFd = malloc(sizeof(*cgroupFd));
+    assert_non_null(cgroupFd);
+    *cgroupFd = open(crinitCgroupDir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    assert_int_not_equal(*cgroupFd, -1);
+    *state = cgroupFd;
+    return 0;
+}
+
+int crinitDispatchMainPidTestTeardown(void **state) {
+    int *cgroupFd = *state;
+    close(*cgroupFd);
+    free(cgroupFd);
+    unlink(crinitCgroupProcs);
+    rmdir(crinitCgroupDir);
+    return 0;
+}
+
+/**
+ * Runs the unit test group for crinitDispatchMainPidPermitted() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitDispatchMainPidTestSuccess, crinitDispatchMainPidTestSetup,
+                                        crinitDispatchMainPidTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitDispatchMainPidTestReject, crinitDispatchMainPidTestSetup,
+                                        crinitDispatchMainPidTestTeardown),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
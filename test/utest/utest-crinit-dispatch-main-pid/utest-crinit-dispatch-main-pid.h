@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-dispatch-main-pid.h
+ * @brief Header declaring the unit tests for crinitDispatchMainPidPermitted().
+ */
+#ifndef __UTEST_DISPATCH_MAIN_PID_H__
+#define __UTEST_DISPATCH_MAIN_PID_H__
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+/**
+ * The function under test, not part of a header as it is internal to the Process Dispatcher.
+ */
+bool crinitDispatchMainPidPermitted(pid_t mainPid, pid_t taskPid, uid_t taskUser, int cgroupFd);
+
+/**
+ * Setup function, creates a directory standing in for a cgroup whose `cgroup.procs` lists PID 1.
+ */
+int crinitDispatchMainPidTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitDispatchMainPidTestTeardown(void **state);
+
+/**
+ * Tests that the task's own process, its descendants, and members of its cgroup are accepted, as is any process for a
+ * task running with crinit's effective user ID.
+ */
+void crinitDispatchMainPidTestSuccess(void **state);
+/**
+ * Tests that other processes are rejected for a task running as a different user.
+ */
+void crinitDispatchMainPidTestReject(void **state);
+
+#endif /* __UTEST_DISPATCH_MAIN_PID_H__ */
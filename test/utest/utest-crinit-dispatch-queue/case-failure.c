@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for the dispatch queue, failure execution.
+ */
+
+#include <errno.h>
+
+#include "common.h"
+#include "dispqueue.h"
+#include "unit_test.h"
+#include "utest-crinit-dispatch-queue.h"
+
+void crinitDispatchQueueTestInitFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitDispatchQueue_t q;
+    errno = 0;
+    assert_int_equal(crinitDispatchQueueInit(&q, 0), -1);
+    assert_int_equal(errno, EINVAL);
+
+    assert_int_equal(crinitDispatchQueueInit(NULL, 1), -1);
+    assert_int_equal(crinitDispatchQueuePush(NULL, NULL), -1);
+    crinitDispatchQueueDestroy(NULL);
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-full.c
+ * @brief Unit test for the dispatch queue, pushing to a full queue.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "dispqueue.h"
+#include "unit_test.h"
+#include "utest-crinit-dispatch-queue.h"
+
+#define CRINIT_TEST_QUEUE_SIZE 3  ///< Depth of the queue under test.
+
+void crinitDispatchQueueTestFullFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitDispatchQueue_t q;
+    assert_int_equal(crinitDispatchQueueInit(&q, CRINIT_TEST_QUEUE_SIZE), 0);
+
+    for (uintptr_t i = 1; i <= CRINIT_TEST_QUEUE_SIZE; i++) {
+        assert_int_equal(crinitDispatchQueuePush(&q, (void *)i), 0);
+    }
+
+    // A full queue rejects the job right away instead of blocking and leaves the queued jobs untouched.
+    errno = 0;
+    assert_int_equal(crinitDispatchQueuePush(&q, (void *)UINTPTR_MAX), -1);
+    assert_int_equal(errno, EAGAIN);
+    assert_int_equal(q.items, CRINIT_TEST_QUEUE_SIZE);
+
+    // Only the first job taken from the full queue reports it.
+    bool wasFull = false;
+    assert_ptr_equal(crinitDispatchQueuePop(&q, &wasFull), (void *)1);
+    assert_true(wasFull);
+
+    // There is space for exactly one job again.
+    assert_int_equal(crinitDispatchQueuePush(&q, (void *)4), 0);
+    errno = 0;
+    assert_int_equal(crinitDispatchQueuePush(&q, (void *)UINTPTR_MAX), -1);
+    assert_int_equal(errno, EAGAIN);
+
+    for (uintptr_t i = 2; i <= CRINIT_TEST_QUEUE_SIZE + 1; i++) {
+        wasFull = false;
+        assert_ptr_equal(crinitDispatchQueuePop(&q, &wasFull), (void *)i);
+        assert_int_equal(wasFull, i == 2);
+    }
+    assert_int_equal(q.items, 0);
+
+    crinitDispatchQueueDestroy(&q);
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for the dispatch queue, FIFO order.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "dispqueue.h"
+#include "unit_test.h"
+#include "utest-crinit-dispatch-queue.h"
+
+#define CRINIT_TEST_QUEUE_SIZE 4  ///< Depth of the queue under test.
+
+void crinitDispatchQueueTestFifoSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitDispatchQueue_t q;
+    assert_int_equal(crinitDispatchQueueInit(&q, CRINIT_TEST_QUEUE_SIZE), 0);
+
+    // Push and pop in uneven batches so that the ring buffer wraps around several times.
+    uintptr_t nextIn = 1, nextOut = 1;
+    for (size_t round = 0; round < 5; round++) {
+        for (size_t i = 0; i < 3; i++) {
+            assert_int_equal(crinitDispatchQueuePush(&q, (void *)nextIn++), 0);
+        }
+        for (size_t i = 0; i < 3; i++) {
+            bool wasFull = true;
+            assert_ptr_equal(crinitDispatchQueuePop(&q, &wasFull), (void *)nextOut++);
+            assert_false(wasFull);
+        }
+    }
+    assert_int_equal(q.items, 0);
+
+    crinitDispatchQueueDestroy(&q);
+}
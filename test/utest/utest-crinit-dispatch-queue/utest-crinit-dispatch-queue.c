@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-dispatch-queue.c
+ * @brief Implementation of the unit tests for the dispatch queue.
+ */
+
+#include "utest-crinit-dispatch-queue.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for the dispatch queue using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitDispatchQueueTestFifoSuccess),
+        cmocka_unit_test(crinitDispatchQueueTestFullFailure),
+        cmocka_unit_test(crinitDispatchQueueTestInitFailure),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-dispatch-queue.h
+ * @brief Header declaring the unit tests for the dispatch queue.
+ */
+#ifndef __UTEST_DISPATCH_QUEUE_H__
+#define __UTEST_DISPATCH_QUEUE_H__
+
+/**
+ * Tests that jobs are taken from the queue in the order they were queued, also across the end of the ring buffer.
+ */
+void crinitDispatchQueueTestFifoSuccess(void **state);
+/**
+ * Tests that pushing to a full queue fails with EAGAIN and that taking a job from a full queue is reported.
+ */
+void crinitDispatchQueueTestFullFailure(void **state);
+/**
+ * Tests NULL pointer handling and rejection of a queue without space.
+ */
+void crinitDispatchQueueTestInitFailure(void **state);
+
+#endif /* __UTEST_DISPATCH_QUEUE_H__ */
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-accept-pause.c
+ * @brief Unit test for the notification and service interface, running out of file descriptors.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "sockcom.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+#include "utest-crinit-notiserv.h"
+
+#define CRINIT_TEST_PENDING 3  ///< Number of connections made while the process is out of file descriptors.
+
+void crinitNotiservTestAcceptPause(void **state) {
+    const char *sockFile = *state;
+    const int baseFds = crinitTestCountFds(NULL);
+    crinitRtimCmd_t cmd, res;
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_GETVER, 0), 0);
+
+    // An established connection, whose closing will resume accepting.
+    crinitClientConn_t keeper;
+    assert_int_equal(crinitConnOpen(&keeper, sockFile), 0);
+    assert_int_equal(crinitConnXfer(&keeper, &res, &cmd), 0);
+    crinitDestroyRtimCmd(&res);
+
+    // The client sockets are created before the process runs out of file descriptors, connecting does not need one.
+    int pending[CRINIT_TEST_PENDING];
+    for (size_t i = 0; i < CRINIT_TEST_PENDING; i++) {
+        pending[i] = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        assert_int_not_equal(pending[i], -1);
+    }
+
+    int maxFd = -1;
+    crinitTestCountFds(&maxFd);
+    struct rlimit origLimit, limit;
+    assert_int_equal(getrlimit(RLIMIT_NOFILE, &origLimit), 0);
+    limit = origLimit;
+    limit.rlim_cur = (rlim_t)maxFd + 1;
+    assert_int_equal(setrlimit(RLIMIT_NOFILE, &limit), 0);
+    int fillers[maxFd + 1];
+    int nFillers = 0;
+    int fd;
+    while ((fd = open("/dev/null", O_RDONLY | O_CLOEXEC)) != -1) {
+        fillers[nFillers++] = fd;
+    }
+    assert_int_equal(errno, EMFILE);
+
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    strncpy(addr.sun_path, sockFile, sizeof(addr.sun_path) - 1);
+    for (size_t i = 0; i < CRINIT_TEST_PENDING; i++) {
+        assert_int_equal(connect(pending[i], (struct sockaddr *)&addr, sizeof(addr)), 0);
+        crinitTestSendV2(pending[i], &cmd);
+    }
+    // The server cannot accept the connections and must not spin on the listening socket meanwhile.
+    for (size_t i = 0; i < CRINIT_TEST_PENDING; i++) {
+        assert_false(crinitTestWaitReadable(pending[i], 100));
+    }
+
+    for (int i = 0; i < nFillers; i++) {
+        close(fillers[i]);
+    }
+    assert_int_equal(setrlimit(RLIMIT_NOFILE, &origLimit), 0);
+    crinitConnClose(&keeper);
+
+    for (size_t i = 0; i < CRINIT_TEST_PENDING; i++) {
+        assert_true(crinitTestWaitReadable(pending[i], CRINIT_TEST_TIMEOUT_MS));
+        ssize_t msgLen = recv(pending[i], NULL, 0, MSG_PEEK | MSG_TRUNC);
+        assert_true(msgLen > (ssize_t)sizeof(crinitSockMsgHdr_t));
+        close(pending[i]);
+    }
+    crinitDestroyRtimCmd(&cmd);
+    crinitTestWaitFdCount(baseFds);
+}
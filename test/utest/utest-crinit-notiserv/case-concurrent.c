@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-concurrent.c
+ * @brief Unit test for the notification and service interface, requests on concurrent connections.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-notiserv.h"
+
+#define CRINIT_TEST_CONNS 8      ///< Number of concurrent connections.
+#define CRINIT_TEST_ARG_SIZE 32  ///< Size of the buffer for the argument identifying a request.
+
+void crinitNotiservTestConcurrentSuccess(void **state) {
+    const char *sockFile = *state;
+    const int baseFds = crinitTestCountFds(NULL);
+    int conns[CRINIT_TEST_CONNS];
+    crinitRtimCmd_t cmd, res;
+    char arg[CRINIT_TEST_ARG_SIZE];
+
+    for (size_t c = 0; c < CRINIT_TEST_CONNS; c++) {
+        conns[c] = crinitTestConnect(sockFile);
+        crinitTestRecvRtr(conns[c]);
+    }
+
+    // Every other request is executed by a command worker.
+    for (size_t c = 0; c < CRINIT_TEST_CONNS; c++) {
+        snprintf(arg, sizeof(arg), "%zu", c);
+        crinitRtimOp_t op = (c % 2 == 0) ? CRINIT_RTIMCMD_C_ADDTASK : CRINIT_RTIMCMD_C_STATUS;
+        assert_int_equal(crinitBuildRtimCmd(&cmd, op, 1, arg), 0);
+        crinitTestSendStr(conns[c], &cmd, false);
+        crinitDestroyRtimCmd(&cmd);
+    }
+
+    for (size_t c = CRINIT_TEST_CONNS; c-- > 0;) {
+        crinitTestRecvStr(conns[c], &res);
+        assert_int_equal(res.op, (c % 2 == 0) ? CRINIT_RTIMCMD_R_ADDTASK : CRINIT_RTIMCMD_R_STATUS);
+        assert_int_equal(res.argc, 2);
+        assert_string_equal(res.args[0].str, CRINIT_RTIMCMD_RES_OK);
+        snprintf(arg, sizeof(arg), "%zu", c);
+        assert_string_equal(res.args[1].str, arg);
+        crinitDestroyRtimCmd(&res);
+        close(conns[c]);
+    }
+    crinitTestWaitFdCount(baseFds);
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-partial.c
+ * @brief Unit test for the notification and service interface, requests and responses not transferred at once.
+ */
+
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "sockcom.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+#include "utest-crinit-notiserv.h"
+
+#define CRINIT_TEST_BIG_REQUESTS 16  ///< Number of requests with a large response, more than fit into the buffer.
+
+void crinitNotiservTestPartialRead(void **state) {
+    const char *sockFile = *state;
+    const int baseFds = crinitTestCountFds(NULL);
+    crinitRtimCmd_t cmd, res;
+
+    // Version 1, the server receives the length and string packets of each request in separate events.
+    int sockFd = crinitTestConnect(sockFile);
+    crinitTestRecvRtr(sockFd);
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_STATUS, 1, "task"), 0);
+    for (int i = 0; i < 2; i++) {
+        crinitTestSendStr(sockFd, &cmd, true);
+        crinitTestRecvStr(sockFd, &res);
+        assert_int_equal(res.op, CRINIT_RTIMCMD_R_STATUS);
+        assert_int_equal(res.argc, 2);
+        assert_string_equal(res.args[0].str, CRINIT_RTIMCMD_RES_OK);
+        assert_string_equal(res.args[1].str, "task");
+        crinitDestroyRtimCmd(&res);
+    }
+    crinitDestroyRtimCmd(&cmd);
+    close(sockFd);
+
+    // Version 2, the request arrives only after the server has accepted the connection and sent the ready-to-receive
+    // message.
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, sockFile), 0);
+    assert_true(crinitTestWaitReadable(conn.sockFd, CRINIT_TEST_TIMEOUT_MS));
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_GETVER, 0), 0);
+    assert_int_equal(crinitConnXfer(&conn, &res, &cmd), 0);
+    crinitDestroyRtimCmd(&cmd);
+    assert_int_equal(res.op, CRINIT_RTIMCMD_R_GETVER);
+    crinitDestroyRtimCmd(&res);
+    assert_int_equal(conn.version, CRINIT_SOCKMSG_VERSION);
+    crinitConnClose(&conn);
+    crinitTestWaitFdCount(baseFds);
+}
+
+void crinitNotiservTestPartialWrite(void **state) {
+    const char *sockFile = *state;
+    const int baseFds = crinitTestCountFds(NULL);
+    crinitRtimCmd_t cmd, res;
+    crinitClientConn_t conn;
+
+    atomic_store(&crinitTestSendAgain, 0);
+    assert_int_equal(crinitConnOpen(&conn, sockFile), 0);
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_STATUS, 1, CRINIT_TEST_BIG_RES_ARG), 0);
+    for (size_t i = 0; i < CRINIT_TEST_BIG_REQUESTS; i++) {
+        assert_int_equal(crinitConnSend(&conn, &cmd, NULL), 0);
+    }
+    crinitDestroyRtimCmd(&cmd);
+
+    // The server waits for the socket to become writable again while the responses are not read.
+    for (int waited = 0; atomic_load(&crinitTestSendAgain) == 0; waited += 10) {
+        assert_true(waited < CRINIT_TEST_TIMEOUT_MS);
+        usleep(10000);
+    }
+
+    for (size_t i = 0; i < CRINIT_TEST_BIG_REQUESTS; i++) {
+        uint64_t resId = UINT64_MAX;
+        assert_int_equal(crinitConnRecv(&conn, &res, &resId), 0);
+        assert_int_equal(resId, i);
+        assert_int_equal(res.argc, 2);
+        assert_int_equal(strlen(res.args[1].str), CRINIT_TEST_BIG_RES_SIZE);
+        crinitDestroyRtimCmd(&res);
+    }
+    crinitConnClose(&conn);
+    crinitTestWaitFdCount(baseFds);
+}
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-pipeline.c
+ * @brief Unit test for the notification and service interface, pipelined requests on concurrent connections.
+ */
+
+#include <stdio.h>
+
+#include "common.h"
+#include "sockcom.h"
+#include "unit_test.h"
+#include "utest-crinit-notiserv.h"
+
+#define CRINIT_TEST_CONNS 4      ///< Number of concurrent connections.
+#define CRINIT_TEST_REQUESTS 40  ///< Number of requests per connection, more than the server answers per event.
+#define CRINIT_TEST_ARG_SIZE 32  ///< Size of the buffer for the argument identifying a request.
+
+void crinitNotiservTestPipelineSuccess(void **state) {
+    const char *sockFile = *state;
+    const int baseFds = crinitTestCountFds(NULL);
+    crinitClientConn_t conns[CRINIT_TEST_CONNS];
+    crinitRtimCmd_t cmd, res;
+    char arg[CRINIT_TEST_ARG_SIZE];
+
+    for (size_t c = 0; c < CRINIT_TEST_CONNS; c++) {
+        assert_int_equal(crinitConnOpen(&conns[c], sockFile), 0);
+    }
+
+    // Every fifth request is executed by a command worker, which re-arms the connection afterwards.
+    for (size_t i = 0; i < CRINIT_TEST_REQUESTS; i++) {
+        for (size_t c = 0; c < CRINIT_TEST_CONNS; c++) {
+            snprintf(arg, sizeof(arg), "%zu-%zu", c, i);
+            crinitRtimOp_t op = (i % 5 == 0) ? CRINIT_RTIMCMD_C_ADDTASK : CRINIT_RTIMCMD_C_STATUS;
+            assert_int_equal(crinitBuildRtimCmd(&cmd, op, 1, arg), 0);
+            assert_int_equal(crinitConnSend(&conns[c], &cmd, NULL), 0);
+            crinitDestroyRtimCmd(&cmd);
+        }
+    }
+
+    for (size_t i = 0; i < CRINIT_TEST_REQUESTS; i++) {
+        for (size_t c = 0; c < CRINIT_TEST_CONNS; c++) {
+            uint64_t resId = UINT64_MAX;
+            assert_int_equal(crinitConnRecv(&conns[c], &res, &resId), 0);
+            assert_int_equal(resId, i);
+            assert_int_equal(res.op, (i % 5 == 0) ? CRINIT_RTIMCMD_R_ADDTASK : CRINIT_RTIMCMD_R_STATUS);
+            assert_int_equal(res.argc, 2);
+            assert_string_equal(res.args[0].str, CRINIT_RTIMCMD_RES_OK);
+            snprintf(arg, sizeof(arg), "%zu-%zu", c, i);
+            assert_string_equal(res.args[1].str, arg);
+            crinitDestroyRtimCmd(&res);
+        }
+    }
+
+    for (size_t c = 0; c < CRINIT_TEST_CONNS; c++) {
+        assert_false(conns[c].perRequest);
+        crinitConnClose(&conns[c]);
+    }
+    crinitTestWaitFdCount(baseFds);
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-teardown.c
+ * @brief Unit test for the notification and service interface, closing connections.
+ */
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "sockcom.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+#include "utest-crinit-notiserv.h"
+
+void crinitNotiservTestTeardown(void **state) {
+    const char *sockFile = *state;
+    const int baseFds = crinitTestCountFds(NULL);
+    crinitRtimCmd_t cmd;
+
+    // Closed by the client with requests outstanding, including one executed by a command worker.
+    crinitClientConn_t conn;
+    assert_int_equal(crinitConnOpen(&conn, sockFile), 0);
+    for (int i = 0; i < 5; i++) {
+        crinitRtimOp_t op = (i == 2) ? CRINIT_RTIMCMD_C_ADDTASK : CRINIT_RTIMCMD_C_STATUS;
+        assert_int_equal(crinitBuildRtimCmd(&cmd, op, 1, "task"), 0);
+        assert_int_equal(crinitConnSend(&conn, &cmd, NULL), 0);
+        crinitDestroyRtimCmd(&cmd);
+    }
+    crinitConnClose(&conn);
+    crinitTestWaitFdCount(baseFds);
+
+    // Closed by a version 1 client after the ready-to-receive message.
+    int sockFd = crinitTestConnect(sockFile);
+    crinitTestRecvRtr(sockFd);
+    close(sockFd);
+    crinitTestWaitFdCount(baseFds);
+
+    // A version 2 request which cannot be parsed.
+    sockFd = crinitTestConnect(sockFile);
+    crinitSockMsgHdr_t hdr = {CRINIT_SOCKMSG_MARKER, CRINIT_SOCKMSG_VERSION, 0};
+    const char junk[] = {1, 2, 3};
+    struct iovec iov[2] = {{.iov_base = &hdr, .iov_len = sizeof(hdr)}, {.iov_base = (void *)junk, .iov_len = 3}};
+    struct msghdr mHdr = {.msg_iov = iov, .msg_iovlen = 2};
+    assert_int_equal(sendmsg(sockFd, &mHdr, MSG_NOSIGNAL), sizeof(hdr) + sizeof(junk));
+    assert_true(crinitTestWaitClosed(sockFd));
+    close(sockFd);
+    crinitTestWaitFdCount(baseFds);
+
+    // A version 1 request announcing an empty string.
+    sockFd = crinitTestConnect(sockFile);
+    crinitTestRecvRtr(sockFd);
+    size_t len = 0;
+    assert_int_equal(send(sockFd, &len, sizeof(len), MSG_NOSIGNAL), sizeof(len));
+    assert_true(crinitTestWaitClosed(sockFd));
+    close(sockFd);
+    crinitTestWaitFdCount(baseFds);
+}
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-notiserv.c
+ * @brief Implementation of the unit tests for the connection handling of the notification and service interface.
+ */
+
+#include "utest-crinit-notiserv.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "notiserv.h"
+#include "sockmsg.h"
+#include "unit_test.h"
+
+atomic_int crinitTestSendAgain = 0;
+
+/** Directory holding the socket of the server. **/
+static char crinitTestSockDir[sizeof(CRINIT_TEST_SOCK_DIR_TEMPLATE)] = CRINIT_TEST_SOCK_DIR_TEMPLATE;
+/** Path of the socket of the server. **/
+static char crinitTestSockFile[sizeof(crinitTestSockDir) + sizeof(CRINIT_TEST_SOCK_NAME)];
+
+ssize_t __real_sendmsg(int sockFd, const struct msghdr *msg, int flags);
+
+int __wrap_crinitExecRtimCmd(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd) {
+    CRINIT_PARAM_UNUSED(ctx);
+
+    crinitRtimArg_t args[cmd->argc + 1];
+    args[0] = (crinitRtimArg_t)CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK);
+    memcpy(&args[1], cmd->args, cmd->argc * sizeof(*cmd->args));
+
+    char *big = NULL;
+    if (cmd->argc > 0 && cmd->args[0].type == CRINIT_RTIMARG_TYPE_STR &&
+        strcmp(cmd->args[0].str, CRINIT_TEST_BIG_RES_ARG) == 0) {
+        big = malloc(CRINIT_TEST_BIG_RES_SIZE + 1);
+        if (big == NULL) {
+            return -1;
+        }
+        memset(big, 'x', CRINIT_TEST_BIG_RES_SIZE);
+        big[CRINIT_TEST_BIG_RES_SIZE] = '\0';
+        args[1].str = big;
+    }
+    int ret = crinitBuildRtimCmdArgs(res, cmd->op + 1, cmd->argc + 1, args);
+    free(big);
+    return ret;
+}
+
+ssize_t __wrap_sendmsg(int sockFd, const struct msghdr *msg, int flags) {
+    ssize_t ret = __real_sendmsg(sockFd, msg, flags);
+    if (ret == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        atomic_fetch_add(&crinitTestSendAgain, 1);
+    }
+    return ret;
+}
+
+int crinitTestConnect(const char *sockFile) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    strncpy(addr.sun_path, sockFile, sizeof(addr.sun_path) - 1);
+    int sockFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    assert_int_not_equal(sockFd, -1);
+    assert_int_equal(connect(sockFd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    return sockFd;
+}
+
+bool crinitTestWaitReadable(int sockFd, int timeoutMs) {
+    struct pollfd pfd = {.fd = sockFd, .events = POLLIN};
+    int ret;
+    do {
+        ret = poll(&pfd, 1, timeoutMs);
+    } while (ret == -1 && errno == EINTR);
+    return ret == 1;
+}
+
+bool crinitTestWaitClosed(int sockFd) {
+    char buf[64];
+    while (crinitTestWaitReadable(sockFd, CRINIT_TEST_TIMEOUT_MS)) {
+        ssize_t ret = recv(sockFd, buf, sizeof(buf), 0);
+        if (ret == 0 || (ret == -1 && errno == ECONNRESET)) {
+            return true;
+        }
+        if (ret == -1) {
+            return false;
+        }
+    }
+    return false;
+}
+
+void crinitTestRecvRtr(int sockFd) {
+    size_t len = 0;
+    char rtr[sizeof("RTR")];
+    assert_true(crinitTestWaitReadable(sockFd, CRINIT_TEST_TIMEOUT_MS));
+    assert_int_equal(recv(sockFd, &len, sizeof(len), 0), sizeof(len));
+    assert_int_equal(len, sizeof(rtr));
+    assert_int_equal(recv(sockFd, rtr, sizeof(rtr), 0), sizeof(rtr));
+    assert_memory_equal(rtr, "RTR", sizeof(rtr));
+}
+
+void crinitTestSendStr(int sockFd, const crinitRtimCmd_t *cmd, bool split) {
+    char *str = NULL;
+    size_t strLen = 0;
+    assert_int_equal(crinitRtimCmdToMsgStr(&str, &strLen, cmd), 0);
+    assert_int_equal(send(sockFd, &strLen, sizeof(strLen), MSG_NOSIGNAL), sizeof(strLen));
+    if (split) {
+        // The server has nothing to answer before it has the string.
+        assert_false(crinitTestWaitReadable(sockFd, 100));
+    }
+    assert_int_equal(send(sockFd, str, strLen, MSG_NOSIGNAL), strLen);
+    free(str);
+}
+
+void crinitTestRecvStr(int sockFd, crinitRtimCmd_t *res) {
+    size_t len = 0;
+    assert_true(crinitTestWaitReadable(sockFd, CRINIT_TEST_TIMEOUT_MS));
+    assert_int_equal(recv(sockFd, &len, sizeof(len), 0), sizeof(len));
+    char *str = malloc(len);
+    assert_non_null(str);
+    assert_int_equal(recv(sockFd, str, len, 0), len);
+    assert_int_equal(crinitParseRtimCmd(res, str), 0);
+    free(str);
+}
+
+void crinitTestSendV2(int sockFd, const crinitRtimCmd_t *cmd) {
+    void *msg = NULL;
+    size_t msgLen = 0;
+    assert_int_equal(crinitRtimCmdToMsgBin(&msg, &msgLen, cmd), 0);
+    crinitSockMsgHdr_t hdr = {CRINIT_SOCKMSG_MARKER, CRINIT_SOCKMSG_VERSION, 0};
+    struct iovec iov[2] = {{.iov_base = &hdr, .iov_len = sizeof(hdr)}, {.iov_base = msg, .iov_len = msgLen}};
+    struct msghdr mHdr = {.msg_iov = iov, .msg_iovlen = 2};
+    assert_int_equal(sendmsg(sockFd, &mHdr, MSG_NOSIGNAL), sizeof(hdr) + msgLen);
+    free(msg);
+}
+
+int crinitTestCountFds(int *maxFd) {
+    DIR *d = opendir("/proc/self/fd");
+    assert_non_null(d);
+    int n = 0;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') {
+            continue;
+        }
+        n++;
+        int fd = atoi(e->d_name);
+        if (maxFd != NULL && (n == 1 || fd > *maxFd)) {
+            *maxFd = fd;
+        }
+    }
+    closedir(d);
+    return n;
+}
+
+void crinitTestWaitFdCount(int n) {
+    for (int waited = 0; crinitTestCountFds(NULL) != n; waited += 10) {
+        assert_true(waited < CRINIT_TEST_TIMEOUT_MS);
+        usleep(10000);
+    }
+}
+
+int crinitNotiservTestGroupSetup(void **state) {
+    // Only the pointer is passed on to the wrapped crinitExecRtimCmd().
+    static crinitTaskDB_t tdb;
+
+    assert_non_null(mkdtemp(crinitTestSockDir));
+    snprintf(crinitTestSockFile, sizeof(crinitTestSockFile), "%s%s", crinitTestSockDir, CRINIT_TEST_SOCK_NAME);
+    assert_int_equal(crinitStartInterfaceServer(&tdb, crinitTestSockFile), 0);
+    *state = crinitTestSockFile;
+    return 0;
+}
+
+int crinitNotiservTestGroupTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    unlink(crinitTestSockFile);
+    rmdir(crinitTestSockDir);
+    return 0;
+}
+
+/**
+ * Runs the unit test group for the connection handling of the notification and service interface using the cmocka
+ * API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitNotiservTestConcurrentSuccess),
+        cmocka_unit_test(crinitNotiservTestPipelineSuccess),
+        cmocka_unit_test(crinitNotiservTestPartialRead),
+        cmocka_unit_test(crinitNotiservTestPartialWrite),
+        cmocka_unit_test(crinitNotiservTestTeardown),
+        cmocka_unit_test(crinitNotiservTestAcceptPause),
+    };
+
+    return cmocka_run_group_tests(tests, crinitNotiservTestGroupSetup, crinitNotiservTestGroupTeardown);
+}
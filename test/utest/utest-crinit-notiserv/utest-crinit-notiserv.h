@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-notiserv.h
+ * @brief Header declaring the unit tests for the connection handling of the notification and service interface.
+ */
+#ifndef __UTEST_NOTISERV_H__
+#define __UTEST_NOTISERV_H__
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+
+#include "rtimcmd.h"
+#include "taskdb.h"
+
+/** Template for the directory holding the socket of the server. **/
+#define CRINIT_TEST_SOCK_DIR_TEMPLATE "/tmp/crinit-utest-notiserv-XXXXXX"
+/** Name of the socket of the server within its directory. **/
+#define CRINIT_TEST_SOCK_NAME "/crinit.sock"
+/** Argument making the wrapped crinitExecRtimCmd() respond with a string of #CRINIT_TEST_BIG_RES_SIZE Bytes. **/
+#define CRINIT_TEST_BIG_RES_ARG "big"
+/** Size of the string argument of a large response. **/
+#define CRINIT_TEST_BIG_RES_SIZE (64 * 1024)
+/** Time in milliseconds to wait for the server before a test fails. **/
+#define CRINIT_TEST_TIMEOUT_MS 5000
+
+/** Number of times the server has found a client socket not writable, counted by __wrap_sendmsg(). **/
+extern atomic_int crinitTestSendAgain;
+
+/**
+ * Stand-in for crinitExecRtimCmd(), so that the server does not need a task database.
+ *
+ * Answers with the response opcode of \a cmd, `RES_OK`, and the arguments of \a cmd. If the first argument is
+ * #CRINIT_TEST_BIG_RES_ARG, it is replaced by a string of #CRINIT_TEST_BIG_RES_SIZE Bytes.
+ */
+int __wrap_crinitExecRtimCmd(crinitTaskDB_t *ctx, crinitRtimCmd_t *res, const crinitRtimCmd_t *cmd);
+/**
+ * Wrapper for sendmsg() counting how often a socket has not been writable, see #crinitTestSendAgain.
+ */
+ssize_t __wrap_sendmsg(int sockFd, const struct msghdr *msg, int flags);
+
+/**
+ * Connect a new socket to the server.
+ *
+ * @param sockFile  Path of the server socket.
+ *
+ * @return  The connected socket.
+ */
+int crinitTestConnect(const char *sockFile);
+/**
+ * Wait until a socket has data to receive or has been closed by the server.
+ *
+ * @param sockFd     The socket.
+ * @param timeoutMs  Maximum time to wait in milliseconds.
+ *
+ * @return  true if the socket is readable, false on timeout
+ */
+bool crinitTestWaitReadable(int sockFd, int timeoutMs);
+/**
+ * Wait until the server has closed a connection, discarding any data it sends before.
+ *
+ * @param sockFd  The socket.
+ *
+ * @return  true if the connection has been closed, false on timeout
+ */
+bool crinitTestWaitClosed(int sockFd);
+/**
+ * Receive the ready-to-receive message the server sends on a new connection.
+ *
+ * @param sockFd  The connected socket.
+ */
+void crinitTestRecvRtr(int sockFd);
+/**
+ * Send a request using version 1 of the protocol without the client library, the length and string packets may be
+ * sent separately.
+ *
+ * @param sockFd  The connected socket.
+ * @param cmd     The request.
+ * @param split   If the server should be given the chance to handle the length packet on its own.
+ */
+void crinitTestSendStr(int sockFd, const crinitRtimCmd_t *cmd, bool split);
+/**
+ * Receive a response using version 1 of the protocol without the client library.
+ *
+ * @param sockFd  The connected socket.
+ * @param res     Return pointer for the response.
+ */
+void crinitTestRecvStr(int sockFd, crinitRtimCmd_t *res);
+/**
+ * Send a request using version 2 of the protocol without the client library.
+ *
+ * @param sockFd  The connected socket.
+ * @param cmd     The request.
+ */
+void crinitTestSendV2(int sockFd, const crinitRtimCmd_t *cmd);
+/**
+ * Count the open file descriptors of the process.
+ *
+ * @param maxFd  Return pointer for the highest open file descriptor, may be NULL.
+ *
+ * @return  The number of open file descriptors.
+ */
+int crinitTestCountFds(int *maxFd);
+/**
+ * Wait until the process has a given number of open file descriptors, i.e. the server has closed its connections.
+ *
+ * @param n  The expected number of open file descriptors.
+ */
+void crinitTestWaitFdCount(int n);
+
+/**
+ * Group setup function, starts the server on a socket in a temporary directory. The state is the path of the socket.
+ */
+int crinitNotiservTestGroupSetup(void **state);
+/**
+ * Group cleanup function, removes the socket. The server threads keep running until the process exits.
+ */
+int crinitNotiservTestGroupTeardown(void **state);
+
+/**
+ * Tests that requests on concurrent connections are all answered, also with commands executed by a command worker.
+ */
+void crinitNotiservTestConcurrentSuccess(void **state);
+/**
+ * Tests that pipelined requests on concurrent persistent connections are all answered in order, also beyond the number
+ * of requests the server handles per event and with commands executed by a command worker.
+ */
+void crinitNotiservTestPipelineSuccess(void **state);
+/**
+ * Tests that version 1 requests whose length and string packets arrive separately are answered, as is a version 2
+ * request which arrives after the server has sent the ready-to-receive message.
+ */
+void crinitNotiservTestPartialRead(void **state);
+/**
+ * Tests that responses which do not fit into the socket buffer are sent once the client reads them.
+ */
+void crinitNotiservTestPartialWrite(void **state);
+/**
+ * Tests that the server closes connections closed by the client, also with requests outstanding, and connections
+ * sending invalid requests.
+ */
+void crinitNotiservTestTeardown(void **state);
+/**
+ * Tests that the server pauses accepting connections while it has run out of file descriptors and resumes once a
+ * connection has been closed.
+ */
+void crinitNotiservTestAcceptPause(void **state);
+
+#endif /* __UTEST_NOTISERV_H__ */
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitProcSpawn(), NULL pointer input.
+ */
+
+#include <unistd.h>
+
+#include "common.h"
+#include "procspawn.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-spawn.h"
+
+void crinitProcSpawnTestNullPointerFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char *argv[] = {"/bin/true", NULL};
+    crinitProcSpawnCreds_t creds = {.user = getuid(), .group = getgid(), .cgroupFd = -1};
+    pid_t pid = -1;
+    size_t calls = crinitTestClone3Calls;
+
+    assert_int_equal(crinitProcSpawn(NULL, argv[0], argv, NULL, NULL, 0, &creds), -1);
+    assert_int_equal(crinitProcSpawn(&pid, NULL, argv, NULL, NULL, 0, &creds), -1);
+    assert_int_equal(crinitProcSpawn(&pid, argv[0], NULL, NULL, NULL, 0, &creds), -1);
+    assert_int_equal(crinitProcSpawn(&pid, argv[0], argv, NULL, NULL, 0, NULL), -1);
+    assert_int_equal(crinitProcSpawn(&pid, argv[0], argv, NULL, NULL, 1, &creds), -1);
+    assert_int_equal(crinitTestClone3Calls, calls);
+    assert_int_equal(pid, -1);
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-fallback.c
+ * @brief Unit test for crinitProcSpawn(), fallback to the launcher if clone3() can not be used.
+ */
+
+#include <errno.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "procspawn.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-spawn.h"
+
+/** Some open file descriptor standing in for a cgroup directory, clone3() is mocked whenever it is used. **/
+#define CRINIT_TEST_CGROUP_FD STDIN_FILENO
+
+static char *crinitTestArgv[] = {"/bin/true", NULL};
+
+static void crinitTestSpawnFails(int cgroupFd, int expectedErr, size_t expectedCalls) {
+    crinitProcSpawnCreds_t creds = {.user = getuid(), .group = getgid(), .cgroupFd = cgroupFd};
+    pid_t pid = -1;
+    size_t calls = crinitTestClone3Calls;
+
+    errno = 0;
+    assert_int_equal(crinitProcSpawn(&pid, crinitTestArgv[0], crinitTestArgv, NULL, NULL, 0, &creds), -1);
+    assert_int_equal(errno, expectedErr);
+    assert_int_equal(pid, -1);
+    assert_int_equal(crinitTestClone3Calls, calls + expectedCalls);
+}
+
+static void crinitTestSpawnSucceeds(void) {
+    if (!crinitTestHaveClone3()) {
+        return;
+    }
+
+    crinitProcSpawnCreds_t creds = {.user = getuid(), .group = getgid(), .cgroupFd = -1};
+    pid_t pid = -1;
+    assert_int_equal(crinitProcSpawn(&pid, crinitTestArgv[0], crinitTestArgv, NULL, NULL, 0, &creds), 0);
+    assert_int_equal(waitpid(pid, NULL, 0), pid);
+}
+
+void crinitProcSpawnTestFallbackNoCgroupV2(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    // The launcher may still be able to use a cgroup v1 directory, so the caller is told to fall back.
+    crinitTestClone3Err = EBADF;
+    crinitTestSpawnFails(CRINIT_TEST_CGROUP_FD, ENOSYS, 1);
+    // Which is not remembered, the next task may use a cgroup v2 directory.
+    crinitTestSpawnFails(CRINIT_TEST_CGROUP_FD, ENOSYS, 1);
+    crinitTestClone3Err = 0;
+    crinitTestSpawnSucceeds();
+}
+
+void crinitProcSpawnTestCloneFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    // Without a cgroup, EINVAL and EBADF do not mean missing kernel support either.
+    crinitTestClone3Err = EAGAIN;
+    crinitTestSpawnFails(-1, EAGAIN, 1);
+    crinitTestClone3Err = EINVAL;
+    crinitTestSpawnFails(-1, EINVAL, 1);
+    crinitTestClone3Err = EBADF;
+    crinitTestSpawnFails(-1, EBADF, 1);
+    crinitTestClone3Err = 0;
+    crinitTestSpawnSucceeds();
+}
+
+void crinitProcSpawnTestFallbackNoCloneIntoCgroup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTestClone3Err = EINVAL;
+    crinitTestSpawnFails(CRINIT_TEST_CGROUP_FD, ENOSYS, 1);
+    // Remembered, clone3() is not tried again for tasks with a cgroup.
+    crinitTestSpawnFails(CRINIT_TEST_CGROUP_FD, ENOSYS, 0);
+    // Tasks without a cgroup can still use clone3().
+    crinitTestClone3Err = 0;
+    crinitTestSpawnSucceeds();
+}
+
+void crinitProcSpawnTestFallbackNoClone3(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTestClone3Err = ENOSYS;
+    crinitTestSpawnFails(-1, ENOSYS, 1);
+    // Remembered, clone3() is not tried again for any task.
+    crinitTestClone3Err = 0;
+    crinitTestSpawnFails(-1, ENOSYS, 0);
+    crinitTestSpawnFails(CRINIT_TEST_CGROUP_FD, ENOSYS, 0);
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-step-failure.c
+ * @brief Unit test for crinitProcSpawn(), failures in the child reported through the error pipe.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "procspawn.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-spawn.h"
+
+void crinitProcSpawnTestStepFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    if (!crinitTestHaveClone3()) {
+        skip();
+    }
+
+    char *argv[] = {"/bin/true", NULL};
+    crinitProcSpawnCreds_t creds = {.user = getuid(), .group = getgid(), .cgroupFd = -1};
+    pid_t pid = -1;
+
+    // The input of the process can not be opened.
+    char missingPath[] = "/nonexistent/crinit-utest";
+    crinitIoRedir_t redir = {.oldFd = -1, .newFd = STDIN_FILENO, .path = missingPath, .oflags = O_RDONLY, .mode = 0};
+    crinitTestLastErrMsg[0] = '\0';
+    errno = 0;
+    assert_int_equal(crinitProcSpawn(&pid, argv[0], argv, NULL, &redir, 1, &creds), -1);
+    assert_int_equal(errno, ENOENT);
+    assert_int_equal(pid, -1);
+    assert_non_null(strstr(crinitTestLastErrMsg, "could not apply IO redirections"));
+
+    // The command does not exist.
+    char *missingArgv[] = {missingPath, NULL};
+    crinitTestLastErrMsg[0] = '\0';
+    errno = 0;
+    assert_int_equal(crinitProcSpawn(&pid, missingArgv[0], missingArgv, NULL, NULL, 0, &creds), -1);
+    assert_int_equal(errno, ENOENT);
+    assert_int_equal(pid, -1);
+    assert_non_null(strstr(crinitTestLastErrMsg, "could not execute command"));
+
+    // The child has been reaped in both cases.
+    errno = 0;
+    assert_int_equal(waitpid(-1, NULL, WNOHANG), -1);
+    assert_int_equal(errno, ECHILD);
+}
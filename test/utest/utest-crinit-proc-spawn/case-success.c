@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitProcSpawn(), successful execution.
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "procspawn.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-spawn.h"
+
+void crinitProcSpawnTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    if (!crinitTestHaveClone3()) {
+        skip();
+    }
+
+    char *argv[] = {"/bin/sh", "-c", "exit 3", NULL};
+    crinitProcSpawnCreds_t creds = {.user = getuid(), .group = getgid(), .cgroupFd = -1};
+    pid_t pid = -1;
+    size_t calls = crinitTestClone3Calls;
+
+    assert_int_equal(crinitProcSpawn(&pid, argv[0], argv, NULL, NULL, 0, &creds), 0);
+    assert_true(pid > 0);
+    assert_int_equal(crinitTestClone3Calls, calls + 1);
+
+    int status;
+    assert_int_equal(waitpid(pid, &status, 0), pid);
+    assert_true(WIFEXITED(status));
+    assert_int_equal(WEXITSTATUS(status), 3);
+}
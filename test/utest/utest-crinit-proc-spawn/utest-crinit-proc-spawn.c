@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-proc-spawn.c
+ * @brief Implementation of the unit tests for crinitProcSpawn().
+ */
+
+#include "utest-crinit-proc-spawn.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+
+#include "common.h"
+#include "unit_test.h"
+
+#ifndef SYS_clone3
+#define SYS_clone3 435  ///< Syscall number of clone3(), missing from older kernel headers.
+#endif
+
+int crinitTestClone3Err = 0;
+size_t crinitTestClone3Calls = 0;
+char crinitTestLastErrMsg[256] = "";
+
+// Rationale: Naming scheme fixed due to linker wrapping.
+// NOLINTBEGIN(readability-identifier-naming)
+long __real_syscall(long number, ...);
+long __wrap_syscall(long number, ...);
+void __wrap_crinitErrnoPrintFFL(const char *file, const char *func, int line, const char *format, ...);
+// NOLINTEND(readability-identifier-naming)
+
+// Rationale: Naming scheme fixed due to linker wrapping.
+// NOLINTNEXTLINE(readability-identifier-naming)
+long __wrap_syscall(long number, ...) {
+    if (number == SYS_clone3) {
+        crinitTestClone3Calls++;
+        if (crinitTestClone3Err != 0) {
+            errno = crinitTestClone3Err;
+            return -1;
+        }
+    }
+#ifdef SYS_setresuid32
+    if (number == SYS_setgroups32 || number == SYS_setresgid32 || number == SYS_setresuid32) {
+        return 0;
+    }
+#endif
+    if (number == SYS_setgroups || number == SYS_setresgid || number == SYS_setresuid) {
+        return 0;
+    }
+
+    // No system call used by crinitProcSpawn() takes more than six arguments.
+    va_list args;
+    va_start(args, number);
+    long a[6];
+    for (size_t i = 0; i < ARRAY_SIZE(a); i++) {
+        a[i] = va_arg(args, long);
+    }
+    va_end(args);
+    return __real_syscall(number, a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+// Rationale: Naming scheme fixed due to linker wrapping.
+// NOLINTNEXTLINE(readability-identifier-naming)
+void __wrap_crinitErrnoPrintFFL(const char *file, const char *func, int line, const char *format, ...) {
+    CRINIT_PARAM_UNUSED(file);
+    CRINIT_PARAM_UNUSED(func);
+    CRINIT_PARAM_UNUSED(line);
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(crinitTestLastErrMsg, sizeof(crinitTestLastErrMsg), format, args);
+    va_end(args);
+}
+
+bool crinitTestHaveClone3(void) {
+    // A supported clone3() rejects the missing argument struct with EINVAL.
+    errno = 0;
+    return __real_syscall(SYS_clone3, NULL, 0) == -1 && errno != ENOSYS;
+}
+
+/**
+ * Runs the unit test group for crinitProcSpawn() using the cmocka API.
+ *
+ * The order matters, the fallback tests leave crinitProcSpawn() believing that the kernel lacks support.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitProcSpawnTestSuccess),
+        cmocka_unit_test(crinitProcSpawnTestStepFailure),
+        cmocka_unit_test(crinitProcSpawnTestNullPointerFailure),
+        cmocka_unit_test(crinitProcSpawnTestFallbackNoCgroupV2),
+        cmocka_unit_test(crinitProcSpawnTestCloneFailure),
+        cmocka_unit_test(crinitProcSpawnTestFallbackNoCloneIntoCgroup),
+        cmocka_unit_test(crinitProcSpawnTestFallbackNoClone3),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
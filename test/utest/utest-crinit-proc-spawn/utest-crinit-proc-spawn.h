@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-proc-spawn.h
+ * @brief Header declaring the unit tests for crinitProcSpawn().
+ */
+#ifndef __UTEST_PROC_SPAWN_H__
+#define __UTEST_PROC_SPAWN_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Error to let clone3() fail with, 0 to call the genuine clone3().
+ *
+ * Calls to setgroups(), setresgid(), and setresuid() always succeed without doing anything, so that the tests do not
+ * need privileges. All other system calls are forwarded.
+ */
+extern int crinitTestClone3Err;
+/** Number of calls to clone3() since the start of the test program. **/
+extern size_t crinitTestClone3Calls;
+/** The message of the last call to crinitErrnoPrint(), formatted. **/
+extern char crinitTestLastErrMsg[256];
+
+/**
+ * Checks if the kernel supports clone3(), tests which spawn real processes are skipped otherwise.
+ */
+bool crinitTestHaveClone3(void);
+
+/**
+ * Tests that a process is spawned and executes the given command.
+ */
+void crinitProcSpawnTestSuccess(void **state);
+/**
+ * Tests that failures during the setup of the child are reported with the failed step and the errno of the child.
+ */
+void crinitProcSpawnTestStepFailure(void **state);
+/**
+ * Tests that crinitProcSpawn() fails with ENOSYS for EBADF from clone3() with a cgroup, without remembering it.
+ */
+void crinitProcSpawnTestFallbackNoCgroupV2(void **state);
+/**
+ * Tests that other errors from clone3() are passed on instead of falling back to the launcher.
+ */
+void crinitProcSpawnTestCloneFailure(void **state);
+/**
+ * Tests that crinitProcSpawn() fails with ENOSYS for EINVAL from clone3() with a cgroup and remembers that
+ * `CLONE_INTO_CGROUP` is unsupported.
+ */
+void crinitProcSpawnTestFallbackNoCloneIntoCgroup(void **state);
+/**
+ * Tests that crinitProcSpawn() fails with ENOSYS if clone3() is unsupported and remembers it.
+ */
+void crinitProcSpawnTestFallbackNoClone3(void **state);
+/**
+ * Tests NULL pointer handling.
+ */
+void crinitProcSpawnTestNullPointerFailure(void **state);
+
+#endif /* __UTEST_PROC_SPAWN_H__ */
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitProcSupWatchFd(), failed execution.
+ */
+
+#include <errno.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "procsup.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-sup-watch-fd.h"
+
+/**
+ * Does nothing, only used as a non-NULL callback.
+ */
+static void crinitTestCallback(int fd, void *arg) {
+    CRINIT_PARAM_UNUSED(fd);
+    CRINIT_PARAM_UNUSED(arg);
+}
+
+void crinitProcSupWatchFdTestFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+    int p[2];
+    assert_int_equal(pipe(p), 0);
+
+    errno = 0;
+    assert_int_equal(crinitProcSupWatchFd(p[0], NULL, NULL), -1);
+    assert_int_equal(errno, EINVAL);
+    errno = 0;
+    assert_int_equal(crinitProcSupWatchFd(-1, crinitTestCallback, NULL), -1);
+    assert_int_equal(errno, EINVAL);
+
+    errno = 0;
+    assert_int_equal(crinitProcSupUnwatchFd(p[0]), -1);
+    assert_int_equal(errno, ENOENT);
+
+    close(p[0]);
+    close(p[1]);
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitProcSupWatchFd(), successful execution.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "procsup.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-sup-watch-fd.h"
+
+#define CRINIT_TEST_NUM_PIPES 8  ///< Number of pipes watched at the same time.
+
+/** Results reported to crinitTestCallback(). **/
+typedef struct crinitTestResults {
+    pthread_mutex_t lock;                   ///< Protects all other members.
+    pthread_cond_t changed;                 ///< Signalled whenever a callback has run.
+    size_t numRead;                         ///< Total number of bytes read by the callbacks.
+    size_t bytesRead[CRINIT_TEST_NUM_PIPES];  ///< Number of bytes read from each pipe.
+} crinitTestResults_t;
+
+static crinitTestResults_t crinitTestRes = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, {0}};
+
+/**
+ * Drains the non-blocking pipe \a fd and records the number of bytes read, the pipe's index is passed as the argument.
+ */
+static void crinitTestCallback(int fd, void *arg) {
+    size_t idx = (size_t)arg;
+    char buf[16];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        pthread_mutex_lock(&crinitTestRes.lock);
+        crinitTestRes.bytesRead[idx] += (size_t)n;
+        crinitTestRes.numRead += (size_t)n;
+        pthread_cond_broadcast(&crinitTestRes.changed);
+        pthread_mutex_unlock(&crinitTestRes.lock);
+    }
+}
+
+/**
+ * Wait until the callbacks have read \a num bytes in total.
+ */
+static void crinitTestWaitRead(size_t num) {
+    pthread_mutex_lock(&crinitTestRes.lock);
+    while (crinitTestRes.numRead < num) {
+        pthread_cond_wait(&crinitTestRes.changed, &crinitTestRes.lock);
+    }
+    pthread_mutex_unlock(&crinitTestRes.lock);
+}
+
+void crinitProcSupWatchFdTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+    int p[CRINIT_TEST_NUM_PIPES][2];
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_PIPES; i++) {
+        assert_int_equal(pipe(p[i]), 0);
+        assert_int_equal(fcntl(p[i][0], F_SETFL, O_NONBLOCK), 0);
+        if (crinitProcSupWatchFd(p[i][0], crinitTestCallback, (void *)i) == -1 && errno == ENOSYS) {
+            for (size_t j = 0; j <= i; j++) {
+                close(p[j][0]);
+                close(p[j][1]);
+            }
+            skip();
+        }
+    }
+
+    // Each pipe gets as many bytes as its index plus one.
+    size_t total = 0;
+    for (size_t i = 0; i < CRINIT_TEST_NUM_PIPES; i++) {
+        for (size_t j = 0; j <= i; j++) {
+            assert_int_equal(write(p[i][1], "x", 1), 1);
+            total++;
+        }
+    }
+    crinitTestWaitRead(total);
+    for (size_t i = 0; i < CRINIT_TEST_NUM_PIPES; i++) {
+        assert_int_equal(crinitTestRes.bytesRead[i], i + 1);
+    }
+
+    // Once unwatched, data written to the first pipe stays there while the others are still served.
+    assert_int_equal(crinitProcSupUnwatchFd(p[0][0]), 0);
+    assert_int_equal(write(p[0][1], "y", 1), 1);
+    assert_int_equal(write(p[1][1], "y", 1), 1);
+    crinitTestWaitRead(total + 1);
+    assert_int_equal(crinitTestRes.bytesRead[0], 1);
+    assert_int_equal(crinitTestRes.bytesRead[1], 3);
+    char c;
+    assert_int_equal(read(p[0][0], &c, 1), 1);
+    assert_int_equal(c, 'y');
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_PIPES; i++) {
+        if (i > 0) {
+            assert_int_equal(crinitProcSupUnwatchFd(p[i][0]), 0);
+        }
+        close(p[i][0]);
+        close(p[i][1]);
+    }
+}
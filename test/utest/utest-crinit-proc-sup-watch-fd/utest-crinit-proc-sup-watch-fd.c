@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-proc-sup-watch-fd.c
+ * @brief Implementation of the unit tests for crinitProcSupWatchFd().
+ */
+
+#include "utest-crinit-proc-sup-watch-fd.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitProcSupWatchFd() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(crinitProcSupWatchFdTestSuccess),
+                                       cmocka_unit_test(crinitProcSupWatchFdTestFailure)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
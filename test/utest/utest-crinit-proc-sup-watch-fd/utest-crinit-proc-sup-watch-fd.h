@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-proc-sup-watch-fd.h
+ * @brief Header declaring the unit tests for crinitProcSupWatchFd().
+ */
+#ifndef __UTEST_PROC_SUP_WATCH_FD_H__
+#define __UTEST_PROC_SUP_WATCH_FD_H__
+
+/**
+ * Tests that the callback runs for each readable file descriptor and never after crinitProcSupUnwatchFd() has returned.
+ */
+void crinitProcSupWatchFdTestSuccess(void **state);
+/**
+ * Tests handling of a NULL callback, an invalid file descriptor, and unwatching a file descriptor which is not watched.
+ */
+void crinitProcSupWatchFdTestFailure(void **state);
+
+#endif /* __UTEST_PROC_SUP_WATCH_FD_H__ */
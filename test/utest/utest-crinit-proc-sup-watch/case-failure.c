@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitProcSupWatch(), failure execution.
+ */
+
+#include <errno.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "procsup.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-sup-watch.h"
+
+static void crinitTestCallback(pid_t pid, const siginfo_t *status, void *arg) {
+    CRINIT_PARAM_UNUSED(pid);
+    CRINIT_PARAM_UNUSED(status);
+    CRINIT_PARAM_UNUSED(arg);
+}
+
+void crinitProcSupWatchTestFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(crinitProcSupWatch(getpid(), NULL, NULL), -1);
+    assert_int_equal(errno, EINVAL);
+
+    // A child which has already been reaped can not be watched anymore.
+    pid_t pid = fork();
+    assert_true(pid != -1);
+    if (pid == 0) {
+        _exit(0);
+    }
+    assert_int_equal(waitpid(pid, NULL, 0), pid);
+    assert_int_equal(crinitProcSupWatch(pid, crinitTestCallback, NULL), -1);
+    assert_true(errno == ESRCH || errno == ENOSYS);
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitProcSupWatch(), successful execution.
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "procsup.h"
+#include "unit_test.h"
+#include "utest-crinit-proc-sup-watch.h"
+
+#define CRINIT_TEST_NUM_CHILDREN 64  ///< Number of child processes watched at the same time.
+
+/** Results reported to crinitTestCallback(). **/
+typedef struct crinitTestResults {
+    pthread_mutex_t lock;                     ///< Protects all other members.
+    pthread_cond_t changed;                   ///< Signalled whenever a callback has run.
+    size_t numDone;                           ///< Number of callbacks run.
+    int exitCode[CRINIT_TEST_NUM_CHILDREN];   ///< Exit code of each child, -1 if not reported yet.
+} crinitTestResults_t;
+
+static crinitTestResults_t crinitTestRes = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, {0}};
+
+/**
+ * Records the exit code of a child and reaps it, the child's index is passed as the argument.
+ */
+static void crinitTestCallback(pid_t pid, const siginfo_t *status, void *arg) {
+    size_t idx = (size_t)arg;
+    pthread_mutex_lock(&crinitTestRes.lock);
+    crinitTestRes.exitCode[idx] = (status != NULL && status->si_code == CLD_EXITED) ? status->si_status : 255;
+    crinitTestRes.numDone++;
+    pthread_cond_broadcast(&crinitTestRes.changed);
+    pthread_mutex_unlock(&crinitTestRes.lock);
+    waitpid(pid, NULL, 0);
+}
+
+/**
+ * Count the threads of the calling process.
+ */
+static size_t crinitTestCountThreads(void) {
+    size_t n = 0;
+    DIR *d = opendir("/proc/self/task");
+    assert_non_null(d);
+    for (struct dirent *e = readdir(d); e != NULL; e = readdir(d)) {
+        if (e->d_name[0] != '.') {
+            n++;
+        }
+    }
+    closedir(d);
+    return n;
+}
+
+/**
+ * Fork a child which waits until the write end of the pipe \a gate is closed and then exits with \a code.
+ */
+static pid_t crinitTestForkChild(const int gate[2], int code) {
+    pid_t pid = fork();
+    assert_true(pid != -1);
+    if (pid == 0) {
+        char c;
+        close(gate[1]);
+        while (read(gate[0], &c, 1) > 0) {
+        }
+        _exit(code);
+    }
+    return pid;
+}
+
+void crinitProcSupWatchTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+    int gate[2];
+    pid_t pids[CRINIT_TEST_NUM_CHILDREN];
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_CHILDREN; i++) {
+        crinitTestRes.exitCode[i] = -1;
+    }
+    assert_int_equal(pipe(gate), 0);
+
+    // The first child starts the supervisor thread.
+    pids[0] = crinitTestForkChild(gate, 0);
+    if (crinitProcSupWatch(pids[0], crinitTestCallback, (void *)0) == -1 && errno == ENOSYS) {
+        close(gate[1]);
+        close(gate[0]);
+        waitpid(pids[0], NULL, 0);
+        skip();
+    }
+    size_t numThreads = crinitTestCountThreads();
+
+    for (size_t i = 1; i < CRINIT_TEST_NUM_CHILDREN; i++) {
+        pids[i] = crinitTestForkChild(gate, (int)(i % 8));
+        assert_int_equal(crinitProcSupWatch(pids[i], crinitTestCallback, (void *)i), 0);
+    }
+    // All children are running, but no thread has been added for them.
+    assert_int_equal(crinitTestCountThreads(), numThreads);
+    pthread_mutex_lock(&crinitTestRes.lock);
+    assert_int_equal(crinitTestRes.numDone, 0);
+    pthread_mutex_unlock(&crinitTestRes.lock);
+
+    close(gate[0]);
+    close(gate[1]);
+    pthread_mutex_lock(&crinitTestRes.lock);
+    while (crinitTestRes.numDone < CRINIT_TEST_NUM_CHILDREN) {
+        pthread_cond_wait(&crinitTestRes.changed, &crinitTestRes.lock);
+    }
+    pthread_mutex_unlock(&crinitTestRes.lock);
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_CHILDREN; i++) {
+        assert_int_equal(crinitTestRes.exitCode[i], i % 8);
+    }
+    // All children have been reaped by the callback.
+    assert_int_equal(waitpid(-1, NULL, WNOHANG), -1);
+    assert_int_equal(errno, ECHILD);
+}
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-proc-sup-watch.c
+ * @brief Implementation of the unit tests for crinitProcSupWatch().
+ */
+
+#include "utest-crinit-proc-sup-watch.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitProcSupWatch() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(crinitProcSupWatchTestSuccess),
+                                       cmocka_unit_test(crinitProcSupWatchTestFailure)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
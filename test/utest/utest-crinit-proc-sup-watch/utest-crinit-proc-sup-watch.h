@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-proc-sup-watch.h
+ * @brief Header declaring the unit tests for crinitProcSupWatch().
+ */
+#ifndef __UTEST_PROC_SUP_WATCH_H__
+#define __UTEST_PROC_SUP_WATCH_H__
+
+/**
+ * Tests that callbacks report the exit status of all watched children and that the number of threads stays constant.
+ */
+void crinitProcSupWatchTestSuccess(void **state);
+/**
+ * Tests handling of a NULL callback and of processes which do not exist.
+ */
+void crinitProcSupWatchTestFailure(void **state);
+
+#endif /* __UTEST_PROC_SUP_WATCH_H__ */
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-arg-read.c
+ * @brief Unit test for crinitRtimArgBinRead(), reading valid and invalid arguments.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-rtim-cmd-bin.h"
+
+/** Size of the buffers holding the encoded arguments. **/
+#define CRINIT_TEST_BUF_SIZE 64
+
+void crinitRtimCmdBinTestArgReadSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    uint8_t buf[CRINIT_TEST_BUF_SIZE];
+    const int64_t num = -42;
+    const uint64_t unum = UINT64_MAX;
+    const int64_t time[2] = {12, 999999999};
+    size_t len = crinitTestPutArg(buf, CRINIT_RTIMARG_TYPE_STR, 3, "abc", 3);
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_STR, 0, NULL, 0);
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_INT, sizeof(num), &num, sizeof(num));
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_UINT, sizeof(unum), &unum, sizeof(unum));
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_TIME, sizeof(time), time, sizeof(time));
+    const uint8_t *runner = buf, *end = buf + len;
+
+    // A string is not copied and not null-terminated.
+    crinitRtimArg_t a;
+    size_t strLen = 0;
+    assert_int_equal(crinitRtimArgBinRead(&a, &strLen, &runner, end), 0);
+    assert_int_equal(a.type, CRINIT_RTIMARG_TYPE_STR);
+    assert_ptr_equal(a.str, buf + CRINIT_TEST_ARG_HDR_SIZE);
+    assert_int_equal(strLen, 3);
+    assert_ptr_equal(runner, buf + CRINIT_TEST_ARG_HDR_SIZE + 3);
+
+    assert_int_equal(crinitRtimArgBinRead(&a, &strLen, &runner, end), 0);
+    assert_int_equal(a.type, CRINIT_RTIMARG_TYPE_STR);
+    assert_int_equal(strLen, 0);
+
+    assert_int_equal(crinitRtimArgBinRead(&a, &strLen, &runner, end), 0);
+    assert_int_equal(a.type, CRINIT_RTIMARG_TYPE_INT);
+    assert_true(a.num == num);
+
+    assert_int_equal(crinitRtimArgBinRead(&a, &strLen, &runner, end), 0);
+    assert_int_equal(a.type, CRINIT_RTIMARG_TYPE_UINT);
+    assert_true(a.unum == unum);
+
+    assert_int_equal(crinitRtimArgBinRead(&a, &strLen, &runner, end), 0);
+    assert_int_equal(a.type, CRINIT_RTIMARG_TYPE_TIME);
+    assert_int_equal(a.time.tv_sec, 12);
+    assert_int_equal(a.time.tv_nsec, 999999999);
+    assert_ptr_equal(runner, end);
+}
+
+void crinitRtimCmdBinTestArgReadFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    uint8_t buf[CRINIT_TEST_BUF_SIZE];
+    const int64_t val[2] = {1, 2};
+    const int64_t nsecNeg[2] = {1, -1}, nsecHigh[2] = {1, 1000000000};
+    const struct {
+        uint8_t type;
+        uint32_t size;
+        const void *val;
+        size_t valLen;
+    } invalid[] = {
+        // Value larger than the rest of the message, also with a size which would overflow a pointer.
+        {CRINIT_RTIMARG_TYPE_STR, 10, "abc", 3},
+        {CRINIT_RTIMARG_TYPE_STR, UINT32_MAX, "abc", 3},
+        {CRINIT_RTIMARG_TYPE_INT, sizeof(int64_t), val, sizeof(int64_t) - 1},
+        // Embedded null byte.
+        {CRINIT_RTIMARG_TYPE_STR, 3, "a\0b", 3},
+        {CRINIT_RTIMARG_TYPE_STR, 1, "", 1},
+        // Unknown type tags.
+        {0, sizeof(int64_t), val, sizeof(int64_t)},
+        {CRINIT_RTIMARG_TYPE_TIME + 1, sizeof(int64_t), val, sizeof(int64_t)},
+        {UINT8_MAX, 0, NULL, 0},
+        // Value size not matching a numerical type.
+        {CRINIT_RTIMARG_TYPE_INT, sizeof(int32_t), val, sizeof(int32_t)},
+        {CRINIT_RTIMARG_TYPE_UINT, 2 * sizeof(int64_t), val, 2 * sizeof(int64_t)},
+        {CRINIT_RTIMARG_TYPE_TIME, sizeof(int64_t), val, sizeof(int64_t)},
+        // Nanoseconds outside of [0, 1000000000).
+        {CRINIT_RTIMARG_TYPE_TIME, sizeof(nsecNeg), nsecNeg, sizeof(nsecNeg)},
+        {CRINIT_RTIMARG_TYPE_TIME, sizeof(nsecHigh), nsecHigh, sizeof(nsecHigh)},
+    };
+
+    crinitRtimArg_t a;
+    size_t strLen = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        size_t len = crinitTestPutArg(buf, invalid[i].type, invalid[i].size, invalid[i].val, invalid[i].valLen);
+        const uint8_t *runner = buf;
+        assert_int_equal(crinitRtimArgBinRead(&a, &strLen, &runner, buf + len), -1);
+        assert_ptr_equal(runner, buf);
+    }
+
+    // Message ending inside the argument header.
+    size_t len = crinitTestPutArg(buf, CRINIT_RTIMARG_TYPE_STR, 0, NULL, 0);
+    for (size_t i = 0; i < len; i++) {
+        const uint8_t *runner = buf;
+        assert_int_equal(crinitRtimArgBinRead(&a, &strLen, &runner, buf + i), -1);
+        assert_ptr_equal(runner, buf);
+    }
+}
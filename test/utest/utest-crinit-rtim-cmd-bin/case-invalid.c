@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-invalid.c
+ * @brief Unit test for crinitParseRtimCmdBin(), messages with invalid content.
+ */
+
+#include <limits.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-rtim-cmd-bin.h"
+
+/** Size of the buffer holding the encoded message. **/
+#define CRINIT_TEST_BUF_SIZE 64
+
+void crinitRtimCmdBinTestInvalid(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    uint8_t buf[CRINIT_TEST_BUF_SIZE];
+    const uint64_t unum = 1;
+    crinitRtimCmd_t out;
+    size_t len;
+
+    // The valid message the invalid ones are derived from.
+    len = crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, 2);
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_STR, 4, "task", 4);
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_UINT, sizeof(unum), &unum, sizeof(unum));
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), 0);
+    assert_int_equal(out.argc, 2);
+    assert_string_equal(out.args[0].str, "task");
+    crinitDestroyRtimCmd(&out);
+
+    // Trailing Bytes, including a whole argument not accounted for by the number of arguments.
+    buf[len] = 0;
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len + 1), -1);
+    crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, 1);
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+
+    // More arguments than the message holds, the number is not trusted for the allocation.
+    crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, 3);
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+    crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, UINT32_MAX);
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+
+    // Unknown opcodes.
+    crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_R_STATUSLIST + 1, 2);
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+    crinitTestPutMsgHdr(buf, (uint32_t)INT_MAX + 1, 2);
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+
+    // An argument larger than the rest of the message.
+    len = crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, 1);
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_STR, 5, "task", 4);
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+
+    // A string with an embedded null byte.
+    len = crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, 1);
+    len += crinitTestPutArg(buf + len, CRINIT_RTIMARG_TYPE_STR, 4, "ta\0k", 4);
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+
+    // Unknown type tags.
+    for (unsigned int type = CRINIT_RTIMARG_TYPE_TIME + 1; type <= UINT8_MAX; type++) {
+        len = crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, 1);
+        len += crinitTestPutArg(buf + len, (uint8_t)type, sizeof(unum), &unum, sizeof(unum));
+        assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+    }
+    len = crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_STATUS, 1);
+    len += crinitTestPutArg(buf + len, 0, sizeof(unum), &unum, sizeof(unum));
+    assert_int_equal(crinitParseRtimCmdBin(&out, buf, len), -1);
+}
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-null-param.c
+ * @brief Unit test for crinitRtimCmdToMsgBin() and crinitParseRtimCmdBin(), NULL pointers and invalid arguments.
+ */
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-rtim-cmd-bin.h"
+
+void crinitRtimCmdBinTestNullParam(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitRtimCmd_t cmd, out;
+    void *msg = NULL;
+    size_t msgLen = 0;
+    uint8_t buf[CRINIT_TEST_MSG_HDR_SIZE];
+    crinitTestPutMsgHdr(buf, CRINIT_RTIMCMD_C_GETVER, 0);
+
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_GETVER, 0), 0);
+    assert_int_equal(crinitRtimCmdToMsgBin(NULL, &msgLen, &cmd), -1);
+    assert_int_equal(crinitRtimCmdToMsgBin(&msg, NULL, &cmd), -1);
+    assert_int_equal(crinitRtimCmdToMsgBin(&msg, &msgLen, NULL), -1);
+    assert_null(msg);
+    crinitDestroyRtimCmd(&cmd);
+
+    assert_int_equal(crinitParseRtimCmdBin(NULL, buf, sizeof(buf)), -1);
+    assert_int_equal(crinitParseRtimCmdBin(&out, NULL, sizeof(buf)), -1);
+
+    // An argument of invalid type is not encoded.
+    crinitRtimArg_t args[] = {CRINIT_RTIMARG_UINT(1)};
+    assert_int_equal(crinitBuildRtimCmdArgs(&cmd, CRINIT_RTIMCMD_R_STATUS, ARRAY_SIZE(args), args), 0);
+    cmd.args[0].type = (crinitRtimArgType_t)0;
+    assert_int_equal(crinitRtimCmdToMsgBin(&msg, &msgLen, &cmd), -1);
+    assert_null(msg);
+    crinitDestroyRtimCmd(&cmd);
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-roundtrip.c
+ * @brief Unit test for crinitRtimCmdToMsgBin() and crinitParseRtimCmdBin(), encoding and decoding of valid commands.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-rtim-cmd-bin.h"
+
+void crinitRtimCmdBinTestRoundTrip(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const crinitRtimArg_t args[] = {
+        CRINIT_RTIMARG_STR("RES_OK"),
+        CRINIT_RTIMARG_STR(""),
+        CRINIT_RTIMARG_STR("line1\nline2"),
+        CRINIT_RTIMARG_INT(INT64_MIN),
+        CRINIT_RTIMARG_INT(-1),
+        CRINIT_RTIMARG_UINT(UINT64_MAX),
+        CRINIT_RTIMARG_TIME(((struct timespec){.tv_sec = 1700000000, .tv_nsec = 999999999})),
+        CRINIT_RTIMARG_TIME(((struct timespec){.tv_sec = -5, .tv_nsec = 0})),
+    };
+    const size_t valSize = strlen("RES_OK") + strlen("line1\nline2") + 3 * sizeof(int64_t) + 4 * sizeof(int64_t);
+    crinitRtimCmd_t cmd, out;
+    assert_int_equal(crinitBuildRtimCmdArgs(&cmd, CRINIT_RTIMCMD_R_STATUS, ARRAY_SIZE(args), args), 0);
+
+    void *msg = NULL;
+    size_t msgLen = 0;
+    assert_int_equal(crinitRtimCmdToMsgBin(&msg, &msgLen, &cmd), 0);
+    assert_int_equal(msgLen, CRINIT_TEST_MSG_HDR_SIZE + ARRAY_SIZE(args) * CRINIT_TEST_ARG_HDR_SIZE + valSize);
+
+    assert_int_equal(crinitParseRtimCmdBin(&out, msg, msgLen), 0);
+    free(msg);
+    assert_int_equal(out.op, CRINIT_RTIMCMD_R_STATUS);
+    assert_int_equal(out.argc, ARRAY_SIZE(args));
+    for (size_t i = 0; i < ARRAY_SIZE(args); i++) {
+        assert_int_equal(out.args[i].type, args[i].type);
+        switch (args[i].type) {
+            case CRINIT_RTIMARG_TYPE_STR:
+                assert_string_equal(out.args[i].str, args[i].str);
+                break;
+            case CRINIT_RTIMARG_TYPE_INT:
+                assert_true(out.args[i].num == args[i].num);
+                break;
+            case CRINIT_RTIMARG_TYPE_UINT:
+                assert_true(out.args[i].unum == args[i].unum);
+                break;
+            case CRINIT_RTIMARG_TYPE_TIME:
+                assert_true(out.args[i].time.tv_sec == args[i].time.tv_sec);
+                assert_int_equal(out.args[i].time.tv_nsec, args[i].time.tv_nsec);
+                break;
+        }
+    }
+    crinitDestroyRtimCmd(&out);
+    crinitDestroyRtimCmd(&cmd);
+
+    // A command without arguments consists of the header only.
+    assert_int_equal(crinitBuildRtimCmd(&cmd, CRINIT_RTIMCMD_C_GETVER, 0), 0);
+    assert_int_equal(crinitRtimCmdToMsgBin(&msg, &msgLen, &cmd), 0);
+    assert_int_equal(msgLen, CRINIT_TEST_MSG_HDR_SIZE);
+    assert_int_equal(crinitParseRtimCmdBin(&out, msg, msgLen), 0);
+    free(msg);
+    assert_int_equal(out.op, CRINIT_RTIMCMD_C_GETVER);
+    assert_int_equal(out.argc, 0);
+    crinitDestroyRtimCmd(&out);
+    crinitDestroyRtimCmd(&cmd);
+}
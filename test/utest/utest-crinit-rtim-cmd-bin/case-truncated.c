@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-truncated.c
+ * @brief Unit test for crinitParseRtimCmdBin(), messages ending inside a header or a value.
+ */
+
+#include <stdlib.h>
+
+#include "common.h"
+#include "unit_test.h"
+#include "utest-crinit-rtim-cmd-bin.h"
+
+void crinitRtimCmdBinTestTruncated(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const crinitRtimArg_t args[] = {
+        CRINIT_RTIMARG_STR("RES_OK"),
+        CRINIT_RTIMARG_UINT(7),
+        CRINIT_RTIMARG_TIME(((struct timespec){.tv_sec = 1, .tv_nsec = 2})),
+    };
+    crinitRtimCmd_t cmd, out;
+    assert_int_equal(crinitBuildRtimCmdArgs(&cmd, CRINIT_RTIMCMD_R_STATUS, ARRAY_SIZE(args), args), 0);
+    void *msg = NULL;
+    size_t msgLen = 0;
+    assert_int_equal(crinitRtimCmdToMsgBin(&msg, &msgLen, &cmd), 0);
+    crinitDestroyRtimCmd(&cmd);
+
+    // Every prefix of the message ends inside the message header, an argument header, or a value.
+    for (size_t len = 0; len < msgLen; len++) {
+        assert_int_equal(crinitParseRtimCmdBin(&out, msg, len), -1);
+    }
+    assert_int_equal(crinitParseRtimCmdBin(&out, msg, msgLen), 0);
+    crinitDestroyRtimCmd(&out);
+    free(msg);
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-rtim-cmd-bin.c
+ * @brief Implementation of the unit tests for the binary encoding of runtime commands.
+ */
+
+#include "utest-crinit-rtim-cmd-bin.h"
+
+#include <string.h>
+
+#include "unit_test.h"
+
+size_t crinitTestPutMsgHdr(uint8_t *buf, uint32_t op, uint32_t argc) {
+    memcpy(buf, &op, sizeof(op));
+    memcpy(buf + sizeof(op), &argc, sizeof(argc));
+    return CRINIT_TEST_MSG_HDR_SIZE;
+}
+
+size_t crinitTestPutArg(uint8_t *buf, uint8_t type, uint32_t size, const void *val, size_t valLen) {
+    buf[0] = type;
+    memcpy(buf + sizeof(type), &size, sizeof(size));
+    if (valLen > 0) {
+        memcpy(buf + CRINIT_TEST_ARG_HDR_SIZE, val, valLen);
+    }
+    return CRINIT_TEST_ARG_HDR_SIZE + valLen;
+}
+
+/**
+ * Runs the unit test group for the binary encoding of runtime commands using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(crinitRtimCmdBinTestRoundTrip),
+        cmocka_unit_test(crinitRtimCmdBinTestArgReadSuccess),
+        cmocka_unit_test(crinitRtimCmdBinTestArgReadFailure),
+        cmocka_unit_test(crinitRtimCmdBinTestTruncated),
+        cmocka_unit_test(crinitRtimCmdBinTestInvalid),
+        cmocka_unit_test(crinitRtimCmdBinTestNullParam),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
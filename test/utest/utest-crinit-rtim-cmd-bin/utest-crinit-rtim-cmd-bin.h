@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-rtim-cmd-bin.h
+ * @brief Header declaring the unit tests for the binary encoding of runtime commands.
+ */
+#ifndef __UTEST_RTIM_CMD_BIN_H__
+#define __UTEST_RTIM_CMD_BIN_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtimcmd.h"
+
+/** Size of the header of a message in the binary encoding, see crinitRtimCmdToMsgBin(). **/
+#define CRINIT_TEST_MSG_HDR_SIZE (2 * sizeof(uint32_t))
+/** Size of the header of an argument in the binary encoding, see crinitRtimCmdToMsgBin(). **/
+#define CRINIT_TEST_ARG_HDR_SIZE (sizeof(uint8_t) + sizeof(uint32_t))
+
+/**
+ * Internal function under test, not part of a header.
+ */
+int crinitRtimArgBinRead(crinitRtimArg_t *a, size_t *strLen, const uint8_t **runner, const uint8_t *end);
+
+/**
+ * Write the header of a message in the binary encoding.
+ *
+ * @param buf   Where to write the header.
+ * @param op    The opcode.
+ * @param argc  The number of arguments.
+ *
+ * @return  The number of Bytes written.
+ */
+size_t crinitTestPutMsgHdr(uint8_t *buf, uint32_t op, uint32_t argc);
+/**
+ * Write an argument in the binary encoding.
+ *
+ * @param buf     Where to write the argument.
+ * @param type    The type tag of the argument.
+ * @param size    The size of the value as written to the argument header.
+ * @param val     The value.
+ * @param valLen  The number of Bytes of \a val to write, independent of \a size.
+ *
+ * @return  The number of Bytes written.
+ */
+size_t crinitTestPutArg(uint8_t *buf, uint8_t type, uint32_t size, const void *val, size_t valLen);
+
+/**
+ * Tests that commands with arguments of each type keep their values through crinitRtimCmdToMsgBin() and
+ * crinitParseRtimCmdBin().
+ */
+void crinitRtimCmdBinTestRoundTrip(void **state);
+/**
+ * Tests that crinitRtimArgBinRead() reads valid arguments and advances behind them.
+ */
+void crinitRtimCmdBinTestArgReadSuccess(void **state);
+/**
+ * Tests that crinitRtimArgBinRead() rejects invalid arguments and leaves the position untouched.
+ */
+void crinitRtimCmdBinTestArgReadFailure(void **state);
+/**
+ * Tests that crinitParseRtimCmdBin() rejects messages which end inside a header or a value.
+ */
+void crinitRtimCmdBinTestTruncated(void **state);
+/**
+ * Tests that crinitParseRtimCmdBin() rejects messages with invalid content.
+ */
+void crinitRtimCmdBinTestInvalid(void **state);
+/**
+ * Tests the handling of NULL pointers and invalid arguments by crinitRtimCmdToMsgBin() and crinitParseRtimCmdBin().
+ */
+void crinitRtimCmdBinTestNullParam(void **state);
+
+#endif /* __UTEST_RTIM_CMD_BIN_H__ */
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-cache.c
+ * @brief Unit test for crinitSpawnPlanGet(), caching of the plan in the configuration snapshot.
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-spawn-plan.h"
+
+/** The plan type is private to the Process Dispatcher, the tests only compare references. **/
+struct crinitSpawnPlan;
+struct crinitSpawnPlan *crinitSpawnPlanGet(crinitTaskCfg_t *cfg);
+
+/** Snapshot of a task spawned directly. **/
+static crinitTaskCfg_t *crinitPlainCfg = NULL;
+/** Snapshot of a task spawned using crinit-launch. **/
+static crinitTaskCfg_t *crinitLauncherCfg = NULL;
+
+static crinitTaskCfg_t *crinitCreateTestCfg(const char *name, const char *user) {
+    crinitConfKvList_t userKv = {.next = NULL, .key = "USER", .val = (char *)user};
+    crinitConfKvList_t cmdKv = {.next = (user != NULL) ? &userKv : NULL, .key = "COMMAND", .val = "/bin/true"};
+    crinitConfKvList_t nameKv = {.next = &cmdKv, .key = "NAME", .val = (char *)name};
+
+    crinitTask_t *t = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &nameKv), 0);
+    crinitTaskCfg_t *cfg = crinitTaskCfgCreate(t);
+    assert_non_null(cfg);
+    crinitFreeTask(t);
+    return cfg;
+}
+
+static void crinitPlanRelease(struct crinitSpawnPlan *plan) {
+    // The common header is the first member of the plan.
+    crinitSpawnPlanRelease((crinitSpawnPlanHdr_t *)plan);
+}
+
+int crinitSpawnPlanTestSetup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    crinitPlainCfg = crinitCreateTestCfg("plain", NULL);
+    crinitLauncherCfg = crinitCreateTestCfg("launched", "nobody");
+
+    return 0;
+}
+
+int crinitSpawnPlanTestTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskCfgRelease(crinitPlainCfg);
+    crinitTaskCfgRelease(crinitLauncherCfg);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+void crinitSpawnPlanTestReuseSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskCfg_t *cfgs[] = {crinitPlainCfg, crinitLauncherCfg};
+    for (size_t i = 0; i < ARRAY_SIZE(cfgs); i++) {
+        assert_null(cfgs[i]->spawnPlan);
+
+        unsigned long long gen = crinitGlobOptGetGeneration();
+        struct crinitSpawnPlan *first = crinitSpawnPlanGet(cfgs[i]);
+        assert_non_null(first);
+        assert_ptr_equal(cfgs[i]->spawnPlan, first);
+
+        // Same generation, the snapshot hands out its cached plan again.
+        struct crinitSpawnPlan *second = crinitSpawnPlanGet(cfgs[i]);
+        assert_ptr_equal(second, first);
+        assert_ptr_equal(cfgs[i]->spawnPlan, first);
+        assert_int_equal(crinitGlobOptGetGeneration(), gen);
+
+        // The snapshot and both callers hold a reference each.
+        assert_int_equal(atomic_load(&cfgs[i]->spawnPlan->refs), 3);
+        crinitPlanRelease(second);
+        crinitPlanRelease(first);
+        assert_int_equal(atomic_load(&cfgs[i]->spawnPlan->refs), 1);
+    }
+}
+
+void crinitSpawnPlanTestRebuildSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskCfg_t *cfgs[] = {crinitPlainCfg, crinitLauncherCfg};
+    for (size_t i = 0; i < ARRAY_SIZE(cfgs); i++) {
+        struct crinitSpawnPlan *old = crinitSpawnPlanGet(cfgs[i]);
+        assert_non_null(old);
+
+        // Any change of the global options, e.g. a different crinit-launch, starts a new generation.
+        unsigned long long gen = crinitGlobOptGetGeneration();
+        assert_int_equal(crinitGlobOptSet(CRINIT_GLOBOPT_LAUNCHER_CMD, (i == 0) ? "/sbin/launch-a" : "/sbin/launch-b"),
+                         0);
+        assert_true(crinitGlobOptGetGeneration() > gen);
+
+        // The old plan is still referenced here, so a new plan can not share its address.
+        struct crinitSpawnPlan *rebuilt = crinitSpawnPlanGet(cfgs[i]);
+        assert_non_null(rebuilt);
+        assert_ptr_not_equal(rebuilt, old);
+        assert_ptr_equal(cfgs[i]->spawnPlan, rebuilt);
+
+        // The snapshot has dropped its reference to the old plan.
+        assert_int_equal(atomic_load(&((crinitSpawnPlanHdr_t *)old)->refs), 1);
+        crinitPlanRelease(old);
+
+        // And the rebuilt plan is cached for the new generation.
+        struct crinitSpawnPlan *again = crinitSpawnPlanGet(cfgs[i]);
+        assert_ptr_equal(again, rebuilt);
+        crinitPlanRelease(again);
+        crinitPlanRelease(rebuilt);
+        assert_int_equal(atomic_load(&cfgs[i]->spawnPlan->refs), 1);
+    }
+}
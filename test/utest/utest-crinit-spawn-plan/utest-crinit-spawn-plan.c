@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-spawn-plan.c
+ * @brief Implementation of the unit tests for crinitSpawnPlanGet().
+ */
+
+#include "utest-crinit-spawn-plan.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitSpawnPlanGet() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitSpawnPlanTestReuseSuccess, crinitSpawnPlanTestSetup,
+                                        crinitSpawnPlanTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitSpawnPlanTestRebuildSuccess, crinitSpawnPlanTestSetup,
+                                        crinitSpawnPlanTestTeardown),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-spawn-plan.h
+ * @brief Header declaring the unit tests for crinitSpawnPlanGet().
+ */
+#ifndef __UTEST_SPAWN_PLAN_H__
+#define __UTEST_SPAWN_PLAN_H__
+
+/**
+ * Setup function, initializes the global options and creates configuration snapshots of two tasks.
+ */
+int crinitSpawnPlanTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitSpawnPlanTestTeardown(void **state);
+
+/**
+ * Tests that the plan cached in a snapshot is reused as long as the global options are unchanged.
+ */
+void crinitSpawnPlanTestReuseSuccess(void **state);
+/**
+ * Tests that the plan is rebuilt and replaces the cached one once the global options have changed.
+ */
+void crinitSpawnPlanTestRebuildSuccess(void **state);
+#endif /* __UTEST_SPAWN_PLAN_H__ */
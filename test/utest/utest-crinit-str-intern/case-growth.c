@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-growth.c
+ * @brief Unit test for the string intern table, growing and shrinking the table.
+ */
+
+#include <stdio.h>
+
+#include "common.h"
+#include "strintern.h"
+#include "unit_test.h"
+#include "utest-crinit-str-intern.h"
+
+#define CRINIT_TEST_NUM_STRINGS 5000  ///< Number of distinct strings to intern, enough for several rounds of growth.
+
+void crinitStrInternTestGrowth(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    static const char *interned[CRINIT_TEST_NUM_STRINGS];
+    char buf[32];
+    size_t count = crinitStrInternCount();
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_STRINGS; i++) {
+        snprintf(buf, sizeof(buf), "task-%zu", i);
+        interned[i] = crinitStrIntern(buf);
+        assert_non_null(interned[i]);
+        assert_string_equal(interned[i], buf);
+    }
+    assert_int_equal(crinitStrInternCount(), count + CRINIT_TEST_NUM_STRINGS);
+
+    // Release every third string, the others must still be found at their original addresses afterwards.
+    for (size_t i = 0; i < CRINIT_TEST_NUM_STRINGS; i += 3) {
+        crinitStrInternRelease(interned[i]);
+        interned[i] = NULL;
+    }
+    for (size_t i = 0; i < CRINIT_TEST_NUM_STRINGS; i++) {
+        snprintf(buf, sizeof(buf), "task-%zu", i);
+        assert_ptr_equal(crinitStrInternFind(buf), interned[i]);
+    }
+
+    // Re-interning must reuse the remaining entries and recreate the released ones.
+    for (size_t i = 0; i < CRINIT_TEST_NUM_STRINGS; i++) {
+        snprintf(buf, sizeof(buf), "task-%zu", i);
+        const char *s = crinitStrIntern(buf);
+        assert_non_null(s);
+        if (interned[i] != NULL) {
+            assert_ptr_equal(s, interned[i]);
+            crinitStrInternRelease(s);
+        } else {
+            interned[i] = s;
+        }
+    }
+    assert_int_equal(crinitStrInternCount(), count + CRINIT_TEST_NUM_STRINGS);
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_STRINGS; i++) {
+        crinitStrInternRelease(interned[i]);
+    }
+    assert_int_equal(crinitStrInternCount(), count);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-null-input.c
+ * @brief Unit test for the string intern table, NULL pointer input.
+ */
+
+#include "common.h"
+#include "strintern.h"
+#include "unit_test.h"
+#include "utest-crinit-str-intern.h"
+
+void crinitStrInternTestNullInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    size_t count = crinitStrInternCount();
+    assert_null(crinitStrIntern(NULL));
+    assert_null(crinitStrInternFind(NULL));
+    assert_null(crinitStrInternRef(NULL));
+    crinitStrInternRelease(NULL);
+    assert_int_equal(crinitStrInternCount(), count);
+}
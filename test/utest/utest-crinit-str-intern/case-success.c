@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for the string intern table, successful execution.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "strintern.h"
+#include "unit_test.h"
+#include "utest-crinit-str-intern.h"
+
+void crinitStrInternTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char buf[] = "network-dhcp";
+    size_t count = crinitStrInternCount();
+
+    const char *a = crinitStrIntern("network-dhcp");
+    assert_non_null(a);
+    assert_string_equal(a, "network-dhcp");
+    assert_int_equal(crinitStrInternCount(), count + 1);
+
+    // A lexicographically equal string from a different buffer must yield the same pointer and no new entry.
+    const char *b = crinitStrIntern(buf);
+    assert_ptr_equal(a, b);
+    assert_ptr_not_equal(b, buf);
+    assert_int_equal(crinitStrInternCount(), count + 1);
+
+    // Changing the original buffer must not affect the interned copy.
+    buf[0] = 'N';
+    assert_string_equal(a, "network-dhcp");
+    assert_null(crinitStrInternFind(buf));
+    assert_ptr_equal(crinitStrInternFind("network-dhcp"), a);
+
+    const char *c = crinitStrIntern("wait");
+    assert_non_null(c);
+    assert_ptr_not_equal(a, c);
+    assert_int_equal(crinitStrInternCount(), count + 2);
+
+    assert_ptr_equal(crinitStrInternRef(a), a);
+    assert_null(crinitStrInternRef(NULL));
+
+    // Three references to "network-dhcp" are held now, so it must survive the first two releases.
+    crinitStrInternRelease(a);
+    crinitStrInternRelease(b);
+    assert_ptr_equal(crinitStrInternFind("network-dhcp"), a);
+    assert_int_equal(crinitStrInternCount(), count + 2);
+    crinitStrInternRelease(a);
+    assert_null(crinitStrInternFind("network-dhcp"));
+    assert_int_equal(crinitStrInternCount(), count + 1);
+
+    // Find must not have taken a reference.
+    assert_ptr_equal(crinitStrInternFind("wait"), c);
+    crinitStrInternRelease(c);
+    assert_null(crinitStrInternFind("wait"));
+    assert_int_equal(crinitStrInternCount(), count);
+
+    crinitStrInternRelease(NULL);
+    assert_int_equal(crinitStrInternCount(), count);
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-str-intern.c
+ * @brief Implementation of the unit tests for the string intern table.
+ */
+
+#include "utest-crinit-str-intern.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for the string intern table using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(crinitStrInternTestSuccess),
+                                       cmocka_unit_test(crinitStrInternTestGrowth),
+                                       cmocka_unit_test(crinitStrInternTestNullInput)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
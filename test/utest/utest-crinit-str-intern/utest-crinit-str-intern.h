@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-str-intern.h
+ * @brief Header declaring the unit tests for the string intern table.
+ */
+#ifndef __UTEST_STR_INTERN_H__
+#define __UTEST_STR_INTERN_H__
+
+/**
+ * Tests that equal strings map to the same pointer and that entries live exactly as long as they are referenced.
+ */
+void crinitStrInternTestSuccess(void **state);
+/**
+ * Tests that all strings stay reachable while the table grows and while entries are removed from it in between.
+ */
+void crinitStrInternTestGrowth(void **state);
+/**
+ * Tests NULL pointer handling.
+ */
+void crinitStrInternTestNullInput(void **state);
+
+#endif /* __UTEST_STR_INTERN_H__ */
@@ -15,7 +15,7 @@
 
 static crinitRtimCmd_t *crinitBuildRtimArgCmd;
 static crinitRtimCmd_t *crinitXferArgRes;
-static char *crinitXferArgResOKArgs[1] = {CRINIT_RTIMCMD_RES_OK};
+static crinitRtimArg_t crinitXferArgResOKArgs[1] = {CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK)};
 static crinitRtimCmd_t crinitXferArgResWrongCmd = {
     .op = CRINIT_RTIMCMD_R_ENABLE, .argc = 1, .args = crinitXferArgResOKArgs};
 static struct crinitStoreRtimCmdArgs crinitXferArgResContext = {
@@ -15,7 +15,7 @@
 
 static crinitRtimCmd_t *crinitBuildRtimArgCmd;
 static crinitRtimCmd_t *crinitXferArgRes;
-static char *crinitXferArgResErrArgs[1] = {CRINIT_RTIMCMD_RES_ERR};
+static crinitRtimArg_t crinitXferArgResErrArgs[1] = {CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_ERR)};
 static crinitRtimCmd_t crinitXferArgResErr = {
     .op = CRINIT_RTIMCMD_R_ADDTASK, .argc = 1, .args = crinitXferArgResErrArgs};
 static struct crinitStoreRtimCmdArgs crinitXferArgResContext = {
@@ -14,7 +14,7 @@
 
 static crinitRtimCmd_t *crinitBuildRtimArgCmd;
 static crinitRtimCmd_t *crinitXferArgRes;
-static char *crinitXferArgResOKArgs[1] = {CRINIT_RTIMCMD_RES_OK};
+static crinitRtimArg_t crinitXferArgResOKArgs[1] = {CRINIT_RTIMARG_STR(CRINIT_RTIMCMD_RES_OK)};
 static crinitRtimCmd_t crinitXferArgResOK = {.op = CRINIT_RTIMCMD_R_ADDTASK, .argc = 1, .args = crinitXferArgResOKArgs};
 static struct crinitStoreRtimCmdArgs crinitXferArgResContext = {
     &crinitXferArgRes,
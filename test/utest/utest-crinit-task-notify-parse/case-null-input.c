@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-null-input.c
+ * @brief Unit test for crinitTaskNotifyParse(), NULL inputs.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-task-notify-parse.h"
+
+void crinitTaskNotifyParseTestNullInput(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const char *s = "READY=1";
+    crinitTaskNotify_t n = CRINIT_TASK_NOTIFY_INIT;
+    crinitTaskNotifyParse(NULL, s, strlen(s));
+    crinitTaskNotifyParse(&n, NULL, 0);
+    assert_int_equal(n.mainPid, -1);
+    assert_false(n.ready);
+    assert_false(n.stopping);
+    assert_null(n.status);
+}
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskNotifyParse(), successful execution.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "task.h"
+#include "unit_test.h"
+#include "utest-crinit-task-notify-parse.h"
+
+void crinitTaskNotifyParseTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const char *all = "STATUS=Listening on port 80\nREADY=1\nMAINPID=42\nSTOPPING=1";
+    crinitTaskNotify_t n = CRINIT_TASK_NOTIFY_INIT;
+    crinitTaskNotifyParse(&n, all, strlen(all));
+    assert_int_equal(n.mainPid, 42);
+    assert_true(n.ready);
+    assert_true(n.stopping);
+    assert_int_equal(n.statusLen, strlen("Listening on port 80"));
+    assert_memory_equal(n.status, "Listening on port 80", n.statusLen);
+
+    // Unknown commands, keys only sharing a prefix, lines without a value, and invalid values are ignored.
+    const char *ignored = "WATCHDOG=1\nREADYX=1\nMAINPIDS=7\nREADY\nREADY=0\nMAINPID=-5\nMAINPID=abc\n\n";
+    n = (crinitTaskNotify_t)CRINIT_TASK_NOTIFY_INIT;
+    crinitTaskNotifyParse(&n, ignored, strlen(ignored));
+    assert_int_equal(n.mainPid, -1);
+    assert_false(n.ready);
+    assert_false(n.stopping);
+    assert_null(n.status);
+
+    // Only the given length is parsed, as a packet read from the readiness pipe is not null-terminated.
+    const char buf[] = {'M', 'A', 'I', 'N', 'P', 'I', 'D', '=', '1', '2', '3', '4', '5'};
+    n = (crinitTaskNotify_t)CRINIT_TASK_NOTIFY_INIT;
+    crinitTaskNotifyParse(&n, buf, 10);
+    assert_int_equal(n.mainPid, 12);
+    assert_false(n.ready);
+}
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-task-notify-parse.c
+ * @brief Implementation of the unit tests for crinitTaskNotifyParse().
+ */
+
+#include "utest-crinit-task-notify-parse.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitTaskNotifyParse() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {cmocka_unit_test(crinitTaskNotifyParseTestSuccess),
+                                       cmocka_unit_test(crinitTaskNotifyParseTestNullInput)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
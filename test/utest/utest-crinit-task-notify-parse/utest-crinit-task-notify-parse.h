@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-task-notify-parse.h
+ * @brief Header declaring the unit tests for crinitTaskNotifyParse().
+ */
+#ifndef __UTEST_TASK_NOTIFY_PARSE_H__
+#define __UTEST_TASK_NOTIFY_PARSE_H__
+
+/**
+ * Tests parsing of all supported commands, unknown and malformed lines, and state strings without a terminating null
+ * byte.
+ */
+void crinitTaskNotifyParseTestSuccess(void **state);
+/**
+ * Tests that NULL inputs are handled gracefully.
+ */
+void crinitTaskNotifyParseTestNullInput(void **state);
+
+#endif /* __UTEST_TASK_NOTIFY_PARSE_H__ */
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBAddTaskUsage(), failure execution.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-add-task-usage.h"
+
+static crinitTask_t *crinitTgt = NULL;
+static crinitTaskDB_t crinitCtx;
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+static void crinitSetupTaskDB(void) {
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskCreateFromConfKvList(&crinitTgt, &name), 0);
+    assert_non_null(crinitTgt);
+
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNullSpawnFunc, CRINIT_TASKDB_INITIAL_SIZE), 0);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, crinitTgt, true), 0);
+}
+
+void crinitTaskDBAddTaskUsageTestCtxNullPointerFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    struct rusage ru = {0};
+    assert_int_equal(crinitTaskDBAddTaskUsage(NULL, &ru, "TEST"), -1);
+}
+
+void crinitTaskDBAddTaskUsageTestArgNullPointerFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitSetupTaskDB();
+
+    struct rusage ru = {0};
+    assert_int_equal(crinitTaskDBAddTaskUsage(&crinitCtx, NULL, "TEST"), -1);
+    assert_int_equal(crinitTaskDBAddTaskUsage(&crinitCtx, &ru, NULL), -1);
+}
+
+void crinitTaskDBAddTaskUsageTestTaskNotFoundFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitSetupTaskDB();
+
+    struct rusage ru = {0};
+    assert_int_equal(crinitTaskDBAddTaskUsage(&crinitCtx, &ru, "fooBar"), -1);
+}
+
+int crinitTaskDBAddTaskUsageTestFailureTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitDestroyTask(crinitTgt);
+    free(crinitTgt);
+    crinitGlobOptDestroy();
+    crinitTaskDBDestroy(&crinitCtx);
+
+    return 0;
+}
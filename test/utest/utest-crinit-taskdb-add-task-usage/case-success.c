@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBAddTaskUsage(), successful execution.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-add-task-usage.h"
+
+static crinitTask_t *crinitTgt = NULL;
+static crinitTaskDB_t crinitCtx;
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+void crinitTaskDBAddTaskUsageTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskCreateFromConfKvList(&crinitTgt, &name), 0);
+    assert_non_null(crinitTgt);
+
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNullSpawnFunc, CRINIT_TASKDB_INITIAL_SIZE), 0);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, crinitTgt, true), 0);
+
+    struct rusage ru1 = {.ru_utime = {.tv_sec = 1, .tv_usec = 500000},
+                         .ru_stime = {.tv_sec = 0, .tv_usec = 250000},
+                         .ru_maxrss = 2048,
+                         .ru_nvcsw = 3,
+                         .ru_nivcsw = 1};
+    struct rusage ru2 = {.ru_utime = {.tv_sec = 0, .tv_usec = 600000},
+                         .ru_stime = {.tv_sec = 2, .tv_usec = 0},
+                         .ru_maxrss = 1024,
+                         .ru_nvcsw = 7,
+                         .ru_nivcsw = 4};
+    assert_int_equal(crinitTaskDBAddTaskUsage(&crinitCtx, &ru1, "TEST"), 0);
+    assert_int_equal(crinitTaskDBAddTaskUsage(&crinitCtx, &ru2, "TEST"), 0);
+
+    crinitTaskDBStatus_t status;
+    assert_int_equal(crinitTaskDBGetTaskStatus(&crinitCtx, &status, "TEST"), 0);
+    assert_int_equal(status.usage.userTime, 2100000);
+    assert_int_equal(status.usage.sysTime, 2250000);
+    assert_int_equal(status.usage.maxRss, 2048);
+    assert_int_equal(status.usage.volCtxSw, 10);
+    assert_int_equal(status.usage.involCtxSw, 5);
+    assert_int_equal(status.usage.numProcs, 2);
+    assert_int_equal(status.usage.lastRuntime, 0);
+    free(status.username);
+    free(status.groupname);
+}
+
+int crinitTaskDBAddTaskUsageTestSuccessTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitDestroyTask(crinitTgt);
+    free(crinitTgt);
+    crinitGlobOptDestroy();
+    crinitTaskDBDestroy(&crinitCtx);
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-add-task-usage.c
+ * @brief Implementation of the crinitTaskDBAddTaskUsage() unit test group.
+ */
+
+#include "utest-crinit-taskdb-add-task-usage.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitTaskDBAddTaskUsage() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_teardown(crinitTaskDBAddTaskUsageTestSuccess, crinitTaskDBAddTaskUsageTestSuccessTeardown),
+        cmocka_unit_test(crinitTaskDBAddTaskUsageTestCtxNullPointerFailure),
+        cmocka_unit_test_teardown(crinitTaskDBAddTaskUsageTestArgNullPointerFailure,
+                                  crinitTaskDBAddTaskUsageTestFailureTeardown),
+        cmocka_unit_test_teardown(crinitTaskDBAddTaskUsageTestTaskNotFoundFailure,
+                                  crinitTaskDBAddTaskUsageTestFailureTeardown)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
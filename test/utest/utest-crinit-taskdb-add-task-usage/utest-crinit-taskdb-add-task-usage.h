@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-add-task-usage.h
+ * @brief Header declaring the unit tests for crinitTaskDBAddTaskUsage().
+ */
+#ifndef __UTEST_TASKDB_ADD_TASK_USAGE_H__
+#define __UTEST_TASKDB_ADD_TASK_USAGE_H__
+
+/**
+ * Cleanup function
+ */
+int crinitTaskDBAddTaskUsageTestSuccessTeardown(void **state);
+
+/**
+ * Cleanup function
+ */
+int crinitTaskDBAddTaskUsageTestFailureTeardown(void **state);
+
+/**
+ * Tests successful accumulation of the resource usage of two processes.
+ */
+void crinitTaskDBAddTaskUsageTestSuccess(void **state);
+/**
+ * Tests NULL pointer handling on ctx parameter.
+ */
+void crinitTaskDBAddTaskUsageTestCtxNullPointerFailure(void **state);
+/**
+ * Tests NULL pointer handling on ru and taskName.
+ */
+void crinitTaskDBAddTaskUsageTestArgNullPointerFailure(void **state);
+/**
+ * Tests error case "task not found"
+ */
+void crinitTaskDBAddTaskUsageTestTaskNotFoundFailure(void **state);
+
+#endif /* __UTEST_TASKDB_ADD_TASK_USAGE_H__ */
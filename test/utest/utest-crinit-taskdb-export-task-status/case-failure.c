@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBExportTaskStatus(), failure execution.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-export-task-status.h"
+
+void crinitTaskDBExportTaskStatusTestFailure(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskDBStatus_t *tasks;
+    size_t numTasks;
+
+    assert_int_equal(crinitTaskDBExportTaskStatus(NULL, &tasks, &numTasks, NULL), -1);
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, NULL, &numTasks, NULL), -1);
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, &tasks, NULL, NULL), -1);
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBExportTaskStatus(), successful execution.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-export-task-status.h"
+
+const char *crinitTestTaskNames[CRINIT_TEST_NUM_TASKS] = {"task-0", "task-1", "task-2", "task-3", "svc-0", "svc-1"};
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+int crinitTaskDBExportTaskStatusTestSetup(void **state) {
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = NULL, .next = &cmd};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    crinitTaskDB_t *ctx = malloc(sizeof(*ctx));
+    assert_non_null(ctx);
+    assert_int_equal(crinitTaskDBInitWithSize(ctx, crinitNullSpawnFunc, 1), 0);
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        crinitTask_t *t = NULL;
+        name.val = (char *)crinitTestTaskNames[i];
+        assert_int_equal(crinitTaskCreateFromConfKvList(&t, &name), 0);
+        assert_non_null(t);
+        if (i == 0) {
+            t->user = 65534;
+            t->group = 65534;
+            t->username = strdup("nobody");
+            t->groupname = strdup("nogroup");
+            assert_non_null(t->username);
+            assert_non_null(t->groupname);
+        }
+        assert_int_equal(crinitTaskDBInsert(ctx, t, false), 0);
+        crinitFreeTask(t);
+    }
+
+    *state = ctx;
+    return 0;
+}
+
+int crinitTaskDBExportTaskStatusTestTeardown(void **state) {
+    crinitTaskDB_t *ctx = *state;
+
+    crinitTaskDBDestroy(ctx);
+    free(ctx);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+void crinitTaskDBExportTaskStatusTestSuccess(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskDBStatus_t *tasks;
+    size_t numTasks;
+
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, &tasks, &numTasks, NULL), 0);
+    assert_int_equal(numTasks, CRINIT_TEST_NUM_TASKS);
+    for (size_t i = 0; i < numTasks; i++) {
+        assert_string_equal(tasks[i].name, crinitTestTaskNames[i]);
+        assert_int_equal(tasks[i].state, CRINIT_TASK_STATE_LOADED);
+        assert_int_equal(tasks[i].failCount, 0);
+    }
+    assert_int_equal(tasks[0].user, 65534);
+    assert_string_equal(tasks[0].username, "nobody");
+    assert_string_equal(tasks[0].groupname, "nogroup");
+    assert_null(tasks[1].username);
+    assert_null(tasks[1].groupname);
+    free(tasks);
+
+    crinitTaskListFilter_t filter = {.stateMask = CRINIT_TASKLIST_FILTER_LOADED};
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, &tasks, &numTasks, &filter), 0);
+    assert_int_equal(numTasks, CRINIT_TEST_NUM_TASKS);
+    free(tasks);
+
+    filter.stateMask = CRINIT_TASK_STATE_RUNNING;
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, &tasks, &numTasks, &filter), 0);
+    assert_int_equal(numTasks, 0);
+    assert_null(tasks);
+
+    assert_int_equal(crinitTaskDBSpawnReady(ctx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitTaskDBSetTaskPID(ctx, 42, "svc-1"), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_RUNNING, "svc-1"), 0);
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, &tasks, &numTasks, &filter), 0);
+    assert_int_equal(numTasks, 1);
+    assert_string_equal(tasks[0].name, "svc-1");
+    assert_int_equal(tasks[0].pid, 42);
+    free(tasks);
+
+    filter = (crinitTaskListFilter_t){.stateMask = CRINIT_TASK_STATE_STARTING | CRINIT_TASK_STATE_RUNNING,
+                                      .prefix = "svc-"};
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, &tasks, &numTasks, &filter), 0);
+    assert_int_equal(numTasks, 2);
+    assert_string_equal(tasks[0].name, "svc-0");
+    assert_int_equal(tasks[0].state, CRINIT_TASK_STATE_STARTING);
+    assert_string_equal(tasks[1].name, "svc-1");
+    assert_int_equal(tasks[1].state, CRINIT_TASK_STATE_RUNNING);
+    free(tasks);
+
+    const char *names[] = {"svc-1", "no-such-task", "task-0"};
+    filter = (crinitTaskListFilter_t){.numNames = sizeof(names) / sizeof(names[0]), .names = names};
+    assert_int_equal(crinitTaskDBExportTaskStatus(ctx, &tasks, &numTasks, &filter), 0);
+    assert_int_equal(numTasks, 2);
+    assert_string_equal(tasks[0].name, "svc-1");
+    assert_string_equal(tasks[1].name, "task-0");
+    assert_string_equal(tasks[1].username, "nobody");
+    free(tasks);
+}
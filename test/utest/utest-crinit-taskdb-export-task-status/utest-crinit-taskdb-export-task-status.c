@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-export-task-status.c
+ * @brief Implementation of the unit tests for crinitTaskDBExportTaskStatus().
+ */
+
+#include "utest-crinit-taskdb-export-task-status.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitTaskDBExportTaskStatus() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBExportTaskStatusTestSuccess, crinitTaskDBExportTaskStatusTestSetup,
+                                        crinitTaskDBExportTaskStatusTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBExportTaskStatusTestFailure, crinitTaskDBExportTaskStatusTestSetup,
+                                        crinitTaskDBExportTaskStatusTestTeardown)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-export-task-status.h
+ * @brief Header declaring the unit tests for crinitTaskDBExportTaskStatus().
+ */
+#ifndef __UTEST_TASKDB_EXPORT_TASK_STATUS_H__
+#define __UTEST_TASKDB_EXPORT_TASK_STATUS_H__
+
+#define CRINIT_TEST_NUM_TASKS 6  ///< Number of tasks created by the setup function, see crinitTestTaskNames.
+
+/** Names of the tasks created by the setup function, in the order of creation. **/
+extern const char *crinitTestTaskNames[CRINIT_TEST_NUM_TASKS];
+
+/**
+ * Setup function, creates a TaskDB with a few tasks and a spawn function doing nothing.
+ */
+int crinitTaskDBExportTaskStatusTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBExportTaskStatusTestTeardown(void **state);
+
+/**
+ * Tests exporting the status of all tasks and of the tasks selected by state, name prefix, and names.
+ */
+void crinitTaskDBExportTaskStatusTestSuccess(void **state);
+/**
+ * Tests NULL pointer handling.
+ */
+void crinitTaskDBExportTaskStatusTestFailure(void **state);
+
+#endif /* __UTEST_TASKDB_EXPORT_TASK_STATUS_H__ */
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBFulfillDep(), failure execution.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-fulfill-dep.h"
+
+void crinitTaskDBFulfillDepTestNullPointerFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskDB_t ctx;
+    char name[] = "X", event[] = "wait";
+    crinitTaskDep_t dep = {name, event};
+    assert_int_equal(crinitTaskDBFulfillDep(NULL, &dep, NULL), -1);
+    assert_int_equal(crinitTaskDBFulfillDep(&ctx, NULL, NULL), -1);
+}
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBFulfillDep(), successful execution.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-fulfill-dep.h"
+
+static crinitTaskDB_t crinitCtx;
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+static void crinitInsertTestTask(const char *name, const char *depends, const char *trigger) {
+    crinitConfKvList_t trig = {.key = "TRIGGER", .val = (char *)trigger, .next = NULL};
+    crinitConfKvList_t deps = {.key = "DEPENDS", .val = (char *)depends, .next = (trigger != NULL) ? &trig : NULL};
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = (depends != NULL) ? &deps : &trig};
+    crinitConfKvList_t nameKv = {.key = "NAME", .val = (char *)name, .next = &cmd};
+    if (depends == NULL && trigger == NULL) {
+        cmd.next = NULL;
+    }
+
+    crinitTask_t *t = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &nameKv), 0);
+    assert_non_null(t);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, t, false), 0);
+    crinitFreeTask(t);
+}
+
+static size_t crinitGetDepsSize(const char *name) {
+    crinitTask_t *t = crinitTaskDBBorrowTask(&crinitCtx, name);
+    assert_non_null(t);
+    size_t ret = t->depsSize;
+    assert_int_equal(crinitTaskDBRemit(&crinitCtx), 0);
+    return ret;
+}
+
+static bool crinitGetTriggered(const char *name) {
+    crinitTask_t *t = crinitTaskDBBorrowTask(&crinitCtx, name);
+    assert_non_null(t);
+    bool ret = t->triggered;
+    assert_int_equal(crinitTaskDBRemit(&crinitCtx), 0);
+    return ret;
+}
+
+static size_t crinitGetNumWaiters(const char *name, const char *event) {
+    for (size_t i = 0; i < crinitCtx.waitSetItems; i++) {
+        if (strcmp(crinitCtx.waitSet[i].name, name) == 0 && strcmp(crinitCtx.waitSet[i].event, event) == 0) {
+            return crinitCtx.waitSet[i].waitersSize;
+        }
+    }
+    return 0;
+}
+
+int crinitTaskDBFulfillDepTestSetup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    // Start small so that the reverse dependency index needs to grow.
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNullSpawnFunc, 1), 0);
+
+    crinitInsertTestTask("A", "X:wait", NULL);
+    crinitInsertTestTask("B", "X:wait Y:spawn", NULL);
+    crinitInsertTestTask("C", NULL, "X:wait");
+    crinitInsertTestTask("D", NULL, NULL);
+
+    return 0;
+}
+
+int crinitTaskDBFulfillDepTestTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskDBDestroy(&crinitCtx);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+void crinitTaskDBFulfillDepTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(crinitGetNumWaiters("X", "wait"), 3);
+    assert_int_equal(crinitGetNumWaiters("Y", "spawn"), 1);
+    assert_false(crinitGetTriggered("C"));
+
+    char xName[] = "X", xEvent[] = "wait";
+    crinitTaskDep_t xDep = {xName, xEvent};
+    assert_int_equal(crinitTaskDBFulfillDep(&crinitCtx, &xDep, NULL), 0);
+
+    assert_int_equal(crinitGetDepsSize("A"), 0);
+    assert_int_equal(crinitGetDepsSize("B"), 1);
+    assert_true(crinitGetTriggered("C"));
+    // Only the trigger of C is left waiting for X:wait, so it can be rearmed.
+    assert_int_equal(crinitGetNumWaiters("X", "wait"), 1);
+
+    // Fulfilling an event nobody waits for must succeed and change nothing.
+    char zName[] = "Z", zEvent[] = "fail";
+    crinitTaskDep_t zDep = {zName, zEvent};
+    assert_int_equal(crinitTaskDBFulfillDep(&crinitCtx, &zDep, NULL), 0);
+    assert_int_equal(crinitGetDepsSize("B"), 1);
+    assert_int_equal(crinitGetDepsSize("D"), 0);
+}
+
+void crinitTaskDBFulfillDepTestAddRemoveSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char zName[] = "Z", zEvent[] = "fail";
+    crinitTaskDep_t zDep = {zName, zEvent};
+    assert_int_equal(crinitTaskDBAddDepToTask(&crinitCtx, &zDep, "D"), 0);
+    assert_int_equal(crinitTaskDBAddDepToTask(&crinitCtx, &zDep, "A"), 0);
+    assert_int_equal(crinitGetNumWaiters("Z", "fail"), 2);
+    assert_int_equal(crinitGetDepsSize("D"), 1);
+
+    assert_int_equal(crinitTaskDBRemoveDepFromTask(&crinitCtx, &zDep, "A"), 0);
+    assert_int_equal(crinitGetNumWaiters("Z", "fail"), 1);
+    assert_int_equal(crinitGetDepsSize("A"), 1);
+
+    assert_int_equal(crinitTaskDBFulfillDep(&crinitCtx, &zDep, NULL), 0);
+    assert_int_equal(crinitGetDepsSize("D"), 0);
+    assert_int_equal(crinitGetNumWaiters("Z", "fail"), 0);
+
+    // Overwriting a task must replace its index entries.
+    crinitTask_t *t = NULL;
+    crinitConfKvList_t deps = {.key = "DEPENDS", .val = "Y:spawn", .next = NULL};
+    crinitConfKvList_t nameKv = {.key = "NAME", .val = "A", .next = &deps};
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &nameKv), 0);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, t, true), 0);
+    crinitFreeTask(t);
+    assert_int_equal(crinitGetNumWaiters("X", "wait"), 2);
+    assert_int_equal(crinitGetNumWaiters("Y", "spawn"), 2);
+
+    char yName[] = "Y", yEvent[] = "spawn";
+    crinitTaskDep_t yDep = {yName, yEvent};
+    assert_int_equal(crinitTaskDBFulfillDep(&crinitCtx, &yDep, NULL), 0);
+    assert_int_equal(crinitGetDepsSize("A"), 0);
+    assert_int_equal(crinitGetDepsSize("B"), 1);
+    assert_int_equal(crinitGetNumWaiters("Y", "spawn"), 0);
+}
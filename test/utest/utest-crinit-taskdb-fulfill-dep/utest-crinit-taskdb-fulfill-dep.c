@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-fulfill-dep.c
+ * @brief Implementation of the unit tests for crinitTaskDBFulfillDep().
+ */
+
+#include "utest-crinit-taskdb-fulfill-dep.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitTaskDBFulfillDep() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBFulfillDepTestSuccess, crinitTaskDBFulfillDepTestSetup,
+                                        crinitTaskDBFulfillDepTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBFulfillDepTestAddRemoveSuccess, crinitTaskDBFulfillDepTestSetup,
+                                        crinitTaskDBFulfillDepTestTeardown),
+        cmocka_unit_test(crinitTaskDBFulfillDepTestNullPointerFailure)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
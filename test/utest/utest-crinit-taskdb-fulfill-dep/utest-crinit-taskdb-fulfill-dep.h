@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-fulfill-dep.h
+ * @brief Header declaring the unit tests for crinitTaskDBFulfillDep().
+ */
+#ifndef __UTEST_TASKDB_FULFILL_DEP_H__
+#define __UTEST_TASKDB_FULFILL_DEP_H__
+
+/**
+ * Setup function, creates a TaskDB with some interdependent tasks.
+ */
+int crinitTaskDBFulfillDepTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBFulfillDepTestTeardown(void **state);
+
+/**
+ * Tests that fulfilling a dependency reaches exactly the tasks waiting for it via the reverse dependency index.
+ */
+void crinitTaskDBFulfillDepTestSuccess(void **state);
+/**
+ * Tests that the reverse dependency index follows crinitTaskDBAddDepToTask(), crinitTaskDBRemoveDepFromTask() and
+ * overwriting tasks.
+ */
+void crinitTaskDBFulfillDepTestAddRemoveSuccess(void **state);
+/**
+ * Tests NULL pointer handling.
+ */
+void crinitTaskDBFulfillDepTestNullPointerFailure(void **state);
+
+#endif /* __UTEST_TASKDB_FULFILL_DEP_H__ */
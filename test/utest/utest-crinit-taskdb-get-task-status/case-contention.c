@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-contention.c
+ * @brief Unit test/benchmark for crinitTaskDBGetTaskStatus(), checks status queries do not stall task spawning.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-get-task-status.h"
+
+#define CRINIT_TEST_NUM_CYCLES 2000            ///< Number of times each task is spawned and completed per round.
+#define CRINIT_TEST_NUM_ROUNDS 5               ///< Number of timing rounds per scenario, the fastest one counts.
+#define CRINIT_TEST_NUM_READERS 4              ///< Number of threads sending status queries.
+#define CRINIT_TEST_QUERY_INTERVAL_NS 1000000  ///< Pause between two queries of a single reader thread.
+#define CRINIT_TEST_MIN_QUERY_RATE 1000.0      ///< Minimum rate of status queries per second during the benchmark.
+/**
+ * Maximum allowed ratio between the time per spawn with and without concurrent queries. Queries only hold the read
+ * side of crinitTaskDB_t::queryLock for a few copies, so apart from noise on busy test machines there should not be
+ * a measurable difference.
+ */
+#define CRINIT_TEST_MAX_SLOWDOWN 2.0
+
+/** Shared state of the benchmark and the reader threads. **/
+typedef struct crinitTestReaderCtx {
+    crinitTaskDB_t *tdb;        ///< The TaskDB to query.
+    atomic_bool stop;           ///< Set to true to end the reader threads.
+    atomic_size_t numQueries;   ///< Number of queries done so far.
+    atomic_size_t numFailures;  ///< Number of queries which failed or returned inconsistent data.
+} crinitTestReaderCtx_t;
+
+/**
+ * Reader thread, alternates between single task status queries and listing all tasks like crinit-ctl does.
+ */
+static void *crinitTestReader(void *arg) {
+    crinitTestReaderCtx_t *rc = arg;
+    struct timespec interval = {.tv_sec = 0, .tv_nsec = CRINIT_TEST_QUERY_INTERVAL_NS};
+    char taskName[16];
+
+    for (size_t i = 0; !atomic_load(&rc->stop); i++) {
+        crinitTaskDBStatus_t st;
+        snprintf(taskName, sizeof(taskName), "task-%zu", i % CRINIT_TEST_NUM_TASKS);
+        if (crinitTaskDBGetTaskStatus(rc->tdb, &st, taskName) == -1 ||
+            (st.state & ~(CRINIT_TASK_STATE_STARTING | CRINIT_TASK_STATE_RUNNING | CRINIT_TASK_STATE_DONE)) != 0) {
+            atomic_fetch_add(&rc->numFailures, 1);
+        }
+        free(st.username);
+        free(st.groupname);
+
+        if (i % 10 == 0) {
+            char **names = NULL;
+            size_t numNames = 0;
+            if (crinitTaskDBExportTaskNamesToArray(rc->tdb, &names, &numNames) == -1 ||
+                numNames != CRINIT_TEST_NUM_TASKS) {
+                atomic_fetch_add(&rc->numFailures, 1);
+            }
+            for (size_t j = 0; j < numNames; j++) {
+                free(names[j]);
+            }
+            free(names);
+        }
+
+        atomic_fetch_add(&rc->numQueries, 1);
+        nanosleep(&interval, NULL);
+    }
+    return NULL;
+}
+
+/**
+ * Run the spawn loop of the scheduler and the state updates of the dispatch threads for all tasks and return the
+ * fastest average time per spawn in nanoseconds.
+ */
+static double crinitMeasureSpawn(crinitTaskDB_t *ctx) {
+    char taskName[16];
+    double best = -1.0;
+
+    for (size_t r = 0; r < CRINIT_TEST_NUM_ROUNDS; r++) {
+        struct timespec start, end;
+        assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &start), 0);
+        for (size_t c = 0; c < CRINIT_TEST_NUM_CYCLES; c++) {
+            assert_int_equal(crinitTaskDBSpawnReady(ctx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+            for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+                snprintf(taskName, sizeof(taskName), "task-%zu", i);
+                assert_int_equal(crinitTaskDBSetTaskPID(ctx, 1000 + (pid_t)i, taskName), 0);
+                assert_int_equal(crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_RUNNING, taskName), 0);
+                assert_int_equal(crinitTaskDBSetTaskPID(ctx, -1, taskName), 0);
+                // The tasks respawn, so this puts them back into the ready queue.
+                assert_int_equal(crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_DONE, taskName), 0);
+            }
+        }
+        assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &end), 0);
+        double ns = (double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec);
+        ns /= CRINIT_TEST_NUM_CYCLES * CRINIT_TEST_NUM_TASKS;
+        if (best < 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+void crinitTaskDBGetTaskStatusTestContention(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTestReaderCtx_t rc = {.tdb = ctx};
+    pthread_t readers[CRINIT_TEST_NUM_READERS];
+    struct timespec start, end;
+
+    atomic_init(&rc.stop, false);
+    atomic_init(&rc.numQueries, 0);
+    atomic_init(&rc.numFailures, 0);
+
+    double idle = crinitMeasureSpawn(ctx);
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_READERS; i++) {
+        assert_int_equal(pthread_create(&readers[i], NULL, crinitTestReader, &rc), 0);
+    }
+    assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &start), 0);
+    double loaded = crinitMeasureSpawn(ctx);
+    assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &end), 0);
+    size_t numQueries = atomic_load(&rc.numQueries);
+    atomic_store(&rc.stop, true);
+    for (size_t i = 0; i < CRINIT_TEST_NUM_READERS; i++) {
+        assert_int_equal(pthread_join(readers[i], NULL), 0);
+    }
+
+    double secs = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    print_message("Spawn without queries: %.1f ns, with %.0f queries/s: %.1f ns.\n", idle, (double)numQueries / secs,
+                  loaded);
+
+    assert_int_equal(atomic_load(&rc.numFailures), 0);
+    assert_true((double)numQueries / secs >= CRINIT_TEST_MIN_QUERY_RATE);
+    assert_true(loaded <= idle * CRINIT_TEST_MAX_SLOWDOWN);
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBGetTaskStatus(), failure execution.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-get-task-status.h"
+
+void crinitTaskDBGetTaskStatusTestFailure(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskDBStatus_t st;
+
+    assert_int_equal(crinitTaskDBGetTaskStatus(NULL, &st, "task-0"), -1);
+    assert_int_equal(crinitTaskDBGetTaskStatus(ctx, NULL, "task-0"), -1);
+    assert_int_equal(crinitTaskDBGetTaskStatus(ctx, &st, NULL), -1);
+
+    assert_int_equal(crinitTaskDBGetTaskStatus(ctx, &st, "no-such-task"), -1);
+    assert_null(st.username);
+    assert_null(st.groupname);
+}
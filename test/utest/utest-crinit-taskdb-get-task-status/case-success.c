@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBGetTaskStatus(), successful execution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-get-task-status.h"
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+int crinitTaskDBGetTaskStatusTestSetup(void **state) {
+    crinitConfKvList_t resp = {.key = "RESPAWN", .val = "YES", .next = NULL};
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = &resp};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+    char taskName[16];
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    crinitTaskDB_t *ctx = malloc(sizeof(*ctx));
+    assert_non_null(ctx);
+    assert_int_equal(crinitTaskDBInitWithSize(ctx, crinitNullSpawnFunc, 1), 0);
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        crinitTask_t *t = NULL;
+        snprintf(taskName, sizeof(taskName), "task-%zu", i);
+        name.val = taskName;
+        assert_int_equal(crinitTaskCreateFromConfKvList(&t, &name), 0);
+        assert_non_null(t);
+        if (i == 0) {
+            t->user = 65534;
+            t->group = 65534;
+            t->username = strdup("nobody");
+            t->groupname = strdup("nogroup");
+            assert_non_null(t->username);
+            assert_non_null(t->groupname);
+        }
+        assert_int_equal(crinitTaskDBInsert(ctx, t, false), 0);
+        crinitFreeTask(t);
+    }
+
+    *state = ctx;
+    return 0;
+}
+
+int crinitTaskDBGetTaskStatusTestTeardown(void **state) {
+    crinitTaskDB_t *ctx = *state;
+
+    crinitTaskDBDestroy(ctx);
+    free(ctx);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+void crinitTaskDBGetTaskStatusTestSuccess(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskDBStatus_t st;
+
+    assert_int_equal(crinitTaskDBGetTaskStatus(ctx, &st, "task-0"), 0);
+    assert_int_equal(st.state, 0);
+    assert_int_equal(st.user, 65534);
+    assert_int_equal(st.group, 65534);
+    assert_string_equal(st.username, "nobody");
+    assert_string_equal(st.groupname, "nogroup");
+    free(st.username);
+    free(st.groupname);
+
+    assert_int_equal(crinitTaskDBSpawnReady(ctx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitTaskDBGetTaskStatus(ctx, &st, "task-1"), 0);
+    assert_int_equal(st.state, CRINIT_TASK_STATE_STARTING);
+    assert_null(st.username);
+    assert_null(st.groupname);
+
+    assert_int_equal(crinitTaskDBSetTaskPID(ctx, 42, "task-1"), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_RUNNING, "task-1"), 0);
+    assert_int_equal(crinitTaskDBGetTaskStatus(ctx, &st, "task-1"), 0);
+    assert_int_equal(st.state, CRINIT_TASK_STATE_RUNNING);
+    assert_int_equal(st.pid, 42);
+    struct timespec started = st.startTime;
+
+    assert_int_equal(crinitTaskDBSetTaskPID(ctx, -1, "task-1"), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_DONE, "task-1"), 0);
+    assert_int_equal(crinitTaskDBGetTaskStatus(ctx, &st, "task-1"), 0);
+    assert_int_equal(st.state, CRINIT_TASK_STATE_DONE);
+    assert_int_equal(st.pid, -1);
+    assert_int_equal(st.startTime.tv_sec, started.tv_sec);
+    assert_int_equal(st.startTime.tv_nsec, started.tv_nsec);
+    assert_true(st.endTime.tv_sec > started.tv_sec ||
+                (st.endTime.tv_sec == started.tv_sec && st.endTime.tv_nsec >= started.tv_nsec));
+}
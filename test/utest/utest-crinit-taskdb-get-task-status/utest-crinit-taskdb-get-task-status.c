@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-get-task-status.c
+ * @brief Implementation of the unit tests for crinitTaskDBGetTaskStatus().
+ */
+
+#include "utest-crinit-taskdb-get-task-status.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitTaskDBGetTaskStatus() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBGetTaskStatusTestSuccess, crinitTaskDBGetTaskStatusTestSetup,
+                                        crinitTaskDBGetTaskStatusTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBGetTaskStatusTestFailure, crinitTaskDBGetTaskStatusTestSetup,
+                                        crinitTaskDBGetTaskStatusTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBGetTaskStatusTestContention, crinitTaskDBGetTaskStatusTestSetup,
+                                        crinitTaskDBGetTaskStatusTestTeardown)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
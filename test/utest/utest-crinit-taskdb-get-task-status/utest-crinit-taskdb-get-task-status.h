@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-get-task-status.h
+ * @brief Header declaring the unit tests for crinitTaskDBGetTaskStatus().
+ */
+#ifndef __UTEST_TASKDB_GET_TASK_STATUS_H__
+#define __UTEST_TASKDB_GET_TASK_STATUS_H__
+
+#define CRINIT_TEST_NUM_TASKS 8  ///< Number of tasks named task-0, task-1, ... created by the setup function.
+
+/**
+ * Setup function, creates a TaskDB with a few respawning tasks and a spawn function doing nothing.
+ */
+int crinitTaskDBGetTaskStatusTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBGetTaskStatusTestTeardown(void **state);
+
+/**
+ * Tests that the returned status reflects the state changes made through the TaskDB.
+ */
+void crinitTaskDBGetTaskStatusTestSuccess(void **state);
+/**
+ * Tests NULL pointer handling and querying a task which is not in the TaskDB.
+ */
+void crinitTaskDBGetTaskStatusTestFailure(void **state);
+/**
+ * Benchmarks spawning with and without concurrent status queries and checks the queries do not slow down spawning
+ * significantly.
+ */
+void crinitTaskDBGetTaskStatusTestContention(void **state);
+
+#endif /* __UTEST_TASKDB_GET_TASK_STATUS_H__ */
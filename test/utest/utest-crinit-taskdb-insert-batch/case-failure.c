@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBInsertBatch(), failure execution.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-insert-batch.h"
+
+void crinitTaskDBInsertBatchTestFailure(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTask_t *tasks[3];
+
+    crinitTestCreateTasks(tasks, 1, "task");
+    assert_int_equal(crinitTaskDBInsertBatch(NULL, tasks, 1, false), -1);
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, NULL, 1, false), -1);
+    assert_non_null(tasks[0]->name);
+
+    // A NULL element stops the batch, the tasks before it are inserted anyway.
+    tasks[1] = NULL;
+    crinitTestCreateTasks(tasks + 2, 1, "other");
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 3, false), -1);
+    assert_int_equal(ctx->taskSetItems, 1);
+    assert_null(tasks[0]->name);
+    assert_string_equal(tasks[2]->name, "other-0");
+
+    // Duplicates within a batch are treated like duplicates in the TaskDB.
+    crinitTestFreeTasks(tasks, 3);
+    crinitTestCreateTasks(tasks, 1, "dup");
+    crinitTestCreateTasks(tasks + 1, 1, "dup");
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 2, false), -1);
+    assert_int_equal(ctx->taskSetItems, 2);
+    assert_null(tasks[0]->name);
+    assert_string_equal(tasks[1]->name, "dup-0");
+    crinitTestFreeTasks(tasks, 2);
+}
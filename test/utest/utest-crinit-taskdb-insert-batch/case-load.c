@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-load.c
+ * @brief Unit test/benchmark for crinitTaskDBInsertBatch(), compares it against single inserts.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-insert-batch.h"
+
+#define CRINIT_TEST_NUM_TASKS 2000  ///< Number of tasks in the series to load.
+#define CRINIT_TEST_NUM_ROUNDS 5    ///< Number of timing rounds per variant, the fastest one counts.
+
+/**
+ * Load a series of tasks into a fresh TaskDB, either one by one or as a batch, and return the time it took in
+ * nanoseconds. Only the inserts are timed, not the creation of the tasks.
+ */
+static double crinitMeasureLoad(bool batch) {
+    crinitTask_t **tasks = calloc(CRINIT_TEST_NUM_TASKS, sizeof(*tasks));
+    assert_non_null(tasks);
+    crinitTestCreateTasks(tasks, CRINIT_TEST_NUM_TASKS, "task");
+
+    crinitTaskDB_t ctx;
+    assert_int_equal(crinitTaskDBInitWithSize(&ctx, NULL, CRINIT_TASKDB_INITIAL_SIZE), 0);
+
+    struct timespec start, end;
+    assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &start), 0);
+    if (batch) {
+        assert_int_equal(crinitTaskDBInsertBatch(&ctx, tasks, CRINIT_TEST_NUM_TASKS, false), 0);
+    } else {
+        for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+            assert_int_equal(crinitTaskDBInsert(&ctx, tasks[i], false), 0);
+        }
+    }
+    assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &end), 0);
+    assert_int_equal(ctx.taskSetItems, CRINIT_TEST_NUM_TASKS);
+
+    crinitTaskDBDestroy(&ctx);
+    crinitTestFreeTasks(tasks, CRINIT_TEST_NUM_TASKS);
+    free(tasks);
+    return (double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec);
+}
+
+void crinitTaskDBInsertBatchTestLoad(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    // Task creation needs the global environment set.
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    double single = -1.0, batch = -1.0;
+    for (size_t r = 0; r < CRINIT_TEST_NUM_ROUNDS; r++) {
+        double ns = crinitMeasureLoad(false);
+        if (single < 0 || ns < single) {
+            single = ns;
+        }
+        ns = crinitMeasureLoad(true);
+        if (batch < 0 || ns < batch) {
+            batch = ns;
+        }
+    }
+    print_message("Loading %d tasks one by one: %.1f us, as a batch: %.1f us.\n", CRINIT_TEST_NUM_TASKS, single / 1e3,
+                  batch / 1e3);
+    crinitGlobOptDestroy();
+
+    assert_true(batch < single);
+}
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBInsertBatch(), successful execution.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "common.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-insert-batch.h"
+
+#define CRINIT_TEST_NUM_TASKS 1000  ///< Number of tasks per batch, enough to force growth of the TaskDB.
+
+/**
+ * Count the tasks waiting for `@ctl:enable` in the reverse dependency index.
+ */
+static size_t crinitTestCountEnableWaiters(const crinitTaskDB_t *ctx);
+
+static size_t crinitTestCountEnableWaiters(const crinitTaskDB_t *ctx) {
+    for (size_t i = 0; i < ctx->waitSetItems; i++) {
+        if (strcmp(ctx->waitSet[i].name, "@ctl") == 0 && strcmp(ctx->waitSet[i].event, "enable") == 0) {
+            return ctx->waitSet[i].waitersSize;
+        }
+    }
+    return 0;
+}
+
+void crinitTaskDBInsertBatchTestSuccess(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTask_t *tasks[CRINIT_TEST_NUM_TASKS];
+    char taskName[32];
+
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 0, false), 0);
+    assert_int_equal(ctx->taskSetItems, 0);
+
+    crinitTestCreateTasks(tasks, CRINIT_TEST_NUM_TASKS, "task");
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, CRINIT_TEST_NUM_TASKS, false), 0);
+    assert_int_equal(ctx->taskSetItems, CRINIT_TEST_NUM_TASKS);
+
+    // The contents have been moved, so only empty shells are left.
+    for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        assert_null(tasks[i]->name);
+        assert_null(tasks[i]->deps);
+        assert_int_equal(tasks[i]->depsSize, 0);
+    }
+    crinitTestFreeTasks(tasks, CRINIT_TEST_NUM_TASKS);
+
+    for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        crinitTask_t *pTask = NULL;
+        snprintf(taskName, sizeof(taskName), "task-%zu", i);
+        assert_int_equal(crinitTaskDBGetTaskByName(ctx, &pTask, taskName), 0);
+        assert_string_equal(pTask->name, taskName);
+        assert_int_equal(pTask->depsSize, 1);
+        crinitFreeTask(pTask);
+    }
+
+    // The moved dependencies must have made it into the reverse dependency index.
+    const crinitTaskDep_t enable = {"@ctl", "enable"};
+    assert_int_equal(crinitTaskDBFulfillDep(ctx, &enable, NULL), 0);
+    for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        crinitTask_t *pTask = NULL;
+        snprintf(taskName, sizeof(taskName), "task-%zu", i);
+        assert_int_equal(crinitTaskDBGetTaskByName(ctx, &pTask, taskName), 0);
+        assert_int_equal(pTask->depsSize, 0);
+        crinitFreeTask(pTask);
+    }
+}
+
+void crinitTaskDBInsertBatchTestOverwrite(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTask_t *tasks[CRINIT_TEST_NUM_TASKS];
+
+    crinitTestCreateTasks(tasks, CRINIT_TEST_NUM_TASKS, "task");
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, CRINIT_TEST_NUM_TASKS, false), 0);
+    crinitTestFreeTasks(tasks, CRINIT_TEST_NUM_TASKS);
+
+    // Without permission to overwrite, the batch must stop at the first existing task.
+    crinitTestCreateTasks(tasks, 2, "new");
+    crinitTestCreateTasks(tasks + 2, 2, "task");
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 4, false), -1);
+    assert_int_equal(ctx->taskSetItems, CRINIT_TEST_NUM_TASKS + 2);
+    assert_null(tasks[0]->name);
+    assert_null(tasks[1]->name);
+    assert_string_equal(tasks[2]->name, "task-0");
+    assert_string_equal(tasks[3]->name, "task-1");
+    crinitTestFreeTasks(tasks, 4);
+
+    // With permission, the tasks keep their handles.
+    crinitTaskHandle_t before, after;
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &before, "task-1"), 0);
+    crinitTestCreateTasks(tasks, 2, "task");
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 2, true), 0);
+    assert_int_equal(ctx->taskSetItems, CRINIT_TEST_NUM_TASKS + 2);
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &after, "task-1"), 0);
+    assert_int_equal(before, after);
+    crinitTestFreeTasks(tasks, 2);
+}
+
+void crinitTaskDBInsertBatchTestDuplicate(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTask_t *tasks[4];
+
+    crinitTestCreateTasks(tasks, 2, "task");
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 2, false), 0);
+    crinitTestFreeTasks(tasks, 2);
+
+    // An existing and a new task, each contained twice. Like consecutive inserts, the later definitions win.
+    crinitTestCreateTasks(tasks, 1, "task");
+    crinitTestCreateTasks(tasks + 1, 1, "new");
+    crinitTestCreateTasks(tasks + 2, 1, "task");
+    crinitTestCreateTasks(tasks + 3, 1, "new");
+    tasks[2]->maxRetries = 2;
+    tasks[3]->maxRetries = 3;
+    crinitTestTaskAddedCount = 0;
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 4, true), 0);
+    assert_int_equal(crinitTestTaskAddedCount, 2);
+    for (size_t i = 0; i < 4; i++) {
+        assert_null(tasks[i]->name);
+    }
+    crinitTestFreeTasks(tasks, 4);
+    assert_int_equal(ctx->taskSetItems, 3);
+
+    crinitTask_t *pTask = NULL;
+    assert_int_equal(crinitTaskDBGetTaskByName(ctx, &pTask, "task-0"), 0);
+    assert_int_equal(pTask->maxRetries, 2);
+    crinitFreeTask(pTask);
+    assert_int_equal(crinitTaskDBGetTaskByName(ctx, &pTask, "new-0"), 0);
+    assert_int_equal(pTask->maxRetries, 3);
+    crinitFreeTask(pTask);
+
+    // Each task has been added once, so it waits for its dependency once.
+    assert_int_equal(crinitTestCountEnableWaiters(ctx), 3);
+
+    // Without permission to overwrite, a duplicate within the batch fails like an existing task.
+    crinitTestCreateTasks(tasks, 1, "other");
+    crinitTestCreateTasks(tasks + 1, 1, "other");
+    crinitTestTaskAddedCount = 0;
+    assert_int_equal(crinitTaskDBInsertBatch(ctx, tasks, 2, false), -1);
+    assert_int_equal(crinitTestTaskAddedCount, 1);
+    assert_null(tasks[0]->name);
+    assert_string_equal(tasks[1]->name, "other-0");
+    crinitTestFreeTasks(tasks, 2);
+    assert_int_equal(ctx->taskSetItems, 4);
+    assert_int_equal(crinitTestCountEnableWaiters(ctx), 4);
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-insert-batch.c
+ * @brief Implementation of the crinitTaskDBInsertBatch() unit test group.
+ */
+
+#include "utest-crinit-taskdb-insert-batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "taskdb.h"
+#include "unit_test.h"
+
+size_t crinitTestTaskAddedCount = 0;
+
+int __real_crinitFeatureHook(const char *sysFeatName, crinitHookType_t type, void *data);
+
+int __wrap_crinitFeatureHook(const char *sysFeatName, crinitHookType_t type, void *data) {
+    if (type == CRINIT_HOOK_TASK_ADDED) {
+        crinitTestTaskAddedCount++;
+    }
+    return __real_crinitFeatureHook(sysFeatName, type, data);
+}
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+int crinitTaskDBInsertBatchTestSetup(void **state) {
+    crinitTaskDB_t *ctx = malloc(sizeof(*ctx));
+    assert_non_null(ctx);
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskDBInitWithSize(ctx, crinitNullSpawnFunc, 1), 0);
+    *state = ctx;
+    return 0;
+}
+
+int crinitTaskDBInsertBatchTestTeardown(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskDBDestroy(ctx);
+    free(ctx);
+    crinitGlobOptDestroy();
+    return 0;
+}
+
+void crinitTestCreateTasks(crinitTask_t **tasks, size_t n, const char *prefix) {
+    char taskName[32];
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t dep = {.key = "DEPENDS", .val = "@ctl:enable", .next = &cmd};
+    crinitConfKvList_t name = {.key = "NAME", .val = taskName, .next = &dep};
+
+    for (size_t i = 0; i < n; i++) {
+        snprintf(taskName, sizeof(taskName), "%s-%zu", prefix, i);
+        tasks[i] = NULL;
+        assert_int_equal(crinitTaskCreateFromConfKvList(&tasks[i], &name), 0);
+        assert_non_null(tasks[i]);
+    }
+}
+
+void crinitTestFreeTasks(crinitTask_t **tasks, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        crinitFreeTask(tasks[i]);
+        tasks[i] = NULL;
+    }
+}
+
+/**
+ * Runs the unit test group for crinitTaskDBInsertBatch() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBInsertBatchTestSuccess, crinitTaskDBInsertBatchTestSetup,
+                                        crinitTaskDBInsertBatchTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBInsertBatchTestOverwrite, crinitTaskDBInsertBatchTestSetup,
+                                        crinitTaskDBInsertBatchTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBInsertBatchTestDuplicate, crinitTaskDBInsertBatchTestSetup,
+                                        crinitTaskDBInsertBatchTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBInsertBatchTestFailure, crinitTaskDBInsertBatchTestSetup,
+                                        crinitTaskDBInsertBatchTestTeardown),
+        cmocka_unit_test(crinitTaskDBInsertBatchTestLoad)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-insert-batch.h
+ * @brief Header declaring the unit tests for crinitTaskDBInsertBatch().
+ */
+#ifndef __UTEST_TASKDB_INSERT_BATCH_H__
+#define __UTEST_TASKDB_INSERT_BATCH_H__
+
+#include <stddef.h>
+
+#include "optfeat.h"
+#include "task.h"
+
+/** Number of calls to crinitFeatureHook() for #CRINIT_HOOK_TASK_ADDED, i.e. the number of tasks added. **/
+extern size_t crinitTestTaskAddedCount;
+
+/**
+ * Counts calls for #CRINIT_HOOK_TASK_ADDED and passes all calls on to the real crinitFeatureHook().
+ */
+int __wrap_crinitFeatureHook(const char *sysFeatName, crinitHookType_t type, void *data);
+
+/**
+ * Setup function, creates an empty TaskDB with a single slot.
+ */
+int crinitTaskDBInsertBatchTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBInsertBatchTestTeardown(void **state);
+
+/**
+ * Create tasks named `<prefix>-0`, `<prefix>-1`, ... using crinitTaskCreateFromConfKvList().
+ *
+ * @param tasks   Array to store the created tasks in.
+ * @param n       Number of tasks to create.
+ * @param prefix  Prefix of the task names.
+ */
+void crinitTestCreateTasks(crinitTask_t **tasks, size_t n, const char *prefix);
+/**
+ * Free tasks created by crinitTestCreateTasks().
+ */
+void crinitTestFreeTasks(crinitTask_t **tasks, size_t n);
+
+/**
+ * Tests that all tasks of a batch are found after insertion and that their contents have been moved.
+ */
+void crinitTaskDBInsertBatchTestSuccess(void **state);
+/**
+ * Tests overwriting tasks with a batch, with and without permission.
+ */
+void crinitTaskDBInsertBatchTestOverwrite(void **state);
+/**
+ * Tests that a task contained more than once in a batch is added only once and that its last definition wins.
+ */
+void crinitTaskDBInsertBatchTestDuplicate(void **state);
+/**
+ * Tests NULL pointer handling and invalid batch elements.
+ */
+void crinitTaskDBInsertBatchTestFailure(void **state);
+/**
+ * Benchmarks loading a series of tasks one by one against loading it as a batch.
+ */
+void crinitTaskDBInsertBatchTestLoad(void **state);
+
+#endif /* __UTEST_TASKDB_INSERT_BATCH_H__ */
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-scaling.c
+ * @brief Unit test/benchmark for task lookup by name in the TaskDB, checks lookup cost does not grow with DB size.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-lookup.h"
+
+#define CRINIT_TEST_NUM_LOOKUPS 100000  ///< Number of lookups to time per TaskDB size.
+#define CRINIT_TEST_NUM_ROUNDS 5        ///< Number of timing rounds per TaskDB size, the fastest one counts.
+/**
+ * Maximum allowed ratio between the per-lookup time in the largest and the smallest TaskDB. A linear search would be
+ * several thousand times slower at 50k tasks. The hash index needs a constant number of probes but at 50k tasks these
+ * are mostly cache misses instead of hits, so some slack is left for that and for noisy test machines.
+ */
+#define CRINIT_TEST_MAX_SLOWDOWN 64.0
+
+static crinitTask_t *crinitTgt = NULL;
+static char *crinitTgtName = NULL;
+static crinitTaskDB_t crinitCtx;
+static bool crinitCtxInitialized = false;
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+/**
+ * Fill a fresh TaskDB with \a numTasks tasks and return the fastest average time per lookup in nanoseconds.
+ */
+static double crinitMeasureLookup(size_t numTasks) {
+    char taskName[32];
+
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNullSpawnFunc, CRINIT_TASKDB_INITIAL_SIZE), 0);
+    crinitCtxInitialized = true;
+
+    crinitTgt->name = taskName;
+    for (size_t i = 0; i < numTasks; i++) {
+        snprintf(taskName, sizeof(taskName), "task-%zu", i);
+        assert_int_equal(crinitTaskDBInsert(&crinitCtx, crinitTgt, false), 0);
+    }
+    crinitTgt->name = crinitTgtName;
+
+    // Pre-generate names so that only the lookup itself is timed.
+    char(*names)[32] = malloc(numTasks * sizeof(*names));
+    assert_non_null(names);
+    for (size_t i = 0; i < numTasks; i++) {
+        snprintf(names[i], sizeof(names[i]), "task-%zu", i);
+    }
+
+    double best = -1.0;
+    for (size_t r = 0; r < CRINIT_TEST_NUM_ROUNDS; r++) {
+        struct timespec start, end;
+        pid_t pid;
+        assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &start), 0);
+        for (size_t i = 0; i < CRINIT_TEST_NUM_LOOKUPS; i++) {
+            // Stride through the set so the whole DB is visited, not only its beginning.
+            assert_int_equal(crinitTaskDBGetTaskPID(&crinitCtx, &pid, names[(i * 7919) % numTasks]), 0);
+        }
+        assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &end), 0);
+        double ns = (double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec);
+        ns /= CRINIT_TEST_NUM_LOOKUPS;
+        if (best < 0 || ns < best) {
+            best = ns;
+        }
+    }
+
+    free(names);
+    crinitTaskDBDestroy(&crinitCtx);
+    crinitCtxInitialized = false;
+    print_message("TaskDB with %zu tasks: %.1f ns per lookup.\n", numTasks, best);
+    return best;
+}
+
+void crinitTaskDBLookupTestScaling(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskCreateFromConfKvList(&crinitTgt, &name), 0);
+    assert_non_null(crinitTgt);
+    crinitTgtName = crinitTgt->name;
+
+    double small = crinitMeasureLookup(10);
+    crinitMeasureLookup(1000);
+    double large = crinitMeasureLookup(50000);
+
+    assert_true(large <= small * CRINIT_TEST_MAX_SLOWDOWN);
+}
+
+int crinitTaskDBLookupTestScalingTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    if (crinitTgt != NULL) {
+        crinitTgt->name = crinitTgtName;
+    }
+    crinitDestroyTask(crinitTgt);
+    free(crinitTgt);
+    crinitTgt = NULL;
+    crinitGlobOptDestroy();
+    if (crinitCtxInitialized) {
+        crinitTaskDBDestroy(&crinitCtx);
+        crinitCtxInitialized = false;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for task lookup by name in the TaskDB, successful execution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-lookup.h"
+
+#define CRINIT_TEST_NUM_TASKS 1000  ///< Number of tasks to insert, enough to force several rounds of growth.
+
+static crinitTask_t *crinitTgt = NULL;
+static char *crinitTgtName = NULL;
+static crinitTaskDB_t crinitCtx;
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+void crinitTaskDBLookupTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskCreateFromConfKvList(&crinitTgt, &name), 0);
+    assert_non_null(crinitTgt);
+    crinitTgtName = crinitTgt->name;
+
+    // Start with a single slot so the task set and its index need to be grown and rebuilt multiple times.
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNullSpawnFunc, 1), 0);
+
+    char taskName[32];
+    crinitTgt->name = taskName;
+    for (pid_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        snprintf(taskName, sizeof(taskName), "task-%d", i);
+        crinitTgt->pid = i;
+        assert_int_equal(crinitTaskDBInsert(&crinitCtx, crinitTgt, false), 0);
+    }
+    assert_int_equal(crinitCtx.taskSetItems, CRINIT_TEST_NUM_TASKS);
+
+    // Every task must be found at its own slot after growth.
+    for (pid_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        pid_t pid = -1;
+        snprintf(taskName, sizeof(taskName), "task-%d", i);
+        assert_int_equal(crinitTaskDBGetTaskPID(&crinitCtx, &pid, taskName), 0);
+        assert_int_equal(pid, i);
+    }
+
+    // Overwriting must reuse the existing slot and keep the index consistent.
+    snprintf(taskName, sizeof(taskName), "task-%d", CRINIT_TEST_NUM_TASKS / 2);
+    crinitTgt->pid = -42;
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, crinitTgt, false), -1);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, crinitTgt, true), 0);
+    assert_int_equal(crinitCtx.taskSetItems, CRINIT_TEST_NUM_TASKS);
+    pid_t pid = -1;
+    assert_int_equal(crinitTaskDBGetTaskPID(&crinitCtx, &pid, taskName), 0);
+    assert_int_equal(pid, -42);
+
+    crinitTgt->name = crinitTgtName;
+}
+
+int crinitTaskDBLookupTestSuccessTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    if (crinitTgt != NULL) {
+        crinitTgt->name = crinitTgtName;
+    }
+    crinitDestroyTask(crinitTgt);
+    free(crinitTgt);
+    crinitTgt = NULL;
+    crinitGlobOptDestroy();
+    crinitTaskDBDestroy(&crinitCtx);
+
+    return 0;
+}
+
+void crinitTaskDBLookupTestNotFound(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskCreateFromConfKvList(&crinitTgt, &name), 0);
+    assert_non_null(crinitTgt);
+    crinitTgtName = crinitTgt->name;
+
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNullSpawnFunc, CRINIT_TASKDB_INITIAL_SIZE), 0);
+
+    crinitTaskState_t s = 0;
+    assert_int_equal(crinitTaskDBGetTaskState(&crinitCtx, &s, "TEST"), -1);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, crinitTgt, false), 0);
+    assert_int_equal(crinitTaskDBGetTaskState(&crinitCtx, &s, "TEST"), 0);
+    assert_int_equal(crinitTaskDBGetTaskState(&crinitCtx, &s, "TES"), -1);
+    assert_int_equal(crinitTaskDBGetTaskState(&crinitCtx, &s, "TEST2"), -1);
+    assert_int_equal(crinitTaskDBGetTaskState(&crinitCtx, &s, ""), -1);
+}
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-lookup.c
+ * @brief Implementation of the unit tests for task lookup by name in the TaskDB.
+ */
+
+#include "utest-crinit-taskdb-lookup.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for task lookup by name in the TaskDB using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_teardown(crinitTaskDBLookupTestSuccess, crinitTaskDBLookupTestSuccessTeardown),
+        cmocka_unit_test_teardown(crinitTaskDBLookupTestNotFound, crinitTaskDBLookupTestSuccessTeardown),
+        cmocka_unit_test_teardown(crinitTaskDBLookupTestScaling, crinitTaskDBLookupTestScalingTeardown)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
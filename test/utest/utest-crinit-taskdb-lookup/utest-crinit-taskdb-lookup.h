@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-lookup.h
+ * @brief Header declaring the unit tests for task lookup by name in the TaskDB.
+ */
+#ifndef __UTEST_TASKDB_LOOKUP_H__
+#define __UTEST_TASKDB_LOOKUP_H__
+
+/**
+ * Cleanup function
+ */
+int crinitTaskDBLookupTestSuccessTeardown(void **state);
+
+/**
+ * Cleanup function
+ */
+int crinitTaskDBLookupTestScalingTeardown(void **state);
+
+/**
+ * Tests that all tasks are found after several rounds of TaskDB growth and after overwriting.
+ */
+void crinitTaskDBLookupTestSuccess(void **state);
+/**
+ * Tests that lookups of names not in the TaskDB fail.
+ */
+void crinitTaskDBLookupTestNotFound(void **state);
+/**
+ * Tests that lookup cost stays flat between a TaskDB of 10 and one of 50000 tasks.
+ */
+void crinitTaskDBLookupTestScaling(void **state);
+
+#endif /* __UTEST_TASKDB_LOOKUP_H__ */
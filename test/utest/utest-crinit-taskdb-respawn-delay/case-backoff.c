@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-backoff.c
+ * @brief Unit tests for the exponential respawn delay of crinitTaskDBSetTaskState().
+ */
+
+#include "common.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-respawn-delay.h"
+
+/**
+ * Let the task fail repeatedly and check the respawn delay after each failure.
+ *
+ * @param expected  The expected delays in milliseconds.
+ * @param n         The number of elements in \a expected.
+ */
+static void crinitTestExpectBackoff(const unsigned int *expected, size_t n);
+
+static void crinitTestExpectBackoff(const unsigned int *expected, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        size_t timers = crinitTestTimerCount;
+        crinitTestFailTask();
+        assert_int_equal(crinitTestTimerCount, timers + 1);
+        assert_int_equal(crinitTestTimerDelay, expected[i]);
+        assert_true(crinitTestTaskState() & CRINIT_TASK_STATE_BACKOFF);
+        crinitTestEndDelay();
+    }
+}
+
+void crinitTaskDBRespawnDelayTestBackoff(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const char *opts[] = {"RESPAWN_DELAY_MS", "100", NULL};
+    crinitTestInsertTask(opts);
+
+    const unsigned int expected[] = {100, 200, 400, 800};
+    crinitTestExpectBackoff(expected, ARRAY_SIZE(expected));
+
+    // A successful run resets the backoff.
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitTestCtx, CRINIT_TASK_STATE_RUNNING, CRINIT_TEST_TASK_NAME), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitTestCtx, CRINIT_TASK_STATE_DONE, CRINIT_TEST_TASK_NAME), 0);
+    assert_int_equal(crinitTestTimerDelay, 100);
+    crinitTestEndDelay();
+    crinitTestExpectBackoff(expected, ARRAY_SIZE(expected));
+}
+
+void crinitTaskDBRespawnDelayTestBackoffLimit(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const char *opts[] = {"RESPAWN_DELAY_MS", "100", "RESPAWN_DELAY_MAX_MS", "250", NULL};
+    crinitTestInsertTask(opts);
+
+    const unsigned int expected[] = {100, 200, 250, 250};
+    crinitTestExpectBackoff(expected, ARRAY_SIZE(expected));
+}
+
+void crinitTaskDBRespawnDelayTestBackoffDefaultLimit(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const char *opts[] = {"RESPAWN_DELAY_MS", "10000", NULL};
+    crinitTestInsertTask(opts);
+
+    const unsigned int expected[] = {10000, 20000, 40000, CRINIT_TASK_RESPAWN_DELAY_MAX_DEFAULT,
+                                     CRINIT_TASK_RESPAWN_DELAY_MAX_DEFAULT};
+    crinitTestExpectBackoff(expected, ARRAY_SIZE(expected));
+}
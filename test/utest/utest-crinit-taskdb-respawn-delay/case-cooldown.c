@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-cooldown.c
+ * @brief Unit test for the respawn cool down of crinitTaskDBSetTaskState().
+ */
+
+#include "common.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-respawn-delay.h"
+
+void crinitTaskDBRespawnDelayTestCooldown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const char *opts[] = {"RESPAWN_BURST", "3", "RESPAWN_COOLDOWN_MS", "5000", NULL};
+    crinitTestInsertTask(opts);
+
+    // Without a respawn delay, the first starts of the burst are respawned right away.
+    for (size_t i = 1; i < 3; i++) {
+        crinitTestFailTask();
+        assert_int_equal(crinitTestTimerCount, 0);
+        assert_false(crinitTestTaskState() & (CRINIT_TASK_STATE_BACKOFF | CRINIT_TASK_STATE_COOLDOWN));
+        assert_int_equal(crinitTaskDBSpawnReady(&crinitTestCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+        assert_int_equal(crinitTestSpawnCount, i + 1);
+    }
+
+    crinitTestFailTask();
+    assert_int_equal(crinitTestTimerCount, 1);
+    assert_int_equal(crinitTestTimerDelay, 5000);
+    assert_true(crinitTestTaskState() & CRINIT_TASK_STATE_COOLDOWN);
+    assert_false(crinitTestTaskState() & CRINIT_TASK_STATE_BACKOFF);
+    crinitTestEndDelay();
+
+    // A new burst begins with the next start.
+    crinitTestFailTask();
+    assert_int_equal(crinitTestTimerCount, 1);
+}
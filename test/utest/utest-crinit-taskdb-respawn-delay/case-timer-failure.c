@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-timer-failure.c
+ * @brief Unit test for crinitTaskDBSetTaskState(), respawn timer could not be armed.
+ */
+
+#include "common.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-respawn-delay.h"
+
+void crinitTaskDBRespawnDelayTestTimerFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    const char *opts[] = {"RESPAWN_DELAY_MS", "100", NULL};
+    crinitTestInsertTask(opts);
+
+    crinitTestTimerRet = -1;
+    crinitTestFailTask();
+    assert_int_equal(crinitTestTimerCount, 1);
+    assert_false(crinitTestTaskState() & CRINIT_TASK_STATE_BACKOFF);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitTestCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitTestSpawnCount, 2);
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-respawn-delay.c
+ * @brief Implementation of the unit tests for the respawn delay of crinitTaskDBSetTaskState() and
+ *        crinitTaskDBEndRespawnDelay().
+ */
+
+#include "utest-crinit-taskdb-respawn-delay.h"
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "unit_test.h"
+
+/** Maximum number of additional configuration options of the test task. **/
+#define CRINIT_TEST_MAX_OPTS 8
+
+crinitTaskDB_t crinitTestCtx;
+size_t crinitTestSpawnCount = 0;
+size_t crinitTestTimerCount = 0;
+unsigned int crinitTestTimerDelay = 0;
+int crinitTestTimerRet = 0;
+
+int __wrap_crinitTimerDBAddRespawnTimer(const char *taskName, unsigned int delayMs) {
+    assert_string_equal(taskName, CRINIT_TEST_TASK_NAME);
+    crinitTestTimerCount++;
+    crinitTestTimerDelay = delayMs;
+    return crinitTestTimerRet;
+}
+
+static int crinitCountingSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    crinitTestSpawnCount++;
+    return 0;
+}
+
+void crinitTestInsertTask(const char *opts[]) {
+    crinitConfKvList_t kvs[CRINIT_TEST_MAX_OPTS + 3] = {
+        {.key = "NAME", .val = CRINIT_TEST_TASK_NAME},
+        {.key = "COMMAND", .val = "/bin/false"},
+        {.key = "RESPAWN", .val = "YES"},
+    };
+    size_t n = 3;
+    for (size_t i = 0; opts[i] != NULL; i += 2) {
+        assert_true(n < ARRAY_SIZE(kvs));
+        kvs[n].key = (char *)opts[i];
+        kvs[n].val = (char *)opts[i + 1];
+        n++;
+    }
+    for (size_t i = 0; i + 1 < n; i++) {
+        kvs[i].next = &kvs[i + 1];
+    }
+
+    crinitTask_t *t = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, kvs), 0);
+    assert_non_null(t);
+    assert_int_equal(crinitTaskDBInsert(&crinitTestCtx, t, false), 0);
+    crinitFreeTask(t);
+
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitTestCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitTestSpawnCount, 1);
+}
+
+void crinitTestFailTask(void) {
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitTestCtx, CRINIT_TASK_STATE_RUNNING, CRINIT_TEST_TASK_NAME), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitTestCtx, CRINIT_TASK_STATE_FAILED, CRINIT_TEST_TASK_NAME), 0);
+}
+
+void crinitTestEndDelay(void) {
+    size_t spawned = crinitTestSpawnCount;
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitTestCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitTestSpawnCount, spawned);
+
+    assert_int_equal(crinitTaskDBEndRespawnDelay(&crinitTestCtx, CRINIT_TEST_TASK_NAME), 0);
+    assert_false(crinitTestTaskState() & (CRINIT_TASK_STATE_BACKOFF | CRINIT_TASK_STATE_COOLDOWN));
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitTestCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitTestSpawnCount, spawned + 1);
+}
+
+crinitTaskState_t crinitTestTaskState(void) {
+    crinitTaskState_t s = 0;
+    assert_int_equal(crinitTaskDBGetTaskState(&crinitTestCtx, &s, CRINIT_TEST_TASK_NAME), 0);
+    return s;
+}
+
+int crinitTaskDBRespawnDelayTestSetup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTestSpawnCount = 0;
+    crinitTestTimerCount = 0;
+    crinitTestTimerDelay = 0;
+    crinitTestTimerRet = 0;
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitTestCtx, crinitCountingSpawnFunc, CRINIT_TASKDB_INITIAL_SIZE), 0);
+
+    return 0;
+}
+
+int crinitTaskDBRespawnDelayTestTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskDBDestroy(&crinitTestCtx);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+/**
+ * Runs the unit test group for the respawn delay using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBRespawnDelayTestBackoff, crinitTaskDBRespawnDelayTestSetup,
+                                        crinitTaskDBRespawnDelayTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBRespawnDelayTestBackoffLimit, crinitTaskDBRespawnDelayTestSetup,
+                                        crinitTaskDBRespawnDelayTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBRespawnDelayTestBackoffDefaultLimit,
+                                        crinitTaskDBRespawnDelayTestSetup, crinitTaskDBRespawnDelayTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBRespawnDelayTestCooldown, crinitTaskDBRespawnDelayTestSetup,
+                                        crinitTaskDBRespawnDelayTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBRespawnDelayTestTimerFailure, crinitTaskDBRespawnDelayTestSetup,
+                                        crinitTaskDBRespawnDelayTestTeardown),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
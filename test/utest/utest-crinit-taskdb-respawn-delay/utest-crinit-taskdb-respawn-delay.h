@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-respawn-delay.h
+ * @brief Header declaring the unit tests for the respawn delay of crinitTaskDBSetTaskState() and
+ *        crinitTaskDBEndRespawnDelay().
+ */
+#ifndef __UTEST_TASKDB_RESPAWN_DELAY_H__
+#define __UTEST_TASKDB_RESPAWN_DELAY_H__
+
+#include <stddef.h>
+
+#include "taskdb.h"
+
+/** Name of the task used by the tests. **/
+#define CRINIT_TEST_TASK_NAME "TEST"
+
+/** The TaskDB used by the tests, created by crinitTaskDBRespawnDelayTestSetup(). **/
+extern crinitTaskDB_t crinitTestCtx;
+/** Number of calls to the spawn function of #crinitTestCtx. **/
+extern size_t crinitTestSpawnCount;
+/** Number of calls to __wrap_crinitTimerDBAddRespawnTimer(). **/
+extern size_t crinitTestTimerCount;
+/** The delay passed to the last call of __wrap_crinitTimerDBAddRespawnTimer(). **/
+extern unsigned int crinitTestTimerDelay;
+/** Return value of __wrap_crinitTimerDBAddRespawnTimer(). **/
+extern int crinitTestTimerRet;
+
+/**
+ * Stand-in for crinitTimerDBAddRespawnTimer(), records the delay instead of arming a timer.
+ *
+ * @return  #crinitTestTimerRet
+ */
+int __wrap_crinitTimerDBAddRespawnTimer(const char *taskName, unsigned int delayMs);
+
+/**
+ * Insert the respawning task #CRINIT_TEST_TASK_NAME into #crinitTestCtx and spawn it once.
+ *
+ * @param opts  Additional configuration as pairs of keys and values, terminated by NULL.
+ */
+void crinitTestInsertTask(const char *opts[]);
+/**
+ * Let the task fail once after it has been started.
+ *
+ * Sets the state of the task to running and then to failed, as the dispatch thread would do.
+ */
+void crinitTestFailTask(void);
+/**
+ * Let the respawn delay of the task pass.
+ *
+ * Checks that the task is not respawned while it waits, calls crinitTaskDBEndRespawnDelay() as the respawn timer would
+ * do, and checks that the task is respawned afterwards.
+ */
+void crinitTestEndDelay(void);
+/**
+ * Get the state of the task.
+ *
+ * @return  The crinitTask_t::state of #CRINIT_TEST_TASK_NAME.
+ */
+crinitTaskState_t crinitTestTaskState(void);
+
+/**
+ * Setup function, creates an empty TaskDB with a spawn function counting its calls and resets the stand-in timer.
+ */
+int crinitTaskDBRespawnDelayTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBRespawnDelayTestTeardown(void **state);
+
+/**
+ * Tests that the respawn delay doubles with each consecutive failure and that the task is ready once it has passed.
+ */
+void crinitTaskDBRespawnDelayTestBackoff(void **state);
+/**
+ * Tests that the respawn delay is capped at the configured upper limit.
+ */
+void crinitTaskDBRespawnDelayTestBackoffLimit(void **state);
+/**
+ * Tests that the respawn delay is capped at #CRINIT_TASK_RESPAWN_DELAY_MAX_DEFAULT if no limit is configured.
+ */
+void crinitTaskDBRespawnDelayTestBackoffDefaultLimit(void **state);
+/**
+ * Tests that too many starts within the burst interval lead to a cool down, also without a respawn delay.
+ */
+void crinitTaskDBRespawnDelayTestCooldown(void **state);
+/**
+ * Tests that the task is respawned right away if the respawn timer cannot be armed.
+ */
+void crinitTaskDBRespawnDelayTestTimerFailure(void **state);
+
+#endif /* __UTEST_TASKDB_RESPAWN_DELAY_H__ */
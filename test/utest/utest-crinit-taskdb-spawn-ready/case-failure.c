@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBSpawnReady(), failure execution.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-spawn-ready.h"
+
+void crinitTaskDBSpawnReadyTestNullPointerFailure(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    assert_int_equal(crinitTaskDBSpawnReady(NULL, CRINIT_DISPATCH_THREAD_MODE_START), -1);
+    assert_int_equal(crinitTaskDBWaitReady(NULL), -1);
+    assert_int_equal(crinitTaskDBWaitSpawnRetry(NULL), -1);
+    assert_int_equal(crinitTaskDBDispatchSpaceFreed(NULL), -1);
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-meta.c
+ * @brief Unit test for crinitTaskDBSpawnReady(), inline completion of tasks without commands.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-spawn-ready.h"
+
+static crinitTaskDB_t crinitCtx;
+static size_t crinitSpawnCount = 0;
+
+static int crinitCountingSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(mode);
+
+    // Meta-tasks must never reach the spawn function.
+    assert_int_not_equal(t->cmdsSize, 0);
+    crinitSpawnCount++;
+    return 0;
+}
+
+static void crinitInsertTestTask(const char *name, const char *cmd, const char *depends, const char *provides) {
+    crinitConfKvList_t kvs[] = {
+        {.key = "NAME", .val = (char *)name},
+        {.key = "COMMAND", .val = (char *)cmd},
+        {.key = "DEPENDS", .val = (char *)depends},
+        {.key = "PROVIDES", .val = (char *)provides},
+    };
+    // Chain only the options which are given, NAME always is.
+    crinitConfKvList_t *last = &kvs[0];
+    for (size_t i = 1; i < sizeof(kvs) / sizeof(kvs[0]); i++) {
+        if (kvs[i].val != NULL) {
+            last->next = &kvs[i];
+            last = &kvs[i];
+        }
+    }
+    last->next = NULL;
+
+    crinitTask_t *t = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &kvs[0]), 0);
+    assert_non_null(t);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, t, false), 0);
+    crinitFreeTask(t);
+}
+
+static void crinitAssertMetaDone(const char *name) {
+    crinitTaskDBStatus_t status;
+    assert_int_equal(crinitTaskDBGetTaskStatus(&crinitCtx, &status, name), 0);
+    assert_int_equal(status.state, CRINIT_TASK_STATE_DONE);
+    assert_int_equal(status.pid, -1);
+    assert_memory_equal(&status.startTime, &status.endTime, sizeof(status.startTime));
+    assert_int_equal(status.usage.lastRuntime, 0);
+    free(status.username);
+    free(status.groupname);
+}
+
+int crinitTaskDBSpawnReadyTestMetaSetup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitSpawnCount = 0;
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitCountingSpawnFunc, 1), 0);
+
+    return 0;
+}
+
+int crinitTaskDBSpawnReadyTestMetaTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskDBDestroy(&crinitCtx);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+void crinitTaskDBSpawnReadyTestMetaSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    // A chain of two meta-tasks behind a regular task, with regular tasks waiting for each of them.
+    crinitInsertTestTask("base", "/bin/true", NULL, NULL);
+    crinitInsertTestTask("group", NULL, "base:wait", "group-feature:wait");
+    crinitInsertTestTask("outer", NULL, "group:wait", NULL);
+    crinitInsertTestTask("feature_user", "/bin/true", "@provided:group-feature", NULL);
+    crinitInsertTestTask("outer_user", "/bin/true", "outer:wait", NULL);
+
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 1);
+
+    // Completing the regular task resolves the whole chain in a single call.
+    char depName[] = "base", depEvent[] = "wait";
+    crinitTaskDep_t dep = {depName, depEvent};
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitCtx, CRINIT_TASK_STATE_DONE, "base"), 0);
+    assert_int_equal(crinitTaskDBFulfillDep(&crinitCtx, &dep, NULL), 0);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 3);
+    assert_int_equal(crinitCtx.readyQueueItems, 0);
+    crinitAssertMetaDone("group");
+    crinitAssertMetaDone("outer");
+
+    // A completed meta-task is not started again.
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 3);
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-retry.c
+ * @brief Unit test for crinitTaskDBSpawnReady(), retry after the spawn function was busy.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-spawn-ready.h"
+
+static crinitTaskDB_t crinitCtx;
+static size_t crinitSpawnCount = 0;
+static bool crinitDispatcherBusy = false;
+
+static int crinitBusySpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    if (crinitDispatcherBusy) {
+        errno = EAGAIN;
+        return -1;
+    }
+    crinitSpawnCount++;
+    return 0;
+}
+
+int crinitTaskDBSpawnReadyTestRetrySetup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitSpawnCount = 0;
+    crinitDispatcherBusy = true;
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitBusySpawnFunc, 1), 0);
+
+    return 0;
+}
+
+int crinitTaskDBSpawnReadyTestRetryTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskDBDestroy(&crinitCtx);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+void crinitTaskDBSpawnReadyTestRetrySuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitConfKvList_t cmd = {.next = NULL, .key = "COMMAND", .val = "/bin/true"};
+    crinitConfKvList_t name = {.next = &cmd, .key = "NAME", .val = "busy"};
+    crinitTask_t *t = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &name), 0);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, t, false), 0);
+    crinitFreeTask(t);
+
+    // The dispatcher is busy, the task stays queued and nothing has changed since.
+    errno = 0;
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), -1);
+    assert_int_equal(errno, EAGAIN);
+    assert_int_equal(crinitCtx.readyQueueItems, 1);
+    assert_true(crinitCtx.changeGen == crinitCtx.spawnFailGen);
+
+    // Space is freed before the caller waits. The wakeup must not be lost, so waiting returns right away instead of
+    // blocking forever.
+    crinitDispatcherBusy = false;
+    assert_int_equal(crinitTaskDBDispatchSpaceFreed(&crinitCtx), 0);
+    assert_int_equal(crinitTaskDBWaitSpawnRetry(&crinitCtx), 0);
+
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 1);
+    assert_int_equal(crinitCtx.readyQueueItems, 0);
+}
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-scan.c
+ * @brief Unit test/benchmark for the scheduling state array used by crinitTaskDBSpawnReady().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-spawn-ready.h"
+
+#define CRINIT_TEST_NUM_TASKS 10000                ///< Number of tasks in the scanned TaskDB.
+#define CRINIT_TEST_NUM_ROUNDS 10                  ///< Number of timed scans per variant, the fastest one counts.
+#define CRINIT_TEST_L2_SIZE (256 * 1024)           ///< Conservative lower bound of the L2 cache size of current CPUs.
+#define CRINIT_TEST_EVICT_SIZE (64 * 1024 * 1024)  ///< Size of the buffer written to evict the caches before a scan.
+
+static crinitTaskDB_t crinitCtx;
+
+static int crinitNopSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+    return 0;
+}
+
+/**
+ * Readiness check on the full crinitTask_t, as the TaskDB did before crinitTaskDB_t::taskSched existed.
+ */
+static bool crinitTestTaskIsReady(const crinitTask_t *t) {
+    if (t->depsSize != 0 || !t->triggered) {
+        return false;
+    }
+    if (t->state & (CRINIT_TASK_STATE_RUNNING | CRINIT_TASK_STATE_STARTING)) {
+        return false;
+    }
+    if ((t->opts & CRINIT_TASK_OPT_RESPAWN) && t->inhibitRespawn) {
+        return false;
+    }
+    if (t->state & (CRINIT_TASK_STATE_FAILED | CRINIT_TASK_STATE_DONE)) {
+        if (!(t->opts & CRINIT_TASK_OPT_RESPAWN)) {
+            return false;
+        }
+        if (t->maxRetries != -1 && t->failCount > t->maxRetries) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Write a buffer larger than the last level cache so that a following scan starts cold, like the scheduler does after
+ * the dispatch threads and crinit-ctl requests have run in between.
+ */
+static void crinitTestEvictCaches(volatile unsigned char *buf) {
+    for (size_t i = 0; i < CRINIT_TEST_EVICT_SIZE; i += 64) {
+        buf[i]++;
+    }
+}
+
+static double crinitTestNow(void) {
+    struct timespec ts;
+    assert_int_equal(clock_gettime(CLOCK_MONOTONIC, &ts), 0);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int crinitTaskDBSpawnReadyTestScanSetup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    char name[32], depends[48];
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNopSpawnFunc, CRINIT_TASKDB_INITIAL_SIZE), 0);
+    for (size_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        snprintf(name, sizeof(name), "task-%zu", i);
+        snprintf(depends, sizeof(depends), "task-%zu:wait", i / 2);
+        crinitConfKvList_t deps = {.key = "DEPENDS", .val = depends, .next = NULL};
+        crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = (i % 2 == 1) ? &deps : NULL};
+        crinitConfKvList_t nameKv = {.key = "NAME", .val = name, .next = &cmd};
+
+        crinitTask_t *t = NULL;
+        assert_int_equal(crinitTaskCreateFromConfKvList(&t, &nameKv), 0);
+        assert_int_equal(crinitTaskDBInsert(&crinitCtx, t, false), 0);
+        crinitFreeTask(t);
+    }
+    return 0;
+}
+
+int crinitTaskDBSpawnReadyTestScanTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskDBDestroy(&crinitCtx);
+    crinitGlobOptDestroy();
+    return 0;
+}
+
+void crinitTaskDBSpawnReadyTestScan(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    size_t hotBytes = crinitCtx.taskSetItems * sizeof(*crinitCtx.taskSched);
+    size_t coldBytes = crinitCtx.taskSetItems * sizeof(crinitTask_t);
+    assert_int_equal(crinitCtx.taskSetItems, CRINIT_TEST_NUM_TASKS);
+    assert_true(hotBytes <= CRINIT_TEST_L2_SIZE);
+
+    unsigned char *evictBuf = calloc(CRINIT_TEST_EVICT_SIZE, 1);
+    assert_non_null(evictBuf);
+
+    double hot = -1.0, cold = -1.0;
+    size_t readyHot = 0, readyCold = 0;
+    for (size_t r = 0; r < CRINIT_TEST_NUM_ROUNDS; r++) {
+        crinitTestEvictCaches(evictBuf);
+        double start = crinitTestNow();
+        readyHot = 0;
+        for (size_t i = 0; i < crinitCtx.taskSetItems; i++) {
+            readyHot += crinitTaskDBSchedIsReady(&crinitCtx.taskSched[i]);
+        }
+        double ns = crinitTestNow() - start;
+        if (hot < 0 || ns < hot) {
+            hot = ns;
+        }
+
+        crinitTestEvictCaches(evictBuf);
+        start = crinitTestNow();
+        readyCold = 0;
+        const crinitTask_t *pTask;
+        crinitTaskDbForEach(&crinitCtx, pTask) {
+            readyCold += crinitTestTaskIsReady(pTask);
+        }
+        ns = crinitTestNow() - start;
+        if (cold < 0 || ns < cold) {
+            cold = ns;
+        }
+    }
+    free(evictBuf);
+
+    print_message("Readiness scan over %zu tasks: %.1f us on %zu bytes of scheduling state, %.1f us on %zu bytes of "
+                  "tasks.\n",
+                  crinitCtx.taskSetItems, hot / 1e3, hotBytes, cold / 1e3, coldBytes);
+
+    // Every task without a dependency is ready, the others still wait for theirs.
+    assert_int_equal(readyHot, CRINIT_TEST_NUM_TASKS / 2);
+    assert_int_equal(readyCold, readyHot);
+    assert_true(hot <= cold);
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBSpawnReady(), successful execution.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-spawn-ready.h"
+
+static crinitTaskDB_t crinitCtx;
+static size_t crinitSpawnCount = 0;
+static char crinitLastSpawned[32] = {0};
+
+static int crinitCountingSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(mode);
+
+    crinitSpawnCount++;
+    strncpy(crinitLastSpawned, t->name, sizeof(crinitLastSpawned) - 1);
+    return 0;
+}
+
+static void crinitInsertTestTask(const char *name, const char *depends, bool respawn) {
+    crinitConfKvList_t resp = {.key = "RESPAWN", .val = "YES", .next = NULL};
+    crinitConfKvList_t deps = {.key = "DEPENDS", .val = (char *)depends, .next = respawn ? &resp : NULL};
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = &deps};
+    crinitConfKvList_t nameKv = {.key = "NAME", .val = (char *)name, .next = &cmd};
+    if (depends == NULL) {
+        cmd.next = respawn ? &resp : NULL;
+    }
+
+    crinitTask_t *t = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &nameKv), 0);
+    assert_non_null(t);
+    assert_int_equal(crinitTaskDBInsert(&crinitCtx, t, false), 0);
+    crinitFreeTask(t);
+}
+
+int crinitTaskDBSpawnReadyTestSetup(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitSpawnCount = 0;
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    // Start small so that the ready queue needs to grow with tasks queued.
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitCountingSpawnFunc, 1), 0);
+
+    return 0;
+}
+
+int crinitTaskDBSpawnReadyTestTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitTaskDBDestroy(&crinitCtx);
+    crinitGlobOptDestroy();
+
+    return 0;
+}
+
+void crinitTaskDBSpawnReadyTestSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitInsertTestTask("A", NULL, false);
+    crinitInsertTestTask("B", "A:wait", false);
+    crinitInsertTestTask("C", NULL, false);
+    assert_int_equal(crinitCtx.readyQueueItems, 2);
+
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 2);
+    assert_int_equal(crinitCtx.readyQueueItems, 0);
+
+    // Nothing changed, so nothing to spawn and the queue stays empty.
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 2);
+
+    // State and PID traffic of non-respawning tasks does not make anything ready.
+    assert_int_equal(crinitTaskDBSetTaskPID(&crinitCtx, 42, "A"), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitCtx, CRINIT_TASK_STATE_RUNNING, "A"), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitCtx, CRINIT_TASK_STATE_DONE, "A"), 0);
+    assert_int_equal(crinitCtx.readyQueueItems, 0);
+
+    // Clearing the last dependency queues the waiting task.
+    char depName[] = "A", depEvent[] = "wait";
+    crinitTaskDep_t dep = {depName, depEvent};
+    assert_int_equal(crinitTaskDBFulfillDep(&crinitCtx, &dep, NULL), 0);
+    assert_int_equal(crinitCtx.readyQueueItems, 1);
+    assert_int_equal(crinitTaskDBWaitReady(&crinitCtx), 0);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 3);
+    assert_string_equal(crinitLastSpawned, "B");
+
+    // Restarting (state reset to 0 as done by the RESTART command) queues the task again.
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitCtx, 0, "C"), 0);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 4);
+    assert_string_equal(crinitLastSpawned, "C");
+}
+
+void crinitTaskDBSpawnReadyTestRespawnSuccess(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    crinitInsertTestTask("R", NULL, true);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 1);
+
+    // Becoming eligible for respawn queues the task.
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitCtx, CRINIT_TASK_STATE_RUNNING, "R"), 0);
+    assert_int_equal(crinitCtx.readyQueueItems, 0);
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitCtx, CRINIT_TASK_STATE_FAILED, "R"), 0);
+    assert_int_equal(crinitCtx.readyQueueItems, 1);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 2);
+
+    // Inhibited respawn does not queue, lifting the inhibition does.
+    assert_int_equal(crinitTaskDBSetTaskRespawnInhibit(&crinitCtx, true, "R"), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(&crinitCtx, CRINIT_TASK_STATE_DONE, "R"), 0);
+    assert_int_equal(crinitCtx.readyQueueItems, 0);
+    assert_int_equal(crinitTaskDBSetTaskRespawnInhibit(&crinitCtx, false, "R"), 0);
+    assert_int_equal(crinitCtx.readyQueueItems, 1);
+
+    // While spawning is inhibited, the queue is kept.
+    assert_int_equal(crinitTaskDBSetSpawnInhibit(&crinitCtx, true), 0);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 2);
+    assert_int_equal(crinitCtx.readyQueueItems, 1);
+    assert_int_equal(crinitTaskDBSetSpawnInhibit(&crinitCtx, false), 0);
+    assert_int_equal(crinitTaskDBSpawnReady(&crinitCtx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitSpawnCount, 3);
+    assert_int_equal(crinitCtx.readyQueueItems, 0);
+}
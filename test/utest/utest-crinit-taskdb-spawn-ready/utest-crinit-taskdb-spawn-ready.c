@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-spawn-ready.c
+ * @brief Implementation of the unit tests for crinitTaskDBSpawnReady().
+ */
+
+#include "utest-crinit-taskdb-spawn-ready.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitTaskDBSpawnReady() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBSpawnReadyTestSuccess, crinitTaskDBSpawnReadyTestSetup,
+                                        crinitTaskDBSpawnReadyTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBSpawnReadyTestRespawnSuccess, crinitTaskDBSpawnReadyTestSetup,
+                                        crinitTaskDBSpawnReadyTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBSpawnReadyTestMetaSuccess, crinitTaskDBSpawnReadyTestMetaSetup,
+                                        crinitTaskDBSpawnReadyTestMetaTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBSpawnReadyTestRetrySuccess, crinitTaskDBSpawnReadyTestRetrySetup,
+                                        crinitTaskDBSpawnReadyTestRetryTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBSpawnReadyTestScan, crinitTaskDBSpawnReadyTestScanSetup,
+                                        crinitTaskDBSpawnReadyTestScanTeardown),
+        cmocka_unit_test(crinitTaskDBSpawnReadyTestNullPointerFailure)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-spawn-ready.h
+ * @brief Header declaring the unit tests for crinitTaskDBSpawnReady().
+ */
+#ifndef __UTEST_TASKDB_SPAWN_READY_H__
+#define __UTEST_TASKDB_SPAWN_READY_H__
+
+/**
+ * Setup function, creates an empty TaskDB with a spawn function counting its calls.
+ */
+int crinitTaskDBSpawnReadyTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBSpawnReadyTestTeardown(void **state);
+/**
+ * Setup function, creates a TaskDB with 10000 tasks of which every second one waits for a dependency.
+ */
+int crinitTaskDBSpawnReadyTestScanSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBSpawnReadyTestScanTeardown(void **state);
+/**
+ * Setup function, creates an empty TaskDB with a spawn function which rejects tasks without commands.
+ */
+int crinitTaskDBSpawnReadyTestMetaSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBSpawnReadyTestMetaTeardown(void **state);
+/**
+ * Setup function, creates an empty TaskDB with a spawn function which fails with EAGAIN while the dispatcher is busy.
+ */
+int crinitTaskDBSpawnReadyTestRetrySetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBSpawnReadyTestRetryTeardown(void **state);
+
+/**
+ * Tests that tasks are queued and spawned once their dependencies are fulfilled or they are restarted.
+ */
+void crinitTaskDBSpawnReadyTestSuccess(void **state);
+/**
+ * Tests queueing of respawning tasks, respawn inhibition and spawn inhibition.
+ */
+void crinitTaskDBSpawnReadyTestRespawnSuccess(void **state);
+/**
+ * Tests that chains of tasks without commands are completed inline without calling the spawn function.
+ */
+void crinitTaskDBSpawnReadyTestMetaSuccess(void **state);
+/**
+ * Tests that a failed spawn is retried after crinitTaskDBDispatchSpaceFreed(), even if the space was freed before
+ * crinitTaskDBWaitSpawnRetry() was called.
+ */
+void crinitTaskDBSpawnReadyTestRetrySuccess(void **state);
+/**
+ * Benchmarks a readiness scan over crinitTaskDB_t::taskSched against one over crinitTaskDB_t::taskSet and checks that
+ * the scheduling state of 10000 tasks fits into the L2 cache.
+ */
+void crinitTaskDBSpawnReadyTestScan(void **state);
+/**
+ * Tests NULL pointer handling.
+ */
+void crinitTaskDBSpawnReadyTestNullPointerFailure(void **state);
+
+#endif /* __UTEST_TASKDB_SPAWN_READY_H__ */
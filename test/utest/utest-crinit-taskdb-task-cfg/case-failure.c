@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBGetTaskCfg() and crinitTaskDBPinTaskCfg(), failure execution.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-task-cfg.h"
+
+void crinitTaskDBTaskCfgTestFailure(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskCfg_t *cfg = NULL;
+
+    assert_int_equal(crinitTaskDBGetTaskCfg(NULL, &cfg, CRINIT_TEST_TASK_NAME), -1);
+    assert_int_equal(crinitTaskDBGetTaskCfg(ctx, NULL, CRINIT_TEST_TASK_NAME), -1);
+    assert_int_equal(crinitTaskDBGetTaskCfg(ctx, &cfg, NULL), -1);
+    assert_int_equal(crinitTaskDBGetTaskCfg(ctx, &cfg, "no-such-task"), -1);
+    assert_null(cfg);
+
+    assert_null(crinitTaskDBPinTaskCfg(NULL, 0));
+    assert_int_equal(pthread_mutex_lock(&ctx->lock), 0);
+    assert_null(crinitTaskDBPinTaskCfg(ctx, ctx->taskSetItems));
+    assert_int_equal(pthread_mutex_unlock(&ctx->lock), 0);
+
+    // Releasing NULL is a no-op.
+    crinitTaskCfgRelease(NULL);
+}
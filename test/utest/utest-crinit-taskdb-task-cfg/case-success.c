@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBGetTaskCfg() and crinitTaskDBPinTaskCfg(), successful execution.
+ */
+
+#include "common.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-task-cfg.h"
+
+/**
+ * Spawn the ready task and let it finish, so it is put back into the ready queue.
+ */
+static void crinitTestSpawnCycle(crinitTaskDB_t *ctx) {
+    crinitTestSpawnedTask = NULL;
+    assert_int_equal(crinitTaskDBSpawnReady(ctx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_non_null(crinitTestSpawnedTask);
+    assert_int_equal(crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_RUNNING, CRINIT_TEST_TASK_NAME), 0);
+    assert_int_equal(crinitTaskDBSetTaskState(ctx, CRINIT_TASK_STATE_DONE, CRINIT_TEST_TASK_NAME), 0);
+}
+
+void crinitTaskDBTaskCfgTestSuccess(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskCfg_t *cfg = NULL, *cfgNew = NULL;
+
+    // The snapshot is taken on first use and then shared by the TaskDB and the caller.
+    assert_int_equal(crinitTaskDBGetTaskCfg(ctx, &cfg, CRINIT_TEST_TASK_NAME), 0);
+    assert_non_null(cfg);
+    assert_string_equal(cfg->task.name, CRINIT_TEST_TASK_NAME);
+    assert_int_equal(atomic_load(&cfg->refs), 2);
+    assert_ptr_equal(crinitTaskCfgOf(&cfg->task), cfg);
+
+    // Repeated spawns of the task all get the same snapshot.
+    for (int i = 0; i < 3; i++) {
+        crinitTestSpawnCycle(ctx);
+        assert_ptr_equal(crinitTestSpawnedTask, &cfg->task);
+    }
+    assert_int_equal(atomic_load(&cfg->refs), 2);
+
+    // The handle based variant returns the same snapshot.
+    crinitTaskHandle_t h;
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &h, CRINIT_TEST_TASK_NAME), 0);
+    assert_int_equal(pthread_mutex_lock(&ctx->lock), 0);
+    assert_ptr_equal(crinitTaskDBPinTaskCfg(ctx, h), cfg);
+    assert_int_equal(pthread_mutex_unlock(&ctx->lock), 0);
+    assert_int_equal(atomic_load(&cfg->refs), 3);
+    crinitTaskCfgRelease(cfg);
+
+    // Overwriting the task drops the old snapshot from the TaskDB, the caller's reference stays valid.
+    crinitTask_t *t = crinitTestCreateTask();
+    assert_int_equal(crinitTaskDBInsert(ctx, t, true), 0);
+    crinitFreeTask(t);
+    assert_int_equal(atomic_load(&cfg->refs), 1);
+    assert_string_equal(cfg->task.name, CRINIT_TEST_TASK_NAME);
+    crinitTestSpawnCycle(ctx);
+    assert_ptr_not_equal(crinitTestSpawnedTask, &cfg->task);
+    crinitTaskCfgRelease(cfg);
+
+    // Borrowing the task may modify its configuration, so a new snapshot is taken afterwards.
+    assert_int_equal(crinitTaskDBGetTaskCfg(ctx, &cfg, CRINIT_TEST_TASK_NAME), 0);
+    crinitTask_t *pTask = crinitTaskDBBorrowTask(ctx, CRINIT_TEST_TASK_NAME);
+    assert_non_null(pTask);
+    pTask->maxRetries = 42;
+    assert_int_equal(crinitTaskDBRemit(ctx), 0);
+    assert_int_equal(atomic_load(&cfg->refs), 1);
+
+    assert_int_equal(crinitTaskDBGetTaskCfg(ctx, &cfgNew, CRINIT_TEST_TASK_NAME), 0);
+    assert_ptr_not_equal(cfgNew, cfg);
+    assert_int_equal(cfgNew->task.maxRetries, 42);
+    assert_int_not_equal(cfg->task.maxRetries, 42);
+    crinitTaskCfgRelease(cfg);
+    crinitTaskCfgRelease(cfgNew);
+}
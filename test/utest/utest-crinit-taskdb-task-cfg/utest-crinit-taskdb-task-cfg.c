@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-task-cfg.c
+ * @brief Implementation of the unit tests for crinitTaskDBGetTaskCfg() and crinitTaskDBPinTaskCfg().
+ */
+
+#include "utest-crinit-taskdb-task-cfg.h"
+
+#include <stdlib.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "taskdb.h"
+#include "unit_test.h"
+
+const crinitTask_t *crinitTestSpawnedTask = NULL;
+
+static int crinitRecordingSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(mode);
+
+    crinitTestSpawnedTask = t;
+    return 0;
+}
+
+crinitTask_t *crinitTestCreateTask(void) {
+    crinitConfKvList_t respawn = {.key = "RESPAWN", .val = "YES", .next = NULL};
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = &respawn};
+    crinitConfKvList_t name = {.key = "NAME", .val = CRINIT_TEST_TASK_NAME, .next = &cmd};
+    crinitTask_t *t = NULL;
+
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &name), 0);
+    assert_non_null(t);
+    return t;
+}
+
+int crinitTaskDBTaskCfgTestSetup(void **state) {
+    crinitTaskDB_t *ctx = malloc(sizeof(*ctx));
+    assert_non_null(ctx);
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskDBInitWithSize(ctx, crinitRecordingSpawnFunc, 1), 0);
+
+    crinitTask_t *t = crinitTestCreateTask();
+    assert_int_equal(crinitTaskDBInsert(ctx, t, false), 0);
+    crinitFreeTask(t);
+
+    crinitTestSpawnedTask = NULL;
+    *state = ctx;
+    return 0;
+}
+
+int crinitTaskDBTaskCfgTestTeardown(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskDBDestroy(ctx);
+    free(ctx);
+    crinitGlobOptDestroy();
+    return 0;
+}
+
+/**
+ * Runs the unit test group for crinitTaskDBGetTaskCfg() and crinitTaskDBPinTaskCfg() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBTaskCfgTestSuccess, crinitTaskDBTaskCfgTestSetup,
+                                        crinitTaskDBTaskCfgTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBTaskCfgTestFailure, crinitTaskDBTaskCfgTestSetup,
+                                        crinitTaskDBTaskCfgTestTeardown)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
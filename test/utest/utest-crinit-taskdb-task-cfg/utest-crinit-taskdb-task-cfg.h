@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-task-cfg.h
+ * @brief Header declaring the unit tests for crinitTaskDBGetTaskCfg() and crinitTaskDBPinTaskCfg().
+ */
+#ifndef __UTEST_TASKDB_TASK_CFG_H__
+#define __UTEST_TASKDB_TASK_CFG_H__
+
+#include "task.h"
+
+#define CRINIT_TEST_TASK_NAME "task-0"  ///< Name of the respawning task created by the setup function.
+
+/**
+ * The task passed to the spawn function of the TaskDB created by the setup function on its last call.
+ */
+extern const crinitTask_t *crinitTestSpawnedTask;
+
+/**
+ * Setup function, creates a TaskDB with a single respawning task and a spawn function recording its argument.
+ */
+int crinitTaskDBTaskCfgTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBTaskCfgTestTeardown(void **state);
+/**
+ * Create a task named CRINIT_TEST_TASK_NAME with the RESPAWN option set.
+ */
+crinitTask_t *crinitTestCreateTask(void);
+
+/**
+ * Tests that spawns share a single snapshot until the task configuration is replaced or borrowed.
+ */
+void crinitTaskDBTaskCfgTestSuccess(void **state);
+/**
+ * Tests NULL pointer handling and handles or names which are not in the TaskDB.
+ */
+void crinitTaskDBTaskCfgTestFailure(void **state);
+
+#endif /* __UTEST_TASKDB_TASK_CFG_H__ */
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskDBGetTaskHandle() and crinitTaskDBBorrowTaskByHandle(), failure execution.
+ */
+
+#include <stdlib.h>
+
+#include "common.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-task-handle.h"
+
+void crinitTaskDBTaskHandleTestFailure(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskHandle_t h = 0;
+
+    assert_int_equal(crinitTaskDBGetTaskHandle(NULL, &h, "TEST"), -1);
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, NULL, "TEST"), -1);
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &h, NULL), -1);
+    assert_null(crinitTaskDBBorrowTaskByHandle(NULL, 0));
+
+    // Nothing has been inserted yet, so every handle is out of range, even one within the allocated capacity.
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &h, "TEST"), -1);
+    assert_null(crinitTaskDBBorrowTaskByHandle(ctx, 0));
+
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+    crinitTask_t *t = NULL;
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &name), 0);
+    assert_int_equal(crinitTaskDBInsert(ctx, t, false), 0);
+    crinitDestroyTask(t);
+    free(t);
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &h, "TEST"), 0);
+    assert_int_equal(h, 0);
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &h, "TEST2"), -1);
+    assert_null(crinitTaskDBBorrowTaskByHandle(ctx, 1));
+    assert_null(crinitTaskDBBorrowTaskByHandle(ctx, (crinitTaskHandle_t)-1));
+
+    // A failed borrow must not leave the TaskDB locked.
+    assert_non_null(crinitTaskDBBorrowTaskByHandle(ctx, 0));
+    assert_int_equal(crinitTaskDBRemit(ctx), 0);
+}
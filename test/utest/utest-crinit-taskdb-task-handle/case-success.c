@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskDBGetTaskHandle() and crinitTaskDBBorrowTaskByHandle(), successful execution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "taskdb.h"
+#include "unit_test.h"
+#include "utest-crinit-taskdb-task-handle.h"
+
+#define CRINIT_TEST_NUM_TASKS 1000  ///< Number of tasks to insert, enough to force several rounds of growth.
+
+static crinitTask_t *crinitTgt = NULL;
+static char *crinitTgtName = NULL;
+static crinitTaskDB_t crinitCtx;
+
+static int crinitNullSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(t);
+    CRINIT_PARAM_UNUSED(mode);
+
+    return 0;
+}
+
+int crinitTaskDBTaskHandleTestSetup(void **state) {
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = NULL};
+    crinitConfKvList_t name = {.key = "NAME", .val = "TEST", .next = &cmd};
+
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskCreateFromConfKvList(&crinitTgt, &name), 0);
+    assert_non_null(crinitTgt);
+    crinitTgtName = crinitTgt->name;
+
+    // Start with a single slot so the task set needs to be grown multiple times.
+    assert_int_equal(crinitTaskDBInitWithSize(&crinitCtx, crinitNullSpawnFunc, 1), 0);
+    *state = &crinitCtx;
+    return 0;
+}
+
+int crinitTaskDBTaskHandleTestTeardown(void **state) {
+    CRINIT_PARAM_UNUSED(state);
+
+    if (crinitTgt != NULL) {
+        crinitTgt->name = crinitTgtName;
+    }
+    crinitDestroyTask(crinitTgt);
+    free(crinitTgt);
+    crinitTgt = NULL;
+    crinitGlobOptDestroy();
+    crinitTaskDBDestroy(&crinitCtx);
+
+    return 0;
+}
+
+void crinitTaskDBTaskHandleTestSuccess(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskHandle_t handles[CRINIT_TEST_NUM_TASKS];
+    crinitTask_t *addrs[CRINIT_TEST_NUM_TASKS];
+    char taskName[32];
+
+    crinitTgt->name = taskName;
+    for (pid_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        snprintf(taskName, sizeof(taskName), "task-%d", i);
+        crinitTgt->pid = i;
+        assert_int_equal(crinitTaskDBInsert(ctx, crinitTgt, false), 0);
+
+        // Take the handle and address right after insertion, before the TaskDB has grown any further.
+        assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &handles[i], taskName), 0);
+        addrs[i] = crinitTaskDBBorrowTaskByHandle(ctx, handles[i]);
+        assert_non_null(addrs[i]);
+        assert_string_equal(addrs[i]->name, taskName);
+        assert_int_equal(crinitTaskDBRemit(ctx), 0);
+    }
+    assert_true(ctx->taskSetSize > CRINIT_TASKDB_CHUNK_SIZE);
+
+    // Neither handles nor addresses may have changed after growth.
+    for (pid_t i = 0; i < CRINIT_TEST_NUM_TASKS; i++) {
+        crinitTaskHandle_t h;
+        snprintf(taskName, sizeof(taskName), "task-%d", i);
+        assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &h, taskName), 0);
+        assert_int_equal(h, handles[i]);
+
+        crinitTask_t *pTask = crinitTaskDBBorrowTaskByHandle(ctx, h);
+        assert_ptr_equal(pTask, addrs[i]);
+        assert_int_equal(pTask->pid, i);
+        assert_int_equal(crinitTaskDBRemit(ctx), 0);
+
+        assert_ptr_equal(crinitTaskDBBorrowTask(ctx, taskName), addrs[i]);
+        assert_int_equal(crinitTaskDBRemit(ctx), 0);
+    }
+
+    // Overwriting keeps the task at its handle.
+    pid_t tgtIdx = CRINIT_TEST_NUM_TASKS / 2;
+    snprintf(taskName, sizeof(taskName), "task-%d", tgtIdx);
+    crinitTgt->pid = -42;
+    assert_int_equal(crinitTaskDBInsert(ctx, crinitTgt, true), 0);
+    crinitTaskHandle_t h;
+    assert_int_equal(crinitTaskDBGetTaskHandle(ctx, &h, taskName), 0);
+    assert_int_equal(h, handles[tgtIdx]);
+    crinitTask_t *pTask = crinitTaskDBBorrowTaskByHandle(ctx, h);
+    assert_ptr_equal(pTask, addrs[tgtIdx]);
+    assert_int_equal(pTask->pid, -42);
+    assert_int_equal(crinitTaskDBRemit(ctx), 0);
+
+    crinitTgt->name = crinitTgtName;
+}
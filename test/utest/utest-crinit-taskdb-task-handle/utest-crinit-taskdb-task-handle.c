@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-task-handle.c
+ * @brief Implementation of the unit tests for crinitTaskDBGetTaskHandle() and crinitTaskDBBorrowTaskByHandle().
+ */
+
+#include "utest-crinit-taskdb-task-handle.h"
+
+#include "unit_test.h"
+
+/**
+ * Runs the unit test group for crinitTaskDBGetTaskHandle() and crinitTaskDBBorrowTaskByHandle() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskDBTaskHandleTestSuccess, crinitTaskDBTaskHandleTestSetup,
+                                        crinitTaskDBTaskHandleTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskDBTaskHandleTestFailure, crinitTaskDBTaskHandleTestSetup,
+                                        crinitTaskDBTaskHandleTestTeardown)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskdb-task-handle.h
+ * @brief Header declaring the unit tests for crinitTaskDBGetTaskHandle() and crinitTaskDBBorrowTaskByHandle().
+ */
+#ifndef __UTEST_TASKDB_TASK_HANDLE_H__
+#define __UTEST_TASKDB_TASK_HANDLE_H__
+
+/**
+ * Setup function, creates an empty TaskDB with a single slot and a task to insert.
+ */
+int crinitTaskDBTaskHandleTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskDBTaskHandleTestTeardown(void **state);
+
+/**
+ * Tests that handles and task addresses stay the same across TaskDB growth and overwriting.
+ */
+void crinitTaskDBTaskHandleTestSuccess(void **state);
+/**
+ * Tests NULL pointer handling and handles or names which are not in the TaskDB.
+ */
+void crinitTaskDBTaskHandleTestFailure(void **state);
+
+#endif /* __UTEST_TASKDB_TASK_HANDLE_H__ */
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-cycle.c
+ * @brief Unit test for crinitTaskGraphAnalyze(), detection of dependency cycles and dangling dependencies.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "taskgraph.h"
+#include "unit_test.h"
+#include "utest-crinit-taskgraph-analyze.h"
+
+void crinitTaskGraphAnalyzeTestCycle(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskGraph_t graph;
+
+    crinitTestAddTask(ctx, "ping", "pong:wait", NULL);
+    crinitTestAddTask(ctx, "pong", "ping:spawn", NULL);
+    crinitTestAddTask(ctx, "after-ping", "ping:wait", NULL);
+    crinitTestAddTask(ctx, "self", "self:wait", NULL);
+    crinitTestAddTask(ctx, "orphan", "missing:wait @provided:nothing", NULL);
+    crinitTestAddTask(ctx, "free", NULL, NULL);
+
+    assert_int_equal(crinitTaskGraphAnalyze(&graph, ctx), 0);
+    assert_int_equal(graph.numNodes, 6);
+    assert_int_equal(graph.numCycleTasks, 3);
+    assert_int_equal(graph.numBlockedTasks, 1);
+    assert_int_equal(graph.numDanglingDeps, 2);
+
+    const crinitTaskGraphNode_t *ping = crinitTestGetNode(&graph, "ping");
+    const crinitTaskGraphNode_t *pong = crinitTestGetNode(&graph, "pong");
+    const crinitTaskGraphNode_t *afterPing = crinitTestGetNode(&graph, "after-ping");
+    const crinitTaskGraphNode_t *self = crinitTestGetNode(&graph, "self");
+    const crinitTaskGraphNode_t *orphan = crinitTestGetNode(&graph, "orphan");
+    const crinitTaskGraphNode_t *freeTask = crinitTestGetNode(&graph, "free");
+
+    assert_int_equal(ping->flags, CRINIT_DEPGRAPH_CYCLE);
+    assert_int_equal(pong->flags, CRINIT_DEPGRAPH_CYCLE);
+    assert_int_equal(self->flags, CRINIT_DEPGRAPH_CYCLE);
+    assert_int_equal(afterPing->flags, CRINIT_DEPGRAPH_BLOCKED);
+    assert_int_equal(orphan->flags, CRINIT_DEPGRAPH_DANGLING);
+    assert_int_equal(freeTask->flags, 0);
+
+    // Tasks which will never be started get neither a critical path nor a priority.
+    assert_int_equal(ping->critPath, 0);
+    assert_int_equal(ping->prio, 0);
+    assert_int_equal(afterPing->critPath, 0);
+    assert_int_equal(afterPing->prio, 0);
+    assert_int_equal(self->prio, 0);
+    assert_int_equal(orphan->critPath, CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+    assert_true(orphan->prio > 0);
+    assert_int_equal(freeTask->prio, orphan->prio);
+
+    crinitTaskGraphDestroy(&graph);
+
+    // Problems are reported, but are no error.
+    assert_int_equal(crinitTaskGraphUpdate(ctx), 0);
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-failure.c
+ * @brief Unit test for crinitTaskGraphAnalyze(), failure execution.
+ */
+
+#include "common.h"
+#include "taskdb.h"
+#include "taskgraph.h"
+#include "unit_test.h"
+#include "utest-crinit-taskgraph-analyze.h"
+
+void crinitTaskGraphAnalyzeTestFailure(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskGraph_t graph;
+
+    assert_int_equal(crinitTaskGraphAnalyze(NULL, ctx), -1);
+    assert_int_equal(crinitTaskGraphAnalyze(&graph, NULL), -1);
+    assert_int_equal(crinitTaskGraphUpdate(NULL), -1);
+
+    // An empty TaskDB gives an empty graph.
+    assert_int_equal(crinitTaskGraphAnalyze(&graph, ctx), 0);
+    assert_int_equal(graph.numNodes, 0);
+    crinitTaskGraphDestroy(&graph);
+
+    // Destroying NULL is a no-op.
+    crinitTaskGraphDestroy(NULL);
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file case-success.c
+ * @brief Unit test for crinitTaskGraphAnalyze(), successful execution on an acyclic graph.
+ */
+
+#include <string.h>
+
+#include "common.h"
+#include "taskdb.h"
+#include "taskgraph.h"
+#include "unit_test.h"
+#include "utest-crinit-taskgraph-analyze.h"
+
+void crinitTaskGraphAnalyzeTestSuccess(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskGraph_t graph;
+
+    // Two independent tasks followed by a chain of three tasks, the first of which is only reachable through a
+    // provided feature.
+    crinitTestAddTask(ctx, "short", NULL, NULL);
+    crinitTestAddTask(ctx, "tail", "middle:wait", NULL);
+    crinitTestAddTask(ctx, "provider", NULL, "feature:spawn");
+    crinitTestAddTask(ctx, "middle", "head:wait", NULL);
+    crinitTestAddTask(ctx, "head", NULL, NULL);
+    crinitTestAddTask(ctx, "consumer", "@provided:feature @ctl:enable", NULL);
+
+    assert_int_equal(crinitTaskGraphAnalyze(&graph, ctx), 0);
+    assert_int_equal(graph.numNodes, 6);
+    assert_int_equal(graph.numCycleTasks, 0);
+    assert_int_equal(graph.numBlockedTasks, 0);
+    assert_int_equal(graph.numDanglingDeps, 0);
+
+    const crinitTaskGraphNode_t *head = crinitTestGetNode(&graph, "head");
+    const crinitTaskGraphNode_t *middle = crinitTestGetNode(&graph, "middle");
+    const crinitTaskGraphNode_t *tail = crinitTestGetNode(&graph, "tail");
+    const crinitTaskGraphNode_t *provider = crinitTestGetNode(&graph, "provider");
+    const crinitTaskGraphNode_t *consumer = crinitTestGetNode(&graph, "consumer");
+    const crinitTaskGraphNode_t *shortTask = crinitTestGetNode(&graph, "short");
+
+    assert_int_equal(head->level, 0);
+    assert_int_equal(middle->level, 1);
+    assert_int_equal(tail->level, 2);
+    assert_int_equal(provider->level, 0);
+    assert_int_equal(consumer->level, 1);
+    assert_int_equal(shortTask->level, 0);
+
+    // None of the tasks has run, so all count with the default weight.
+    assert_int_equal(head->critPath, 3 * CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+    assert_int_equal(middle->critPath, 2 * CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+    assert_int_equal(tail->critPath, CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+    assert_int_equal(provider->critPath, 2 * CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+    assert_int_equal(consumer->critPath, CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+    assert_int_equal(shortTask->critPath, CRINIT_TASKGRAPH_DEFAULT_WEIGHT);
+
+    // Tasks with equal critical paths share a priority, longer critical paths get higher priorities.
+    assert_true(head->prio > provider->prio);
+    assert_int_equal(provider->prio, middle->prio);
+    assert_true(provider->prio > shortTask->prio);
+    assert_int_equal(shortTask->prio, tail->prio);
+    assert_int_equal(shortTask->prio, consumer->prio);
+    assert_true(shortTask->prio > 0);
+
+    for (size_t i = 0; i < graph.numNodes; i++) {
+        assert_int_equal(graph.nodes[i].flags, 0);
+    }
+    crinitTaskGraphDestroy(&graph);
+    assert_null(graph.nodes);
+
+    // The ready tasks leave the queue by descending priority, although "short" was inserted first.
+    assert_int_equal(crinitTaskDBSpawnReady(ctx, CRINIT_DISPATCH_THREAD_MODE_START), 0);
+    assert_int_equal(crinitTestNumSpawns, 3);
+    assert_string_equal(crinitTestSpawnOrder[0], "head");
+    assert_string_equal(crinitTestSpawnOrder[1], "provider");
+    assert_string_equal(crinitTestSpawnOrder[2], "short");
+
+    assert_int_equal(crinitTaskGraphUpdate(ctx), 0);
+}
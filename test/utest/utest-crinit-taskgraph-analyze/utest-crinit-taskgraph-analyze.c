@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskgraph-analyze.c
+ * @brief Implementation of the unit tests for crinitTaskGraphAnalyze().
+ */
+
+#include "utest-crinit-taskgraph-analyze.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "globopt.h"
+#include "task.h"
+#include "unit_test.h"
+
+const char *crinitTestSpawnOrder[CRINIT_TEST_MAX_SPAWNS];
+size_t crinitTestNumSpawns = 0;
+
+static int crinitRecordingSpawnFunc(crinitTaskDB_t *ctx, const crinitTask_t *t, crinitDispatchThreadMode_t mode) {
+    CRINIT_PARAM_UNUSED(ctx);
+    CRINIT_PARAM_UNUSED(mode);
+
+    assert_true(crinitTestNumSpawns < CRINIT_TEST_MAX_SPAWNS);
+    crinitTestSpawnOrder[crinitTestNumSpawns++] = t->name;
+    return 0;
+}
+
+void crinitTestAddTask(crinitTaskDB_t *ctx, char *name, char *depends, char *provides) {
+    crinitConfKvList_t prv = {.key = "PROVIDES", .val = provides, .next = NULL};
+    crinitConfKvList_t dep = {.key = "DEPENDS", .val = depends, .next = (provides != NULL) ? &prv : NULL};
+    crinitConfKvList_t cmd = {.key = "COMMAND", .val = "/bin/true", .next = (depends != NULL) ? &dep : dep.next};
+    crinitConfKvList_t n = {.key = "NAME", .val = name, .next = &cmd};
+    crinitTask_t *t = NULL;
+
+    assert_int_equal(crinitTaskCreateFromConfKvList(&t, &n), 0);
+    assert_non_null(t);
+    assert_int_equal(crinitTaskDBInsert(ctx, t, false), 0);
+    crinitFreeTask(t);
+}
+
+const crinitTaskGraphNode_t *crinitTestGetNode(const crinitTaskGraph_t *graph, const char *name) {
+    const crinitTaskGraphNode_t *node = NULL;
+    for (size_t i = 0; i < graph->numNodes && node == NULL; i++) {
+        if (strcmp(graph->nodes[i].name, name) == 0) {
+            node = &graph->nodes[i];
+        }
+    }
+    assert_non_null(node);
+    return node;
+}
+
+int crinitTaskGraphAnalyzeTestSetup(void **state) {
+    crinitTaskDB_t *ctx = malloc(sizeof(*ctx));
+    assert_non_null(ctx);
+    assert_int_equal(crinitGlobOptInitDefault(), 0);
+    assert_int_equal(crinitTaskDBInitWithSize(ctx, crinitRecordingSpawnFunc, 4), 0);
+
+    crinitTestNumSpawns = 0;
+    *state = ctx;
+    return 0;
+}
+
+int crinitTaskGraphAnalyzeTestTeardown(void **state) {
+    crinitTaskDB_t *ctx = *state;
+    crinitTaskDBDestroy(ctx);
+    free(ctx);
+    crinitGlobOptDestroy();
+    return 0;
+}
+
+/**
+ * Runs the unit test group for crinitTaskGraphAnalyze() using the cmocka API.
+ */
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(crinitTaskGraphAnalyzeTestSuccess, crinitTaskGraphAnalyzeTestSetup,
+                                        crinitTaskGraphAnalyzeTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskGraphAnalyzeTestCycle, crinitTaskGraphAnalyzeTestSetup,
+                                        crinitTaskGraphAnalyzeTestTeardown),
+        cmocka_unit_test_setup_teardown(crinitTaskGraphAnalyzeTestFailure, crinitTaskGraphAnalyzeTestSetup,
+                                        crinitTaskGraphAnalyzeTestTeardown)};
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
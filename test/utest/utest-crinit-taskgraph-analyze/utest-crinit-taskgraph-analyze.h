@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+/**
+ * @file utest-crinit-taskgraph-analyze.h
+ * @brief Header declaring the unit tests for crinitTaskGraphAnalyze().
+ */
+#ifndef __UTEST_TASKGRAPH_ANALYZE_H__
+#define __UTEST_TASKGRAPH_ANALYZE_H__
+
+#include <stddef.h>
+
+#include "taskdb.h"
+#include "taskgraph.h"
+
+#define CRINIT_TEST_MAX_SPAWNS 16  ///< Maximum number of spawns recorded by the spawn function of the test TaskDB.
+
+/**
+ * Names of the tasks passed to the spawn function of the TaskDB created by the setup function, in order of the calls.
+ */
+extern const char *crinitTestSpawnOrder[CRINIT_TEST_MAX_SPAWNS];
+/**
+ * Number of valid elements in crinitTestSpawnOrder.
+ */
+extern size_t crinitTestNumSpawns;
+
+/**
+ * Setup function, creates an empty TaskDB with a spawn function recording the order of spawned tasks.
+ */
+int crinitTaskGraphAnalyzeTestSetup(void **state);
+/**
+ * Cleanup function
+ */
+int crinitTaskGraphAnalyzeTestTeardown(void **state);
+/**
+ * Create a task and insert it into a TaskDB.
+ *
+ * @param ctx       The TaskDB to insert into.
+ * @param name      Name of the task.
+ * @param depends   Value of the DEPENDS option, may be NULL.
+ * @param provides  Value of the PROVIDES option, may be NULL.
+ */
+void crinitTestAddTask(crinitTaskDB_t *ctx, char *name, char *depends, char *provides);
+/**
+ * Get the analysis results for a task by name.
+ */
+const crinitTaskGraphNode_t *crinitTestGetNode(const crinitTaskGraph_t *graph, const char *name);
+
+/**
+ * Tests levels, critical paths and priorities of an acyclic graph and the resulting spawn order.
+ */
+void crinitTaskGraphAnalyzeTestSuccess(void **state);
+/**
+ * Tests detection of dependency cycles, tasks blocked by them, and dangling dependencies.
+ */
+void crinitTaskGraphAnalyzeTestCycle(void **state);
+/**
+ * Tests NULL pointer handling.
+ */
+void crinitTaskGraphAnalyzeTestFailure(void **state);
+
+#endif /* __UTEST_TASKGRAPH_ANALYZE_H__ */